@@ -0,0 +1,178 @@
+import { createHash } from 'node:crypto';
+import { mkdirSync, readFileSync, statSync } from 'node:fs';
+import { dirname, join } from 'node:path';
+import { PerformanceObserver, performance } from 'node:perf_hooks';
+import { fileURLToPath } from 'node:url';
+
+import { getMemoryAccounting, resetMemoryAccountingPeak } from '../src/index.js';
+
+const __filename = fileURLToPath(import.meta.url);
+const __dirname = dirname(__filename);
+
+export function prepareBenchEnvironment() {
+  mkdirSync(getTmpDir(), { recursive: true });
+}
+
+export function getInputFile(name: string) {
+  return join(__dirname, '../testdata', name);
+}
+
+export function getOutputFile(name: string) {
+  return join(getTmpDir(), name);
+}
+
+export function getTmpDir() {
+  return join(__dirname, '.tmp');
+}
+
+/**
+ * Fixture identity recorded with the results, so runs are only compared
+ * when they used the same media.
+ */
+export function describeFixture(name: string): { name: string; size: number; sha256: string } {
+  const path = getInputFile(name);
+  return {
+    name,
+    size: statSync(path).size,
+    sha256: createHash('sha256').update(readFileSync(path)).digest('hex').slice(0, 16),
+  };
+}
+
+export interface BenchOptions {
+  // Minimum measured time per benchmark in ms
+  time?: number;
+  // Minimum measured iterations
+  minIterations?: number;
+  // Unmeasured iterations before sampling
+  warmup?: number;
+}
+
+/**
+ * Benchmark body. Returns the number of units (packets, frames, bytes...)
+ * processed by one iteration, or nothing for a single operation.
+ */
+export type BenchFn = () => number | void | Promise<number | void>;
+
+export interface BenchCase {
+  name: string;
+  group: 'micro' | 'macro';
+  // Unit of the throughput figure (default: 'op')
+  unit?: string;
+  fixture?: string;
+  options?: BenchOptions;
+  // Called once before warmup; returns the body and an optional cleanup
+  setup: () => Promise<{ run: BenchFn; teardown?: () => void | Promise<void> }> | { run: BenchFn; teardown?: () => void | Promise<void> };
+}
+
+export interface BenchResult {
+  name: string;
+  group: 'micro' | 'macro';
+  unit: string;
+  fixture?: ReturnType<typeof describeFixture>;
+  iterations: number;
+  // Units per second over the measured time
+  opsPerSec: number;
+  // Iteration latency in ms
+  mean: number;
+  p50: number;
+  p99: number;
+  max: number;
+  // Allocation pressure during the measured iterations
+  gcCount: number;
+  gcTime: number;
+  heapDelta: number;
+  nativePeakBytes: number;
+  rssPeak: number;
+}
+
+const defaults: Required<BenchOptions> = {
+  time: 1000,
+  minIterations: 5,
+  warmup: 20,
+};
+
+function percentile(sorted: number[], q: number): number {
+  return sorted[Math.min(sorted.length - 1, Math.floor(q * sorted.length))];
+}
+
+/**
+ * Run one benchmark case.
+ *
+ * Iterations are timed one by one with performance.now(), so the
+ * percentiles include GC pauses that hit the measured code. Native
+ * memory accounting is only enabled by the runner with --memory (0 bytes
+ * otherwise); its peak is reset before sampling so nativePeakBytes is the
+ * high water mark of this case only.
+ */
+export async function runBench(bench: BenchCase, overrides: BenchOptions = {}): Promise<BenchResult> {
+  const options = { ...defaults, ...bench.options, ...overrides };
+  const { run, teardown } = await bench.setup();
+
+  try {
+    for (let i = 0; i < options.warmup; i++) {
+      await run();
+    }
+
+    globalThis.gc?.();
+    resetMemoryAccountingPeak();
+
+    let gcCount = 0;
+    let gcTime = 0;
+    const observer = new PerformanceObserver((list) => {
+      for (const entry of list.getEntries()) {
+        gcCount++;
+        gcTime += entry.duration;
+      }
+    });
+    observer.observe({ entryTypes: ['gc'] });
+
+    const heapBefore = process.memoryUsage().heapUsed;
+    let rssPeak = process.memoryUsage.rss();
+    const samples: number[] = [];
+    let units = 0;
+
+    const start = performance.now();
+    let elapsed = 0;
+    while (elapsed < options.time || samples.length < options.minIterations) {
+      const t0 = performance.now();
+      const processed = await run();
+      const t1 = performance.now();
+      samples.push(t1 - t0);
+      units += typeof processed === 'number' ? processed : 1;
+      elapsed = t1 - start;
+
+      // Cheap enough to sample every 64 iterations
+      if ((samples.length & 63) === 0 || bench.group === 'macro') {
+        rssPeak = Math.max(rssPeak, process.memoryUsage.rss());
+      }
+    }
+
+    const heapDelta = process.memoryUsage().heapUsed - heapBefore;
+    rssPeak = Math.max(rssPeak, process.memoryUsage.rss());
+
+    // GC entries are delivered asynchronously
+    await new Promise((resolve) => setImmediate(resolve));
+    observer.disconnect();
+
+    const sorted = samples.sort((a, b) => a - b);
+    return {
+      name: bench.name,
+      group: bench.group,
+      unit: bench.unit ?? 'op',
+      fixture: bench.fixture ? describeFixture(bench.fixture) : undefined,
+      iterations: samples.length,
+      opsPerSec: units / (elapsed / 1000),
+      mean: elapsed / samples.length,
+      p50: percentile(sorted, 0.5),
+      p99: percentile(sorted, 0.99),
+      max: sorted[sorted.length - 1],
+      gcCount,
+      gcTime,
+      heapDelta,
+      nativePeakBytes: getMemoryAccounting().peakBytes,
+      rssPeak,
+    };
+  } finally {
+    await teardown?.();
+  }
+}
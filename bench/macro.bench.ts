@@ -0,0 +1,126 @@
+import { rmSync } from 'node:fs';
+
+import { Decoder, Demuxer, Encoder, FF_ENCODER_LIBX264, FilterAPI, Muxer, pipeline } from '../src/index.js';
+import { getInputFile, getOutputFile } from './index.js';
+
+import type { BenchCase, BenchOptions } from './index.js';
+
+const fixture = 'demux.mp4';
+
+// Whole jobs: a few iterations, each one a complete pass over the fixture
+const jobOptions: BenchOptions = { time: 0, minIterations: 5, warmup: 1 };
+
+function withOutput(name: string) {
+  const path = getOutputFile(name);
+  return {
+    path,
+    teardown: () => rmSync(path, { force: true }),
+  };
+}
+
+async function countFrames(frames: AsyncGenerator<{ free(): void } | null>): Promise<number> {
+  let count = 0;
+  for await (const frame of frames) {
+    if (frame === null) {
+      break;
+    }
+    frame.free();
+    count++;
+  }
+  return count;
+}
+
+export const macroBenchmarks: BenchCase[] = [
+  {
+    name: 'pipeline remux (stream copy)',
+    group: 'macro',
+    unit: 'job',
+    fixture,
+    options: jobOptions,
+    setup: () => {
+      const output = withOutput('bench-remux.mp4');
+      return {
+        run: async () => {
+          await using input = await Demuxer.open(getInputFile(fixture));
+          await using muxer = await Muxer.open(output.path);
+          await pipeline(input, muxer).completion;
+        },
+        teardown: output.teardown,
+      };
+    },
+  },
+  {
+    name: 'pipeline remux (stream copy, mmap input)',
+    group: 'macro',
+    unit: 'job',
+    fixture,
+    options: jobOptions,
+    setup: () => {
+      const output = withOutput('bench-remux-mmap.mp4');
+      return {
+        run: async () => {
+          await using input = await Demuxer.open(getInputFile(fixture), { mmap: true });
+          await using muxer = await Muxer.open(output.path);
+          await pipeline(input, muxer).completion;
+        },
+        teardown: output.teardown,
+      };
+    },
+  },
+  {
+    name: 'pipeline decode-only (video)',
+    group: 'macro',
+    unit: 'frame',
+    fixture,
+    options: jobOptions,
+    setup: () => ({
+      run: async () => {
+        await using input = await Demuxer.open(getInputFile(fixture));
+        using decoder = await Decoder.create(input.video()!);
+        return await countFrames(pipeline(input, decoder));
+      },
+    }),
+  },
+  {
+    name: 'pipeline filter chain (scale + format)',
+    group: 'macro',
+    unit: 'frame',
+    fixture,
+    options: jobOptions,
+    setup: () => ({
+      run: async () => {
+        await using input = await Demuxer.open(getInputFile(fixture));
+        const stream = input.video()!;
+        using decoder = await Decoder.create(stream);
+        using scale = FilterAPI.create('scale=640:360', { framerate: stream.avgFrameRate });
+        using format = FilterAPI.create('format=rgba,hflip', { framerate: stream.avgFrameRate });
+        return await countFrames(pipeline(input, decoder, [scale, format]));
+      },
+    }),
+  },
+  {
+    name: 'pipeline transcode (libx264 ultrafast)',
+    group: 'macro',
+    unit: 'job',
+    fixture,
+    options: jobOptions,
+    setup: () => {
+      const output = withOutput('bench-transcode.mp4');
+      return {
+        run: async () => {
+          await using input = await Demuxer.open(getInputFile(fixture));
+          await using muxer = await Muxer.open(output.path);
+          using decoder = await Decoder.create(input.video()!);
+          using encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+            decoder,
+            bitrate: '1M',
+            gopSize: 30,
+            options: { preset: 'ultrafast' },
+          });
+          await pipeline(input, decoder, encoder, muxer).completion;
+        },
+        teardown: output.teardown,
+      };
+    },
+  },
+];
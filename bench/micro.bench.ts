@@ -0,0 +1,344 @@
+import { readFileSync } from 'node:fs';
+
+import {
+  AudioMixer,
+  AV_CHANNEL_LAYOUT_STEREO,
+  AV_PIX_FMT_YUV420P,
+  AV_SAMPLE_FMT_FLTP,
+  AVERROR_EOF,
+  AVMEDIA_TYPE_VIDEO,
+  AVSEEK_FLAG_BACKWARD,
+  AVSEEK_SET,
+  AVSEEK_SIZE,
+  Codec,
+  CodecContext,
+  FFmpegError,
+  FormatContext,
+  Frame,
+  FrameUtils,
+  ImageEncoder,
+  IOContext,
+  Packet,
+  SoftwareScaleContext,
+  SWS_BILINEAR,
+} from '../src/index.js';
+import { getInputFile } from './index.js';
+
+import type { BenchCase } from './index.js';
+
+const demuxFixture = 'demux.mp4';
+const nv12Fixture = 'input.nv12';
+
+async function openInput(fixture: string): Promise<FormatContext> {
+  const ctx = new FormatContext();
+  FFmpegError.throwIfError(await ctx.openInput(getInputFile(fixture)), 'openInput');
+  FFmpegError.throwIfError(await ctx.findStreamInfo(), 'findStreamInfo');
+  return ctx;
+}
+
+function allocVideoFrame(width: number, height: number): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.width = width;
+  frame.height = height;
+  frame.format = AV_PIX_FMT_YUV420P;
+  FFmpegError.throwIfError(frame.getBuffer(), 'getBuffer');
+  return frame;
+}
+
+export const microBenchmarks: BenchCase[] = [
+  {
+    name: 'packet.clone',
+    group: 'micro',
+    setup: () => {
+      const packet = new Packet();
+      packet.alloc();
+      packet.data = Buffer.alloc(4096);
+      return {
+        run: () => {
+          packet.clone()!.free();
+        },
+        teardown: () => packet.free(),
+      };
+    },
+  },
+  {
+    name: 'frame.clone 1280x720',
+    group: 'micro',
+    setup: () => {
+      const frame = allocVideoFrame(1280, 720);
+      return {
+        run: () => {
+          frame.clone()!.free();
+        },
+        teardown: () => frame.free(),
+      };
+    },
+  },
+  {
+    name: 'accessors (packet + frame)',
+    group: 'micro',
+    unit: 'access',
+    setup: () => {
+      const packet = new Packet();
+      packet.alloc();
+      const frame = allocVideoFrame(320, 240);
+      return {
+        run: () => {
+          // 100 getter/setter pairs per iteration
+          for (let i = 0; i < 25; i++) {
+            packet.pts = packet.pts + 1n;
+            packet.streamIndex = packet.streamIndex ^ 1;
+            frame.pts = frame.pts + 1n;
+            frame.quality = frame.quality + 1;
+          }
+          return 200;
+        },
+        teardown: () => {
+          packet.free();
+          frame.free();
+        },
+      };
+    },
+  },
+  {
+    name: 'formatContext.readFrame',
+    group: 'micro',
+    unit: 'packet',
+    fixture: demuxFixture,
+    setup: async () => {
+      const ctx = await openInput(demuxFixture);
+      const packet = new Packet();
+      packet.alloc();
+      return {
+        run: async () => {
+          let ret = await ctx.readFrame(packet);
+          if (ret === AVERROR_EOF) {
+            FFmpegError.throwIfError(await ctx.seekFrame(-1, 0n, AVSEEK_FLAG_BACKWARD), 'seekFrame');
+            ret = await ctx.readFrame(packet);
+          }
+          FFmpegError.throwIfError(ret, 'readFrame');
+          packet.unref();
+        },
+        teardown: async () => {
+          packet.free();
+          await ctx.closeInput();
+        },
+      };
+    },
+  },
+  {
+    name: 'codecContext.sendPacket/receiveFrame',
+    group: 'micro',
+    unit: 'frame',
+    fixture: demuxFixture,
+    setup: async () => {
+      const ctx = await openInput(demuxFixture);
+      const stream = ctx.streams.find((s) => s.codecpar.codecType === AVMEDIA_TYPE_VIDEO)!;
+
+      // Decode from memory so only the codec crossings are measured
+      const packets: Packet[] = [];
+      const packet = new Packet();
+      packet.alloc();
+      while ((await ctx.readFrame(packet)) >= 0) {
+        if (packet.streamIndex === stream.index) {
+          packets.push(packet.clone()!);
+        }
+        packet.unref();
+      }
+      packet.free();
+
+      const decoder = new CodecContext();
+      decoder.allocContext3(Codec.findDecoder(stream.codecpar.codecId));
+      FFmpegError.throwIfError(decoder.parametersToContext(stream.codecpar), 'parametersToContext');
+      FFmpegError.throwIfError(await decoder.open2(), 'open2');
+      await ctx.closeInput();
+
+      const frame = new Frame();
+      frame.alloc();
+      let next = 0;
+      return {
+        run: async () => {
+          if (next === packets.length) {
+            // Restart at the first (key) packet
+            decoder.flushBuffers();
+            next = 0;
+          }
+          FFmpegError.throwIfError(await decoder.sendPacket(packets[next++]), 'sendPacket');
+          let frames = 0;
+          while ((await decoder.receiveFrame(frame)) >= 0) {
+            frame.unref();
+            frames++;
+          }
+          return frames;
+        },
+        teardown: () => {
+          frame.free();
+          decoder.freeContext();
+          for (const p of packets) {
+            p.free();
+          }
+        },
+      };
+    },
+  },
+  {
+    name: 'sws.scaleFrame 1280x720 -> 640x360',
+    group: 'micro',
+    unit: 'frame',
+    setup: () => {
+      const src = allocVideoFrame(1280, 720);
+      const dst = allocVideoFrame(640, 360);
+      const sws = new SoftwareScaleContext();
+      sws.getContext(1280, 720, AV_PIX_FMT_YUV420P, 640, 360, AV_PIX_FMT_YUV420P, SWS_BILINEAR);
+      return {
+        run: async () => {
+          FFmpegError.throwIfError(await sws.scaleFrame(dst, src), 'scaleFrame');
+        },
+        teardown: () => {
+          sws.freeContext();
+          src.free();
+          dst.free();
+        },
+      };
+    },
+  },
+  {
+    name: 'imageEncoder.encode jpeg 1280x720 -> 640x360',
+    group: 'micro',
+    unit: 'frame',
+    setup: () => {
+      const frame = allocVideoFrame(1280, 720);
+      const encoder = ImageEncoder.create();
+      return {
+        run: async () => {
+          await encoder.encode(frame, { width: 640, quality: 75 });
+        },
+        teardown: () => {
+          encoder.close();
+          frame.free();
+        },
+      };
+    },
+  },
+  {
+    name: 'audioMixer 64 inputs stereo 1024 samples',
+    group: 'micro',
+    unit: 'frame',
+    setup: () => {
+      const mixer = AudioMixer.create({ frameSize: 1024 });
+      const inputs = Array.from({ length: 64 }, () => mixer.addInput({ gain: 0.1 }));
+      const input = new Frame();
+      input.alloc();
+      input.format = AV_SAMPLE_FMT_FLTP;
+      input.sampleRate = 48000;
+      input.nbSamples = 1024;
+      input.channelLayout = AV_CHANNEL_LAYOUT_STEREO;
+      FFmpegError.throwIfError(input.getBuffer(), 'getBuffer');
+      FFmpegError.throwIfError(input.fromBuffer(Buffer.alloc(1024 * 2 * 4)), 'fromBuffer');
+      const output = new Frame();
+      output.alloc();
+      return {
+        run: () => {
+          for (const index of inputs) {
+            mixer.write(index, input);
+          }
+          FFmpegError.throwIfError(mixer.receive(output), 'receive');
+        },
+        teardown: () => {
+          mixer.close();
+          input.free();
+          output.free();
+        },
+      };
+    },
+  },
+  {
+    name: 'frameUtils.process nv12 -> rgba',
+    group: 'micro',
+    unit: 'frame',
+    fixture: nv12Fixture,
+    setup: () => {
+      const input = readFileSync(getInputFile(nv12Fixture));
+      const processor = new FrameUtils(320, 180);
+      return {
+        run: () => {
+          processor.process(input, { resize: { width: 160, height: 90 }, format: { to: 'rgba' } });
+        },
+        teardown: () => processor.close(),
+      };
+    },
+  },
+  {
+    name: 'ioContext read callback',
+    group: 'micro',
+    unit: 'byte',
+    fixture: demuxFixture,
+    setup: () => {
+      const data = readFileSync(getInputFile(demuxFixture));
+      let position = 0;
+      const io = new IOContext();
+      io.allocContextWithCallbacks(
+        4096,
+        0,
+        (size) => {
+          if (position >= data.length) {
+            return AVERROR_EOF;
+          }
+          const chunk = data.subarray(position, position + size);
+          position += chunk.length;
+          return chunk;
+        },
+        null,
+        (offset, whence) => {
+          if (whence === AVSEEK_SIZE) {
+            return BigInt(data.length);
+          }
+          if (whence === AVSEEK_SET) {
+            position = Number(offset);
+            return offset;
+          }
+          return -1;
+        },
+      );
+      return {
+        run: () => {
+          const chunk = io.readSync(64 * 1024);
+          if (typeof chunk === 'number') {
+            io.seekSync(0n, AVSEEK_SET);
+            return 0;
+          }
+          return chunk.length;
+        },
+        teardown: () => io.freeContext(),
+      };
+    },
+  },
+  {
+    name: 'ioContext write callback',
+    group: 'micro',
+    unit: 'byte',
+    setup: () => {
+      const chunk = Buffer.alloc(64 * 1024, 0x5a);
+      let written = 0;
+      const io = new IOContext();
+      io.allocContextWithCallbacks(4096, 1, null, (buffer) => {
+        written += buffer.length;
+        return buffer.length;
+      });
+      return {
+        run: () => {
+          io.writeSync(chunk);
+          io.flushSync();
+          return chunk.length;
+        },
+        teardown: () => {
+          io.freeContext();
+          if (written === 0) {
+            throw new Error('Write callback was never called');
+          }
+        },
+      };
+    },
+  },
+];
@@ -0,0 +1,157 @@
+/**
+ * Benchmark runner for the binding layer
+ *
+ * Micro benchmarks time single native crossings (clone, accessors, readFrame,
+ * sendPacket/receiveFrame, scaleFrame, FrameUtils, IOContext callbacks).
+ * Macro benchmarks run complete pipeline() jobs over the testdata fixtures.
+ *
+ * Usage: npm run bench -- [options]
+ *
+ * Options:
+ *   --filter <regex>      Only run benchmarks whose name matches
+ *   --group <name>        Only run 'micro' or 'macro' benchmarks
+ *   --time <ms>           Minimum measured time per micro benchmark (default: 1000)
+ *   --json <file>         Write the results as JSON
+ *   --compare <file>      Compare with a previous --json run, exit 1 on regressions
+ *   --threshold <pct>     Allowed throughput loss for --compare (default: 10)
+ *   --memory              Enable native memory accounting and report its peak per benchmark
+ *                         (adds bookkeeping to every allocation, so compare like with like)
+ *
+ * Examples:
+ *   npm run bench -- --json bench/.tmp/baseline.json
+ *   npm run bench -- --compare bench/.tmp/baseline.json --threshold 5
+ *   npm run bench -- --group micro --filter clone
+ *   npm run bench -- --group macro --memory
+ */
+
+import { readFileSync, writeFileSync } from 'node:fs';
+import { cpus, totalmem } from 'node:os';
+
+import { getFFmpegInfo, setMemoryAccounting } from '../src/index.js';
+import { prepareBenchEnvironment, runBench } from './index.js';
+import { macroBenchmarks } from './macro.bench.js';
+import { microBenchmarks } from './micro.bench.js';
+
+import type { BenchOptions, BenchResult } from './index.js';
+
+interface BenchReport {
+  version: 1;
+  date: string;
+  environment: {
+    node: string;
+    platform: string;
+    cpu: string;
+    cores: number;
+    memory: number;
+    ffmpeg: string;
+    exposeGc: boolean;
+    memoryAccounting: boolean;
+  };
+  results: BenchResult[];
+}
+
+const args = process.argv.slice(2);
+const option = (name: string): string | undefined => {
+  const index = args.indexOf(`--${name}`);
+  return index >= 0 ? args[index + 1] : undefined;
+};
+
+const filter = option('filter') ? new RegExp(option('filter')!, 'i') : null;
+const group = option('group');
+const jsonFile = option('json');
+const compareFile = option('compare');
+const threshold = Number(option('threshold') ?? '10');
+const memory = args.includes('--memory');
+const overrides: BenchOptions = option('time') ? { time: Number(option('time')) } : {};
+
+const benchmarks = [...microBenchmarks, ...macroBenchmarks].filter((b) => (!group || b.group === group) && (!filter || filter.test(b.name)));
+if (benchmarks.length === 0) {
+  console.error('No benchmarks selected');
+  process.exit(1);
+}
+
+prepareBenchEnvironment();
+if (memory) {
+  setMemoryAccounting(true);
+}
+
+if (!globalThis.gc) {
+  console.warn('Running without --expose-gc: heap figures include garbage from previous benchmarks\n');
+}
+
+const report: BenchReport = {
+  version: 1,
+  date: new Date().toISOString(),
+  environment: {
+    node: process.version,
+    platform: `${process.platform}-${process.arch}`,
+    cpu: cpus()[0]?.model ?? 'unknown',
+    cores: cpus().length,
+    memory: totalmem(),
+    ffmpeg: getFFmpegInfo().version,
+    exposeGc: !!globalThis.gc,
+    memoryAccounting: memory,
+  },
+  results: [],
+};
+
+const formatBytes = (bytes: number) => `${(bytes / 1024 / 1024).toFixed(1)}M`;
+const formatRate = (rate: number) => (rate >= 1e6 ? `${(rate / 1e6).toFixed(2)}M` : rate >= 1e3 ? `${(rate / 1e3).toFixed(1)}k` : rate.toFixed(1));
+
+console.log(`node-av benchmarks (${report.environment.node}, ${report.environment.platform}, FFmpeg ${report.environment.ffmpeg})\n`);
+console.log(
+  `  ${'benchmark'.padEnd(40)} ${'throughput'.padStart(16)} ${'p50 ms'.padStart(9)} ${'p99 ms'.padStart(9)} ${'gc'.padStart(5)} ${'native'.padStart(8)} ${'rss'.padStart(8)}`,
+);
+
+for (const bench of benchmarks) {
+  const result = await runBench(bench, bench.group === 'micro' ? overrides : {});
+  report.results.push(result);
+  console.log(
+    `  ${bench.name.padEnd(40)} ${`${formatRate(result.opsPerSec)} ${result.unit}/s`.padStart(16)} ${result.p50.toFixed(3).padStart(9)} ${result.p99.toFixed(3).padStart(9)} ${String(result.gcCount).padStart(5)} ${(memory ? formatBytes(result.nativePeakBytes) : '-').padStart(8)} ${formatBytes(result.rssPeak).padStart(8)}`,
+  );
+}
+
+if (memory) {
+  setMemoryAccounting(false);
+}
+
+if (jsonFile) {
+  writeFileSync(jsonFile, JSON.stringify(report, null, 2));
+  console.log(`\nResults written to ${jsonFile}`);
+}
+
+if (compareFile) {
+  const baseline = JSON.parse(readFileSync(compareFile, 'utf8')) as BenchReport;
+  const previous = new Map(baseline.results.map((r) => [r.name, r]));
+  const regressions: string[] = [];
+
+  console.log(`\nCompared with ${compareFile} (${baseline.date}, ${baseline.environment.node}, FFmpeg ${baseline.environment.ffmpeg})`);
+  if (!!baseline.environment.memoryAccounting !== memory) {
+    console.warn('  Memory accounting differs from the baseline run; throughput is not directly comparable');
+  }
+  for (const result of report.results) {
+    const before = previous.get(result.name);
+    if (!before) {
+      continue;
+    }
+    if (before.fixture?.sha256 !== result.fixture?.sha256) {
+      console.log(`  ${result.name.padEnd(40)} fixture changed, skipped`);
+      continue;
+    }
+
+    const change = ((result.opsPerSec - before.opsPerSec) / before.opsPerSec) * 100;
+    const p99Change = ((result.p99 - before.p99) / before.p99) * 100;
+    const regressed = change < -threshold;
+    if (regressed) {
+      regressions.push(result.name);
+    }
+    console.log(
+      `  ${result.name.padEnd(40)} ${`${change >= 0 ? '+' : ''}${change.toFixed(1)}%`.padStart(9)} throughput ${`${p99Change >= 0 ? '+' : ''}${p99Change.toFixed(1)}%`.padStart(9)} p99${regressed ? '  REGRESSION' : ''}`,
+    );
+  }
+
+  if (regressions.length > 0) {
+    console.error(`\n${regressions.length} benchmark(s) lost more than ${threshold}% throughput`);
+    process.exit(1);
+  }
+}
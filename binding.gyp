@@ -26,6 +26,25 @@
                 "src/bindings/io_context.cc",
                 "src/bindings/io_context_async.cc",
                 "src/bindings/io_context_sync.cc",
+                "src/bindings/rtp_sink.cc",
+                "src/bindings/udp_sender.cc",
+                "src/bindings/rtsp_talkback.cc",
+                "src/bindings/pipeline_stage.cc",
+                "src/bindings/packet_pacer.cc",
+                "src/bindings/input_synchronizer.cc",
+                "src/bindings/mp4_defragmenter.cc",
+                "src/bindings/lazy_exports.cc",
+                "src/bindings/registry.cc",
+                "src/bindings/memory_accounting.cc",
+                "src/bindings/leak_detector.cc",
+                "src/bindings/tracing.cc",
+                "src/bindings/timestamp_rescaler.cc",
+                "src/bindings/mmap_source.cc",
+                "src/bindings/image_encoder.cc",
+                "src/bindings/inline_dispatch.cc",
+                "src/bindings/audio_mixer.cc",
+                "src/bindings/loudness_meter.cc",
+                "src/bindings/voice_activity_detector.cc",
                 "src/bindings/error.cc",
                 "src/bindings/software_scale_context.cc",
                 "src/bindings/software_scale_context_async.cc",
@@ -43,6 +62,7 @@
                 "src/bindings/filter_graph_segment.cc",
                 "src/bindings/filter_inout.cc",
                 "src/bindings/hardware_device_context.cc",
+                "src/bindings/hardware_device_context_probe.cc",
                 "src/bindings/hardware_frames_context.cc",
                 "src/bindings/hardware_frames_context_async.cc",
                 "src/bindings/hardware_frames_context_sync.cc",
@@ -151,6 +171,7 @@
                 "OTHER_CPLUSPLUSFLAGS": [
                     "-fexceptions",
                     "-O3",
+                    "-fopenmp-simd",
                 ],
                 "OTHER_LDFLAGS": [
                     "-Wl,-dead_strip",
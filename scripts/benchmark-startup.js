@@ -0,0 +1,69 @@
+#!/usr/bin/env node
+
+/**
+ * Startup latency benchmark: process start -> module loaded -> first Demuxer.open()
+ *
+ * Every run is a fresh Node.js process, like a short-lived probe worker.
+ *
+ * Usage: node scripts/benchmark-startup.js [--runs 20] [--entry dist/index.js] [--input testdata/demux.mp4]
+ */
+
+import { execFileSync } from 'child_process';
+import { existsSync } from 'fs';
+import { dirname, join, resolve } from 'path';
+import { fileURLToPath, pathToFileURL } from 'url';
+
+const __dirname = dirname(fileURLToPath(import.meta.url));
+const rootDir = join(__dirname, '..');
+
+const args = process.argv.slice(2);
+const option = (name, fallback) => {
+  const index = args.indexOf(`--${name}`);
+  return index >= 0 && args[index + 1] ? args[index + 1] : fallback;
+};
+
+const runs = Number(option('runs', '20'));
+const entry = resolve(rootDir, option('entry', 'dist/index.js'));
+const input = resolve(rootDir, option('input', 'testdata/demux.mp4'));
+
+if (!existsSync(entry)) {
+  console.error(`Entry not found: ${entry} (run npm run build:tsc first)`);
+  process.exit(1);
+}
+
+// Runs in the child. performance.now() counts from process start.
+const child = `
+const loadStart = performance.now();
+const { Demuxer } = await import(${JSON.stringify(pathToFileURL(entry).href)});
+const loaded = performance.now();
+const input = await Demuxer.open(${JSON.stringify(input)});
+const opened = performance.now();
+await input.close();
+console.log(JSON.stringify({ boot: loadStart, load: loaded - loadStart, open: opened - loaded, total: opened }));
+`;
+
+const samples = [];
+for (let i = 0; i < runs; i++) {
+  const output = execFileSync(process.execPath, ['--input-type=module', '-e', child], { encoding: 'utf8' });
+  samples.push(JSON.parse(output.trim().split('\n').pop()));
+}
+
+const stats = (key) => {
+  const values = samples.map((s) => s[key]).sort((a, b) => a - b);
+  const pick = (q) => values[Math.min(values.length - 1, Math.floor(q * values.length))];
+  return { min: values[0], median: pick(0.5), p95: pick(0.95) };
+};
+
+console.log(`Startup benchmark (${runs} runs, ${process.version}, ${process.platform}-${process.arch})`);
+console.log(`  entry: ${entry}`);
+console.log(`  input: ${input}\n`);
+console.log('  phase                      min   median      p95  (ms)');
+for (const [key, label] of [
+  ['boot', 'node bootstrap'],
+  ['load', 'import (addon + modules)'],
+  ['open', 'first Demuxer.open()'],
+  ['total', 'process start -> opened'],
+]) {
+  const { min, median, p95 } = stats(key);
+  console.log(`  ${label.padEnd(24)} ${min.toFixed(1).padStart(6)} ${median.toFixed(1).padStart(8)} ${p95.toFixed(1).padStart(8)}`);
+}
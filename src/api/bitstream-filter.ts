@@ -3,6 +3,7 @@ import { BitStreamFilterContext } from '../lib/bitstream-filter-context.js';
 import { BitStreamFilter } from '../lib/bitstream-filter.js';
 import { FFmpegError } from '../lib/error.js';
 import { Packet } from '../lib/packet.js';
+import { PipelineStage } from '../lib/pipeline-stage.js';
 import { PACKET_THREAD_QUEUE_SIZE } from './constants.js';
 import { Muxer } from './muxer.js';
 import { AsyncQueue } from './utilities/async-queue.js';
@@ -64,6 +65,11 @@ export class BitStreamFilterAPI implements Disposable {
   private nextComponent: SchedulableComponent<Packet> | null = null;
   private pipeToPromise: Promise<void> | null = null;
 
+  // Native stage, used instead of the worker when piped to another bitstream filter
+  private stage: PipelineStage | null = null;
+  private stageNext: BitStreamFilterAPI | null = null;
+  private stageFed = false; // Input comes from an upstream native stage
+
   /**
    * @param bsf - Bitstream filter
    *
@@ -1000,6 +1006,9 @@ export class BitStreamFilterAPI implements Disposable {
     this.inputQueue.close();
     this.outputQueue.close();
 
+    // The stage thread uses the context
+    this.stage?.stopSync();
+
     this.packet.free();
     this.ctx.free();
   }
@@ -1042,6 +1051,11 @@ export class BitStreamFilterAPI implements Disposable {
    * @internal
    */
   async sendToQueue(packet: Packet | null): Promise<void> {
+    if (this.stage) {
+      await this.sendToStage(packet);
+      return;
+    }
+
     if (packet) {
       await this.inputQueue.send(packet);
     } else {
@@ -1068,6 +1082,37 @@ export class BitStreamFilterAPI implements Disposable {
     }
   }
 
+  /**
+   * Send packet to the native stage chain or flush it.
+   *
+   * End of stream propagates through the linked stages natively,
+   * so flushing only waits for the tail of the chain.
+   *
+   * @param packet - Packet to send, or null to flush
+   *
+   * @internal
+   */
+  private async sendToStage(packet: Packet | null): Promise<void> {
+    const queued = await this.stage!.pushAsync(packet);
+
+    if (packet && !queued) {
+      const { error } = this.stage!.getStats();
+      FFmpegError.throwIfError(error < 0 ? error : AVERROR_EOF, 'Bitstream filter stage is not accepting packets');
+    }
+
+    if (!packet) {
+      // Wait for the tail of the chain to drain
+      let tail = this.stageNext;
+      while (tail?.stageNext) {
+        tail = tail.stageNext;
+      }
+      const drained = (tail ?? this).pipeToPromise;
+      if (drained) {
+        await drained;
+      }
+    }
+  }
+
   /**
    * Receive packet from output queue.
    *
@@ -1182,7 +1227,28 @@ export class BitStreamFilterAPI implements Disposable {
   pipeTo(output: Muxer, streamIndex: number): SchedulerControl<Packet>;
 
   pipeTo(target: BitStreamFilterAPI | Muxer, streamIndex?: number): Scheduler<Packet> | SchedulerControl<Packet> {
-    if (target instanceof Muxer) {
+    if (target instanceof Muxer && this.stage) {
+      // Tail of a native stage chain
+      const stage = this.stage;
+      stage.start();
+
+      this.pipeToPromise = (async () => {
+        using packet = new Packet();
+        packet.alloc();
+
+        while (true) {
+          let ret = stage.pull(packet);
+          if (ret === AVERROR_EAGAIN) {
+            ret = await stage.pullAsync(packet);
+          }
+          if (ret === AVERROR_EOF) break;
+          FFmpegError.throwIfError(ret, 'Bitstream filter stage failed');
+          await target.writePacket(packet, streamIndex!);
+        }
+      })();
+
+      return new SchedulerControl<Packet>(this as unknown as SchedulableComponent<Packet>);
+    } else if (target instanceof Muxer) {
       // Start worker if not already running
       this.workerPromise ??= this.runWorker();
 
@@ -1197,6 +1263,19 @@ export class BitStreamFilterAPI implements Disposable {
 
       // Return control without pipeTo (terminal stage)
       return new SchedulerControl<Packet>(this as unknown as SchedulableComponent<Packet>);
+    } else if (!this.workerPromise && !target.workerPromise && !target.stageFed) {
+      // Both ends are bitstream filters: link them with native stages so
+      // packets no longer cross the event loop between the two filters
+      this.stage ??= PipelineStage.create('bsf', this.ctx);
+      target.stage ??= PipelineStage.create('bsf', target.ctx);
+      this.stage.connect(target.stage);
+      this.stage.start();
+
+      this.stageNext = target;
+      target.stageFed = true;
+      this.nextComponent = target as unknown as SchedulableComponent<Packet>;
+
+      return new Scheduler<Packet>(this as unknown as SchedulableComponent<Packet>, this.nextComponent);
     } else {
       // BitStreamFilterAPI
       const t = target as unknown as SchedulableComponent<Packet>;
@@ -2,6 +2,7 @@ import {
   AV_CODEC_FLAG_COPY_OPAQUE,
   AV_FRAME_FLAG_CORRUPT,
   AV_NOPTS_VALUE,
+  AV_PIX_FMT_NONE,
   AV_ROUND_UP,
   AVERROR_DECODER_NOT_FOUND,
   AVERROR_EAGAIN,
@@ -18,6 +19,7 @@ import { Dictionary } from '../lib/dictionary.js';
 import { FFmpegError } from '../lib/error.js';
 import { Frame } from '../lib/frame.js';
 import { Packet } from '../lib/packet.js';
+import { PipelineStage } from '../lib/pipeline-stage.js';
 import { Rational } from '../lib/rational.js';
 import { avGcd, avInvQ, avMulQ, avRescaleDelta, avRescaleQ, avRescaleQRnd } from '../lib/utilities.js';
 import { FRAME_THREAD_QUEUE_SIZE, PACKET_THREAD_QUEUE_SIZE } from './constants.js';
@@ -30,7 +32,7 @@ import type { IRational } from '../lib/types.js';
 import type { Encoder } from './encoder.js';
 import type { FilterAPI } from './filter.js';
 import type { DecoderOptions } from './types.js';
-import type { SchedulableComponent } from './utilities/scheduler.js';
+import type { SchedulableComponent, StageLinkable } from './utilities/scheduler.js';
 
 /**
  * High-level decoder for audio and video streams.
@@ -99,6 +101,10 @@ export class Decoder implements Disposable {
   private nextComponent: SchedulableComponent<Frame> | null = null;
   private pipeToPromise: Promise<void> | null = null;
 
+  // Native stage, used instead of the worker when the target can run on one
+  private stage: PipelineStage | null = null;
+  private stageNext: StageLinkable | null = null;
+
   /**
    * @param codecContext - Configured codec context
    *
@@ -1428,6 +1434,8 @@ export class Decoder implements Disposable {
    * ```typescript
    * decoder.pipeTo(filter).pipeTo(encoder)
    * ```
+   *
+   * @see {@link PipelineStage} For when components are linked with native stages
    */
   pipeTo(target: FilterAPI): Scheduler<Packet>;
   pipeTo(target: Encoder): Scheduler<Packet>;
@@ -1437,6 +1445,19 @@ export class Decoder implements Disposable {
     // Store reference to next component for flush propagation
     this.nextComponent = t;
 
+    // Link decoder and target with native stages so frames no longer cross the event loop
+    const template = this.workerPromise || this.stage ? null : this.createOutputTemplate();
+    const next = template ? (target as unknown as StageLinkable).linkStage(template) : null;
+    template?.free();
+
+    if (next) {
+      this.stage = PipelineStage.create('decoder', this.codecContext);
+      this.stage.connect(next);
+      this.stage.start();
+      this.stageNext = target as unknown as StageLinkable;
+      return new Scheduler<Packet>(this as unknown as SchedulableComponent<Packet>, t);
+    }
+
     // Start worker if not already running
     this.workerPromise ??= this.runWorker();
 
@@ -1482,6 +1503,9 @@ export class Decoder implements Disposable {
     this.inputQueue?.close();
     this.outputQueue?.close();
 
+    // The stage thread uses the codec context
+    this.stage?.stopSync();
+
     this.frame.free();
     this.codecContext.freeContext();
 
@@ -1606,6 +1630,11 @@ export class Decoder implements Disposable {
    * @internal
    */
   private async sendToQueue(packet: Packet | null): Promise<void> {
+    if (this.stage) {
+      await this.sendToStage(packet);
+      return;
+    }
+
     if (packet) {
       await this.inputQueue.send(packet);
     } else {
@@ -1653,6 +1682,75 @@ export class Decoder implements Disposable {
     return await this.outputQueue.receive();
   }
 
+  /**
+   * Send packet to the native stage chain or flush it.
+   *
+   * End of stream propagates through the linked stages natively,
+   * so flushing only waits for the tail of the chain.
+   *
+   * @param packet - Packet to send, or null to flush
+   *
+   * @internal
+   */
+  private async sendToStage(packet: Packet | null): Promise<void> {
+    if (packet) {
+      // Skip packets for other streams
+      if (packet.streamIndex !== this.stream.index || packet.size === 0) {
+        return;
+      }
+
+      if (!(await this.stage!.pushAsync(packet))) {
+        const { error } = this.stage!.getStats();
+        FFmpegError.throwIfError(error < 0 ? error : AVERROR_EOF, 'Decoder stage is not accepting packets');
+      }
+      return;
+    }
+
+    await this.stage!.pushAsync(null);
+
+    // Wait for the tail of the chain to drain
+    const drained = this.stageNext!.stageDrained();
+    if (drained) {
+      await drained;
+    }
+  }
+
+  /**
+   * Build a frame carrying the decoder output parameters.
+   *
+   * Only plain video decoding qualifies: hardware decoding and the frame
+   * adjustments of processVideoFrame() need the JavaScript worker.
+   *
+   * @returns Template frame without data, or null if the decoder cannot run on a native stage
+   *
+   * @internal
+   */
+  private createOutputTemplate(): Frame | null {
+    const ctx = this.codecContext;
+    const { hardware, hwaccelOutputFormat, forcedFramerate, sarOverride, applyCropping } = this.options;
+    if (this.isClosed || ctx.codecType !== AVMEDIA_TYPE_VIDEO || hardware || hwaccelOutputFormat !== undefined || forcedFramerate || sarOverride || applyCropping) {
+      return null;
+    }
+
+    if (ctx.width <= 0 || ctx.height <= 0 || ctx.pixelFormat === AV_PIX_FMT_NONE) {
+      return null;
+    }
+
+    const frame = new Frame();
+    frame.alloc();
+    frame.format = ctx.pixelFormat;
+    frame.width = ctx.width;
+    frame.height = ctx.height;
+    frame.sampleAspectRatio = ctx.sampleAspectRatio;
+    frame.colorRange = ctx.colorRange;
+    frame.colorPrimaries = ctx.colorPrimaries;
+    frame.colorTrc = ctx.colorTrc;
+    frame.colorSpace = ctx.colorSpace;
+    frame.chromaLocation = ctx.chromaLocation;
+    frame.timeBase = ctx.pktTimebase;
+    return frame;
+  }
+
   /**
    * Estimate video frame duration.
    *
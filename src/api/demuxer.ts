@@ -18,6 +18,7 @@ import {
   AVMEDIA_TYPE_AUDIO,
   AVMEDIA_TYPE_VIDEO,
   AVSEEK_CUR,
+  AVSEEK_FLAG_BACKWARD,
   AVSEEK_END,
   AVSEEK_SET,
 } from '../constants/constants.js';
@@ -26,16 +27,22 @@ import { FFmpegError } from '../lib/error.js';
 import { FormatContext } from '../lib/format-context.js';
 import { InputFormat } from '../lib/input-format.js';
 import { IOContext } from '../lib/io-context.js';
+import { handOverAllocationSite, leakDetection } from '../lib/leak-detector.js';
+import { PacketPacer } from '../lib/packet-pacer.js';
 import { Packet } from '../lib/packet.js';
 import { Rational } from '../lib/rational.js';
-import { avGetPixFmtName, avGetSampleFmtName, avRescaleQ, avRescaleQRnd, dtsPredict as nativeDtsPredict } from '../lib/utilities.js';
+import { TimestampRescaler } from '../lib/timestamp-rescaler.js';
+import { avGetPixFmtName, avGetSampleFmtName, dtsPredict as nativeDtsPredict } from '../lib/utilities.js';
 import { DELTA_THRESHOLD, DTS_ERROR_THRESHOLD, IO_BUFFER_SIZE, MAX_INPUT_QUEUE_SIZE } from './constants.js';
 import { IOStream } from './io-stream.js';
 import { StreamingUtils } from './utilities/streaming.js';
 
 import type { AVMediaType, AVSeekFlag, AVSeekWhence } from '../constants/index.js';
 import type { Stream } from '../lib/stream.js';
-import type { DemuxerOptions, IOInputCallbacks, RawData, RTPDemuxer } from './types.js';
+import type { IRational, PacketPacerStats } from '../lib/types.js';
+import type { DemuxerOptions, IOInputCallbacks, RawData, ReconnectOptions, ReconnectStats, RTPDemuxer } from './types.js';
+
+type ResolvedReconnectOptions = Required<Omit<ReconnectOptions, 'onDisconnect' | 'onReconnect'>> & Pick<ReconnectOptions, 'onDisconnect' | 'onReconnect'>;
 
 /**
  * Per-stream timestamp processing state.
@@ -50,6 +57,19 @@ interface StreamState {
   firstDts: bigint;
   nextDts: bigint;
   dts: bigint;
+
+  // Conversions between the stream time base and AV_TIME_BASE_Q
+  rescalers: StreamRescalers | null;
+}
+
+/**
+ * Rescalers between a stream time base and AV_TIME_BASE_Q.
+ * Created once per stream, so per-packet conversions only pass the timestamp.
+ */
+interface StreamRescalers {
+  toUs: TimestampRescaler;
+  toUsPassMinMax: TimestampRescaler; // AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX
+  fromUs: TimestampRescaler;
 }
 
 /**
@@ -110,9 +130,38 @@ export class Demuxer implements AsyncDisposable, Disposable {
   private demuxThread: Promise<void> | null = null;
   private packetQueues = new Map<number | 'all', Packet[]>(); // streamIndex or 'all' -> queue
   private queueResolvers = new Map<number | 'all', () => void>(); // Promise resolvers for waiting consumers
+  private packetArrivals = new WeakMap<Packet, number>(); // queued packet -> enqueue time (ms)
+  private trackArrivals = false; // Set by the first getQueueLatency() call (LoadShedder)
   private demuxThreadActive = false;
   private demuxEof = false;
 
+  // Real-time pacing and looping of the demux loop
+  private pacer: PacketPacer | null = null;
+  private loopsRemaining = 0;
+  private loopOffset = 0n; // AV_TIME_BASE units added to timestamps of the current pass (or connection)
+  private loopFirstTs = AV_NOPTS_VALUE; // First timestamp of the input (AV_TIME_BASE)
+  private loopEndTs = AV_NOPTS_VALUE; // End of the current pass (AV_TIME_BASE, offset applied)
+  private loopPassPackets = 0;
+
+  // Reconnecting network inputs
+  private url: string | null = null;
+  private reconnectOptions: ResolvedReconnectOptions | null = null;
+  private originContext: FormatContext; // First connection, owns the stream objects handed out
+  private currentStreams: Stream[]; // Streams of the current connection
+  private standby: FormatContext | null = null;
+  private standbyTask: Promise<void> | null = null;
+  private standbyTimer: NodeJS.Timeout | null = null;
+  private rebasePending = false; // Continue timestamps on the first packet of a new connection
+  private lastPacketTime = 0;
+  private reconnectStats: ReconnectStats = {
+    reconnects: 0,
+    stalls: 0,
+    failedAttempts: 0,
+    standbyFailovers: 0,
+    standbyReady: false,
+    gaveUp: null,
+  };
+
   /**
    * @param formatContext - Opened format context
    *
@@ -120,13 +169,36 @@ export class Demuxer implements AsyncDisposable, Disposable {
    *
    * @param ioContext - Optional IO context for custom I/O (e.g., from Buffer)
    *
+   * @param url - Resolved URL the input was opened from (enables reconnecting)
+   *
    * @internal
    */
-  private constructor(formatContext: FormatContext, options: Required<DemuxerOptions>, ioContext?: IOContext) {
+  private constructor(formatContext: FormatContext, options: Required<DemuxerOptions>, ioContext?: IOContext, url?: string) {
     this.formatContext = formatContext;
+    this.originContext = formatContext;
     this.ioContext = ioContext;
     this._streams = formatContext.streams ?? [];
+    this.currentStreams = this._streams;
     this.options = options;
+    this.loopsRemaining = options.loop;
+    if (options.pacing) {
+      this.pacer = PacketPacer.create(options.pacing === true ? undefined : options.pacing);
+    }
+    if (options.reconnect && url) {
+      const reconnect = options.reconnect === true ? {} : options.reconnect;
+      this.url = url;
+      this.reconnectOptions = {
+        stallTimeout: reconnect.stallTimeout ?? 5000,
+        maxAttempts: reconnect.maxAttempts ?? -1,
+        delay: reconnect.delay ?? 500,
+        maxDelay: reconnect.maxDelay ?? 10000,
+        standby: reconnect.standby ?? false,
+        standbyRefresh: reconnect.standbyRefresh ?? 30000,
+        onDisconnect: reconnect.onDisconnect,
+        onReconnect: reconnect.onReconnect,
+      };
+      formatContext.readTimeout = this.reconnectOptions.stallTimeout;
+    }
   }
 
   /**
@@ -426,6 +498,7 @@ export class Demuxer implements AsyncDisposable, Disposable {
     let ioContext: IOContext | undefined;
     let optionsDict: Dictionary | null = null;
     let inputFormat: InputFormat | null = null;
+    let url: string | undefined;
 
     try {
       // Create options dictionary if options are provided
@@ -457,6 +530,16 @@ export class Demuxer implements AsyncDisposable, Disposable {
         ]);
         const shouldResolve = !isUrl && !(options.format && noResolveFormats.has(options.format));
         const resolvedInput = shouldResolve ? resolve(input) : input;
+        url = resolvedInput;
+
+        if (options.mmap && shouldResolve) {
+          // Local file served from a memory mapping instead of the file protocol
+          formatContext.allocContext();
+          ioContext = new IOContext();
+          ioContext.allocContextMmap(resolvedInput, options.bufferSize ?? IO_BUFFER_SIZE);
+          formatContext.pb = ioContext;
+          formatContext.setFlags(AVFMT_FLAG_CUSTOM_IO);
+        }
 
         const ret = await formatContext.openInput(resolvedInput, inputFormat, optionsDict);
         FFmpegError.throwIfError(ret, 'Failed to open input');
@@ -538,9 +621,13 @@ export class Demuxer implements AsyncDisposable, Disposable {
         copyTs: options.copyTs ?? false,
         options: options.options ?? {},
         blocking: options.blocking ?? false,
+        pacing: options.pacing ?? false,
+        loop: options.loop ?? 0,
+        reconnect: options.reconnect ?? false,
+        mmap: options.mmap ?? false,
       };
 
-      return new Demuxer(formatContext, fullOptions, ioContext);
+      return new Demuxer(formatContext, fullOptions, ioContext, url);
     } catch (error) {
       // Clean up only on error
       if (ioContext) {
@@ -668,6 +755,7 @@ export class Demuxer implements AsyncDisposable, Disposable {
     let ioContext: IOContext | undefined;
     let optionsDict: Dictionary | null = null;
     let inputFormat: InputFormat | null = null;
+    let url: string | undefined;
 
     try {
       // Create options dictionary if options are provided
@@ -699,6 +787,16 @@ export class Demuxer implements AsyncDisposable, Disposable {
         ]);
         const shouldResolve = !isUrl && !(options.format && noResolveFormats.has(options.format));
         const resolvedInput = shouldResolve ? resolve(input) : input;
+        url = resolvedInput;
+
+        if (options.mmap && shouldResolve) {
+          // Local file served from a memory mapping instead of the file protocol
+          formatContext.allocContext();
+          ioContext = new IOContext();
+          ioContext.allocContextMmap(resolvedInput, options.bufferSize ?? IO_BUFFER_SIZE);
+          formatContext.pb = ioContext;
+          formatContext.setFlags(AVFMT_FLAG_CUSTOM_IO);
+        }
 
         const ret = formatContext.openInputSync(resolvedInput, inputFormat, optionsDict);
         FFmpegError.throwIfError(ret, 'Failed to open input');
@@ -766,9 +864,13 @@ export class Demuxer implements AsyncDisposable, Disposable {
         copyTs: options.copyTs ?? false,
         options: options.options ?? {},
         blocking: options.blocking ?? false,
+        pacing: options.pacing ?? false,
+        loop: options.loop ?? 0,
+        reconnect: options.reconnect ?? false,
+        mmap: options.mmap ?? false,
       };
 
-      return new Demuxer(formatContext, fullOptions, ioContext);
+      return new Demuxer(formatContext, fullOptions, ioContext, url);
     } catch (error) {
       // Clean up only on error
       if (ioContext) {
@@ -1457,6 +1559,11 @@ export class Demuxer implements AsyncDisposable, Disposable {
           }
         }
 
+        // Cloned by the read loop; report leaks where the packet is consumed
+        if (leakDetection.enabled) {
+          handOverAllocationSite(packet);
+        }
+
         yield packet;
       }
     } finally {
@@ -1472,6 +1579,75 @@ export class Demuxer implements AsyncDisposable, Disposable {
     }
   }
 
+  /**
+   * Get the queue latency of a packet generator.
+   *
+   * Returns how long the oldest packet waiting in the queue of a running
+   * {@link packets} generator has been queued. Grows when the consumer
+   * (decoder, encoder, muxer) falls behind the demuxer, e.g. in live
+   * pipelines where the source delivers in real time.
+   *
+   * Enqueue times are only recorded once this has been called, so the
+   * packet loop pays nothing without a {@link LoadShedder}. Packets queued
+   * before the first call are not counted.
+   *
+   * @param index - Stream index of the generator (omit for the all-streams generator)
+   *
+   * @returns Age of the oldest queued packet in milliseconds, 0 if the queue is empty
+   *
+   * @example
+   * ```typescript
+   * const latency = input.getQueueLatency(video.index);
+   * if (latency > 500) {
+   *   console.warn(`Video is ${latency.toFixed(0)}ms behind`);
+   * }
+   * ```
+   *
+   * @see {@link LoadShedder} For dropping work when latency grows
+   */
+  getQueueLatency(index?: number): number {
+    this.trackArrivals = true;
+    const oldest = this.packetQueues.get(index ?? 'all')?.[0];
+    const arrival = oldest ? this.packetArrivals.get(oldest) : undefined;
+    return arrival === undefined ? 0 : performance.now() - arrival;
+  }
+
+  /**
+   * Get real-time pacing statistics.
+   *
+   * @returns Pacer statistics, or null if the `pacing` option is not enabled
+   *
+   * @example
+   * ```typescript
+   * const input = await Demuxer.open('channel.mp4', { pacing: true, loop: -1 });
+   * // ...
+   * const stats = input.getPacingStats();
+   * console.log(`${stats?.late} late packets, ${stats?.reanchors} re-anchors`);
+   * ```
+   *
+   * @see {@link PacketPacer} For the pacing algorithm
+   */
+  getPacingStats(): PacketPacerStats | null {
+    return this.pacer?.getStats() ?? null;
+  }
+
+  /**
+   * Get reconnect statistics.
+   *
+   * @returns Reconnect statistics, or null if the `reconnect` option is not enabled
+   *
+   * @example
+   * ```typescript
+   * const input = await Demuxer.open('rtsp://camera/stream', { reconnect: { standby: true } });
+   * // ...
+   * const stats = input.getReconnectStats();
+   * console.log(`${stats?.reconnects} reconnects (${stats?.stalls} stalls)`);
+   * ```
+   */
+  getReconnectStats(): ReconnectStats | null {
+    return this.reconnectOptions ? { ...this.reconnectStats } : null;
+  }
+
   /**
    * Read packets from media as generator synchronously.
    * Synchronous version of packets.
@@ -1677,6 +1853,10 @@ export class Demuxer implements AsyncDisposable, Disposable {
     }
 
     this.demuxThreadActive = true;
+    this.lastPacketTime = performance.now();
+    if (this.reconnectOptions?.standby) {
+      this.refreshStandby();
+    }
     this.demuxThread = (async () => {
       using packet = new Packet();
       packet.alloc();
@@ -1711,10 +1891,29 @@ export class Demuxer implements AsyncDisposable, Disposable {
           // This can happen with live device capture - retry instead of treating as EOF
           const EAGAIN_POSIX = -11;
           const EAGAIN_MACOS = -35;
+          let stalled = false;
           if (ret === EAGAIN_POSIX || ret === EAGAIN_MACOS) {
-            await new Promise(resolve => setTimeout(resolve, 1));
+            // Non-blocking reads return right away, so the native read timeout never fires
+            stalled = this.reconnectOptions !== null && performance.now() - this.lastPacketTime > this.reconnectOptions.stallTimeout;
+            if (!stalled) {
+              await new Promise(resolve => setTimeout(resolve, 1));
+              continue;
+            }
+          }
+          // Rewind and continue with offset timestamps when looping
+          if (!stalled && this.loopsRemaining !== 0 && (await this.rewindForLoop())) {
             continue;
           }
+          // Replace a lost network connection and continue
+          if (this.reconnectOptions && !this.isClosed && (stalled || this.isLiveInput())) {
+            if (await this.reconnect(ret, stalled || this.formatContext.readStalled)) {
+              continue;
+            }
+          }
+          if (this.isClosed) {
+            break;
+          }
+
           // Actual end of stream - notify all waiting consumers
           this.demuxEof = true;
           for (const resolve of this.queueResolvers.values()) {
@@ -1724,13 +1923,30 @@ export class Demuxer implements AsyncDisposable, Disposable {
           break;
         }
 
+        this.lastPacketTime = performance.now();
+
         // Get stream for timestamp processing
-        const stream = this._streams[packet.streamIndex];
+        const stream = this.currentStreams[packet.streamIndex];
         if (stream) {
           packet.timeBase = stream.timeBase;
+          if (this.options.loop !== 0 || this.reconnectOptions) {
+            this.applyLoopOffset(packet, stream);
+          }
           this.ptsWrapAroundCorrection(packet, stream);
           this.timestampDiscontinuityProcess(packet, stream);
           this.dtsPredict(packet, stream);
+
+          // Release at the packet's DTS in real time (no wait if already due)
+          if (this.pacer) {
+            const pending = this.pacer.wait(packet.dts !== AV_NOPTS_VALUE ? packet.dts : packet.pts, stream.timeBase);
+            if (pending) {
+              await pending;
+              if (this.isClosed || !this.demuxThreadActive) {
+                packet.unref();
+                break;
+              }
+            }
+          }
         }
 
         // Find which queues need this packet
@@ -1762,6 +1978,10 @@ export class Demuxer implements AsyncDisposable, Disposable {
 
         // Add to first queue and resolve waiting promise
         const firstKey = targetQueues[0].event.replace('packet-', '') === 'all' ? 'all' : packet.streamIndex;
+        const arrival = this.trackArrivals ? performance.now() : 0;
+        if (this.trackArrivals) {
+          this.packetArrivals.set(firstClone, arrival);
+        }
         targetQueues[0].queue.push(firstClone);
         const firstResolver = this.queueResolvers.get(firstKey);
         if (firstResolver) {
@@ -1776,6 +1996,9 @@ export class Demuxer implements AsyncDisposable, Disposable {
             throw new Error('Failed to clone packet for additional queue (out of memory)');
           }
           const queueKey = targetQueues[i].event.replace('packet-', '') === 'all' ? 'all' : packet.streamIndex;
+          if (this.trackArrivals) {
+            this.packetArrivals.set(additionalClone, arrival);
+          }
           targetQueues[i].queue.push(additionalClone);
           const resolver = this.queueResolvers.get(queueKey);
           if (resolver) {
@@ -1791,6 +2014,325 @@ export class Demuxer implements AsyncDisposable, Disposable {
     })();
   }
 
+  /**
+   * Shift packet timestamps by the loop offset and track the pass boundaries.
+   *
+   * @param packet - Packet read in the current pass
+   *
+   * @param stream - Stream of the packet
+   *
+   * @internal
+   */
+  private applyLoopOffset(packet: Packet, stream: Stream): void {
+    const { toUs, fromUs } = this.getRescalers(packet.streamIndex, stream.timeBase);
+
+    // A new connection continues right after the last packet of the previous one
+    // (by DTS, so decode order stays monotonic with reordered frames)
+    if (this.rebasePending) {
+      const first = packet.dts !== AV_NOPTS_VALUE ? packet.dts : packet.pts;
+      if (first === AV_NOPTS_VALUE) {
+        return;
+      }
+      this.loopOffset = this.loopEndTs !== AV_NOPTS_VALUE ? this.loopEndTs - toUs.rescale(first) : 0n;
+      this.rebasePending = false;
+    }
+
+    if (this.loopOffset !== 0n) {
+      const offset = fromUs.rescale(this.loopOffset);
+      if (packet.pts !== AV_NOPTS_VALUE) {
+        packet.pts += offset;
+      }
+      if (packet.dts !== AV_NOPTS_VALUE) {
+        packet.dts += offset;
+      }
+    }
+
+    const ts = packet.pts !== AV_NOPTS_VALUE ? packet.pts : packet.dts;
+    if (ts === AV_NOPTS_VALUE) {
+      return;
+    }
+
+    // At least one tick, so the next pass never repeats the last timestamp
+    const start = toUs.rescale(ts);
+    const end = toUs.rescale(ts + (packet.duration > 0n ? packet.duration : 1n));
+    if (this.loopOffset === 0n && (this.loopFirstTs === AV_NOPTS_VALUE || start < this.loopFirstTs)) {
+      this.loopFirstTs = start;
+    }
+    if (this.loopEndTs === AV_NOPTS_VALUE || end > this.loopEndTs) {
+      this.loopEndTs = end;
+    }
+    this.loopPassPackets++;
+  }
+
+  /**
+   * Rewind the input for the next loop pass.
+   *
+   * @returns True if the input was rewound, false if looping ends here
+   *
+   * @internal
+   */
+  private async rewindForLoop(): Promise<boolean> {
+    // An empty pass would loop forever without producing packets
+    if (this.loopPassPackets === 0 || this.loopFirstTs === AV_NOPTS_VALUE || this.loopEndTs === AV_NOPTS_VALUE) {
+      return false;
+    }
+
+    const startTime = this.formatContext.startTime;
+    const ret = await this.formatContext.seekFrame(-1, startTime !== AV_NOPTS_VALUE ? startTime : 0n, AVSEEK_FLAG_BACKWARD);
+    if (ret < 0 || this.isClosed) {
+      return false;
+    }
+
+    this.loopOffset = this.loopEndTs - this.loopFirstTs;
+    this.loopPassPackets = 0;
+    if (this.loopsRemaining > 0) {
+      this.loopsRemaining--;
+    }
+    return true;
+  }
+
+  /**
+   * Check whether the input is a live network stream.
+   *
+   * End of file on such inputs means the connection was closed.
+   *
+   * @returns True if the input has no seekable I/O context
+   *
+   * @internal
+   */
+  private isLiveInput(): boolean {
+    const pb = this.formatContext.pb;
+    return !pb || pb.seekable === 0;
+  }
+
+  /**
+   * Replace a lost connection.
+   *
+   * Tries the standby connection first, then reconnects with exponential
+   * backoff. The new connection is only used if its streams match, so
+   * decoders created from the original streams keep working.
+   *
+   * @param error - Error of the failed read
+   *
+   * @param stalled - Whether the read stalled
+   *
+   * @returns True if reading can continue on a new connection
+   *
+   * @internal
+   */
+  private async reconnect(error: number, stalled: boolean): Promise<boolean> {
+    const options = this.reconnectOptions!;
+    if (stalled) {
+      this.reconnectStats.stalls++;
+    }
+    options.onDisconnect?.(error, stalled);
+
+    // The stream objects handed out belong to the first connection, so it is only
+    // suspended (no more network traffic) and closed in close(). A stalled
+    // server would not answer PAUSE, so it is not sent
+    if (this.formatContext !== this.originContext) {
+      await this.formatContext.closeInput();
+    } else {
+      await this.originContext.suspendInput(!stalled).catch(() => 0);
+    }
+
+    for (let attempt = 1; options.maxAttempts < 0 || attempt <= options.maxAttempts; attempt++) {
+      let ctx = this.standby;
+      this.standby = null;
+      this.reconnectStats.standbyReady = false;
+      const fromStandby = ctx !== null;
+
+      if (ctx) {
+        // A failed resume shows up as a read error on the next packet
+        await ctx.readPlay();
+      } else {
+        if (attempt > 1) {
+          const delay = Math.min(options.delay * 2 ** (attempt - 2), options.maxDelay);
+          await new Promise((resolve) => setTimeout(resolve, delay));
+        }
+        if (this.isClosed || !this.demuxThreadActive) {
+          return false;
+        }
+        ctx = await Demuxer.connect(this.url!, this.options, options.stallTimeout).catch(() => null);
+      }
+
+      if (!ctx) {
+        this.reconnectStats.failedAttempts++;
+        continue;
+      }
+      if (this.isClosed || !this.demuxThreadActive) {
+        await ctx.closeInput();
+        return false;
+      }
+      if (!this.hasSameStreams(ctx)) {
+        await ctx.closeInput();
+        this.reconnectStats.gaveUp = 'parameters';
+        return false;
+      }
+
+      this.formatContext = ctx;
+      this.currentStreams = ctx.streams ?? [];
+      this.rebasePending = true;
+      this.lastPacketTime = performance.now();
+      this.reconnectStats.reconnects++;
+      if (fromStandby) {
+        this.reconnectStats.standbyFailovers++;
+      }
+      if (options.standby) {
+        this.refreshStandby();
+      }
+      options.onReconnect?.(attempt, fromStandby);
+      return true;
+    }
+
+    this.reconnectStats.gaveUp = 'attempts';
+    return false;
+  }
+
+  /**
+   * Check whether a new connection has the same streams as the first one.
+   *
+   * @param ctx - Newly opened format context
+   *
+   * @returns True if stream count and codec parameters match
+   *
+   * @internal
+   */
+  private hasSameStreams(ctx: FormatContext): boolean {
+    const streams = ctx.streams ?? [];
+    if (streams.length !== this._streams.length) {
+      return false;
+    }
+
+    return streams.every((stream, i) => {
+      const a = this._streams[i].codecpar;
+      const b = stream.codecpar;
+      const extraA = a.extradata;
+      const extraB = b.extradata;
+      return (
+        a.codecType === b.codecType &&
+        a.codecId === b.codecId &&
+        a.width === b.width &&
+        a.height === b.height &&
+        a.sampleRate === b.sampleRate &&
+        a.channels === b.channels &&
+        (extraA && extraB ? extraA.equals(extraB) : extraA === extraB)
+      );
+    });
+  }
+
+  /**
+   * Open a new connection to the input URL.
+   *
+   * Same steps as {@link open} for URL inputs.
+   *
+   * @param url - Resolved input URL
+   *
+   * @param options - Options the demuxer was opened with
+   *
+   * @param stallTimeout - Read timeout in milliseconds, also bounds opening and probing
+   *
+   * @returns Opened format context with stream info and the read timeout set
+   *
+   * @throws {FFmpegError} If opening or probing fails or times out
+   *
+   * @internal
+   */
+  private static async connect(url: string, options: Required<DemuxerOptions>, stallTimeout: number): Promise<FormatContext> {
+    const formatContext = new FormatContext();
+    const optionsDict = Object.keys(options.options).length > 0 ? Dictionary.fromObject(options.options) : null;
+    const inputFormat = options.format ? InputFormat.findInputFormat(options.format) : null;
+
+    // A server that accepts the connection but never answers must not block the reconnect
+    formatContext.readTimeout = stallTimeout;
+
+    try {
+      let ret = await formatContext.openInput(url, inputFormat, optionsDict);
+      FFmpegError.throwIfError(ret, 'Failed to open input');
+      if (!options.blocking) {
+        formatContext.setFlags(AVFMT_FLAG_NONBLOCK);
+      }
+
+      if (!options.skipStreamInfo) {
+        // Probing reads up to analyzeduration of media, which takes that long on a live source
+        const analyzeMs = Number(options.options.analyzeduration ?? 5000000) / 1000;
+        formatContext.readTimeout = stallTimeout + (Number.isFinite(analyzeMs) ? analyzeMs : 5000);
+        ret = await formatContext.findStreamInfo(null);
+        formatContext.readTimeout = stallTimeout;
+        FFmpegError.throwIfError(ret, 'Failed to find stream info');
+
+        for (const stream of formatContext.streams ?? []) {
+          const codecpar = stream.codecpar;
+          if (codecpar.codecType === AVMEDIA_TYPE_VIDEO && (codecpar.width === 0 || codecpar.height === 0) && codecpar.extradataSize > 0) {
+            codecpar.parseExtradata();
+          }
+        }
+      }
+      return formatContext;
+    } catch (error) {
+      await formatContext.closeInput();
+      throw error;
+    } finally {
+      optionsDict?.free();
+    }
+  }
+
+  /**
+   * Open (or re-open) the paused standby connection in the background.
+   *
+   * @internal
+   */
+  private refreshStandby(): void {
+    const options = this.reconnectOptions;
+    if (!options || this.standbyTask || this.isClosed) {
+      return;
+    }
+    if (this.standbyTimer) {
+      clearTimeout(this.standbyTimer);
+      this.standbyTimer = null;
+    }
+
+    this.standbyTask = (async () => {
+      // Paused sessions expire on the server, so the standby is replaced periodically
+      const previous = this.standby;
+      this.standby = null;
+      this.reconnectStats.standbyReady = false;
+      await previous?.closeInput();
+
+      const ctx = await Demuxer.connect(this.url!, this.options, options.stallTimeout).catch(() => null);
+      if (ctx) {
+        await ctx.readPause();
+      }
+      if (this.isClosed || !this.demuxThreadActive) {
+        await ctx?.closeInput();
+        return;
+      }
+
+      this.standby = ctx;
+      this.reconnectStats.standbyReady = ctx !== null;
+      this.standbyTimer = setTimeout(() => this.refreshStandby(), options.standbyRefresh);
+      this.standbyTimer.unref();
+    })().finally(() => {
+      this.standbyTask = null;
+    });
+  }
+
+  /**
+   * Close the standby connection and stop refreshing it.
+   *
+   * @internal
+   */
+  private async closeStandby(): Promise<void> {
+    if (this.standbyTimer) {
+      clearTimeout(this.standbyTimer);
+      this.standbyTimer = null;
+    }
+    // A standby still connecting closes itself once it sees the demuxer closed
+    await this.standby?.closeInput();
+    this.standby = null;
+    this.reconnectStats.standbyReady = false;
+  }
+
   /**
    * Stop the internal demux thread.
    *
@@ -1842,12 +2384,38 @@ export class Demuxer implements AsyncDisposable, Disposable {
         firstDts: AV_NOPTS_VALUE,
         nextDts: AV_NOPTS_VALUE,
         dts: AV_NOPTS_VALUE,
+        rescalers: null,
       };
       this.streamStates.set(streamIndex, state);
     }
     return state;
   }
 
+  /**
+   * Get the timestamp rescalers of a stream.
+   *
+   * Recreated only when the time base changes (e.g. after a reconnect).
+   *
+   * @param streamIndex - Stream index
+   *
+   * @param timeBase - Stream time base
+   *
+   * @returns Rescalers from and to AV_TIME_BASE_Q
+   *
+   * @internal
+   */
+  private getRescalers(streamIndex: number, timeBase: IRational): StreamRescalers {
+    const state = this.getStreamState(streamIndex);
+    if (!state.rescalers?.toUs.matches(timeBase, AV_TIME_BASE_Q)) {
+      state.rescalers = {
+        toUs: TimestampRescaler.create(timeBase, AV_TIME_BASE_Q),
+        toUsPassMinMax: TimestampRescaler.create(timeBase, AV_TIME_BASE_Q, AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX),
+        fromUs: TimestampRescaler.create(AV_TIME_BASE_Q, timeBase),
+      };
+    }
+    return state.rescalers;
+  }
+
   /**
    * PTS Wrap-Around Correction.
    *
@@ -1885,7 +2453,7 @@ export class Demuxer implements AsyncDisposable, Disposable {
 
     // Rescale start_time to packet's timebase
     // Note: packet.timeBase was set to stream.timeBase in packets() generator
-    const stime = avRescaleQ(startTime, AV_TIME_BASE_Q, packet.timeBase);
+    const stime = this.getRescalers(packet.streamIndex, packet.timeBase).fromUs.rescale(startTime);
     const stime2 = stime + (1n << BigInt(ptsWrapBits));
 
     state.wrapCorrectionDone = true;
@@ -1979,13 +2547,14 @@ export class Demuxer implements AsyncDisposable, Disposable {
     let disableDiscontinuityCorrection = this.options.copyTs;
 
     // Rescale packet DTS to AV_TIME_BASE for comparison
-    const pktDts = avRescaleQRnd(packet.dts, packet.timeBase, AV_TIME_BASE_Q, (AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX) as any);
+    const { toUs, toUsPassMinMax, fromUs } = this.getRescalers(packet.streamIndex, packet.timeBase);
+    const pktDts = toUsPassMinMax.rescale(packet.dts);
 
     // PTS wrap-around detection
     // Only applies when copyTs is enabled and stream has limited timestamp bits
     if (this.options.copyTs && state.nextDts !== AV_NOPTS_VALUE && fmtIsDiscont && stream.ptsWrapBits < 60) {
       // Calculate wrapped DTS by adding 2^pts_wrap_bits to packet DTS
-      const wrapDts = avRescaleQRnd(packet.dts + (1n << BigInt(stream.ptsWrapBits)), packet.timeBase, AV_TIME_BASE_Q, (AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX) as any);
+      const wrapDts = toUsPassMinMax.rescale(packet.dts + (1n << BigInt(stream.ptsWrapBits)));
 
       // If wrapped DTS is closer to predicted nextDts, enable correction
       const wrapDelta = wrapDts > state.nextDts ? wrapDts - state.nextDts : state.nextDts - wrapDts;
@@ -2008,7 +2577,7 @@ export class Demuxer implements AsyncDisposable, Disposable {
           this.tsOffsetDiscont -= delta;
 
           // Apply correction to packet
-          const deltaInPktTb = avRescaleQ(delta, AV_TIME_BASE_Q, packet.timeBase);
+          const deltaInPktTb = fromUs.rescale(delta);
           packet.dts -= deltaInPktTb;
           if (packet.pts !== AV_NOPTS_VALUE) {
             packet.pts -= deltaInPktTb;
@@ -2025,7 +2594,7 @@ export class Demuxer implements AsyncDisposable, Disposable {
 
         // Check PTS
         if (packet.pts !== AV_NOPTS_VALUE) {
-          const pktPts = avRescaleQ(packet.pts, packet.timeBase, AV_TIME_BASE_Q);
+          const pktPts = toUs.rescale(packet.pts);
           const ptsDelta = pktPts - state.nextDts;
           if (ptsDelta > threshold || ptsDelta < -threshold) {
             packet.pts = AV_NOPTS_VALUE;
@@ -2041,7 +2610,7 @@ export class Demuxer implements AsyncDisposable, Disposable {
         this.tsOffsetDiscont -= delta;
 
         // Apply correction to packet
-        const deltaInPktTb = avRescaleQ(delta, AV_TIME_BASE_Q, packet.timeBase);
+        const deltaInPktTb = fromUs.rescale(delta);
         packet.dts -= deltaInPktTb;
         if (packet.pts !== AV_NOPTS_VALUE) {
           packet.pts -= deltaInPktTb;
@@ -2050,7 +2619,7 @@ export class Demuxer implements AsyncDisposable, Disposable {
     }
 
     // Update last timestamp
-    this.lastTs = avRescaleQ(packet.dts, packet.timeBase, AV_TIME_BASE_Q);
+    this.lastTs = toUs.rescale(packet.dts);
   }
 
   /**
@@ -2074,7 +2643,7 @@ export class Demuxer implements AsyncDisposable, Disposable {
   private timestampDiscontinuityProcess(packet: Packet, stream: Stream): void {
     // Apply previously-detected discontinuity offset
     // This applies to ALL streams, not just audio/video
-    const offset = avRescaleQ(this.tsOffsetDiscont, AV_TIME_BASE_Q, packet.timeBase);
+    const offset = this.getRescalers(packet.streamIndex, packet.timeBase).fromUs.rescale(this.tsOffsetDiscont);
     if (packet.dts !== AV_NOPTS_VALUE) {
       packet.dts += offset;
     }
@@ -2120,6 +2689,9 @@ export class Demuxer implements AsyncDisposable, Disposable {
     // Signal demux thread to stop FIRST
     this.demuxThreadActive = false;
 
+    // Release a pending pacing wait so the demux thread can exit
+    this.pacer?.close();
+
     // Set EOF flag so generators know to exit
     this.demuxEof = true;
 
@@ -2138,6 +2710,14 @@ export class Demuxer implements AsyncDisposable, Disposable {
     // Close FormatContext - this may interrupt blocking readFrame()
     await this.formatContext.closeInput();
 
+    // Connections kept by reconnecting
+    if (this.reconnectOptions) {
+      await this.closeStandby();
+      if (this.originContext !== this.formatContext) {
+        await this.originContext.closeInput();
+      }
+    }
+
     // Wait for demux thread with timeout to avoid hanging on blocked reads
     if (this.demuxThread) {
       const threadPromise = this.demuxThread;
@@ -2198,8 +2778,18 @@ export class Demuxer implements AsyncDisposable, Disposable {
 
     // Close FormatContext
     this.formatContext.closeInputSync();
+    if (this.originContext !== this.formatContext) {
+      this.originContext.closeInputSync();
+    }
+    if (this.standbyTimer) {
+      clearTimeout(this.standbyTimer);
+      this.standbyTimer = null;
+    }
+    this.standby?.closeInputSync();
+    this.standby = null;
 
     this.demuxThreadActive = false;
+    this.pacer?.close();
 
     for (const queue of this.packetQueues.values()) {
       for (const packet of queue) {
@@ -22,12 +22,13 @@ import { Dictionary } from '../lib/dictionary.js';
 import { FFmpegError } from '../lib/error.js';
 import { Frame } from '../lib/frame.js';
 import { Packet } from '../lib/packet.js';
+import { PipelineStage } from '../lib/pipeline-stage.js';
 import { Rational } from '../lib/rational.js';
-import { avRescaleQ } from '../lib/utilities.js';
+import { TimestampRescaler } from '../lib/timestamp-rescaler.js';
 import { AudioFrameBuffer } from './audio-frame-buffer.js';
 import { FRAME_THREAD_QUEUE_SIZE, PACKET_THREAD_QUEUE_SIZE } from './constants.js';
 import { AsyncQueue } from './utilities/async-queue.js';
-import { SchedulerControl } from './utilities/scheduler.js';
+import { forwardStage, SchedulerControl } from './utilities/scheduler.js';
 import { parseBitrate } from './utils.js';
 
 import type { AVCodecFlag, AVCodecID, AVPixelFormat, AVSampleFormat, EOFSignal, FFEncoderCodec } from '../constants/index.js';
@@ -103,6 +104,7 @@ export class Encoder implements Disposable {
   private opts?: Dictionary | null;
   private options: EncoderOptions;
   private audioFrameBuffer?: AudioFrameBuffer;
+  private tsRescaler: TimestampRescaler | null = null;
 
   // Worker pattern for push-based processing
   private inputQueue: AsyncQueue<Frame>;
@@ -110,6 +112,9 @@ export class Encoder implements Disposable {
   private workerPromise: Promise<void> | null = null;
   private pipeToPromise: Promise<void> | null = null;
 
+  // Native stage, used instead of the worker when fed by an upstream stage
+  private stage: PipelineStage | null = null;
+
   /**
    * @param codecContext - Configured codec context
    *
@@ -1407,8 +1412,16 @@ export class Encoder implements Disposable {
    * ```typescript
    * decoder.pipeTo(filter).pipeTo(encoder)
    * ```
+   *
+   * @see {@link PipelineStage} For when components are linked with native stages
    */
   pipeTo(target: Muxer, streamIndex: number): SchedulerControl<Frame> {
+    if (this.stage) {
+      // Tail of a native stage chain
+      this.pipeToPromise = forwardStage(this.stage, target, streamIndex);
+      return new SchedulerControl<Frame>(this as unknown as SchedulableComponent<Frame>);
+    }
+
     // Start worker if not already running
     this.workerPromise ??= this.runWorker();
 
@@ -1455,6 +1468,9 @@ export class Encoder implements Disposable {
     this.inputQueue.close();
     this.outputQueue.close();
 
+    // The stage thread uses the codec context
+    this.stage?.stopSync();
+
     this.packet.free();
     this.codecContext.freeContext();
 
@@ -1599,6 +1615,38 @@ export class Encoder implements Disposable {
     return await this.outputQueue.receive();
   }
 
+  /**
+   * Open the encoder from the upstream output parameters and create a native stage.
+   *
+   * Only video encoders that have not been initialized yet can be linked.
+   *
+   * @param template - Frame carrying the upstream output parameters (no data)
+   *
+   * @returns Encoder stage, or null to keep the JavaScript worker
+   *
+   * @internal
+   */
+  linkStage(template: Frame): PipelineStage | null {
+    if (this.isClosed || this.initialized || this.workerPromise || !template.isVideo()) {
+      return null;
+    }
+
+    this.initializeSync(template);
+    this.stage = PipelineStage.create('encoder', this.codecContext);
+    return this.stage;
+  }
+
+  /**
+   * Forwarding task of the native stage chain tail.
+   *
+   * @returns Promise settling once the chain has drained, or null if not piped yet
+   *
+   * @internal
+   */
+  stageDrained(): Promise<void> | null {
+    return this.pipeToPromise;
+  }
+
   /**
    * Initialize encoder from first frame.
    *
@@ -1919,6 +1967,9 @@ export class Encoder implements Disposable {
     // - Audio: frame.timeBase from first frame (typically 1/sample_rate)
     const encoderTimebase = this.codecContext.timeBase;
     const oldTimebase = frame.timeBase;
+    if (!this.tsRescaler?.matches(oldTimebase, encoderTimebase)) {
+      this.tsRescaler = TimestampRescaler.create(oldTimebase, encoderTimebase);
+    }
 
     // IMPORTANT: Calculate duration BEFORE converting frame timebase
     // This matches FFmpeg's video_sync_process() which calculates:
@@ -1929,7 +1980,7 @@ export class Encoder implements Disposable {
     if (frame.duration && frame.duration > 0n) {
       // Convert duration from frame timebase to encoder timebase
       // This ensures encoder gets correct frame duration for timestamps
-      frameDuration = avRescaleQ(frame.duration, oldTimebase, encoderTimebase);
+      frameDuration = this.tsRescaler.rescale(frame.duration);
     } else {
       // Default to 1 (constant frame rate behavior)
       // Matches FFmpeg's CFR mode: frame->duration = 1
@@ -1938,7 +1989,7 @@ export class Encoder implements Disposable {
 
     if (frame.pts !== null && frame.pts !== undefined) {
       // Convert PTS to encoder timebase
-      frame.pts = avRescaleQ(frame.pts, oldTimebase, encoderTimebase);
+      frame.pts = this.tsRescaler.rescale(frame.pts);
 
       // IMPORTANT: Set frame timebase to encoder timebase
       // FFmpeg does this in adjust_frame_pts_to_encoder_tb(): frame->time_base = tb_dst
@@ -13,18 +13,20 @@ import { FilterGraph } from '../lib/filter-graph.js';
 import { FilterInOut } from '../lib/filter-inout.js';
 import { Filter } from '../lib/filter.js';
 import { Frame } from '../lib/frame.js';
+import { PipelineStage } from '../lib/pipeline-stage.js';
 import { Rational } from '../lib/rational.js';
+import { TimestampRescaler } from '../lib/timestamp-rescaler.js';
 import { avGetSampleFmtName, avInvQ, avRescaleQ } from '../lib/utilities.js';
 import { FRAME_THREAD_QUEUE_SIZE } from './constants.js';
 import { AsyncQueue } from './utilities/async-queue.js';
-import { Scheduler } from './utilities/scheduler.js';
+import { forwardStage, Scheduler } from './utilities/scheduler.js';
 
 import type { AVBufferSrcFlag, AVColorRange, AVColorSpace, AVFilterCmdFlag, AVPixelFormat, AVSampleFormat, EOFSignal } from '../constants/index.js';
 import type { FilterContext } from '../lib/filter-context.js';
 import type { ChannelLayout, IDimension, IRational } from '../lib/types.js';
 import type { Encoder } from './encoder.js';
 import type { FilterOptions } from './types.js';
-import type { SchedulableComponent } from './utilities/scheduler.js';
+import type { SchedulableComponent, StageLinkable } from './utilities/scheduler.js';
 
 /**
  * High-level filter API for audio and video processing.
@@ -77,6 +79,9 @@ export class FilterAPI implements Disposable {
   // Auto-calculated timeBase from first frame
   private calculatedTimeBase: IRational | null = null;
 
+  // Frame timeBase -> calculatedTimeBase, recreated when either changes
+  private tsRescaler: TimestampRescaler | null = null;
+
   // Track last frame properties for change detection (for dropOnChange/allowReinit)
   private lastFrameProps: {
     format: number;
@@ -93,6 +98,10 @@ export class FilterAPI implements Disposable {
   private nextComponent: SchedulableComponent<Frame> | null = null;
   private pipeToPromise: Promise<void> | null = null;
 
+  // Native stage, used instead of the worker when fed by an upstream stage
+  private stage: PipelineStage | null = null;
+  private stageNext: StageLinkable | null = null;
+
   /**
    * @param graph - Filter graph instance
    *
@@ -592,8 +601,11 @@ export class FilterAPI implements Disposable {
     // Rescale timestamps to filter's timeBase
     if (this.calculatedTimeBase) {
       const originalTimeBase = frame.timeBase;
-      frame.pts = avRescaleQ(frame.pts, originalTimeBase, this.calculatedTimeBase);
-      frame.duration = avRescaleQ(frame.duration, originalTimeBase, this.calculatedTimeBase);
+      if (!this.tsRescaler?.matches(originalTimeBase, this.calculatedTimeBase)) {
+        this.tsRescaler = TimestampRescaler.create(originalTimeBase, this.calculatedTimeBase);
+      }
+      frame.pts = this.tsRescaler.rescale(frame.pts);
+      frame.duration = this.tsRescaler.rescale(frame.duration);
       frame.timeBase = new Rational(this.calculatedTimeBase.num, this.calculatedTimeBase.den);
     }
 
@@ -674,8 +686,11 @@ export class FilterAPI implements Disposable {
     // Rescale timestamps to filter's timeBase
     if (this.calculatedTimeBase) {
       const originalTimeBase = frame.timeBase;
-      frame.pts = avRescaleQ(frame.pts, originalTimeBase, this.calculatedTimeBase);
-      frame.duration = avRescaleQ(frame.duration, originalTimeBase, this.calculatedTimeBase);
+      if (!this.tsRescaler?.matches(originalTimeBase, this.calculatedTimeBase)) {
+        this.tsRescaler = TimestampRescaler.create(originalTimeBase, this.calculatedTimeBase);
+      }
+      frame.pts = this.tsRescaler.rescale(frame.pts);
+      frame.duration = this.tsRescaler.rescale(frame.duration);
       frame.timeBase = new Rational(this.calculatedTimeBase.num, this.calculatedTimeBase.den);
     }
 
@@ -1437,6 +1452,8 @@ export class FilterAPI implements Disposable {
    * ```typescript
    * decoder.pipeTo(filter).pipeTo(encoder)
    * ```
+   *
+   * @see {@link PipelineStage} For when components are linked with native stages
    */
   pipeTo(target: FilterAPI): Scheduler<Frame>;
   pipeTo(target: Encoder): Scheduler<Frame>;
@@ -1446,6 +1463,23 @@ export class FilterAPI implements Disposable {
     // Store reference to next component for flush propagation
     this.nextComponent = t;
 
+    if (this.stage) {
+      // Fed by an upstream stage: link the target natively if it can run on one
+      const template = this.options.hardware ? null : this.createOutputTemplate();
+      const next = template ? (target as unknown as StageLinkable).linkStage(template) : null;
+      template?.free();
+
+      if (next) {
+        this.stage.connect(next);
+        this.stage.start();
+        this.stageNext = target as unknown as StageLinkable;
+      } else {
+        this.pipeToPromise = forwardStage(this.stage, t);
+      }
+
+      return new Scheduler<Frame>(this as unknown as SchedulableComponent<Frame>, t);
+    }
+
     // Start worker if not already running
     this.workerPromise ??= this.runWorker();
 
@@ -1486,6 +1520,9 @@ export class FilterAPI implements Disposable {
     this.inputQueue.close();
     this.outputQueue.close();
 
+    // The stage thread uses the graph
+    this.stage?.stopSync();
+
     this.frame.free();
     this.graph.free();
     this.buffersrcCtx = null;
@@ -1495,6 +1532,59 @@ export class FilterAPI implements Disposable {
     this.initializePromise = null;
   }
 
+  /**
+   * Configure the graph from the upstream output parameters and create a native stage.
+   *
+   * Only video filters that have not processed any frame yet can be linked.
+   *
+   * @param template - Frame carrying the upstream output parameters (no data)
+   *
+   * @returns Filter stage, or null to keep the JavaScript worker
+   *
+   * @internal
+   */
+  linkStage(template: Frame): PipelineStage | null {
+    if (this.isClosed || this.initialized || this.workerPromise || !template.isVideo()) {
+      return null;
+    }
+
+    this.initializeSync(template);
+    this.stage = PipelineStage.create('filter', this.buffersrcCtx!, this.buffersinkCtx!);
+    return this.stage;
+  }
+
+  /**
+   * Forwarding task of the native stage chain tail.
+   *
+   * @returns Promise settling once the chain has drained, or null if the tail is not piped yet
+   *
+   * @internal
+   */
+  stageDrained(): Promise<void> | null {
+    return this.stageNext ? this.stageNext.stageDrained() : this.pipeToPromise;
+  }
+
+  /**
+   * Build a frame carrying the buffersink output parameters.
+   *
+   * @returns Template frame without data
+   *
+   * @internal
+   */
+  private createOutputTemplate(): Frame {
+    const sink = this.buffersinkCtx!;
+    const frame = new Frame();
+    frame.alloc();
+    frame.format = sink.buffersinkGetFormat();
+    frame.width = sink.buffersinkGetWidth();
+    frame.height = sink.buffersinkGetHeight();
+    frame.sampleAspectRatio = sink.buffersinkGetSampleAspectRatio();
+    frame.colorSpace = sink.buffersinkGetColorspace();
+    frame.colorRange = sink.buffersinkGetColorRange();
+    frame.timeBase = sink.buffersinkGetTimeBase();
+    return frame;
+  }
+
   /**
    * Worker loop for push-based processing.
    *
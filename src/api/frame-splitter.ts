@@ -0,0 +1,426 @@
+import { FRAME_THREAD_QUEUE_SIZE } from './constants.js';
+
+import type { Frame } from '../lib/frame.js';
+import type { FrameSplitterBranchOptions, FrameSplitterBranchStats, FrameSplitterDropPolicy } from './types.js';
+
+/**
+ * Per-branch queue state.
+ *
+ * @internal
+ */
+interface BranchState {
+  queue: (Frame | null)[];
+  capacity: number;
+  dropPolicy: FrameSplitterDropPolicy;
+  receiveWaiter: (() => void) | null;
+  sendWaiter: (() => void) | null;
+  ended: boolean;
+  detached: boolean;
+  delivered: number;
+  dropped: number;
+}
+
+/**
+ * Fan-out stage that decodes once and feeds multiple branches.
+ *
+ * Reads frames from one source (typically `decoder.frames(...)`) and hands
+ * each frame to every branch. Branches receive reference-counted copies
+ * (av_frame_clone, frame data is shared, not copied); the last branch receives
+ * the source frame itself. Each branch has its own bounded queue and drop
+ * policy, so a slow branch (e.g. a 1080p encode) can be configured to not
+ * stall fast ones (e.g. a thumbnail generator).
+ *
+ * Branches are async generators of frames and can be used as the source of
+ * `pipeline()` or passed to `FilterAPI.frames()`/`Encoder.packets()`.
+ * All branches must be created before any of them is consumed.
+ * Frames yielded by a branch are owned by the consumer.
+ *
+ * A splitter created without a source can be placed in a `pipeline()`
+ * named-stages list. The frames reaching it become its source and the stages
+ * after it run on a branch of their own; the other branches are fed from the
+ * same frames and consumed elsewhere.
+ *
+ * @example
+ * ```typescript
+ * import { Decoder, Demuxer, FrameSplitter, pipeline } from 'node-av/api';
+ *
+ * await using input = await Demuxer.open('input.mp4');
+ * const video = input.video()!;
+ * using decoder = await Decoder.create(video);
+ *
+ * // Decode once
+ * await using split = FrameSplitter.create(decoder.frames(input.packets(video.index)));
+ * const hd = split.branch({ queueSize: 8 });
+ * const preview = split.branch({ queueSize: 1, dropPolicy: 'drop-oldest' });
+ *
+ * const hdControl = pipeline(hd, scale1080, encoder1080, output1080);
+ * const previewControl = pipeline(preview, scale360, encoder360, output360);
+ * await Promise.all([hdControl.completion, previewControl.completion]);
+ * ```
+ *
+ * @example
+ * ```typescript
+ * // As a named stage: the pipeline feeds the splitter and encodes one branch
+ * await using split = FrameSplitter.create();
+ * const preview = split.branch({ queueSize: 1, dropPolicy: 'drop-oldest' });
+ *
+ * const hdControl = pipeline(input, { video: [decoder, split, encoder1080] }, output1080);
+ * const previewControl = pipeline(preview, scale360, encoder360, output360);
+ * await Promise.all([hdControl.completion, previewControl.completion]);
+ * ```
+ *
+ * @see {@link Decoder.frames} For the usual frame source
+ * @see {@link Encoder.packets} For consuming branches
+ */
+export class FrameSplitter implements AsyncDisposable {
+  private source: AsyncIterable<Frame | null> | null;
+  private sourceWaiter: ((source: AsyncIterable<Frame | null> | null) => void) | null = null;
+  private branches: BranchState[] = [];
+  private pumpPromise: Promise<void> | null = null;
+  private isClosed = false;
+  private error: Error | null = null;
+
+  /**
+   * @param source - Frame source, or null to attach it later
+   *
+   * @internal
+   */
+  private constructor(source: AsyncIterable<Frame | null> | null) {
+    this.source = source;
+  }
+
+  /**
+   * Create a splitter for a frame source.
+   *
+   * The source is not read until the first branch is consumed.
+   * Without a source, the splitter waits for {@link frames} (called by
+   * `pipeline()` when the splitter is used as a stage).
+   *
+   * @param source - Frame source (e.g. `decoder.frames(input.packets(index))`)
+   *
+   * @returns Splitter without branches
+   *
+   * @example
+   * ```typescript
+   * const split = FrameSplitter.create(decoder.frames(input.packets(video.index)));
+   * ```
+   */
+  static create(source?: AsyncIterable<Frame | null>): FrameSplitter {
+    return new FrameSplitter(source ?? null);
+  }
+
+  /**
+   * Number of branches.
+   */
+  get branchCount(): number {
+    return this.branches.length;
+  }
+
+  /**
+   * Add a branch.
+   *
+   * Must be called before any branch is consumed. The returned generator
+   * yields every source frame (subject to the drop policy), followed by the
+   * null flush marker if the source yields one. Stopping the iteration early
+   * detaches the branch; the other branches continue.
+   *
+   * @param options - Queue size and drop policy
+   *
+   * @returns Frame generator for this branch
+   *
+   * @throws {Error} If consumption has already started or the splitter is closed
+   *
+   * @example
+   * ```typescript
+   * const main = split.branch();
+   * const thumbnails = split.branch({ queueSize: 1, dropPolicy: 'drop-newest' });
+   * ```
+   */
+  branch(options: FrameSplitterBranchOptions = {}): AsyncGenerator<Frame | null> {
+    // Without a source the pump is still waiting, so branches can be added
+    if ((this.pumpPromise && this.source) || this.isClosed) {
+      throw new Error('Branches must be created before the splitter is consumed');
+    }
+
+    const state: BranchState = {
+      queue: [],
+      capacity: Math.max(1, options.queueSize ?? FRAME_THREAD_QUEUE_SIZE),
+      dropPolicy: options.dropPolicy ?? 'block',
+      receiveWaiter: null,
+      sendWaiter: null,
+      ended: false,
+      detached: false,
+      delivered: 0,
+      dropped: 0,
+    };
+    this.branches.push(state);
+
+    return this.consume(state);
+  }
+
+  /**
+   * Attach the source and add a branch for it.
+   *
+   * Used by `pipeline()` to run the splitter as a stage: the stages after
+   * it consume the returned branch. Branches created earlier with
+   * {@link branch} receive the same frames.
+   *
+   * @param source - Frame source
+   *
+   * @param options - Queue size and drop policy for the returned branch
+   *
+   * @returns Frame generator for the new branch
+   *
+   * @throws {Error} If the splitter already has a source or is closed
+   *
+   * @example
+   * ```typescript
+   * const split = FrameSplitter.create();
+   * const preview = split.branch({ queueSize: 1, dropPolicy: 'drop-oldest' });
+   * const main = split.frames(decoder.frames(input.packets(video.index)));
+   * ```
+   */
+  frames(source: AsyncIterable<Frame | null>, options: FrameSplitterBranchOptions = {}): AsyncGenerator<Frame | null> {
+    if (this.source) {
+      throw new Error('Splitter already has a source');
+    }
+
+    const branch = this.branch(options);
+    this.source = source;
+
+    const waiter = this.sourceWaiter;
+    this.sourceWaiter = null;
+    waiter?.(source);
+
+    return branch;
+  }
+
+  /**
+   * Get per-branch statistics, in branch creation order.
+   *
+   * @returns Delivered, dropped and queued frame counts
+   *
+   * @example
+   * ```typescript
+   * const [main, preview] = split.getStats();
+   * console.log(`Preview dropped ${preview.dropped} frames`);
+   * ```
+   */
+  getStats(): FrameSplitterBranchStats[] {
+    return this.branches.map((b) => ({
+      delivered: b.delivered,
+      dropped: b.dropped,
+      queued: b.queue.length,
+    }));
+  }
+
+  /**
+   * Close the splitter.
+   *
+   * Stops reading the source, frees queued frames and ends all branches.
+   * Safe to call multiple times.
+   *
+   * @example
+   * ```typescript
+   * await split.close();
+   * ```
+   */
+  async close(): Promise<void> {
+    if (this.isClosed) {
+      return;
+    }
+
+    this.isClosed = true;
+
+    for (const branch of this.branches) {
+      this.detach(branch);
+    }
+
+    // Release a pump still waiting for its source
+    const waiter = this.sourceWaiter;
+    this.sourceWaiter = null;
+    waiter?.(null);
+
+    await this.pumpPromise?.catch(() => {
+      // Reported through the branches
+    });
+  }
+
+  /**
+   * Dispose of the splitter.
+   *
+   * Implements AsyncDisposable interface for automatic cleanup.
+   * Equivalent to calling close().
+   *
+   * @example
+   * ```typescript
+   * {
+   *   await using split = FrameSplitter.create(frames);
+   *   // Use split...
+   * } // Automatically closed
+   * ```
+   */
+  async [Symbol.asyncDispose](): Promise<void> {
+    await this.close();
+  }
+
+  /**
+   * Branch generator.
+   *
+   * @param state - Branch state
+   *
+   * @yields {Frame | null} Frames for this branch
+   *
+   * @internal
+   */
+  private async *consume(state: BranchState): AsyncGenerator<Frame | null> {
+    this.pumpPromise ??= this.pump();
+
+    try {
+      while (true) {
+        if (state.queue.length > 0) {
+          const frame = state.queue.shift() ?? null;
+          this.wake(state, 'send');
+          if (frame) {
+            state.delivered++;
+          }
+          yield frame;
+          continue;
+        }
+
+        if (state.ended || state.detached) {
+          break;
+        }
+
+        await new Promise<void>((resolve) => (state.receiveWaiter = resolve));
+      }
+
+      if (this.error) {
+        throw this.error;
+      }
+    } finally {
+      this.detach(state);
+    }
+  }
+
+  /**
+   * Read the source and distribute frames to the branches.
+   *
+   * @internal
+   */
+  private async pump(): Promise<void> {
+    try {
+      const source = this.source ?? (await new Promise<AsyncIterable<Frame | null> | null>((resolve) => (this.sourceWaiter = resolve)));
+      if (!source) {
+        return;
+      }
+
+      for await (const frame of source) {
+        const live = this.branches.filter((b) => !b.detached);
+        if (this.isClosed || live.length === 0) {
+          frame?.free();
+          break;
+        }
+
+        // Clone for all but the last branch, which takes the source frame
+        for (let i = 0; i < live.length; i++) {
+          let item: Frame | null = frame;
+          if (frame && i < live.length - 1) {
+            item = frame.clone();
+            if (!item) {
+              frame.free();
+              throw new Error('Failed to reference frame for split branch');
+            }
+          }
+          await this.deliver(live[i], item);
+        }
+      }
+    } catch (error) {
+      this.error = error instanceof Error ? error : new Error(String(error));
+    } finally {
+      for (const branch of this.branches) {
+        branch.ended = true;
+        this.wake(branch, 'receive');
+      }
+    }
+  }
+
+  /**
+   * Queue a frame for a branch, applying its drop policy.
+   *
+   * @param branch - Target branch
+   *
+   * @param frame - Frame (owned by the splitter until queued) or null flush marker
+   *
+   * @internal
+   */
+  private async deliver(branch: BranchState, frame: Frame | null): Promise<void> {
+    // The flush marker is never dropped
+    while (frame && branch.queue.length >= branch.capacity && !branch.detached) {
+      if (branch.dropPolicy === 'drop-newest') {
+        branch.dropped++;
+        frame.free();
+        return;
+      }
+
+      if (branch.dropPolicy === 'drop-oldest') {
+        const index = branch.queue.findIndex((f) => f !== null);
+        if (index >= 0) {
+          branch.queue.splice(index, 1)[0]!.free();
+          branch.dropped++;
+          continue;
+        }
+      }
+
+      await new Promise<void>((resolve) => (branch.sendWaiter = resolve));
+    }
+
+    if (branch.detached) {
+      frame?.free();
+      return;
+    }
+
+    branch.queue.push(frame);
+    this.wake(branch, 'receive');
+  }
+
+  /**
+   * Stop delivering to a branch and free its queued frames.
+   *
+   * @param branch - Branch to detach
+   *
+   * @internal
+   */
+  private detach(branch: BranchState): void {
+    if (branch.detached) {
+      return;
+    }
+
+    branch.detached = true;
+    for (const frame of branch.queue) {
+      frame?.free();
+    }
+    branch.queue = [];
+    this.wake(branch, 'send');
+    this.wake(branch, 'receive');
+  }
+
+  /**
+   * Resolve a pending wait on a branch.
+   *
+   * @param branch - Branch
+   *
+   * @param side - Which waiter to wake
+   *
+   * @internal
+   */
+  private wake(branch: BranchState, side: 'send' | 'receive'): void {
+    const waiter = side === 'send' ? branch.sendWaiter : branch.receiveWaiter;
+    if (side === 'send') {
+      branch.sendWaiter = null;
+    } else {
+      branch.receiveWaiter = null;
+    }
+    waiter?.();
+  }
+}
@@ -1,9 +1,10 @@
+import { createHash } from 'node:crypto';
+import { mkdirSync, readFileSync, renameSync, statSync, writeFileSync } from 'node:fs';
+import { mkdir, readFile, rename, writeFile } from 'node:fs/promises';
 import { dirname, join } from 'node:path';
 import { fileURLToPath } from 'node:url';
 
 import {
-  AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX,
-  AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX,
   AV_CODEC_ID_AV1,
   AV_CODEC_ID_H263,
   AV_CODEC_ID_H264,
@@ -45,15 +46,17 @@ import { Codec } from '../lib/codec.js';
 import { Dictionary } from '../lib/dictionary.js';
 import { FFmpegError } from '../lib/error.js';
 import { HardwareDeviceContext } from '../lib/hardware-device-context.js';
+import { Registry } from '../lib/registry.js';
 import { Stream } from '../lib/stream.js';
-import { avGetHardwareDeviceTypeFromName } from '../lib/utilities.js';
+import { avGetHardwareDeviceTypeFromName, getFFmpegInfo } from '../lib/utilities.js';
 import { Decoder } from './decoder.js';
 import { Demuxer } from './demuxer.js';
 import { Encoder } from './encoder.js';
 
 import type { AVCodecID, AVHWDeviceType, AVPixelFormat, FFDecoderCodec, FFEncoderCodec, FFHWDeviceType } from '../constants/index.js';
 import type { Packet } from '../lib/packet.js';
-import type { BaseCodecName, HardwareOptions } from './types.js';
+import type { HardwareDeviceCapability } from '../lib/types.js';
+import type { BaseCodecName, HardwareCapabilities, HardwareDeviceCapabilities, HardwareOptions, HardwareProbeOptions } from './types.js';
 
 const __filename = fileURLToPath(import.meta.url);
 const __dirname = dirname(__filename);
@@ -64,6 +67,12 @@ const vp9Data = join(__dirname, 'data', 'test_vp9.ivf');
 const av1Data = join(__dirname, 'data', 'test_av1.ivf');
 const mjpegData = join(__dirname, 'data', 'test_mjpeg.mjpeg');
 
+// Capability cache file format version (part of the cache key)
+const CAPABILITY_CACHE_VERSION = 1;
+
+// Capability matrices probed or loaded by this process, by cache key
+const capabilityMemo = new Map<string, HardwareCapabilities>();
+
 /**
  * High-level hardware acceleration management.
  *
@@ -152,6 +161,15 @@ export class HardwareContext implements Disposable {
    * @see {@link listAvailable} To check available types
    */
   static auto(options: HardwareOptions = {}): HardwareContext | null {
+    if (options.capabilityCache) {
+      const capabilities = this.probeCapabilitiesSync({
+        device: options.device,
+        options: options.options,
+        cacheFile: options.capabilityCache,
+      });
+      return this.autoFromCapabilities(capabilities, options);
+    }
+
     // Platform-specific preference order
     const preferenceOrder = this.getPreferenceOrder();
 
@@ -353,6 +371,148 @@ export class HardwareContext implements Disposable {
     return available;
   }
 
+  /**
+   * Probe the hardware capability matrix of this host.
+   *
+   * Runs the native probe once (device types × codecs × pixel formats for
+   * decoding and encoding, see {@link HardwareDeviceContext.probeCapabilities})
+   * and verifies every available device with one test decode. The result is
+   * kept for the lifetime of the process and, with `cacheFile`, persisted so
+   * later processes skip device creation and test decoding entirely.
+   *
+   * Cache entries are keyed by the FFmpeg build (version, configuration and
+   * library versions), platform and device node; a changed build or device
+   * node invalidates them. Cache read and write errors are ignored. On a
+   * host without hardware the matrix lists the compiled-in device types as
+   * unavailable.
+   *
+   * @param options - Device, cache file and verification options
+   *
+   * @returns Capability matrix
+   *
+   * @example
+   * ```typescript
+   * const caps = await HardwareContext.probeCapabilities({ cacheFile: '/var/cache/app/hwcaps.json' });
+   * for (const device of caps.devices.filter((d) => d.verified)) {
+   *   console.log(device.type, device.encoders.map((c) => c.name).join(', '));
+   * }
+   * ```
+   *
+   * @see {@link probeCapabilitiesSync} For synchronous version
+   * @see {@link auto} With `capabilityCache` to select the device from the cache
+   */
+  static async probeCapabilities(options: HardwareProbeOptions = {}): Promise<HardwareCapabilities> {
+    const key = this.getCapabilityKey(options);
+
+    if (!options.refresh) {
+      const memo = capabilityMemo.get(key);
+      if (memo) {
+        return { ...memo, fromCache: true };
+      }
+      if (options.cacheFile) {
+        const cached = this.parseCapabilityCache(await readFile(options.cacheFile, 'utf8').catch(() => null))[key];
+        if (cached) {
+          capabilityMemo.set(key, cached);
+          return { ...cached, fromCache: true };
+        }
+      }
+    }
+
+    this.prepareDeviceEnvironment();
+    const optionsDict = options.options && Object.keys(options.options).length > 0 ? Dictionary.fromObject(options.options) : null;
+    let devices: HardwareDeviceCapability[];
+    try {
+      devices = await HardwareDeviceContext.probeCapabilities(options.device, optionsDict);
+    } finally {
+      optionsDict?.free();
+    }
+
+    const capabilities = this.finishProbe(key, options, devices);
+
+    if (options.cacheFile) {
+      try {
+        const entries = this.parseCapabilityCache(await readFile(options.cacheFile, 'utf8').catch(() => null));
+        await mkdir(dirname(options.cacheFile), { recursive: true });
+        const tmp = `${options.cacheFile}.${process.pid}.tmp`;
+        await writeFile(tmp, this.serializeCapabilityCache(entries, capabilities));
+        await rename(tmp, options.cacheFile);
+      } catch {
+        // The cache is only an optimization
+      }
+    }
+
+    return capabilities;
+  }
+
+  /**
+   * Probe the hardware capability matrix of this host.
+   * Synchronous version of probeCapabilities.
+   *
+   * @param options - Device, cache file and verification options
+   *
+   * @returns Capability matrix
+   *
+   * @example
+   * ```typescript
+   * const caps = HardwareContext.probeCapabilitiesSync({ cacheFile: '/var/cache/app/hwcaps.json' });
+   * ```
+   *
+   * @see {@link probeCapabilities} For async version
+   */
+  static probeCapabilitiesSync(options: HardwareProbeOptions = {}): HardwareCapabilities {
+    const key = this.getCapabilityKey(options);
+
+    if (!options.refresh) {
+      const memo = capabilityMemo.get(key);
+      if (memo) {
+        return { ...memo, fromCache: true };
+      }
+      if (options.cacheFile) {
+        let text: string | null = null;
+        try {
+          text = readFileSync(options.cacheFile, 'utf8');
+        } catch {
+          // No cache yet
+        }
+        const cached = this.parseCapabilityCache(text)[key];
+        if (cached) {
+          capabilityMemo.set(key, cached);
+          return { ...cached, fromCache: true };
+        }
+      }
+    }
+
+    this.prepareDeviceEnvironment();
+    const optionsDict = options.options && Object.keys(options.options).length > 0 ? Dictionary.fromObject(options.options) : null;
+    let devices: HardwareDeviceCapability[];
+    try {
+      devices = HardwareDeviceContext.probeCapabilitiesSync(options.device, optionsDict);
+    } finally {
+      optionsDict?.free();
+    }
+
+    const capabilities = this.finishProbe(key, options, devices);
+
+    if (options.cacheFile) {
+      try {
+        let text: string | null = null;
+        try {
+          text = readFileSync(options.cacheFile, 'utf8');
+        } catch {
+          // No cache yet
+        }
+        mkdirSync(dirname(options.cacheFile), { recursive: true });
+        const tmp = `${options.cacheFile}.${process.pid}.tmp`;
+        writeFileSync(tmp, this.serializeCapabilityCache(this.parseCapabilityCache(text), capabilities));
+        renameSync(tmp, options.cacheFile);
+      } catch {
+        // The cache is only an optimization
+      }
+    }
+
+    return capabilities;
+  }
+
   /**
    * Get the hardware device context.
    *
@@ -506,7 +666,7 @@ export class HardwareContext implements Disposable {
    */
   supportsCodec(codecId: AVCodecID, isEncoder = false): boolean {
     // Try to find the codec
-    const codec = isEncoder ? Codec.findEncoder(codecId) : Codec.findDecoder(codecId);
+    const codec = isEncoder ? Registry.findEncoder(codecId) : Registry.findDecoder(codecId);
     if (!codec) {
       return false;
     }
@@ -544,7 +704,7 @@ export class HardwareContext implements Disposable {
    * @see {@link supportsCodec} For basic codec support
    */
   supportsPixelFormat(codecId: AVCodecID, pixelFormat: AVPixelFormat, isEncoder = false): boolean {
-    const codec = isEncoder ? Codec.findEncoder(codecId) : Codec.findDecoder(codecId);
+    const codec = isEncoder ? Registry.findEncoder(codecId) : Registry.findDecoder(codecId);
     if (!codec) {
       return false;
     }
@@ -620,7 +780,7 @@ export class HardwareContext implements Disposable {
 
       let suffix = '';
       for (const name of codecNames) {
-        const encoderCodec = Codec.findEncoderByName(name);
+        const encoderCodec = Registry.findEncoder(name);
         if (!encoderCodec) {
           continue;
         }
@@ -664,7 +824,7 @@ export class HardwareContext implements Disposable {
 
     // Construct the encoder name
     const encoderName = `${codecBaseName}_${encoderSuffix}` as FFEncoderCodec;
-    const encoderCodec = Codec.findEncoderByName(encoderName);
+    const encoderCodec = Registry.findEncoder(encoderName);
 
     if (!encoderCodec?.isHardwareAcceleratedEncoder()) {
       return null;
@@ -726,37 +886,8 @@ export class HardwareContext implements Disposable {
       return null;
     }
 
-    // Find all decoders for this codec
-    const codecs = Codec.getCodecList();
-
-    for (const decoderCodec of codecs) {
-      // Skip if not a decoder
-      if (!decoderCodec.isDecoder()) {
-        continue;
-      }
-
-      // Skip if wrong codec ID
-      if (decoderCodec.id !== codecId) {
-        continue;
-      }
-
-      // Check if this decoder supports our hardware device type
-      for (let i = 0; ; i++) {
-        const config = decoderCodec.getHwConfig(i);
-        if (!config) break;
-
-        // Accept both HW_DEVICE_CTX and HW_FRAMES_CTX methods
-        const supportsDeviceCtx = (config.methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) !== 0;
-        const supportsFramesCtx = (config.methods & AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX) !== 0;
-
-        if ((supportsDeviceCtx || supportsFramesCtx) && config.deviceType === this._deviceType) {
-          // Found a hardware decoder that supports this device type
-          return decoderCodec;
-        }
-      }
-    }
-
-    return null;
+    // First decoder for this codec with a device or frames context config for our device type
+    return Registry.codecsForDevice(this._deviceType, false).find((decoderCodec) => decoderCodec.id === codecId) ?? null;
   }
 
   /**
@@ -867,33 +998,7 @@ export class HardwareContext implements Disposable {
    * @see {@link supportsCodec} For checking specific codec
    */
   findSupportedCodecs(isEncoder = false): string[] {
-    const supportedCodecs: string[] = [];
-    const codecs = Codec.getCodecList();
-
-    for (const codec of codecs) {
-      // Skip if wrong type (encoder vs decoder)
-      if (isEncoder && !codec.isEncoder()) continue;
-      if (!isEncoder && !codec.isDecoder()) continue;
-
-      // Check if this codec supports our hardware device type
-      for (let i = 0; ; i++) {
-        const config = codec.getHwConfig(i);
-        if (!config) break;
-
-        // Accept both HW_DEVICE_CTX and HW_FRAMES_CTX methods
-        const supportsDeviceCtx = (config.methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) !== 0;
-        const supportsFramesCtx = (config.methods & AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX) !== 0;
-
-        if ((supportsDeviceCtx || supportsFramesCtx) && config.deviceType === this._deviceType) {
-          if (codec.name) {
-            supportedCodecs.push(codec.name);
-          }
-          break; // Found support, move to next codec
-        }
-      }
-    }
-
-    return supportedCodecs;
+    return Registry.codecsForDevice(this._deviceType, isEncoder).map((codec) => codec.name!);
   }
 
   /**
@@ -1144,6 +1249,173 @@ export class HardwareContext implements Disposable {
     }
   }
 
+  /**
+   * Select a device from a capability matrix.
+   *
+   * Follows the platform preference order, skips device types that are
+   * unavailable or failed verification and trusts verified ones.
+   *
+   * @param capabilities - Probed capability matrix
+   *
+   * @param options - Device options
+   *
+   * @returns Hardware context or null if none is usable
+   *
+   * @internal
+   */
+  private static autoFromCapabilities(capabilities: HardwareCapabilities, options: HardwareOptions): HardwareContext | null {
+    for (const deviceType of this.getPreferenceOrder()) {
+      const entry = capabilities.devices.find((device) => device.deviceType === deviceType);
+      if (!entry?.available || entry.verified === false) {
+        continue;
+      }
+
+      try {
+        const device = options.device ?? (deviceType === AV_HWDEVICE_TYPE_VAAPI ? '/dev/dri/renderD128' : undefined);
+        const hwCtx = this.createFromType(deviceType, device, options.options);
+        if (entry.verified === null && !hwCtx.testDecoder()) {
+          hwCtx.dispose();
+          continue;
+        }
+        return hwCtx;
+      } catch {
+        // Device went away since probing: try next device type
+        continue;
+      }
+    }
+
+    return null;
+  }
+
+  /**
+   * Build the capability cache key.
+   *
+   * Covers the FFmpeg build, platform, device nodes (path and device number)
+   * and device options.
+   *
+   * @param options - Probe options
+   *
+   * @returns Hex key
+   *
+   * @internal
+   */
+  private static getCapabilityKey(options: HardwareProbeOptions): string {
+    const info = getFFmpegInfo();
+    const nodes = options.device ? [options.device] : process.platform === 'linux' ? ['/dev/dri/renderD128'] : [];
+    const nodeIds = nodes.map((node) => {
+      try {
+        const st = statSync(node);
+        return `${node}:${st.rdev}:${st.ino}`;
+      } catch {
+        return `${node}:-`;
+      }
+    });
+
+    return createHash('sha256')
+      .update(JSON.stringify([CAPABILITY_CACHE_VERSION, info.version, info.configuration, info.libraries, process.platform, process.arch, nodeIds, options.options ?? {}]))
+      .digest('hex')
+      .slice(0, 32);
+  }
+
+  /**
+   * Verify probed devices and remember the matrix for this process.
+   *
+   * @param key - Cache key
+   *
+   * @param options - Probe options
+   *
+   * @param devices - Native probe result
+   *
+   * @returns Capability matrix
+   *
+   * @internal
+   */
+  private static finishProbe(key: string, options: HardwareProbeOptions, devices: HardwareDeviceCapability[]): HardwareCapabilities {
+    const verify = options.verify ?? true;
+
+    const verified: HardwareDeviceCapabilities[] = devices.map((device) => {
+      if (!device.available || !verify) {
+        return { ...device, verified: device.available ? null : false };
+      }
+
+      try {
+        const node = options.device ?? (device.deviceType === AV_HWDEVICE_TYPE_VAAPI ? '/dev/dri/renderD128' : undefined);
+        using hwCtx = this.createFromType(device.deviceType, node, options.options);
+        return { ...device, verified: hwCtx.testDecoder() };
+      } catch {
+        return { ...device, verified: false };
+      }
+    });
+
+    const capabilities: HardwareCapabilities = {
+      key,
+      ffmpegVersion: getFFmpegInfo().version,
+      device: options.device ?? null,
+      probedAt: Date.now(),
+      fromCache: false,
+      devices: verified,
+    };
+    capabilityMemo.set(key, capabilities);
+
+    return capabilities;
+  }
+
+  /**
+   * Parse a capability cache file.
+   *
+   * @param text - File content or null
+   *
+   * @returns Entries by key (empty for missing, corrupt or outdated files)
+   *
+   * @internal
+   */
+  private static parseCapabilityCache(text: string | null): Record<string, HardwareCapabilities> {
+    if (!text) {
+      return {};
+    }
+
+    try {
+      const parsed = JSON.parse(text);
+      if (parsed?.version !== CAPABILITY_CACHE_VERSION || typeof parsed.entries !== 'object' || parsed.entries === null) {
+        return {};
+      }
+      return parsed.entries;
+    } catch {
+      return {};
+    }
+  }
+
+  /**
+   * Serialize a capability cache file with one entry replaced.
+   *
+   * @param entries - Existing entries
+   *
+   * @param capabilities - Entry to store
+   *
+   * @returns File content
+   *
+   * @internal
+   */
+  private static serializeCapabilityCache(entries: Record<string, HardwareCapabilities>, capabilities: HardwareCapabilities): string {
+    return JSON.stringify({
+      version: CAPABILITY_CACHE_VERSION,
+      entries: { ...entries, [capabilities.key]: { ...capabilities, fromCache: false } },
+    });
+  }
+
+  /**
+   * Set environment needed before creating devices.
+   *
+   * @internal
+   */
+  private static prepareDeviceEnvironment(): void {
+    // Enable Vulkan video support on older gpus (see createFromType)
+    if (HardwareDeviceContext.iterateTypes().includes(AV_HWDEVICE_TYPE_VULKAN)) {
+      process.env.ANV_DEBUG ??= 'video-decode,video-encode';
+      process.env.RADV_PERFTEST ??= 'video_decode,video_encode';
+    }
+  }
+
   /**
    * Create hardware context from device type.
    *
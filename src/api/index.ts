@@ -16,6 +16,15 @@ export { Encoder } from './encoder.js';
 // AudioFrameBuffer
 export { AudioFrameBuffer } from './audio-frame-buffer.js';
 
+// FrameSplitter
+export { FrameSplitter } from './frame-splitter.js';
+
+// LoadShedder
+export { LoadShedder } from './load-shedder.js';
+
+// SilenceGate
+export { SilenceGate } from './silence-gate.js';
+
 // Hardware
 export { HardwareContext } from './hardware.js';
 
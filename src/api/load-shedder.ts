@@ -0,0 +1,351 @@
+import { AV_NOPTS_VALUE, AV_PKT_FLAG_DISPOSABLE } from '../constants/constants.js';
+
+import type { Frame } from '../lib/frame.js';
+import type { Packet } from '../lib/packet.js';
+import type { IRational } from '../lib/types.js';
+import type { Demuxer } from './demuxer.js';
+import type { Encoder } from './encoder.js';
+import type { LoadSheddingAction, LoadSheddingOptions, LoadSheddingStats } from './types.js';
+
+/**
+ * Adaptive load shedding for live pipelines.
+ *
+ * Measures how far a pipeline lags behind real time and sheds work in steps
+ * when the lag grows, instead of letting queues (and latency) grow without bound:
+ *
+ * 1. 'drop-disposable': drop packets flagged AV_PKT_FLAG_DISPOSABLE (non-reference
+ *    frames) before they reach the decoder. Decoding stays correct, only frames
+ *    nothing else depends on are skipped.
+ * 2. 'drop-frames': keep only one of every N decoded frames before filtering/encoding.
+ * 3. 'lower-bitrate': lower the encoder bitrate (for encoders that reconfigure
+ *    at runtime, e.g. libx264) and restore it when the pipeline has caught up.
+ *
+ * Latency is the larger of the demuxer queue latency ({@link Demuxer.getQueueLatency})
+ * and the media clock lag: wall clock time elapsed minus media time elapsed at the
+ * point where packets/frames pass the shedder. Each action has its own threshold
+ * with hysteresis, and callbacks report when an action starts and stops.
+ *
+ * Pass the shedder as a stage of a simple `pipeline()` to apply it before the
+ * decoder and before the filter/encoder, or wrap generators with {@link packets}
+ * and {@link frames} directly.
+ *
+ * Intended for real-time sources (RTSP, capture devices). File inputs are read
+ * faster than real time and fill the demuxer queue immediately.
+ *
+ * @example
+ * ```typescript
+ * import { Decoder, Demuxer, Encoder, LoadShedder, Muxer, pipeline } from 'node-av/api';
+ *
+ * await using input = await Demuxer.open('rtsp://camera/stream');
+ * using decoder = await Decoder.create(input.video()!);
+ * using encoder = await Encoder.create(FF_ENCODER_LIBX264, { bitrate: '2M' });
+ * await using output = await Muxer.open('rtp://127.0.0.1:5004', { format: 'rtp' });
+ *
+ * const shedder = LoadShedder.create({
+ *   dropFramesAfter: 300,
+ *   onSheddingStart: ({ action, latency }) => console.warn(`${action} (${latency.toFixed(0)}ms)`),
+ *   onSheddingStop: ({ action }) => console.info(`${action} stopped`),
+ * });
+ *
+ * const control = pipeline(input, shedder, decoder, encoder, output);
+ * await control.completion;
+ * console.log(shedder.getStats());
+ * ```
+ *
+ * @see {@link Demuxer.getQueueLatency} For the demuxer queue latency
+ */
+export class LoadShedder {
+  private options: Required<Omit<LoadSheddingOptions, 'onSheddingStart' | 'onSheddingStop'>>;
+  private onSheddingStart: LoadSheddingOptions['onSheddingStart'];
+  private onSheddingStop: LoadSheddingOptions['onSheddingStop'];
+  private active = new Set<LoadSheddingAction>();
+  private clockOffsets = new Map<string, number>(); // measurement point -> min(wall - media) in ms
+  private packetLatency = 0;
+  private frameLatency = 0;
+  private maxLatency = 0;
+  private droppedPackets = 0;
+  private droppedFrames = 0;
+  private frameCounter = 0;
+  private encoder: Encoder | null = null;
+  private originalBitRate: bigint | null = null;
+
+  /**
+   * @param options - Load shedding options
+   *
+   * @internal
+   */
+  private constructor(options: LoadSheddingOptions) {
+    this.options = {
+      dropDisposableAfter: options.dropDisposableAfter ?? 200,
+      dropFramesAfter: options.dropFramesAfter ?? 500,
+      frameDecimation: Math.max(1, Math.floor(options.frameDecimation ?? 2)),
+      lowerBitrateAfter: options.lowerBitrateAfter ?? 1000,
+      bitrateScale: Math.min(1, Math.max(0.01, options.bitrateScale ?? 0.5)),
+      recoveryRatio: Math.min(1, Math.max(0, options.recoveryRatio ?? 0.5)),
+    };
+    this.onSheddingStart = options.onSheddingStart;
+    this.onSheddingStop = options.onSheddingStop;
+  }
+
+  /**
+   * Create a load shedder.
+   *
+   * @param options - Thresholds, shedding parameters and callbacks
+   *
+   * @returns Load shedder
+   *
+   * @example
+   * ```typescript
+   * const shedder = LoadShedder.create({
+   *   dropDisposableAfter: 100,
+   *   dropFramesAfter: 250,
+   *   lowerBitrateAfter: 0, // Never touch the encoder
+   * });
+   * ```
+   */
+  static create(options: LoadSheddingOptions = {}): LoadShedder {
+    return new LoadShedder(options);
+  }
+
+  /**
+   * Latest measured latency in milliseconds.
+   */
+  get latency(): number {
+    return Math.max(this.packetLatency, this.frameLatency);
+  }
+
+  /**
+   * Whether any action is active.
+   */
+  get isShedding(): boolean {
+    return this.active.size > 0;
+  }
+
+  /**
+   * Set the encoder whose bitrate is lowered by the 'lower-bitrate' action.
+   *
+   * Done automatically when the shedder is a stage of `pipeline()`.
+   *
+   * @param encoder - Encoder of the pipeline
+   *
+   * @example
+   * ```typescript
+   * shedder.setEncoder(encoder);
+   * ```
+   */
+  setEncoder(encoder: Encoder): void {
+    this.encoder = encoder;
+  }
+
+  /**
+   * Shed packets before decoding.
+   *
+   * Measures latency and drops disposable packets while 'drop-disposable' is active.
+   * Dropped packets are freed.
+   *
+   * @param source - Packet source
+   *
+   * @param demuxer - Demuxer the packets come from, to include its queue latency
+   *
+   * @param streamIndex - Stream index passed to `demuxer.packets()`
+   *
+   * @yields {Packet | null} Packets that were not dropped
+   *
+   * @example
+   * ```typescript
+   * const packets = shedder.packets(input.packets(video.index), input, video.index);
+   * for await (using frame of decoder.frames(packets)) {
+   *   // ...
+   * }
+   * ```
+   */
+  async *packets(source: AsyncIterable<Packet | null>, demuxer?: Demuxer, streamIndex?: number): AsyncGenerator<Packet | null> {
+    for await (const packet of source) {
+      if (packet) {
+        const ts = packet.dts !== AV_NOPTS_VALUE ? packet.dts : packet.pts;
+        const lag = this.measure(`packet:${packet.streamIndex}`, ts, packet.timeBase);
+        this.packetLatency = Math.max(lag ?? this.packetLatency, demuxer?.getQueueLatency(streamIndex) ?? 0);
+        this.update();
+
+        if (this.active.has('drop-disposable') && (packet.flags & AV_PKT_FLAG_DISPOSABLE) !== 0) {
+          this.droppedPackets++;
+          packet.free();
+          continue;
+        }
+      }
+
+      yield packet;
+    }
+  }
+
+  /**
+   * Shed frames before filtering/encoding.
+   *
+   * Measures latency and keeps one of every `frameDecimation` frames while
+   * 'drop-frames' is active. Dropped frames are freed. The null flush
+   * marker is never dropped.
+   *
+   * @param source - Frame source
+   *
+   * @yields {Frame | null} Frames that were not dropped
+   *
+   * @example
+   * ```typescript
+   * for await (using packet of encoder.packets(shedder.frames(decoder.frames(packets)))) {
+   *   await output.writePacket(packet, streamIndex);
+   * }
+   * ```
+   */
+  async *frames(source: AsyncIterable<Frame | null>): AsyncGenerator<Frame | null> {
+    for await (const frame of source) {
+      if (frame) {
+        const ts = frame.pts !== AV_NOPTS_VALUE ? frame.pts : frame.bestEffortTimestamp;
+        this.frameLatency = this.measure('frame', ts, frame.timeBase) ?? this.frameLatency;
+        this.update();
+
+        if (this.active.has('drop-frames') && this.frameCounter++ % this.options.frameDecimation !== 0) {
+          this.droppedFrames++;
+          frame.free();
+          continue;
+        }
+      }
+
+      yield frame;
+    }
+  }
+
+  /**
+   * Get load shedding statistics.
+   *
+   * @returns Latency, active actions and drop counters
+   *
+   * @example
+   * ```typescript
+   * const stats = shedder.getStats();
+   * console.log(`${stats.droppedFrames} frames dropped, max latency ${stats.maxLatency}ms`);
+   * ```
+   */
+  getStats(): LoadSheddingStats {
+    return {
+      latency: this.latency,
+      maxLatency: this.maxLatency,
+      activeActions: [...this.active],
+      droppedPackets: this.droppedPackets,
+      droppedFrames: this.droppedFrames,
+    };
+  }
+
+  /**
+   * Measure the media clock lag at a measurement point.
+   *
+   * The lag is the wall clock minus media time offset relative to the
+   * smallest offset seen so far, so sources running ahead of real time
+   * (bursts, file inputs) read as zero lag.
+   *
+   * @param key - Measurement point
+   *
+   * @param ts - Timestamp
+   *
+   * @param timeBase - Time base of the timestamp
+   *
+   * @returns Lag in milliseconds, or null if the timestamp is unusable
+   *
+   * @internal
+   */
+  private measure(key: string, ts: bigint, timeBase: IRational): number | null {
+    if (ts === AV_NOPTS_VALUE || timeBase.num <= 0 || timeBase.den <= 0) {
+      return null;
+    }
+
+    const offset = performance.now() - (Number(ts) * timeBase.num * 1000) / timeBase.den;
+    const min = this.clockOffsets.get(key);
+    if (min === undefined || offset < min) {
+      this.clockOffsets.set(key, offset);
+      return 0;
+    }
+
+    return offset - min;
+  }
+
+  /**
+   * Start and stop actions for the current latency.
+   *
+   * @internal
+   */
+  private update(): void {
+    const latency = this.latency;
+    this.maxLatency = Math.max(this.maxLatency, latency);
+
+    this.transition('drop-disposable', this.options.dropDisposableAfter, latency);
+    this.transition('drop-frames', this.options.dropFramesAfter, latency);
+    this.transition('lower-bitrate', this.options.lowerBitrateAfter, latency);
+
+    // The encoder opens lazily on its first frame
+    if (this.active.has('lower-bitrate') && this.originalBitRate === null) {
+      this.lowerBitrate();
+    }
+  }
+
+  /**
+   * Apply the threshold and hysteresis of one action.
+   *
+   * @param action - Action
+   *
+   * @param threshold - Start threshold in milliseconds (0 = disabled)
+   *
+   * @param latency - Current latency in milliseconds
+   *
+   * @internal
+   */
+  private transition(action: LoadSheddingAction, threshold: number, latency: number): void {
+    if (threshold <= 0) {
+      return;
+    }
+
+    if (!this.active.has(action) && latency > threshold) {
+      this.active.add(action);
+      if (action === 'drop-frames') {
+        this.frameCounter = 0;
+      } else if (action === 'lower-bitrate') {
+        this.lowerBitrate();
+      }
+      this.onSheddingStart?.({ action, latency });
+    } else if (this.active.has(action) && latency < threshold * this.options.recoveryRatio) {
+      this.active.delete(action);
+      if (action === 'lower-bitrate') {
+        this.restoreBitrate();
+      }
+      this.onSheddingStop?.({ action, latency });
+    }
+  }
+
+  /**
+   * Lower the encoder bitrate.
+   *
+   * No-op without an opened encoder or in constant quality mode (bitrate 0).
+   *
+   * @internal
+   */
+  private lowerBitrate(): void {
+    const codecContext = this.encoder?.getCodecContext();
+    if (!codecContext || codecContext.bitRate <= 0n) {
+      return;
+    }
+
+    this.originalBitRate = codecContext.bitRate;
+    codecContext.bitRate = BigInt(Math.max(1, Math.round(Number(this.originalBitRate) * this.options.bitrateScale)));
+  }
+
+  /**
+   * Restore the encoder bitrate.
+   *
+   * @internal
+   */
+  private restoreBitrate(): void {
+    const codecContext = this.encoder?.getCodecContext();
+    if (codecContext && this.originalBitRate !== null) {
+      codecContext.bitRate = this.originalBitRate;
+    }
+    this.originalBitRate = null;
+  }
+}
@@ -1,5 +1,5 @@
-import { mkdirSync } from 'fs';
-import { mkdir } from 'fs/promises';
+import { mkdirSync, renameSync, unlinkSync } from 'fs';
+import { mkdir, rename, unlink } from 'fs/promises';
 import { dirname, resolve } from 'path';
 
 import {
@@ -25,13 +25,15 @@ import { IOContext } from '../lib/io-context.js';
 import { Packet } from '../lib/packet.js';
 import { Rational } from '../lib/rational.js';
 import { SyncQueue, SyncQueueType } from '../lib/sync-queue.js';
-import { avAddQ, avCompareTs, avGetAudioFrameDuration2, avRescaleDelta, avRescaleQ } from '../lib/utilities.js';
+import { TimestampRescaler } from '../lib/timestamp-rescaler.js';
+import { avAddQ, avCompareTs, avGetAudioFrameDuration2, avRescaleDelta, avRescaleQ, mp4Defragment, mp4DefragmentSync } from '../lib/utilities.js';
 import { IO_BUFFER_SIZE, MAX_MUXING_QUEUE_SIZE, MAX_PACKET_SIZE, MUXING_QUEUE_DATA_THRESHOLD, SYNC_BUFFER_DURATION } from './constants.js';
 import { Encoder } from './encoder.js';
 import { AsyncQueue } from './utilities/async-queue.js';
 
 import type { IRational, OutputFormat, Stream } from '../lib/index.js';
-import type { IOOutputCallbacks, MuxerOptions } from './types.js';
+import type { RTPSinkStats } from '../lib/types.js';
+import type { IOOutputCallbacks, IORTPSinkTarget, MuxerOptions } from './types.js';
 
 export interface AddStreamOptionsWithEncoder {
   encoder?: Encoder;
@@ -41,6 +43,9 @@ export interface AddStreamOptionsWithInputStream {
   inputStream?: Stream;
 }
 
+// Output formats whose fragmented output can be finalized by mp4Defragment()
+const FAST_START_FORMATS = new Set(['mp4', 'mov', 'ipod', '3gp', '3g2', 'psp']);
+
 interface StreamDescription {
   initialized: boolean;
   inputStream?: Stream; // Source stream for metadata/properties (optional in encoder-only mode)
@@ -56,6 +61,9 @@ interface StreamDescription {
   lastMuxDts: bigint;
   tsRescaleDeltaLast: { value: bigint }; // For av_rescale_delta (audio streamcopy)
   streamcopyStarted: boolean; // Track if streamcopy has started for this stream
+  toUs?: TimestampRescaler; // Packet time base to AV_TIME_BASE_Q (streamcopy)
+  fromUs?: TimestampRescaler; // AV_TIME_BASE_Q to packet time base (streamcopy)
+  durationRescaler?: TimestampRescaler; // Source to stream time base (audio streamcopy)
 }
 
 interface WriteJob {
@@ -126,6 +134,7 @@ export class Muxer implements AsyncDisposable, Disposable {
   private containerMetadataCopied = false; // Track if container metadata has been copied
   private writeQueue?: AsyncQueue<WriteJob>; // Optional async queue for serialized writes
   private writeWorkerPromise?: Promise<void>; // Background worker promise
+  private fastStartTarget?: string; // Final path when writing fragmented to <path>.part
 
   /**
    * @param options - Media output options
@@ -197,12 +206,43 @@ export class Muxer implements AsyncDisposable, Disposable {
    * });
    * ```
    *
+   * @example
+   * ```typescript
+   * // Native RTP sink - header rewrites and batching without per-packet JS
+   * await using output = await Muxer.open({
+   *   ssrc: 0x1234,
+   *   payloadType: 96,
+   *   onPackets: (slab, offsets) => {
+   *     for (let i = 0; i < offsets.length - 1; i++) {
+   *       socket.send(slab.subarray(offsets[i], offsets[i + 1]));
+   *     }
+   *   }
+   * }, {
+   *   format: 'rtp',
+   *   maxPacketSize: 1200
+   * });
+   * ```
+   *
+   * @example
+   * ```typescript
+   * // Native RTP sink with native UDP output (no JS per batch)
+   * await using output = await Muxer.open({
+   *   ssrc: 0x1234,
+   *   udp: { address: '127.0.0.1', port: 5004, pacingBitrate: 4_000_000 }
+   * }, {
+   *   format: 'rtp',
+   *   maxPacketSize: 1200
+   * });
+   * ```
+   *
    * @see {@link MuxerOptions} For configuration options
    * @see {@link IOOutputCallbacks} For custom I/O interface
+   * @see {@link IORTPSinkTarget} For the native RTP sink
    */
   static async open(target: string, options?: MuxerOptions): Promise<Muxer>;
   static async open(target: IOOutputCallbacks, options: MuxerOptions & { format: string }): Promise<Muxer>;
-  static async open(target: string | IOOutputCallbacks, options?: MuxerOptions): Promise<Muxer> {
+  static async open(target: IORTPSinkTarget, options: MuxerOptions & { format: 'rtp' }): Promise<Muxer>;
+  static async open(target: string | IOOutputCallbacks | IORTPSinkTarget, options?: MuxerOptions): Promise<Muxer> {
     const output = new Muxer(options);
 
     try {
@@ -233,9 +273,10 @@ export class Muxer implements AsyncDisposable, Disposable {
         if (resolvedTarget && oformat && !oformat.hasFlags(AVFMT_NOFILE)) {
           // For file-based formats, we need to open the file using avio_open2
           // FFmpeg will manage the AVIOContext internally
+          const writeTarget = output.prepareFastStart(resolvedTarget, isUrl);
           output.ioContext = new IOContext();
-          const openRet = await output.ioContext.open2(resolvedTarget, AVIO_FLAG_WRITE);
-          FFmpegError.throwIfError(openRet, `Failed to open output file: ${resolvedTarget}`);
+          const openRet = await output.ioContext.open2(writeTarget, AVIO_FLAG_WRITE);
+          FFmpegError.throwIfError(openRet, `Failed to open output file: ${writeTarget}`);
           output.formatContext.pb = output.ioContext;
         }
       } else {
@@ -254,9 +295,14 @@ export class Muxer implements AsyncDisposable, Disposable {
           }
         }
 
-        // Setup custom IO with callbacks
+        // Setup custom IO with callbacks (or the native RTP sink)
         output.ioContext = new IOContext();
-        output.ioContext.allocContextWithCallbacks(options.bufferSize ?? IO_BUFFER_SIZE, 1, target.read, target.write, target.seek);
+        if (!('write' in target)) {
+          const { onPackets, ...sinkOptions } = target;
+          output.ioContext.allocContextRtpSink(options.bufferSize ?? IO_BUFFER_SIZE, sinkOptions, onPackets);
+        } else {
+          output.ioContext.allocContextWithCallbacks(options.bufferSize ?? IO_BUFFER_SIZE, 1, target.read, target.write, target.seek);
+        }
         output.ioContext.maxPacketSize = options.maxPacketSize ?? MAX_PACKET_SIZE;
         output.formatContext.pb = output.ioContext;
         output.formatContext.setFlags(AVFMT_FLAG_CUSTOM_IO);
@@ -330,7 +376,8 @@ export class Muxer implements AsyncDisposable, Disposable {
    */
   static openSync(target: string, options?: MuxerOptions): Muxer;
   static openSync(target: IOOutputCallbacks, options: MuxerOptions & { format: string }): Muxer;
-  static openSync(target: string | IOOutputCallbacks, options?: MuxerOptions): Muxer {
+  static openSync(target: IORTPSinkTarget, options: MuxerOptions & { format: 'rtp' }): Muxer;
+  static openSync(target: string | IOOutputCallbacks | IORTPSinkTarget, options?: MuxerOptions): Muxer {
     const output = new Muxer(options);
 
     try {
@@ -361,9 +408,10 @@ export class Muxer implements AsyncDisposable, Disposable {
         if (resolvedTarget && oformat && !oformat.hasFlags(AVFMT_NOFILE)) {
           // For file-based formats, we need to open the file using avio_open2
           // FFmpeg will manage the AVIOContext internally
+          const writeTarget = output.prepareFastStart(resolvedTarget, isUrl);
           output.ioContext = new IOContext();
-          const openRet = output.ioContext.open2Sync(resolvedTarget, AVIO_FLAG_WRITE);
-          FFmpegError.throwIfError(openRet, `Failed to open output file: ${resolvedTarget}`);
+          const openRet = output.ioContext.open2Sync(writeTarget, AVIO_FLAG_WRITE);
+          FFmpegError.throwIfError(openRet, `Failed to open output file: ${writeTarget}`);
           output.formatContext.pb = output.ioContext;
         }
       } else {
@@ -382,9 +430,14 @@ export class Muxer implements AsyncDisposable, Disposable {
           }
         }
 
-        // Setup custom IO with callbacks
+        // Setup custom IO with callbacks (or the native RTP sink)
         output.ioContext = new IOContext();
-        output.ioContext.allocContextWithCallbacks(options.bufferSize ?? IO_BUFFER_SIZE, 1, target.read, target.write, target.seek);
+        if (!('write' in target)) {
+          const { onPackets, ...sinkOptions } = target;
+          output.ioContext.allocContextRtpSink(options.bufferSize ?? IO_BUFFER_SIZE, sinkOptions, onPackets);
+        } else {
+          output.ioContext.allocContextWithCallbacks(options.bufferSize ?? IO_BUFFER_SIZE, 1, target.read, target.write, target.seek);
+        }
         output.ioContext.maxPacketSize = options.maxPacketSize ?? MAX_PACKET_SIZE;
         output.formatContext.pb = output.ioContext;
         output.formatContext.setFlags(AVFMT_FLAG_CUSTOM_IO);
@@ -1581,6 +1634,23 @@ export class Muxer implements AsyncDisposable, Disposable {
       }
     }
 
+    // Convert the fragmented recording into the fast-start file
+    if (this.fastStartTarget) {
+      const part = `${this.fastStartTarget}.part`;
+      let defragmented = false;
+      try {
+        await mp4Defragment(part, this.fastStartTarget, this.options.onFinalizeProgress);
+        defragmented = true;
+        await unlink(part);
+      } catch (error) {
+        this.reportFastStartError(error);
+        if (!defragmented) {
+          // Keep the fragmented file, it is playable without fast start
+          await rename(part, this.fastStartTarget).catch((renameError) => this.reportFastStartError(renameError));
+        }
+      }
+    }
+
     // Free format context
     if (this.formatContext) {
       try {
@@ -1675,6 +1745,27 @@ export class Muxer implements AsyncDisposable, Disposable {
       }
     }
 
+    // Convert the fragmented recording into the fast-start file
+    if (this.fastStartTarget) {
+      const part = `${this.fastStartTarget}.part`;
+      let defragmented = false;
+      try {
+        mp4DefragmentSync(part, this.fastStartTarget);
+        defragmented = true;
+        unlinkSync(part);
+      } catch (error) {
+        this.reportFastStartError(error);
+        if (!defragmented) {
+          // Keep the fragmented file, it is playable without fast start
+          try {
+            renameSync(part, this.fastStartTarget);
+          } catch (renameError) {
+            this.reportFastStartError(renameError);
+          }
+        }
+      }
+    }
+
     // Free format context
     if (this.formatContext) {
       try {
@@ -1694,6 +1785,23 @@ export class Muxer implements AsyncDisposable, Disposable {
     }
   }
 
+  /**
+   * Get native RTP sink statistics.
+   *
+   * Only available when the muxer was opened with an {@link IORTPSinkTarget}.
+   *
+   * @returns Packet, byte, batch and drop counters, or null if no RTP sink is used
+   *
+   * @example
+   * ```typescript
+   * const stats = output.getRtpSinkStats();
+   * console.log(`RTCP dropped: ${stats?.rtcpDropped}`);
+   * ```
+   */
+  getRtpSinkStats(): RTPSinkStats | null {
+    return this.ioContext?.getRtpSinkStats() ?? null;
+  }
+
   /**
    * Get underlying format context.
    *
@@ -1707,6 +1815,63 @@ export class Muxer implements AsyncDisposable, Disposable {
     return this.formatContext;
   }
 
+  /**
+   * Configure fragmented writing for fast start.
+   *
+   * The recording is written as fragmented MP4 to `<target>.part` and
+   * converted into `<target>` on close (see MuxerOptions.fastStart).
+   * A faststart movflag requested by the user is replaced by this.
+   *
+   * @param target - Resolved output path
+   *
+   * @param isUrl - Whether the target is a protocol URL
+   *
+   * @returns Path to open for writing
+   *
+   * @throws {TypeError} If fastStart is used with a non-file or non-MP4 output
+   *
+   * @internal
+   */
+  private prepareFastStart(target: string, isUrl: boolean): string {
+    if (!this.options.fastStart) {
+      return target;
+    }
+
+    const names = this.formatContext.oformat?.name?.split(',') ?? [];
+    if (isUrl || !names.some((name) => FAST_START_FORMATS.has(name))) {
+      throw new TypeError('fastStart requires a file output of the mp4/mov family');
+    }
+
+    // Relative to the flags already set from options.movflags
+    this.formatContext.setOption('movflags', '-faststart+frag_keyframe+empty_moov+default_base_moof');
+
+    // frag_keyframe only cuts at video keyframes: bound audio-only fragments
+    if (this.options.options?.frag_duration === undefined) {
+      this.formatContext.setOption('frag_duration', '2000000');
+    }
+
+    this.fastStartTarget = target;
+    return `${target}.part`;
+  }
+
+  /**
+   * Report a failed fast-start finalize.
+   *
+   * Passed to MuxerOptions.onFastStartError, or emitted as a process warning.
+   *
+   * @param error - Defragment or rename error
+   *
+   * @internal
+   */
+  private reportFastStartError(error: unknown): void {
+    const err = error instanceof Error ? error : new Error(String(error));
+    if (this.options.onFastStartError) {
+      this.options.onFastStartError(err);
+    } else {
+      process.emitWarning(`fastStart finalize of ${this.fastStartTarget} failed: ${err.message}`, { code: 'NODE_AV_FAST_START' });
+    }
+  }
+
   /**
    * Setup sync queues based on stream configuration.
    *
@@ -2109,9 +2274,18 @@ export class Muxer implements AsyncDisposable, Disposable {
       return false;
     }
 
+    // Rescalers are kept per stream and only recreated when the time base changes
+    const pktTb = pkt.timeBase;
+    if (!streamInfo.toUs?.matches(pktTb, AV_TIME_BASE_Q)) {
+      streamInfo.toUs = TimestampRescaler.create(pktTb, AV_TIME_BASE_Q);
+      streamInfo.fromUs = TimestampRescaler.create(AV_TIME_BASE_Q, pktTb);
+    }
+    const toUs = streamInfo.toUs;
+    const fromUs = streamInfo.fromUs!;
+
     // Get DTS in AV_TIME_BASE for comparison
     // Use packet DTS directly
-    const dts = pkt.dts !== AV_NOPTS_VALUE ? avRescaleQ(pkt.dts, pkt.timeBase, AV_TIME_BASE_Q) : AV_NOPTS_VALUE;
+    const dts = pkt.dts !== AV_NOPTS_VALUE ? toUs.rescale(pkt.dts) : AV_NOPTS_VALUE;
     const startTimeUs = this.options.startTime !== undefined ? BigInt(Math.floor(this.options.startTime * 1000000)) : AV_NOPTS_VALUE;
 
     // 1. Skip non-keyframes at start
@@ -2130,7 +2304,7 @@ export class Muxer implements AsyncDisposable, Disposable {
 
       // Only check ts_copy_start if copyPriorStart is not set (0 or -1)
       if (copyPriorStart !== 1 && tsCopyStart > 0n) {
-        const pktTsUs = pkt.pts !== AV_NOPTS_VALUE ? avRescaleQ(pkt.pts, pkt.timeBase, AV_TIME_BASE_Q) : dts;
+        const pktTsUs = pkt.pts !== AV_NOPTS_VALUE ? toUs.rescale(pkt.pts) : dts;
 
         if (pktTsUs !== AV_NOPTS_VALUE && pktTsUs < tsCopyStart) {
           return false; // skip packet
@@ -2146,7 +2320,7 @@ export class Muxer implements AsyncDisposable, Disposable {
     // 4. Apply start_time timestamp offset
     // FFmpeg uses: start_time = (of->start_time == AV_NOPTS_VALUE) ? 0 : of->start_time
     const startForOffset = startTimeUs !== AV_NOPTS_VALUE ? startTimeUs : 0n;
-    const tsOffset = avRescaleQ(startForOffset, AV_TIME_BASE_Q, pkt.timeBase);
+    const tsOffset = fromUs.rescale(startForOffset);
 
     if (pkt.pts !== AV_NOPTS_VALUE) {
       pkt.pts -= tsOffset;
@@ -2155,7 +2329,7 @@ export class Muxer implements AsyncDisposable, Disposable {
     if (pkt.dts === AV_NOPTS_VALUE) {
       // If DTS missing, use our estimated DTS
       if (dts !== AV_NOPTS_VALUE) {
-        pkt.dts = avRescaleQ(dts, AV_TIME_BASE_Q, pkt.timeBase);
+        pkt.dts = fromUs.rescale(dts);
       }
     } else if (outputStream.codecpar.codecType === AVMEDIA_TYPE_AUDIO) {
       // Audio: PTS = DTS - ts_offset
@@ -2219,7 +2393,10 @@ export class Muxer implements AsyncDisposable, Disposable {
       pkt.dts = avRescaleDelta(srcTb, pkt.dts, fsTb, duration, streamInfo.tsRescaleDeltaLast, dstTb);
       pkt.pts = pkt.dts;
 
-      pkt.duration = avRescaleQ(pkt.duration, srcTb, dstTb);
+      if (!streamInfo.durationRescaler?.matches(srcTb, dstTb)) {
+        streamInfo.durationRescaler = TimestampRescaler.create(srcTb, dstTb);
+      }
+      pkt.duration = streamInfo.durationRescaler.rescale(pkt.duration);
     } else {
       // For video or encoded audio, use regular rescaling
       const srcTb = streamInfo.sourceTimeBase!;
@@ -6,6 +6,8 @@ import type { Decoder } from './decoder.js';
 import type { Demuxer } from './demuxer.js';
 import type { Encoder } from './encoder.js';
 import type { FilterAPI } from './filter.js';
+import type { FrameSplitter } from './frame-splitter.js';
+import type { LoadShedder } from './load-shedder.js';
 import type { Muxer } from './muxer.js';
 
 // Restrict stream names to known types
@@ -14,7 +16,7 @@ export type StreamName = 'video' | 'audio';
 // Better type definitions with proper inference
 export type NamedInputs<K extends StreamName = StreamName> = Pick<Record<StreamName, Demuxer>, K>;
 export type NamedStages<K extends StreamName = StreamName> = Pick<
-  Record<StreamName, (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[] | 'passthrough'>,
+  Record<StreamName, (Decoder | FilterAPI | FilterAPI[] | FrameSplitter | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[] | 'passthrough'>,
   K
 >;
 export type NamedOutputs<K extends StreamName = StreamName> = Pick<Record<StreamName, Muxer>, K>;
@@ -29,6 +31,7 @@ interface StreamMetadata {
   encoder?: Encoder;
   decoder?: Decoder;
   bitStreamFilter?: BitStreamFilterAPI;
+  loadShedder?: LoadShedder;
   streamIndex?: number;
   type?: 'video' | 'audio';
 }
@@ -208,6 +211,62 @@ export function pipeline(
  */
 export function pipeline(source: Demuxer, decoder: Decoder, filter1: FilterAPI, filter2: FilterAPI, encoder: Encoder, output: Muxer): PipelineControl;
 
+/**
+ * Live transcoding pipeline with load shedding: input → decoder → encoder → output.
+ *
+ * The shedder drops disposable packets before the decoder, drops frames
+ * before the encoder and lowers the encoder bitrate when the pipeline
+ * falls behind real time.
+ *
+ * @param source - Media input source
+ *
+ * @param shedder - Load shedding policy
+ *
+ * @param decoder - Decoder for decoding packets to frames
+ *
+ * @param encoder - Encoder for encoding frames to packets
+ *
+ * @param output - Media output destination
+ *
+ * @returns Pipeline control for managing execution
+ *
+ * @example
+ * ```typescript
+ * const shedder = LoadShedder.create({ dropFramesAfter: 300 });
+ * const control = pipeline(input, shedder, decoder, encoder, output);
+ * await control.completion;
+ * ```
+ */
+export function pipeline(source: Demuxer, shedder: LoadShedder, decoder: Decoder, encoder: Encoder, output: Muxer): PipelineControl;
+
+/**
+ * Live transcoding pipeline with load shedding and filter: input → decoder → filter → encoder → output.
+ *
+ * Frames are shed before the filter.
+ *
+ * @param source - Media input source
+ *
+ * @param shedder - Load shedding policy
+ *
+ * @param decoder - Decoder for decoding packets to frames
+ *
+ * @param filter - Filter or filter chain for processing frames
+ *
+ * @param encoder - Encoder for encoding frames to packets
+ *
+ * @param output - Media output destination
+ *
+ * @returns Pipeline control for managing execution
+ *
+ * @example
+ * ```typescript
+ * const shedder = LoadShedder.create({ onSheddingStart: (e) => console.warn(e) });
+ * const control = pipeline(input, shedder, decoder, scaleFilter, encoder, output);
+ * await control.completion;
+ * ```
+ */
+export function pipeline(source: Demuxer, shedder: LoadShedder, decoder: Decoder, filter: FilterAPI | FilterAPI[], encoder: Encoder, output: Muxer): PipelineControl;
+
 /**
  * Stream copy pipeline: input → output (copies all streams).
  *
@@ -909,7 +968,9 @@ function runSimplePipeline(args: any[]): PipelineControl | AsyncGenerator<Packet
 
   // Process metadata first by walking through stages
   for (const stage of processStages) {
-    if (isDecoder(stage)) {
+    if (isLoadShedder(stage)) {
+      metadata.loadShedder = stage;
+    } else if (isDecoder(stage)) {
       metadata.decoder = stage;
     } else if (isEncoder(stage)) {
       metadata.encoder = stage;
@@ -938,6 +999,20 @@ function runSimplePipeline(args: any[]): PipelineControl | AsyncGenerator<Packet
     actualSource = source;
   }
 
+  if (metadata.loadShedder) {
+    if (metadata.encoder) {
+      metadata.loadShedder.setEncoder(metadata.encoder);
+    }
+
+    // Shed packets in front of the decoder; a frame source is shed directly
+    if (metadata.decoder) {
+      const streamIndex = metadata.decoder.getStream().index;
+      actualSource = metadata.loadShedder.packets(actualSource as AsyncIterable<Packet | null>, metadata.demuxer, streamIndex);
+    } else if (!metadata.demuxer) {
+      actualSource = metadata.loadShedder.frames(actualSource as AsyncIterable<Frame | null>);
+    }
+  }
+
   const generator = buildSimplePipeline(actualSource, processStages);
 
   // If output, consume the generator
@@ -965,13 +1040,20 @@ function runSimplePipeline(args: any[]): PipelineControl | AsyncGenerator<Packet
  */
 async function* buildSimplePipeline(
   source: AsyncIterable<Packet | Frame | null>,
-  stages: (Decoder | Encoder | FilterAPI | FilterAPI[] | BitStreamFilterAPI | BitStreamFilterAPI[] | Muxer)[],
+  stages: (Decoder | Encoder | FilterAPI | FilterAPI[] | BitStreamFilterAPI | BitStreamFilterAPI[] | LoadShedder | Muxer)[],
 ): AsyncGenerator<Packet | Frame | null> {
   let stream: AsyncIterable<any> = source;
+  const shedder = stages.find(isLoadShedder);
 
   for (const stage of stages) {
-    if (isDecoder(stage)) {
+    if (isLoadShedder(stage)) {
+      // Applied around the decoder (see runSimplePipeline)
+      continue;
+    } else if (isDecoder(stage)) {
       stream = stage.frames(stream as AsyncIterable<Packet>);
+      if (shedder) {
+        stream = shedder.frames(stream as AsyncIterable<Frame | null>);
+      }
     } else if (isEncoder(stage)) {
       stream = stage.packets(stream as AsyncIterable<Frame>);
     } else if (isFilterAPI(stage)) {
@@ -1098,7 +1180,7 @@ function runNamedPartialPipeline<K extends StreamName>(inputs: NamedInputs<K>, s
 
   for (const [streamName, streamStages] of Object.entries(stages) as [
     StreamName,
-    (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[] | 'passthrough',
+    (Decoder | FilterAPI | FilterAPI[] | FrameSplitter | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[] | 'passthrough',
   ][]) {
     const input = (inputs as any)[streamName] as Demuxer;
     if (!input) {
@@ -1210,7 +1292,7 @@ async function runNamedPipelineAsync<K extends StreamName>(
     // Single pass: collect metadata and build pipelines directly using input.packets(streamIndex)
     for (const [streamName, streamStages] of Object.entries(stages) as [
       StreamName,
-      (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[] | 'passthrough',
+      (Decoder | FilterAPI | FilterAPI[] | FrameSplitter | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[] | 'passthrough',
     ][]) {
       const metadata: StreamMetadata = {};
       streamMetadata[streamName] = metadata;
@@ -1275,7 +1357,7 @@ async function runNamedPipelineAsync<K extends StreamName>(
     // Original logic: separate inputs or single input
     for (const [streamName, streamStages] of Object.entries(stages) as [
       StreamName,
-      (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[] | 'passthrough',
+      (Decoder | FilterAPI | FilterAPI[] | FrameSplitter | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[] | 'passthrough',
     ][]) {
       const metadata: StreamMetadata = {};
       streamMetadata[streamName] = metadata;
@@ -1446,7 +1528,7 @@ async function runNamedPipelineAsync<K extends StreamName>(
  */
 async function* buildFlexibleNamedStreamPipeline(
   source: AsyncIterable<Packet | null>,
-  stages: (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[],
+  stages: (Decoder | FilterAPI | FilterAPI[] | FrameSplitter | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[],
   metadata: StreamMetadata,
 ): AsyncGenerator<Packet | Frame | null> {
   let stream: AsyncIterable<any> = source;
@@ -1460,6 +1542,9 @@ async function* buildFlexibleNamedStreamPipeline(
       stream = stage.packets(stream as AsyncIterable<Frame>);
     } else if (isFilterAPI(stage)) {
       stream = stage.frames(stream as AsyncIterable<Frame>);
+    } else if (isFrameSplitter(stage)) {
+      // Feed the splitter and continue on a branch of our own
+      stream = stage.frames(stream as AsyncIterable<Frame>);
     } else if (isBitStreamFilterAPI(stage)) {
       metadata.bitStreamFilter = stage;
       stream = stage.packets(stream as AsyncIterable<Packet>);
@@ -1494,7 +1579,7 @@ async function* buildFlexibleNamedStreamPipeline(
  */
 async function* buildNamedStreamPipeline(
   source: AsyncIterable<Packet | null>,
-  stages: (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[],
+  stages: (Decoder | FilterAPI | FilterAPI[] | FrameSplitter | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[] | undefined)[],
   metadata: StreamMetadata,
 ): AsyncGenerator<Packet | null> {
   let stream: AsyncIterable<any> = source;
@@ -1508,6 +1593,9 @@ async function* buildNamedStreamPipeline(
       stream = stage.packets(stream as AsyncIterable<Frame>);
     } else if (isFilterAPI(stage)) {
       stream = stage.frames(stream as AsyncIterable<Frame>);
+    } else if (isFrameSplitter(stage)) {
+      // Feed the splitter and continue on a branch of our own
+      stream = stage.frames(stream as AsyncIterable<Frame>);
     } else if (isBitStreamFilterAPI(stage)) {
       metadata.bitStreamFilter = stage;
       stream = stage.packets(stream as AsyncIterable<Packet>);
@@ -1778,6 +1866,32 @@ function isBitStreamFilterAPI(obj: any): obj is BitStreamFilterAPI {
   return obj && typeof obj.filter === 'function' && typeof obj.flushPackets === 'function' && typeof obj.reset === 'function';
 }
 
+/**
+ * Check if object is FrameSplitter.
+ *
+ * @param obj - Object to check
+ *
+ * @returns True if object is FrameSplitter
+ *
+ * @internal
+ */
+function isFrameSplitter(obj: any): obj is FrameSplitter {
+  return obj && typeof obj.branch === 'function' && typeof obj.frames === 'function' && typeof obj.getStats === 'function';
+}
+
+/**
+ * Check if object is LoadShedder.
+ *
+ * @param obj - Object to check
+ *
+ * @returns True if object is LoadShedder
+ *
+ * @internal
+ */
+function isLoadShedder(obj: any): obj is LoadShedder {
+  return obj && typeof obj.setEncoder === 'function' && typeof obj.frames === 'function' && typeof obj.packets === 'function';
+}
+
 /**
  * Check if object is Muxer.
  *
@@ -1,4 +1,4 @@
-import { isRtcp, RtpPacket } from 'werift';
+import { RtpPacket } from 'werift';
 
 import { AV_HWDEVICE_TYPE_NONE } from '../constants/constants.js';
 import { FF_ENCODER_LIBOPUS, FF_ENCODER_LIBX264, FF_ENCODER_LIBX265 } from '../constants/encoders.js';
@@ -14,6 +14,7 @@ import { Muxer } from './muxer.js';
 import { pipeline } from './pipeline.js';
 
 import type { AVCodecID, AVHWDeviceType, AVSampleFormat, FFAudioEncoder, FFHWDeviceType, FFVideoEncoder } from '../constants/index.js';
+import type { RTPSinkUdpOptions } from '../lib/types.js';
 import type { PipelineControl } from './pipeline.js';
 import type { DemuxerOptions, EncoderOptions } from './types.js';
 
@@ -37,6 +38,28 @@ export interface RTPStreamOptions {
    */
   onAudioPacket?: (packet: RtpPacket) => void;
 
+  /**
+   * Callback invoked for each batch of video RTP datagrams.
+   * Datagrams are already serialized with rewritten headers, no RtpPacket is created.
+   * Preferred over `onVideoPacket` for high track counts, cannot be combined with it.
+   *
+   * @param slab - Buffer containing all datagrams of the batch back to back
+   *
+   * @param offsets - Datagram boundaries, datagram `i` spans `slab.subarray(offsets[i], offsets[i + 1])`
+   */
+  onVideoPackets?: (slab: Buffer, offsets: Uint32Array) => void;
+
+  /**
+   * Callback invoked for each batch of audio RTP datagrams.
+   * Datagrams are already serialized with rewritten headers, no RtpPacket is created.
+   * Preferred over `onAudioPacket` for high track counts, cannot be combined with it.
+   *
+   * @param slab - Buffer containing all datagrams of the batch back to back
+   *
+   * @param offsets - Datagram boundaries, datagram `i` spans `slab.subarray(offsets[i], offsets[i + 1])`
+   */
+  onAudioPackets?: (slab: Buffer, offsets: Uint32Array) => void;
+
   /**
    * Callback invoked when the stream is closed or encounters an error.
    *
@@ -80,6 +103,11 @@ export interface RTPStreamOptions {
     ssrc?: number;
     payloadType?: number;
     mtu?: number;
+    /**
+     * Send video datagrams natively over UDP (e.g. to a local SFU socket).
+     * When set, `onVideoPacket`/`onVideoPackets` are not called.
+     */
+    udp?: RTPSinkUdpOptions;
     fps?: number;
     width?: number;
     height?: number;
@@ -93,6 +121,11 @@ export interface RTPStreamOptions {
     ssrc?: number;
     payloadType?: number;
     mtu?: number;
+    /**
+     * Send audio datagrams natively over UDP (e.g. to a local SFU socket).
+     * When set, `onAudioPacket`/`onAudioPackets` are not called.
+     */
+    udp?: RTPSinkUdpOptions;
     sampleFormat?: AVSampleFormat;
     sampleRate?: number;
     channels?: number;
@@ -160,6 +193,13 @@ export class RTPStream {
    * @internal
    */
   private constructor(inputUrl: string, options: RTPStreamOptions) {
+    if (options.onVideoPacket && options.onVideoPackets) {
+      throw new TypeError('onVideoPacket and onVideoPackets are mutually exclusive');
+    }
+    if (options.onAudioPacket && options.onAudioPackets) {
+      throw new TypeError('onAudioPacket and onAudioPackets are mutually exclusive');
+    }
+
     this.inputUrl = inputUrl;
 
     this.inputOptions = {
@@ -185,6 +225,8 @@ export class RTPStream {
     this.options = {
       onVideoPacket: options.onVideoPacket ?? (() => {}),
       onAudioPacket: options.onAudioPacket ?? (() => {}),
+      onVideoPackets: options.onVideoPackets ?? RTPStream.unbatch(options.onVideoPacket),
+      onAudioPackets: options.onAudioPackets ?? RTPStream.unbatch(options.onAudioPacket),
       onClose: options.onClose ?? (() => {}),
       supportedVideoCodecs: Array.from(this.supportedVideoCodecs),
       supportedAudioCodecs: Array.from(this.supportedAudioCodecs),
@@ -194,6 +236,7 @@ export class RTPStream {
         ssrc: options.video?.ssrc,
         payloadType: options.video?.payloadType,
         mtu: options.video?.mtu ?? MAX_PACKET_SIZE,
+        udp: options.video?.udp,
         fps: options.video?.fps ?? 20,
         width: options.video?.width,
         height: options.video?.height,
@@ -203,6 +246,7 @@ export class RTPStream {
         ssrc: options.audio?.ssrc,
         payloadType: options.audio?.payloadType,
         mtu: options.audio?.mtu ?? MAX_PACKET_SIZE,
+        udp: options.audio?.udp,
         sampleRate: options.audio?.sampleRate,
         channels: options.audio?.channels,
         encoderOptions: options.audio?.encoderOptions,
@@ -223,6 +267,8 @@ export class RTPStream {
    *
    * @returns Configured RTP stream instance
    *
+   * @throws {TypeError} If both a per-packet and a batched callback are set for the same media type
+   *
    * @example
    * ```typescript
    * // Stream from RTSP camera
@@ -395,9 +441,9 @@ export class RTPStream {
     }
 
     // Initialize RTP sequence numbers and timestamps
-    let videoSequenceNumber = Math.floor(Math.random() * 0xffff);
-    let videoTimestamp = Math.floor(Math.random() * 0xffffffff) >>> 0; // unsigned 32-bit
-    let audioSequenceNumber = Math.floor(Math.random() * 0xffff);
+    const videoSequenceNumber = Math.floor(Math.random() * 0xffff);
+    const videoTimestamp = Math.floor(Math.random() * 0xffffffff) >>> 0; // unsigned 32-bit
+    const audioSequenceNumber = Math.floor(Math.random() * 0xffff);
 
     // Calculate video timestamp increment
     const videoStreamFps = videoStream ? videoStream.avgFrameRate.num / videoStream.avgFrameRate.den : 20;
@@ -406,46 +452,21 @@ export class RTPStream {
       fps = 20; // Default to 20 FPS if invalid
     }
 
-    const videoTimestampIncrement = 90000 / fps;
+    const videoTimestampIncrement = Math.round(90000 / fps);
 
     // Setup video output
+    // Header rewrites (SSRC, payload type, sequence number, timestamp) and RTCP
+    // filtering run in the native RTP sink, JS only receives finished datagrams
     this.videoOutput = await Muxer.open(
       {
-        write: (buffer: Buffer) => {
-          if (isRtcp(buffer)) {
-            // Ignore RTCP packets
-            return buffer.length;
-          }
-
-          const rtpPacket = RtpPacket.deSerialize(buffer);
-
-          // Set SSRC (synchronization source identifier)
-          if (this.options.video.ssrc !== undefined) {
-            rtpPacket.header.ssrc = this.options.video.ssrc;
-          }
-
-          // Set payload type
-          if (this.options.video.payloadType !== undefined) {
-            rtpPacket.header.payloadType = this.options.video.payloadType;
-          }
-
-          // Fix sequence number - ensure continuous sequence
-          rtpPacket.header.sequenceNumber = videoSequenceNumber;
-          videoSequenceNumber = (videoSequenceNumber + 1) & 0xffff; // Wrap at 16-bit
-
-          // Fix timestamp - calculate based on FPS
-          // All packets in same frame have same timestamp (marker=false)
-          // Only increment timestamp when frame ends (marker=true)
-          rtpPacket.header.timestamp = videoTimestamp;
-
-          // Increment timestamp for next frame when current frame ends
-          if (rtpPacket.header.marker) {
-            videoTimestamp = (videoTimestamp + videoTimestampIncrement) >>> 0; // Unsigned 32-bit wrap
-          }
-
-          this.options.onVideoPacket(rtpPacket);
-          return buffer.length;
-        },
+        ssrc: this.options.video.ssrc,
+        payloadType: this.options.video.payloadType,
+        sequenceNumber: videoSequenceNumber,
+        // All packets in same frame share the timestamp, advanced on marker bit
+        timestamp: videoTimestamp,
+        timestampIncrement: videoTimestampIncrement,
+        onPackets: this.options.onVideoPackets,
+        udp: this.options.video.udp,
       },
       {
         input: this.input,
@@ -519,31 +540,13 @@ export class RTPStream {
     if (audioStream) {
       this.audioOutput = await Muxer.open(
         {
-          write: (buffer: Buffer) => {
-            if (isRtcp(buffer)) {
-              // Ignore RTCP packets
-              return buffer.length;
-            }
-
-            const rtpPacket = RtpPacket.deSerialize(buffer);
-
-            // Set SSRC (synchronization source identifier)
-            if (this.options.audio.ssrc !== undefined) {
-              rtpPacket.header.ssrc = this.options.audio.ssrc;
-            }
-
-            // Set payload type
-            if (this.options.audio.payloadType !== undefined) {
-              rtpPacket.header.payloadType = this.options.audio.payloadType;
-            }
-
-            // Fix sequence number - ensure continuous sequence
-            rtpPacket.header.sequenceNumber = audioSequenceNumber;
-            audioSequenceNumber = (audioSequenceNumber + 1) & 0xffff; // Wrap at 16-bit
-
-            this.options.onAudioPacket(rtpPacket);
-            return buffer.length;
-          },
+          ssrc: this.options.audio.ssrc,
+          payloadType: this.options.audio.payloadType,
+          sequenceNumber: audioSequenceNumber,
+          // Audio packets are delivered one by one to keep latency low
+          maxBatchPackets: 1,
+          onPackets: this.options.onAudioPackets,
+          udp: this.options.audio.udp,
         },
         {
           input: this.input,
@@ -834,4 +837,25 @@ export class RTPStream {
 
     return firstLayout.mask.toString();
   }
+
+  /**
+   * Adapt a per-packet callback to the batched native RTP sink callback.
+   *
+   * @param onPacket - Per-packet callback
+   *
+   * @returns Batch callback deserializing each datagram
+   *
+   * @internal
+   */
+  private static unbatch(onPacket?: (packet: RtpPacket) => void): (slab: Buffer, offsets: Uint32Array) => void {
+    if (!onPacket) {
+      return () => {};
+    }
+
+    return (slab: Buffer, offsets: Uint32Array) => {
+      for (let i = 0; i < offsets.length - 1; i++) {
+        onPacket(RtpPacket.deSerialize(slab.subarray(offsets[i], offsets[i + 1])));
+      }
+    };
+  }
 }
@@ -0,0 +1,293 @@
+import { FFmpegError } from '../lib/error.js';
+import { VoiceActivityDetector } from '../lib/voice-activity-detector.js';
+
+import type { Frame } from '../lib/frame.js';
+import type { SpeechSegment } from '../lib/types.js';
+import type { SilenceGateOptions, SilenceGateStats } from './types.js';
+
+/**
+ * Silent frame held back as pre-roll.
+ */
+interface QueuedFrame {
+  frame: Frame;
+  start: number; // Source time in ms
+  duration: number; // ms
+}
+
+/**
+ * Silence gate for audio pipelines.
+ *
+ * Runs a {@link VoiceActivityDetector} over an audio frame stream and drops
+ * silent frames (or flags them in metadata), so expensive stages after it,
+ * like speech recognition, only see speech. The last `preRoll` ms of silence
+ * are held back and passed on when speech starts, so word onsets that are
+ * quieter than the detection threshold are kept.
+ *
+ * Audio passed on in 'drop' mode has gaps. {@link sourceTime} maps a time on
+ * the passed audio (counted in samples, as e.g. the whisper filter does) back
+ * to the source.
+ *
+ * @example
+ * ```typescript
+ * import { Decoder, Demuxer, FilterAPI, SilenceGate } from 'node-av/api';
+ *
+ * await using input = await Demuxer.open('meeting.wav');
+ * using decoder = await Decoder.create(input.audio()!);
+ *
+ * const gate = SilenceGate.create({
+ *   hangover: 500,
+ *   onSegment: ({ start, end }) => console.log(`Speech ${start}ms - ${end}ms`),
+ * });
+ *
+ * for await (using frame of gate.frames(decoder.frames(input.packets()))) {
+ *   // Only speech (and its pre-roll) arrives here
+ * }
+ *
+ * const { speechDuration, duration } = gate.getStats();
+ * console.log(`Skipped ${(duration - speechDuration).toFixed(0)}ms of silence`);
+ * ```
+ *
+ * @see {@link VoiceActivityDetector} For the detection
+ * @see {@link WhisperTranscriber} For transcription with the gate
+ */
+export class SilenceGate {
+  private detector: VoiceActivityDetector;
+  private mode: 'drop' | 'flag';
+  private preRoll: number;
+  private onSegment: SilenceGateOptions['onSegment'];
+  private queue: QueuedFrame[] = [];
+  private queuedDuration = 0;
+  private sourceClock = 0; // Source time in ms, counted in samples
+  private passedClock = 0; // Passed audio in ms, counted in samples
+  private spanPassed: number[] = []; // Passed time where a contiguous span starts
+  private spanSource: number[] = []; // Source time where that span starts
+  private passedFrames = 0;
+  private droppedFrames = 0;
+
+  /**
+   * @param options - Gate options
+   *
+   * @internal
+   */
+  private constructor(options: SilenceGateOptions) {
+    const { mode, preRoll, onSegment, ...detectorOptions } = options;
+    this.mode = mode ?? 'drop';
+    this.preRoll = Math.max(0, preRoll ?? 300);
+    this.onSegment = onSegment;
+    this.detector = VoiceActivityDetector.create({ ...detectorOptions, flagFrames: this.mode === 'flag' });
+  }
+
+  /**
+   * Create a silence gate.
+   *
+   * @param options - Detection options, mode, pre-roll and segment callback
+   *
+   * @returns Silence gate
+   *
+   * @example
+   * ```typescript
+   * // Keep all frames, mark silence for a later stage
+   * const gate = SilenceGate.create({ mode: 'flag' });
+   * ```
+   */
+  static create(options: SilenceGateOptions = {}): SilenceGate {
+    return new SilenceGate(options);
+  }
+
+  /**
+   * Whether speech is currently detected.
+   */
+  get speaking(): boolean {
+    return this.detector.speaking;
+  }
+
+  /**
+   * Gate an audio frame stream.
+   *
+   * In 'drop' mode, silent frames beyond the pre-roll are freed. In 'flag' mode
+   * all frames are passed on with 'vad.speech' metadata. On the null flush
+   * marker (or the end of the source), the open segment is ended and held
+   * back frames are freed.
+   *
+   * @param source - Audio frame source
+   *
+   * @yields {Frame | null} Speech frames, followed by null when the source sends it
+   *
+   * @throws {FFmpegError} If a frame cannot be analyzed
+   *
+   * @example
+   * ```typescript
+   * for await (using frame of encoder.packets(gate.frames(decoder.frames(packets)))) {
+   *   // ...
+   * }
+   * ```
+   */
+  async *frames(source: AsyncIterable<Frame | null>): AsyncGenerator<Frame | null> {
+    try {
+      for await (const frame of source) {
+        if (frame === null) {
+          this.finish();
+          yield null;
+          return;
+        }
+
+        const ret = this.detector.process(frame);
+        if (ret < 0) {
+          frame.free();
+          FFmpegError.throwIfError(ret, 'Failed to analyze audio frame');
+        }
+        this.emitSegments();
+
+        const duration = frame.sampleRate > 0 ? (frame.nbSamples * 1000) / frame.sampleRate : 0;
+        const start = this.sourceClock;
+        this.sourceClock += duration;
+
+        if (this.mode === 'flag') {
+          this.pass(start, duration);
+          yield frame;
+          continue;
+        }
+
+        if (ret === 1) {
+          // Speech: release the pre-roll first
+          const queued = this.queue;
+          this.queue = [];
+          this.queuedDuration = 0;
+          for (const item of queued) {
+            this.pass(item.start, item.duration);
+            yield item.frame;
+          }
+          this.pass(start, duration);
+          yield frame;
+          continue;
+        }
+
+        this.queue.push({ frame, start, duration });
+        this.queuedDuration += duration;
+        while (this.queue.length > 0 && this.queuedDuration > this.preRoll) {
+          const dropped = this.queue.shift()!;
+          this.queuedDuration -= dropped.duration;
+          dropped.frame.free();
+          this.droppedFrames++;
+        }
+      }
+
+      this.finish();
+    } finally {
+      this.discardQueue();
+    }
+  }
+
+  /**
+   * Map a time on the passed audio to the source.
+   *
+   * The passed audio is counted in samples from the first passed frame, as a
+   * downstream stage sees it. Source time is counted in samples from the first
+   * frame of the source.
+   *
+   * @param passedTime - Time on the passed audio in ms
+   *
+   * @returns Source time in ms
+   *
+   * @example
+   * ```typescript
+   * // Whisper segment start, on the gated audio
+   * const start = gate.sourceTime(segment.start);
+   * ```
+   */
+  sourceTime(passedTime: number): number {
+    // Last span starting at or before passedTime
+    let low = 0;
+    let high = this.spanPassed.length - 1;
+    if (high < 0) {
+      return passedTime;
+    }
+    while (low < high) {
+      const mid = (low + high + 1) >> 1;
+      if (this.spanPassed[mid] <= passedTime) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    return this.spanSource[low] + (passedTime - this.spanPassed[low]);
+  }
+
+  /**
+   * Get gate statistics.
+   *
+   * @returns Detection statistics and frame counters
+   *
+   * @example
+   * ```typescript
+   * const stats = gate.getStats();
+   * console.log(`${stats.droppedFrames} silent frames dropped`);
+   * ```
+   */
+  getStats(): SilenceGateStats {
+    return {
+      ...this.detector.getStats(),
+      passedFrames: this.passedFrames,
+      droppedFrames: this.droppedFrames,
+    };
+  }
+
+  /**
+   * Record a passed frame on the time map.
+   *
+   * @param start - Source time of the frame in ms
+   *
+   * @param duration - Frame duration in ms
+   *
+   * @internal
+   */
+  private pass(start: number, duration: number): void {
+    const last = this.spanPassed.length - 1;
+    const contiguous = last >= 0 && Math.abs(this.spanSource[last] + (this.passedClock - this.spanPassed[last]) - start) < 1e-6;
+    if (!contiguous) {
+      this.spanPassed.push(this.passedClock);
+      this.spanSource.push(start);
+    }
+    this.passedClock += duration;
+    this.passedFrames++;
+  }
+
+  /**
+   * End of stream: end the open segment and free held back frames.
+   *
+   * @internal
+   */
+  private finish(): void {
+    this.detector.flush();
+    this.emitSegments();
+    this.discardQueue();
+  }
+
+  /**
+   * Free held back frames.
+   *
+   * @internal
+   */
+  private discardQueue(): void {
+    for (const item of this.queue) {
+      item.frame.free();
+      this.droppedFrames++;
+    }
+    this.queue = [];
+    this.queuedDuration = 0;
+  }
+
+  /**
+   * Report ended segments to the callback.
+   *
+   * @internal
+   */
+  private emitSegments(): void {
+    const segments: SpeechSegment[] = this.detector.takeSegments();
+    if (this.onSegment) {
+      for (const segment of segments) {
+        this.onSegment(segment);
+      }
+    }
+  }
+}
@@ -1,6 +1,14 @@
 import type { RtpPacket } from 'werift';
 import type { AVMediaType, AVPixelFormat, AVSampleFormat, AVSeekWhence } from '../constants/index.js';
-import type { IRational } from '../lib/types.js';
+import type {
+  HardwareDeviceCapability,
+  IRational,
+  PacketPacerOptions,
+  RTPSinkOptions,
+  SpeechSegment,
+  VoiceActivityDetectorOptions,
+  VoiceActivityStats,
+} from '../lib/types.js';
 import type { Decoder } from './decoder.js';
 import type { Demuxer } from './demuxer.js';
 import type { FilterComplexAPI } from './filter-complex.js';
@@ -219,6 +227,178 @@ export interface DemuxerOptions {
    * @default false
    */
   blocking?: boolean;
+
+  /**
+   * Read the input in real time (FFmpeg CLI's -re / -readrate).
+   *
+   * The demux loop of {@link Demuxer.packets} releases packets according to their
+   * DTS relative to a wall clock, using a native {@link PacketPacer}. Waiting does
+   * not block the event loop or the libuv threadpool. Pass options to set speed,
+   * initial burst and drift correction. Does not apply to packetsSync().
+   *
+   * Useful for restreaming files as live channels.
+   *
+   * @default false
+   */
+  pacing?: boolean | PacketPacerOptions;
+
+  /**
+   * Number of times to loop the input (FFmpeg CLI's -stream_loop).
+   *
+   * At end of file the input is rewound and timestamps continue from the end
+   * of the previous pass, so downstream stages see one continuous stream.
+   * 0 disables looping, -1 loops forever. Requires a seekable input.
+   * Applies to {@link Demuxer.packets}.
+   *
+   * @default 0
+   */
+  loop?: number;
+
+  /**
+   * Reconnect network inputs (RTSP, TCP, HTTP live streams) after a drop or stall.
+   *
+   * Reconnects in the background of {@link Demuxer.packets}: the generators keep
+   * running, stream objects stay valid and timestamps continue from the last
+   * packet, so decoders created from the streams are kept open. If the new
+   * connection reports different codec parameters the generators end instead.
+   * Only applies to URL inputs. Pass options to tune stall detection, backoff
+   * and the warm standby connection.
+   *
+   * @default false
+   */
+  reconnect?: boolean | ReconnectOptions;
+
+  /**
+   * Read local files through a memory mapping instead of the file protocol.
+   *
+   * Packet payloads are copied once from the mapped file into the packet
+   * instead of being read into the I/O buffer and copied again, which mostly
+   * benefits remuxing and stream copy of large local files. Ignored for URLs
+   * and device inputs.
+   *
+   * Meant for finished files. The mapping covers the size at open, so data
+   * appended later is not read. Truncating the file while it is open can
+   * crash the process (SIGBUS) when a read touches the removed pages. The
+   * size is re-checked every few megabytes and reads switch to pread() once
+   * a truncation is seen, but that only narrows the window. Do not use it
+   * for files that are still being written or may be truncated by another
+   * process.
+   *
+   * @default false
+   */
+  mmap?: boolean;
+}
+
+/**
+ * Reconnect options for network inputs.
+ *
+ * @see {@link DemuxerOptions.reconnect}
+ */
+export interface ReconnectOptions {
+  /**
+   * Time in milliseconds without a packet after which the connection is
+   * considered stalled and is replaced.
+   *
+   * Blocking reads are interrupted natively (FormatContext.readTimeout).
+   *
+   * @default 5000
+   */
+  stallTimeout?: number;
+
+  /**
+   * Connection attempts per disconnect before giving up (-1 for unlimited).
+   *
+   * @default -1
+   */
+  maxAttempts?: number;
+
+  /**
+   * Delay in milliseconds before the first retry, doubled on every failed attempt.
+   *
+   * @default 500
+   */
+  delay?: number;
+
+  /**
+   * Maximum retry delay in milliseconds.
+   *
+   * @default 10000
+   */
+  maxDelay?: number;
+
+  /**
+   * Keep a second, paused connection ready for instant failover.
+   *
+   * The standby is opened and probed in the background and paused (RTSP PAUSE)
+   * until needed, so failover skips DESCRIBE/SETUP and stream probing. It is
+   * refreshed every `standbyRefresh` milliseconds so the server session does
+   * not expire. Costs one extra session on the server.
+   *
+   * @default false
+   */
+  standby?: boolean;
+
+  /**
+   * Interval in milliseconds at which the standby connection is re-established.
+   *
+   * @default 30000
+   */
+  standbyRefresh?: number;
+
+  /**
+   * Called when the connection was lost.
+   *
+   * @param error - AVERROR code of the failed read (AVERROR_EOF when closed by the server)
+   *
+   * @param stalled - True if no packet arrived within `stallTimeout`
+   */
+  onDisconnect?: (error: number, stalled: boolean) => void;
+
+  /**
+   * Called when a new connection has replaced the lost one.
+   *
+   * @param attempt - Number of the successful attempt (1 for the first)
+   *
+   * @param standby - True if the standby connection was used
+   */
+  onReconnect?: (attempt: number, standby: boolean) => void;
+}
+
+/**
+ * Reconnect statistics of a demuxer.
+ *
+ * @see {@link Demuxer.getReconnectStats}
+ */
+export interface ReconnectStats {
+  /**
+   * Successful reconnects.
+   */
+  reconnects: number;
+
+  /**
+   * Disconnects caused by a stall (no packet within `stallTimeout`).
+   */
+  stalls: number;
+
+  /**
+   * Failed connection attempts.
+   */
+  failedAttempts: number;
+
+  /**
+   * Failovers served by the standby connection.
+   */
+  standbyFailovers: number;
+
+  /**
+   * Whether a standby connection is ready.
+   */
+  standbyReady: boolean;
+
+  /**
+   * Why reconnecting ended the stream ('attempts' or 'parameters'), null while reconnecting is possible.
+   */
+  gaveUp: 'attempts' | 'parameters' | null;
 }
 
 /**
@@ -391,6 +571,43 @@ export interface MuxerOptions {
    */
   useAsyncWrite?: boolean;
 
+  /**
+   * Write a fast-start MP4 (moov in front) without a second rewrite pass.
+   *
+   * Only for file outputs of the mp4/mov family. While recording, the muxer
+   * writes a fragmented MP4 (`frag_keyframe+empty_moov+default_base_moof`,
+   * fragments of at most `frag_duration`, 2 seconds unless set in `options`)
+   * to `<path>.part`, so an interrupted recording is still playable. On close
+   * the fragments are converted in a single pass into a regular MP4 at
+   * `<path>`: only the fragment headers are parsed and the media data is
+   * copied in kernel space where supported. If the conversion fails, the
+   * fragmented file is kept at `<path>` and the error is passed to
+   * {@link onFastStartError}.
+   *
+   * Replaces `movflags=faststart`, which rewrites the whole file after the
+   * trailer is written.
+   *
+   * @default false
+   */
+  fastStart?: boolean;
+
+  /**
+   * Progress of the fast-start finalize on close.
+   *
+   * Called with the copied fraction of the media data (0..1).
+   * Only used with {@link fastStart} and the async close().
+   */
+  onFinalizeProgress?: (progress: number) => void;
+
+  /**
+   * Called when the fast-start finalize on close fails.
+   *
+   * The fragmented recording is kept at the output path (without fast start).
+   * Without a handler, the error is emitted as a process warning with code
+   * `NODE_AV_FAST_START`. Only used with {@link fastStart}.
+   */
+  onFastStartError?: (error: Error) => void;
+
   /**
    * FFmpeg format options passed directly to the output.
    *
@@ -560,6 +777,216 @@ export interface EncoderOptions {
   options?: Record<string, string | number | boolean | undefined | null>;
 }
 
+/**
+ * Drop policy of a FrameSplitter branch when its queue is full.
+ *
+ * - 'block': Wait for the branch (lossless, a slow branch stalls all branches)
+ * - 'drop-oldest': Discard the oldest queued frame (branch sees the most recent frames)
+ * - 'drop-newest': Discard the incoming frame
+ */
+export type FrameSplitterDropPolicy = 'block' | 'drop-oldest' | 'drop-newest';
+
+/**
+ * Options for a FrameSplitter branch.
+ */
+export interface FrameSplitterBranchOptions {
+  /**
+   * Maximum number of frames queued for this branch.
+   *
+   * @default 2
+   */
+  queueSize?: number;
+
+  /**
+   * What to do when the queue is full.
+   *
+   * @default 'block'
+   */
+  dropPolicy?: FrameSplitterDropPolicy;
+}
+
+/**
+ * Statistics of a FrameSplitter branch.
+ */
+export interface FrameSplitterBranchStats {
+  /**
+   * Frames handed to the branch consumer.
+   */
+  delivered: number;
+
+  /**
+   * Frames discarded by the drop policy.
+   */
+  dropped: number;
+
+  /**
+   * Frames currently queued.
+   */
+  queued: number;
+}
+
+/**
+ * Load shedding action, in escalation order.
+ *
+ * - 'drop-disposable': Drop packets flagged AV_PKT_FLAG_DISPOSABLE before decoding
+ * - 'drop-frames': Drop decoded frames before filtering/encoding
+ * - 'lower-bitrate': Lower the encoder bitrate
+ */
+export type LoadSheddingAction = 'drop-disposable' | 'drop-frames' | 'lower-bitrate';
+
+/**
+ * Load shedding state change passed to the LoadShedder callbacks.
+ */
+export interface LoadSheddingEvent {
+  /**
+   * Action that started or stopped.
+   */
+  action: LoadSheddingAction;
+
+  /**
+   * Measured latency in milliseconds when the change happened.
+   */
+  latency: number;
+}
+
+/**
+ * Options for creating a LoadShedder.
+ *
+ * Thresholds are latencies in milliseconds. An action starts when the latency
+ * exceeds its threshold and stops when it falls below `threshold * recoveryRatio`.
+ * Set a threshold to 0 to disable the action.
+ */
+export interface LoadSheddingOptions {
+  /**
+   * Latency above which disposable packets are dropped before decoding.
+   *
+   * @default 200
+   */
+  dropDisposableAfter?: number;
+
+  /**
+   * Latency above which decoded frames are dropped before filtering/encoding.
+   *
+   * @default 500
+   */
+  dropFramesAfter?: number;
+
+  /**
+   * Keep one of every N frames while dropping frames.
+   *
+   * @default 2
+   */
+  frameDecimation?: number;
+
+  /**
+   * Latency above which the encoder bitrate is lowered.
+   * Only effective for encoders that apply bitrate changes while running (e.g. libx264).
+   *
+   * @default 1000
+   */
+  lowerBitrateAfter?: number;
+
+  /**
+   * Factor applied to the encoder bitrate while lowered.
+   *
+   * @default 0.5
+   */
+  bitrateScale?: number;
+
+  /**
+   * Fraction of a threshold the latency must fall below to stop an action.
+   *
+   * @default 0.5
+   */
+  recoveryRatio?: number;
+
+  /**
+   * Called when an action starts.
+   */
+  onSheddingStart?: (event: LoadSheddingEvent) => void;
+
+  /**
+   * Called when an action stops.
+   */
+  onSheddingStop?: (event: LoadSheddingEvent) => void;
+}
+
+/**
+ * Statistics of a LoadShedder.
+ */
+export interface LoadSheddingStats {
+  /**
+   * Latest measured latency in milliseconds.
+   */
+  latency: number;
+
+  /**
+   * Highest measured latency in milliseconds.
+   */
+  maxLatency: number;
+
+  /**
+   * Actions currently active.
+   */
+  activeActions: LoadSheddingAction[];
+
+  /**
+   * Disposable packets dropped before decoding.
+   */
+  droppedPackets: number;
+
+  /**
+   * Frames dropped before filtering/encoding.
+   */
+  droppedFrames: number;
+}
+
+/**
+ * Options for creating a SilenceGate.
+ *
+ * Detection options are passed to the VoiceActivityDetector; times are in milliseconds.
+ */
+export interface SilenceGateOptions extends Omit<VoiceActivityDetectorOptions, 'flagFrames'> {
+  /**
+   * What happens to silent frames.
+   *
+   * - 'drop': Silent frames are freed and not passed on
+   * - 'flag': All frames are passed on with 'vad.speech' metadata set to '1' or '0'
+   *
+   * @default 'drop'
+   */
+  mode?: 'drop' | 'flag';
+
+  /**
+   * Silent audio kept and passed on before speech starts, so the start of
+   * speech is not cut off. Only used in 'drop' mode. Should be longer than
+   * `minSpeech`.
+   *
+   * @default 300
+   */
+  preRoll?: number;
+
+  /**
+   * Called when a speech segment ends.
+   */
+  onSegment?: (segment: SpeechSegment) => void;
+}
+
+/**
+ * Statistics of a SilenceGate.
+ */
+export interface SilenceGateStats extends VoiceActivityStats {
+  /**
+   * Frames passed on.
+   */
+  passedFrames: number;
+
+  /**
+   * Silent frames dropped.
+   */
+  droppedFrames: number;
+}
+
 /**
  * Options for creating a filter instance.
  */
@@ -730,6 +1157,108 @@ export interface HardwareOptions {
    * Device initialization options.
    */
   options?: Record<string, string>;
+
+  /**
+   * Capability cache file used by {@link HardwareContext.auto}.
+   *
+   * When set, auto() selects the device from the cached capability matrix
+   * (see {@link HardwareContext.probeCapabilitiesSync}) instead of creating
+   * every candidate device and test-decoding on it. Device types that failed
+   * before are skipped and the verified one is created without a test decode.
+   * The cache is rebuilt when the FFmpeg build or the device node changes.
+   */
+  capabilityCache?: string;
+}
+
+/**
+ * Options for hardware capability probing.
+ */
+export interface HardwareProbeOptions {
+  /**
+   * Device path or index used for every device type.
+   *
+   * VAAPI defaults to /dev/dri/renderD128 like {@link HardwareContext.auto}.
+   */
+  device?: string;
+
+  /**
+   * Device initialization options.
+   */
+  options?: Record<string, string>;
+
+  /**
+   * JSON file to persist the capability matrix in.
+   *
+   * Entries are keyed by FFmpeg build, platform and device node, so one file
+   * can be shared by all processes of a host. Unreadable or stale files are
+   * ignored and rewritten.
+   */
+  cacheFile?: string;
+
+  /**
+   * Ignore cached results and probe again.
+   *
+   * @default false
+   */
+  refresh?: boolean;
+
+  /**
+   * Verify every available device with a test decode.
+   *
+   * Sets {@link HardwareDeviceCapabilities.verified}. Without verification
+   * auto() still test-decodes before using a device.
+   *
+   * @default true
+   */
+  verify?: boolean;
+}
+
+/**
+ * Capabilities of one hardware device type.
+ */
+export interface HardwareDeviceCapabilities extends HardwareDeviceCapability {
+  /**
+   * Result of the test decode, or null if not verified.
+   */
+  verified: boolean | null;
+}
+
+/**
+ * Hardware capability matrix of this host.
+ *
+ * Device types × codecs × pixel formats for decoding and encoding.
+ * Plain JSON, safe to persist and to send to other processes.
+ */
+export interface HardwareCapabilities {
+  /**
+   * Cache key (FFmpeg build, platform and device node).
+   */
+  key: string;
+
+  /**
+   * FFmpeg version string.
+   */
+  ffmpegVersion: string;
+
+  /**
+   * Device specifier the matrix was probed with (null for defaults).
+   */
+  device: string | null;
+
+  /**
+   * Probe time (milliseconds since epoch).
+   */
+  probedAt: number;
+
+  /**
+   * Whether the matrix was reused from the process or file cache.
+   */
+  fromCache: boolean;
+
+  /**
+   * Capabilities per device type compiled into FFmpeg.
+   */
+  devices: HardwareDeviceCapabilities[];
 }
 
 /**
@@ -799,6 +1328,29 @@ export interface IOOutputCallbacks {
   read?: (size: number) => Buffer | null | number;
 }
 
+/**
+ * Native RTP output target.
+ *
+ * Replaces {@link IOOutputCallbacks} for `format: 'rtp'` outputs.
+ * Header rewrites, RTCP filtering and batching run natively, JS only
+ * receives batches of ready-to-send datagrams.
+ * Used by Muxer.open() and RTPStream.
+ *
+ */
+export interface IORTPSinkTarget extends RTPSinkOptions {
+  /**
+   * Batch callback - called with ready-to-send RTP datagrams.
+   * Not called (and optional) when `udp` is set.
+   *
+   * Datagram `i` spans `slab.subarray(offsets[i], offsets[i + 1])`.
+   *
+   * @param slab - Buffer containing all datagrams of the batch back to back
+   *
+   * @param offsets - Datagram boundaries (length = datagram count + 1)
+   */
+  onPackets?: (slab: Buffer, offsets: Uint32Array) => void;
+}
+
 /**
  * RTP Demuxer interface.
  */
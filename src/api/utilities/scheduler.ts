@@ -1,6 +1,10 @@
+import { AVERROR_EAGAIN, AVERROR_EOF } from '../../constants/constants.js';
+import { FFmpegError } from '../../lib/error.js';
+import { Frame } from '../../lib/frame.js';
+import { Packet } from '../../lib/packet.js';
 import { Muxer } from '../muxer.js';
 
-import type { Frame, Packet } from '../../lib/index.js';
+import type { PipelineStage } from '../../lib/pipeline-stage.js';
 import type { BitStreamFilterAPI } from '../bitstream-filter.js';
 import type { Encoder } from '../encoder.js';
 import type { FilterAPI } from '../filter.js';
@@ -10,6 +14,79 @@ export interface SchedulableComponent<TItem = Packet | Frame> {
   pipeTo(target: FilterAPI | Encoder | BitStreamFilterAPI | Muxer, streamIndex?: number): any;
 }
 
+/**
+ * Component that can run on a native stage fed by an upstream stage.
+ *
+ * @internal
+ */
+export interface StageLinkable {
+  /**
+   * Initialize from the upstream output parameters and create the stage.
+   *
+   * @param template - Frame carrying the upstream output parameters (no data)
+   *
+   * @returns Stage to connect to, or null to keep the JavaScript worker
+   */
+  linkStage(template: Frame): PipelineStage | null;
+
+  /**
+   * Promise settling once the tail of the stage chain has drained.
+   *
+   * @returns Forwarding task of the chain tail, or null if the tail is not piped yet
+   */
+  stageDrained(): Promise<void> | null;
+}
+
+/**
+ * Forward the output of a stage chain tail to a JavaScript component or muxer.
+ *
+ * Frames handed to a component are owned by it; packets written to the muxer
+ * reuse one packet. End of stream is propagated to the component.
+ *
+ * @param stage - Tail stage of the chain (started by this function)
+ *
+ * @param target - Next component or muxer
+ *
+ * @param streamIndex - Output stream index (muxer only)
+ *
+ * @internal
+ */
+export async function forwardStage(stage: PipelineStage, target: SchedulableComponent<Frame | Packet> | Muxer, streamIndex?: number): Promise<void> {
+  const pull = async (item: Frame | Packet): Promise<boolean> => {
+    let ret = stage.pull(item);
+    if (ret === AVERROR_EAGAIN) {
+      ret = await stage.pullAsync(item);
+    }
+    if (ret === AVERROR_EOF) {
+      return false;
+    }
+    FFmpegError.throwIfError(ret, `Native ${stage.kind} stage failed`);
+    return true;
+  };
+
+  stage.start();
+
+  if (target instanceof Muxer) {
+    using packet = new Packet();
+    packet.alloc();
+    while (await pull(packet)) {
+      await target.writePacket(packet, streamIndex!);
+    }
+    return;
+  }
+
+  while (true) {
+    const item = stage.kind === 'encoder' ? new Packet() : new Frame();
+    item.alloc();
+    if (!(await pull(item))) {
+      item.free();
+      break;
+    }
+    await target.sendToQueue(item);
+  }
+  await target.sendToQueue(null);
+}
+
 /**
  * Pipeline scheduler for chaining components.
  *
@@ -10,6 +10,7 @@ import {
   AV_CODEC_ID_VP8,
   AV_CODEC_ID_VP9,
 } from '../constants/constants.js';
+import { RTSPTalkback } from '../lib/rtsp-talkback.js';
 import { RTPStream } from './rtp-stream.js';
 
 import type { AVCodecID } from '../constants/index.js';
@@ -126,6 +127,7 @@ export class WebRTCStream {
   private pc: RTCPeerConnection | null = null;
   private videoTrack: MediaStreamTrack | null = null;
   private audioTrack: MediaStreamTrack | null = null;
+  private talkback: RTSPTalkback | null = null;
   private options: WebRTCStreamOptions;
   private pendingIceCandidates: string[] = [];
 
@@ -246,6 +248,9 @@ export class WebRTCStream {
    * ```
    */
   async stop(): Promise<void> {
+    // Stop talkback before the input (and its RTSP connection) is closed
+    await this.talkback?.stop();
+    this.talkback = null;
     await this.stream.stop();
     this.pc?.close();
     this.videoTrack = null;
@@ -386,8 +391,24 @@ export class WebRTCStream {
         const streams = ctx?.getRTSPStreamInfo();
         const backchannel = streams?.find((s) => s.direction === 'sendonly' && s.mediaType === 'audio');
 
+        // Opus backchannels take the WebRTC packets as they are,
+        // other codecs are transcoded natively (decode, resample, encode, packetize)
+        if (ctx && backchannel && backchannel.codecId !== AV_CODEC_ID_OPUS) {
+          try {
+            this.talkback = RTSPTalkback.create(ctx, backchannel.streamIndex);
+          } catch {
+            // Unsupported backchannel codec - fall back to forwarding
+            this.talkback = null;
+          }
+        }
+
         track.onReceiveRtp.subscribe(async (rtp) => {
           if (backchannel && this.stream.isStreamActive) {
+            if (this.talkback) {
+              this.talkback.push(rtp.serialize());
+              return;
+            }
+
             try {
               await ctx?.sendRTSPPacket(backchannel.streamIndex, rtp.serialize());
             } catch {
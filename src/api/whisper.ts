@@ -1,8 +1,10 @@
+import { Frame } from '../lib/frame.js';
 import { FilterPreset } from './filter-presets.js';
 import { FilterAPI } from './filter.js';
+import { SilenceGate } from './silence-gate.js';
 import { WhisperDownloader } from './utilities/whisper-model.js';
 
-import type { Frame } from '../lib/frame.js';
+import type { SilenceGateOptions } from './types.js';
 import type { WhisperModelName, WhisperVADModelName } from './utilities/whisper-model.js';
 
 /**
@@ -128,6 +130,19 @@ export interface WhisperTranscriberOptions {
    * @default 0.5
    */
   vadMinSilenceDuration?: number;
+
+  /**
+   * Drop silent frames before the whisper filter.
+   *
+   * Runs a {@link SilenceGate} (energy and zero-crossing detection) on the
+   * frames, so whisper only processes speech. Segment times still refer to
+   * the source audio. Unlike `vadModel`, no model is needed and silence never
+   * reaches the filter. Pass options to tune the detection. Applies to frame
+   * streams, not to single frames passed to transcribe().
+   *
+   * @default false
+   */
+  silenceGate?: boolean | SilenceGateOptions;
 }
 
 /**
@@ -274,6 +289,7 @@ export class WhisperTranscriber implements Disposable {
       vadThreshold: options.vadThreshold ?? 0.5,
       vadMinSpeechDuration: options.vadMinSpeechDuration ?? 0.1,
       vadMinSilenceDuration: options.vadMinSilenceDuration ?? 0.5,
+      silenceGate: options.silenceGate ?? false,
     };
 
     return new WhisperTranscriber(fullOptions);
@@ -353,6 +369,13 @@ export class WhisperTranscriber implements Disposable {
       dropOnChange: false,
     });
 
+    // Drop silence before the filter; whisper then counts time on the gated audio
+    let gate: SilenceGate | null = null;
+    if (this.options.silenceGate && frames !== null && !(frames instanceof Frame)) {
+      gate = SilenceGate.create(this.options.silenceGate === true ? {} : this.options.silenceGate);
+      frames = gate.frames(frames);
+    }
+
     // Track cumulative time for start/end timestamps
     let cumulativeTime = 0; // in milliseconds
     const filterGenerator = filter.frames(frames);
@@ -378,8 +401,8 @@ export class WhisperTranscriber implements Disposable {
 
         // Yield transcribed segment
         yield {
-          start: cumulativeTime,
-          end: cumulativeTime + duration,
+          start: gate ? gate.sourceTime(cumulativeTime) : cumulativeTime,
+          end: gate ? gate.sourceTime(cumulativeTime + duration) : cumulativeTime + duration,
           text: text.trim(),
         };
 
@@ -1,4 +1,6 @@
 #include "audio_fifo.h"
+#include "tracing.h"
+#include "inline_dispatch.h"
 #include <napi.h>
 
 extern "C" {
@@ -41,6 +43,8 @@ public:
   }
   
   void Execute() override {
+    Tracing::Scope trace("AudioFifoWriteWorker", "worker", fifo_);
+
     // Null checks to prevent use-after-free crashes
     if (!fifo_) {
       result_ = AVERROR(EINVAL);
@@ -103,6 +107,8 @@ public:
   }
   
   void Execute() override {
+    Tracing::Scope trace("AudioFifoReadWorker", "worker", fifo_);
+
     // Null checks to prevent use-after-free crashes
     if (!fifo_) {
       result_ = AVERROR(EINVAL);
@@ -165,6 +171,8 @@ public:
   }
   
   void Execute() override {
+    Tracing::Scope trace("AudioFifoPeekWorker", "worker", fifo_);
+
     // Null checks to prevent use-after-free crashes
     if (!fifo_) {
       result_ = AVERROR(EINVAL);
@@ -219,10 +227,13 @@ Napi::Value AudioFifo::WriteAsync(const Napi::CallbackInfo& info) {
       return env.Undefined();
     }
     
+    // Cost estimate: the copy is bounded by the buffer sizes
+    size_t bytes = 0;
     for (uint32_t i = 0; i < dataArray.Length(); i++) {
       if (dataArray.Get(i).IsBuffer()) {
         Napi::Buffer<uint8_t> buf = dataArray.Get(i).As<Napi::Buffer<uint8_t>>();
         data[i] = buf.Data();
+        bytes += buf.Length();
       } else {
         data[i] = nullptr;
       }
@@ -230,8 +241,7 @@ Napi::Value AudioFifo::WriteAsync(const Napi::CallbackInfo& info) {
 
     Napi::Object thisObj = info.This().As<Napi::Object>();
     auto* worker = new AudioFifoWriteWorker(env, thisObj, fifo_, info[0], data, dataArray.Length(), nb_samples);
-    auto promise = worker->GetPromise();
-    worker->Queue();
+    auto promise = InlineDispatch::Dispatch(InlineDispatch::kAudioFifo, bytes, worker);
 
     av_free(data);
     return promise;
@@ -240,11 +250,11 @@ Napi::Value AudioFifo::WriteAsync(const Napi::CallbackInfo& info) {
   else if (info[0].IsBuffer()) {
     Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
     void* data[1] = { buffer.Data() };
+    size_t bytes = buffer.Length();
 
     Napi::Object thisObj = info.This().As<Napi::Object>();
     auto* worker = new AudioFifoWriteWorker(env, thisObj, fifo_, info[0], data, 1, nb_samples);
-    auto promise = worker->GetPromise();
-    worker->Queue();
+    auto promise = InlineDispatch::Dispatch(InlineDispatch::kAudioFifo, bytes, worker);
 
     return promise;
   }
@@ -278,10 +288,13 @@ Napi::Value AudioFifo::ReadAsync(const Napi::CallbackInfo& info) {
       return env.Undefined();
     }
     
+    // Cost estimate: the copy is bounded by the buffer sizes
+    size_t bytes = 0;
     for (uint32_t i = 0; i < dataArray.Length(); i++) {
       if (dataArray.Get(i).IsBuffer()) {
         Napi::Buffer<uint8_t> buf = dataArray.Get(i).As<Napi::Buffer<uint8_t>>();
         data[i] = buf.Data();
+        bytes += buf.Length();
       } else {
         data[i] = nullptr;
       }
@@ -289,8 +302,7 @@ Napi::Value AudioFifo::ReadAsync(const Napi::CallbackInfo& info) {
 
     Napi::Object thisObj = info.This().As<Napi::Object>();
     auto* worker = new AudioFifoReadWorker(env, thisObj, fifo_, info[0], data, dataArray.Length(), nb_samples);
-    auto promise = worker->GetPromise();
-    worker->Queue();
+    auto promise = InlineDispatch::Dispatch(InlineDispatch::kAudioFifo, bytes, worker);
 
     av_free(data);
     return promise;
@@ -299,11 +311,11 @@ Napi::Value AudioFifo::ReadAsync(const Napi::CallbackInfo& info) {
   else if (info[0].IsBuffer()) {
     Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
     void* data[1] = { buffer.Data() };
+    size_t bytes = buffer.Length();
 
     Napi::Object thisObj = info.This().As<Napi::Object>();
     auto* worker = new AudioFifoReadWorker(env, thisObj, fifo_, info[0], data, 1, nb_samples);
-    auto promise = worker->GetPromise();
-    worker->Queue();
+    auto promise = InlineDispatch::Dispatch(InlineDispatch::kAudioFifo, bytes, worker);
 
     return promise;
   }
@@ -337,10 +349,13 @@ Napi::Value AudioFifo::PeekAsync(const Napi::CallbackInfo& info) {
       return env.Undefined();
     }
     
+    // Cost estimate: the copy is bounded by the buffer sizes
+    size_t bytes = 0;
     for (uint32_t i = 0; i < dataArray.Length(); i++) {
       if (dataArray.Get(i).IsBuffer()) {
         Napi::Buffer<uint8_t> buf = dataArray.Get(i).As<Napi::Buffer<uint8_t>>();
         data[i] = buf.Data();
+        bytes += buf.Length();
       } else {
         data[i] = nullptr;
       }
@@ -348,8 +363,7 @@ Napi::Value AudioFifo::PeekAsync(const Napi::CallbackInfo& info) {
 
     Napi::Object thisObj = info.This().As<Napi::Object>();
     auto* worker = new AudioFifoPeekWorker(env, thisObj, fifo_, info[0], data, dataArray.Length(), nb_samples);
-    auto promise = worker->GetPromise();
-    worker->Queue();
+    auto promise = InlineDispatch::Dispatch(InlineDispatch::kAudioFifo, bytes, worker);
 
     av_free(data);
     return promise;
@@ -358,11 +372,11 @@ Napi::Value AudioFifo::PeekAsync(const Napi::CallbackInfo& info) {
   else if (info[0].IsBuffer()) {
     Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
     void* data[1] = { buffer.Data() };
+    size_t bytes = buffer.Length();
 
     Napi::Object thisObj = info.This().As<Napi::Object>();
     auto* worker = new AudioFifoPeekWorker(env, thisObj, fifo_, info[0], data, 1, nb_samples);
-    auto promise = worker->GetPromise();
-    worker->Queue();
+    auto promise = InlineDispatch::Dispatch(InlineDispatch::kAudioFifo, bytes, worker);
 
     return promise;
   }
@@ -0,0 +1,718 @@
+#include "audio_mixer.h"
+#include "frame.h"
+#include "tracing.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+extern "C" {
+#include <libavutil/mathematics.h>
+#include <libavutil/time.h>
+}
+
+namespace ffmpeg {
+
+static constexpr int DEFAULT_SAMPLE_RATE = 48000;
+static constexpr int DEFAULT_FRAME_SIZE = 1024;
+static constexpr double DEFAULT_MAX_WAIT_MS = 100;
+static constexpr double DEFAULT_MAX_BUFFERED_MS = 500;
+
+// Soft clipper knee; samples below it pass unchanged
+static constexpr float SOFT_CLIP_KNEE = 0.8f;
+
+Napi::FunctionReference AudioMixer::constructor;
+
+namespace {
+
+bool IsSupportedFormat(int format) {
+  return format == AV_SAMPLE_FMT_FLT || format == AV_SAMPLE_FMT_FLTP ||
+         format == AV_SAMPLE_FMT_S16 || format == AV_SAMPLE_FMT_S16P;
+}
+
+// Plain loop over restrict pointers, vectorized by the compiler
+void AddScaled(float* __restrict dst, const float* __restrict src, size_t count, float gain) {
+  for (size_t i = 0; i < count; i++) {
+    dst[i] += src[i] * gain;
+  }
+}
+
+// Transparent up to the knee, then a tanh curve approaching full scale
+inline float SoftClip(float x) {
+  float a = std::fabs(x);
+  if (a <= SOFT_CLIP_KNEE) {
+    return x;
+  }
+  float y = SOFT_CLIP_KNEE + (1.0f - SOFT_CLIP_KNEE) * std::tanh((a - SOFT_CLIP_KNEE) / (1.0f - SOFT_CLIP_KNEE));
+  return std::copysign(y, x);
+}
+
+inline int16_t ToS16(float x) {
+  return static_cast<int16_t>(std::lrintf(std::clamp(x, -1.0f, 1.0f) * 32767.0f));
+}
+
+// Convert count samples of one channel, starting at sample start, to float
+void ToFloat(float* dst, const AVFrame* frame, int channel, int channels, size_t start, size_t count) {
+  switch (frame->format) {
+    case AV_SAMPLE_FMT_FLTP:
+      memcpy(dst, reinterpret_cast<const float*>(frame->extended_data[channel]) + start, count * sizeof(float));
+      break;
+    case AV_SAMPLE_FMT_FLT: {
+      const float* src = reinterpret_cast<const float*>(frame->extended_data[0]) + start * channels + channel;
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = src[i * channels];
+      }
+      break;
+    }
+    case AV_SAMPLE_FMT_S16P: {
+      const int16_t* src = reinterpret_cast<const int16_t*>(frame->extended_data[channel]) + start;
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = src[i] * (1.0f / 32768.0f);
+      }
+      break;
+    }
+    case AV_SAMPLE_FMT_S16: {
+      const int16_t* src = reinterpret_cast<const int16_t*>(frame->extended_data[0]) + start * channels + channel;
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = src[i * channels] * (1.0f / 32768.0f);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+} // namespace
+
+class AMReceiveWorker : public Napi::AsyncWorker {
+public:
+  AMReceiveWorker(Napi::Env env, Napi::Object mixerObj, AudioMixer* mixer, Napi::Object frameObj, Frame* frame,
+                  Napi::Promise::Deferred deferred)
+    : AsyncWorker(env),
+      mixer_(mixer),
+      frame_(frame),
+      deferred_(deferred) {
+    mixer_ref_.Reset(mixerObj, 1);
+    frame_ref_.Reset(frameObj, 1);
+  }
+
+  ~AMReceiveWorker() {
+    mixer_ref_.Reset();
+    frame_ref_.Reset();
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("AMReceiveWorker", "worker", mixer_);
+    ret_ = mixer_->WaitAndMix(frame_->Get());
+  }
+
+  void OnOK() override {
+    mixer_->receive_pending_ = false;
+    frame_->TrackMemory();
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& error) override {
+    mixer_->receive_pending_ = false;
+    deferred_.Reject(error.Value());
+  }
+
+private:
+  Napi::ObjectReference mixer_ref_;
+  Napi::ObjectReference frame_ref_;
+  AudioMixer* mixer_;
+  Frame* frame_;
+  int ret_ = 0;
+  Napi::Promise::Deferred deferred_;
+};
+
+Napi::Object AudioMixer::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "AudioMixer", {
+    StaticMethod<&AudioMixer::Create>("create"),
+
+    InstanceMethod<&AudioMixer::AddInput>("addInput"),
+    InstanceMethod<&AudioMixer::RemoveInput>("removeInput"),
+    InstanceMethod<&AudioMixer::Write>("write"),
+    InstanceMethod<&AudioMixer::SetGain>("setGain"),
+    InstanceMethod<&AudioMixer::SetMuted>("setMuted"),
+    InstanceMethod<&AudioMixer::Receive>("receive"),
+    InstanceMethod<&AudioMixer::ReceiveAsync>("receiveAsync"),
+    InstanceMethod<&AudioMixer::Close>("close"),
+    InstanceMethod<&AudioMixer::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &AudioMixer::Dispose),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("AudioMixer", func);
+  return exports;
+}
+
+AudioMixer::AudioMixer(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<AudioMixer>(info) {
+  // Created via AudioMixer.create()
+}
+
+AudioMixer::~AudioMixer() {
+  av_channel_layout_uninit(&ch_layout_);
+}
+
+Napi::Value AudioMixer::Create(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int sample_rate = DEFAULT_SAMPLE_RATE;
+  int frame_size = DEFAULT_FRAME_SIZE;
+  int format = AV_SAMPLE_FMT_FLTP;
+  double max_wait_ms = DEFAULT_MAX_WAIT_MS;
+  double max_buffered_ms = DEFAULT_MAX_BUFFERED_MS;
+  bool wait_policy = false;
+  bool soft_clip = true;
+  AVChannelLayout ch_layout = {};
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+    Napi::Value v = options.Get("sampleRate");
+    if (v.IsNumber()) {
+      sample_rate = v.As<Napi::Number>().Int32Value();
+    }
+    v = options.Get("frameSize");
+    if (v.IsNumber()) {
+      frame_size = v.As<Napi::Number>().Int32Value();
+    }
+    v = options.Get("sampleFormat");
+    if (v.IsNumber()) {
+      format = v.As<Napi::Number>().Int32Value();
+    }
+    v = options.Get("latePolicy");
+    if (v.IsString()) {
+      std::string policy = v.As<Napi::String>().Utf8Value();
+      if (policy != "zero" && policy != "wait") {
+        Napi::TypeError::New(env, "latePolicy must be 'zero' or 'wait'").ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      wait_policy = policy == "wait";
+    }
+    v = options.Get("maxWait");
+    if (v.IsNumber()) {
+      max_wait_ms = std::max(0.0, v.As<Napi::Number>().DoubleValue());
+    }
+    v = options.Get("maxBuffered");
+    if (v.IsNumber()) {
+      max_buffered_ms = std::max(0.0, v.As<Napi::Number>().DoubleValue());
+    }
+    v = options.Get("softClip");
+    if (v.IsBoolean()) {
+      soft_clip = v.As<Napi::Boolean>().Value();
+    }
+    v = options.Get("channelLayout");
+    if (v.IsObject()) {
+      Napi::Object layout = v.As<Napi::Object>();
+      if (layout.Has("order")) {
+        ch_layout.order = static_cast<AVChannelOrder>(layout.Get("order").As<Napi::Number>().Int32Value());
+      }
+      if (layout.Has("nbChannels")) {
+        ch_layout.nb_channels = layout.Get("nbChannels").As<Napi::Number>().Int32Value();
+      }
+      if (layout.Has("mask")) {
+        bool lossless;
+        ch_layout.u.mask = layout.Get("mask").As<Napi::BigInt>().Uint64Value(&lossless);
+      }
+    }
+  }
+
+  if (ch_layout.nb_channels == 0) {
+    av_channel_layout_default(&ch_layout, 2);
+  }
+  if (!av_channel_layout_check(&ch_layout)) {
+    Napi::TypeError::New(env, "Invalid channel layout").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (sample_rate <= 0 || frame_size <= 0) {
+    Napi::RangeError::New(env, "sampleRate and frameSize must be positive").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!IsSupportedFormat(format)) {
+    Napi::TypeError::New(env, "sampleFormat must be FLT, FLTP, S16 or S16P").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Object obj = constructor.New({});
+  AudioMixer* mixer = Napi::ObjectWrap<AudioMixer>::Unwrap(obj);
+  mixer->sample_rate_ = sample_rate;
+  mixer->channels_ = ch_layout.nb_channels;
+  mixer->frame_size_ = frame_size;
+  mixer->ch_layout_ = ch_layout;
+  mixer->format_ = static_cast<AVSampleFormat>(format);
+  mixer->grace_us_ = wait_policy ? static_cast<int64_t>(max_wait_ms * 1000) : 0;
+  mixer->soft_clip_ = soft_clip;
+
+  // At least two frames, so a full frame can be buffered while one is mixed
+  size_t buffered = static_cast<size_t>(max_buffered_ms * sample_rate / 1000);
+  mixer->capacity_ = std::max(buffered, static_cast<size_t>(frame_size) * 2);
+  mixer->mix_.resize(static_cast<size_t>(mixer->channels_) * frame_size);
+
+  return obj;
+}
+
+AudioMixer::Input* AudioMixer::GetInput(const Napi::CallbackInfo& info) {
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(info.Env(), "Expected an input index").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+  int64_t index = info[0].As<Napi::Number>().Int64Value();
+  if (index < 0 || index >= static_cast<int64_t>(inputs_.size()) || !inputs_[index].used) {
+    Napi::RangeError::New(info.Env(), "Unknown input index").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+  return &inputs_[index];
+}
+
+Napi::Value AudioMixer::AddInput(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    Napi::Error::New(env, "AudioMixer is closed").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Reuse the slot of a removed input
+  size_t index = 0;
+  while (index < inputs_.size() && inputs_[index].used) {
+    index++;
+  }
+  if (index == inputs_.size()) {
+    inputs_.emplace_back();
+  }
+
+  Input& input = inputs_[index];
+  input = Input();
+  input.used = true;
+  input.ring.resize(static_cast<size_t>(channels_) * capacity_);
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+    Napi::Value v = options.Get("gain");
+    if (v.IsNumber()) {
+      input.gain = v.As<Napi::Number>().FloatValue();
+    }
+    v = options.Get("muted");
+    if (v.IsBoolean()) {
+      input.muted = v.As<Napi::Boolean>().Value();
+    }
+  }
+
+  return Napi::Number::New(env, static_cast<double>(index));
+}
+
+Napi::Value AudioMixer::RemoveInput(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Input* input = GetInput(info);
+  if (!input) {
+    return env.Undefined();
+  }
+
+  *input = Input();
+  // The removed input may have been the one a waiting receive was held by
+  cv_.notify_all();
+  return env.Undefined();
+}
+
+Napi::Value AudioMixer::Write(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Input* input = GetInput(info);
+  if (!input) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  if (closed_ || input->ended) {
+    return Napi::Number::New(env, AVERROR_EOF);
+  }
+
+  // null ends the input; its remaining samples are still mixed
+  if (info.Length() < 2 || info[1].IsNull() || info[1].IsUndefined()) {
+    input->ended = true;
+    cv_.notify_all();
+    return Napi::Number::New(env, 0);
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[1], "Frame");
+  const AVFrame* f = frame ? frame->Get() : nullptr;
+  if (!f || !f->extended_data) {
+    Napi::TypeError::New(env, "Expected an audio Frame").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  if (f->sample_rate != sample_rate_ || f->ch_layout.nb_channels != channels_ || !IsSupportedFormat(f->format)) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  size_t count = static_cast<size_t>(std::max(f->nb_samples, 0));
+  size_t offset = 0;
+
+  // A pts gap means the samples the zero-fill stood in for never arrive
+  // (packet loss, DTX), so they are not owed anymore
+  int64_t start = AV_NOPTS_VALUE;
+  if (f->pts != AV_NOPTS_VALUE && f->time_base.num > 0 && f->time_base.den > 0) {
+    start = av_rescale_q(f->pts, f->time_base, AVRational{1, sample_rate_});
+  }
+  if (start != AV_NOPTS_VALUE && input->next_pts != AV_NOPTS_VALUE && start > input->next_pts) {
+    input->debt -= std::min(input->debt, static_cast<size_t>(start - input->next_pts));
+  }
+  input->next_pts = start != AV_NOPTS_VALUE ? start + static_cast<int64_t>(count) : AV_NOPTS_VALUE;
+
+  // Samples standing in for the zero-filled part of earlier output frames
+  if (input->debt > 0) {
+    size_t drop = std::min(input->debt, count);
+    input->debt -= drop;
+    input->late_dropped += drop;
+    offset += drop;
+    count -= drop;
+  }
+
+  // Overflow drops the oldest samples, buffered ones first
+  if (count > capacity_) {
+    input->overrun_dropped += count - capacity_;
+    offset += count - capacity_;
+    count = capacity_;
+  }
+  if (input->size + count > capacity_) {
+    size_t drop = input->size + count - capacity_;
+    input->read = (input->read + drop) % capacity_;
+    input->size -= drop;
+    input->overrun_dropped += drop;
+  }
+
+  if (count > 0) {
+    WriteSamples(*input, f, static_cast<int>(offset), count);
+    input->started = true;
+
+    if (!clock_started_) {
+      clock_started_ = true;
+      origin_us_ = av_gettime_relative();
+    }
+    cv_.notify_all();
+  }
+
+  return Napi::Number::New(env, 0);
+}
+
+void AudioMixer::WriteSamples(Input& input, const AVFrame* frame, int offset, size_t count) {
+  size_t pos = (input.read + input.size) % capacity_;
+  size_t first = std::min(count, capacity_ - pos);
+
+  for (int c = 0; c < channels_; c++) {
+    float* ring = &input.ring[static_cast<size_t>(c) * capacity_];
+    ToFloat(ring + pos, frame, c, channels_, offset, first);
+    if (count > first) {
+      ToFloat(ring, frame, c, channels_, offset + first, count - first);
+    }
+  }
+
+  input.size += count;
+}
+
+int AudioMixer::TryMix(AVFrame* frame, int64_t now, int64_t* wait_until) {
+  *wait_until = INT64_MAX;
+  if (closed_) {
+    return AVERROR_EOF;
+  }
+
+  bool any = false;
+  bool all_ended = true;
+  size_t pending = 0;               // Running inputs without a full frame
+  size_t full = 0;                  // Inputs with a full frame
+  size_t max_left = 0;
+  const size_t frame_size = static_cast<size_t>(frame_size_);
+
+  for (const Input& input : inputs_) {
+    if (!input.used) continue;
+    any = true;
+    all_ended = all_ended && input.ended;
+    max_left = std::max(max_left, input.size);
+    if (input.size >= frame_size) {
+      full++;
+    } else if (input.started && !input.ended) {
+      pending++;
+    }
+  }
+
+  if (!any) {
+    return AVERROR(EAGAIN);
+  }
+
+  // Drain ended inputs without waiting for the clock
+  if (all_ended) {
+    if (max_left == 0) {
+      return AVERROR_EOF;
+    }
+    return MixInto(frame, static_cast<int>(std::min(max_left, frame_size)));
+  }
+
+  if (!clock_started_) {
+    return AVERROR(EAGAIN);
+  }
+
+  if (pending == 0 && full > 0) {
+    return MixInto(frame, frame_size_);
+  }
+
+  // Late inputs get the grace on top of the due time, silence does not
+  int64_t due = origin_us_ + av_rescale(samples_out_ + frame_size_, 1000000, sample_rate_);
+  if (pending > 0) {
+    due += grace_us_;
+  }
+  if (now >= due) {
+    return MixInto(frame, frame_size_);
+  }
+
+  *wait_until = due;
+  return AVERROR(EAGAIN);
+}
+
+int AudioMixer::MixInto(AVFrame* frame, int nb_samples) {
+  const size_t nb = static_cast<size_t>(nb_samples);
+  std::fill(mix_.begin(), mix_.end(), 0.0f);
+  bool late = false;
+
+  for (Input& input : inputs_) {
+    if (!input.used) continue;
+
+    size_t take = std::min(input.size, nb);
+    if (take > 0 && !input.muted && input.gain != 0.0f) {
+      size_t first = std::min(take, capacity_ - input.read);
+      for (int c = 0; c < channels_; c++) {
+        float* dst = &mix_[static_cast<size_t>(c) * frame_size_];
+        const float* ring = &input.ring[static_cast<size_t>(c) * capacity_];
+        AddScaled(dst, ring + input.read, first, input.gain);
+        if (take > first) {
+          AddScaled(dst + first, ring, take - first, input.gain);
+        }
+      }
+    }
+    input.read = (input.read + take) % capacity_;
+    input.size -= take;
+
+    // Zero-filled: skip as many samples when they arrive, at most a full
+    // ring (longer stalls resume with live samples)
+    if (input.started && !input.ended && take < nb) {
+      input.debt = std::min(input.debt + (nb - take), capacity_);
+      input.late_frames++;
+      late = true;
+    }
+  }
+
+  av_frame_unref(frame);
+  frame->format = format_;
+  frame->sample_rate = sample_rate_;
+  frame->nb_samples = nb_samples;
+  int ret = av_channel_layout_copy(&frame->ch_layout, &ch_layout_);
+  if (ret < 0) {
+    return ret;
+  }
+  ret = av_frame_get_buffer(frame, 0);
+  if (ret < 0) {
+    return ret;
+  }
+
+  for (int c = 0; c < channels_; c++) {
+    const float* src = &mix_[static_cast<size_t>(c) * frame_size_];
+    switch (format_) {
+      case AV_SAMPLE_FMT_FLTP: {
+        float* dst = reinterpret_cast<float*>(frame->extended_data[c]);
+        for (size_t i = 0; i < nb; i++) {
+          dst[i] = soft_clip_ ? SoftClip(src[i]) : src[i];
+        }
+        break;
+      }
+      case AV_SAMPLE_FMT_FLT: {
+        float* dst = reinterpret_cast<float*>(frame->extended_data[0]) + c;
+        for (size_t i = 0; i < nb; i++) {
+          dst[i * channels_] = soft_clip_ ? SoftClip(src[i]) : src[i];
+        }
+        break;
+      }
+      case AV_SAMPLE_FMT_S16P: {
+        int16_t* dst = reinterpret_cast<int16_t*>(frame->extended_data[c]);
+        for (size_t i = 0; i < nb; i++) {
+          dst[i] = ToS16(soft_clip_ ? SoftClip(src[i]) : src[i]);
+        }
+        break;
+      }
+      case AV_SAMPLE_FMT_S16: {
+        int16_t* dst = reinterpret_cast<int16_t*>(frame->extended_data[0]) + c;
+        for (size_t i = 0; i < nb; i++) {
+          dst[i * channels_] = ToS16(soft_clip_ ? SoftClip(src[i]) : src[i]);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  frame->pts = samples_out_;
+  frame->duration = nb_samples;
+  frame->time_base = {1, sample_rate_};
+
+  samples_out_ += nb_samples;
+  frames_out_++;
+  if (late) {
+    late_frames_out_++;
+  }
+  return 0;
+}
+
+int AudioMixer::WaitAndMix(AVFrame* frame) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    int64_t now = av_gettime_relative();
+    int64_t wait_until;
+    int ret = TryMix(frame, now, &wait_until);
+    if (ret != AVERROR(EAGAIN)) {
+      return ret;
+    }
+
+    if (wait_until == INT64_MAX) {
+      cv_.wait(lock);
+    } else {
+      cv_.wait_for(lock, std::chrono::microseconds(wait_until - now));
+    }
+  }
+}
+
+Napi::Value AudioMixer::SetGain(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Input* input = GetInput(info);
+  if (!input) {
+    return env.Undefined();
+  }
+  if (info.Length() < 2 || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Expected a gain").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  input->gain = info[1].As<Napi::Number>().FloatValue();
+  return env.Undefined();
+}
+
+Napi::Value AudioMixer::SetMuted(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Input* input = GetInput(info);
+  if (!input) {
+    return env.Undefined();
+  }
+
+  input->muted = info.Length() > 1 && info[1].ToBoolean().Value();
+  return env.Undefined();
+}
+
+Napi::Value AudioMixer::Receive(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Expected an allocated Frame").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (receive_pending_) {
+    Napi::Error::New(env, "A receiveAsync() call is pending").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  int ret;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t wait_until;
+    ret = TryMix(frame->Get(), av_gettime_relative(), &wait_until);
+  }
+  frame->TrackMemory();
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value AudioMixer::ReceiveAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Expected an allocated Frame").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (receive_pending_) {
+    Napi::Error::New(env, "A receiveAsync() call is pending").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto deferred = Napi::Promise::Deferred::New(env);
+
+  // Fast path: a frame is ready (or all inputs have ended)
+  int ret;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t wait_until;
+    ret = TryMix(frame->Get(), av_gettime_relative(), &wait_until);
+  }
+  if (ret != AVERROR(EAGAIN)) {
+    frame->TrackMemory();
+    deferred.Resolve(Napi::Number::New(env, ret));
+    return deferred.Promise();
+  }
+
+  receive_pending_ = true;
+  auto* worker = new AMReceiveWorker(env, info.This().As<Napi::Object>(), this, info[0].As<Napi::Object>(), frame,
+                                     deferred);
+  worker->Queue();
+  return deferred.Promise();
+}
+
+Napi::Value AudioMixer::Close(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  closed_ = true;
+  inputs_.clear();
+  cv_.notify_all();
+  return info.Env().Undefined();
+}
+
+Napi::Value AudioMixer::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Napi::Array inputs = Napi::Array::New(env);
+  uint32_t n = 0;
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    const Input& input = inputs_[i];
+    if (!input.used) continue;
+
+    Napi::Object stats = Napi::Object::New(env);
+    stats.Set("index", Napi::Number::New(env, static_cast<double>(i)));
+    stats.Set("buffered", Napi::Number::New(env, static_cast<double>(input.size)));
+    stats.Set("gain", Napi::Number::New(env, input.gain));
+    stats.Set("muted", Napi::Boolean::New(env, input.muted));
+    stats.Set("ended", Napi::Boolean::New(env, input.ended));
+    stats.Set("lateFrames", Napi::Number::New(env, static_cast<double>(input.late_frames)));
+    stats.Set("lateDropped", Napi::Number::New(env, static_cast<double>(input.late_dropped)));
+    stats.Set("overrunDropped", Napi::Number::New(env, static_cast<double>(input.overrun_dropped)));
+    inputs.Set(n++, stats);
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("frames", Napi::Number::New(env, static_cast<double>(frames_out_)));
+  result.Set("lateFrames", Napi::Number::New(env, static_cast<double>(late_frames_out_)));
+  result.Set("inputs", inputs);
+  return result;
+}
+
+Napi::Value AudioMixer::Dispose(const Napi::CallbackInfo& info) {
+  return Close(info);
+}
+
+} // namespace ffmpeg
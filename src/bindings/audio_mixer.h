@@ -0,0 +1,116 @@
+#ifndef FFMPEG_AUDIO_MIXER_H
+#define FFMPEG_AUDIO_MIXER_H
+
+#include <napi.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "common.h"
+
+extern "C" {
+#include <libavutil/channel_layout.h>
+#include <libavutil/frame.h>
+#include <libavutil/samplefmt.h>
+}
+
+namespace ffmpeg {
+
+// Clock driven mixer for live audio inputs.
+//
+// Every input has a float ring buffer in the output format (sample rate and
+// channel count must match, sample formats are converted on write). Output
+// frames of a fixed size are mixed as soon as every started input has a full
+// frame buffered, and at the latest when the frame is due on the mixer clock
+// (anchored at the first write) plus the late input grace: 0 for the
+// zero-fill policy, maxWait for the wait policy. A late input contributes what
+// it has followed by silence, and as many of its next samples are dropped so
+// it stays aligned with the others. Frames with pts reduce that count by the
+// gap to the previous frame of the input: samples that were never sent are
+// not dropped again from the ones that follow.
+//
+// Inputs are summed with their gain and soft clipped when converting to the
+// output sample format.
+class AudioMixer : public Napi::ObjectWrap<AudioMixer> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  AudioMixer(const Napi::CallbackInfo& info);
+  ~AudioMixer();
+
+private:
+  friend class AMReceiveWorker;
+
+  struct Input {
+    bool used = false;              // Slot belongs to an added input
+    bool started = false;           // Has received samples
+    bool ended = false;             // write(null) was called
+    bool muted = false;
+    float gain = 1.0f;
+
+    std::vector<float> ring;        // Planar, capacity_ samples per channel
+    size_t read = 0;                // Read position in the ring
+    size_t size = 0;                // Buffered samples per channel
+    size_t debt = 0;                // Samples to drop after a zero-filled frame
+    int64_t next_pts = AV_NOPTS_VALUE; // Expected start of the next write (1/sample_rate)
+
+    uint64_t late_frames = 0;       // Output frames this input was zero-filled in
+    uint64_t late_dropped = 0;      // Samples dropped to catch up after being late
+    uint64_t overrun_dropped = 0;   // Oldest samples dropped on ring overflow
+  };
+
+  static Napi::FunctionReference constructor;
+
+  // Static methods
+  static Napi::Value Create(const Napi::CallbackInfo& info);
+
+  // Instance methods
+  Napi::Value AddInput(const Napi::CallbackInfo& info);
+  Napi::Value RemoveInput(const Napi::CallbackInfo& info);
+  Napi::Value Write(const Napi::CallbackInfo& info);
+  Napi::Value SetGain(const Napi::CallbackInfo& info);
+  Napi::Value SetMuted(const Napi::CallbackInfo& info);
+  Napi::Value Receive(const Napi::CallbackInfo& info);
+  Napi::Value ReceiveAsync(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  // With mutex_ held. Returns 0 when a frame was mixed, AVERROR(EAGAIN) with
+  // the wakeup time in *wait_until (INT64_MAX: until the next write) or
+  // AVERROR_EOF when all inputs have ended and drained.
+  int TryMix(AVFrame* frame, int64_t now, int64_t* wait_until);
+  int MixInto(AVFrame* frame, int nb_samples);
+  void WriteSamples(Input& input, const AVFrame* frame, int offset, size_t count);
+
+  // Worker thread, waits for the next frame
+  int WaitAndMix(AVFrame* frame);
+
+  Input* GetInput(const Napi::CallbackInfo& info);
+
+  int sample_rate_ = 48000;
+  int channels_ = 2;
+  int frame_size_ = 1024;
+  AVChannelLayout ch_layout_ = {};
+  AVSampleFormat format_ = AV_SAMPLE_FMT_FLTP;
+  int64_t grace_us_ = 0;            // Late input grace past the due time
+  size_t capacity_ = 0;             // Ring capacity in samples per channel
+  bool soft_clip_ = true;
+
+  std::vector<Input> inputs_;
+  std::vector<float> mix_;          // Planar, frame_size_ samples per channel
+
+  bool clock_started_ = false;
+  int64_t origin_us_ = 0;           // Wall clock of the first write
+  int64_t samples_out_ = 0;         // Output position, pts of the next frame
+  uint64_t frames_out_ = 0;
+  uint64_t late_frames_out_ = 0;    // Output frames with at least one late input
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool closed_ = false;
+  bool receive_pending_ = false;    // JS thread only
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_AUDIO_MIXER_H
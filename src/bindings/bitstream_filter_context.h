@@ -29,6 +29,9 @@ private:
   AVBSFContext* context_ = nullptr;
   bool is_initialized_ = false;
 
+  // Size of the last packet sent, cost estimate for an inline receive
+  size_t pending_bytes_ = 0;
+
   Napi::Value Alloc(const Napi::CallbackInfo& info);
   Napi::Value Init(const Napi::CallbackInfo& info);
   Napi::Value Free(const Napi::CallbackInfo& info);
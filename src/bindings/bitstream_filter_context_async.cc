@@ -1,6 +1,9 @@
 #include "bitstream_filter_context.h"
 #include "packet.h"
 #include "common.h"
+#include "tracing.h"
+#include "inline_dispatch.h"
+#include <cstring>
 #include <napi.h>
 
 extern "C" {
@@ -9,6 +12,28 @@ extern "C" {
 
 namespace ffmpeg {
 
+namespace {
+
+// Filters that at most copy the packet (header rewrites, start codes,
+// extradata and timestamp edits), so their cost is the packet size
+bool IsLightFilter(const AVBitStreamFilter* filter) {
+  static const char* const names[] = {
+    "null", "chomp", "setts", "aac_adtstoasc", "h264_mp4toannexb", "hevc_mp4toannexb",
+    "extract_extradata", "dump_extra", "remove_extra",
+  };
+  if (!filter) {
+    return false;
+  }
+  for (const char* name : names) {
+    if (strcmp(filter->name, name) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
 class BSFSendPacketWorker : public Napi::AsyncWorker {
 public:
   BSFSendPacketWorker(Napi::Env env, Napi::Object ctxObj, BitStreamFilterContext* context,
@@ -31,6 +56,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("BSFSendPacketWorker", "worker", context_);
+
     // Null checks to prevent use-after-free crashes
     if (!context_ || !context_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -41,6 +68,10 @@ public:
   }
 
   void OnOK() override {
+    // The filter took the packet's data
+    if (!packet_ref_.IsEmpty()) {
+      Napi::ObjectWrap<Packet>::Unwrap(packet_ref_.Value())->TrackMemory();
+    }
     deferred_.Resolve(Napi::Number::New(Env(), ret_));
   }
 
@@ -81,6 +112,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("BSFReceivePacketWorker", "worker", context_);
+
     // Null checks to prevent use-after-free crashes
     if (!context_ || !context_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -96,6 +129,7 @@ public:
   }
 
   void OnOK() override {
+    Napi::ObjectWrap<Packet>::Unwrap(packet_ref_.Value())->TrackMemory();
     deferred_.Resolve(Napi::Number::New(Env(), ret_));
   }
 
@@ -151,11 +185,16 @@ Napi::Value BitStreamFilterContext::SendPacketAsync(const Napi::CallbackInfo& in
     packet = pkt->Get();
   }
 
+  pending_bytes_ = packet ? static_cast<size_t>(packet->size) : 0;
+
+  // Sending moves the packet reference into the filter; only packets
+  // without a reference are copied
+  size_t cost = packet && !packet->buf ? static_cast<size_t>(packet->size) : 0;
+
   Napi::Object thisObj = info.This().As<Napi::Object>();
   Napi::Value packetVal = (info.Length() > 0) ? info[0] : env.Undefined();
   auto* worker = new BSFSendPacketWorker(env, thisObj, this, packetVal, packet);
-  auto promise = worker->GetPromise();
-  worker->Queue();
+  auto promise = InlineDispatch::Dispatch(InlineDispatch::kBitStreamFilter, cost, worker);
   
   return promise;
 }
@@ -196,9 +235,9 @@ Napi::Value BitStreamFilterContext::ReceivePacketAsync(const Napi::CallbackInfo&
 
   Napi::Object thisObj = info.This().As<Napi::Object>();
   Napi::Object packetObj = info[0].As<Napi::Object>();
+  size_t cost = IsLightFilter(context_->filter) ? pending_bytes_ : InlineDispatch::kUnknownCost;
   auto* worker = new BSFReceivePacketWorker(env, thisObj, this, packetObj, packet->Get());
-  auto promise = worker->GetPromise();
-  worker->Queue();
+  auto promise = InlineDispatch::Dispatch(InlineDispatch::kBitStreamFilter, cost, worker);
   
   return promise;
 }
@@ -25,6 +25,7 @@ Napi::Value BitStreamFilterContext::SendPacketSync(const Napi::CallbackInfo& inf
   }
 
   AVPacket* packet = nullptr;
+  Packet* wrapper = nullptr;
 
   // Check if packet is provided (null packet means EOF)
   if (info.Length() > 0 && !info[0].IsNull() && !info[0].IsUndefined()) {
@@ -42,10 +43,17 @@ Napi::Value BitStreamFilterContext::SendPacketSync(const Napi::CallbackInfo& inf
     }
 
     packet = pkt->Get();
+    wrapper = pkt;
   }
 
+  pending_bytes_ = packet ? static_cast<size_t>(packet->size) : 0;
+
   // Direct synchronous call
   int ret = av_bsf_send_packet(context_, packet);
+  if (wrapper) {
+    // The filter took the packet's data
+    wrapper->TrackMemory();
+  }
 
   return Napi::Number::New(env, ret);
 }
@@ -86,6 +94,7 @@ Napi::Value BitStreamFilterContext::ReceivePacketSync(const Napi::CallbackInfo&
 
   // Direct synchronous call
   int ret = av_bsf_receive_packet(context_, packet->Get());
+  packet->TrackMemory();
 
   return Napi::Number::New(env, ret);
 }
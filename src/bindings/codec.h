@@ -22,6 +22,8 @@ public:
   static Napi::Object NewInstance(Napi::Env env, AVCodec* codec);
 
 private:
+  friend class Registry;
+
   static Napi::FunctionReference constructor;
 
   const AVCodec* codec_; // AVCodec is const, we don't own it
@@ -4,6 +4,7 @@
 #include "codec.h"
 #include "dictionary.h"
 #include "common.h"
+#include "tracing.h"
 #include <napi.h>
 
 extern "C" {
@@ -40,6 +41,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("CCOpen2Worker", "worker", ctx_);
+
     ret_ = avcodec_open2(ctx_->context_, codec_, options_ ? &options_ : nullptr);
     if (ret_ >= 0) {
       ctx_->is_open_ = true;
@@ -89,12 +92,15 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("CCSendPacketWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_ || !ctx_->context_) {
       ret_ = AVERROR(EINVAL);
       return;
     }
 
+    Tracing::Scope call("avcodec_send_packet", "ffmpeg", ctx_);
     ret_ = avcodec_send_packet(ctx_->context_, packet_ ? packet_->Get() : nullptr);
   }
 
@@ -139,6 +145,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("CCReceiveFrameWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_ || !ctx_->context_) {
       ret_ = AVERROR(EINVAL);
@@ -149,6 +157,7 @@ public:
   }
 
   void OnOK() override {
+    frame_->TrackMemory();
     deferred_.Resolve(Napi::Number::New(Env(), ret_));
   }
 
@@ -191,6 +200,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("CCSendFrameWorker", "worker", ctx_);
+
     // Basic null checks
     if (!ctx_ || !ctx_->context_) {
       ret_ = AVERROR(EINVAL);
@@ -261,6 +272,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("CCReceivePacketWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_ || !ctx_->context_) {
       ret_ = AVERROR(EINVAL);
@@ -271,6 +284,7 @@ public:
   }
 
   void OnOK() override {
+    packet_->TrackMemory();
     deferred_.Resolve(Napi::Number::New(Env(), ret_));
   }
 
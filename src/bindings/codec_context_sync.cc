@@ -4,6 +4,7 @@
 #include "codec.h"
 #include "dictionary.h"
 #include "common.h"
+#include "tracing.h"
 #include <napi.h>
 
 extern "C" {
@@ -71,6 +72,7 @@ Napi::Value CodecContext::SendPacketSync(const Napi::CallbackInfo& info) {
   }
 
   // Direct synchronous call
+  Tracing::Scope trace("avcodec_send_packet", "ffmpeg", this);
   int ret = avcodec_send_packet(context_, packet ? packet->Get() : nullptr);
 
   return Napi::Number::New(env, ret);
@@ -97,6 +99,7 @@ Napi::Value CodecContext::ReceiveFrameSync(const Napi::CallbackInfo& info) {
 
   // Direct synchronous call
   int ret = avcodec_receive_frame(context_, frame->Get());
+  frame->TrackMemory();
 
   return Napi::Number::New(env, ret);
 }
@@ -141,6 +144,7 @@ Napi::Value CodecContext::ReceivePacketSync(const Napi::CallbackInfo& info) {
 
   // Direct synchronous call
   int ret = avcodec_receive_packet(context_, packet->Get());
+  packet->TrackMemory();
 
   return Napi::Number::New(env, ret);
 }
@@ -1,4 +1,6 @@
 #include "fifo.h"
+#include "tracing.h"
+#include "inline_dispatch.h"
 #include <napi.h>
 
 extern "C" {
@@ -29,6 +31,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FifoWriteWorker", "worker", fifo_);
+
     // Null checks to prevent use-after-free crashes
     if (!fifo_) {
       result_ = AVERROR(EINVAL);
@@ -82,6 +86,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FifoReadWorker", "worker", fifo_);
+
     // Null checks to prevent use-after-free crashes
     if (!fifo_) {
       result_ = AVERROR(EINVAL);
@@ -143,6 +149,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FifoPeekWorker", "worker", fifo_);
+
     // Null checks to prevent use-after-free crashes
     if (!fifo_) {
       result_ = AVERROR(EINVAL);
@@ -197,11 +205,12 @@ Napi::Value Fifo::WriteAsync(const Napi::CallbackInfo& info) {
   Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
   size_t nb_elems = static_cast<size_t>(info[1].As<Napi::Number>().Int64Value());
 
+  size_t bytes = nb_elems * av_fifo_elem_size(fifo_);
+
   Napi::Object thisObj = info.This().As<Napi::Object>();
   Napi::Object bufObj = info[0].As<Napi::Object>();
   auto* worker = new FifoWriteWorker(env, thisObj, fifo_, bufObj, buffer.Data(), nb_elems);
-  auto promise = worker->GetPromise();
-  worker->Queue();
+  auto promise = InlineDispatch::Dispatch(InlineDispatch::kFifo, bytes, worker);
 
   return promise;
 }
@@ -227,11 +236,12 @@ Napi::Value Fifo::ReadAsync(const Napi::CallbackInfo& info) {
   Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
   size_t nb_elems = static_cast<size_t>(info[1].As<Napi::Number>().Int64Value());
 
+  size_t bytes = nb_elems * av_fifo_elem_size(fifo_);
+
   Napi::Object thisObj = info.This().As<Napi::Object>();
   Napi::Object bufObj = info[0].As<Napi::Object>();
   auto* worker = new FifoReadWorker(env, thisObj, fifo_, bufObj, buffer.Data(), nb_elems);
-  auto promise = worker->GetPromise();
-  worker->Queue();
+  auto promise = InlineDispatch::Dispatch(InlineDispatch::kFifo, bytes, worker);
 
   return promise;
 }
@@ -262,11 +272,12 @@ Napi::Value Fifo::PeekAsync(const Napi::CallbackInfo& info) {
     offset = static_cast<size_t>(info[2].As<Napi::Number>().Int64Value());
   }
 
+  size_t bytes = nb_elems * av_fifo_elem_size(fifo_);
+
   Napi::Object thisObj = info.This().As<Napi::Object>();
   Napi::Object bufObj = info[0].As<Napi::Object>();
   auto* worker = new FifoPeekWorker(env, thisObj, fifo_, bufObj, buffer.Data(), nb_elems, offset);
-  auto promise = worker->GetPromise();
-  worker->Queue();
+  auto promise = InlineDispatch::Dispatch(InlineDispatch::kFifo, bytes, worker);
 
   return promise;
 }
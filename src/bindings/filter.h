@@ -22,6 +22,7 @@ private:
   friend class FilterContext;
   friend class FilterGraph;
   friend class FilterInOut;
+  friend class Registry;
 
   static Napi::FunctionReference constructor;
 
@@ -1,6 +1,7 @@
 #include "filter_context.h"
 #include "frame.h"
 #include "common.h"
+#include "tracing.h"
 #include <napi.h>
 
 extern "C" {
@@ -35,6 +36,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCBuffersrcAddFrameWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_ || !ctx_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -86,6 +89,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCBuffersinkGetFrameWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_ || !ctx_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -101,6 +106,7 @@ public:
   }
 
   void OnOK() override {
+    frame_->TrackMemory();
     deferred_.Resolve(Napi::Number::New(Env(), ret_));
   }
 
@@ -52,6 +52,7 @@ Napi::Value FilterContext::BuffersinkGetFrameSync(const Napi::CallbackInfo& info
 
   // Direct synchronous call
   int ret = av_buffersink_get_frame(ctx, frame->Get());
+  frame->TrackMemory();
 
   return Napi::Number::New(env, ret);
 }
@@ -57,6 +57,7 @@ FilterGraph::FilterGraph(const Napi::CallbackInfo& info)
 
 FilterGraph::~FilterGraph() {
   avfilter_graph_free(&graph_);
+  account_.Release(Env());
 }
 
 Napi::Value FilterGraph::Alloc(const Napi::CallbackInfo& info) {
@@ -72,6 +73,7 @@ Napi::Value FilterGraph::Alloc(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  account_.Update(env, 0);
   return env.Undefined();
 }
 
@@ -80,6 +82,7 @@ Napi::Value FilterGraph::Free(const Napi::CallbackInfo& info) {
 
   avfilter_graph_free(&graph_);
   unowned_graph_ = nullptr;
+  account_.Release(env);
 
   return env.Undefined();
 }
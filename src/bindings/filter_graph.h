@@ -3,6 +3,7 @@
 
 #include <napi.h>
 #include "common.h"
+#include "memory_accounting.h"
 
 extern "C" {
 #include <libavfilter/avfilter.h>
@@ -47,6 +48,10 @@ private:
   AVFilterGraph* graph_ = nullptr;
   AVFilterGraph* unowned_graph_ = nullptr;
 
+  // Counts live graphs; libavfilter does not expose the memory of queued
+  // frames, which is attributed to the frames once they leave the graph
+  MemoryAccounting::Account account_{MemoryAccounting::kFilterGraph};
+
   Napi::Value Alloc(const Napi::CallbackInfo& info);
   Napi::Value Free(const Napi::CallbackInfo& info);
   Napi::Value CreateFilter(const Napi::CallbackInfo& info);
@@ -1,4 +1,5 @@
 #include "filter_graph.h"
+#include "tracing.h"
 #include <napi.h>
 
 extern "C" {
@@ -23,6 +24,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FGConfigWorker", "worker", graph_);
+
     // Null checks to prevent use-after-free crashes
     if (!graph_ || !graph_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -67,6 +70,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FGRequestOldestWorker", "worker", graph_);
+
     // Null checks to prevent use-after-free crashes
     if (!graph_ || !graph_->Get()) {
       ret_ = AVERROR(EINVAL);
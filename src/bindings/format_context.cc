@@ -6,10 +6,15 @@
 #include "input_format.h"
 #include "output_format.h"
 #include "io_context.h"
+#include "lazy_exports.h"
 #include "common.h"
 #include <napi.h>
 #include <memory>
 
+extern "C" {
+#include <libavutil/time.h>
+}
+
 namespace ffmpeg {
 
 Napi::FunctionReference FormatContext::constructor;
@@ -44,6 +49,12 @@ Napi::Object FormatContext::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod<&FormatContext::WriteTrailerSync>("writeTrailerSync"),
     InstanceMethod<&FormatContext::FlushAsync>("flush"),
     InstanceMethod<&FormatContext::FlushSync>("flushSync"),
+    InstanceMethod<&FormatContext::ReadPlayAsync>("readPlay"),
+    InstanceMethod<&FormatContext::ReadPlaySync>("readPlaySync"),
+    InstanceMethod<&FormatContext::ReadPauseAsync>("readPause"),
+    InstanceMethod<&FormatContext::ReadPauseSync>("readPauseSync"),
+    InstanceMethod<&FormatContext::SuspendInputAsync>("suspendInput"),
+    InstanceMethod<&FormatContext::SuspendInputSync>("suspendInputSync"),
     InstanceMethod<&FormatContext::NewStream>("newStream"),
     InstanceMethod<&FormatContext::DumpFormat>("dumpFormat"),
     InstanceMethod<&FormatContext::FindBestStream>("findBestStream"),
@@ -71,6 +82,8 @@ Napi::Object FormatContext::Init(Napi::Env env, Napi::Object exports) {
     InstanceAccessor<&FormatContext::GetMaxStreams, &FormatContext::SetMaxStreams>("maxStreams"),
     InstanceAccessor<&FormatContext::GetNbPrograms, nullptr>("nbPrograms"),
     InstanceAccessor<&FormatContext::GetProbeScore, nullptr>("probeScore"),
+    InstanceAccessor<&FormatContext::GetReadTimeout, &FormatContext::SetReadTimeout>("readTimeout"),
+    InstanceAccessor<&FormatContext::GetReadStalled, nullptr>("readStalled"),
   });
   
   constructor = Napi::Persistent(func);
@@ -168,6 +181,7 @@ Napi::Value FormatContext::AllocOutputContext2(const Napi::CallbackInfo& info) {
     filename = filename_str.c_str();
   }
   
+  LazyExports::EnsureDevices();
   AVFormatContext* new_ctx = nullptr;
   int ret = avformat_alloc_output_context2(&new_ctx, oformat, format_name, filename);
 
@@ -546,6 +560,85 @@ Napi::Value FormatContext::GetRTSPStreamInfo(const Napi::CallbackInfo& info) {
   return streams;
 }
 
+int FormatContext::SendRTSPPacket(int stream_index, const uint8_t* data, size_t len) {
+  // Counted like a read so closeInput() waits for in-flight sends
+  active_read_operations_.fetch_add(1);
+  struct ActiveGuard {
+    std::atomic<int>& count;
+    ~ActiveGuard() { count.fetch_sub(1); }
+  } guard{active_read_operations_};
+
+  if (interrupt_requested_.load()) {
+    return AVERROR_EXIT; // Context is closing
+  }
+
+  if (!ctx_) {
+    return AVERROR(EINVAL);
+  }
+
+  // Check if this is an RTSP input context
+  if (!ctx_->iformat || !ctx_->iformat->name ||
+      (strcmp(ctx_->iformat->name, "rtsp") != 0)) {
+    return AVERROR(ENOTSUP);
+  }
+
+  // Access RTSP private data
+  RTSPState* rt = static_cast<RTSPState*>(ctx_->priv_data);
+  if (!rt) {
+    return AVERROR(ENOTSUP);
+  }
+
+  // Find the RTSP stream by index
+  RTSPStream* rtsp_st = nullptr;
+  for (int i = 0; i < rt->nb_rtsp_streams; i++) {
+    if (rt->rtsp_streams[i] && rt->rtsp_streams[i]->stream_index == stream_index) {
+      rtsp_st = rt->rtsp_streams[i];
+      break;
+    }
+  }
+
+  if (!rtsp_st) {
+    return AVERROR(EINVAL); // Stream not found
+  }
+
+  std::lock_guard<std::mutex> lock(rtsp_send_mutex_);
+
+  // Send based on transport type
+  if (rt->lower_transport == RTSP_LOWER_TRANSPORT_TCP) {
+    // TCP: Send with interleaved header over RTSP connection
+    if (!rt->rtsp_hd) {
+      return AVERROR(ENOTSUP); // No TCP connection
+    }
+
+    // Build interleaved packet: $ + channel_id + length (2 bytes) + RTP data
+    int channel_id = rtsp_st->interleaved_min;
+    size_t total_len = 4 + len;
+    std::vector<uint8_t> interleaved_packet(total_len);
+
+    interleaved_packet[0] = '$';
+    interleaved_packet[1] = static_cast<uint8_t>(channel_id);
+    interleaved_packet[2] = static_cast<uint8_t>((len >> 8) & 0xFF);
+    interleaved_packet[3] = static_cast<uint8_t>(len & 0xFF);
+    memcpy(interleaved_packet.data() + 4, data, len);
+
+    // Write to RTSP TCP socket
+    return ffurl_write(static_cast<URLContext*>(rt->rtsp_hd), interleaved_packet.data(), total_len);
+  }
+
+  if (rt->lower_transport == RTSP_LOWER_TRANSPORT_UDP ||
+      rt->lower_transport == RTSP_LOWER_TRANSPORT_UDP_MULTICAST) {
+    // UDP: Send raw RTP packet directly over UDP socket
+    if (!rtsp_st->rtp_handle) {
+      return AVERROR(ENOTSUP); // No UDP socket
+    }
+
+    // Write raw RTP packet to UDP socket (no interleaved header)
+    return ffurl_write(static_cast<URLContext*>(rtsp_st->rtp_handle), data, len);
+  }
+
+  return AVERROR(ENOTSUP); // Unknown transport
+}
+
 Napi::Value FormatContext::GetStreams(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   
@@ -949,6 +1042,20 @@ Napi::Value FormatContext::GetProbeScore(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, ctx->probe_score);
 }
 
+Napi::Value FormatContext::GetReadTimeout(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), read_timeout_us_.load() / 1000.0);
+}
+
+void FormatContext::SetReadTimeout(const Napi::CallbackInfo& info, const Napi::Value& value) {
+  // Milliseconds, 0 disables stall detection
+  double ms = value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : 0;
+  read_timeout_us_.store(ms > 0 ? static_cast<int64_t>(ms * 1000) : 0);
+}
+
+Napi::Value FormatContext::GetReadStalled(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), read_stalled_.load());
+}
+
 void FormatContext::SetMaxStreams(const Napi::CallbackInfo& info, const Napi::Value& value) {
   Napi::Env env = info.Env();
   
@@ -986,8 +1093,29 @@ int FormatContext::InterruptCallback(void* opaque) {
 
   FormatContext* self = static_cast<FormatContext*>(opaque);
 
+  if (self->interrupt_requested_.load()) {
+    return 1;
+  }
+
+  // Interrupt a read that has not returned within the read timeout
+  int64_t deadline = self->read_deadline_us_.load();
+  if (deadline != 0 && av_gettime_relative() > deadline) {
+    self->read_stalled_.store(true);
+    return 1;
+  }
+
   // Return 1 to interrupt FFmpeg operations, 0 to continue
-  return self->interrupt_requested_.load() ? 1 : 0;
+  return 0;
+}
+
+void FormatContext::ArmReadDeadline() {
+  int64_t timeout = read_timeout_us_.load();
+  read_stalled_.store(false);
+  read_deadline_us_.store(timeout > 0 ? av_gettime_relative() + timeout : 0);
+}
+
+void FormatContext::DisarmReadDeadline() {
+  read_deadline_us_.store(0);
 }
 
 void FormatContext::RequestInterrupt() {
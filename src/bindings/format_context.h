@@ -104,6 +104,10 @@ public:
   const AVFormatContext* Get() const { return ctx_; }
   bool IsOutput() const { return is_output_; }
 
+  // Send one RTP packet on an RTSP stream (interleaved over TCP or raw over UDP).
+  // Thread-safe; shared by sendRTSPPacket() and the native talkback engine.
+  int SendRTSPPacket(int stream_index, const uint8_t* data, size_t len);
+
 private:
   friend class AVOptionWrapper;
   friend class FCOpenInputWorker;
@@ -120,7 +124,10 @@ private:
   friend class FCCloseInputWorker;
   friend class FCDisposeWorker;
   friend class FCFlushWorker;
+  friend class FCReadPlayPauseWorker;
+  friend class FCSuspendInputWorker;
   friend class FCSendRTSPPacketWorker;
+  friend class InputSynchronizer;
 
   static Napi::FunctionReference constructor;
 
@@ -155,6 +162,12 @@ private:
   Napi::Value WriteTrailerSync(const Napi::CallbackInfo& info);
   Napi::Value FlushAsync(const Napi::CallbackInfo& info);
   Napi::Value FlushSync(const Napi::CallbackInfo& info);
+  Napi::Value ReadPlayAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReadPlaySync(const Napi::CallbackInfo& info);
+  Napi::Value ReadPauseAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReadPauseSync(const Napi::CallbackInfo& info);
+  Napi::Value SuspendInputAsync(const Napi::CallbackInfo& info);
+  Napi::Value SuspendInputSync(const Napi::CallbackInfo& info);
   Napi::Value NewStream(const Napi::CallbackInfo& info);
   Napi::Value GetStreams(const Napi::CallbackInfo& info);
   Napi::Value GetNbStreams(const Napi::CallbackInfo& info);
@@ -205,6 +218,11 @@ private:
 
   Napi::Value GetProbeScore(const Napi::CallbackInfo& info);
 
+  Napi::Value GetReadTimeout(const Napi::CallbackInfo& info);
+  void SetReadTimeout(const Napi::CallbackInfo& info, const Napi::Value& value);
+
+  Napi::Value GetReadStalled(const Napi::CallbackInfo& info);
+
   void SetPb(const Napi::CallbackInfo& info, const Napi::Value& value);
 
   // Interrupt callback mechanism for cancelling blocking operations
@@ -212,8 +230,21 @@ private:
   void RequestInterrupt();
   std::atomic<bool> interrupt_requested_{false};
 
+  // Stall detection: a read, open, stream probe or PLAY/PAUSE request blocking
+  // longer than read_timeout_us_ is interrupted by the interrupt callback
+  // (closing is not limited)
+  void ArmReadDeadline();
+  void DisarmReadDeadline();
+  std::atomic<int64_t> read_timeout_us_{0};
+  std::atomic<int64_t> read_deadline_us_{0};
+  std::atomic<bool> read_stalled_{false};
+
   // Track active read operations to prevent closing while reading
+  // (RTSP backchannel sends are counted as well)
   std::atomic<int> active_read_operations_{0};
+
+  // Serializes backchannel writes so interleaved TCP frames never mix
+  std::mutex rtsp_send_mutex_;
 };
 
 } // namespace ffmpeg
@@ -4,6 +4,7 @@
 #include "output_format.h"
 #include "dictionary.h"
 #include "common.h"
+#include "tracing.h"
 #include <napi.h>
 #include <thread>
 #include <chrono>
@@ -37,6 +38,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCOpenInputWorker", "worker", parent_);
+
     // Null checks to prevent use-after-free crashes
     if (!parent_) {
       result_ = AVERROR(EINVAL);
@@ -45,6 +48,17 @@ public:
 
     // If we already have a context (e.g., for custom I/O), use it
     AVFormatContext* ctx = parent_->ctx_;
+    if (!ctx) {
+      // Allocate here so the interrupt callback covers the connection too
+      ctx = avformat_alloc_context();
+      if (!ctx) {
+        result_ = AVERROR(ENOMEM);
+        return;
+      }
+      ctx->interrupt_callback.callback = FormatContext::InterruptCallback;
+      ctx->interrupt_callback.opaque = parent_;
+      parent_->interrupt_requested_.store(false);
+    }
 
     // For custom I/O, pass NULL as URL
     const char* url = nullptr;
@@ -52,12 +66,14 @@ public:
       url = url_.c_str();
     }
 
+    parent_->ArmReadDeadline();
     result_ = avformat_open_input(&ctx, url, fmt_, options_ ? &options_ : nullptr);
+    parent_->DisarmReadDeadline();
 
+    // avformat_open_input() frees the context on failure
+    parent_->ctx_ = ctx;
     if (result_ >= 0) {
-      parent_->ctx_ = ctx;
       parent_->is_output_ = false;
-      // Successfully opened
     }
   }
 
@@ -102,13 +118,17 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCFindStreamInfoWorker", "worker", parent_);
+
     if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
     }
 
     if (parent_->ctx_) {
+      parent_->ArmReadDeadline();
       result_ = avformat_find_stream_info(parent_->ctx_, options_ ? &options_ : nullptr);
+      parent_->DisarmReadDeadline();
     } else {
       result_ = AVERROR(EINVAL);
     }
@@ -153,6 +173,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCReadFrameWorker", "worker", parent_);
+
     if (!parent_ || !packet_) {
       result_ = AVERROR(EINVAL);
       return;
@@ -176,7 +198,12 @@ public:
     parent_->active_read_operations_.fetch_add(1);
 
     // Read a frame
-    result_ = av_read_frame(parent_->ctx_, packet_->Get());
+    parent_->ArmReadDeadline();
+    {
+      Tracing::Scope call("av_read_frame", "ffmpeg", parent_);
+      result_ = av_read_frame(parent_->ctx_, packet_->Get());
+    }
+    parent_->DisarmReadDeadline();
 
     // Decrement counter to signal read operation is complete
     parent_->active_read_operations_.fetch_sub(1);
@@ -184,6 +211,7 @@ public:
 
   void OnOK() override {
     Napi::HandleScope scope(Env());
+    packet_->TrackMemory();
     deferred_.Resolve(Napi::Number::New(Env(), result_));
   }
 
@@ -221,6 +249,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCSeekFrameWorker", "worker", parent_);
+
     if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
@@ -275,6 +305,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCSeekFileWorker", "worker", parent_);
+
     if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
@@ -331,6 +363,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCWriteHeaderWorker", "worker", parent_);
+
     if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
@@ -396,6 +430,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCWriteFrameWorker", "worker", parent_);
+
     if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
@@ -449,12 +485,15 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCInterleavedWriteFrameWorker", "worker", parent_);
+
     if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
     }
 
     if (parent_->ctx_) {
+      Tracing::Scope call("av_interleaved_write_frame", "ffmpeg", parent_);
       result_ = av_interleaved_write_frame(parent_->ctx_, packet_ ? packet_->Get() : nullptr);
     } else {
       result_ = AVERROR(EINVAL);
@@ -463,6 +502,10 @@ public:
 
   void OnOK() override {
     Napi::HandleScope scope(Env());
+    // The muxer took the packet's data
+    if (packet_) {
+      packet_->TrackMemory();
+    }
     deferred_.Resolve(Napi::Number::New(Env(), result_));
   }
 
@@ -496,6 +539,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCWriteTrailerWorker", "worker", parent_);
+
     if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
@@ -541,6 +586,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCOpenOutputWorker", "worker", parent_);
+
     if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
@@ -597,6 +644,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCCloseOutputWorker", "worker", parent_);
+
     if (!parent_) {
       return;
     }
@@ -642,6 +691,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCCloseInputWorker", "worker", parent_);
+
     if (!parent_) {
       return;
     }
@@ -727,6 +778,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("FCFlushWorker", "worker", parent_);
+
     if (!parent_) {
       return;
     }
@@ -753,6 +806,124 @@ private:
   Napi::Promise::Deferred deferred_;
 };
 
+class FCReadPlayPauseWorker : public Napi::AsyncWorker {
+public:
+  FCReadPlayPauseWorker(Napi::Env env, Napi::Object parentObj, FormatContext* parent, bool play)
+    : AsyncWorker(env),
+      parent_(parent),
+      play_(play),
+      result_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    parent_ref_.Reset(parentObj, 1);
+  }
+
+  ~FCReadPlayPauseWorker() {
+    parent_ref_.Reset();
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("FCReadPlayPauseWorker", "worker", parent_);
+
+    if (!parent_ || !parent_->ctx_) {
+      result_ = AVERROR(EINVAL);
+      return;
+    }
+
+    // Counts as a read operation, so closeInput() waits for the RTSP request
+    parent_->active_read_operations_.fetch_add(1);
+
+    // Network streams only (RTSP PLAY/PAUSE), others return AVERROR(ENOSYS).
+    // The read timeout bounds the request, a dead server never answers it
+    parent_->ArmReadDeadline();
+    result_ = play_ ? av_read_play(parent_->ctx_) : av_read_pause(parent_->ctx_);
+    parent_->DisarmReadDeadline();
+
+    parent_->active_read_operations_.fetch_sub(1);
+  }
+
+  void OnOK() override {
+    Napi::HandleScope scope(Env());
+    deferred_.Resolve(Napi::Number::New(Env(), result_));
+  }
+
+  void OnError(const Napi::Error& error) override {
+    deferred_.Reject(error.Value());
+  }
+
+  Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+private:
+  Napi::ObjectReference parent_ref_;
+  FormatContext* parent_;
+  bool play_;
+  int result_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class FCSuspendInputWorker : public Napi::AsyncWorker {
+public:
+  FCSuspendInputWorker(Napi::Env env, Napi::Object parentObj, FormatContext* parent, bool pause)
+    : AsyncWorker(env),
+      parent_(parent),
+      pause_(pause),
+      result_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    parent_ref_.Reset(parentObj, 1);
+  }
+
+  ~FCSuspendInputWorker() {
+    parent_ref_.Reset();
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("FCSuspendInputWorker", "worker", parent_);
+
+    if (!parent_ || !parent_->ctx_ || parent_->is_output_) {
+      result_ = AVERROR(EINVAL);
+      return;
+    }
+
+    parent_->active_read_operations_.fetch_add(1);
+
+    AVFormatContext* ctx = parent_->ctx_;
+
+    // RTSP PAUSE stops the server sending, other formats have no pause
+    if (pause_) {
+      parent_->ArmReadDeadline();
+      result_ = av_read_pause(ctx);
+      parent_->DisarmReadDeadline();
+      if (result_ == AVERROR(ENOSYS)) {
+        result_ = 0;
+      }
+    }
+
+    // Close our own I/O, streams stay valid until closeInput()
+    if (ctx->pb && !(ctx->flags & AVFMT_FLAG_CUSTOM_IO)) {
+      avio_closep(&ctx->pb);
+    }
+
+    parent_->active_read_operations_.fetch_sub(1);
+  }
+
+  void OnOK() override {
+    Napi::HandleScope scope(Env());
+    deferred_.Resolve(Napi::Number::New(Env(), result_));
+  }
+
+  void OnError(const Napi::Error& error) override {
+    deferred_.Reject(error.Value());
+  }
+
+  Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+private:
+  Napi::ObjectReference parent_ref_;
+  FormatContext* parent_;
+  bool pause_;
+  int result_;
+  Napi::Promise::Deferred deferred_;
+};
+
 Napi::Value FormatContext::OpenInputAsync(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
@@ -1015,6 +1186,49 @@ Napi::Value FormatContext::FlushAsync(const Napi::CallbackInfo& info) {
   return worker->GetPromise();
 }
 
+Napi::Value FormatContext::ReadPlayAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!ctx_) {
+    Napi::Error::New(env, "Format context not allocated").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Object thisObj = info.This().As<Napi::Object>();
+  auto* worker = new FCReadPlayPauseWorker(env, thisObj, this, true);
+  worker->Queue();
+  return worker->GetPromise();
+}
+
+Napi::Value FormatContext::ReadPauseAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!ctx_) {
+    Napi::Error::New(env, "Format context not allocated").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Object thisObj = info.This().As<Napi::Object>();
+  auto* worker = new FCReadPlayPauseWorker(env, thisObj, this, false);
+  worker->Queue();
+  return worker->GetPromise();
+}
+
+Napi::Value FormatContext::SuspendInputAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!ctx_) {
+    Napi::Error::New(env, "Format context not allocated").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Object thisObj = info.This().As<Napi::Object>();
+  bool pause = info.Length() < 1 || !info[0].IsBoolean() || info[0].As<Napi::Boolean>().Value();
+  auto* worker = new FCSuspendInputWorker(env, thisObj, this, pause);
+  worker->Queue();
+  return worker->GetPromise();
+}
+
 class FCSendRTSPPacketWorker : public Napi::AsyncWorker {
 public:
   FCSendRTSPPacketWorker(Napi::Env env, Napi::Object parentObj, FormatContext* parent,
@@ -1034,81 +1248,14 @@ public:
   }
 
   void Execute() override {
-    if (!parent_) {
-      result_ = AVERROR(EINVAL);
-      return;
-    }
+    Tracing::Scope trace("FCSendRTSPPacketWorker", "worker", parent_);
 
-    if (!parent_->ctx_) {
+    if (!parent_) {
       result_ = AVERROR(EINVAL);
       return;
     }
 
-    // Check if this is an RTSP input context
-    if (!parent_->ctx_->iformat || !parent_->ctx_->iformat->name ||
-        (strcmp(parent_->ctx_->iformat->name, "rtsp") != 0)) {
-      result_ = AVERROR(ENOTSUP);
-      return;
-    }
-
-    // Access RTSP private data
-    RTSPState* rt = static_cast<RTSPState*>(parent_->ctx_->priv_data);
-    if (!rt) {
-      result_ = AVERROR(ENOTSUP);
-      return;
-    }
-
-    // Find the RTSP stream by index
-    RTSPStream* rtsp_st = nullptr;
-    for (int i = 0; i < rt->nb_rtsp_streams; i++) {
-      if (rt->rtsp_streams[i] && rt->rtsp_streams[i]->stream_index == stream_index_) {
-        rtsp_st = rt->rtsp_streams[i];
-        break;
-      }
-    }
-
-    if (!rtsp_st) {
-      result_ = AVERROR(EINVAL); // Stream not found
-      return;
-    }
-
-    // Send based on transport type
-    if (rt->lower_transport == RTSP_LOWER_TRANSPORT_TCP) {
-      // TCP: Send with interleaved header over RTSP connection
-      if (!rt->rtsp_hd) {
-        result_ = AVERROR(ENOTSUP); // No TCP connection
-        return;
-      }
-
-      // Build interleaved packet: $ + channel_id + length (2 bytes) + RTP data
-      int channel_id = rtsp_st->interleaved_min;
-      size_t total_len = 4 + rtp_data_.size();
-      std::vector<uint8_t> interleaved_packet(total_len);
-
-      interleaved_packet[0] = '$';
-      interleaved_packet[1] = static_cast<uint8_t>(channel_id);
-      interleaved_packet[2] = static_cast<uint8_t>((rtp_data_.size() >> 8) & 0xFF);
-      interleaved_packet[3] = static_cast<uint8_t>(rtp_data_.size() & 0xFF);
-      memcpy(interleaved_packet.data() + 4, rtp_data_.data(), rtp_data_.size());
-
-      // Write to RTSP TCP socket
-      result_ = ffurl_write(static_cast<URLContext*>(rt->rtsp_hd), interleaved_packet.data(), total_len);
-
-    } else if (rt->lower_transport == RTSP_LOWER_TRANSPORT_UDP ||
-               rt->lower_transport == RTSP_LOWER_TRANSPORT_UDP_MULTICAST) {
-      // UDP: Send raw RTP packet directly over UDP socket
-      if (!rtsp_st->rtp_handle) {
-        result_ = AVERROR(ENOTSUP); // No UDP socket
-        return;
-      }
-
-      // Write raw RTP packet to UDP socket (no interleaved header)
-      result_ = ffurl_write(static_cast<URLContext*>(rtsp_st->rtp_handle),
-                           rtp_data_.data(), rtp_data_.size());
-
-    } else {
-      result_ = AVERROR(ENOTSUP); // Unknown transport
-    }
+    result_ = parent_->SendRTSPPacket(stream_index_, rtp_data_.data(), rtp_data_.size());
   }
 
   void OnOK() override {
@@ -3,6 +3,7 @@
 #include "input_format.h"
 #include "dictionary.h"
 #include "common.h"
+#include "tracing.h"
 #include <napi.h>
 #include <thread>
 #include <chrono>
@@ -40,7 +41,14 @@ Napi::Value FormatContext::ReadFrameSync(const Napi::CallbackInfo& info) {
   active_read_operations_.fetch_add(1);
 
   // Read a frame
-  int result = av_read_frame(ctx_, packet->Get());
+  ArmReadDeadline();
+  int result;
+  {
+    Tracing::Scope trace("av_read_frame", "ffmpeg", this);
+    result = av_read_frame(ctx_, packet->Get());
+  }
+  DisarmReadDeadline();
+  packet->TrackMemory();
 
   // Decrement counter to signal read operation is complete
   active_read_operations_.fetch_sub(1);
@@ -81,7 +89,12 @@ Napi::Value FormatContext::InterleavedWriteFrameSync(const Napi::CallbackInfo& i
   }
 
   // Direct synchronous call to av_interleaved_write_frame
+  Tracing::Scope trace("av_interleaved_write_frame", "ffmpeg", this);
   int result = av_interleaved_write_frame(ctx_, packet ? packet->Get() : nullptr);
+  if (packet) {
+    // The muxer took the packet's data
+    packet->TrackMemory();
+  }
 
   return Napi::Number::New(env, result);
 }
@@ -116,13 +129,27 @@ Napi::Value FormatContext::OpenInputSync(const Napi::CallbackInfo& info) {
 
   // If we already have a context (e.g., for custom I/O), preserve it
   AVFormatContext* ctx = ctx_;
+  if (!ctx) {
+    // Allocate here so the interrupt callback covers the connection too
+    ctx = avformat_alloc_context();
+    if (!ctx) {
+      av_dict_free(&options);
+      return Napi::Number::New(env, AVERROR(ENOMEM));
+    }
+    ctx->interrupt_callback.callback = InterruptCallback;
+    ctx->interrupt_callback.opaque = this;
+    interrupt_requested_.store(false);
+  }
 
   // Direct synchronous call
   const char* urlPtr = url.empty() || url == "dummy" ? nullptr : url.c_str();
+  ArmReadDeadline();
   int ret = avformat_open_input(&ctx, urlPtr, fmt, options ? &options : nullptr);
+  DisarmReadDeadline();
 
+  // avformat_open_input() frees the context on failure
+  ctx_ = ctx;
   if (ret >= 0) {
-    ctx_ = ctx;  // Update the stored context
     is_output_ = false;
   }
 
@@ -153,7 +180,9 @@ Napi::Value FormatContext::FindStreamInfoSync(const Napi::CallbackInfo& info) {
   }
 
   // Direct synchronous call
+  ArmReadDeadline();
   int ret = avformat_find_stream_info(ctx_, options ? &options : nullptr);
+  DisarmReadDeadline();
 
   // Clean up options if any remain
   if (options) {
@@ -376,7 +405,7 @@ Napi::Value FormatContext::FlushSync(const Napi::CallbackInfo& info) {
   return env.Undefined();
 }
 
-Napi::Value FormatContext::SendRTSPPacketSync(const Napi::CallbackInfo& info) {
+Napi::Value FormatContext::ReadPlaySync(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
   if (!ctx_) {
@@ -384,89 +413,97 @@ Napi::Value FormatContext::SendRTSPPacketSync(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
-  // Parameters: streamIndex (number), rtpPacketData (Buffer)
-  if (info.Length() < 2) {
-    Napi::TypeError::New(env, "Expected 2 arguments: streamIndex and rtpPacketData").ThrowAsJavaScriptException();
-    return env.Undefined();
-  }
+  active_read_operations_.fetch_add(1);
+  ArmReadDeadline();
+  int ret = av_read_play(ctx_);
+  DisarmReadDeadline();
+  active_read_operations_.fetch_sub(1);
 
-  if (!info[0].IsNumber()) {
-    Napi::TypeError::New(env, "streamIndex must be a number").ThrowAsJavaScriptException();
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value FormatContext::ReadPauseSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!ctx_) {
+    Napi::Error::New(env, "Format context not allocated").ThrowAsJavaScriptException();
     return env.Undefined();
   }
 
-  if (!info[1].IsBuffer()) {
-    Napi::TypeError::New(env, "rtpPacketData must be a Buffer").ThrowAsJavaScriptException();
+  active_read_operations_.fetch_add(1);
+  ArmReadDeadline();
+  int ret = av_read_pause(ctx_);
+  DisarmReadDeadline();
+  active_read_operations_.fetch_sub(1);
+
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value FormatContext::SuspendInputSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!ctx_) {
+    Napi::Error::New(env, "Format context not allocated").ThrowAsJavaScriptException();
     return env.Undefined();
   }
 
-  // Check if this is an RTSP input context
-  if (!ctx_->iformat || !ctx_->iformat->name ||
-      (strcmp(ctx_->iformat->name, "rtsp") != 0)) {
-    return Napi::Number::New(env, AVERROR(ENOTSUP));
+  if (is_output_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
   }
 
-  int stream_index = info[0].As<Napi::Number>().Int32Value();
-  Napi::Buffer<uint8_t> buffer = info[1].As<Napi::Buffer<uint8_t>>();
-  uint8_t* data = buffer.Data();
-  size_t len = buffer.Length();
+  bool pause = info.Length() < 1 || !info[0].IsBoolean() || info[0].As<Napi::Boolean>().Value();
 
-  // Access RTSP private data
-  RTSPState* rt = static_cast<RTSPState*>(ctx_->priv_data);
-  if (!rt) {
-    return Napi::Number::New(env, AVERROR(ENOTSUP));
-  }
+  active_read_operations_.fetch_add(1);
 
-  // Find the RTSP stream by index
-  RTSPStream* rtsp_st = nullptr;
-  for (int i = 0; i < rt->nb_rtsp_streams; i++) {
-    if (rt->rtsp_streams[i] && rt->rtsp_streams[i]->stream_index == stream_index) {
-      rtsp_st = rt->rtsp_streams[i];
-      break;
+  // RTSP PAUSE stops the server sending, other formats have no pause
+  int ret = 0;
+  if (pause) {
+    ArmReadDeadline();
+    ret = av_read_pause(ctx_);
+    DisarmReadDeadline();
+    if (ret == AVERROR(ENOSYS)) {
+      ret = 0;
     }
   }
 
-  if (!rtsp_st) {
-    return Napi::Number::New(env, AVERROR(EINVAL)); // Stream not found
+  // Close our own I/O, streams stay valid until closeInput()
+  if (ctx_->pb && !(ctx_->flags & AVFMT_FLAG_CUSTOM_IO)) {
+    avio_closep(&ctx_->pb);
   }
 
-  int ret = 0;
+  active_read_operations_.fetch_sub(1);
 
-  // Send based on transport type
-  if (rt->lower_transport == RTSP_LOWER_TRANSPORT_TCP) {
-    // TCP: Send with interleaved header over RTSP connection
-    if (!rt->rtsp_hd) {
-      return Napi::Number::New(env, AVERROR(ENOTSUP)); // No TCP connection
-    }
+  return Napi::Number::New(env, ret);
+}
 
-    // Build interleaved packet: $ + channel_id + length (2 bytes) + RTP data
-    int channel_id = rtsp_st->interleaved_min;
-    size_t total_len = 4 + len;
-    std::vector<uint8_t> interleaved_packet(total_len);
-
-    interleaved_packet[0] = '$';
-    interleaved_packet[1] = static_cast<uint8_t>(channel_id);
-    interleaved_packet[2] = static_cast<uint8_t>((len >> 8) & 0xFF);
-    interleaved_packet[3] = static_cast<uint8_t>(len & 0xFF);
-    memcpy(interleaved_packet.data() + 4, data, len);
-
-    // Write to RTSP TCP socket
-    ret = ffurl_write(static_cast<URLContext*>(rt->rtsp_hd), interleaved_packet.data(), total_len);
-
-  } else if (rt->lower_transport == RTSP_LOWER_TRANSPORT_UDP ||
-             rt->lower_transport == RTSP_LOWER_TRANSPORT_UDP_MULTICAST) {
-    // UDP: Send raw RTP packet directly over UDP socket
-    if (!rtsp_st->rtp_handle) {
-      return Napi::Number::New(env, AVERROR(ENOTSUP)); // No UDP socket
-    }
+Napi::Value FormatContext::SendRTSPPacketSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
 
-    // Write raw RTP packet to UDP socket (no interleaved header)
-    ret = ffurl_write(static_cast<URLContext*>(rtsp_st->rtp_handle), data, len);
+  if (!ctx_) {
+    Napi::Error::New(env, "Format context not allocated").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
 
-  } else {
-    return Napi::Number::New(env, AVERROR(ENOTSUP)); // Unknown transport
+  // Parameters: streamIndex (number), rtpPacketData (Buffer)
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected 2 arguments: streamIndex and rtpPacketData").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!info[0].IsNumber()) {
+    Napi::TypeError::New(env, "streamIndex must be a number").ThrowAsJavaScriptException();
+    return env.Undefined();
   }
 
+  if (!info[1].IsBuffer()) {
+    Napi::TypeError::New(env, "rtpPacketData must be a Buffer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int stream_index = info[0].As<Napi::Number>().Int32Value();
+  Napi::Buffer<uint8_t> buffer = info[1].As<Napi::Buffer<uint8_t>>();
+
+  int ret = SendRTSPPacket(stream_index, buffer.Data(), buffer.Length());
   return Napi::Number::New(env, ret);
 }
 
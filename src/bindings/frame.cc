@@ -30,6 +30,7 @@ Napi::Object Frame::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod<&Frame::GetMetadata>("getMetadata"),
     InstanceMethod<&Frame::ApplyCropping>("applyCropping"),
     InstanceMethod<&Frame::Dispose>(Napi::Symbol::WellKnown(env, "dispose")),
+    InstanceMethod<&Frame::SetAllocationSite>("setAllocationSite"),
 
     InstanceAccessor<&Frame::GetFormat, &Frame::SetFormat>("format"),
     InstanceAccessor<&Frame::GetWidth, &Frame::SetWidth>("width"),
@@ -75,7 +76,12 @@ Frame::Frame(const Napi::CallbackInfo& info)
 }
 
 Frame::~Frame() {
+  if (leak_site_ >= 0 && frame_) {
+    // Finalized by the GC while still holding its AVFrame
+    LeakDetector::Leaked(leak_site_, MemoryAccounting::FrameBytes(frame_));
+  }
   av_frame_free(&frame_);
+  account_.Release(Env());
 }
 
 Napi::Value Frame::Alloc(const Napi::CallbackInfo& info) {
@@ -88,14 +94,18 @@ Napi::Value Frame::Alloc(const Napi::CallbackInfo& info) {
   }
 
   av_frame_free(&frame_);
+  ClearLeakSite();
 
   frame_ = frame;
+  TrackMemory();
   return env.Undefined();
 }
 
 Napi::Value Frame::Free(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   av_frame_free(&frame_);
+  ClearLeakSite();
+  account_.Release(env);
   return env.Undefined();
 }
 
@@ -118,6 +128,7 @@ Napi::Value Frame::Ref(const Napi::CallbackInfo& info) {
   }
   
   int ret = av_frame_ref(frame_, src->Get());
+  TrackMemory();
   return Napi::Number::New(env, ret);
 }
 
@@ -126,6 +137,7 @@ Napi::Value Frame::Unref(const Napi::CallbackInfo& info) {
   
   if (frame_) {
     av_frame_unref(frame_);
+    TrackMemory();
   }
   
   return env.Undefined();
@@ -147,6 +159,7 @@ Napi::Value Frame::Clone(const Napi::CallbackInfo& info) {
   Napi::Object newFrame = constructor.New({});
   Frame* wrapper = Napi::ObjectWrap<Frame>::Unwrap(newFrame);
   wrapper->frame_ = cloned;
+  wrapper->TrackMemory();
 
   return newFrame;
 }
@@ -164,6 +177,7 @@ Napi::Value Frame::GetBuffer(const Napi::CallbackInfo& info) {
   }
   
   int ret = av_frame_get_buffer(frame_, align);
+  TrackMemory();
   return Napi::Number::New(env, ret);
 }
 
@@ -180,6 +194,7 @@ Napi::Value Frame::MakeWritable(const Napi::CallbackInfo& info) {
   }
   
   int ret = av_frame_make_writable(frame_);
+  TrackMemory();
   return Napi::Number::New(env, ret);
 }
 
@@ -1019,6 +1034,7 @@ Napi::Value Frame::NewSideData(const Napi::CallbackInfo& info) {
     Napi::Error::New(env, "Failed to allocate new side data").ThrowAsJavaScriptException();
     return env.Undefined();
   }
+  TrackMemory();
   
   // Return as Buffer that references the side data (not a copy)
   // Note: The buffer lifetime is tied to the frame
@@ -1043,6 +1059,7 @@ Napi::Value Frame::RemoveSideData(const Napi::CallbackInfo& info) {
   enum AVFrameSideDataType type = static_cast<AVFrameSideDataType>(info[0].As<Napi::Number>().Int32Value());
 
   av_frame_remove_side_data(frame_, type);
+  TrackMemory();
   return env.Undefined();
 }
 
@@ -1159,4 +1176,22 @@ Napi::Value Frame::Dispose(const Napi::CallbackInfo& info) {
   return Free(info);
 }
 
-} // namespace ffmpeg
\ No newline at end of file
+Napi::Value Frame::SetAllocationSite(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Site id (number) required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!LeakDetector::Enabled() || !frame_) {
+    return env.Undefined();
+  }
+
+  ClearLeakSite();
+  leak_site_ = info[0].As<Napi::Number>().Int32Value();
+  LeakDetector::Allocated(leak_site_);
+  return env.Undefined();
+}
+
+} // namespace ffmpeg
@@ -3,6 +3,8 @@
 
 #include <napi.h>
 #include "common.h"
+#include "memory_accounting.h"
+#include "leak_detector.h"
 
 extern "C" {
 #include <libavutil/frame.h>
@@ -21,12 +23,30 @@ public:
 
   AVFrame* Get() { return frame_; }
 
+  // Re-measure for memory accounting after native code filled or released
+  // the frame (decode, filter, transfer)
+  void TrackMemory() {
+    if (account_.Active()) {
+      account_.Update(Env(), MemoryAccounting::FrameBytes(frame_));
+    }
+  }
+
 private:
   friend class HwframeTransferDataWorker;
 
   static Napi::FunctionReference constructor;
 
   AVFrame* frame_ = nullptr;
+  MemoryAccounting::Account account_{MemoryAccounting::kFrame};
+  int32_t leak_site_ = -1;  // Allocation site while leak detection is enabled
+
+  // Explicitly freed or replaced; no longer a leak candidate
+  void ClearLeakSite() {
+    if (leak_site_ >= 0) {
+      LeakDetector::Freed(leak_site_);
+      leak_site_ = -1;
+    }
+  }
 
   Napi::Value Alloc(const Napi::CallbackInfo& info);
   Napi::Value Free(const Napi::CallbackInfo& info);
@@ -49,6 +69,7 @@ private:
   Napi::Value RemoveSideData(const Napi::CallbackInfo& info);
   Napi::Value GetMetadata(const Napi::CallbackInfo& info);
   Napi::Value Dispose(const Napi::CallbackInfo& info);
+  Napi::Value SetAllocationSite(const Napi::CallbackInfo& info);
 
   Napi::Value GetFormat(const Napi::CallbackInfo& info);
   void SetFormat(const Napi::CallbackInfo& info, const Napi::Value& value);
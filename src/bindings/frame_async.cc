@@ -1,5 +1,6 @@
 #include "frame.h"
 #include "common.h"
+#include "tracing.h"
 #include <napi.h>
 
 extern "C" {
@@ -30,6 +31,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("HwframeTransferDataWorker", "worker", src_);
+
     // Null checks to prevent use-after-free crashes
     if (!src_ || !src_->Get() || !dst_ || !dst_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -40,6 +43,9 @@ public:
   }
 
   void OnOK() override {
+    if (dst_) {
+      dst_->TrackMemory();
+    }
     deferred_.Resolve(Napi::Number::New(Env(), ret_));
   }
 
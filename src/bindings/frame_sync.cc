@@ -39,6 +39,7 @@ Napi::Value Frame::HwframeTransferDataSync(const Napi::CallbackInfo& info) {
 
   // Direct synchronous call
   int ret = av_hwframe_transfer_data(dst->frame_, frame_, flags);
+  dst->TrackMemory();
 
   return Napi::Number::New(env, ret);
 }
@@ -72,6 +72,8 @@ FrameUtils::FrameUtils(const Napi::CallbackInfo& info)
     Napi::Error::New(env, "Failed to make frame writable").ThrowAsJavaScriptException();
     return;
   }
+
+  TrackMemory();
 }
 
 FrameUtils::~FrameUtils() {
@@ -83,6 +85,7 @@ FrameUtils::~FrameUtils() {
 
   CleanupFrames();
   CleanupSwsContexts();
+  account_.Release(Env());
 }
 
 Napi::Value FrameUtils::Process(const Napi::CallbackInfo& info) {
@@ -225,15 +228,29 @@ Napi::Value FrameUtils::Process(const Napi::CallbackInfo& info) {
   // Copy frame to output buffer
   CopyFrameToBuffer(outputData, current_frame);
 
+  TrackMemory();
   return outputBuffer;
 }
 
 Napi::Value FrameUtils::Close(const Napi::CallbackInfo& info) {
   CleanupFrames();
   CleanupSwsContexts();
+  TrackMemory();
   return info.Env().Undefined();
 }
 
+void FrameUtils::TrackMemory() {
+  if (!account_.Active()) {
+    return;
+  }
+
+  int64_t bytes = MemoryAccounting::FrameBytes(input_frame_);
+  for (const auto& pair : frame_pool_) {
+    bytes += MemoryAccounting::FrameBytes(pair.second);
+  }
+  account_.Update(Env(), bytes);
+}
+
 AVFrame* FrameUtils::GetOrCreateFrame(int width, int height, AVPixelFormat format) {
   FrameConfig config = {width, height, format};
 
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include "memory_accounting.h"
 
 extern "C" {
 #include <libavutil/frame.h>
@@ -81,6 +82,8 @@ private:
   // Input frame (persistent)
   AVFrame* input_frame_;
 
+  MemoryAccounting::Account account_{MemoryAccounting::kFrameUtils};
+
   // Methods
   Napi::Value Process(const Napi::CallbackInfo& info);
   Napi::Value Close(const Napi::CallbackInfo& info);
@@ -94,6 +97,9 @@ private:
   void CopyBufferToFrame(AVFrame* frame, const uint8_t* buffer, size_t buffer_size);
   size_t CopyFrameToBuffer(uint8_t* buffer, AVFrame* frame);
 
+  // Input frame and frame pool bytes for memory accounting
+  void TrackMemory();
+
   // Cleanup
   void CleanupFrames();
   void CleanupSwsContexts();
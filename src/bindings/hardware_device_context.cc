@@ -2,6 +2,7 @@
 #include "dictionary.h"
 #include "error.h"
 #include "common.h"
+#include "lazy_exports.h"
 #include <sstream>
 
 namespace ffmpeg {
@@ -13,6 +14,8 @@ Napi::Object HardwareDeviceContext::Init(Napi::Env env, Napi::Object exports) {
     StaticMethod<&HardwareDeviceContext::GetTypeName>("getTypeName"),
     StaticMethod<&HardwareDeviceContext::IterateTypes>("iterateTypes"),
     StaticMethod<&HardwareDeviceContext::FindTypeByName>("findTypeByName"),
+    StaticMethod<&HardwareDeviceContext::ProbeCapabilitiesAsync>("probeCapabilities"),
+    StaticMethod<&HardwareDeviceContext::ProbeCapabilitiesSync>("probeCapabilitiesSync"),
 
     InstanceMethod<&HardwareDeviceContext::Alloc>("alloc"),
     InstanceMethod<&HardwareDeviceContext::Init>("init"),
@@ -47,6 +50,9 @@ Napi::Value HardwareDeviceContext::Wrap(Napi::Env env, AVBufferRef* device_ref)
   if (!device_ref) {
     return env.Null();
   }
+
+  // Registered lazily; FFmpeg objects can reach JS before the class was used
+  LazyExports::Ensure(env, &HardwareDeviceContext::Init);
   
   Napi::Object obj = constructor.New({});
   HardwareDeviceContext* ctx = Napi::ObjectWrap<HardwareDeviceContext>::Unwrap(obj);
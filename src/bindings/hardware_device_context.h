@@ -49,6 +49,8 @@ private:
   static Napi::Value GetTypeName(const Napi::CallbackInfo& info);
   static Napi::Value IterateTypes(const Napi::CallbackInfo& info);
   static Napi::Value FindTypeByName(const Napi::CallbackInfo& info);
+  static Napi::Value ProbeCapabilitiesAsync(const Napi::CallbackInfo& info);
+  static Napi::Value ProbeCapabilitiesSync(const Napi::CallbackInfo& info);
   
   Napi::Value Alloc(const Napi::CallbackInfo& info);
   Napi::Value Init(const Napi::CallbackInfo& info);
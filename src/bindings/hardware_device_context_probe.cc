@@ -0,0 +1,280 @@
+#include "hardware_device_context.h"
+#include "dictionary.h"
+#include "common.h"
+#include "tracing.h"
+#include <napi.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/hwcontext.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+// Capability matrix of one device type, filled off the JS thread
+struct CodecCapability {
+  std::string name;
+  int codec_id;
+  std::vector<int> pixel_formats;
+};
+
+struct DeviceCapability {
+  AVHWDeviceType type;
+  std::string name;
+  int error = 0;
+  bool available = false;
+  std::vector<int> hw_formats;
+  std::vector<int> sw_formats;
+  int max_width = 0;
+  int max_height = 0;
+  std::vector<CodecCapability> decoders;
+  std::vector<CodecCapability> encoders;
+};
+
+bool HasSuffix(const char* name, const std::string& suffix) {
+  size_t len = strlen(name);
+  return len > suffix.size() && name[len - suffix.size() - 1] == '_' &&
+         strcmp(name + len - suffix.size(), suffix.c_str()) == 0;
+}
+
+// Codecs bound to a device type. Decoders are matched by their hw configs,
+// encoders also by the <codec>_<type> naming when they have no hw config
+// (e.g. videotoolbox).
+void CollectCodecs(DeviceCapability& device) {
+  void* opaque = nullptr;
+  const AVCodec* codec = nullptr;
+  while ((codec = av_codec_iterate(&opaque))) {
+    if (codec->type != AVMEDIA_TYPE_VIDEO) {
+      continue;
+    }
+
+    bool encoder = av_codec_is_encoder(codec);
+    CodecCapability cap = {codec->name, codec->id, {}};
+    bool matched = false;
+
+    for (int i = 0;; i++) {
+      const AVCodecHWConfig* config = avcodec_get_hw_config(codec, i);
+      if (!config) {
+        break;
+      }
+      if (config->device_type == device.type &&
+          (config->methods & (AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX | AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX))) {
+        matched = true;
+        if (!encoder) {
+          cap.pixel_formats.push_back(config->pix_fmt);
+        }
+      }
+    }
+
+    if (!matched && encoder && (codec->capabilities & AV_CODEC_CAP_HARDWARE)) {
+      matched = HasSuffix(codec->name, device.name);
+    }
+    if (!matched) {
+      continue;
+    }
+
+    if (encoder) {
+      const AVPixelFormat* formats = nullptr;
+      int count = 0;
+      if (avcodec_get_supported_config(nullptr, codec, AV_CODEC_CONFIG_PIX_FORMAT, 0,
+                                       (const void**)&formats, &count) >= 0 && formats) {
+        cap.pixel_formats.assign(formats, formats + count);
+      }
+      device.encoders.push_back(std::move(cap));
+    } else {
+      device.decoders.push_back(std::move(cap));
+    }
+  }
+}
+
+void Probe(const std::string& device, const AVDictionary* options, bool open, std::vector<DeviceCapability>& out) {
+  AVHWDeviceType type = AV_HWDEVICE_TYPE_NONE;
+  while ((type = av_hwdevice_iterate_types(type)) != AV_HWDEVICE_TYPE_NONE) {
+    DeviceCapability cap;
+    cap.type = type;
+    cap.name = av_hwdevice_get_type_name(type);
+    CollectCodecs(cap);
+
+    if (open) {
+      // Same device selection as HardwareContext.auto()
+      const char* node = device.empty() ? nullptr : device.c_str();
+      if (!node && type == AV_HWDEVICE_TYPE_VAAPI) {
+        node = "/dev/dri/renderD128";
+      }
+
+      AVDictionary* opts = nullptr;
+      av_dict_copy(&opts, options, 0);
+      AVBufferRef* ref = nullptr;
+      cap.error = av_hwdevice_ctx_create(&ref, type, node, opts, 0);
+      av_dict_free(&opts);
+
+      if (cap.error >= 0 && ref) {
+        cap.available = true;
+        AVHWFramesConstraints* constraints = av_hwdevice_get_hwframe_constraints(ref, nullptr);
+        if (constraints) {
+          for (int i = 0; constraints->valid_hw_formats && constraints->valid_hw_formats[i] != AV_PIX_FMT_NONE; i++) {
+            cap.hw_formats.push_back(constraints->valid_hw_formats[i]);
+          }
+          for (int i = 0; constraints->valid_sw_formats && constraints->valid_sw_formats[i] != AV_PIX_FMT_NONE; i++) {
+            cap.sw_formats.push_back(constraints->valid_sw_formats[i]);
+          }
+          cap.max_width = constraints->max_width;
+          cap.max_height = constraints->max_height;
+          av_hwframe_constraints_free(&constraints);
+        }
+      }
+      av_buffer_unref(&ref);
+    }
+
+    out.push_back(std::move(cap));
+  }
+}
+
+Napi::Array IntArray(Napi::Env env, const std::vector<int>& values) {
+  Napi::Array array = Napi::Array::New(env, values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    array.Set(static_cast<uint32_t>(i), Napi::Number::New(env, values[i]));
+  }
+  return array;
+}
+
+Napi::Array CodecsToJS(Napi::Env env, const std::vector<CodecCapability>& codecs) {
+  Napi::Array array = Napi::Array::New(env, codecs.size());
+  for (size_t i = 0; i < codecs.size(); i++) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("name", Napi::String::New(env, codecs[i].name));
+    obj.Set("codecId", Napi::Number::New(env, codecs[i].codec_id));
+    obj.Set("pixelFormats", IntArray(env, codecs[i].pixel_formats));
+    array.Set(static_cast<uint32_t>(i), obj);
+  }
+  return array;
+}
+
+Napi::Array ProbeToJS(Napi::Env env, const std::vector<DeviceCapability>& devices) {
+  Napi::Array array = Napi::Array::New(env, devices.size());
+  for (size_t i = 0; i < devices.size(); i++) {
+    const DeviceCapability& d = devices[i];
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("type", Napi::String::New(env, d.name));
+    obj.Set("deviceType", Napi::Number::New(env, d.type));
+    obj.Set("available", Napi::Boolean::New(env, d.available));
+    obj.Set("error", Napi::Number::New(env, d.error));
+    obj.Set("hwFormats", IntArray(env, d.hw_formats));
+    obj.Set("swFormats", IntArray(env, d.sw_formats));
+    obj.Set("maxWidth", Napi::Number::New(env, d.max_width));
+    obj.Set("maxHeight", Napi::Number::New(env, d.max_height));
+    obj.Set("decoders", CodecsToJS(env, d.decoders));
+    obj.Set("encoders", CodecsToJS(env, d.encoders));
+    array.Set(static_cast<uint32_t>(i), obj);
+  }
+  return array;
+}
+
+// Arguments: (device: string | null, options: Dictionary | null, open: boolean)
+bool ParseProbeArgs(const Napi::CallbackInfo& info, std::string& device, AVDictionary** options, bool& open) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() > 0 && !info[0].IsNull() && !info[0].IsUndefined()) {
+    if (!info[0].IsString()) {
+      Napi::TypeError::New(env, "Device must be string or null").ThrowAsJavaScriptException();
+      return false;
+    }
+    device = info[0].As<Napi::String>().Utf8Value();
+  }
+
+  if (info.Length() > 1 && !info[1].IsNull() && !info[1].IsUndefined()) {
+    Dictionary* dict = UnwrapNativeObject<Dictionary>(env, info[1], "Dictionary");
+    if (!dict) {
+      return false;
+    }
+    if (dict->Get()) {
+      av_dict_copy(options, dict->Get(), 0);
+    }
+  }
+
+  open = info.Length() < 3 || !info[2].IsBoolean() || info[2].As<Napi::Boolean>().Value();
+  return true;
+}
+
+class HWDCProbeWorker : public Napi::AsyncWorker {
+public:
+  HWDCProbeWorker(Napi::Env env, std::string device, AVDictionary* options, bool open)
+    : Napi::AsyncWorker(env),
+      device_(std::move(device)),
+      options_(options),
+      open_(open),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  ~HWDCProbeWorker() {
+    av_dict_free(&options_);
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("HWDCProbeWorker", "worker", nullptr);
+
+    Probe(device_, options_, open_, devices_);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(ProbeToJS(Env(), devices_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  std::string device_;
+  AVDictionary* options_;
+  bool open_;
+  std::vector<DeviceCapability> devices_;
+  Napi::Promise::Deferred deferred_;
+};
+
+} // namespace
+
+Napi::Value HardwareDeviceContext::ProbeCapabilitiesAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::string device;
+  AVDictionary* options = nullptr;
+  bool open = true;
+  if (!ParseProbeArgs(info, device, &options, open)) {
+    av_dict_free(&options);
+    return env.Undefined();
+  }
+
+  auto* worker = new HWDCProbeWorker(env, std::move(device), options, open);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+  return promise;
+}
+
+Napi::Value HardwareDeviceContext::ProbeCapabilitiesSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::string device;
+  AVDictionary* options = nullptr;
+  bool open = true;
+  if (!ParseProbeArgs(info, device, &options, open)) {
+    av_dict_free(&options);
+    return env.Undefined();
+  }
+
+  std::vector<DeviceCapability> devices;
+  Probe(device, options, open, devices);
+  av_dict_free(&options);
+
+  return ProbeToJS(env, devices);
+}
+
+} // namespace ffmpeg
@@ -3,6 +3,7 @@
 #include "frame.h"
 #include "error.h"
 #include "common.h"
+#include "lazy_exports.h"
 
 namespace ffmpeg {
 
@@ -49,6 +50,9 @@ Napi::Value HardwareFramesContext::Wrap(Napi::Env env, AVBufferRef* frames_ref)
   if (!frames_ref) {
     return env.Null();
   }
+
+  // Registered lazily; FFmpeg objects can reach JS before the class was used
+  LazyExports::Ensure(env, &HardwareFramesContext::Init);
   
   Napi::Object obj = constructor.New({});
   HardwareFramesContext* ctx = Napi::ObjectWrap<HardwareFramesContext>::Unwrap(obj);
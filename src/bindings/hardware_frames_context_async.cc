@@ -1,6 +1,7 @@
 #include "hardware_frames_context.h"
 #include "frame.h"
 #include "common.h"
+#include "tracing.h"
 #include <napi.h>
 
 extern "C" {
@@ -30,6 +31,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("HWFCTransferDataWorker", "worker", dst_);
+
     // Null checks to prevent use-after-free crashes
     if (!dst_ || !dst_->Get() || !src_ || !src_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -0,0 +1,541 @@
+#include "image_encoder.h"
+#include "frame.h"
+#include "tracing.h"
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include <libavutil/hwcontext.h>
+#include <libavutil/opt.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+constexpr size_t kDefaultMaxIdle = 16;
+
+// Full range counterpart of a YUV format (JPEG), or the format itself
+AVPixelFormat JpegFormat(AVPixelFormat format) {
+  switch (format) {
+    case AV_PIX_FMT_YUV420P: return AV_PIX_FMT_YUVJ420P;
+    case AV_PIX_FMT_YUV422P: return AV_PIX_FMT_YUVJ422P;
+    case AV_PIX_FMT_YUV444P: return AV_PIX_FMT_YUVJ444P;
+    case AV_PIX_FMT_YUV440P: return AV_PIX_FMT_YUVJ440P;
+    case AV_PIX_FMT_YUV411P: return AV_PIX_FMT_YUVJ411P;
+    default: return format;
+  }
+}
+
+// Encoder for a still image. The default WebP encoder is libwebp_anim, which
+// only emits a packet on flush, so single images use libwebp.
+const AVCodec* FindImageEncoder(int codec_id) {
+  if (codec_id == AV_CODEC_ID_WEBP) {
+    const AVCodec* codec = avcodec_find_encoder_by_name("libwebp");
+    if (codec) {
+      return codec;
+    }
+  }
+  return avcodec_find_encoder(static_cast<AVCodecID>(codec_id));
+}
+
+// Encoder pixel format closest to the source format
+AVPixelFormat ChooseFormat(const AVCodec* codec, AVPixelFormat source) {
+  const void* configs = nullptr;
+  int count = 0;
+  int ret = avcodec_get_supported_config(nullptr, codec, AV_CODEC_CONFIG_PIX_FORMAT, 0, &configs, &count);
+  if (ret < 0 || !configs || count == 0) {
+    return source;
+  }
+
+  const AVPixelFormat* formats = static_cast<const AVPixelFormat*>(configs);
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(source);
+  int has_alpha = desc && (desc->flags & AV_PIX_FMT_FLAG_ALPHA) ? 1 : 0;
+  AVPixelFormat best = avcodec_find_best_pix_fmt_of_list(formats, source, has_alpha, nullptr);
+
+  // MJPEG expects full range YUV, prefer the J formats when listed
+  if (codec->id == AV_CODEC_ID_MJPEG) {
+    AVPixelFormat full = JpegFormat(best);
+    if (std::find(formats, formats + count, full) != formats + count) {
+      best = full;
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+ImageEncoderPool::Entry::~Entry() {
+  avcodec_free_context(&codec_ctx);
+  for (Scaler& scaler : scalers) {
+    sws_freeContext(scaler.ctx);
+  }
+  av_frame_free(&converted);
+}
+
+SwsContext* ImageEncoderPool::Entry::GetScaler(int width, int height, AVPixelFormat format) {
+  auto it = std::find_if(scalers.begin(), scalers.end(), [&](const Scaler& scaler) {
+    return scaler.width == width && scaler.height == height && scaler.format == format;
+  });
+  if (it != scalers.end()) {
+    std::rotate(scalers.begin(), it, it + 1);
+    return scalers.front().ctx;
+  }
+
+  SwsContext* ctx = sws_getContext(width, height, format, key.width, key.height, key.format,
+                                   SWS_BILINEAR, nullptr, nullptr, nullptr);
+  if (!ctx) {
+    return nullptr;
+  }
+  if (scalers.size() == kMaxScalers) {
+    sws_freeContext(scalers.back().ctx);
+    scalers.pop_back();
+  }
+  scalers.insert(scalers.begin(), Scaler{width, height, format, ctx});
+  return ctx;
+}
+
+std::unique_ptr<ImageEncoderPool::Entry> ImageEncoderPool::Open(const Key& key, int& ret) {
+  const AVCodec* codec = FindImageEncoder(key.codec_id);
+  if (!codec) {
+    ret = AVERROR_ENCODER_NOT_FOUND;
+    return nullptr;
+  }
+
+  auto entry = std::make_unique<Entry>();
+  entry->key = key;
+  entry->codec_ctx = avcodec_alloc_context3(codec);
+  entry->converted = av_frame_alloc();
+  if (!entry->codec_ctx || !entry->converted) {
+    ret = AVERROR(ENOMEM);
+    return nullptr;
+  }
+
+  AVCodecContext* ctx = entry->codec_ctx;
+  ctx->width = key.width;
+  ctx->height = key.height;
+  ctx->pix_fmt = key.format;
+  ctx->time_base = {1, 25};
+  ctx->thread_count = threads_;
+  if (key.codec_id == AV_CODEC_ID_MJPEG) {
+    ctx->color_range = AVCOL_RANGE_JPEG;
+  }
+
+  // Quality 1-100 mapped to each encoder's own scale
+  if (key.quality > 0) {
+    if (key.codec_id == AV_CODEC_ID_MJPEG) {
+      int qscale = 2 + ((100 - key.quality) * 29 + 49) / 99;
+      ctx->flags |= AV_CODEC_FLAG_QSCALE;
+      ctx->global_quality = qscale * FF_QP2LAMBDA;
+    } else {
+      av_opt_set_double(ctx, "quality", key.quality, AV_OPT_SEARCH_CHILDREN);
+    }
+  }
+
+  ret = avcodec_open2(ctx, codec, nullptr);
+  if (ret < 0) {
+    return nullptr;
+  }
+
+  entry->converted->width = key.width;
+  entry->converted->height = key.height;
+  entry->converted->format = key.format;
+  ret = av_frame_get_buffer(entry->converted, 0);
+  if (ret < 0) {
+    return nullptr;
+  }
+
+  ret = 0;
+  return entry;
+}
+
+std::unique_ptr<ImageEncoderPool::Entry> ImageEncoderPool::Acquire(const Key& key, int& ret) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) {
+      ret = AVERROR(EINVAL);
+      return nullptr;
+    }
+    in_use_++;
+    for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+      if ((*it)->key == key) {
+        std::unique_ptr<Entry> entry = std::move(*it);
+        idle_.erase(it);
+        hits_++;
+        return entry;
+      }
+    }
+    misses_++;
+  }
+
+  // Open outside the lock, other workers keep encoding meanwhile
+  std::unique_ptr<Entry> entry = Open(key, ret);
+  if (!entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_use_--;
+  }
+  return entry;
+}
+
+void ImageEncoderPool::Release(std::unique_ptr<Entry> entry) {
+  std::vector<std::unique_ptr<Entry>> evicted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_use_--;
+    if (closed_ || !entry) {
+      return;
+    }
+    idle_.push_front(std::move(entry));
+    while (idle_.size() > max_idle_) {
+      evicted.push_back(std::move(idle_.back()));
+      idle_.pop_back();
+      evictions_++;
+    }
+  }
+  // Contexts are freed outside the lock
+}
+
+int ImageEncoderPool::Encode(const AVFrame* frame, const ImageEncoderOptions& options, AVPacket* packet) {
+  // Hardware frames are downloaded first
+  AVFrame* downloaded = nullptr;
+  if (frame->hw_frames_ctx) {
+    downloaded = av_frame_alloc();
+    if (!downloaded) {
+      return AVERROR(ENOMEM);
+    }
+    int ret = av_hwframe_transfer_data(downloaded, frame, 0);
+    if (ret < 0) {
+      av_frame_free(&downloaded);
+      return ret;
+    }
+    av_frame_copy_props(downloaded, frame);
+    frame = downloaded;
+  }
+
+  int ret = 0;
+  std::unique_ptr<Entry> entry;
+  AVFrame* input = nullptr;
+
+  do {
+    if (frame->width <= 0 || frame->height <= 0 || frame->format < 0) {
+      ret = AVERROR(EINVAL);
+      break;
+    }
+
+    // Output size, keeping the aspect ratio when only one side is given
+    int width = options.width;
+    int height = options.height;
+    if (width <= 0 && height <= 0) {
+      width = frame->width;
+      height = frame->height;
+    } else if (width <= 0) {
+      width = std::max(1, static_cast<int>((static_cast<int64_t>(frame->width) * height + frame->height / 2) / frame->height));
+    } else if (height <= 0) {
+      height = std::max(1, static_cast<int>((static_cast<int64_t>(frame->height) * width + frame->width / 2) / frame->width));
+    }
+
+    // Full range YUV is described by the J formats for swscale
+    AVPixelFormat source = static_cast<AVPixelFormat>(frame->format);
+    if (frame->color_range == AVCOL_RANGE_JPEG) {
+      source = JpegFormat(source);
+    }
+
+    const AVCodec* codec = FindImageEncoder(options.codec_id);
+    if (!codec) {
+      ret = AVERROR_ENCODER_NOT_FOUND;
+      break;
+    }
+
+    // PNG is lossless, quality would only split the pool
+    int quality = options.codec_id == AV_CODEC_ID_PNG ? -1 : options.quality;
+    Key key{options.codec_id, width, height, ChooseFormat(codec, source), quality};
+
+    entry = Acquire(key, ret);
+    if (!entry) {
+      break;
+    }
+
+    input = av_frame_alloc();
+    if (!input) {
+      ret = AVERROR(ENOMEM);
+      break;
+    }
+
+    if (source == key.format && frame->width == width && frame->height == height) {
+      ret = av_frame_ref(input, frame);
+      // Same layout, the J format only marks the range
+      input->format = key.format;
+    } else {
+      SwsContext* sws = entry->GetScaler(frame->width, frame->height, source);
+      if (!sws) {
+        ret = AVERROR(EINVAL);
+        break;
+      }
+
+      ret = av_frame_make_writable(entry->converted);
+      if (ret < 0) {
+        break;
+      }
+      int lines = sws_scale(sws, frame->data, frame->linesize, 0, frame->height,
+                            entry->converted->data, entry->converted->linesize);
+      if (lines <= 0) {
+        ret = lines < 0 ? lines : AVERROR(EINVAL);
+        break;
+      }
+      ret = av_frame_ref(input, entry->converted);
+    }
+    if (ret < 0) {
+      break;
+    }
+
+    input->pts = entry->next_pts++;
+    input->pict_type = AV_PICTURE_TYPE_NONE;
+    input->quality = entry->codec_ctx->global_quality;
+
+    ret = avcodec_send_frame(entry->codec_ctx, input);
+    if (ret < 0) {
+      break;
+    }
+    ret = avcodec_receive_packet(entry->codec_ctx, packet);
+  } while (false);
+
+  av_frame_free(&input);
+  av_frame_free(&downloaded);
+
+  if (entry) {
+    if (ret < 0) {
+      // The encoder state is unknown after a failure, do not reuse it
+      entry.reset();
+    } else {
+      std::lock_guard<std::mutex> lock(mutex_);
+      encoded_++;
+    }
+    Release(std::move(entry));
+  }
+  return ret;
+}
+
+void ImageEncoderPool::Clear(bool close) {
+  std::list<std::unique_ptr<Entry>> idle;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle.swap(idle_);
+    if (close) {
+      closed_ = true;
+    }
+  }
+}
+
+Napi::Object ImageEncoderPool::GetStats(Napi::Env env) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("idle", Napi::Number::New(env, static_cast<double>(idle_.size())));
+  stats.Set("inUse", Napi::Number::New(env, static_cast<double>(in_use_)));
+  stats.Set("encoded", Napi::Number::New(env, static_cast<double>(encoded_)));
+  stats.Set("hits", Napi::Number::New(env, static_cast<double>(hits_)));
+  stats.Set("misses", Napi::Number::New(env, static_cast<double>(misses_)));
+  stats.Set("evictions", Napi::Number::New(env, static_cast<double>(evictions_)));
+  return stats;
+}
+
+class ImageEncodeWorker : public Napi::AsyncWorker {
+public:
+  ImageEncodeWorker(Napi::Env env, std::shared_ptr<ImageEncoderPool> pool,
+                    Napi::Object frameObj, Frame* frame, const ImageEncoderOptions& options)
+    : Napi::AsyncWorker(env),
+      pool_(std::move(pool)),
+      frame_(frame),
+      options_(options),
+      packet_(av_packet_alloc()),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    // Hold reference to prevent GC during async operation
+    frame_ref_.Reset(frameObj, 1);
+  }
+
+  ~ImageEncodeWorker() {
+    frame_ref_.Reset();
+    av_packet_free(&packet_);
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("ImageEncodeWorker", "worker", pool_.get());
+
+    if (!frame_ || !frame_->Get() || !packet_) {
+      ret_ = AVERROR(EINVAL);
+      return;
+    }
+
+    ret_ = pool_->Encode(frame_->Get(), options_, packet_);
+  }
+
+  void OnOK() override {
+    Napi::Env env = Env();
+    if (ret_ < 0) {
+      deferred_.Resolve(Napi::Number::New(env, ret_));
+      return;
+    }
+    deferred_.Resolve(Napi::Buffer<uint8_t>::Copy(env, packet_->data, packet_->size));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  std::shared_ptr<ImageEncoderPool> pool_;
+  Napi::ObjectReference frame_ref_;
+  Frame* frame_;
+  ImageEncoderOptions options_;
+  AVPacket* packet_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+Napi::FunctionReference ImageEncoder::constructor;
+
+Napi::Object ImageEncoder::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "ImageEncoder", {
+    StaticMethod<&ImageEncoder::Create>("create"),
+    InstanceMethod<&ImageEncoder::EncodeAsync>("encode"),
+    InstanceMethod<&ImageEncoder::EncodeSync>("encodeSync"),
+    InstanceMethod<&ImageEncoder::Clear>("clear"),
+    InstanceMethod<&ImageEncoder::Close>("close"),
+    InstanceMethod<&ImageEncoder::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &ImageEncoder::Dispose),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ImageEncoder", func);
+  return exports;
+}
+
+ImageEncoder::ImageEncoder(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ImageEncoder>(info) {
+  // Created via ImageEncoder.create()
+}
+
+Napi::Value ImageEncoder::Create(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int64_t max_idle = kDefaultMaxIdle;
+  int threads = 1;
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+    Napi::Value value = options.Get("maxContexts");
+    if (value.IsNumber()) {
+      max_idle = value.As<Napi::Number>().Int64Value();
+    }
+    value = options.Get("threads");
+    if (value.IsNumber()) {
+      threads = value.As<Napi::Number>().Int32Value();
+    }
+  }
+
+  if (max_idle < 0 || threads < 0) {
+    Napi::RangeError::New(env, "maxContexts and threads must not be negative").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Object obj = constructor.New({});
+  ImageEncoder* encoder = Napi::ObjectWrap<ImageEncoder>::Unwrap(obj);
+  encoder->pool_ = std::make_shared<ImageEncoderPool>(static_cast<size_t>(max_idle), threads);
+  return obj;
+}
+
+bool ImageEncoder::ParseEncodeOptions(const Napi::Value& value, ImageEncoderOptions& options) {
+  if (!value.IsObject()) {
+    return false;
+  }
+
+  Napi::Object obj = value.As<Napi::Object>();
+  Napi::Value codecId = obj.Get("codecId");
+  if (!codecId.IsNumber()) {
+    return false;
+  }
+  options.codec_id = codecId.As<Napi::Number>().Int32Value();
+
+  Napi::Value width = obj.Get("width");
+  if (width.IsNumber()) {
+    options.width = width.As<Napi::Number>().Int32Value();
+  }
+  Napi::Value height = obj.Get("height");
+  if (height.IsNumber()) {
+    options.height = height.As<Napi::Number>().Int32Value();
+  }
+  Napi::Value quality = obj.Get("quality");
+  if (quality.IsNumber()) {
+    options.quality = std::min(100, std::max(1, quality.As<Napi::Number>().Int32Value()));
+  }
+  return true;
+}
+
+Napi::Value ImageEncoder::EncodeAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  ImageEncoderOptions options;
+  if (!frame || info.Length() < 2 || !ParseEncodeOptions(info[1], options)) {
+    Napi::TypeError::New(env, "Expected (frame, { codecId, width?, height?, quality? })").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  auto* worker = new ImageEncodeWorker(env, pool_, info[0].As<Napi::Object>(), frame, options);
+  worker->Queue();
+  return worker->GetPromise();
+}
+
+Napi::Value ImageEncoder::EncodeSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  ImageEncoderOptions options;
+  if (!frame || info.Length() < 2 || !ParseEncodeOptions(info[1], options)) {
+    Napi::TypeError::New(env, "Expected (frame, { codecId, width?, height?, quality? })").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!frame->Get()) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  AVPacket* packet = av_packet_alloc();
+  if (!packet) {
+    return Napi::Number::New(env, AVERROR(ENOMEM));
+  }
+
+  int ret = pool_->Encode(frame->Get(), options, packet);
+  Napi::Value result = ret < 0
+    ? Napi::Number::New(env, ret)
+    : Napi::Buffer<uint8_t>::Copy(env, packet->data, packet->size).As<Napi::Value>();
+  av_packet_free(&packet);
+  return result;
+}
+
+Napi::Value ImageEncoder::Clear(const Napi::CallbackInfo& info) {
+  pool_->Clear(false);
+  return info.Env().Undefined();
+}
+
+Napi::Value ImageEncoder::Close(const Napi::CallbackInfo& info) {
+  pool_->Clear(true);
+  return info.Env().Undefined();
+}
+
+Napi::Value ImageEncoder::GetStats(const Napi::CallbackInfo& info) {
+  return pool_->GetStats(info.Env());
+}
+
+Napi::Value ImageEncoder::Dispose(const Napi::CallbackInfo& info) {
+  return Close(info);
+}
+
+} // namespace ffmpeg
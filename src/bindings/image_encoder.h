@@ -0,0 +1,133 @@
+#ifndef FFMPEG_IMAGE_ENCODER_H
+#define FFMPEG_IMAGE_ENCODER_H
+
+#include <napi.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "common.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/frame.h>
+#include <libswscale/swscale.h>
+}
+
+namespace ffmpeg {
+
+// Still image encoding (JPEG, PNG, WebP) with warm encoder contexts.
+//
+// Opening an image encoder and a scaler costs far more than encoding one
+// small frame. Contexts are keyed by codec, output size, pixel format and
+// quality and returned to a bounded LRU pool of idle contexts after each
+// encode; each keeps its conversion frame and a scaler per source size and
+// format (up to kMaxScalers), so a steady stream of snapshots from the same
+// cameras never reopens anything, even when their resolutions differ. Concurrent encodes
+// with the same key check out separate contexts, so threadpool workers never
+// share an encoder.
+//
+// The pool is shared with in-flight workers: close() frees idle contexts
+// and contexts still in use are freed when their encode finishes.
+struct ImageEncoderOptions {
+  int codec_id = AV_CODEC_ID_MJPEG;
+  int width = 0;    // 0 = source width (or keep aspect with height)
+  int height = 0;   // 0 = source height (or keep aspect with width)
+  int quality = -1; // 1-100, -1 = encoder default
+};
+
+class ImageEncoderPool {
+public:
+  struct Key {
+    int codec_id;
+    int width;
+    int height;
+    AVPixelFormat format;
+    int quality;
+
+    bool operator==(const Key& other) const {
+      return codec_id == other.codec_id && width == other.width && height == other.height &&
+             format == other.format && quality == other.quality;
+    }
+  };
+
+  // Scaler from one source size and format to the entry's output
+  struct Scaler {
+    int width;
+    int height;
+    AVPixelFormat format;
+    SwsContext* ctx;
+  };
+
+  static constexpr size_t kMaxScalers = 4;
+
+  struct Entry {
+    ~Entry();
+
+    // Scaler for the source, created on first use; nullptr on failure
+    SwsContext* GetScaler(int width, int height, AVPixelFormat format);
+
+    Key key;
+    AVCodecContext* codec_ctx = nullptr;
+    std::vector<Scaler> scalers;    // Most recently used first
+    AVFrame* converted = nullptr;
+    int64_t next_pts = 0;
+  };
+
+  ImageEncoderPool(size_t max_idle, int threads) : max_idle_(max_idle), threads_(threads) {}
+
+  // Encode one frame; returns 0 and sets packet, or a negative AVERROR
+  int Encode(const AVFrame* frame, const ImageEncoderOptions& options, AVPacket* packet);
+
+  // Free idle contexts; with close, contexts in use are freed on release
+  void Clear(bool close);
+
+  Napi::Object GetStats(Napi::Env env);
+
+private:
+  std::unique_ptr<Entry> Acquire(const Key& key, int& ret);
+  void Release(std::unique_ptr<Entry> entry);
+  std::unique_ptr<Entry> Open(const Key& key, int& ret);
+
+  size_t max_idle_;
+  int threads_;
+
+  std::mutex mutex_;
+  std::list<std::unique_ptr<Entry>> idle_;  // Most recently used first
+  bool closed_ = false;
+  size_t in_use_ = 0;
+  uint64_t encoded_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+};
+
+class ImageEncoder : public Napi::ObjectWrap<ImageEncoder> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  ImageEncoder(const Napi::CallbackInfo& info);
+
+private:
+  friend class ImageEncodeWorker;
+
+  static Napi::FunctionReference constructor;
+
+  // Static methods
+  static Napi::Value Create(const Napi::CallbackInfo& info);
+
+  // Instance methods
+  Napi::Value EncodeAsync(const Napi::CallbackInfo& info);
+  Napi::Value EncodeSync(const Napi::CallbackInfo& info);
+  Napi::Value Clear(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  static bool ParseEncodeOptions(const Napi::Value& value, ImageEncoderOptions& options);
+
+  std::shared_ptr<ImageEncoderPool> pool_;
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_IMAGE_ENCODER_H
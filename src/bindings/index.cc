@@ -1,9 +1,5 @@
 #include <napi.h>
 
-extern "C" {
-#include <libavdevice/avdevice.h>
-}
-
 #include "packet.h"
 #include "frame.h"
 #include "codec.h"
@@ -35,12 +31,29 @@ extern "C" {
 #include "log.h"
 #include "option.h"
 #include "sync_queue.h"
+#include "rtsp_talkback.h"
+#include "pipeline_stage.h"
+#include "packet_pacer.h"
+#include "input_synchronizer.h"
+#include "mp4_defragmenter.h"
+#include "lazy_exports.h"
+#include "registry.h"
+#include "memory_accounting.h"
+#include "leak_detector.h"
+#include "tracing.h"
+#include "timestamp_rescaler.h"
+#include "image_encoder.h"
+#include "inline_dispatch.h"
+#include "audio_mixer.h"
+#include "loudness_meter.h"
+#include "voice_activity_detector.h"
 
 namespace ffmpeg {
 
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
-  // PodFirst: Register device input/output formats (avfoundation, dshow, v4l2, etc.)
-  avdevice_register_all();
+  // PodFirst: Device input/output formats (avfoundation, dshow, v4l2, etc.) are
+  // registered on first format lookup by name, see LazyExports::EnsureDevices()
+  LazyExports::Attach(env, exports);
 
   // Core Types
   Packet::Init(env, exports);
@@ -66,12 +79,12 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   FFmpegError::Init(env, exports);
   Utilities::Init(env, exports);
   
-  // Processing
-  SoftwareScaleContext::Init(env, exports);
-  SoftwareResampleContext::Init(env, exports);
-  AudioFifo::Init(env, exports);
-  Fifo::Init(env, exports);
-  FrameUtils::Init(env, exports);
+  // Processing (registered on first use)
+  LazyExports::Define(env, {"SoftwareScaleContext"}, SoftwareScaleContext::Init);
+  LazyExports::Define(env, {"SoftwareResampleContext"}, SoftwareResampleContext::Init);
+  LazyExports::Define(env, {"AudioFifo"}, AudioFifo::Init);
+  LazyExports::Define(env, {"Fifo"}, Fifo::Init);
+  LazyExports::Define(env, {"FrameUtils"}, FrameUtils::Init);
   
   // Filter System
   Filter::Init(env, exports);
@@ -84,9 +97,9 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   BitStreamFilter::Init(env, exports);
   BitStreamFilterContext::Init(env, exports);
   
-  // Hardware Acceleration
-  HardwareDeviceContext::Init(env, exports);
-  HardwareFramesContext::Init(env, exports);
+  // Hardware Acceleration (registered on first use)
+  LazyExports::Define(env, {"HardwareDeviceContext"}, HardwareDeviceContext::Init);
+  LazyExports::Define(env, {"HardwareFramesContext"}, HardwareFramesContext::Init);
   
   // Logging
   Log::Init(env, exports);
@@ -94,8 +107,55 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   // Options System
   AVOptionWrapper::Init(env, exports);
 
+  // Subsystems below are registered on first use
+
   // Sync Queue
-  SyncQueue::Init(env, exports);
+  LazyExports::Define(env, {"SyncQueue"}, SyncQueue::Init);
+
+  // RTSP Talkback
+  LazyExports::Define(env, {"RTSPTalkback"}, RtspTalkback::Init);
+
+  // Native pipeline stages
+  LazyExports::Define(env, {"PipelineStage"}, PipelineStage::Init);
+
+  // Real-time packet pacing
+  LazyExports::Define(env, {"PacketPacer"}, PacketPacer::Init);
+
+  // Multi-input synchronization
+  LazyExports::Define(env, {"InputSynchronizer"}, InputSynchronizer::Init);
+
+  // MP4 finalization
+  LazyExports::Define(env, {"mp4Defragment", "mp4DefragmentSync"}, Mp4Defragmenter::Init);
+
+  // Indexed codec/filter/format registry
+  LazyExports::Define(env, {"registryFind", "registryEntry", "registrySnapshot"}, Registry::Init);
+
+  // Native memory accounting
+  LazyExports::Define(env, {"setMemoryAccounting", "getMemoryAccounting", "resetMemoryAccountingPeak"}, MemoryAccounting::Init);
+
+  // Leak detection for Packet/Frame wrappers
+  LazyExports::Define(env, {"setLeakDetection", "getLeakDetectionSites", "resetLeakDetection"}, LeakDetector::Init);
+
+  // Native tracing (Chrome trace export)
+  LazyExports::Define(env, {"setNativeTracing", "exportNativeTrace"}, Tracing::Init);
+
+  // Timestamp rescaler bound to a time base pair
+  LazyExports::Define(env, {"TimestampRescaler"}, TimestampRescaler::Init);
+
+  // Still image encoding with pooled encoder contexts
+  LazyExports::Define(env, {"ImageEncoder"}, ImageEncoder::Init);
+
+  // Inline dispatch of cheap async operations
+  LazyExports::Define(env, {"setInlineDispatch", "getInlineDispatchStats"}, InlineDispatch::Init);
+
+  // Clock driven mixing of live audio inputs
+  LazyExports::Define(env, {"AudioMixer"}, AudioMixer::Init);
+
+  // Loudness and level metering (EBU R128)
+  LazyExports::Define(env, {"LoudnessMeter"}, LoudnessMeter::Init);
+
+  // Voice activity detection (energy and zero crossings)
+  LazyExports::Define(env, {"VoiceActivityDetector"}, VoiceActivityDetector::Init);
 
   return exports;
 }
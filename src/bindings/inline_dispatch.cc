@@ -0,0 +1,89 @@
+#include "inline_dispatch.h"
+
+namespace ffmpeg {
+
+namespace {
+
+constexpr size_t kDefaultMaxBytes = 64 * 1024;
+
+const char* const kOpNames[InlineDispatch::kOpCount] = {
+  "audioFifo",
+  "fifo",
+  "bitstreamFilter",
+};
+
+} // namespace
+
+std::atomic<bool> InlineDispatch::enabled_{true};
+std::atomic<size_t> InlineDispatch::max_bytes_{kDefaultMaxBytes};
+std::atomic<uint64_t> InlineDispatch::inline_[kOpCount] = {};
+std::atomic<uint64_t> InlineDispatch::offloaded_[kOpCount] = {};
+
+bool InlineDispatch::ShouldInline(Op op, size_t cost) {
+  if (enabled_.load(std::memory_order_relaxed) && cost <= max_bytes_.load(std::memory_order_relaxed)) {
+    inline_[op].fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  offloaded_[op].fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+Napi::Object InlineDispatch::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setInlineDispatch", Napi::Function::New(env, Set));
+  exports.Set("getInlineDispatchStats", Napi::Function::New(env, GetStats));
+  return exports;
+}
+
+Napi::Value InlineDispatch::Set(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "Options object required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Object options = info[0].As<Napi::Object>();
+  Napi::Value maxBytes = options.Get("maxBytes");
+  if (maxBytes.IsNumber()) {
+    int64_t value = maxBytes.As<Napi::Number>().Int64Value();
+    if (value < 0) {
+      Napi::RangeError::New(env, "maxBytes must not be negative").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    max_bytes_.store(static_cast<size_t>(value), std::memory_order_relaxed);
+  }
+
+  Napi::Value enabled = options.Get("enabled");
+  if (enabled.IsBoolean()) {
+    enabled_.store(enabled.As<Napi::Boolean>().Value(), std::memory_order_relaxed);
+  }
+
+  Napi::Value resetStats = options.Get("resetStats");
+  if (resetStats.IsBoolean() && resetStats.As<Napi::Boolean>().Value()) {
+    for (int i = 0; i < kOpCount; i++) {
+      inline_[i].store(0, std::memory_order_relaxed);
+      offloaded_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value InlineDispatch::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("enabled", Napi::Boolean::New(env, enabled_.load(std::memory_order_relaxed)));
+  stats.Set("maxBytes", Napi::Number::New(env, static_cast<double>(max_bytes_.load(std::memory_order_relaxed))));
+
+  for (int i = 0; i < kOpCount; i++) {
+    Napi::Object counters = Napi::Object::New(env);
+    counters.Set("inline", Napi::Number::New(env, static_cast<double>(inline_[i].load(std::memory_order_relaxed))));
+    counters.Set("offloaded", Napi::Number::New(env, static_cast<double>(offloaded_[i].load(std::memory_order_relaxed))));
+    stats.Set(kOpNames[i], counters);
+  }
+
+  return stats;
+}
+
+} // namespace ffmpeg
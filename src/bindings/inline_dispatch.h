@@ -0,0 +1,63 @@
+#ifndef FFMPEG_INLINE_DISPATCH_H
+#define FFMPEG_INLINE_DISPATCH_H
+
+#include <napi.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ffmpeg {
+
+// Inline execution of cheap async operations.
+//
+// Queuing an AsyncWorker costs a threadpool hop and an event loop wakeup,
+// far more than the small copies done by FIFO writes/reads or by passing a
+// packet to a bitstream filter. Dispatch() runs such a worker on the calling
+// thread and returns an already settled promise when the estimated cost is
+// at most maxBytes, and queues it otherwise. Callers estimate the cost in
+// bytes copied; operations with unknown cost pass kUnknownCost and are
+// always queued.
+class InlineDispatch {
+public:
+  enum Op {
+    kAudioFifo = 0,
+    kFifo,
+    kBitStreamFilter,
+    kOpCount
+  };
+
+  static constexpr size_t kUnknownCost = SIZE_MAX;
+
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  // Decide where to run and count the decision; true = run inline
+  static bool ShouldInline(Op op, size_t cost);
+
+  // Run the worker inline or queue it; returns its promise.
+  // Workers must not call SetError() (they report FFmpeg codes instead).
+  template <typename Worker>
+  static Napi::Promise Dispatch(Op op, size_t cost, Worker* worker) {
+    Napi::Promise promise = worker->GetPromise();
+    if (ShouldInline(op, cost)) {
+      worker->Execute();
+      worker->OnOK();
+      delete worker;
+    } else {
+      worker->Queue();
+    }
+    return promise;
+  }
+
+private:
+  static std::atomic<bool> enabled_;
+  static std::atomic<size_t> max_bytes_;
+  static std::atomic<uint64_t> inline_[kOpCount];
+  static std::atomic<uint64_t> offloaded_[kOpCount];
+
+  static Napi::Value Set(const Napi::CallbackInfo& info);
+  static Napi::Value GetStats(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_INLINE_DISPATCH_H
@@ -1,4 +1,5 @@
 #include "input_format.h"
+#include "lazy_exports.h"
 #include <cstring>
 
 namespace ffmpeg {
@@ -40,6 +41,7 @@ Napi::Value InputFormat::FindInputFormat(const Napi::CallbackInfo& info) {
   }
   
   std::string shortName = info[0].As<Napi::String>().Utf8Value();
+  LazyExports::EnsureDevices();
   const AVInputFormat* fmt = av_find_input_format(shortName.c_str());
   
   if (!fmt) {
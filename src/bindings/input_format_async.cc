@@ -1,5 +1,6 @@
 #include "input_format.h"
 #include "io_context.h"
+#include "tracing.h"
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -29,6 +30,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("InputFormatProbeBufferWorker", "worker", io_context_);
+
     // Null checks to prevent use-after-free crashes
     if (!io_context_) {
       ret_ = AVERROR(EINVAL);
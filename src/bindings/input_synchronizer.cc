@@ -0,0 +1,547 @@
+#include "input_synchronizer.h"
+#include "format_context.h"
+#include "packet.h"
+#include "tracing.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+extern "C" {
+#include <libavutil/mathematics.h>
+#include <libavutil/time.h>
+}
+
+namespace ffmpeg {
+
+static constexpr double DEFAULT_BUFFER_SECONDS = 1.0;
+static constexpr size_t DEFAULT_MAX_QUEUED = 8192;
+
+// Backstop for reader threads waiting on queue space
+static constexpr auto WAIT_SLICE = std::chrono::milliseconds(20);
+
+Napi::FunctionReference InputSynchronizer::constructor;
+
+class ISStopWorker : public Napi::AsyncWorker {
+public:
+  ISStopWorker(Napi::Env env, Napi::Object parentObj, InputSynchronizer* parent)
+    : AsyncWorker(env),
+      parent_(parent),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    parent_ref_.Reset(parentObj, 1);
+  }
+
+  ~ISStopWorker() {
+    parent_ref_.Reset();
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("ISStopWorker", "worker", parent_);
+
+    // Joining waits for interrupted av_read_frame() calls to return
+    parent_->Stop();
+  }
+
+  void OnOK() override {
+    Napi::HandleScope scope(Env());
+    parent_->ReleaseJs();
+    deferred_.Resolve(Env().Undefined());
+  }
+
+  void OnError(const Napi::Error& error) override {
+    deferred_.Reject(error.Value());
+  }
+
+  Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+private:
+  Napi::ObjectReference parent_ref_;
+  InputSynchronizer* parent_;
+  Napi::Promise::Deferred deferred_;
+};
+
+Napi::Object InputSynchronizer::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "InputSynchronizer", {
+    StaticMethod<&InputSynchronizer::Create>("create"),
+    InstanceMethod<&InputSynchronizer::Start>("start"),
+    InstanceMethod<&InputSynchronizer::Receive>("receive"),
+    InstanceMethod<&InputSynchronizer::ReceiveAsync>("receiveAsync"),
+    InstanceMethod<&InputSynchronizer::StopAsync>("stop"),
+    InstanceMethod<&InputSynchronizer::GetStats>("getStats"),
+
+    InstanceAccessor<&InputSynchronizer::GetStreamCount>("streamCount"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("InputSynchronizer", func);
+  return exports;
+}
+
+InputSynchronizer::InputSynchronizer(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<InputSynchronizer>(info) {
+  // Created via InputSynchronizer.create()
+}
+
+InputSynchronizer::~InputSynchronizer() {
+  Stop();
+  if (sq_) {
+    sq_free(&sq_);
+  }
+}
+
+Napi::Value InputSynchronizer::Create(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "Expected an array of FormatContexts").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Array contexts = info[0].As<Napi::Array>();
+  if (contexts.Length() == 0) {
+    Napi::RangeError::New(env, "At least one input is required").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  double buffer_seconds = DEFAULT_BUFFER_SECONDS;
+  size_t max_queued = DEFAULT_MAX_QUEUED;
+  if (info.Length() > 1 && info[1].IsObject()) {
+    Napi::Object options = info[1].As<Napi::Object>();
+    Napi::Value v = options.Get("bufferDuration");
+    if (v.IsNumber()) {
+      buffer_seconds = std::max(0.0, v.As<Napi::Number>().DoubleValue());
+    }
+    v = options.Get("maxQueuedPackets");
+    if (v.IsNumber()) {
+      max_queued = static_cast<size_t>(std::max(1.0, v.As<Napi::Number>().DoubleValue()));
+    }
+  }
+
+  Napi::Object obj = constructor.New({});
+  InputSynchronizer* sync = Napi::ObjectWrap<InputSynchronizer>::Unwrap(obj);
+  sync->max_queued_ = max_queued;
+
+  for (uint32_t i = 0; i < contexts.Length(); i++) {
+    Napi::Value value = contexts.Get(i);
+    FormatContext* format = UnwrapNativeObject<FormatContext>(env, value, "FormatContext");
+    AVFormatContext* ctx = format ? format->Get() : nullptr;
+    if (!ctx || format->IsOutput() || !ctx->iformat) {
+      Napi::TypeError::New(env, "All inputs must be opened input FormatContexts").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    for (const auto& other : sync->inputs_) {
+      if (other->ctx == ctx) {
+        Napi::Error::New(env, "The same FormatContext was passed twice").ThrowAsJavaScriptException();
+        return env.Null();
+      }
+    }
+
+    auto input = std::make_unique<Input>();
+    input->format = format;
+    input->ctx = ctx;
+    input->ref.Reset(value.As<Napi::Object>(), 1);
+    input->base = sync->nb_streams_;
+    input->streams.resize(ctx->nb_streams);
+    for (unsigned int s = 0; s < ctx->nb_streams; s++) {
+      input->streams[s].time_base = ctx->streams[s]->time_base;
+    }
+    sync->nb_streams_ += static_cast<int>(ctx->nb_streams);
+    sync->inputs_.push_back(std::move(input));
+  }
+
+  sync->sq_ = sq_alloc(SYNC_QUEUE_PACKETS, static_cast<int64_t>(buffer_seconds * AV_TIME_BASE), nullptr);
+  if (!sync->sq_) {
+    Napi::Error::New(env, "Failed to allocate sync queue").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Limiting streams: no stream may run ahead of the others by more than the buffer
+  for (int i = 0; i < sync->nb_streams_; i++) {
+    if (sq_add_stream(sync->sq_, 1) < 0) {
+      Napi::Error::New(env, "Failed to add stream to sync queue").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  return obj;
+}
+
+Napi::Value InputSynchronizer::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (started_) {
+    Napi::Error::New(env, "Synchronizer already started").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  started_ = true;
+
+  // Timeline zero: packets are placed relative to this wall clock instant
+  origin_us_ = av_gettime();
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    inputs_[i]->thread = std::thread(&InputSynchronizer::Run, this, i);
+  }
+
+  return env.Undefined();
+}
+
+void InputSynchronizer::Run(size_t index) {
+  Input& input = *inputs_[index];
+  AVPacket* pkt = av_packet_alloc();
+  int ret = pkt ? 0 : AVERROR(ENOMEM);
+
+  while (pkt && !abort_.load()) {
+    if (input.format->interrupt_requested_.load()) {
+      ret = AVERROR_EXIT;
+      break;
+    }
+
+    input.format->active_read_operations_.fetch_add(1);
+    input.format->ArmReadDeadline();
+    {
+      Tracing::Scope trace("av_read_frame", "ffmpeg", input.format);
+      ret = av_read_frame(input.ctx, pkt);
+    }
+    input.format->DisarmReadDeadline();
+    input.format->active_read_operations_.fetch_sub(1);
+
+    if (ret == AVERROR(EAGAIN)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    if (ret < 0) {
+      break;
+    }
+
+    // Streams added after open are not part of the timeline
+    if (pkt->stream_index < 0 || pkt->stream_index >= static_cast<int>(input.streams.size())) {
+      av_packet_unref(pkt);
+      continue;
+    }
+
+    Map(input, pkt);
+
+    {
+      std::unique_lock<std::mutex> lock(sq_mutex_);
+      while (queued_ >= max_queued_ && !abort_.load()) {
+        space_cv_.wait_for(lock, WAIT_SLICE);
+      }
+      if (abort_.load()) {
+        av_packet_unref(pkt);
+        break;
+      }
+
+      // sq_send() moves the packet contents on success
+      ::SyncQueueFrame frame;
+      frame.p = pkt;
+      if (sq_send(sq_, input.base + pkt->stream_index, frame) >= 0) {
+        queued_++;
+      } else {
+        av_packet_unref(pkt);
+      }
+    }
+    WakeJs();
+  }
+
+  if (pkt) {
+    av_packet_free(&pkt);
+  }
+  FinishInput(input, ret);
+}
+
+void InputSynchronizer::Map(Input& input, AVPacket* pkt) {
+  AVStream* st = input.ctx->streams[pkt->stream_index];
+  StreamClock& clock = input.streams[pkt->stream_index];
+  int64_t now_us = av_gettime();
+  int64_t ts = pkt->dts != AV_NOPTS_VALUE ? pkt->dts : pkt->pts;
+
+  // RTSP sets start_time_realtime when the first RTCP sender report arrives,
+  // which may be after the first RTP packet: such an input starts on arrival
+  // time and is re-anchored once, to the source clock, when the report shows up
+  bool realtime = input.ctx->start_time_realtime != AV_NOPTS_VALUE && input.ctx->start_time_realtime > 0;
+  if ((!input.anchored || (realtime && !input.realtime)) && ts != AV_NOPTS_VALUE) {
+    int64_t offset_us;
+    if (realtime) {
+      // Absolute start time from the source clock (RTCP NTP for RTSP)
+      int64_t start = input.ctx->start_time != AV_NOPTS_VALUE ? input.ctx->start_time : 0;
+      offset_us = input.ctx->start_time_realtime - start - origin_us_;
+    } else {
+      offset_us = now_us - av_rescale_q(ts, st->time_base, AV_TIME_BASE_Q) - origin_us_;
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    input.anchored = true;
+    input.realtime = realtime;
+    input.offset_us = offset_us;
+    for (auto& sc : input.streams) {
+      sc.offset = av_rescale_q(offset_us, AV_TIME_BASE_Q, sc.time_base);
+      sc.has_transit = false;  // The jump is not jitter
+    }
+  }
+
+  if (input.anchored) {
+    if (pkt->pts != AV_NOPTS_VALUE) {
+      pkt->pts += clock.offset;
+    }
+    if (pkt->dts != AV_NOPTS_VALUE) {
+      pkt->dts += clock.offset;
+    }
+
+    // A re-anchor to an earlier source clock must not move the stream back
+    // behind packets already queued: follow the last mapped dts until the
+    // new timeline catches up
+    int64_t mapped = pkt->dts != AV_NOPTS_VALUE ? pkt->dts : pkt->pts;
+    if (mapped != AV_NOPTS_VALUE) {
+      if (clock.last_dts != AV_NOPTS_VALUE && mapped <= clock.last_dts) {
+        int64_t shift = clock.last_dts + 1 - mapped;
+        if (pkt->pts != AV_NOPTS_VALUE) {
+          pkt->pts += shift;
+        }
+        if (pkt->dts != AV_NOPTS_VALUE) {
+          pkt->dts += shift;
+        }
+        mapped += shift;
+      }
+      clock.last_dts = mapped;
+    }
+  }
+  pkt->time_base = st->time_base;
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  input.packets++;
+
+  // Interarrival jitter (RFC 3550): variation of arrival time minus timeline position
+  if (input.anchored && ts != AV_NOPTS_VALUE) {
+    int64_t mapped_ts = pkt->dts != AV_NOPTS_VALUE ? pkt->dts : pkt->pts;
+    int64_t transit = (now_us - origin_us_) - av_rescale_q(mapped_ts, st->time_base, AV_TIME_BASE_Q);
+    if (clock.has_transit) {
+      double d = std::fabs(static_cast<double>(transit - clock.last_transit_us));
+      clock.jitter_us += (d - clock.jitter_us) / 16.0;
+    }
+    clock.has_transit = true;
+    clock.last_transit_us = transit;
+
+    input.jitter_us = 0;
+    for (const auto& sc : input.streams) {
+      input.jitter_us = std::max(input.jitter_us, sc.jitter_us);
+    }
+    input.max_jitter_us = std::max(input.max_jitter_us, input.jitter_us);
+  }
+}
+
+void InputSynchronizer::FinishInput(Input& input, int ret) {
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    input.eof = true;
+    input.error = (ret == AVERROR_EOF || ret == AVERROR_EXIT || ret >= 0) ? 0 : ret;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(sq_mutex_);
+    inputs_done_++;
+
+    // An ended input only stalls (the buffer limit lets the others continue);
+    // the timeline ends when all inputs have ended, so a lost camera does
+    // not end the recording
+    if (inputs_done_ == static_cast<int>(inputs_.size())) {
+      for (int i = 0; i < nb_streams_; i++) {
+        ::SyncQueueFrame frame;
+        frame.p = nullptr;
+        sq_send(sq_, i, frame);
+      }
+    }
+  }
+
+  WakeJs();
+}
+
+int InputSynchronizer::ReceiveInto(AVPacket* pkt) {
+  std::lock_guard<std::mutex> lock(sq_mutex_);
+  av_packet_unref(pkt);
+
+  ::SyncQueueFrame frame;
+  frame.p = pkt;
+  int ret = sq_receive(sq_, -1, frame);
+  if (ret >= 0) {
+    pkt->stream_index = ret;
+    queued_--;
+    space_cv_.notify_one();
+  }
+  return ret;
+}
+
+Napi::Value InputSynchronizer::Receive(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Expected an allocated Packet").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (receive_deferred_) {
+    Napi::Error::New(env, "A receiveAsync() call is pending").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return Napi::Number::New(env, ReceiveInto(packet->Get()));
+}
+
+Napi::Value InputSynchronizer::ReceiveAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Expected an allocated Packet").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (receive_deferred_) {
+    Napi::Error::New(env, "A receiveAsync() call is pending").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto deferred = Napi::Promise::Deferred::New(env);
+
+  // Fast path: a packet is ready (or the timeline has ended)
+  int ret = ReceiveInto(packet->Get());
+  if (ret != AVERROR(EAGAIN) || abort_.load()) {
+    deferred.Resolve(Napi::Number::New(env, ret == AVERROR(EAGAIN) ? AVERROR_EOF : ret));
+    return deferred.Promise();
+  }
+
+  receive_target_.Reset(info[0].As<Napi::Object>(), 1);
+  receive_deferred_ = std::make_unique<Napi::Promise::Deferred>(deferred);
+  EnsureTsfn(env);
+  tsfn_.Ref(env);
+  SettleReceive();
+
+  return deferred.Promise();
+}
+
+void InputSynchronizer::SettleReceive() {
+  if (!receive_deferred_) {
+    return;
+  }
+
+  Napi::Env env = receive_deferred_->Env();
+  Packet* packet = Napi::ObjectWrap<Packet>::Unwrap(receive_target_.Value());
+  int ret = ReceiveInto(packet->Get());
+
+  if (ret == AVERROR(EAGAIN) && !abort_.load()) {
+    // Arm the wakeup, then re-check so a packet queued in between is not missed
+    js_waiting_.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ret = ReceiveInto(packet->Get());
+    if (ret == AVERROR(EAGAIN) && !abort_.load()) {
+      return;
+    }
+    js_waiting_.store(false);
+  }
+  if (ret == AVERROR(EAGAIN)) {
+    ret = AVERROR_EOF;
+  }
+
+  auto deferred = std::move(receive_deferred_);
+  receive_target_.Reset();
+  if (has_tsfn_) {
+    tsfn_.Unref(env);
+  }
+  deferred->Resolve(Napi::Number::New(env, ret));
+}
+
+void InputSynchronizer::WakeJs() {
+  if (js_waiting_.exchange(false)) {
+    tsfn_.NonBlockingCall(this, [](Napi::Env env, Napi::Function, InputSynchronizer* sync) {
+      Napi::HandleScope scope(env);
+      sync->SettleReceive();
+    });
+  }
+}
+
+void InputSynchronizer::EnsureTsfn(Napi::Env env) {
+  if (has_tsfn_) {
+    return;
+  }
+
+  // The synchronizer must outlive queued wakeups: the finalizer drops the self reference
+  self_ref_.Reset(Value(), 1);
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "InputSynchronizerWakeup",
+    0,  // Unlimited queue
+    static_cast<size_t>(inputs_.size()),
+    [this](Napi::Env) { self_ref_.Reset(); }
+  );
+  tsfn_.Unref(env);
+  has_tsfn_ = true;
+}
+
+void InputSynchronizer::ReleaseJs() {
+  SettleReceive();
+  if (has_tsfn_) {
+    has_tsfn_ = false;
+    tsfn_.Release();
+  }
+}
+
+void InputSynchronizer::Stop() {
+  abort_ = true;
+
+  // Unblock reads on live inputs; the inputs are not readable afterwards
+  for (auto& input : inputs_) {
+    if (input->thread.joinable()) {
+      input->format->RequestInterrupt();
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(sq_mutex_);
+    space_cv_.notify_all();
+  }
+  for (auto& input : inputs_) {
+    if (input->thread.joinable()) {
+      input->thread.join();
+    }
+  }
+}
+
+Napi::Value InputSynchronizer::StopAsync(const Napi::CallbackInfo& info) {
+  auto* worker = new ISStopWorker(info.Env(), Value(), this);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+  return promise;
+}
+
+Napi::Value InputSynchronizer::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Array inputs = Napi::Array::New(env, inputs_.size());
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (size_t i = 0; i < inputs_.size(); i++) {
+      const Input& input = *inputs_[i];
+      Napi::Object stats = Napi::Object::New(env);
+      stats.Set("packets", Napi::Number::New(env, static_cast<double>(input.packets)));
+      stats.Set("clock", Napi::String::New(env, !input.anchored ? "none" : input.realtime ? "realtime" : "arrival"));
+      stats.Set("offsetMs", Napi::Number::New(env, input.offset_us / 1000.0));
+      stats.Set("jitterMs", Napi::Number::New(env, input.jitter_us / 1000.0));
+      stats.Set("maxJitterMs", Napi::Number::New(env, input.max_jitter_us / 1000.0));
+      stats.Set("eof", Napi::Boolean::New(env, input.eof));
+      stats.Set("error", Napi::Number::New(env, input.error));
+      inputs.Set(static_cast<uint32_t>(i), stats);
+    }
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("inputs", inputs);
+  {
+    std::lock_guard<std::mutex> lock(sq_mutex_);
+    result.Set("queued", Napi::Number::New(env, static_cast<double>(queued_)));
+  }
+  return result;
+}
+
+Napi::Value InputSynchronizer::GetStreamCount(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), nb_streams_);
+}
+
+} // namespace ffmpeg
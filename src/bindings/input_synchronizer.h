@@ -0,0 +1,125 @@
+#ifndef FFMPEG_INPUT_SYNCHRONIZER_H
+#define FFMPEG_INPUT_SYNCHRONIZER_H
+
+#include <napi.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common.h"
+
+extern "C" {
+#include "fftools/sync_queue.h"
+}
+
+namespace ffmpeg {
+
+class FormatContext;
+
+// Synchronized reading of several inputs onto one timeline.
+//
+// Each input is read on its own native thread. Packet timestamps are mapped
+// onto a shared wall clock timeline: inputs that report an absolute start time
+// (start_time_realtime, e.g. RTSP with RTCP sender reports) use it, the others
+// are anchored at the arrival time of their first packet. An input whose
+// start_time_realtime appears after its first packet is re-anchored to it
+// once; mapped dts never go backwards per stream, so packets after a jump to
+// an earlier clock follow the last mapped one until the timeline catches up.
+// Otherwise the per-input offset is constant, so mapping never adds rounding
+// jitter. Mapped packets are interleaved by FFmpeg's sync queue and received
+// from JS in timeline order.
+//
+// Output stream indices are flattened: all streams of input 0, then input 1...
+class InputSynchronizer : public Napi::ObjectWrap<InputSynchronizer> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  InputSynchronizer(const Napi::CallbackInfo& info);
+  ~InputSynchronizer();
+
+private:
+  friend class ISStopWorker;
+
+  struct StreamClock {
+    AVRational time_base = {0, 1};
+    int64_t offset = 0;                // Timeline offset in stream time base
+    int64_t last_dts = AV_NOPTS_VALUE; // Last mapped dts (or pts), never goes backwards
+    bool has_transit = false;
+    int64_t last_transit_us = 0;       // Arrival minus mapped wall clock
+    double jitter_us = 0;              // RFC 3550 interarrival jitter estimate
+  };
+
+  struct Input {
+    FormatContext* format = nullptr;
+    AVFormatContext* ctx = nullptr;
+    Napi::ObjectReference ref;
+    int base = 0;                   // First output stream index
+    std::vector<StreamClock> streams;
+    std::thread thread;
+
+    // Clock mapping (reader thread, read by getStats under stats_mutex_)
+    bool anchored = false;
+    bool realtime = false;
+    int64_t offset_us = 0;          // Timeline = input timestamp + offset_us
+    double jitter_us = 0;
+    double max_jitter_us = 0;
+    uint64_t packets = 0;
+    bool eof = false;
+    int error = 0;
+  };
+
+  static Napi::FunctionReference constructor;
+
+  // Static methods
+  static Napi::Value Create(const Napi::CallbackInfo& info);
+
+  // Instance methods
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Receive(const Napi::CallbackInfo& info);
+  Napi::Value ReceiveAsync(const Napi::CallbackInfo& info);
+  Napi::Value StopAsync(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value GetStreamCount(const Napi::CallbackInfo& info);
+
+  // Reader threads
+  void Run(size_t index);
+  void Map(Input& input, AVPacket* pkt);
+  void FinishInput(Input& input, int ret);
+
+  // Main thread
+  int ReceiveInto(AVPacket* pkt);
+  void SettleReceive();
+  void EnsureTsfn(Napi::Env env);
+  void ReleaseJs();
+  void WakeJs();
+  void Stop();
+
+  std::vector<std::unique_ptr<Input>> inputs_;
+  int nb_streams_ = 0;
+  int64_t origin_us_ = 0;           // Wall clock at start(), timeline zero
+  size_t max_queued_ = 0;
+
+  // Sync queue, shared by all threads
+  ::SyncQueue* sq_ = nullptr;
+  std::mutex sq_mutex_;
+  std::condition_variable space_cv_;
+  size_t queued_ = 0;
+  int inputs_done_ = 0;
+
+  std::mutex stats_mutex_;
+  std::atomic<bool> abort_{false};
+  bool started_ = false;
+
+  // JS wakeups (pending receiveAsync)
+  Napi::ThreadSafeFunction tsfn_;
+  bool has_tsfn_ = false;
+  Napi::ObjectReference self_ref_;
+  std::atomic<bool> js_waiting_{false};
+  Napi::ObjectReference receive_target_;
+  std::unique_ptr<Napi::Promise::Deferred> receive_deferred_;
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_INPUT_SYNCHRONIZER_H
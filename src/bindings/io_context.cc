@@ -13,6 +13,10 @@ Napi::Object IOContext::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "IOContext", {
     InstanceMethod<&IOContext::AllocContext>("allocContext"),
     InstanceMethod<&IOContext::AllocContextWithCallbacks>("allocContextWithCallbacks"),
+    InstanceMethod<&IOContext::AllocContextRtpSink>("allocContextRtpSink"),
+    InstanceMethod<&IOContext::AllocContextMmap>("allocContextMmap"),
+    InstanceMethod<&IOContext::FlushRtpSink>("flushRtpSink"),
+    InstanceMethod<&IOContext::GetRtpSinkStats>("getRtpSinkStats"),
     InstanceMethod<&IOContext::FreeContext>("freeContext"),
     InstanceMethod<&IOContext::Open2Async>("open2"),
     InstanceMethod<&IOContext::Open2Sync>("open2Sync"),
@@ -60,6 +64,7 @@ IOContext::IOContext(const Napi::CallbackInfo& info)
 IOContext::~IOContext() {
   // Clean up callbacks first
   CleanupCallbacks();
+  rtp_sink_.reset();
   
   // Don't automatically free anything in destructor
   // The user must explicitly call freeContext() or closep()
@@ -74,6 +79,7 @@ IOContext::~IOContext() {
   // Clear pointers without freeing
   ctx_ = nullptr;
   buffer_ = nullptr;
+  account_.Release(Env());
 }
 
 int IOContext::ReadPacket(void* opaque, uint8_t* buf, int buf_size) {
@@ -352,6 +358,7 @@ Napi::Value IOContext::AllocContext(const Napi::CallbackInfo& info) {
   }
   
   ctx_ = new_ctx;
+  TrackMemory();
   return env.Undefined();
 }
 
@@ -464,14 +471,191 @@ Napi::Value IOContext::AllocContextWithCallbacks(const Napi::CallbackInfo& info)
   }
   
   ctx_ = new_ctx;
+  TrackMemory();
   return env.Undefined();
 }
 
+Napi::Value IOContext::AllocContextRtpSink(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Parameters: bufferSize, options, callback(slab, offsets)
+  // The callback is optional when options.udp is set
+  if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Expected (bufferSize, options, callback)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int buffer_size = info[0].As<Napi::Number>().Int32Value();
+  Napi::Object optionsObj = info[1].As<Napi::Object>();
+
+  RtpSinkOptions options;
+  if (!RtpSink::ParseOptions(optionsObj, options)) {
+    Napi::RangeError::New(env, "Invalid RTP sink options").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::unique_ptr<UdpSender> sender;
+  Napi::Value udp = optionsObj.Get("udp");
+  if (udp.IsObject()) {
+    UdpSenderOptions udpOptions;
+    if (!UdpSender::ParseOptions(udp.As<Napi::Object>(), udpOptions)) {
+      Napi::TypeError::New(env, "udp requires address (string) and port (number)").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    std::string error;
+    sender = UdpSender::Create(udpOptions, error);
+    if (!sender) {
+      Napi::Error::New(env, error).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  Napi::Function callback;
+  if (info.Length() > 2 && info[2].IsFunction()) {
+    callback = info[2].As<Napi::Function>();
+  } else if (!sender) {
+    Napi::TypeError::New(env, "Expected callback function or udp destination").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (buffer_) {
+    av_free(buffer_);
+  }
+  buffer_ = (uint8_t*)av_malloc(buffer_size);
+  if (!buffer_) {
+    Napi::Error::New(env, "Failed to allocate buffer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CleanupCallbacks();
+  rtp_sink_ = std::make_unique<RtpSink>(env, options, callback, std::move(sender));
+
+  // Write-only context, every flush of the RTP muxer is one datagram
+  AVIOContext* new_ctx = avio_alloc_context(
+    buffer_,
+    buffer_size,
+    1,
+    rtp_sink_.get(),
+    nullptr,
+    RtpSink::WritePacket,
+    nullptr
+  );
+
+  if (!new_ctx) {
+    av_free(buffer_);
+    buffer_ = nullptr;
+    rtp_sink_.reset();
+    Napi::Error::New(env, "Failed to allocate AVIOContext for RTP sink").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (ctx_) {
+    avio_context_free(&ctx_);
+  }
+
+  ctx_ = new_ctx;
+  TrackMemory();
+  return env.Undefined();
+}
+
+Napi::Value IOContext::AllocContextMmap(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Parameters: path, bufferSize
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Expected (path, bufferSize?)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  int buffer_size = 32768;
+  if (info.Length() > 1 && info[1].IsNumber()) {
+    buffer_size = info[1].As<Napi::Number>().Int32Value();
+  }
+
+  std::string error;
+  std::unique_ptr<MmapSource> source = MmapSource::Open(path, error);
+  if (!source) {
+    Napi::Error::New(env, error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (buffer_) {
+    av_free(buffer_);
+  }
+  buffer_ = (uint8_t*)av_malloc(buffer_size);
+  if (!buffer_) {
+    Napi::Error::New(env, "Failed to allocate buffer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CleanupCallbacks();
+
+  // Read-only context served from the mapping
+  AVIOContext* new_ctx = avio_alloc_context(
+    buffer_,
+    buffer_size,
+    0,
+    source.get(),
+    MmapSource::ReadPacket,
+    nullptr,
+    MmapSource::Seek
+  );
+
+  if (!new_ctx) {
+    av_free(buffer_);
+    buffer_ = nullptr;
+    Napi::Error::New(env, "Failed to allocate AVIOContext for mapped file").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Large reads bypass the buffer and copy straight from the mapping
+  new_ctx->direct = 1;
+
+  if (ctx_) {
+    avio_context_free(&ctx_);
+  }
+
+  ctx_ = new_ctx;
+  mmap_source_ = std::move(source);
+  TrackMemory();
+  return env.Undefined();
+}
+
+Napi::Value IOContext::FlushRtpSink(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (rtp_sink_) {
+    if (ctx_) {
+      avio_flush(ctx_);
+    }
+    rtp_sink_->Flush();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value IOContext::GetRtpSinkStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!rtp_sink_) {
+    return env.Null();
+  }
+
+  return rtp_sink_->GetStats(env);
+}
+
 Napi::Value IOContext::FreeContext(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   
   // Clean up callbacks first if they exist
   CleanupCallbacks();
+
+  // Hand out datagrams still pending in the RTP sink
+  if (rtp_sink_) {
+    rtp_sink_->Flush();
+    rtp_sink_->Release();
+  }
   
   if (ctx_) {
     // avio_context_free will also free the buffer
@@ -479,6 +663,12 @@ Napi::Value IOContext::FreeContext(const Napi::CallbackInfo& info) {
     ctx_ = nullptr;
     buffer_ = nullptr;  // Buffer was freed by avio_context_free
   }
+  TrackMemory();
+
+  // Unmap only after the context that reads from it is gone
+  mmap_source_.reset();
+
+  // The released RTP sink is kept until destruction so its final statistics stay readable
   
   return env.Undefined();
 }
@@ -619,6 +809,7 @@ Napi::Value IOContext::AsyncDispose(const Napi::CallbackInfo& info) {
       avio_context_free(&ctx_);
       ctx_ = nullptr;
     }
+    TrackMemory();
     
     // Return resolved promise
     auto deferred = Napi::Promise::Deferred::New(env);
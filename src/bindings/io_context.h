@@ -6,6 +6,9 @@
 #include <atomic>
 #include <thread>
 #include "common.h"
+#include "rtp_sink.h"
+#include "mmap_source.h"
+#include "memory_accounting.h"
 
 extern "C" {
 #include <libavformat/avio.h>
@@ -22,6 +25,14 @@ public:
 
   AVIOContext* Get() { return ctx_; }
 
+  // I/O buffer bytes for memory accounting; call where ctx_ was just
+  // allocated, opened or freed by this wrapper
+  void TrackMemory() {
+    if (account_.Active()) {
+      account_.Update(Env(), ctx_ ? ctx_->buffer_size : 0);
+    }
+  }
+
   Napi::Value FreeContext(const Napi::CallbackInfo& info);
   Napi::Value ClosepAsync(const Napi::CallbackInfo& info);
   Napi::Value ClosepSync(const Napi::CallbackInfo& info);
@@ -56,6 +67,9 @@ public:
   Napi::Value GetBufferSize(const Napi::CallbackInfo& info);
 
   Napi::Value GetWriteFlag(const Napi::CallbackInfo& info);
+
+  Napi::Value FlushRtpSink(const Napi::CallbackInfo& info);
+  Napi::Value GetRtpSinkStats(const Napi::CallbackInfo& info);
   
   // Static members  
   static Napi::FunctionReference constructor;
@@ -95,6 +109,14 @@ private:
   
   std::unique_ptr<CallbackData> callback_data_;
   uint8_t* buffer_ = nullptr;  // Buffer for custom I/O
+
+  // Native RTP output sink (replaces the JS write callback)
+  std::unique_ptr<RtpSink> rtp_sink_;
+
+  // Memory-mapped input file (replaces the file protocol)
+  std::unique_ptr<MmapSource> mmap_source_;
+
+  MemoryAccounting::Account account_{MemoryAccounting::kIOContext};
   
   // Helper to clean up callbacks
   void CleanupCallbacks();
@@ -106,6 +128,8 @@ private:
   
   Napi::Value AllocContext(const Napi::CallbackInfo& info);
   Napi::Value AllocContextWithCallbacks(const Napi::CallbackInfo& info);
+  Napi::Value AllocContextRtpSink(const Napi::CallbackInfo& info);
+  Napi::Value AllocContextMmap(const Napi::CallbackInfo& info);
   Napi::Value Open2Async(const Napi::CallbackInfo& info);
   Napi::Value Open2Sync(const Napi::CallbackInfo& info);
   Napi::Value AsyncDispose(const Napi::CallbackInfo& info);
@@ -1,4 +1,5 @@
 #include "io_context.h"
+#include "tracing.h"
 #include <napi.h>
 #include <libavformat/avio.h>
 
@@ -23,6 +24,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("IOOpen2Worker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_) {
       ret_ = AVERROR(EINVAL);
@@ -41,6 +44,7 @@ public:
   }
 
   void OnOK() override {
+    ctx_->TrackMemory();
     deferred_.Resolve(Napi::Number::New(Env(), ret_));
   }
 
@@ -77,6 +81,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("IOClosepWorker", "worker", ctx_);
+
     AVIOContext* ctx = ctx_->Get();
     if (ctx) {
       // Mark callbacks as inactive to prevent further calls
@@ -95,6 +101,7 @@ public:
   void OnOK() override {
     // Clean up callbacks on the main thread after closep succeeds
     ctx_->CleanupCallbacks();
+    ctx_->TrackMemory();
     deferred_.Resolve(Napi::Number::New(Env(), ret_));
   }
 
@@ -131,6 +138,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("IOReadWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_) {
       bytes_read_ = AVERROR(EINVAL);
@@ -193,6 +202,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("IOWriteWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_) {
       return;
@@ -244,6 +255,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("IOSeekWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_) {
       new_pos_ = AVERROR(EINVAL);
@@ -296,6 +309,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("IOSizeWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_) {
       size_ = AVERROR(EINVAL);
@@ -345,6 +360,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("IOFlushWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_) {
       return;
@@ -393,6 +410,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("IOSkipWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_) {
       new_pos_ = AVERROR(EINVAL);
@@ -28,6 +28,7 @@ Napi::Value IOContext::Open2Sync(const Napi::CallbackInfo& info) {
 
   // Store the newly opened context
   ctx_ = avio_ctx;
+  TrackMemory();
 
   return Napi::Number::New(env, 0);
 }
@@ -130,6 +131,7 @@ Napi::Value IOContext::ClosepSync(const Napi::CallbackInfo& info) {
 
   // Update internal state
   ctx_ = nullptr;
+  TrackMemory();
 
   // Clean up callbacks on the main thread
   CleanupCallbacks();
@@ -0,0 +1,78 @@
+#include "lazy_exports.h"
+#include <mutex>
+
+extern "C" {
+#include <libavdevice/avdevice.h>
+}
+
+namespace ffmpeg {
+
+void LazyExports::Attach(Napi::Env env, Napi::Object exports) {
+  State* state = new State();
+  state->exports = Napi::Persistent(exports);
+  env.SetInstanceData<State>(state);
+}
+
+void LazyExports::Define(Napi::Env env, std::initializer_list<const char*> names, InitFn init) {
+  State* state = env.GetInstanceData<State>();
+  Napi::Object exports = state->exports.Value();
+
+  state->entries.push_back({names, init});
+  Entry& entry = state->entries.back();
+
+  for (const char* name : names) {
+    state->names.push_back({&entry, name});
+    exports.DefineProperty(Napi::PropertyDescriptor::Accessor<&LazyExports::Get>(
+        name, static_cast<napi_property_attributes>(napi_enumerable | napi_configurable), &state->names.back()));
+  }
+}
+
+void LazyExports::Ensure(Napi::Env env, InitFn init) {
+  State* state = env.GetInstanceData<State>();
+  if (!state) {
+    return;
+  }
+
+  for (Entry& entry : state->entries) {
+    if (entry.init == init && !entry.registered) {
+      Register(env, entry, state->exports.Value(), nullptr);
+    }
+  }
+}
+
+void LazyExports::EnsureDevices() {
+  static std::once_flag once;
+  std::call_once(once, [] { avdevice_register_all(); });
+}
+
+void LazyExports::Register(Napi::Env env, Entry& entry, Napi::Object exports, Napi::Object* values) {
+  entry.registered = true;
+
+  Napi::Object scratch = Napi::Object::New(env);
+  entry.init(env, scratch);
+
+  for (const char* name : entry.names) {
+    exports.DefineProperty(Napi::PropertyDescriptor::Value(name, scratch.Get(name), napi_default_jsproperty));
+  }
+
+  if (values) {
+    *values = scratch;
+  }
+}
+
+Napi::Value LazyExports::Get(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Name* name = static_cast<Name*>(info.Data());
+  State* state = env.GetInstanceData<State>();
+
+  if (name->entry->registered) {
+    // Registered by Ensure() after this getter was looked up
+    return state->exports.Value().Get(name->name);
+  }
+
+  Napi::Object values;
+  Register(env, *name->entry, state->exports.Value(), &values);
+  return values.Get(name->name);
+}
+
+} // namespace ffmpeg
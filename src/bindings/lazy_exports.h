@@ -0,0 +1,55 @@
+#ifndef FFMPEG_LAZY_EXPORTS_H
+#define FFMPEG_LAZY_EXPORTS_H
+
+#include <napi.h>
+#include <deque>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace ffmpeg {
+
+// Module exports that are registered on first use instead of at load time.
+//
+// Define() installs a configurable getter per export name. The first read of
+// any of the names runs the subsystem's Init into a scratch object and
+// replaces the getters with the plain values, so later reads are ordinary
+// property reads. Native code that needs a lazily registered class (e.g. to
+// wrap an FFmpeg object) calls Ensure() first.
+class LazyExports {
+public:
+  using InitFn = Napi::Object (*)(Napi::Env env, Napi::Object exports);
+
+  static void Attach(Napi::Env env, Napi::Object exports);
+  static void Define(Napi::Env env, std::initializer_list<const char*> names, InitFn init);
+  static void Ensure(Napi::Env env, InitFn init);
+
+  // Registers libavdevice formats (avfoundation, dshow, v4l2, lavfi...) once,
+  // before the first lookup of a format by name
+  static void EnsureDevices();
+
+private:
+  struct Entry {
+    std::vector<const char*> names;
+    InitFn init;
+    bool registered = false;
+  };
+
+  struct Name {
+    Entry* entry;
+    const char* name;
+  };
+
+  struct State {
+    Napi::ObjectReference exports;
+    std::deque<Entry> entries;
+    std::deque<Name> names;
+  };
+
+  static void Register(Napi::Env env, Entry& entry, Napi::Object exports, Napi::Object* values);
+  static Napi::Value Get(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_LAZY_EXPORTS_H
@@ -0,0 +1,91 @@
+#include "leak_detector.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace ffmpeg {
+
+std::atomic<bool> LeakDetector::enabled_{false};
+
+namespace {
+
+struct SiteStats {
+  int64_t allocated = 0;
+  int64_t freed = 0;
+  int64_t leaked = 0;
+  int64_t leaked_bytes = 0;
+};
+
+// Only touched in debug mode; finalizers of all environments report here
+std::mutex sites_mutex;
+std::unordered_map<int32_t, SiteStats> sites;
+
+} // namespace
+
+void LeakDetector::Allocated(int32_t site) {
+  std::lock_guard<std::mutex> lock(sites_mutex);
+  sites[site].allocated++;
+}
+
+void LeakDetector::Freed(int32_t site) {
+  std::lock_guard<std::mutex> lock(sites_mutex);
+  sites[site].freed++;
+}
+
+void LeakDetector::Leaked(int32_t site, int64_t bytes) {
+  std::lock_guard<std::mutex> lock(sites_mutex);
+  SiteStats& stats = sites[site];
+  stats.leaked++;
+  stats.leaked_bytes += bytes;
+}
+
+void LeakDetector::Moved(int32_t from, int32_t to) {
+  std::lock_guard<std::mutex> lock(sites_mutex);
+  sites[from].allocated--;
+  sites[to].allocated++;
+}
+
+Napi::Object LeakDetector::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setLeakDetection", Napi::Function::New(env, SetEnabled));
+  exports.Set("getLeakDetectionSites", Napi::Function::New(env, GetSites));
+  exports.Set("resetLeakDetection", Napi::Function::New(env, Reset));
+  return exports;
+}
+
+Napi::Value LeakDetector::SetEnabled(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsBoolean()) {
+    Napi::TypeError::New(env, "Enabled (boolean) required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  enabled_.store(info[0].As<Napi::Boolean>().Value(), std::memory_order_relaxed);
+  return env.Undefined();
+}
+
+// getLeakDetectionSites() -> [{ site, allocated, freed, leaked, leakedBytes }]
+Napi::Value LeakDetector::GetSites(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(sites_mutex);
+  Napi::Array result = Napi::Array::New(env, sites.size());
+  uint32_t index = 0;
+  for (const auto& [site, stats] : sites) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("site", Napi::Number::New(env, site));
+    obj.Set("allocated", Napi::Number::New(env, static_cast<double>(stats.allocated)));
+    obj.Set("freed", Napi::Number::New(env, static_cast<double>(stats.freed)));
+    obj.Set("leaked", Napi::Number::New(env, static_cast<double>(stats.leaked)));
+    obj.Set("leakedBytes", Napi::Number::New(env, static_cast<double>(stats.leaked_bytes)));
+    result.Set(index++, obj);
+  }
+  return result;
+}
+
+Napi::Value LeakDetector::Reset(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(sites_mutex);
+  sites.clear();
+  return info.Env().Undefined();
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,38 @@
+#ifndef FFMPEG_LEAK_DETECTOR_H
+#define FFMPEG_LEAK_DETECTOR_H
+
+#include <napi.h>
+#include <atomic>
+#include <cstdint>
+
+namespace ffmpeg {
+
+// Debug aid that finds Packet/Frame wrappers which are never freed.
+//
+// While enabled, the JS wrappers tag each allocated packet or frame with an
+// allocation site id (an interned stack trace, kept on the JS side). Explicit
+// free()/dispose clears the tag; a wrapper that still holds its AVPacket or
+// AVFrame when the GC finalizes it is counted as leaked for its site, along
+// with the buffer bytes it kept alive until then.
+class LeakDetector {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  static void Allocated(int32_t site);
+  static void Freed(int32_t site);
+  static void Leaked(int32_t site, int64_t bytes);
+  static void Moved(int32_t from, int32_t to);
+
+private:
+  static std::atomic<bool> enabled_;
+
+  static Napi::Value SetEnabled(const Napi::CallbackInfo& info);
+  static Napi::Value GetSites(const Napi::CallbackInfo& info);
+  static Napi::Value Reset(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_LEAK_DETECTOR_H
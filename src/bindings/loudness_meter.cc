@@ -0,0 +1,453 @@
+#include "loudness_meter.h"
+#include "frame.h"
+#include "sample_convert.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+extern "C" {
+#include <libavutil/channel_layout.h>
+#include <libavutil/error.h>
+#include <libavutil/mathematics.h>
+#include <libavutil/samplefmt.h>
+}
+
+namespace ffmpeg {
+
+// Interpolation filter taps per phase for true peak
+static constexpr int TRUE_PEAK_TAPS = 12;
+
+// Channels weighted +1.5 dB (BS.1770 surround channels)
+static constexpr uint64_t SURROUND_MASK =
+    AV_CH_BACK_LEFT | AV_CH_BACK_CENTER | AV_CH_BACK_RIGHT |
+    AV_CH_TOP_BACK_LEFT | AV_CH_TOP_BACK_CENTER | AV_CH_TOP_BACK_RIGHT |
+    AV_CH_SIDE_LEFT | AV_CH_SIDE_RIGHT |
+    AV_CH_SURROUND_DIRECT_LEFT | AV_CH_SURROUND_DIRECT_RIGHT;
+
+Napi::FunctionReference LoudnessMeter::constructor;
+
+namespace {
+
+constexpr double kNegInf = -std::numeric_limits<double>::infinity();
+
+inline double EnergyToLufs(double energy) {
+  return energy > 0 ? -0.691 + 10.0 * std::log10(energy) : kNegInf;
+}
+
+inline double AmplitudeToDb(double value) {
+  return value > 0 ? 20.0 * std::log10(value) : kNegInf;
+}
+
+} // namespace
+
+void LoudnessMeter::Histogram::Add(double energy_value) {
+  double lufs = EnergyToLufs(energy_value);
+  // Absolute gate
+  if (!(lufs >= -70.0)) {
+    return;
+  }
+  int bin = std::min(static_cast<int>((lufs + 70.0) * 10.0), kBins - 1);
+  count[bin]++;
+  energy[bin] += energy_value;
+  total++;
+  total_energy += energy_value;
+}
+
+void LoudnessMeter::Histogram::Clear() {
+  std::fill(std::begin(count), std::end(count), 0);
+  std::fill(std::begin(energy), std::end(energy), 0.0);
+  total = 0;
+  total_energy = 0;
+}
+
+Napi::Object LoudnessMeter::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "LoudnessMeter", {
+    StaticMethod<&LoudnessMeter::Create>("create"),
+
+    InstanceMethod<&LoudnessMeter::Measure>("measure"),
+    InstanceMethod<&LoudnessMeter::GetValues>("getValues"),
+    InstanceMethod<&LoudnessMeter::Reset>("reset"),
+    InstanceMethod<&LoudnessMeter::ResetPeaks>("resetPeaks"),
+
+    InstanceAccessor<&LoudnessMeter::GetChannels>("channels"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("LoudnessMeter", func);
+  return exports;
+}
+
+LoudnessMeter::LoudnessMeter(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<LoudnessMeter>(info) {
+  // Created via LoudnessMeter.create()
+}
+
+Napi::Value LoudnessMeter::Create(const Napi::CallbackInfo& info) {
+  Napi::Object obj = constructor.New({});
+  LoudnessMeter* meter = Napi::ObjectWrap<LoudnessMeter>::Unwrap(obj);
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Value v = info[0].As<Napi::Object>().Get("truePeak");
+    if (v.IsBoolean()) {
+      meter->true_peak_enabled_ = v.As<Napi::Boolean>().Value();
+    }
+  }
+
+  return obj;
+}
+
+int LoudnessMeter::Configure(const AVFrame* frame) {
+  if (frame->sample_rate <= 0 || frame->ch_layout.nb_channels <= 0) {
+    return AVERROR(EINVAL);
+  }
+
+  sample_rate_ = frame->sample_rate;
+  channels_ = frame->ch_layout.nb_channels;
+  block_size_ = std::max(sample_rate_ / 10, 1);
+
+  // K-weighting: high shelf pre-filter and RLB high-pass, for any sample rate
+  double f0 = 1681.974450955533;
+  double gain = 3.999843853973347;
+  double q = 0.7071752369554196;
+  double k = std::tan(M_PI * f0 / sample_rate_);
+  double vh = std::pow(10.0, gain / 20.0);
+  double vb = std::pow(vh, 0.4996667741545416);
+  double a0 = 1.0 + k / q + k * k;
+  pre_ = {
+    (vh + vb * k / q + k * k) / a0,
+    2.0 * (k * k - vh) / a0,
+    (vh - vb * k / q + k * k) / a0,
+    2.0 * (k * k - 1.0) / a0,
+    (1.0 - k / q + k * k) / a0,
+  };
+
+  f0 = 38.13547087602444;
+  q = 0.5003270373238773;
+  k = std::tan(M_PI * f0 / sample_rate_);
+  a0 = 1.0 + k / q + k * k;
+  rlb_ = {1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+
+  // True peak interpolation filter, one normalized phase per output sample
+  oversample_ = !true_peak_enabled_ || sample_rate_ >= 192000 ? 1 : sample_rate_ >= 96000 ? 2 : 4;
+  taps_ = oversample_ > 1 ? TRUE_PEAK_TAPS : 0;
+  phases_.assign(static_cast<size_t>(oversample_) * taps_, 0.0f);
+  if (oversample_ > 1) {
+    int n_total = oversample_ * taps_;
+    double center = (n_total - 1) / 2.0;
+    std::vector<double> h(n_total);
+    for (int n = 0; n < n_total; n++) {
+      double t = (n - center) / oversample_;
+      double sinc = t == 0 ? 1.0 : std::sin(M_PI * t) / (M_PI * t);
+      double window = 0.42 - 0.5 * std::cos(2 * M_PI * n / (n_total - 1)) + 0.08 * std::cos(4 * M_PI * n / (n_total - 1));
+      h[n] = sinc * window;
+    }
+    for (int p = 0; p < oversample_; p++) {
+      double sum = 0;
+      for (int j = 0; j < taps_; j++) sum += h[j * oversample_ + p];
+      for (int i = 0; i < taps_; i++) {
+        phases_[p * taps_ + i] = static_cast<float>(h[(taps_ - 1 - i) * oversample_ + p] / sum);
+      }
+    }
+  }
+
+  state_.assign(channels_, Channel());
+  for (int c = 0; c < channels_; c++) {
+    Channel& ch = state_[c];
+    AVChannel id = av_channel_layout_channel_from_index(&frame->ch_layout, c);
+    if (id == AV_CHAN_LOW_FREQUENCY || id == AV_CHAN_LOW_FREQUENCY_2) {
+      ch.weight = 0.0;
+    } else if (id >= 0 && id < 64 && (SURROUND_MASK & (1ULL << id))) {
+      ch.weight = 1.41;
+    }
+    ch.history.assign(taps_ > 0 ? taps_ - 1 : 0, 0.0f);
+  }
+
+  block_fill_ = 0;
+  blocks_ = 0;
+  std::fill(std::begin(block_energy_), std::end(block_energy_), 0.0);
+  integrated_.Clear();
+  short_term_.Clear();
+  return 0;
+}
+
+void LoudnessMeter::ProcessChunk(const AVFrame* frame, int offset, int count) {
+  const AVSampleFormat format = static_cast<AVSampleFormat>(frame->format);
+  const AVSampleFormat packed = av_get_packed_sample_fmt(format);
+  const bool planar = av_sample_fmt_is_planar(format);
+  const size_t n = static_cast<size_t>(count);
+  scratch_.resize(n);
+
+  for (int c = 0; c < channels_; c++) {
+    Channel& ch = state_[c];
+    const uint8_t* data = planar ? frame->extended_data[c] : frame->extended_data[0];
+    size_t index = planar ? offset : static_cast<size_t>(offset) * channels_ + c;
+    SamplesToDouble(scratch_.data(), data, packed, index, planar ? 1 : channels_, n);
+    const double* x = scratch_.data();
+
+    // Level and sample peak as separate reductions. The pragmas (honored with
+    // -fopenmp-simd) allow vector partial sums and a vector max; without them
+    // the sum stays in source order and the peak loop is not vectorized
+    double raw = 0;
+#pragma omp simd reduction(+:raw)
+    for (size_t i = 0; i < n; i++) {
+      raw += x[i] * x[i];
+    }
+    double peak = 0;
+#pragma omp simd reduction(max:peak)
+    for (size_t i = 0; i < n; i++) {
+      double a = std::fabs(x[i]);
+      peak = a > peak ? a : peak;
+    }
+    ch.block_raw += raw;
+    ch.sample_peak = std::max(ch.sample_peak, static_cast<float>(peak));
+
+    // K-weighted energy; the recursion is serial, skipped for the LFE
+    if (ch.weight != 0.0) {
+      double s10 = ch.s1[0], s11 = ch.s1[1];
+      double s20 = ch.s2[0], s21 = ch.s2[1];
+      double weighted = 0;
+      for (size_t i = 0; i < n; i++) {
+        double y1 = pre_.b0 * x[i] + s10;
+        s10 = pre_.b1 * x[i] - pre_.a1 * y1 + s11;
+        s11 = pre_.b2 * x[i] - pre_.a2 * y1;
+        double y2 = rlb_.b0 * y1 + s20;
+        s20 = rlb_.b1 * y1 - rlb_.a1 * y2 + s21;
+        s21 = rlb_.b2 * y1 - rlb_.a2 * y2;
+        weighted += y2 * y2;
+      }
+      ch.s1[0] = s10;
+      ch.s1[1] = s11;
+      ch.s2[0] = s20;
+      ch.s2[1] = s21;
+      ch.block_weighted += weighted;
+    }
+
+    if (!true_peak_enabled_) {
+      continue;
+    }
+    if (oversample_ == 1) {
+      ch.true_peak = std::max(ch.true_peak, ch.sample_peak);
+      continue;
+    }
+
+    // True peak: dot product of each phase with the last taps_ samples
+    const size_t keep = static_cast<size_t>(taps_ - 1);
+    tp_buffer_.resize(keep + n);
+    std::copy(ch.history.begin(), ch.history.end(), tp_buffer_.begin());
+    for (size_t i = 0; i < n; i++) {
+      tp_buffer_[keep + i] = static_cast<float>(x[i]);
+    }
+
+    // The dot product has a compile-time trip count (taps_ is always
+    // TRUE_PEAK_TAPS here) and a simd reduction, so with -fopenmp-simd it is
+    // computed in vector partial sums. Without the pragma (MSVC) the sum is
+    // a scalar loop in source order.
+    float tp = ch.true_peak;
+    for (size_t i = 0; i < n; i++) {
+      const float* window = &tp_buffer_[i];
+      for (int p = 0; p < oversample_; p++) {
+        const float* coeffs = &phases_[static_cast<size_t>(p) * TRUE_PEAK_TAPS];
+        float acc = 0;
+#pragma omp simd reduction(+:acc)
+        for (int j = 0; j < TRUE_PEAK_TAPS; j++) {
+          acc += coeffs[j] * window[j];
+        }
+        tp = std::max(tp, std::fabs(acc));
+      }
+    }
+    ch.true_peak = std::max(tp, ch.sample_peak);
+    std::copy(tp_buffer_.end() - keep, tp_buffer_.end(), ch.history.begin());
+  }
+}
+
+void LoudnessMeter::FinishBlock() {
+  double energy = 0;
+  for (Channel& ch : state_) {
+    energy += ch.weight * ch.block_weighted;
+    ch.raw_blocks[blocks_ % 4] = ch.block_raw;
+    ch.block_weighted = 0;
+    ch.block_raw = 0;
+  }
+  block_energy_[blocks_ % 30] = energy / block_size_;
+  blocks_++;
+  block_fill_ = 0;
+
+  // 400 ms gating blocks with 75% overlap, short-term values at 10 Hz
+  if (blocks_ >= 4) {
+    integrated_.Add(MeanOfLast(4));
+  }
+  if (blocks_ >= 30) {
+    short_term_.Add(MeanOfLast(30));
+  }
+}
+
+double LoudnessMeter::MeanOfLast(int n) const {
+  double sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += block_energy_[(blocks_ - 1 - i) % 30];
+  }
+  return sum / n;
+}
+
+double LoudnessMeter::Integrated() const {
+  const Histogram& h = integrated_;
+  if (h.total == 0) {
+    return kNegInf;
+  }
+
+  // Relative gate: 10 LU below the loudness of the absolute-gated blocks
+  double relative = EnergyToLufs(h.total_energy / h.total) - 10.0;
+  int start = std::max(static_cast<int>(std::floor((relative + 70.0) * 10.0)), 0);
+
+  uint64_t count = 0;
+  double energy = 0;
+  for (int i = start; i < Histogram::kBins; i++) {
+    count += h.count[i];
+    energy += h.energy[i];
+  }
+  return count > 0 ? EnergyToLufs(energy / count) : kNegInf;
+}
+
+double LoudnessMeter::Range() const {
+  const Histogram& h = short_term_;
+  if (h.total == 0) {
+    return 0;
+  }
+
+  // Relative gate 20 LU, then the spread between the 10th and 95th percentile
+  double relative = EnergyToLufs(h.total_energy / h.total) - 20.0;
+  int start = std::max(static_cast<int>(std::floor((relative + 70.0) * 10.0)), 0);
+
+  uint64_t count = 0;
+  for (int i = start; i < Histogram::kBins; i++) {
+    count += h.count[i];
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  uint64_t low_rank = static_cast<uint64_t>(0.10 * (count - 1));
+  uint64_t high_rank = static_cast<uint64_t>(0.95 * (count - 1));
+  int low = start, high = start;
+  uint64_t seen = 0;
+  for (int i = start; i < Histogram::kBins; i++) {
+    if (h.count[i] == 0) continue;
+    if (seen <= low_rank) low = i;
+    if (seen <= high_rank) high = i;
+    seen += h.count[i];
+  }
+  return (high - low) / 10.0;
+}
+
+Napi::Value LoudnessMeter::Measure(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  const AVFrame* f = frame ? frame->Get() : nullptr;
+  if (!f) {
+    Napi::TypeError::New(env, "Expected a Frame").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  if (f->nb_samples <= 0 || !f->extended_data || !f->extended_data[0] ||
+      !IsConvertibleSampleFormat(av_get_packed_sample_fmt(static_cast<AVSampleFormat>(f->format)))) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  if (channels_ == 0) {
+    int ret = Configure(f);
+    if (ret < 0) {
+      return Napi::Number::New(env, ret);
+    }
+  } else if (f->sample_rate != sample_rate_ || f->ch_layout.nb_channels != channels_) {
+    return Napi::Number::New(env, AVERROR_INPUT_CHANGED);
+  }
+
+  int offset = 0;
+  while (offset < f->nb_samples) {
+    int count = std::min(f->nb_samples - offset, block_size_ - block_fill_);
+    ProcessChunk(f, offset, count);
+    offset += count;
+    block_fill_ += count;
+    if (block_fill_ == block_size_) {
+      FinishBlock();
+    }
+  }
+
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value LoudnessMeter::GetValues(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  size_t length = kHeaderValues + kChannelValues * channels_;
+  Napi::Float64Array out;
+  if (info.Length() > 0 && !info[0].IsNull() && !info[0].IsUndefined()) {
+    if (!info[0].IsTypedArray() || info[0].As<Napi::TypedArray>().TypedArrayType() != napi_float64_array ||
+        info[0].As<Napi::TypedArray>().ElementLength() < length) {
+      Napi::TypeError::New(env, "Output must be a Float64Array of at least 6 + 3 * channels values").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    out = info[0].As<Napi::Float64Array>();
+  } else {
+    out = Napi::Float64Array::New(env, length);
+  }
+  double* values = out.Data();
+
+  double sample_peak = 0;
+  double true_peak = 0;
+  for (int c = 0; c < channels_; c++) {
+    const Channel& ch = state_[c];
+    sample_peak = std::max(sample_peak, static_cast<double>(ch.sample_peak));
+    true_peak = std::max(true_peak, static_cast<double>(ch.true_peak));
+
+    // RMS over the last 400 ms
+    uint64_t blocks = std::min<uint64_t>(blocks_, 4);
+    double raw = 0;
+    for (uint64_t b = 0; b < blocks; b++) {
+      raw += ch.raw_blocks[b];
+    }
+    double mean_square = blocks > 0 ? raw / (static_cast<double>(blocks) * block_size_) : 0;
+
+    double* channel = values + kHeaderValues + kChannelValues * c;
+    channel[0] = mean_square > 0 ? 10.0 * std::log10(mean_square) : kNegInf;
+    channel[1] = AmplitudeToDb(ch.sample_peak);
+    channel[2] = true_peak_enabled_ ? AmplitudeToDb(ch.true_peak) : NAN;
+  }
+
+  values[0] = blocks_ >= 4 ? EnergyToLufs(MeanOfLast(4)) : kNegInf;
+  values[1] = blocks_ >= 30 ? EnergyToLufs(MeanOfLast(30)) : kNegInf;
+  values[2] = Integrated();
+  values[3] = Range();
+  values[4] = AmplitudeToDb(sample_peak);
+  values[5] = true_peak_enabled_ ? AmplitudeToDb(true_peak) : NAN;
+
+  return out;
+}
+
+Napi::Value LoudnessMeter::Reset(const Napi::CallbackInfo& info) {
+  // Reconfigured from the next frame
+  sample_rate_ = 0;
+  channels_ = 0;
+  state_.clear();
+  block_fill_ = 0;
+  blocks_ = 0;
+  integrated_.Clear();
+  short_term_.Clear();
+  return info.Env().Undefined();
+}
+
+Napi::Value LoudnessMeter::ResetPeaks(const Napi::CallbackInfo& info) {
+  for (Channel& ch : state_) {
+    ch.sample_peak = 0;
+    ch.true_peak = 0;
+  }
+  return info.Env().Undefined();
+}
+
+Napi::Value LoudnessMeter::GetChannels(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), channels_);
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,160 @@
+#include "memory_accounting.h"
+
+namespace ffmpeg {
+
+std::atomic<bool> MemoryAccounting::enabled_{false};
+
+namespace {
+
+const char* const kOwnerNames[MemoryAccounting::kOwnerCount] = {
+  "packet",
+  "frame",
+  "frameUtils",
+  "ioContext",
+  "filterGraph",
+};
+
+struct Counter {
+  std::atomic<int64_t> objects{0};
+  std::atomic<int64_t> bytes{0};
+  std::atomic<int64_t> peak{0};
+};
+
+// Process-wide; wrappers of all environments (worker threads) add up
+Counter counters[MemoryAccounting::kOwnerCount];
+Counter total;
+
+void RaisePeak(std::atomic<int64_t>& peak, int64_t value) {
+  int64_t current = peak.load(std::memory_order_relaxed);
+  while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+void Add(Counter& counter, int64_t delta) {
+  int64_t bytes = counter.bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+  if (delta > 0) {
+    RaisePeak(counter.peak, bytes);
+  }
+}
+
+int64_t BufferBytes(const AVBufferRef* buf) {
+  return buf ? static_cast<int64_t>(buf->size) : 0;
+}
+
+} // namespace
+
+int64_t MemoryAccounting::PacketBytes(const AVPacket* packet) {
+  if (!packet) {
+    return 0;
+  }
+
+  // Non refcounted packets point at memory owned elsewhere
+  int64_t bytes = BufferBytes(packet->buf);
+  for (int i = 0; i < packet->side_data_elems; i++) {
+    bytes += static_cast<int64_t>(packet->side_data[i].size);
+  }
+  return bytes;
+}
+
+int64_t MemoryAccounting::FrameBytes(const AVFrame* frame) {
+  if (!frame) {
+    return 0;
+  }
+
+  int64_t bytes = 0;
+  for (int i = 0; i < AV_NUM_DATA_POINTERS; i++) {
+    bytes += BufferBytes(frame->buf[i]);
+  }
+  for (int i = 0; i < frame->nb_extended_buf; i++) {
+    bytes += BufferBytes(frame->extended_buf[i]);
+  }
+  for (int i = 0; i < frame->nb_side_data; i++) {
+    bytes += BufferBytes(frame->side_data[i]->buf);
+  }
+  return bytes;
+}
+
+void MemoryAccounting::Account::Update(napi_env env, int64_t bytes) {
+  if (!tracked_) {
+    if (!Enabled()) {
+      return;
+    }
+    tracked_ = true;
+    counters[owner_].objects.fetch_add(1, std::memory_order_relaxed);
+    total.objects.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  int64_t delta = bytes - bytes_;
+  if (delta == 0) {
+    return;
+  }
+  bytes_ = bytes;
+
+  Add(counters[owner_], delta);
+  Add(total, delta);
+
+  int64_t adjusted = 0;
+  napi_adjust_external_memory(env, delta, &adjusted);
+}
+
+void MemoryAccounting::Account::Release(napi_env env) {
+  if (!tracked_) {
+    return;
+  }
+
+  Update(env, 0);
+  tracked_ = false;
+  counters[owner_].objects.fetch_sub(1, std::memory_order_relaxed);
+  total.objects.fetch_sub(1, std::memory_order_relaxed);
+}
+
+Napi::Object MemoryAccounting::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setMemoryAccounting", Napi::Function::New(env, SetEnabled));
+  exports.Set("getMemoryAccounting", Napi::Function::New(env, GetSnapshot));
+  exports.Set("resetMemoryAccountingPeak", Napi::Function::New(env, ResetPeak));
+  return exports;
+}
+
+Napi::Value MemoryAccounting::SetEnabled(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsBoolean()) {
+    Napi::TypeError::New(env, "Enabled (boolean) required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  enabled_.store(info[0].As<Napi::Boolean>().Value(), std::memory_order_relaxed);
+  return env.Undefined();
+}
+
+Napi::Value MemoryAccounting::GetSnapshot(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  auto toJS = [&env](const Counter& counter) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("objects", Napi::Number::New(env, static_cast<double>(counter.objects.load(std::memory_order_relaxed))));
+    obj.Set("bytes", Napi::Number::New(env, static_cast<double>(counter.bytes.load(std::memory_order_relaxed))));
+    obj.Set("peakBytes", Napi::Number::New(env, static_cast<double>(counter.peak.load(std::memory_order_relaxed))));
+    return obj;
+  };
+
+  Napi::Object owners = Napi::Object::New(env);
+  for (int i = 0; i < kOwnerCount; i++) {
+    owners.Set(kOwnerNames[i], toJS(counters[i]));
+  }
+
+  Napi::Object result = toJS(total);
+  result.Set("enabled", Napi::Boolean::New(env, Enabled()));
+  result.Set("owners", owners);
+  return result;
+}
+
+Napi::Value MemoryAccounting::ResetPeak(const Napi::CallbackInfo& info) {
+  for (Counter& counter : counters) {
+    counter.peak.store(counter.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  total.peak.store(total.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  return info.Env().Undefined();
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,77 @@
+#ifndef FFMPEG_MEMORY_ACCOUNTING_H
+#define FFMPEG_MEMORY_ACCOUNTING_H
+
+#include <napi.h>
+#include <atomic>
+#include <cstdint>
+
+extern "C" {
+#include <libavcodec/packet.h>
+#include <libavutil/frame.h>
+}
+
+namespace ffmpeg {
+
+// Optional accounting of native memory held by the JS wrappers.
+//
+// Disabled by default. When enabled, wrappers measure the FFmpeg buffers they
+// reference at their ownership points (alloc, ref/unref, clone, free and the
+// read/receive calls that fill them), add the bytes to per-owner counters and
+// report the difference to V8 as external memory, so GC pressure reflects the
+// packets and frames kept alive from JS. Buffers shared between wrappers are
+// counted once per wrapper.
+class MemoryAccounting {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  // Keep in sync with the owner names in memory_accounting.cc
+  enum Owner {
+    kPacket = 0,
+    kFrame,
+    kFrameUtils,
+    kIOContext,
+    kFilterGraph,
+    kOwnerCount,
+  };
+
+  static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  // Bytes of the buffers referenced by a packet or frame (data and side data)
+  static int64_t PacketBytes(const AVPacket* packet);
+  static int64_t FrameBytes(const AVFrame* frame);
+
+  // Per-object account, embedded in a wrapper. Joins the counters on the
+  // first Update() while accounting is enabled and stays tracked until
+  // Release(), so disabling accounting does not unbalance the totals.
+  class Account {
+  public:
+    explicit Account(Owner owner) : owner_(owner) {}
+    Account(const Account&) = delete;
+    Account& operator=(const Account&) = delete;
+
+    // Cheap check before measuring
+    bool Active() const { return tracked_ || Enabled(); }
+
+    // Set the bytes currently held by the object
+    void Update(napi_env env, int64_t bytes);
+
+    // Object is gone; call from the wrapper's destructor
+    void Release(napi_env env);
+
+  private:
+    Owner owner_;
+    int64_t bytes_ = 0;
+    bool tracked_ = false;
+  };
+
+private:
+  static std::atomic<bool> enabled_;
+
+  static Napi::Value SetEnabled(const Napi::CallbackInfo& info);
+  static Napi::Value GetSnapshot(const Napi::CallbackInfo& info);
+  static Napi::Value ResetPeak(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_MEMORY_ACCOUNTING_H
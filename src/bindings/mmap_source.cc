@@ -0,0 +1,182 @@
+#include "mmap_source.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+extern "C" {
+#include <libavformat/avio.h>
+#include <libavutil/error.h>
+}
+
+namespace ffmpeg {
+
+MmapSource::~MmapSource() {
+#ifdef _WIN32
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_) {
+    CloseHandle(mapping_);
+  }
+#else
+  if (data_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+#endif
+}
+
+std::unique_ptr<MmapSource> MmapSource::Open(const std::string& path, std::string& error) {
+  std::unique_ptr<MmapSource> source(new MmapSource());
+
+#ifdef _WIN32
+  int fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+  if (fd < 0) {
+    error = "Failed to open file: " + std::string(strerror(errno));
+    return nullptr;
+  }
+
+  int64_t size = _filelengthi64(fd);
+  if (size > 0) {
+    HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+    source->mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (source->mapping_) {
+      source->data_ = static_cast<const uint8_t*>(MapViewOfFile(source->mapping_, FILE_MAP_READ, 0, 0, 0));
+    }
+  }
+  _close(fd);
+
+  if (size < 0 || (size > 0 && !source->data_)) {
+    error = "Failed to map file";
+    return nullptr;
+  }
+#else
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    error = "Failed to open file: " + std::string(strerror(errno));
+    return nullptr;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    error = "Not a regular file";
+    return nullptr;
+  }
+
+  int64_t size = static_cast<int64_t>(st.st_size);
+  if (size > 0) {
+    void* data = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      int err = errno;
+      close(fd);
+      error = "Failed to map file: " + std::string(strerror(err));
+      return nullptr;
+    }
+    // Demuxers read mostly forward; let the kernel read ahead aggressively
+    madvise(data, static_cast<size_t>(size), MADV_SEQUENTIAL);
+    source->data_ = static_cast<const uint8_t*>(data);
+  }
+  // Kept open to detect truncation before reads
+  source->fd_ = fd;
+#endif
+
+  source->size_ = static_cast<size_t>(size);
+  return source;
+}
+
+int MmapSource::ReadPacket(void* opaque, uint8_t* buf, int buf_size) {
+  MmapSource* source = static_cast<MmapSource*>(opaque);
+
+  if (buf_size <= 0) {
+    return 0;
+  }
+  if (source->pos_ >= source->size_) {
+    return AVERROR_EOF;
+  }
+
+  size_t n = std::min(static_cast<size_t>(buf_size), source->size_ - source->pos_);
+
+#ifndef _WIN32
+  // Windows refuses to truncate a mapped file; elsewhere pages past the new
+  // end raise SIGBUS, so a shrunk file is read with pread() from then on.
+  // The size is re-checked once per kSizeCheckInterval bytes, not per read.
+  if (!source->truncated_ && source->unchecked_bytes_ >= kSizeCheckInterval) {
+    source->unchecked_bytes_ = 0;
+    struct stat st;
+    if (fstat(source->fd_, &st) != 0 || static_cast<uint64_t>(st.st_size) < source->size_) {
+      source->truncated_ = true;
+    }
+  }
+  if (source->truncated_) {
+    ssize_t ret;
+    do {
+      ret = pread(source->fd_, buf, n, static_cast<off_t>(source->pos_));
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+      return AVERROR(errno);
+    }
+    if (ret == 0) {
+      return AVERROR_EOF;
+    }
+    source->pos_ += static_cast<size_t>(ret);
+    return static_cast<int>(ret);
+  }
+#endif
+
+  memcpy(buf, source->data_ + source->pos_, n);
+  source->pos_ += n;
+#ifndef _WIN32
+  source->unchecked_bytes_ += n;
+#endif
+  return static_cast<int>(n);
+}
+
+int64_t MmapSource::Seek(void* opaque, int64_t offset, int whence) {
+  MmapSource* source = static_cast<MmapSource*>(opaque);
+
+  int64_t target;
+  switch (whence & ~AVSEEK_FORCE) {
+    case AVSEEK_SIZE:
+      return source->Size();
+    case SEEK_SET:
+      target = offset;
+      break;
+    case SEEK_CUR:
+      target = static_cast<int64_t>(source->pos_) + offset;
+      break;
+    case SEEK_END:
+      target = source->Size() + offset;
+      break;
+    default:
+      return AVERROR(EINVAL);
+  }
+
+  // Seeking past the end is allowed (like lseek); reads there return EOF
+  if (target < 0) {
+    return AVERROR(EINVAL);
+  }
+  source->pos_ = static_cast<size_t>(target);
+  return target;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,58 @@
+#ifndef FFMPEG_MMAP_SOURCE_H
+#define FFMPEG_MMAP_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ffmpeg {
+
+// Memory-mapped local file backing a read-only AVIOContext.
+//
+// The file protocol reads through read(2) into the AVIOContext buffer, which
+// the demuxer then copies into the packet. With the context in direct mode,
+// avio_read() hands large reads (packet payloads) straight to ReadPacket, so
+// samples are copied once from the mapping into the packet buffer. Small
+// header reads still go through the AVIOContext buffer. Seeking only moves
+// the read position.
+//
+// Touching a mapped page past the end of a file that was truncated raises
+// SIGBUS. On POSIX the file stays open and its size is re-checked every
+// kSizeCheckInterval bytes; once it is shorter than the mapping, reads fall
+// back to pread(). A truncation between two checks still raises SIGBUS, so
+// the source is only meant for files that are not modified while open.
+class MmapSource {
+public:
+  ~MmapSource();
+
+  // Map the file; returns nullptr and sets error on failure
+  static std::unique_ptr<MmapSource> Open(const std::string& path, std::string& error);
+
+  // AVIOContext callbacks (opaque = MmapSource*)
+  static int ReadPacket(void* opaque, uint8_t* buf, int buf_size);
+  static int64_t Seek(void* opaque, int64_t offset, int whence);
+
+  int64_t Size() const { return static_cast<int64_t>(size_); }
+
+private:
+  MmapSource() = default;
+
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+
+#ifdef _WIN32
+  void* mapping_ = nullptr;
+#else
+  static constexpr size_t kSizeCheckInterval = 4 * 1024 * 1024;
+
+  int fd_ = -1;
+  bool truncated_ = false;     // File shrank, read with pread()
+  size_t unchecked_bytes_ = 0; // Copied from the mapping since the last size check
+#endif
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_MMAP_SOURCE_H
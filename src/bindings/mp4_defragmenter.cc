@@ -0,0 +1,1004 @@
+#include "mp4_defragmenter.h"
+#include "common.h"
+#include "tracing.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+extern "C" {
+#include <libavutil/mathematics.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+constexpr uint32_t Tag(const char (&s)[5]) {
+  return (static_cast<uint32_t>(static_cast<uint8_t>(s[0])) << 24) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(s[1])) << 16) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(s[2])) << 8) |
+         static_cast<uint32_t>(static_cast<uint8_t>(s[3]));
+}
+
+uint32_t RB32(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+uint64_t RB64(const uint8_t* p) {
+  return (static_cast<uint64_t>(RB32(p)) << 32) | RB32(p + 4);
+}
+
+void WB32(uint8_t* p, uint32_t v) {
+  p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+}
+
+void WB64(uint8_t* p, uint64_t v) {
+  WB32(p, static_cast<uint32_t>(v >> 32));
+  WB32(p + 4, static_cast<uint32_t>(v));
+}
+
+// Minimal file wrapper: positioned reads, sequential writes
+class File {
+public:
+  ~File() { Close(); }
+
+  bool OpenRead(const std::string& path) {
+#ifdef _WIN32
+    fd_ = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    return fd_ >= 0;
+  }
+
+  bool OpenWrite(const std::string& path) {
+#ifdef _WIN32
+    fd_ = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+    return fd_ >= 0;
+  }
+
+  int64_t Size() const {
+#ifdef _WIN32
+    return _filelengthi64(fd_);
+#else
+    struct stat st;
+    return fstat(fd_, &st) == 0 ? static_cast<int64_t>(st.st_size) : -1;
+#endif
+  }
+
+  bool ReadAt(uint8_t* buf, size_t size, uint64_t offset) const {
+#ifdef _WIN32
+    if (_lseeki64(fd_, static_cast<int64_t>(offset), SEEK_SET) < 0) {
+      return false;
+    }
+#endif
+    while (size > 0) {
+#ifdef _WIN32
+      int n = _read(fd_, buf, static_cast<unsigned int>(std::min<size_t>(size, 1 << 30)));
+#else
+      ssize_t n = pread(fd_, buf, size, static_cast<off_t>(offset));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+#endif
+      if (n <= 0) {
+        return false;
+      }
+      buf += n;
+      size -= static_cast<size_t>(n);
+      offset += static_cast<uint64_t>(n);
+    }
+    return true;
+  }
+
+  bool Write(const uint8_t* buf, size_t size) {
+    while (size > 0) {
+#ifdef _WIN32
+      int n = _write(fd_, buf, static_cast<unsigned int>(std::min<size_t>(size, 1 << 30)));
+#else
+      ssize_t n = write(fd_, buf, size);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+#endif
+      if (n <= 0) {
+        return false;
+      }
+      buf += n;
+      size -= static_cast<size_t>(n);
+    }
+    return true;
+  }
+
+  // Append size bytes of src starting at offset
+  bool CopyFrom(const File& src, uint64_t offset, uint64_t size, std::vector<uint8_t>& scratch) {
+#if defined(__linux__)
+    // Kernel-side copy (reflink or in-kernel on most filesystems)
+    while (size > 0 && !no_copy_range_) {
+      loff_t off_in = static_cast<loff_t>(offset);
+      ssize_t n = copy_file_range(src.fd_, &off_in, fd_, nullptr, size, 0);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        // Unsupported between these files (EXDEV, ENOSYS, EINVAL...): fall back
+        no_copy_range_ = true;
+        break;
+      }
+      offset += static_cast<uint64_t>(n);
+      size -= static_cast<uint64_t>(n);
+    }
+#endif
+    while (size > 0) {
+      size_t n = static_cast<size_t>(std::min<uint64_t>(size, scratch.size()));
+      if (!src.ReadAt(scratch.data(), n, offset) || !Write(scratch.data(), n)) {
+        return false;
+      }
+      offset += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  void Close() {
+    if (fd_ >= 0) {
+#ifdef _WIN32
+      _close(fd_);
+#else
+      close(fd_);
+#endif
+      fd_ = -1;
+    }
+  }
+
+private:
+  int fd_ = -1;
+  bool no_copy_range_ = false;
+};
+
+// Box within an in-memory buffer
+struct Box {
+  uint32_t type = 0;
+  const uint8_t* data = nullptr;  // Box start
+  size_t size = 0;                // Including header
+  size_t header = 0;
+
+  const uint8_t* payload() const { return data + header; }
+  size_t payload_size() const { return size - header; }
+};
+
+bool NextBox(const uint8_t*& p, const uint8_t* end, Box& box) {
+  if (end - p < 8) {
+    return false;
+  }
+  uint64_t size = RB32(p);
+  size_t header = 8;
+  if (size == 1) {
+    if (end - p < 16) {
+      return false;
+    }
+    size = RB64(p + 8);
+    header = 16;
+  } else if (size == 0) {
+    size = static_cast<uint64_t>(end - p);
+  }
+  if (size < header || size > static_cast<uint64_t>(end - p)) {
+    return false;
+  }
+
+  box.type = RB32(p + 4);
+  box.data = p;
+  box.size = static_cast<size_t>(size);
+  box.header = header;
+  p += size;
+  return true;
+}
+
+template <typename Fn>
+void ForEachChild(const Box& parent, Fn&& fn) {
+  const uint8_t* p = parent.payload();
+  const uint8_t* end = p + parent.payload_size();
+  Box child;
+  while (NextBox(p, end, child)) {
+    fn(child);
+  }
+}
+
+bool FindChild(const Box& parent, uint32_t type, Box& out) {
+  bool found = false;
+  ForEachChild(parent, [&](const Box& child) {
+    if (!found && child.type == type) {
+      out = child;
+      found = true;
+    }
+  });
+  return found;
+}
+
+// Bounds-checked big-endian reader
+struct Reader {
+  const uint8_t* p;
+  size_t left;
+  bool ok = true;
+
+  Reader(const uint8_t* data, size_t size) : p(data), left(size) {}
+
+  uint32_t U32() {
+    if (left < 4) {
+      ok = false;
+      return 0;
+    }
+    uint32_t v = RB32(p);
+    p += 4;
+    left -= 4;
+    return v;
+  }
+
+  uint64_t U64() {
+    uint64_t hi = U32();
+    return (hi << 32) | U32();
+  }
+};
+
+struct Writer {
+  std::vector<uint8_t> buf;
+
+  void U8(uint8_t v) { buf.push_back(v); }
+  void U32(uint32_t v) { uint8_t b[4]; WB32(b, v); buf.insert(buf.end(), b, b + 4); }
+  void U64(uint64_t v) { uint8_t b[8]; WB64(b, v); buf.insert(buf.end(), b, b + 8); }
+  void Bytes(const uint8_t* p, size_t n) { buf.insert(buf.end(), p, p + n); }
+
+  size_t Begin(uint32_t type) {
+    size_t pos = buf.size();
+    U32(0);
+    U32(type);
+    return pos;
+  }
+
+  size_t BeginFull(uint32_t type, uint8_t version, uint32_t flags) {
+    size_t pos = Begin(type);
+    U32((static_cast<uint32_t>(version) << 24) | (flags & 0xffffff));
+    return pos;
+  }
+
+  void End(size_t pos) {
+    WB32(buf.data() + pos, static_cast<uint32_t>(buf.size() - pos));
+  }
+};
+
+struct Sample {
+  uint32_t size;
+  uint32_t duration;
+  int32_t cto;
+  bool sync;
+};
+
+// One track run: samples stored contiguously
+struct Chunk {
+  uint64_t offset;   // Source file offset, later output offset
+  uint32_t samples;
+  uint32_t desc;
+};
+
+struct Track {
+  uint32_t id = 0;
+  uint32_t timescale = 0;
+  uint32_t def_desc = 1;
+  uint32_t def_duration = 0;
+  uint32_t def_size = 0;
+  uint32_t def_flags = 0;
+  std::vector<Sample> samples;
+  std::vector<Chunk> chunks;
+  uint64_t duration = 0;
+};
+
+struct MdatRange {
+  uint64_t src;      // Payload offset in the input
+  uint64_t size;
+  uint64_t dst;      // Offset within the output mdat payload
+};
+
+// Track state before a fragment, to drop it again
+struct TrackMark {
+  size_t samples;
+  size_t chunks;
+  uint64_t duration;
+};
+
+// mdat holding a whole run, or nullptr
+const MdatRange* FindMdat(const std::vector<MdatRange>& mdats, uint64_t offset, uint64_t bytes) {
+  auto it = std::upper_bound(mdats.begin(), mdats.end(), offset,
+                             [](uint64_t off, const MdatRange& m) { return off < m.src; });
+  if (it == mdats.begin() || offset + bytes > std::prev(it)->src + std::prev(it)->size) {
+    return nullptr;
+  }
+  return &*std::prev(it);
+}
+
+// Bytes of the samples of a run, starting at sample index
+uint64_t ChunkBytes(const Track& track, const Chunk& chunk, size_t& sample) {
+  uint64_t bytes = 0;
+  for (uint32_t i = 0; i < chunk.samples; i++) {
+    bytes += track.samples[sample++].size;
+  }
+  return bytes;
+}
+
+constexpr uint32_t SAMPLE_NON_SYNC = 0x10000;
+
+// Version byte of a full box
+uint8_t Version(const Box& box) {
+  return box.payload_size() > 0 ? box.payload()[0] : 0;
+}
+
+Track* FindTrack(std::vector<Track>& tracks, uint32_t id) {
+  for (auto& track : tracks) {
+    if (track.id == id) {
+      return &track;
+    }
+  }
+  return nullptr;
+}
+
+std::string ParseMoov(const Box& moov, std::vector<Track>& tracks, uint32_t& movie_timescale) {
+  Box mvhd;
+  if (!FindChild(moov, Tag("mvhd"), mvhd)) {
+    return "moov has no mvhd";
+  }
+  size_t ts_pos = Version(mvhd) == 1 ? 20 : 12;
+  if (mvhd.payload_size() < ts_pos + 4) {
+    return "Invalid mvhd";
+  }
+  movie_timescale = RB32(mvhd.payload() + ts_pos);
+
+  std::string error;
+  ForEachChild(moov, [&](const Box& child) {
+    if (child.type == Tag("trak")) {
+      Box tkhd, mdia, mdhd;
+      if (!FindChild(child, Tag("tkhd"), tkhd) || !FindChild(child, Tag("mdia"), mdia) ||
+          !FindChild(mdia, Tag("mdhd"), mdhd)) {
+        error = "Incomplete trak";
+        return;
+      }
+      size_t id_pos = Version(tkhd) == 1 ? 20 : 12;
+      size_t mts_pos = Version(mdhd) == 1 ? 20 : 12;
+      if (tkhd.payload_size() < id_pos + 4 || mdhd.payload_size() < mts_pos + 4) {
+        error = "Invalid tkhd/mdhd";
+        return;
+      }
+      Track track;
+      track.id = RB32(tkhd.payload() + id_pos);
+      track.timescale = RB32(mdhd.payload() + mts_pos);
+      tracks.push_back(track);
+    }
+  });
+  if (!error.empty()) {
+    return error;
+  }
+
+  Box mvex;
+  if (FindChild(moov, Tag("mvex"), mvex)) {
+    ForEachChild(mvex, [&](const Box& child) {
+      if (child.type != Tag("trex")) {
+        return;
+      }
+      Reader r(child.payload(), child.payload_size());
+      r.U32();  // version/flags
+      Track* track = FindTrack(tracks, r.U32());
+      uint32_t desc = r.U32(), duration = r.U32(), size = r.U32(), flags = r.U32();
+      if (track && r.ok) {
+        track->def_desc = desc;
+        track->def_duration = duration;
+        track->def_size = size;
+        track->def_flags = flags;
+      }
+    });
+  }
+
+  return tracks.empty() ? "moov has no tracks" : "";
+}
+
+std::string ParseMoof(const Box& moof, uint64_t moof_offset, std::vector<Track>& tracks) {
+  std::string error;
+  uint64_t prev_traf_end = moof_offset;
+  bool first_traf = true;
+
+  ForEachChild(moof, [&](const Box& traf) {
+    if (traf.type != Tag("traf") || !error.empty()) {
+      return;
+    }
+
+    Box tfhd;
+    if (!FindChild(traf, Tag("tfhd"), tfhd)) {
+      error = "traf has no tfhd";
+      return;
+    }
+    Reader h(tfhd.payload(), tfhd.payload_size());
+    uint32_t tf_flags = h.U32() & 0xffffff;
+    Track* track = FindTrack(tracks, h.U32());
+    if (!track) {
+      error = "Fragment references an unknown track";
+      return;
+    }
+    uint64_t base = first_traf ? moof_offset : prev_traf_end;
+    if (tf_flags & 0x000001) {
+      base = h.U64();
+    } else if (tf_flags & 0x020000) {
+      base = moof_offset;  // default-base-is-moof
+    }
+    uint32_t desc = (tf_flags & 0x000002) ? h.U32() : track->def_desc;
+    uint32_t def_duration = (tf_flags & 0x000008) ? h.U32() : track->def_duration;
+    uint32_t def_size = (tf_flags & 0x000010) ? h.U32() : track->def_size;
+    uint32_t def_flags = (tf_flags & 0x000020) ? h.U32() : track->def_flags;
+    if (!h.ok) {
+      error = "Invalid tfhd";
+      return;
+    }
+    first_traf = false;
+
+    uint64_t cursor = base;
+    bool first_trun = true;
+    ForEachChild(traf, [&](const Box& trun) {
+      if (trun.type != Tag("trun") || !error.empty()) {
+        return;
+      }
+      Reader r(trun.payload(), trun.payload_size());
+      uint32_t vf = r.U32();
+      uint8_t version = vf >> 24;
+      uint32_t flags = vf & 0xffffff;
+      uint32_t count = r.U32();
+      if (flags & 0x001) {
+        cursor = base + static_cast<int64_t>(static_cast<int32_t>(r.U32()));
+      } else if (first_trun) {
+        cursor = base;
+      }
+      first_trun = false;
+      uint32_t first_flags = (flags & 0x004) ? r.U32() : 0;
+
+      Chunk chunk = {cursor, count, desc};
+      for (uint32_t i = 0; i < count && r.ok; i++) {
+        Sample s;
+        s.duration = (flags & 0x100) ? r.U32() : def_duration;
+        s.size = (flags & 0x200) ? r.U32() : def_size;
+        uint32_t sample_flags = (flags & 0x400) ? r.U32() : (i == 0 && (flags & 0x004)) ? first_flags : def_flags;
+        if (flags & 0x800) {
+          uint32_t cto = r.U32();
+          s.cto = version == 0 ? static_cast<int32_t>(std::min<uint32_t>(cto, INT32_MAX)) : static_cast<int32_t>(cto);
+        } else {
+          s.cto = 0;
+        }
+        s.sync = !(sample_flags & SAMPLE_NON_SYNC);
+        cursor += s.size;
+        track->duration += s.duration;
+        track->samples.push_back(s);
+      }
+      if (!r.ok) {
+        error = "Truncated trun";
+        return;
+      }
+      if (count > 0) {
+        track->chunks.push_back(chunk);
+      }
+    });
+    prev_traf_end = cursor;
+  });
+
+  return error;
+}
+
+// Patch the duration field of an mvhd/mdhd (duration after timescale) or tkhd box copy
+void PatchDuration(Writer& w, size_t box_pos, size_t header, uint8_t version, size_t v0_pos, size_t v1_pos, uint64_t duration) {
+  uint8_t* payload = w.buf.data() + box_pos + header;
+  size_t box_size = w.buf.size() - box_pos;
+  if (version == 1) {
+    if (header + v1_pos + 8 <= box_size) {
+      WB64(payload + v1_pos, duration);
+    }
+  } else if (header + v0_pos + 4 <= box_size) {
+    WB32(payload + v0_pos, static_cast<uint32_t>(std::min<uint64_t>(duration, UINT32_MAX)));
+  }
+}
+
+void WriteSampleTable(Writer& w, const Box& stbl, const Track& track, bool co64) {
+  size_t stbl_pos = w.Begin(Tag("stbl"));
+
+  Box stsd;
+  if (FindChild(stbl, Tag("stsd"), stsd)) {
+    w.Bytes(stsd.data, stsd.size);
+  }
+
+  const auto& samples = track.samples;
+
+  // Decoding times, run-length coded
+  std::vector<std::pair<uint32_t, uint32_t>> runs;
+  for (const auto& s : samples) {
+    if (!runs.empty() && runs.back().second == s.duration) {
+      runs.back().first++;
+    } else {
+      runs.emplace_back(1, s.duration);
+    }
+  }
+  size_t pos = w.BeginFull(Tag("stts"), 0, 0);
+  w.U32(static_cast<uint32_t>(runs.size()));
+  for (const auto& run : runs) {
+    w.U32(run.first);
+    w.U32(run.second);
+  }
+  w.End(pos);
+
+  // Composition offsets
+  bool has_cto = false, negative_cto = false, all_sync = true;
+  for (const auto& s : samples) {
+    has_cto |= s.cto != 0;
+    negative_cto |= s.cto < 0;
+    all_sync &= s.sync;
+  }
+  if (has_cto) {
+    runs.clear();
+    for (const auto& s : samples) {
+      uint32_t cto = static_cast<uint32_t>(s.cto);
+      if (!runs.empty() && runs.back().second == cto) {
+        runs.back().first++;
+      } else {
+        runs.emplace_back(1, cto);
+      }
+    }
+    pos = w.BeginFull(Tag("ctts"), negative_cto ? 1 : 0, 0);
+    w.U32(static_cast<uint32_t>(runs.size()));
+    for (const auto& run : runs) {
+      w.U32(run.first);
+      w.U32(run.second);
+    }
+    w.End(pos);
+  }
+
+  // Sync samples (omitted when every sample is a sync sample)
+  if (!all_sync) {
+    std::vector<uint32_t> sync;
+    for (size_t i = 0; i < samples.size(); i++) {
+      if (samples[i].sync) {
+        sync.push_back(static_cast<uint32_t>(i + 1));
+      }
+    }
+    pos = w.BeginFull(Tag("stss"), 0, 0);
+    w.U32(static_cast<uint32_t>(sync.size()));
+    for (uint32_t index : sync) {
+      w.U32(index);
+    }
+    w.End(pos);
+  }
+
+  // Sample to chunk, run-length coded by first chunk
+  struct StscEntry { uint32_t first; uint32_t samples; uint32_t desc; };
+  std::vector<StscEntry> stsc;
+  for (size_t i = 0; i < track.chunks.size(); i++) {
+    const Chunk& c = track.chunks[i];
+    if (stsc.empty() || stsc.back().samples != c.samples || stsc.back().desc != c.desc) {
+      stsc.push_back({static_cast<uint32_t>(i + 1), c.samples, c.desc});
+    }
+  }
+  pos = w.BeginFull(Tag("stsc"), 0, 0);
+  w.U32(static_cast<uint32_t>(stsc.size()));
+  for (const auto& e : stsc) {
+    w.U32(e.first);
+    w.U32(e.samples);
+    w.U32(e.desc);
+  }
+  w.End(pos);
+
+  // Sample sizes (constant size when possible)
+  bool constant = !samples.empty();
+  for (const auto& s : samples) {
+    constant &= s.size == samples[0].size;
+  }
+  pos = w.BeginFull(Tag("stsz"), 0, 0);
+  w.U32(constant ? samples[0].size : 0);
+  w.U32(static_cast<uint32_t>(samples.size()));
+  if (!constant) {
+    for (const auto& s : samples) {
+      w.U32(s.size);
+    }
+  }
+  w.End(pos);
+
+  // Chunk offsets
+  pos = w.BeginFull(co64 ? Tag("co64") : Tag("stco"), 0, 0);
+  w.U32(static_cast<uint32_t>(track.chunks.size()));
+  for (const auto& c : track.chunks) {
+    if (co64) {
+      w.U64(c.offset);
+    } else {
+      w.U32(static_cast<uint32_t>(c.offset));
+    }
+  }
+  w.End(pos);
+
+  w.End(stbl_pos);
+}
+
+// Rebuild moov: durations patched, sample tables replaced, mvex removed
+std::vector<uint8_t> BuildMoov(const Box& moov, const std::vector<Track>& tracks, uint32_t movie_timescale, bool co64) {
+  Writer w;
+  uint64_t movie_duration = 0;
+  for (const auto& t : tracks) {
+    if (t.timescale > 0) {
+      movie_duration = std::max<uint64_t>(movie_duration, av_rescale(t.duration, movie_timescale, t.timescale));
+    }
+  }
+
+  size_t moov_pos = w.Begin(Tag("moov"));
+  size_t track_index = 0;
+  ForEachChild(moov, [&](const Box& child) {
+    if (child.type == Tag("mvex")) {
+      return;
+    }
+    if (child.type == Tag("mvhd")) {
+      size_t pos = w.buf.size();
+      w.Bytes(child.data, child.size);
+      PatchDuration(w, pos, child.header, Version(child), 16, 24, movie_duration);
+      return;
+    }
+    if (child.type != Tag("trak")) {
+      w.Bytes(child.data, child.size);
+      return;
+    }
+
+    const Track& track = tracks[track_index++];
+    uint64_t track_movie_duration = track.timescale > 0 ? av_rescale(track.duration, movie_timescale, track.timescale) : 0;
+
+    size_t trak_pos = w.Begin(Tag("trak"));
+    ForEachChild(child, [&](const Box& tc) {
+      if (tc.type == Tag("tkhd")) {
+        size_t pos = w.buf.size();
+        w.Bytes(tc.data, tc.size);
+        PatchDuration(w, pos, tc.header, Version(tc), 20, 28, track_movie_duration);
+      } else if (tc.type == Tag("mdia")) {
+        size_t mdia_pos = w.Begin(Tag("mdia"));
+        ForEachChild(tc, [&](const Box& mc) {
+          if (mc.type == Tag("mdhd")) {
+            size_t pos = w.buf.size();
+            w.Bytes(mc.data, mc.size);
+            PatchDuration(w, pos, mc.header, Version(mc), 16, 24, track.duration);
+          } else if (mc.type == Tag("minf")) {
+            size_t minf_pos = w.Begin(Tag("minf"));
+            ForEachChild(mc, [&](const Box& ic) {
+              if (ic.type == Tag("stbl")) {
+                WriteSampleTable(w, ic, track, co64);
+              } else {
+                w.Bytes(ic.data, ic.size);
+              }
+            });
+            w.End(minf_pos);
+          } else {
+            w.Bytes(mc.data, mc.size);
+          }
+        });
+        w.End(mdia_pos);
+      } else {
+        w.Bytes(tc.data, tc.size);
+      }
+    });
+    w.End(trak_pos);
+  });
+  w.End(moov_pos);
+
+  return std::move(w.buf);
+}
+
+constexpr size_t COPY_STEP = 8 * 1024 * 1024;
+
+} // namespace
+
+std::string Mp4Defragmenter::Run(const std::string& input, const std::string& output,
+                                 Result& result, const std::function<void(double)>& progress) {
+  File in;
+  if (!in.OpenRead(input)) {
+    return "Cannot open input: " + std::string(strerror(errno));
+  }
+  int64_t file_size = in.Size();
+  if (file_size < 0) {
+    return "Cannot stat input";
+  }
+
+  // Top-level scan: only moov and moof boxes are read into memory
+  std::vector<uint8_t> ftyp, moov_data;
+  std::vector<Track> tracks;
+  std::vector<MdatRange> mdats;
+  std::vector<TrackMark> marks;  // Before the last moof
+  uint32_t movie_timescale = 0;
+  uint64_t payload_total = 0;
+  uint64_t pos = 0;
+  std::string error;
+
+  while (pos + 8 <= static_cast<uint64_t>(file_size)) {
+    uint8_t head[16];
+    if (!in.ReadAt(head, 8, pos)) {
+      return "Read error";
+    }
+    uint64_t size = RB32(head);
+    uint32_t type = RB32(head + 4);
+    uint64_t header = 8;
+    if (size == 1) {
+      if (!in.ReadAt(head + 8, 8, pos + 8)) {
+        return "Read error";
+      }
+      size = RB64(head + 8);
+      header = 16;
+    } else if (size == 0) {
+      size = static_cast<uint64_t>(file_size) - pos;
+    }
+    if (size < header || pos + size > static_cast<uint64_t>(file_size)) {
+      // Truncated last box (recording interrupted): keep what is complete
+      break;
+    }
+
+    if (type == Tag("ftyp") || type == Tag("moov") || type == Tag("moof")) {
+      std::vector<uint8_t> data(static_cast<size_t>(size));
+      if (!in.ReadAt(data.data(), data.size(), pos)) {
+        return "Read error";
+      }
+      Box box;
+      const uint8_t* p = data.data();
+      if (!NextBox(p, data.data() + data.size(), box)) {
+        return "Invalid box";
+      }
+
+      if (type == Tag("ftyp")) {
+        ftyp = std::move(data);
+      } else if (type == Tag("moov")) {
+        error = ParseMoov(box, tracks, movie_timescale);
+        moov_data = std::move(data);
+      } else if (moov_data.empty()) {
+        error = "moof before moov";
+      } else {
+        marks.clear();
+        for (const auto& track : tracks) {
+          marks.push_back({track.samples.size(), track.chunks.size(), track.duration});
+        }
+        error = ParseMoof(box, pos, tracks);
+        result.fragments++;
+      }
+      if (!error.empty()) {
+        return error;
+      }
+    } else if (type == Tag("mdat")) {
+      mdats.push_back({pos + header, size - header, payload_total});
+      payload_total += size - header;
+    }
+
+    pos += size;
+  }
+
+  if (moov_data.empty()) {
+    return "Input has no moov";
+  }
+  if (result.fragments == 0) {
+    return "Input is not a fragmented MP4";
+  }
+
+  // Recording interrupted inside the last mdat: drop the last fragment
+  bool partial = false;
+  for (size_t t = 0; t < marks.size() && !partial; t++) {
+    size_t sample = marks[t].samples;
+    for (size_t c = marks[t].chunks; c < tracks[t].chunks.size() && !partial; c++) {
+      const Chunk& chunk = tracks[t].chunks[c];
+      partial = !FindMdat(mdats, chunk.offset, ChunkBytes(tracks[t], chunk, sample));
+    }
+  }
+  if (partial) {
+    for (size_t t = 0; t < marks.size(); t++) {
+      tracks[t].samples.resize(marks[t].samples);
+      tracks[t].chunks.resize(marks[t].chunks);
+      tracks[t].duration = marks[t].duration;
+    }
+    if (--result.fragments == 0) {
+      return "Input has no complete fragment";
+    }
+  }
+
+  // Map sample data to the output mdat; every run must lie inside one mdat
+  for (auto& track : tracks) {
+    size_t sample = 0;
+    for (auto& chunk : track.chunks) {
+      const MdatRange* mdat = FindMdat(mdats, chunk.offset, ChunkBytes(track, chunk, sample));
+      if (!mdat) {
+        return "Sample data outside of mdat";
+      }
+      chunk.offset = mdat->dst + (chunk.offset - mdat->src);
+    }
+    result.samples += track.samples.size();
+  }
+  result.tracks = static_cast<uint32_t>(tracks.size());
+
+  Box moov;
+  const uint8_t* p = moov_data.data();
+  NextBox(p, moov_data.data() + moov_data.size(), moov);
+
+  // Layout: ftyp, moov, mdat. Offsets depend on the moov size, which only
+  // depends on whether 64-bit chunk offsets are needed.
+  uint64_t mdat_header = payload_total + 8 > UINT32_MAX ? 16 : 8;
+  bool co64 = false;
+  std::vector<uint8_t> new_moov;
+  uint64_t data_start = 0;
+  for (int pass = 0; pass < 2; pass++) {
+    new_moov = BuildMoov(moov, tracks, movie_timescale, co64);
+    data_start = ftyp.size() + new_moov.size() + mdat_header;
+    if (co64 || data_start + payload_total <= UINT32_MAX) {
+      break;
+    }
+    co64 = true;
+  }
+  for (auto& track : tracks) {
+    for (auto& chunk : track.chunks) {
+      chunk.offset += data_start;
+    }
+  }
+  new_moov = BuildMoov(moov, tracks, movie_timescale, co64);
+
+  File out;
+  if (!out.OpenWrite(output)) {
+    return "Cannot open output: " + std::string(strerror(errno));
+  }
+
+  Writer head;
+  head.Bytes(ftyp.data(), ftyp.size());
+  head.Bytes(new_moov.data(), new_moov.size());
+  if (mdat_header == 16) {
+    head.U32(1);
+    head.U32(Tag("mdat"));
+    head.U64(payload_total + 16);
+  } else {
+    head.U32(static_cast<uint32_t>(payload_total + 8));
+    head.U32(Tag("mdat"));
+  }
+
+  bool ok = out.Write(head.buf.data(), head.buf.size());
+  std::vector<uint8_t> scratch(1024 * 1024);
+  uint64_t copied = 0;
+  for (const auto& mdat : mdats) {
+    for (uint64_t done = 0; ok && done < mdat.size; ) {
+      uint64_t step = std::min<uint64_t>(COPY_STEP, mdat.size - done);
+      ok = out.CopyFrom(in, mdat.src + done, step, scratch);
+      done += step;
+      copied += step;
+      if (progress && payload_total > 0) {
+        progress(static_cast<double>(copied) / static_cast<double>(payload_total));
+      }
+    }
+  }
+  out.Close();
+
+  if (!ok) {
+    remove(output.c_str());
+    return "Write error";
+  }
+
+  result.bytes = head.buf.size() + payload_total;
+  return "";
+}
+
+namespace {
+
+Napi::Object ResultToObject(Napi::Env env, const Mp4Defragmenter::Result& result) {
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("tracks", Napi::Number::New(env, result.tracks));
+  obj.Set("fragments", Napi::Number::New(env, static_cast<double>(result.fragments)));
+  obj.Set("samples", Napi::Number::New(env, static_cast<double>(result.samples)));
+  obj.Set("bytes", Napi::Number::New(env, static_cast<double>(result.bytes)));
+  return obj;
+}
+
+class Mp4DefragmentWorker : public Napi::AsyncProgressWorker<double> {
+public:
+  Mp4DefragmentWorker(Napi::Env env, std::string input, std::string output, Napi::Value onProgress)
+    : AsyncProgressWorker(env),
+      input_(std::move(input)),
+      output_(std::move(output)),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    if (onProgress.IsFunction()) {
+      progress_ref_ = Napi::Persistent(onProgress.As<Napi::Function>());
+    }
+  }
+
+  void Execute(const ExecutionProgress& progress) override {
+    Tracing::Scope trace("Mp4DefragmentWorker", "worker", this);
+
+    // Progress updates are coalesced; the callback sees the latest value
+    bool report = !progress_ref_.IsEmpty();
+    error_ = Mp4Defragmenter::Run(input_, output_, result_, [&progress, report](double value) {
+      if (report) {
+        progress.Send(&value, 1);
+      }
+    });
+  }
+
+  void OnProgress(const double* data, size_t count) override {
+    if (count > 0 && !progress_ref_.IsEmpty()) {
+      Napi::HandleScope scope(Env());
+      progress_ref_.Call({Napi::Number::New(Env(), data[count - 1])});
+    }
+  }
+
+  void OnOK() override {
+    Napi::HandleScope scope(Env());
+    if (!error_.empty()) {
+      deferred_.Reject(Napi::Error::New(Env(), error_).Value());
+      return;
+    }
+    deferred_.Resolve(ResultToObject(Env(), result_));
+  }
+
+  void OnError(const Napi::Error& error) override {
+    deferred_.Reject(error.Value());
+  }
+
+  Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+private:
+  std::string input_;
+  std::string output_;
+  Mp4Defragmenter::Result result_;
+  std::string error_;
+  Napi::FunctionReference progress_ref_;
+  Napi::Promise::Deferred deferred_;
+};
+
+} // namespace
+
+Napi::Object Mp4Defragmenter::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("mp4Defragment", Napi::Function::New(env, DefragmentAsync));
+  exports.Set("mp4DefragmentSync", Napi::Function::New(env, DefragmentSync));
+  return exports;
+}
+
+Napi::Value Mp4Defragmenter::DefragmentAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsString() || !info[1].IsString()) {
+    Napi::TypeError::New(env, "Expected input and output paths").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto* worker = new Mp4DefragmentWorker(env, info[0].As<Napi::String>().Utf8Value(), info[1].As<Napi::String>().Utf8Value(),
+                                         info.Length() > 2 ? info[2] : env.Undefined());
+  auto promise = worker->GetPromise();
+  worker->Queue();
+  return promise;
+}
+
+Napi::Value Mp4Defragmenter::DefragmentSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsString() || !info[1].IsString()) {
+    Napi::TypeError::New(env, "Expected input and output paths").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Result result;
+  std::string error = Run(info[0].As<Napi::String>().Utf8Value(), info[1].As<Napi::String>().Utf8Value(), result, nullptr);
+  if (!error.empty()) {
+    Napi::Error::New(env, error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return ResultToObject(env, result);
+}
+
+} // namespace ffmpeg
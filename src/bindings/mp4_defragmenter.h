@@ -0,0 +1,44 @@
+#ifndef FFMPEG_MP4_DEFRAGMENTER_H
+#define FFMPEG_MP4_DEFRAGMENTER_H
+
+#include <napi.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ffmpeg {
+
+// Single-pass conversion of fragmented MP4 (moov + moof/mdat pairs) into a
+// regular MP4 with the moov in front (faststart).
+//
+// Only the (small) moov and moof boxes are parsed; the sample index of every
+// track is rebuilt from the track fragment runs and written as a new sample
+// table. Media data is never parsed: the mdat payloads are copied in order
+// into a single mdat behind the new moov, using copy_file_range() on Linux so
+// the data does not pass through user space. This replaces both the index
+// build and the faststart rewrite of movenc's trailer.
+class Mp4Defragmenter {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  struct Result {
+    uint32_t tracks = 0;
+    uint64_t fragments = 0;
+    uint64_t samples = 0;
+    uint64_t bytes = 0;   // Output file size
+  };
+
+  // Returns an empty string on success, an error message otherwise.
+  // progress receives the copied fraction of the media data (0..1).
+  static std::string Run(const std::string& input, const std::string& output,
+                         Result& result, const std::function<void(double)>& progress);
+
+private:
+  static Napi::Value DefragmentAsync(const Napi::CallbackInfo& info);
+  static Napi::Value DefragmentSync(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_MP4_DEFRAGMENTER_H
@@ -1,4 +1,5 @@
 #include "output_format.h"
+#include "lazy_exports.h"
 
 namespace ffmpeg {
 
@@ -61,6 +62,7 @@ Napi::Value OutputFormat::GuessFormat(const Napi::CallbackInfo& info) {
     mimeType = mimeTypeStr.c_str();
   }
   
+  LazyExports::EnsureDevices();
   const AVOutputFormat* fmt = av_guess_format(shortName, filename, mimeType);
   
   if (!fmt) {
@@ -21,6 +21,7 @@ public:
 
 private:
   friend class FormatContext;
+  friend class Registry;
 
   static Napi::FunctionReference constructor;
 
@@ -19,6 +19,7 @@ Napi::Object Packet::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod<&Packet::NewSideData>("newSideData"),
     InstanceMethod<&Packet::FreeSideData>("freeSideData"),
     InstanceMethod<&Packet::Dispose>(Napi::Symbol::WellKnown(env, "dispose")),
+    InstanceMethod<&Packet::SetAllocationSite>("setAllocationSite"),
 
     InstanceAccessor<&Packet::GetStreamIndex, &Packet::SetStreamIndex>("streamIndex"),
     InstanceAccessor<&Packet::GetPts, &Packet::SetPts>("pts"),
@@ -45,7 +46,12 @@ Packet::Packet(const Napi::CallbackInfo& info)
 }
 
 Packet::~Packet() {
+  if (leak_site_ >= 0 && packet_) {
+    // Finalized by the GC while still holding its AVPacket
+    LeakDetector::Leaked(leak_site_, MemoryAccounting::PacketBytes(packet_));
+  }
   av_packet_free(&packet_);
+  account_.Release(Env());
 }
 
 Napi::Value Packet::Alloc(const Napi::CallbackInfo& info) {
@@ -58,14 +64,18 @@ Napi::Value Packet::Alloc(const Napi::CallbackInfo& info) {
   }
 
   av_packet_free(&packet_);
+  ClearLeakSite();
 
   packet_ = pkt;
+  TrackMemory();
   return env.Undefined();
 }
 
 Napi::Value Packet::Free(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   av_packet_free(&packet_);
+  ClearLeakSite();
+  account_.Release(env);
   return env.Undefined();
 }
 
@@ -88,6 +98,7 @@ Napi::Value Packet::Ref(const Napi::CallbackInfo& info) {
   }
   
   int ret = av_packet_ref(packet_, src->Get());
+  TrackMemory();
   return Napi::Number::New(env, ret);
 }
 
@@ -96,6 +107,7 @@ Napi::Value Packet::Unref(const Napi::CallbackInfo& info) {
   
   if (packet_) {
     av_packet_unref(packet_);
+    TrackMemory();
   }
   
   return env.Undefined();
@@ -117,6 +129,7 @@ Napi::Value Packet::Clone(const Napi::CallbackInfo& info) {
   Napi::Object newPacket = constructor.New({});
   Packet* wrapper = Napi::ObjectWrap<Packet>::Unwrap(newPacket);
   wrapper->packet_ = cloned;
+  wrapper->TrackMemory();
 
   return newPacket;
 }
@@ -149,6 +162,7 @@ Napi::Value Packet::MakeRefcounted(const Napi::CallbackInfo& info) {
   }
   
   int ret = av_packet_make_refcounted(packet_);
+  TrackMemory();
   return Napi::Number::New(env, ret);
 }
 
@@ -160,6 +174,7 @@ Napi::Value Packet::MakeWritable(const Napi::CallbackInfo& info) {
   }
   
   int ret = av_packet_make_writable(packet_);
+  TrackMemory();
   return Napi::Number::New(env, ret);
 }
 
@@ -223,6 +238,7 @@ Napi::Value Packet::AddSideData(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
   
+  TrackMemory();
   return Napi::Number::New(env, 0);
 }
 
@@ -247,6 +263,7 @@ Napi::Value Packet::NewSideData(const Napi::CallbackInfo& info) {
     Napi::Error::New(env, "Failed to allocate new side data").ThrowAsJavaScriptException();
     return env.Undefined();
   }
+  TrackMemory();
   
   // Return as Buffer that references the side data (not a copy)
   // Note: The buffer lifetime is tied to the packet
@@ -264,6 +281,7 @@ Napi::Value Packet::FreeSideData(const Napi::CallbackInfo& info) {
   }
 
   av_packet_free_side_data(packet_);
+  TrackMemory();
   return env.Undefined();
 }
 
@@ -408,6 +426,7 @@ void Packet::SetData(const Napi::CallbackInfo& info, const Napi::Value& value) {
   if (value.IsNull() || value.IsUndefined()) {
     // Clear data
     av_packet_unref(packet_);
+    TrackMemory();
     return;
   }
   
@@ -428,6 +447,7 @@ void Packet::SetData(const Napi::CallbackInfo& info, const Napi::Value& value) {
   
   // Copy data
   memcpy(packet_->data, buffer.Data(), size);
+  TrackMemory();
 }
 
 Napi::Value Packet::GetIsKeyframe(const Napi::CallbackInfo& info) {
@@ -452,4 +472,33 @@ Napi::Value Packet::Dispose(const Napi::CallbackInfo& info) {
   return Free(info);
 }
 
-} // namespace ffmpeg
\ No newline at end of file
+Napi::Value Packet::SetAllocationSite(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Site id (number) required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!LeakDetector::Enabled() || !packet_) {
+    return env.Undefined();
+  }
+
+  int32_t site = info[0].As<Napi::Number>().Int32Value();
+  bool handover = info.Length() > 1 && info[1].IsBoolean() && info[1].As<Napi::Boolean>().Value();
+  if (handover) {
+    // Attribute a tracked packet to the code it was handed to
+    if (leak_site_ >= 0) {
+      LeakDetector::Moved(leak_site_, site);
+      leak_site_ = site;
+    }
+    return env.Undefined();
+  }
+
+  ClearLeakSite();
+  leak_site_ = site;
+  LeakDetector::Allocated(leak_site_);
+  return env.Undefined();
+}
+
+} // namespace ffmpeg
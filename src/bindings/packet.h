@@ -3,6 +3,8 @@
 
 #include <napi.h>
 #include "common.h"
+#include "memory_accounting.h"
+#include "leak_detector.h"
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -18,6 +20,14 @@ public:
 
   AVPacket* Get() { return packet_; }
 
+  // Re-measure for memory accounting after native code filled or released
+  // the packet (read, receive, ref)
+  void TrackMemory() {
+    if (account_.Active()) {
+      account_.Update(Env(), MemoryAccounting::PacketBytes(packet_));
+    }
+  }
+
 private:
   friend class Stream;
   friend class SyncQueue;
@@ -25,6 +35,16 @@ private:
   static Napi::FunctionReference constructor;
 
   AVPacket* packet_ = nullptr;
+  MemoryAccounting::Account account_{MemoryAccounting::kPacket};
+  int32_t leak_site_ = -1;  // Allocation site while leak detection is enabled
+
+  // Explicitly freed or replaced; no longer a leak candidate
+  void ClearLeakSite() {
+    if (leak_site_ >= 0) {
+      LeakDetector::Freed(leak_site_);
+      leak_site_ = -1;
+    }
+  }
 
   Napi::Value Alloc(const Napi::CallbackInfo& info);
   Napi::Value Free(const Napi::CallbackInfo& info);
@@ -39,6 +59,7 @@ private:
   Napi::Value NewSideData(const Napi::CallbackInfo& info);
   Napi::Value FreeSideData(const Napi::CallbackInfo& info);
   Napi::Value Dispose(const Napi::CallbackInfo& info);
+  Napi::Value SetAllocationSite(const Napi::CallbackInfo& info);
 
   Napi::Value GetStreamIndex(const Napi::CallbackInfo& info);
   void SetStreamIndex(const Napi::CallbackInfo& info, const Napi::Value& value);
@@ -0,0 +1,274 @@
+#include "packet_pacer.h"
+#include <algorithm>
+
+extern "C" {
+#include <libavutil/avutil.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference PacketPacer::constructor;
+
+Napi::Object PacketPacer::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "PacketPacer", {
+    StaticMethod<&PacketPacer::Create>("create"),
+    InstanceMethod<&PacketPacer::Wait>("wait"),
+    InstanceMethod<&PacketPacer::Reset>("reset"),
+    InstanceMethod<&PacketPacer::Close>("close"),
+    InstanceMethod<&PacketPacer::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &PacketPacer::Dispose),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("PacketPacer", func);
+  return exports;
+}
+
+PacketPacer::PacketPacer(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<PacketPacer>(info) {
+  // Created via PacketPacer.create()
+}
+
+PacketPacer::~PacketPacer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+Napi::Value PacketPacer::Create(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object obj = constructor.New({});
+  PacketPacer* pacer = Napi::ObjectWrap<PacketPacer>::Unwrap(obj);
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+
+    Napi::Value v = options.Get("speed");
+    if (v.IsNumber()) {
+      double speed = v.As<Napi::Number>().DoubleValue();
+      if (!(speed > 0)) {
+        Napi::RangeError::New(env, "speed must be greater than 0").ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      pacer->speed_ = speed;
+    }
+
+    // Durations are given in seconds
+    v = options.Get("initialBurst");
+    if (v.IsNumber()) {
+      pacer->initial_burst_us_ = static_cast<int64_t>(std::max(0.0, v.As<Napi::Number>().DoubleValue()) * AV_TIME_BASE);
+    }
+    v = options.Get("maxLag");
+    if (v.IsNumber()) {
+      pacer->max_lag_us_ = static_cast<int64_t>(std::max(0.0, v.As<Napi::Number>().DoubleValue()) * AV_TIME_BASE);
+    }
+    v = options.Get("maxJump");
+    if (v.IsNumber()) {
+      pacer->max_jump_us_ = static_cast<int64_t>(std::max(0.0, v.As<Napi::Number>().DoubleValue()) * AV_TIME_BASE);
+    }
+  }
+
+  return obj;
+}
+
+PacketPacer::Clock::time_point PacketPacer::Schedule(int64_t ts_us, Clock::time_point now) {
+  bool jumped = anchored_ && (ts_us > last_ts_ + max_jump_us_ || ts_us < last_ts_ - max_jump_us_);
+  last_ts_ = ts_us;
+
+  if (!anchored_ || jumped) {
+    // The initial burst releases the first part of the media immediately
+    int64_t burst = anchored_ ? 0 : initial_burst_us_;
+    if (anchored_) {
+      reanchors_++;
+    }
+    anchored_ = true;
+    anchor_wall_ = now;
+    anchor_ts_ = ts_us + burst;
+  }
+
+  auto offset = std::chrono::microseconds(static_cast<int64_t>((ts_us - anchor_ts_) / speed_));
+  Clock::time_point deadline = anchor_wall_ + offset;
+
+  if (ts_us >= anchor_ts_ && now > deadline) {
+    auto late = now - deadline;
+    if (late > std::chrono::microseconds(max_lag_us_)) {
+      // Consumer or source stalled: continue from here instead of bursting to catch up
+      reanchors_++;
+      anchor_wall_ = now;
+      anchor_ts_ = ts_us;
+      return now;
+    }
+
+    double late_ms = std::chrono::duration<double, std::milli>(late).count();
+    if (late_ms > 1.0) {
+      late_++;
+      max_late_ms_ = std::max(max_late_ms_, late_ms);
+    }
+  }
+
+  return deadline;
+}
+
+Napi::Value PacketPacer::Wait(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsBigInt() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Expected 2 arguments: timestamp (bigint), timeBase").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (deferred_) {
+    Napi::Error::New(env, "A wait() call is pending").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  bool lossless;
+  int64_t ts = info[0].As<Napi::BigInt>().Int64Value(&lossless);
+  Napi::Object tbObj = info[1].As<Napi::Object>();
+  AVRational tb = {
+    tbObj.Get("num").As<Napi::Number>().Int32Value(),
+    tbObj.Get("den").As<Napi::Number>().Int32Value(),
+  };
+
+  // Unpaceable packets are released immediately
+  if (closed_ || ts == AV_NOPTS_VALUE || tb.num <= 0 || tb.den <= 0) {
+    released_++;
+    return env.Null();
+  }
+
+  Clock::time_point now = Clock::now();
+  Clock::time_point deadline = Schedule(av_rescale_q(ts, tb, AV_TIME_BASE_Q), now);
+  released_++;
+
+  // Fast path: already due, no promise and no thread hop
+  if (deadline <= now) {
+    return env.Null();
+  }
+
+  waited_++;
+  auto deferred = Napi::Promise::Deferred::New(env);
+  deferred_ = std::make_unique<Napi::Promise::Deferred>(deferred);
+  EnsureTsfn(env);
+  tsfn_.Ref(env);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = true;
+    deadline_ = deadline;
+  }
+  if (!thread_.joinable()) {
+    thread_ = std::thread(&PacketPacer::Run, this);
+  }
+  cv_.notify_one();
+
+  return deferred.Promise();
+}
+
+void PacketPacer::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!closed_) {
+    if (!pending_) {
+      cv_.wait(lock, [this]() { return pending_ || closed_; });
+      continue;
+    }
+    if (Clock::now() < deadline_) {
+      cv_.wait_until(lock, deadline_);
+      continue;
+    }
+
+    pending_ = false;
+    tsfn_.NonBlockingCall(this, [](Napi::Env env, Napi::Function, PacketPacer* pacer) {
+      Napi::HandleScope scope(env);
+      pacer->Settle();
+    });
+  }
+}
+
+void PacketPacer::Settle() {
+  if (!deferred_) {
+    return;
+  }
+
+  auto deferred = std::move(deferred_);
+  Napi::Env env = deferred->Env();
+  if (has_tsfn_) {
+    tsfn_.Unref(env);
+  }
+  deferred->Resolve(env.Undefined());
+}
+
+void PacketPacer::EnsureTsfn(Napi::Env env) {
+  if (has_tsfn_) {
+    return;
+  }
+
+  // The pacer must outlive queued wakeups: the finalizer drops the self reference
+  self_ref_.Reset(Value(), 1);
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "PacketPacerWakeup",
+    0,  // Unlimited queue
+    1,  // One thread
+    [this](Napi::Env) { self_ref_.Reset(); }
+  );
+  tsfn_.Unref(env);
+  has_tsfn_ = true;
+}
+
+void PacketPacer::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    pending_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  // Release a pending wait right away
+  Settle();
+  if (has_tsfn_) {
+    has_tsfn_ = false;
+    tsfn_.Release();
+  }
+}
+
+Napi::Value PacketPacer::Reset(const Napi::CallbackInfo& info) {
+  // Next packet becomes the new anchor (after seeking or looping)
+  anchored_ = false;
+  return info.Env().Undefined();
+}
+
+Napi::Value PacketPacer::Close(const Napi::CallbackInfo& info) {
+  Shutdown();
+  return info.Env().Undefined();
+}
+
+Napi::Value PacketPacer::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("released", Napi::Number::New(env, static_cast<double>(released_)));
+  stats.Set("waited", Napi::Number::New(env, static_cast<double>(waited_)));
+  stats.Set("late", Napi::Number::New(env, static_cast<double>(late_)));
+  stats.Set("maxLateMs", Napi::Number::New(env, max_late_ms_));
+  stats.Set("reanchors", Napi::Number::New(env, static_cast<double>(reanchors_)));
+
+  return stats;
+}
+
+Napi::Value PacketPacer::Dispose(const Napi::CallbackInfo& info) {
+  return Close(info);
+}
+
+} // namespace ffmpeg
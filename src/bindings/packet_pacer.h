@@ -0,0 +1,92 @@
+#ifndef FFMPEG_PACKET_PACER_H
+#define FFMPEG_PACKET_PACER_H
+
+#include <napi.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "common.h"
+
+namespace ffmpeg {
+
+// Real-time packet pacing (native equivalent of ffmpeg -re / -readrate).
+//
+// Release times are derived from packet timestamps relative to one wall clock
+// anchor, so sleep overshoot does not accumulate into drift. Packets that are
+// already due are released synchronously; otherwise a dedicated timer thread
+// waits on a steady clock and resolves the pending promise through a
+// ThreadSafeFunction, so neither the event loop nor a libuv threadpool thread
+// is blocked.
+//
+// The anchor is moved when the timestamps jump (discontinuity, loop) or when
+// the consumer fell behind by more than maxLag, so a stall is followed by
+// steady pacing instead of a catch-up burst.
+class PacketPacer : public Napi::ObjectWrap<PacketPacer> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  PacketPacer(const Napi::CallbackInfo& info);
+  ~PacketPacer();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  static Napi::FunctionReference constructor;
+
+  // Static methods
+  static Napi::Value Create(const Napi::CallbackInfo& info);
+
+  // Instance methods
+  Napi::Value Wait(const Napi::CallbackInfo& info);
+  Napi::Value Reset(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  // Main thread
+  Clock::time_point Schedule(int64_t ts_us, Clock::time_point now);
+  void Settle();
+  void EnsureTsfn(Napi::Env env);
+  void Shutdown();
+
+  // Timer thread
+  void Run();
+
+  // Options
+  double speed_ = 1.0;
+  int64_t initial_burst_us_ = 0;
+  int64_t max_lag_us_ = 1000000;
+  int64_t max_jump_us_ = 10000000;
+
+  // Clock anchor (main thread only)
+  bool anchored_ = false;
+  Clock::time_point anchor_wall_;
+  int64_t anchor_ts_ = 0;
+  int64_t last_ts_ = 0;
+
+  // Pending wait, shared with the timer thread
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool pending_ = false;
+  bool closed_ = false;
+  Clock::time_point deadline_;
+  std::unique_ptr<Napi::Promise::Deferred> deferred_;
+
+  // JS wakeups
+  Napi::ThreadSafeFunction tsfn_;
+  bool has_tsfn_ = false;
+  Napi::ObjectReference self_ref_;
+
+  // Statistics (main thread only)
+  uint64_t released_ = 0;
+  uint64_t waited_ = 0;
+  uint64_t late_ = 0;
+  uint64_t reanchors_ = 0;
+  double max_late_ms_ = 0;
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_PACKET_PACER_H
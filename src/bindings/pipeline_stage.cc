@@ -0,0 +1,992 @@
+#include "pipeline_stage.h"
+#include "bitstream_filter_context.h"
+#include "codec_context.h"
+#include "filter_context.h"
+#include "frame.h"
+#include "packet.h"
+#include "tracing.h"
+#include <chrono>
+#include <cstring>
+
+extern "C" {
+#include <libavcodec/bsf.h>
+#include <libavfilter/buffersink.h>
+#include <libavfilter/buffersrc.h>
+}
+
+namespace ffmpeg {
+
+static constexpr size_t DEFAULT_QUEUE_SIZE = 16;
+static constexpr size_t MAX_QUEUE_SIZE = 4096;
+
+// Backstop for the (already race-free) sleeping-flag handshake
+static constexpr auto WAIT_SLICE = std::chrono::milliseconds(20);
+
+static const char* KindName(StageKind kind) {
+  switch (kind) {
+    case StageKind::BitStreamFilter: return "bsf";
+    case StageKind::Decoder: return "decoder";
+    case StageKind::Encoder: return "encoder";
+    case StageKind::Filter: return "filter";
+  }
+  return "unknown";
+}
+
+Napi::FunctionReference PipelineStage::constructor;
+
+class PSStopWorker : public Napi::AsyncWorker {
+public:
+  PSStopWorker(Napi::Env env, Napi::Object parentObj, PipelineStage* parent)
+    : AsyncWorker(env),
+      parent_(parent),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    parent_ref_.Reset(parentObj, 1);
+  }
+
+  ~PSStopWorker() {
+    parent_ref_.Reset();
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("PSStopWorker", "worker", parent_);
+
+    // Joining may wait for an in-flight encode/filter call
+    parent_->Stop();
+  }
+
+  void OnOK() override {
+    Napi::HandleScope scope(Env());
+    parent_->ReleaseJs();
+    deferred_.Resolve(Env().Undefined());
+  }
+
+  void OnError(const Napi::Error& error) override {
+    deferred_.Reject(error.Value());
+  }
+
+  Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+private:
+  Napi::ObjectReference parent_ref_;
+  PipelineStage* parent_;
+  Napi::Promise::Deferred deferred_;
+};
+
+Napi::Object PipelineStage::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "PipelineStage", {
+    StaticMethod<&PipelineStage::Create>("create"),
+    InstanceMethod<&PipelineStage::Connect>("connect"),
+    InstanceMethod<&PipelineStage::Start>("start"),
+    InstanceMethod<&PipelineStage::Push>("push"),
+    InstanceMethod<&PipelineStage::PushAsync>("pushAsync"),
+    InstanceMethod<&PipelineStage::Pull>("pull"),
+    InstanceMethod<&PipelineStage::PullAsync>("pullAsync"),
+    InstanceMethod<&PipelineStage::StopAsync>("stop"),
+    InstanceMethod<&PipelineStage::StopSync>("stopSync"),
+    InstanceMethod<&PipelineStage::GetStats>("getStats"),
+
+    InstanceAccessor<&PipelineStage::GetKind>("kind"),
+    InstanceAccessor<&PipelineStage::GetIsRunning>("isRunning"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("PipelineStage", func);
+  return exports;
+}
+
+PipelineStage::PipelineStage(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<PipelineStage>(info) {
+  // Created via PipelineStage.create()
+}
+
+PipelineStage::~PipelineStage() {
+  // Do not touch next_ here: it may already be finalized during env teardown.
+  // A worker blocked on the downstream queue notices abort_ within WAIT_SLICE.
+  abort_ = true;
+  Interrupt();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  void* item = nullptr;
+  if (in_queue_) {
+    while (in_queue_->TryPop(item)) {
+      FreeItem(item, InputIsFrame());
+    }
+  }
+  if (out_queue_) {
+    while (out_queue_->TryPop(item)) {
+      FreeItem(item, OutputIsFrame());
+    }
+  }
+  FreeItem(push_item_, InputIsFrame());
+  push_item_ = nullptr;
+
+  if (scratch_packet_) {
+    av_packet_free(&scratch_packet_);
+  }
+  if (scratch_frame_) {
+    av_frame_free(&scratch_frame_);
+  }
+}
+
+void PipelineStage::FreeItem(void* item, bool frame) {
+  if (!item) {
+    return;
+  }
+  if (frame) {
+    AVFrame* f = static_cast<AVFrame*>(item);
+    av_frame_free(&f);
+  } else {
+    AVPacket* p = static_cast<AVPacket*>(item);
+    av_packet_free(&p);
+  }
+}
+
+Napi::Value PipelineStage::Create(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Expected at least 2 arguments: kind, context").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::string kindName = info[0].As<Napi::String>().Utf8Value();
+
+  size_t queue_size = DEFAULT_QUEUE_SIZE;
+  if (info.Length() > 3 && info[3].IsObject()) {
+    Napi::Value v = info[3].As<Napi::Object>().Get("queueSize");
+    if (v.IsNumber()) {
+      double value = v.As<Napi::Number>().DoubleValue();
+      if (value < 1 || value > MAX_QUEUE_SIZE) {
+        Napi::RangeError::New(env, "queueSize must be between 1 and 4096").ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      queue_size = static_cast<size_t>(value);
+    }
+  }
+
+  Napi::Object obj = constructor.New({});
+  PipelineStage* stage = Napi::ObjectWrap<PipelineStage>::Unwrap(obj);
+
+  if (kindName == "bsf") {
+    BitStreamFilterContext* bsf = UnwrapNativeObject<BitStreamFilterContext>(env, info[1], "BitStreamFilterContext");
+    if (!bsf || !bsf->Get()) {
+      Napi::TypeError::New(env, "bsf stage requires an initialized BitStreamFilterContext").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    stage->kind_ = StageKind::BitStreamFilter;
+    stage->bsf_ = bsf->Get();
+  } else if (kindName == "decoder" || kindName == "encoder") {
+    bool decoder = kindName == "decoder";
+    CodecContext* codec = UnwrapNativeObject<CodecContext>(env, info[1], "CodecContext");
+    AVCodecContext* ctx = codec ? codec->Get() : nullptr;
+    if (!ctx || !avcodec_is_open(ctx) || !ctx->codec ||
+        (decoder ? !av_codec_is_decoder(ctx->codec) : !av_codec_is_encoder(ctx->codec))) {
+      Napi::TypeError::New(env, decoder ? "decoder stage requires an opened decoder CodecContext"
+                                        : "encoder stage requires an opened encoder CodecContext")
+        .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    stage->kind_ = decoder ? StageKind::Decoder : StageKind::Encoder;
+    stage->codec_ = ctx;
+  } else if (kindName == "filter") {
+    FilterContext* src = UnwrapNativeObject<FilterContext>(env, info[1], "FilterContext");
+    FilterContext* sink = info.Length() > 2 ? UnwrapNativeObject<FilterContext>(env, info[2], "FilterContext") : nullptr;
+    AVFilterContext* src_ctx = src ? src->Get() : nullptr;
+    AVFilterContext* sink_ctx = sink ? sink->Get() : nullptr;
+    if (!src_ctx || !sink_ctx || !src_ctx->filter || !sink_ctx->filter ||
+        (strcmp(src_ctx->filter->name, "buffer") != 0 && strcmp(src_ctx->filter->name, "abuffer") != 0) ||
+        (strcmp(sink_ctx->filter->name, "buffersink") != 0 && strcmp(sink_ctx->filter->name, "abuffersink") != 0)) {
+      Napi::TypeError::New(env, "filter stage requires buffersrc and buffersink FilterContexts").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    stage->kind_ = StageKind::Filter;
+    stage->buffersrc_ = src_ctx;
+    stage->buffersink_ = sink_ctx;
+    stage->context_refs_[1].Reset(info[2].As<Napi::Object>(), 1);
+  } else {
+    Napi::TypeError::New(env, "kind must be one of 'bsf', 'decoder', 'encoder', 'filter'").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  stage->context_refs_[0].Reset(info[1].As<Napi::Object>(), 1);
+  stage->in_queue_ = std::make_unique<SpscQueue<void*>>(queue_size);
+  stage->out_queue_ = std::make_unique<SpscQueue<void*>>(queue_size);
+
+  return obj;
+}
+
+// Media type produced by this stage, AVMEDIA_TYPE_UNKNOWN if not known up front
+static AVMediaType OutputMediaType(StageKind kind, AVCodecContext* codec, AVFilterContext* sink) {
+  if (kind == StageKind::Decoder) {
+    return codec->codec_type;
+  }
+  if (kind == StageKind::Filter) {
+    return av_buffersink_get_type(sink);
+  }
+  return AVMEDIA_TYPE_UNKNOWN;
+}
+
+// Media type accepted by this stage, AVMEDIA_TYPE_UNKNOWN if not known up front
+static AVMediaType InputMediaType(StageKind kind, AVCodecContext* codec, AVFilterContext* src) {
+  if (kind == StageKind::Encoder) {
+    return codec->codec_type;
+  }
+  if (kind == StageKind::Filter) {
+    return strcmp(src->filter->name, "abuffer") == 0 ? AVMEDIA_TYPE_AUDIO : AVMEDIA_TYPE_VIDEO;
+  }
+  return AVMEDIA_TYPE_UNKNOWN;
+}
+
+Napi::Value PipelineStage::Connect(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  PipelineStage* next = info.Length() > 0 ? UnwrapNativeObject<PipelineStage>(env, info[0], "PipelineStage") : nullptr;
+  if (!next) {
+    Napi::TypeError::New(env, "Expected a PipelineStage").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (next == this) {
+    Napi::Error::New(env, "Cannot connect a stage to itself").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (started_ || next->started_) {
+    Napi::Error::New(env, "Stages must be connected before start()").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (next_ || next->has_upstream_) {
+    Napi::Error::New(env, "Stage is already connected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (OutputIsFrame() != next->InputIsFrame()) {
+    Napi::TypeError::New(env, std::string("Cannot connect ") + KindName(kind_) + " output to " +
+                              KindName(next->kind_) + " input")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  AVMediaType out_type = OutputMediaType(kind_, codec_, buffersink_);
+  AVMediaType in_type = InputMediaType(next->kind_, next->codec_, next->buffersrc_);
+  if (out_type != AVMEDIA_TYPE_UNKNOWN && in_type != AVMEDIA_TYPE_UNKNOWN && out_type != in_type) {
+    Napi::TypeError::New(env, "Connected stages have different media types").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  next_ = next;
+  next_ref_.Reset(info[0].As<Napi::Object>(), 1);
+  next->has_upstream_ = true;
+
+  return env.Undefined();
+}
+
+Napi::Value PipelineStage::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (started_) {
+    Napi::Error::New(env, "Stage already started").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  started_ = true;
+  running_ = true;
+  thread_ = std::thread(&PipelineStage::Run, this);
+
+  return env.Undefined();
+}
+
+// ============================================================================
+// Worker thread
+// ============================================================================
+
+template <typename Ready>
+void PipelineStage::Wait(std::condition_variable& cv, std::atomic<bool>& sleeping, Ready ready) {
+  std::unique_lock<std::mutex> lock(wait_mutex_);
+  sleeping.store(true);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  while (!ready() && !abort_.load()) {
+    cv.wait_for(lock, WAIT_SLICE);
+  }
+  sleeping.store(false);
+}
+
+void PipelineStage::Wake(std::condition_variable& cv, std::atomic<bool>& sleeping) {
+  // Pairs with the fence in Wait(): either the waiter sees the new state or we
+  // see it sleeping. Only then is the mutex touched.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping.load()) {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    cv.notify_all();
+  }
+}
+
+void PipelineStage::Interrupt() {
+  std::lock_guard<std::mutex> lock(wait_mutex_);
+  input_cv_.notify_all();
+  space_cv_.notify_all();
+  output_cv_.notify_all();
+}
+
+void PipelineStage::WakeJs() {
+  tsfn_.NonBlockingCall(this, [](Napi::Env env, Napi::Function, PipelineStage* stage) {
+    Napi::HandleScope scope(env);
+    stage->SettleAll();
+  });
+}
+
+bool PipelineStage::Enqueue(void* item, const std::atomic<bool>& caller_abort) {
+  while (!in_queue_->TryPush(item)) {
+    if (abort_.load() || finished_.load() || caller_abort.load()) {
+      return false;
+    }
+    input_stalls_++;
+    Wait(space_cv_, space_waiting_, [this, &caller_abort]() {
+      return !in_queue_->Full() || finished_.load() || caller_abort.load();
+    });
+  }
+  Wake(input_cv_, input_waiting_);
+  return true;
+}
+
+void PipelineStage::Run() {
+  int ret = 0;
+  void* item = nullptr;
+
+  for (;;) {
+    if (abort_.load()) {
+      ret = AVERROR_EXIT;
+      break;
+    }
+
+    if (!in_queue_->TryPop(item)) {
+      Wait(input_cv_, input_waiting_, [this]() { return !in_queue_->Empty(); });
+      continue;
+    }
+
+    // A slot was freed: release a blocked producer
+    Wake(space_cv_, space_waiting_);
+    if (js_push_waiting_.exchange(false)) {
+      WakeJs();
+    }
+
+    if (item) {
+      input_items_++;
+    }
+
+    ret = Process(item);
+    if (ret < 0 || !item) {
+      break;
+    }
+  }
+
+  Finish(ret);
+  running_ = false;
+}
+
+int PipelineStage::Process(void* item) {
+  if (item && kind_ == StageKind::Encoder) {
+    // Same adjustments as the Encoder API (adjust_frame_pts_to_encoder_tb)
+    AVFrame* frame = static_cast<AVFrame*>(item);
+    AVRational src_tb = frame->time_base;
+    bool valid_tb = src_tb.num > 0 && src_tb.den > 0;
+
+    frame->pict_type = AV_PICTURE_TYPE_NONE;
+    int64_t duration = 1;
+    if (frame->duration > 0) {
+      duration = valid_tb ? av_rescale_q(frame->duration, src_tb, codec_->time_base) : frame->duration;
+    }
+    if (frame->pts != AV_NOPTS_VALUE && valid_tb) {
+      frame->pts = av_rescale_q(frame->pts, src_tb, codec_->time_base);
+      frame->time_base = codec_->time_base;
+    }
+    frame->duration = duration;
+
+    if (codec_->codec_type == AVMEDIA_TYPE_VIDEO && codec_->global_quality > 0 && frame->quality <= 0) {
+      frame->quality = codec_->global_quality;
+    }
+  } else if (item && kind_ == StageKind::Filter) {
+    // Same rescaling as FilterAPI.process(): the buffer source expects its configured time base
+    AVFrame* frame = static_cast<AVFrame*>(item);
+    AVRational src_tb = frame->time_base;
+    AVRational dst_tb = buffersrc_->outputs[0]->time_base;
+    if (src_tb.num > 0 && src_tb.den > 0 && av_cmp_q(src_tb, dst_tb) != 0) {
+      if (frame->pts != AV_NOPTS_VALUE) {
+        frame->pts = av_rescale_q(frame->pts, src_tb, dst_tb);
+      }
+      frame->duration = av_rescale_q(frame->duration, src_tb, dst_tb);
+      frame->time_base = dst_tb;
+    }
+  }
+
+  int ret = SendInput(item);
+  while (ret == AVERROR(EAGAIN)) {
+    // Output must be drained before more input is accepted
+    ret = Drain();
+    if (ret < 0) {
+      break;
+    }
+    ret = SendInput(item);
+  }
+
+  FreeItem(item, InputIsFrame());
+
+  if (ret < 0 && ret != AVERROR_EOF) {
+    return ret;
+  }
+  return Drain();
+}
+
+int PipelineStage::SendInput(void* item) {
+  switch (kind_) {
+    case StageKind::BitStreamFilter:
+      // Takes the packet reference on success, NULL signals EOF
+      return av_bsf_send_packet(bsf_, static_cast<AVPacket*>(item));
+    case StageKind::Decoder: {
+      Tracing::Scope trace("avcodec_send_packet", "ffmpeg", this);
+      return avcodec_send_packet(codec_, static_cast<AVPacket*>(item));
+    }
+    case StageKind::Encoder:
+      return avcodec_send_frame(codec_, static_cast<AVFrame*>(item));
+    case StageKind::Filter:
+      // Takes the frame reference, NULL signals EOF
+      return av_buffersrc_add_frame_flags(buffersrc_, static_cast<AVFrame*>(item), 0);
+  }
+  return AVERROR_BUG;
+}
+
+int PipelineStage::Drain() {
+  for (;;) {
+    if (abort_.load()) {
+      return AVERROR_EXIT;
+    }
+
+    void* out = nullptr;
+    int ret;
+
+    if (OutputIsFrame()) {
+      if (!scratch_frame_ && !(scratch_frame_ = av_frame_alloc())) {
+        return AVERROR(ENOMEM);
+      }
+      AVFrame* frame = scratch_frame_;
+
+      if (kind_ == StageKind::Decoder) {
+        ret = avcodec_receive_frame(codec_, frame);
+        if (ret >= 0) {
+          // Same timestamp handling as the Decoder API
+          frame->pts = frame->best_effort_timestamp;
+          frame->time_base = codec_->pkt_timebase;
+          if (frame->pts == AV_NOPTS_VALUE) {
+            frame->pts = last_pts_ == AV_NOPTS_VALUE ? 0 : last_pts_ + last_duration_;
+          }
+          last_pts_ = frame->pts;
+          last_duration_ = frame->duration > 0 ? frame->duration : 1;
+        }
+      } else {
+        ret = av_buffersink_get_frame(buffersink_, frame);
+        if (ret >= 0) {
+          // Same as FilterAPI: output time base, video duration from the sink frame rate
+          frame->time_base = av_buffersink_get_time_base(buffersink_);
+          AVRational rate = av_buffersink_get_frame_rate(buffersink_);
+          if (frame->width > 0 && frame->duration == 0 && rate.num > 0 && rate.den > 0) {
+            frame->duration = av_rescale_q(1, av_inv_q(rate), frame->time_base);
+          }
+        }
+      }
+
+      if (ret < 0) {
+        return ret == AVERROR(EAGAIN) || ret == AVERROR_EOF ? 0 : ret;
+      }
+      out = frame;
+      scratch_frame_ = nullptr;
+    } else {
+      if (!scratch_packet_ && !(scratch_packet_ = av_packet_alloc())) {
+        return AVERROR(ENOMEM);
+      }
+      AVPacket* pkt = scratch_packet_;
+
+      if (kind_ == StageKind::BitStreamFilter) {
+        ret = av_bsf_receive_packet(bsf_, pkt);
+        if (ret >= 0) {
+          pkt->time_base = bsf_->time_base_out;
+        }
+      } else {
+        ret = avcodec_receive_packet(codec_, pkt);
+        if (ret >= 0) {
+          // Same as Encoder.receive()
+          pkt->time_base = codec_->time_base;
+          pkt->flags |= AV_PKT_FLAG_TRUSTED;
+        }
+      }
+
+      if (ret < 0) {
+        return ret == AVERROR(EAGAIN) || ret == AVERROR_EOF ? 0 : ret;
+      }
+      out = pkt;
+      scratch_packet_ = nullptr;
+    }
+
+    ret = Emit(out);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+}
+
+int PipelineStage::Emit(void* item) {
+  if (next_) {
+    if (!next_->Enqueue(item, abort_)) {
+      FreeItem(item, OutputIsFrame());
+      return AVERROR_EXIT;
+    }
+    output_items_++;
+    return 0;
+  }
+
+  while (!out_queue_->TryPush(item)) {
+    output_stalls_++;
+    Wait(output_cv_, output_waiting_, [this]() { return !out_queue_->Full(); });
+    if (abort_.load()) {
+      FreeItem(item, OutputIsFrame());
+      return AVERROR_EXIT;
+    }
+  }
+
+  output_items_++;
+  if (js_pull_waiting_.exchange(false)) {
+    WakeJs();
+  }
+  return 0;
+}
+
+void PipelineStage::Finish(int ret) {
+  if (ret >= 0) {
+    ret = upstream_error_.load();
+  }
+  error_ = ret < 0 ? ret : 0;
+  finished_ = true;
+
+  // Producers blocked on our input queue re-check finished_
+  Interrupt();
+  if (js_push_waiting_.exchange(false)) {
+    WakeJs();
+  }
+
+  if (next_) {
+    if (ret < 0) {
+      next_->upstream_error_ = ret;
+    }
+    // End of stream marker; skipped if either side is aborting
+    next_->Enqueue(nullptr, abort_);
+    return;
+  }
+
+  // End of stream marker for pull(); PullInto() also checks finished_
+  if (!abort_.load()) {
+    while (!out_queue_->TryPush(nullptr)) {
+      Wait(output_cv_, output_waiting_, [this]() { return !out_queue_->Full(); });
+      if (abort_.load()) {
+        break;
+      }
+    }
+  }
+  if (js_pull_waiting_.exchange(false)) {
+    WakeJs();
+  }
+}
+
+void PipelineStage::Stop() {
+  abort_ = true;
+  Interrupt();
+  if (next_) {
+    // Release our worker if it is blocked on the downstream queue
+    next_->Interrupt();
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  running_ = false;
+  finished_ = true;
+}
+
+// ============================================================================
+// Main thread
+// ============================================================================
+
+void* PipelineStage::RefInput(const Napi::Value& value, bool& ok) {
+  Napi::Env env = value.Env();
+  ok = true;
+
+  if (value.IsNull() || value.IsUndefined()) {
+    return nullptr;
+  }
+
+  if (InputIsFrame()) {
+    Frame* frame = UnwrapNativeObject<Frame>(env, value, "Frame");
+    if (!frame || !frame->Get()) {
+      ok = false;
+      Napi::TypeError::New(env, "Expected an allocated Frame or null").ThrowAsJavaScriptException();
+      return nullptr;
+    }
+    AVFrame* ref = av_frame_alloc();
+    if (!ref || av_frame_ref(ref, frame->Get()) < 0) {
+      av_frame_free(&ref);
+      ok = false;
+      Napi::Error::New(env, "Failed to reference frame").ThrowAsJavaScriptException();
+      return nullptr;
+    }
+    return ref;
+  }
+
+  Packet* packet = UnwrapNativeObject<Packet>(env, value, "Packet");
+  if (!packet || !packet->Get()) {
+    ok = false;
+    Napi::TypeError::New(env, "Expected an allocated Packet or null").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+  AVPacket* ref = av_packet_alloc();
+  if (!ref || av_packet_ref(ref, packet->Get()) < 0) {
+    av_packet_free(&ref);
+    ok = false;
+    Napi::Error::New(env, "Failed to reference packet").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+  return ref;
+}
+
+void PipelineStage::EnsureTsfn(Napi::Env env) {
+  if (has_tsfn_) {
+    return;
+  }
+
+  // The stage must outlive queued wakeups: the finalizer drops the self reference
+  self_ref_.Reset(Value(), 1);
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "PipelineStageWakeup",
+    0,  // Unlimited queue
+    1,  // One thread
+    [this](Napi::Env) { self_ref_.Reset(); }
+  );
+  tsfn_.Unref(env);
+  has_tsfn_ = true;
+}
+
+void PipelineStage::ReleaseJs() {
+  SettleAll();
+  if (has_tsfn_) {
+    has_tsfn_ = false;
+    tsfn_.Release();
+  }
+}
+
+Napi::Value PipelineStage::Push(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (has_upstream_) {
+    Napi::Error::New(env, "Stage is fed by an upstream stage").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (push_deferred_) {
+    Napi::Error::New(env, "A pushAsync() call is pending").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (input_closed_ || finished_.load() || abort_.load()) {
+    return Napi::Boolean::New(env, false);
+  }
+
+  // Only this thread produces, so the queue cannot fill up after this check
+  if (in_queue_->Full()) {
+    input_stalls_++;
+    return Napi::Boolean::New(env, false);
+  }
+
+  bool ok;
+  void* item = RefInput(info.Length() > 0 ? info[0] : env.Null(), ok);
+  if (!ok) {
+    return env.Undefined();
+  }
+
+  in_queue_->TryPush(item);
+  if (!item) {
+    input_closed_ = true;
+  }
+  Wake(input_cv_, input_waiting_);
+
+  return Napi::Boolean::New(env, true);
+}
+
+Napi::Value PipelineStage::PushAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (has_upstream_) {
+    Napi::Error::New(env, "Stage is fed by an upstream stage").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (push_deferred_) {
+    Napi::Error::New(env, "A pushAsync() call is pending").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto deferred = Napi::Promise::Deferred::New(env);
+
+  if (input_closed_ || finished_.load() || abort_.load()) {
+    deferred.Resolve(Napi::Boolean::New(env, false));
+    return deferred.Promise();
+  }
+
+  bool ok;
+  void* item = RefInput(info.Length() > 0 ? info[0] : env.Null(), ok);
+  if (!ok) {
+    return env.Undefined();
+  }
+  if (!item) {
+    input_closed_ = true;
+  }
+
+  // Fast path: no wakeup needed while there is room
+  if (in_queue_->TryPush(item)) {
+    Wake(input_cv_, input_waiting_);
+    deferred.Resolve(Napi::Boolean::New(env, true));
+    return deferred.Promise();
+  }
+
+  push_item_ = item;
+  push_deferred_ = std::make_unique<Napi::Promise::Deferred>(deferred);
+  EnsureTsfn(env);
+  tsfn_.Ref(env);
+  SettlePush();
+
+  return deferred.Promise();
+}
+
+void PipelineStage::SettlePush() {
+  if (!push_deferred_) {
+    return;
+  }
+
+  Napi::Env env = push_deferred_->Env();
+  bool queued = false;
+
+  if (!finished_.load() && !abort_.load()) {
+    queued = in_queue_->TryPush(push_item_);
+    if (!queued) {
+      input_stalls_++;
+      // Arm the wakeup, then re-check so a slot freed in between is not missed
+      js_push_waiting_.store(true);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      queued = in_queue_->TryPush(push_item_);
+      if (!queued && !finished_.load() && !abort_.load()) {
+        return;
+      }
+      // A wakeup may still be in flight; it finds nothing pending
+      js_push_waiting_.store(false);
+    }
+  }
+
+  if (queued) {
+    Wake(input_cv_, input_waiting_);
+  } else {
+    FreeItem(push_item_, InputIsFrame());
+  }
+  push_item_ = nullptr;
+
+  auto deferred = std::move(push_deferred_);
+  if (!pull_deferred_ && has_tsfn_) {
+    tsfn_.Unref(env);
+  }
+  deferred->Resolve(Napi::Boolean::New(env, queued));
+}
+
+int PipelineStage::PullInto(Napi::Object target) {
+  auto endCode = [this]() {
+    int err = error_.load();
+    return err < 0 && err != AVERROR_EXIT ? err : AVERROR_EOF;
+  };
+
+  if (output_eof_) {
+    return endCode();
+  }
+
+  void* item = nullptr;
+  if (!out_queue_->TryPop(item)) {
+    // finished_ is set after the last item was queued
+    if (finished_.load() && out_queue_->Empty()) {
+      output_eof_ = true;
+      return endCode();
+    }
+    return AVERROR(EAGAIN);
+  }
+
+  Wake(output_cv_, output_waiting_);
+
+  if (!item) {
+    output_eof_ = true;
+    return endCode();
+  }
+
+  if (OutputIsFrame()) {
+    AVFrame* dst = Napi::ObjectWrap<Frame>::Unwrap(target)->Get();
+    AVFrame* src = static_cast<AVFrame*>(item);
+    av_frame_unref(dst);
+    av_frame_move_ref(dst, src);
+    av_frame_free(&src);
+  } else {
+    AVPacket* dst = Napi::ObjectWrap<Packet>::Unwrap(target)->Get();
+    AVPacket* src = static_cast<AVPacket*>(item);
+    av_packet_unref(dst);
+    av_packet_move_ref(dst, src);
+    av_packet_free(&src);
+  }
+
+  return 0;
+}
+
+// Validates the pull() target: an allocated Frame or Packet matching the output
+static bool ValidPullTarget(Napi::Env env, const Napi::CallbackInfo& info, bool frame) {
+  if (info.Length() < 1) {
+    return false;
+  }
+  if (frame) {
+    Frame* f = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+    return f && f->Get();
+  }
+  Packet* p = UnwrapNativeObject<Packet>(env, info[0], "Packet");
+  return p && p->Get();
+}
+
+Napi::Value PipelineStage::Pull(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (next_) {
+    Napi::Error::New(env, "Stage output feeds a downstream stage").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (pull_deferred_) {
+    Napi::Error::New(env, "A pullAsync() call is pending").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ValidPullTarget(env, info, OutputIsFrame())) {
+    Napi::TypeError::New(env, OutputIsFrame() ? "Expected an allocated Frame" : "Expected an allocated Packet")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, PullInto(info[0].As<Napi::Object>()));
+}
+
+Napi::Value PipelineStage::PullAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (next_) {
+    Napi::Error::New(env, "Stage output feeds a downstream stage").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (pull_deferred_) {
+    Napi::Error::New(env, "A pullAsync() call is pending").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ValidPullTarget(env, info, OutputIsFrame())) {
+    Napi::TypeError::New(env, OutputIsFrame() ? "Expected an allocated Frame" : "Expected an allocated Packet")
+      .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto deferred = Napi::Promise::Deferred::New(env);
+
+  // Fast path: an item (or the end of stream) is already available
+  int ret = PullInto(info[0].As<Napi::Object>());
+  if (ret != AVERROR(EAGAIN)) {
+    deferred.Resolve(Napi::Number::New(env, ret));
+    return deferred.Promise();
+  }
+
+  pull_target_.Reset(info[0].As<Napi::Object>(), 1);
+  pull_deferred_ = std::make_unique<Napi::Promise::Deferred>(deferred);
+  EnsureTsfn(env);
+  tsfn_.Ref(env);
+  SettlePull();
+
+  return deferred.Promise();
+}
+
+void PipelineStage::SettlePull() {
+  if (!pull_deferred_) {
+    return;
+  }
+
+  Napi::Env env = pull_deferred_->Env();
+  Napi::Object target = pull_target_.Value();
+
+  int ret = PullInto(target);
+  if (ret == AVERROR(EAGAIN)) {
+    // Arm the wakeup, then re-check so an item queued in between is not missed
+    js_pull_waiting_.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ret = PullInto(target);
+    if (ret == AVERROR(EAGAIN)) {
+      return;
+    }
+    // A wakeup may still be in flight; it finds nothing pending
+    js_pull_waiting_.store(false);
+  }
+
+  auto deferred = std::move(pull_deferred_);
+  pull_target_.Reset();
+  if (!push_deferred_ && has_tsfn_) {
+    tsfn_.Unref(env);
+  }
+  deferred->Resolve(Napi::Number::New(env, ret));
+}
+
+void PipelineStage::SettleAll() {
+  SettlePush();
+  SettlePull();
+}
+
+Napi::Value PipelineStage::StopAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object thisObj = info.This().As<Napi::Object>();
+
+  auto* worker = new PSStopWorker(env, thisObj, this);
+  worker->Queue();
+  return worker->GetPromise();
+}
+
+Napi::Value PipelineStage::StopSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Stop();
+  ReleaseJs();
+
+  return env.Undefined();
+}
+
+Napi::Value PipelineStage::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("inputItems", Napi::Number::New(env, static_cast<double>(input_items_.load())));
+  stats.Set("outputItems", Napi::Number::New(env, static_cast<double>(output_items_.load())));
+  stats.Set("inputQueued", Napi::Number::New(env, static_cast<double>(in_queue_->Size())));
+  stats.Set("outputQueued", Napi::Number::New(env, static_cast<double>(out_queue_->Size())));
+  stats.Set("inputStalls", Napi::Number::New(env, static_cast<double>(input_stalls_.load())));
+  stats.Set("outputStalls", Napi::Number::New(env, static_cast<double>(output_stalls_.load())));
+  stats.Set("finished", Napi::Boolean::New(env, finished_.load()));
+  stats.Set("error", Napi::Number::New(env, error_.load()));
+
+  return stats;
+}
+
+Napi::Value PipelineStage::GetKind(const Napi::CallbackInfo& info) {
+  return Napi::String::New(info.Env(), KindName(kind_));
+}
+
+Napi::Value PipelineStage::GetIsRunning(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), running_.load());
+}
+
+} // namespace ffmpeg
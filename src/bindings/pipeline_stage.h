@@ -0,0 +1,152 @@
+#ifndef FFMPEG_PIPELINE_STAGE_H
+#define FFMPEG_PIPELINE_STAGE_H
+
+#include <napi.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "common.h"
+#include "spsc_queue.h"
+
+namespace ffmpeg {
+
+enum class StageKind {
+  BitStreamFilter,  // packet -> packet
+  Decoder,          // packet -> frame
+  Encoder,          // frame -> packet
+  Filter,           // frame -> frame (buffersrc -> buffersink)
+};
+
+// Pipeline stage running on its own native thread.
+//
+// Each stage owns a bounded lock-free SPSC input queue. Connected stages hand
+// items (refcounted AVPacket/AVFrame) directly from one worker thread to the
+// next; JavaScript is only involved at the ends of a chain (push into the
+// head, pull from the tail). JS-side waits are resolved through a
+// ThreadSafeFunction wakeup, so no libuv threadpool thread is parked.
+//
+// Items are moved, never copied: push() takes a new reference to the caller's
+// packet/frame and pull() moves the result into the caller's object.
+class PipelineStage : public Napi::ObjectWrap<PipelineStage> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  PipelineStage(const Napi::CallbackInfo& info);
+  ~PipelineStage();
+
+private:
+  friend class PSStopWorker;
+
+  static Napi::FunctionReference constructor;
+
+  // Static methods
+  static Napi::Value Create(const Napi::CallbackInfo& info);
+
+  // Instance methods
+  Napi::Value Connect(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Push(const Napi::CallbackInfo& info);
+  Napi::Value PushAsync(const Napi::CallbackInfo& info);
+  Napi::Value Pull(const Napi::CallbackInfo& info);
+  Napi::Value PullAsync(const Napi::CallbackInfo& info);
+  Napi::Value StopAsync(const Napi::CallbackInfo& info);
+  Napi::Value StopSync(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value GetKind(const Napi::CallbackInfo& info);
+  Napi::Value GetIsRunning(const Napi::CallbackInfo& info);
+
+  bool InputIsFrame() const { return kind_ == StageKind::Encoder || kind_ == StageKind::Filter; }
+  bool OutputIsFrame() const { return kind_ == StageKind::Decoder || kind_ == StageKind::Filter; }
+  void FreeItem(void* item, bool frame);
+
+  // Worker thread
+  void Run();
+  int Process(void* item);
+  int SendInput(void* item);
+  int Drain();
+  int Emit(void* item);
+  void Finish(int ret);
+
+  // Producer side of the input queue (upstream worker)
+  bool Enqueue(void* item, const std::atomic<bool>& caller_abort);
+
+  // Blocking waits (worker threads only)
+  template <typename Ready>
+  void Wait(std::condition_variable& cv, std::atomic<bool>& sleeping, Ready ready);
+  void Wake(std::condition_variable& cv, std::atomic<bool>& sleeping);
+  void WakeJs();
+  void Interrupt();
+
+  // Main thread
+  void* RefInput(const Napi::Value& value, bool& ok);
+  int PullInto(Napi::Object target);
+  void SettlePush();
+  void SettlePull();
+  void SettleAll();
+  void Stop();
+  void EnsureTsfn(Napi::Env env);
+  void ReleaseJs();
+
+  StageKind kind_ = StageKind::BitStreamFilter;
+
+  // Processing contexts (kept alive by context_refs_)
+  AVBSFContext* bsf_ = nullptr;
+  AVCodecContext* codec_ = nullptr;
+  AVFilterContext* buffersrc_ = nullptr;
+  AVFilterContext* buffersink_ = nullptr;
+  Napi::ObjectReference context_refs_[2];
+  AVPacket* scratch_packet_ = nullptr;
+  AVFrame* scratch_frame_ = nullptr;
+  int64_t last_pts_ = AV_NOPTS_VALUE;
+  int64_t last_duration_ = 0;
+
+  // Queues: input is fed by JS or the upstream stage, output is drained by JS
+  // when there is no downstream stage
+  std::unique_ptr<SpscQueue<void*>> in_queue_;
+  std::unique_ptr<SpscQueue<void*>> out_queue_;
+
+  // Downstream stage (kept alive by next_ref_)
+  PipelineStage* next_ = nullptr;
+  Napi::ObjectReference next_ref_;
+  bool has_upstream_ = false;
+  std::atomic<int> upstream_error_{0};
+
+  // Worker thread
+  std::thread thread_;
+  std::mutex wait_mutex_;
+  std::condition_variable input_cv_;   // Worker waits for input
+  std::condition_variable space_cv_;   // Upstream worker waits for input space
+  std::condition_variable output_cv_;  // Worker waits for output space
+  std::atomic<bool> input_waiting_{false};
+  std::atomic<bool> space_waiting_{false};
+  std::atomic<bool> output_waiting_{false};
+  std::atomic<bool> abort_{false};
+  std::atomic<bool> running_{false};
+  std::atomic<bool> finished_{false};
+  std::atomic<int> error_{0};
+  bool started_ = false;
+  bool input_closed_ = false;
+  bool output_eof_ = false;
+
+  // JS wakeups (pending pushAsync/pullAsync)
+  Napi::ThreadSafeFunction tsfn_;
+  bool has_tsfn_ = false;
+  Napi::ObjectReference self_ref_;
+  std::atomic<bool> js_push_waiting_{false};
+  std::atomic<bool> js_pull_waiting_{false};
+  void* push_item_ = nullptr;
+  std::unique_ptr<Napi::Promise::Deferred> push_deferred_;
+  Napi::ObjectReference pull_target_;
+  std::unique_ptr<Napi::Promise::Deferred> pull_deferred_;
+
+  // Statistics
+  std::atomic<uint64_t> input_items_{0};
+  std::atomic<uint64_t> output_items_{0};
+  std::atomic<uint64_t> input_stalls_{0};
+  std::atomic<uint64_t> output_stalls_{0};
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_PIPELINE_STAGE_H
@@ -0,0 +1,369 @@
+#include "registry.h"
+#include "codec.h"
+#include "filter.h"
+#include "input_format.h"
+#include "output_format.h"
+#include "lazy_exports.h"
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavfilter/avfilter.h>
+#include <libavformat/avformat.h>
+#include <libavutil/avstring.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+// Longest name accepted by Find(); longer keys cannot match any entry
+constexpr size_t kMaxKey = 256;
+
+struct Tables {
+  std::vector<const AVCodec*> codecs;
+  std::vector<const AVFilter*> filters;
+  std::vector<const AVInputFormat*> demuxers;
+  std::vector<const AVOutputFormat*> muxers;
+
+  // Keys point into FFmpeg's static definitions (or into the split format
+  // names below), which live as long as the process
+  std::unordered_map<std::string_view, int> by_name[Registry::kTableCount];
+  std::unordered_map<int, int> by_id[2];  // kEncoder, kDecoder
+
+  // Split, lowercased format names ("mov,mp4,m4a,..."); a deque keeps
+  // the strings in place as it grows
+  std::deque<std::string> format_names;
+};
+
+// Copy a name lowercased with av_tolower(), as av_match_name() compares
+void LowerInto(char* dst, const char* src, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    dst[i] = static_cast<char>(av_tolower(static_cast<unsigned char>(src[i])));
+  }
+}
+
+// Demuxers and muxers match any of their comma separated names, ignoring
+// case. First registration wins, like the linear scans in libavformat.
+void IndexFormatNames(Tables& t, Registry::Table table, const char* names, int index) {
+  if (!names) {
+    return;
+  }
+
+  const char* start = names;
+  while (true) {
+    const char* end = strchr(start, ',');
+    size_t len = end ? static_cast<size_t>(end - start) : strlen(start);
+    if (len > 0) {
+      std::string& name = t.format_names.emplace_back(len, '\0');
+      LowerInto(name.data(), start, len);
+      t.by_name[table].emplace(name, index);
+    }
+    if (!end) {
+      break;
+    }
+    start = end + 1;
+  }
+}
+
+void IndexCodec(Tables& t, const AVCodec* codec, int index) {
+  Registry::Table table = av_codec_is_encoder(codec) ? Registry::kEncoder : Registry::kDecoder;
+  t.by_name[table].emplace(codec->name, index);
+
+  // avcodec_find_encoder/decoder: first non-experimental codec, else the
+  // first experimental one
+  auto [it, inserted] = t.by_id[table].emplace(codec->id, index);
+  if (!inserted && (t.codecs[it->second]->capabilities & AV_CODEC_CAP_EXPERIMENTAL) &&
+      !(codec->capabilities & AV_CODEC_CAP_EXPERIMENTAL)) {
+    it->second = index;
+  }
+}
+
+const Tables& Build() {
+  static Tables tables;
+  static std::once_flag once;
+
+  std::call_once(once, [] {
+    // Device formats (lavfi, v4l2, avfoundation, ...) are part of the snapshot
+    LazyExports::EnsureDevices();
+
+    Tables& t = tables;
+    void* opaque = nullptr;
+
+    const AVCodec* codec = nullptr;
+    while ((codec = av_codec_iterate(&opaque))) {
+      t.codecs.push_back(codec);
+      IndexCodec(t, codec, static_cast<int>(t.codecs.size() - 1));
+    }
+
+    opaque = nullptr;
+    const AVFilter* filter = nullptr;
+    while ((filter = av_filter_iterate(&opaque))) {
+      t.filters.push_back(filter);
+      t.by_name[Registry::kFilter].emplace(filter->name, static_cast<int>(t.filters.size() - 1));
+    }
+
+    opaque = nullptr;
+    const AVInputFormat* demuxer = nullptr;
+    while ((demuxer = av_demuxer_iterate(&opaque))) {
+      t.demuxers.push_back(demuxer);
+    }
+
+    opaque = nullptr;
+    const AVOutputFormat* muxer = nullptr;
+    while ((muxer = av_muxer_iterate(&opaque))) {
+      t.muxers.push_back(muxer);
+    }
+
+    for (size_t i = 0; i < t.demuxers.size(); i++) {
+      IndexFormatNames(t, Registry::kDemuxer, t.demuxers[i]->name, static_cast<int>(i));
+    }
+    for (size_t i = 0; i < t.muxers.size(); i++) {
+      IndexFormatNames(t, Registry::kMuxer, t.muxers[i]->name, static_cast<int>(i));
+    }
+  });
+
+  return tables;
+}
+
+Napi::Value NullableString(Napi::Env env, const char* str) {
+  return str ? Napi::String::New(env, str) : env.Null();
+}
+
+Napi::Array CodecsToJS(Napi::Env env, const Tables& t) {
+  Napi::Array array = Napi::Array::New(env, t.codecs.size());
+  for (size_t i = 0; i < t.codecs.size(); i++) {
+    const AVCodec* codec = t.codecs[i];
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("name", Napi::String::New(env, codec->name));
+    obj.Set("longName", NullableString(env, codec->long_name));
+    obj.Set("id", Napi::Number::New(env, codec->id));
+    obj.Set("type", Napi::Number::New(env, codec->type));
+    obj.Set("isEncoder", Napi::Boolean::New(env, av_codec_is_encoder(codec) != 0));
+    obj.Set("capabilities", Napi::Number::New(env, codec->capabilities));
+    obj.Set("wrapper", NullableString(env, codec->wrapper_name));
+
+    // Device types usable through a device or frames context
+    Napi::Array devices = Napi::Array::New(env);
+    uint32_t count = 0;
+    for (int c = 0;; c++) {
+      const AVCodecHWConfig* config = avcodec_get_hw_config(codec, c);
+      if (!config) {
+        break;
+      }
+      if (config->methods & (AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX | AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX)) {
+        devices.Set(count++, Napi::Number::New(env, config->device_type));
+      }
+    }
+    obj.Set("hwDeviceTypes", devices);
+
+    array.Set(static_cast<uint32_t>(i), obj);
+  }
+  return array;
+}
+
+Napi::Array FiltersToJS(Napi::Env env, const Tables& t) {
+  Napi::Array array = Napi::Array::New(env, t.filters.size());
+  for (size_t i = 0; i < t.filters.size(); i++) {
+    const AVFilter* filter = t.filters[i];
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("name", Napi::String::New(env, filter->name));
+    obj.Set("description", NullableString(env, filter->description));
+    obj.Set("flags", Napi::Number::New(env, filter->flags));
+    obj.Set("inputs", Napi::Number::New(env, avfilter_filter_pad_count(filter, 0)));
+    obj.Set("outputs", Napi::Number::New(env, avfilter_filter_pad_count(filter, 1)));
+    array.Set(static_cast<uint32_t>(i), obj);
+  }
+  return array;
+}
+
+Napi::Array DemuxersToJS(Napi::Env env, const Tables& t) {
+  Napi::Array array = Napi::Array::New(env, t.demuxers.size());
+  for (size_t i = 0; i < t.demuxers.size(); i++) {
+    const AVInputFormat* format = t.demuxers[i];
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("name", Napi::String::New(env, format->name));
+    obj.Set("longName", NullableString(env, format->long_name));
+    obj.Set("extensions", NullableString(env, format->extensions));
+    obj.Set("mimeType", NullableString(env, format->mime_type));
+    obj.Set("flags", Napi::Number::New(env, format->flags));
+    array.Set(static_cast<uint32_t>(i), obj);
+  }
+  return array;
+}
+
+Napi::Array MuxersToJS(Napi::Env env, const Tables& t) {
+  Napi::Array array = Napi::Array::New(env, t.muxers.size());
+  for (size_t i = 0; i < t.muxers.size(); i++) {
+    const AVOutputFormat* format = t.muxers[i];
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("name", Napi::String::New(env, format->name));
+    obj.Set("longName", NullableString(env, format->long_name));
+    obj.Set("extensions", NullableString(env, format->extensions));
+    obj.Set("mimeType", NullableString(env, format->mime_type));
+    obj.Set("flags", Napi::Number::New(env, format->flags));
+    obj.Set("audioCodec", Napi::Number::New(env, format->audio_codec));
+    obj.Set("videoCodec", Napi::Number::New(env, format->video_codec));
+    obj.Set("subtitleCodec", Napi::Number::New(env, format->subtitle_codec));
+    array.Set(static_cast<uint32_t>(i), obj);
+  }
+  return array;
+}
+
+bool ParseTable(const Napi::CallbackInfo& info, Registry::Table& table) {
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(info.Env(), "Registry table (number) required").ThrowAsJavaScriptException();
+    return false;
+  }
+  int32_t value = info[0].As<Napi::Number>().Int32Value();
+  if (value < 0 || value >= Registry::kTableCount) {
+    Napi::RangeError::New(info.Env(), "Invalid registry table").ThrowAsJavaScriptException();
+    return false;
+  }
+  table = static_cast<Registry::Table>(value);
+  return true;
+}
+
+} // namespace
+
+Napi::Object Registry::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("registryFind", Napi::Function::New(env, Find));
+  exports.Set("registryEntry", Napi::Function::New(env, Entry));
+  exports.Set("registrySnapshot", Napi::Function::New(env, Snapshot));
+  return exports;
+}
+
+int Registry::FindByName(Table table, std::string_view name) {
+  const Tables& t = Build();
+
+  // av_find_input_format() and av_guess_format() go through av_match_name(),
+  // which ignores case; codec and filter names are compared exactly
+  char lower[kMaxKey];
+  if (table == kDemuxer || table == kMuxer) {
+    if (name.size() >= sizeof(lower)) {
+      return -1;
+    }
+    LowerInto(lower, name.data(), name.size());
+    name = std::string_view(lower, name.size());
+  }
+
+  auto it = t.by_name[table].find(name);
+  return it == t.by_name[table].end() ? -1 : it->second;
+}
+
+int Registry::FindById(Table table, int id) {
+  if (table != kEncoder && table != kDecoder) {
+    return -1;
+  }
+  const Tables& t = Build();
+  auto it = t.by_id[table].find(id);
+  return it == t.by_id[table].end() ? -1 : it->second;
+}
+
+// registryFind(table, nameOrId) -> index | -1
+Napi::Value Registry::Find(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Table table;
+  if (!ParseTable(info, table)) {
+    return env.Undefined();
+  }
+
+  if (info.Length() > 1 && info[1].IsNumber()) {
+    return Napi::Number::New(env, FindById(table, info[1].As<Napi::Number>().Int32Value()));
+  }
+
+  if (info.Length() < 2 || !info[1].IsString()) {
+    Napi::TypeError::New(env, "Name (string) or id (number) required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Read the key into a stack buffer; no std::string per lookup
+  char key[kMaxKey];
+  size_t length = 0;
+  napi_status status = napi_get_value_string_utf8(env, info[1], key, sizeof(key), &length);
+  if (status != napi_ok) {
+    Napi::Error::New(env, "Failed to read registry key").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (length >= sizeof(key) - 1) {
+    return Napi::Number::New(env, -1);
+  }
+
+  return Napi::Number::New(env, FindByName(table, std::string_view(key, length)));
+}
+
+// registryEntry(table, index) -> native Codec | Filter | InputFormat | OutputFormat
+Napi::Value Registry::Entry(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Table table;
+  if (!ParseTable(info, table)) {
+    return env.Undefined();
+  }
+  if (info.Length() < 2 || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Index (number) required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const Tables& t = Build();
+  int64_t index = info[1].As<Napi::Number>().Int64Value();
+
+  switch (table) {
+    case kEncoder:
+    case kDecoder: {
+      if (index < 0 || index >= static_cast<int64_t>(t.codecs.size())) {
+        return env.Null();
+      }
+      Napi::Object obj = Codec::constructor.New({});
+      Napi::ObjectWrap<Codec>::Unwrap(obj)->Set(t.codecs[index]);
+      return obj;
+    }
+    case kFilter: {
+      if (index < 0 || index >= static_cast<int64_t>(t.filters.size())) {
+        return env.Null();
+      }
+      Napi::Object obj = Filter::constructor.New({});
+      Napi::ObjectWrap<Filter>::Unwrap(obj)->Set(t.filters[index]);
+      return obj;
+    }
+    case kDemuxer: {
+      if (index < 0 || index >= static_cast<int64_t>(t.demuxers.size())) {
+        return env.Null();
+      }
+      Napi::Object obj = InputFormat::constructor.New({});
+      Napi::ObjectWrap<InputFormat>::Unwrap(obj)->Set(t.demuxers[index]);
+      return obj;
+    }
+    case kMuxer: {
+      if (index < 0 || index >= static_cast<int64_t>(t.muxers.size())) {
+        return env.Null();
+      }
+      Napi::Object obj = OutputFormat::constructor.New({});
+      Napi::ObjectWrap<OutputFormat>::Unwrap(obj)->Set(t.muxers[index]);
+      return obj;
+    }
+    default:
+      return env.Null();
+  }
+}
+
+// registrySnapshot() -> { codecs, filters, demuxers, muxers }, plain data
+Napi::Value Registry::Snapshot(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  const Tables& t = Build();
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("codecs", CodecsToJS(env, t));
+  result.Set("filters", FiltersToJS(env, t));
+  result.Set("demuxers", DemuxersToJS(env, t));
+  result.Set("muxers", MuxersToJS(env, t));
+  return result;
+}
+
+} // namespace ffmpeg
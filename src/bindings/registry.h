@@ -0,0 +1,45 @@
+#ifndef FFMPEG_REGISTRY_H
+#define FFMPEG_REGISTRY_H
+
+#include <napi.h>
+#include <string_view>
+
+namespace ffmpeg {
+
+// Process-wide snapshot of the codec, filter and format registries.
+//
+// Built once on first use by walking the FFmpeg iterators, then kept as
+// compact arrays with hash indexes by name (and by codec id for encoders and
+// decoders). Lookups return an index into the table's array; JS resolves the
+// index to a cached wrapper, so repeated lookups allocate nothing.
+class Registry {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  // Keep in sync with RegistryTable in src/lib/registry.ts
+  enum Table {
+    kEncoder = 0,
+    kDecoder = 1,
+    kFilter = 2,
+    kDemuxer = 3,
+    kMuxer = 4,
+    kTableCount = 5,
+  };
+
+  // Index into the table's array, -1 if not found. Encoders and decoders share
+  // the codec array. Name lookups follow avcodec_find_*_by_name() (exact),
+  // av_find_input_format() and av_guess_format() (case-insensitive, like
+  // av_match_name()); id lookups follow
+  // avcodec_find_encoder()/avcodec_find_decoder() (non-experimental first).
+  static int FindByName(Table table, std::string_view name);
+  static int FindById(Table table, int id);
+
+private:
+  static Napi::Value Find(const Napi::CallbackInfo& info);
+  static Napi::Value Entry(const Napi::CallbackInfo& info);
+  static Napi::Value Snapshot(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_REGISTRY_H
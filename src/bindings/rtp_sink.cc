@@ -0,0 +1,344 @@
+#include "rtp_sink.h"
+#include <cstring>
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+namespace ffmpeg {
+
+static constexpr int RTP_HEADER_SIZE = 12;
+
+static inline bool IsRtcp(const uint8_t* buf, int size) {
+  // RFC 5761: RTCP packet types 192-223 share the second byte with RTP M+PT
+  return size >= 2 && buf[1] >= 192 && buf[1] <= 223;
+}
+
+static inline uint32_t ReadU32(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static inline void WriteU16(uint8_t* p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v >> 8);
+  p[1] = static_cast<uint8_t>(v);
+}
+
+static inline void WriteU32(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v >> 24);
+  p[1] = static_cast<uint8_t>(v >> 16);
+  p[2] = static_cast<uint8_t>(v >> 8);
+  p[3] = static_cast<uint8_t>(v);
+}
+
+RtpSink::RtpSink(Napi::Env env, const RtpSinkOptions& options, Napi::Function callback,
+                 std::unique_ptr<UdpSender> sender)
+  : options_(options),
+    env_(env),
+    main_thread_id_(std::this_thread::get_id()),
+    sender_(std::move(sender)) {
+  if (options_.max_batch_packets < 1) {
+    options_.max_batch_packets = 1;
+  }
+
+  next_seq_ = options_.sequence_number;
+  next_ts_ = options_.timestamp;
+  offsets_.reserve(options_.max_batch_packets + 1);
+
+  if (!sender_ && !callback.IsEmpty()) {
+    tsfn_ = Napi::ThreadSafeFunction::New(
+      env,
+      callback,
+      "RtpSinkCallback",
+      0,  // Unlimited queue
+      1   // One thread
+    );
+    callback_direct_ = Napi::Persistent(callback);
+    has_callback_ = true;
+  }
+  active_ = true;
+}
+
+RtpSink::~RtpSink() {
+  Release();
+  if (slab_) {
+    av_free(slab_);
+    slab_ = nullptr;
+  }
+}
+
+bool RtpSink::ParseOptions(const Napi::Object& obj, RtpSinkOptions& options) {
+  auto getNumber = [&obj](const char* key, double& out) {
+    Napi::Value v = obj.Get(key);
+    if (!v.IsNumber()) {
+      return false;
+    }
+    out = v.As<Napi::Number>().DoubleValue();
+    return true;
+  };
+
+  double value;
+  if (getNumber("ssrc", value)) {
+    options.has_ssrc = true;
+    options.ssrc = static_cast<uint32_t>(static_cast<int64_t>(value));
+  }
+  if (getNumber("payloadType", value)) {
+    if (value < 0 || value > 127) {
+      return false;
+    }
+    options.has_payload_type = true;
+    options.payload_type = static_cast<uint8_t>(value);
+  }
+  if (getNumber("sequenceNumber", value)) {
+    options.sequence_number = static_cast<uint16_t>(static_cast<int64_t>(value) & 0xffff);
+  }
+  if (getNumber("timestamp", value)) {
+    options.has_timestamp = true;
+    options.timestamp = static_cast<uint32_t>(static_cast<int64_t>(value));
+  }
+  if (getNumber("timestampIncrement", value)) {
+    if (value < 0) {
+      return false;
+    }
+    options.timestamp_increment = static_cast<uint32_t>(value);
+  }
+  if (getNumber("maxBatchPackets", value)) {
+    options.max_batch_packets = static_cast<int>(value);
+  }
+
+  Napi::Value flushOnMarker = obj.Get("flushOnMarker");
+  if (flushOnMarker.IsBoolean()) {
+    options.flush_on_marker = flushOnMarker.As<Napi::Boolean>().Value();
+  }
+
+  return true;
+}
+
+int RtpSink::WritePacket(void* opaque, const uint8_t* buf, int buf_size) {
+  RtpSink* sink = static_cast<RtpSink*>(opaque);
+  if (!sink || !sink->active_) {
+    return AVERROR(ENOSYS);
+  }
+  return sink->Write(buf, buf_size);
+}
+
+void RtpSink::RewriteHeader(uint8_t* pkt) {
+  if (options_.has_payload_type) {
+    pkt[1] = static_cast<uint8_t>((pkt[1] & 0x80) | options_.payload_type);
+  }
+
+  // Continuous sequence numbers (wrap at 16 bit)
+  WriteU16(pkt + 2, next_seq_++);
+
+  if (options_.timestamp_increment > 0) {
+    // Synthesized timestamps: all packets of a frame share the timestamp,
+    // advance once the marker bit closes the frame
+    WriteU32(pkt + 4, next_ts_);
+    if (pkt[1] & 0x80) {
+      next_ts_ += options_.timestamp_increment;
+    }
+  } else if (options_.has_timestamp) {
+    // Rebase muxer timestamps onto the requested initial timestamp
+    uint32_t in_ts = ReadU32(pkt + 4);
+    if (!have_first_ts_) {
+      first_in_ts_ = in_ts;
+      have_first_ts_ = true;
+    }
+    WriteU32(pkt + 4, options_.timestamp + (in_ts - first_in_ts_));
+  }
+
+  if (options_.has_ssrc) {
+    WriteU32(pkt + 8, options_.ssrc);
+  }
+}
+
+int RtpSink::Write(const uint8_t* buf, int buf_size) {
+  if (buf_size <= 0) {
+    return buf_size;
+  }
+
+  if (IsRtcp(buf, buf_size)) {
+    rtcp_dropped_++;
+    return buf_size;
+  }
+
+  if (buf_size < RTP_HEADER_SIZE || (buf[0] >> 6) != 2) {
+    invalid_dropped_++;
+    return buf_size;
+  }
+
+  Batch* ready = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    size_t needed = slab_size_ + static_cast<size_t>(buf_size);
+    if (needed > slab_capacity_) {
+      size_t capacity = slab_capacity_ ? slab_capacity_ : static_cast<size_t>(buf_size) * options_.max_batch_packets;
+      while (capacity < needed) {
+        capacity *= 2;
+      }
+      uint8_t* slab = static_cast<uint8_t*>(av_realloc(slab_, capacity));
+      if (!slab) {
+        return AVERROR(ENOMEM);
+      }
+      slab_ = slab;
+      slab_capacity_ = capacity;
+    }
+
+    uint8_t* pkt = slab_ + slab_size_;
+    memcpy(pkt, buf, buf_size);
+    RewriteHeader(pkt);
+
+    if (offsets_.empty()) {
+      offsets_.push_back(0);
+    }
+    slab_size_ += buf_size;
+    offsets_.push_back(static_cast<uint32_t>(slab_size_));
+
+    packets_++;
+    bytes_ += buf_size;
+
+    int count = static_cast<int>(offsets_.size()) - 1;
+    bool marker = (pkt[1] & 0x80) != 0;
+    if (count >= options_.max_batch_packets || (options_.flush_on_marker && marker)) {
+      ready = TakeBatch();
+    }
+  }
+
+  if (ready) {
+    Deliver(ready);
+  }
+
+  return buf_size;
+}
+
+void RtpSink::Flush() {
+  Batch* ready = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready = TakeBatch();
+  }
+  if (ready) {
+    Deliver(ready);
+  }
+}
+
+RtpSink::Batch* RtpSink::TakeBatch() {
+  if (slab_size_ == 0) {
+    return nullptr;
+  }
+
+  Batch* batch = new Batch();
+  batch->data = slab_;
+  batch->size = slab_size_;
+  batch->offsets.swap(offsets_);
+
+  // Ownership of the slab moves to the batch (and later to the JS Buffer)
+  slab_ = nullptr;
+  slab_size_ = 0;
+  slab_capacity_ = 0;
+  offsets_.reserve(options_.max_batch_packets + 1);
+  batches_++;
+  return batch;
+}
+
+void RtpSink::FreeBatch(Batch* batch) {
+  if (batch->data) {
+    av_free(batch->data);
+  }
+  delete batch;
+}
+
+void RtpSink::CallJS(Napi::Env env, Napi::Function callback, Batch* batch) {
+  Napi::Buffer<uint8_t> slab = Napi::Buffer<uint8_t>::New(
+    env, batch->data, batch->size,
+    [](Napi::Env, uint8_t* data) { av_free(data); });
+  batch->data = nullptr;
+
+  Napi::Uint32Array offsets = Napi::Uint32Array::New(env, batch->offsets.size());
+  memcpy(offsets.Data(), batch->offsets.data(), batch->offsets.size() * sizeof(uint32_t));
+
+  callback.Call({slab, offsets});
+
+  // Errors thrown by the consumer must not abort muxing
+  if (env.IsExceptionPending()) {
+    env.GetAndClearPendingException();
+  }
+}
+
+void RtpSink::Deliver(Batch* batch) {
+  if (!active_) {
+    FreeBatch(batch);
+    return;
+  }
+
+  // Native UDP output - the sender thread owns the slab from here on
+  if (sender_) {
+    sender_->Enqueue(batch->data, std::move(batch->offsets));
+    batch->data = nullptr;
+    FreeBatch(batch);
+    return;
+  }
+
+  if (!has_callback_) {
+    FreeBatch(batch);
+    return;
+  }
+
+  // Direct call when the muxer runs synchronously on the main thread. Batches
+  // still queued from async writes go first, so then this one is queued too.
+  if (env_ && !callback_direct_.IsEmpty() && std::this_thread::get_id() == main_thread_id_ &&
+      queued_calls_->load() == 0) {
+    Napi::Env env(env_);
+    Napi::HandleScope scope(env);
+    CallJS(env, callback_direct_.Value(), batch);
+    FreeBatch(batch);
+    return;
+  }
+
+  // The counter is shared so queued calls can run after the sink is gone
+  std::shared_ptr<std::atomic<int>> queued = queued_calls_;
+  queued->fetch_add(1);
+  napi_status status = tsfn_.NonBlockingCall(batch, [queued](Napi::Env env, Napi::Function jsCallback, Batch* batch) {
+    if (env != nullptr) {
+      CallJS(env, jsCallback, batch);
+    }
+    FreeBatch(batch);
+    queued->fetch_sub(1);
+  });
+
+  if (status != napi_ok) {
+    queued->fetch_sub(1);
+    FreeBatch(batch);
+  }
+}
+
+void RtpSink::Release() {
+  if (active_) {
+    active_ = false;
+    if (has_callback_) {
+      tsfn_.Release();
+      callback_direct_.Reset();
+      has_callback_ = false;
+    }
+  }
+  if (sender_) {
+    sender_->Stop();
+  }
+}
+
+Napi::Object RtpSink::GetStats(Napi::Env env) {
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("packets", Napi::Number::New(env, static_cast<double>(packets_.load())));
+  stats.Set("bytes", Napi::Number::New(env, static_cast<double>(bytes_.load())));
+  stats.Set("batches", Napi::Number::New(env, static_cast<double>(batches_.load())));
+  stats.Set("rtcpDropped", Napi::Number::New(env, static_cast<double>(rtcp_dropped_.load())));
+  stats.Set("invalidDropped", Napi::Number::New(env, static_cast<double>(invalid_dropped_.load())));
+  if (sender_) {
+    stats.Set("udp", sender_->GetStats(env));
+  }
+  return stats;
+}
+
+} // namespace ffmpeg
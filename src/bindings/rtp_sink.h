@@ -0,0 +1,103 @@
+#ifndef FFMPEG_RTP_SINK_H
+#define FFMPEG_RTP_SINK_H
+
+#include <napi.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common.h"
+#include "udp_sender.h"
+
+namespace ffmpeg {
+
+// Native sink for the RTP muxer's AVIOContext.
+//
+// The RTP muxer flushes its AVIOContext once per datagram, so every call to
+// the write callback carries exactly one RTP (or RTCP) packet. Instead of
+// copying each datagram into its own Node Buffer, the sink rewrites the RTP
+// header in place (SSRC, payload type, sequence number, timestamp), drops
+// RTCP, and appends the datagram to a slab. Complete batches are handed to JS
+// as one Buffer plus an offsets array, or sent directly over UDP.
+struct RtpSinkOptions {
+  bool has_ssrc = false;
+  uint32_t ssrc = 0;
+  bool has_payload_type = false;
+  uint8_t payload_type = 0;
+  uint16_t sequence_number = 0;
+  bool has_timestamp = false;
+  uint32_t timestamp = 0;
+  uint32_t timestamp_increment = 0;  // 0 = keep (rebased) muxer timestamps
+  bool flush_on_marker = true;
+  int max_batch_packets = 32;
+};
+
+class RtpSink {
+public:
+  // Either callback or sender must be set; with a sender, batches never reach JS
+  RtpSink(Napi::Env env, const RtpSinkOptions& options, Napi::Function callback,
+          std::unique_ptr<UdpSender> sender = nullptr);
+  ~RtpSink();
+
+  // AVIOContext write_packet callback (opaque = RtpSink*)
+  static int WritePacket(void* opaque, const uint8_t* buf, int buf_size);
+
+  // Deliver pending datagrams (if any) to JS or the UDP sender
+  void Flush();
+
+  // Stop delivering, release the JS callback and drain the UDP sender
+  void Release();
+
+  Napi::Object GetStats(Napi::Env env);
+
+  static bool ParseOptions(const Napi::Object& obj, RtpSinkOptions& options);
+
+private:
+  struct Batch {
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint32_t> offsets;
+  };
+
+  int Write(const uint8_t* buf, int buf_size);
+  void RewriteHeader(uint8_t* pkt);
+  Batch* TakeBatch();
+  void Deliver(Batch* batch);
+  static void CallJS(Napi::Env env, Napi::Function callback, Batch* batch);
+  static void FreeBatch(Batch* batch);
+
+  RtpSinkOptions options_;
+
+  napi_env env_ = nullptr;
+  std::thread::id main_thread_id_;
+  Napi::ThreadSafeFunction tsfn_;
+  Napi::FunctionReference callback_direct_;
+  std::shared_ptr<std::atomic<int>> queued_calls_ = std::make_shared<std::atomic<int>>(0);  // Batches queued on tsfn_
+  std::atomic<bool> active_{false};
+  bool has_callback_ = false;
+  std::unique_ptr<UdpSender> sender_;
+
+  std::mutex mutex_;
+  uint8_t* slab_ = nullptr;
+  size_t slab_size_ = 0;
+  size_t slab_capacity_ = 0;
+  std::vector<uint32_t> offsets_;
+
+  // Header rewrite state
+  uint16_t next_seq_ = 0;
+  uint32_t next_ts_ = 0;
+  bool have_first_ts_ = false;
+  uint32_t first_in_ts_ = 0;
+
+  // Statistics
+  std::atomic<uint64_t> packets_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint64_t> batches_{0};
+  std::atomic<uint64_t> rtcp_dropped_{0};
+  std::atomic<uint64_t> invalid_dropped_{0};
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_RTP_SINK_H
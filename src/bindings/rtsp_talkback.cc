@@ -0,0 +1,674 @@
+#include "rtsp_talkback.h"
+#include "format_context.h"
+#include "tracing.h"
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavutil/channel_layout.h>
+#include <libavutil/random_seed.h>
+}
+
+namespace ffmpeg {
+
+static constexpr int RTP_HEADER_SIZE = 12;
+static constexpr int AU_HEADER_SECTION_SIZE = 4;  // RFC 3640 AAC-hbr: AU-headers-length + one AU-header
+
+static inline uint16_t ReadU16(const uint8_t* p) {
+  return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+static inline void WriteU16(uint8_t* p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v >> 8);
+  p[1] = static_cast<uint8_t>(v);
+}
+
+static inline void WriteU32(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v >> 24);
+  p[1] = static_cast<uint8_t>(v >> 16);
+  p[2] = static_cast<uint8_t>(v >> 8);
+  p[3] = static_cast<uint8_t>(v);
+}
+
+Napi::FunctionReference RtspTalkback::constructor;
+
+class RTBStopWorker : public Napi::AsyncWorker {
+public:
+  RTBStopWorker(Napi::Env env, Napi::Object parentObj, RtspTalkback* parent)
+    : AsyncWorker(env),
+      parent_(parent),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    parent_ref_.Reset(parentObj, 1);
+  }
+
+  ~RTBStopWorker() {
+    parent_ref_.Reset();
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("RTBStopWorker", "worker", parent_);
+
+    // Joining may wait for an in-flight send on a slow backchannel
+    parent_->Stop();
+  }
+
+  void OnOK() override {
+    Napi::HandleScope scope(Env());
+    parent_->format_ref_.Reset();
+    deferred_.Resolve(Env().Undefined());
+  }
+
+  void OnError(const Napi::Error& error) override {
+    deferred_.Reject(error.Value());
+  }
+
+  Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+private:
+  Napi::ObjectReference parent_ref_;
+  RtspTalkback* parent_;
+  Napi::Promise::Deferred deferred_;
+};
+
+Napi::Object RtspTalkback::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "RTSPTalkback", {
+    StaticMethod<&RtspTalkback::Create>("create"),
+    InstanceMethod<&RtspTalkback::Push>("push"),
+    InstanceMethod<&RtspTalkback::StopAsync>("stop"),
+    InstanceMethod<&RtspTalkback::StopSync>("stopSync"),
+    InstanceMethod<&RtspTalkback::GetStats>("getStats"),
+
+    InstanceAccessor<&RtspTalkback::GetCodecId>("codecId"),
+    InstanceAccessor<&RtspTalkback::GetIsRunning>("isRunning"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("RTSPTalkback", func);
+  return exports;
+}
+
+RtspTalkback::RtspTalkback(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<RtspTalkback>(info) {
+  // Created via RTSPTalkback.create()
+}
+
+RtspTalkback::~RtspTalkback() {
+  Stop();
+  Cleanup();
+  format_ref_.Reset();
+}
+
+bool RtspTalkback::ParseOptions(const Napi::Object& obj, RtspTalkbackOptions& options) {
+  auto getNumber = [&obj](const char* key, double& out) {
+    Napi::Value v = obj.Get(key);
+    if (!v.IsNumber()) {
+      return false;
+    }
+    out = v.As<Napi::Number>().DoubleValue();
+    return true;
+  };
+
+  double value;
+  if (getNumber("inputPayloadType", value)) {
+    if (value < 0 || value > 127) {
+      return false;
+    }
+    options.input_payload_type = static_cast<int>(value);
+  }
+  if (getNumber("inputChannels", value)) {
+    if (value != 1 && value != 2) {
+      return false;
+    }
+    options.input_channels = static_cast<int>(value);
+  }
+  if (getNumber("payloadType", value)) {
+    if (value < 0 || value > 127) {
+      return false;
+    }
+    options.payload_type = static_cast<int>(value);
+  }
+  if (getNumber("ssrc", value)) {
+    options.has_ssrc = true;
+    options.ssrc = static_cast<uint32_t>(static_cast<int64_t>(value));
+  }
+  if (getNumber("packetDuration", value)) {
+    if (value < 5 || value > 200) {
+      return false;
+    }
+    options.packet_duration_ms = static_cast<int>(value);
+  }
+  if (getNumber("bitrate", value)) {
+    options.bit_rate = static_cast<int64_t>(std::max(0.0, value));
+  }
+  if (getNumber("maxQueuePackets", value)) {
+    options.max_queue_packets = static_cast<size_t>(std::max(1.0, value));
+  }
+
+  return true;
+}
+
+Napi::Value RtspTalkback::Create(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Expected 2 arguments: formatContext, streamIndex").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  FormatContext* format = UnwrapNativeObject<FormatContext>(env, info[0], "FormatContext");
+  if (!format) {
+    Napi::TypeError::New(env, "formatContext must be a FormatContext").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  RtspTalkbackOptions options;
+  if (info.Length() > 2 && info[2].IsObject()) {
+    if (!ParseOptions(info[2].As<Napi::Object>(), options)) {
+      Napi::RangeError::New(env, "Invalid talkback options").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  AVFormatContext* ctx = format->Get();
+  if (!ctx || format->IsOutput() || !ctx->iformat || !ctx->iformat->name ||
+      strcmp(ctx->iformat->name, "rtsp") != 0) {
+    Napi::Error::New(env, "Talkback requires an open RTSP input context").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  int stream_index = info[1].As<Napi::Number>().Int32Value();
+  RTSPState* rt = static_cast<RTSPState*>(ctx->priv_data);
+  RTSPStream* rtsp_st = nullptr;
+  for (int i = 0; rt && i < rt->nb_rtsp_streams; i++) {
+    if (rt->rtsp_streams[i] && rt->rtsp_streams[i]->stream_index == stream_index) {
+      rtsp_st = rt->rtsp_streams[i];
+      break;
+    }
+  }
+
+  if (!rtsp_st || stream_index < 0 || stream_index >= static_cast<int>(ctx->nb_streams)) {
+    Napi::RangeError::New(env, "RTSP stream not found").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  AVCodecParameters* par = ctx->streams[stream_index]->codecpar;
+  if (par->codec_type != AVMEDIA_TYPE_AUDIO) {
+    Napi::Error::New(env, "Backchannel stream must be an audio stream").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Object obj = constructor.New({});
+  RtspTalkback* wrap = Napi::ObjectWrap<RtspTalkback>::Unwrap(obj);
+  wrap->options_ = options;
+  wrap->format_ = format;
+  wrap->stream_index_ = stream_index;
+
+  std::string error;
+  int ret = wrap->Setup(par->codec_id, par->sample_rate, par->ch_layout.nb_channels,
+                        rtsp_st->sdp_payload_type, error);
+  if (ret < 0) {
+    wrap->Cleanup();
+    Napi::Error::New(env, error).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Keep the FormatContext alive while the engine may send on it
+  wrap->format_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+  wrap->Start();
+
+  return obj;
+}
+
+int RtspTalkback::Setup(AVCodecID codec_id, int sample_rate, int channels, int sdp_payload_type, std::string& error) {
+  switch (codec_id) {
+    case AV_CODEC_ID_PCM_MULAW:
+    case AV_CODEC_ID_PCM_ALAW:
+    case AV_CODEC_ID_PCM_S16BE:
+    case AV_CODEC_ID_AAC:
+      break;
+    default:
+      error = std::string("Unsupported backchannel codec: ") + avcodec_get_name(codec_id);
+      return AVERROR(ENOTSUP);
+  }
+
+  payload_type_ = static_cast<uint8_t>(options_.payload_type >= 0 ? options_.payload_type : sdp_payload_type);
+  if (options_.payload_type < 0 && (sdp_payload_type < 0 || sdp_payload_type > 127)) {
+    error = "Backchannel payload type unknown";
+    return AVERROR(EINVAL);
+  }
+
+  // Opus decoder - RTP clock and decoder rate are always 48 kHz (RFC 7587)
+  const AVCodec* dec = avcodec_find_decoder(AV_CODEC_ID_OPUS);
+  if (!dec) {
+    error = "Opus decoder not available";
+    return AVERROR_DECODER_NOT_FOUND;
+  }
+  decoder_ = avcodec_alloc_context3(dec);
+  if (!decoder_) {
+    error = "Failed to allocate decoder";
+    return AVERROR(ENOMEM);
+  }
+  decoder_->sample_rate = 48000;
+  av_channel_layout_default(&decoder_->ch_layout, options_.input_channels);
+  int ret = avcodec_open2(decoder_, dec, nullptr);
+  if (ret < 0) {
+    error = "Failed to open Opus decoder";
+    return ret;
+  }
+
+  // Backchannel encoder, parameters as announced in the SDP
+  const AVCodec* enc = avcodec_find_encoder(codec_id);
+  if (!enc) {
+    error = std::string("Encoder not available: ") + avcodec_get_name(codec_id);
+    return AVERROR_ENCODER_NOT_FOUND;
+  }
+  encoder_ = avcodec_alloc_context3(enc);
+  if (!encoder_) {
+    error = "Failed to allocate encoder";
+    return AVERROR(ENOMEM);
+  }
+
+  const void* formats = nullptr;
+  int nb_formats = 0;
+  avcodec_get_supported_config(nullptr, enc, AV_CODEC_CONFIG_SAMPLE_FORMAT, 0, &formats, &nb_formats);
+
+  encoder_->sample_rate = sample_rate > 0 ? sample_rate : 8000;
+  encoder_->sample_fmt = nb_formats > 0 ? static_cast<const AVSampleFormat*>(formats)[0] : AV_SAMPLE_FMT_S16;
+  av_channel_layout_default(&encoder_->ch_layout, channels > 0 ? channels : 1);
+  encoder_->time_base = { 1, encoder_->sample_rate };
+  if (options_.bit_rate > 0) {
+    encoder_->bit_rate = options_.bit_rate;
+  }
+  ret = avcodec_open2(encoder_, enc, nullptr);
+  if (ret < 0) {
+    error = std::string("Failed to open encoder: ") + enc->name;
+    return ret;
+  }
+
+  // PCM codecs accept any frame size - cut packets of packetDuration ms
+  frame_samples_ = encoder_->frame_size > 0
+    ? encoder_->frame_size
+    : std::max(1, encoder_->sample_rate * options_.packet_duration_ms / 1000);
+
+  fifo_ = av_audio_fifo_alloc(encoder_->sample_fmt, encoder_->ch_layout.nb_channels, frame_samples_ * 4);
+  in_packet_ = av_packet_alloc();
+  out_packet_ = av_packet_alloc();
+  decoded_ = av_frame_alloc();
+  resampled_ = av_frame_alloc();
+  encode_frame_ = av_frame_alloc();
+  if (!fifo_ || !in_packet_ || !out_packet_ || !decoded_ || !resampled_ || !encode_frame_) {
+    error = "Failed to allocate talkback buffers";
+    return AVERROR(ENOMEM);
+  }
+
+  encode_frame_->format = encoder_->sample_fmt;
+  encode_frame_->sample_rate = encoder_->sample_rate;
+  encode_frame_->nb_samples = frame_samples_;
+  av_channel_layout_copy(&encode_frame_->ch_layout, &encoder_->ch_layout);
+  ret = av_frame_get_buffer(encode_frame_, 0);
+  if (ret < 0) {
+    error = "Failed to allocate encoder frame";
+    return ret;
+  }
+
+  ssrc_ = options_.has_ssrc ? options_.ssrc : av_get_random_seed();
+  next_seq_ = static_cast<uint16_t>(av_get_random_seed());
+  base_ts_ = av_get_random_seed();
+  rtp_buffer_.reserve(1500);
+
+  return 0;
+}
+
+void RtspTalkback::Start() {
+  stopping_ = false;
+  running_ = true;
+  thread_ = std::thread(&RtspTalkback::Run, this);
+}
+
+void RtspTalkback::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_one();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void RtspTalkback::Cleanup() {
+  avcodec_free_context(&decoder_);
+  avcodec_free_context(&encoder_);
+  swr_free(&swr_);
+  if (fifo_) {
+    av_audio_fifo_free(fifo_);
+    fifo_ = nullptr;
+  }
+  av_packet_free(&in_packet_);
+  av_packet_free(&out_packet_);
+  av_frame_free(&decoded_);
+  av_frame_free(&resampled_);
+  av_frame_free(&encode_frame_);
+}
+
+void RtspTalkback::Run() {
+  while (true) {
+    std::vector<uint8_t> rtp;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+
+      // Drain what was pushed before stop()
+      if (queue_.empty()) {
+        break;
+      }
+      rtp = std::move(queue_.front());
+      queue_.pop_front();
+    }
+
+    HandleRtp(rtp);
+  }
+
+  running_ = false;
+}
+
+void RtspTalkback::HandleRtp(const std::vector<uint8_t>& rtp) {
+  const uint8_t* buf = rtp.data();
+  size_t size = rtp.size();
+
+  // RTP version 2 only; RTCP (RFC 5761 muxing) is not forwarded
+  if (size < RTP_HEADER_SIZE || (buf[0] >> 6) != 2 || (buf[1] >= 192 && buf[1] <= 223)) {
+    ignored_packets_++;
+    return;
+  }
+
+  int pt = buf[1] & 0x7f;
+  if (options_.input_payload_type >= 0 && pt != options_.input_payload_type) {
+    ignored_packets_++;
+    return;
+  }
+
+  // Out-of-order packets are dropped, gaps are counted as loss
+  uint16_t seq = ReadU16(buf + 2);
+  if (have_seq_) {
+    int16_t delta = static_cast<int16_t>(seq - last_seq_);
+    if (delta <= 0) {
+      late_packets_++;
+      return;
+    }
+    if (delta > 1) {
+      lost_packets_ += delta - 1;
+    }
+  }
+  have_seq_ = true;
+  last_seq_ = seq;
+
+  // Skip CSRC list, header extension and padding
+  size_t offset = RTP_HEADER_SIZE + 4 * (buf[0] & 0x0f);
+  if ((buf[0] & 0x10) && offset + 4 <= size) {
+    offset += 4 + 4 * static_cast<size_t>(ReadU16(buf + offset + 2));
+  }
+  size_t end = size;
+  if (buf[0] & 0x20) {
+    uint8_t padding = buf[size - 1];
+    end = padding <= size ? size - padding : 0;
+  }
+  if (offset >= end) {
+    ignored_packets_++;
+    return;
+  }
+
+  int ret = Decode(buf + offset, static_cast<int>(end - offset));
+  if (ret < 0) {
+    errors_++;
+    last_error_ = ret;
+  }
+}
+
+int RtspTalkback::Decode(const uint8_t* payload, int size) {
+  av_packet_unref(in_packet_);
+  int ret = av_new_packet(in_packet_, size);
+  if (ret < 0) {
+    return ret;
+  }
+  memcpy(in_packet_->data, payload, size);
+
+  {
+    Tracing::Scope trace("avcodec_send_packet", "ffmpeg", this);
+    ret = avcodec_send_packet(decoder_, in_packet_);
+  }
+  if (ret < 0) {
+    return ret;
+  }
+
+  while ((ret = avcodec_receive_frame(decoder_, decoded_)) >= 0) {
+    decoded_frames_++;
+    ret = Resample(decoded_);
+    av_frame_unref(decoded_);
+    if (ret < 0) {
+      return ret;
+    }
+    ret = Encode();
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) ? 0 : ret;
+}
+
+int RtspTalkback::Resample(const AVFrame* frame) {
+  int ret;
+
+  // Configured from the first decoded frame (decoder output format)
+  if (!swr_) {
+    ret = swr_alloc_set_opts2(&swr_,
+      &encoder_->ch_layout, encoder_->sample_fmt, encoder_->sample_rate,
+      &frame->ch_layout, static_cast<AVSampleFormat>(frame->format), frame->sample_rate,
+      0, nullptr);
+    if (ret < 0) {
+      return ret;
+    }
+    ret = swr_init(swr_);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  int out_samples = swr_get_out_samples(swr_, frame->nb_samples);
+  if (out_samples <= 0) {
+    return out_samples;
+  }
+
+  // resampled_->nb_samples is the capacity of the conversion buffer
+  if (resampled_->nb_samples < out_samples) {
+    av_frame_unref(resampled_);
+    resampled_->format = encoder_->sample_fmt;
+    resampled_->sample_rate = encoder_->sample_rate;
+    resampled_->nb_samples = out_samples;
+    av_channel_layout_copy(&resampled_->ch_layout, &encoder_->ch_layout);
+    ret = av_frame_get_buffer(resampled_, 0);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  int converted = swr_convert(swr_, resampled_->extended_data, out_samples,
+                              const_cast<const uint8_t**>(frame->extended_data), frame->nb_samples);
+  if (converted <= 0) {
+    return converted;
+  }
+
+  ret = av_audio_fifo_write(fifo_, reinterpret_cast<void**>(resampled_->extended_data), converted);
+  return ret < 0 ? ret : 0;
+}
+
+int RtspTalkback::Encode() {
+  int ret;
+
+  while (av_audio_fifo_size(fifo_) >= frame_samples_) {
+    ret = av_frame_make_writable(encode_frame_);
+    if (ret < 0) {
+      return ret;
+    }
+
+    ret = av_audio_fifo_read(fifo_, reinterpret_cast<void**>(encode_frame_->extended_data), frame_samples_);
+    if (ret < 0) {
+      return ret;
+    }
+    encode_frame_->pts = next_pts_;
+    next_pts_ += frame_samples_;
+
+    ret = avcodec_send_frame(encoder_, encode_frame_);
+    if (ret < 0) {
+      return ret;
+    }
+
+    while ((ret = avcodec_receive_packet(encoder_, out_packet_)) >= 0) {
+      encoded_packets_++;
+      Packetize(out_packet_);
+      av_packet_unref(out_packet_);
+    }
+
+    if (ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) {
+      return ret;
+    }
+  }
+
+  return 0;
+}
+
+int RtspTalkback::Packetize(const AVPacket* pkt) {
+  bool aac = encoder_->codec_id == AV_CODEC_ID_AAC;
+
+  // AAC-hbr AU-size is 13 bits; bigger frames cannot be signalled in one AU-header
+  if (aac && pkt->size >= (1 << 13)) {
+    errors_++;
+    last_error_ = AVERROR(EMSGSIZE);
+    return AVERROR(EMSGSIZE);
+  }
+
+  size_t header_size = RTP_HEADER_SIZE + (aac ? AU_HEADER_SECTION_SIZE : 0);
+  rtp_buffer_.resize(header_size + pkt->size);
+  uint8_t* rtp = rtp_buffer_.data();
+
+  // Marker bit on the first packet of the talkspurt (RFC 3551)
+  rtp[0] = 0x80;
+  rtp[1] = static_cast<uint8_t>((marker_pending_ ? 0x80 : 0x00) | payload_type_);
+  marker_pending_ = false;
+  WriteU16(rtp + 2, next_seq_++);
+
+  // Encoder time base is 1/sample_rate, which is the RTP clock for all supported codecs
+  int64_t pts = pkt->pts != AV_NOPTS_VALUE ? pkt->pts : 0;
+  WriteU32(rtp + 4, base_ts_ + static_cast<uint32_t>(pts));
+  WriteU32(rtp + 8, ssrc_);
+
+  if (aac) {
+    // AU-headers-length (16 bits) + AU-size (13 bits) / AU-index (3 bits)
+    rtp[12] = 0x00;
+    rtp[13] = 0x10;
+    rtp[14] = static_cast<uint8_t>((pkt->size >> 5) & 0xff);
+    rtp[15] = static_cast<uint8_t>((pkt->size & 0x1f) << 3);
+  }
+  memcpy(rtp + header_size, pkt->data, pkt->size);
+
+  int ret = format_->SendRTSPPacket(stream_index_, rtp, rtp_buffer_.size());
+  if (ret < 0) {
+    send_errors_++;
+    last_error_ = ret;
+    return ret;
+  }
+
+  sent_packets_++;
+  sent_bytes_ += rtp_buffer_.size();
+  return 0;
+}
+
+Napi::Value RtspTalkback::Push(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsBuffer()) {
+    Napi::TypeError::New(env, "rtpPacketData must be a Buffer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
+  std::vector<uint8_t> rtp(buffer.Data(), buffer.Data() + buffer.Length());
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_ || !running_) {
+      return Napi::Boolean::New(env, false);
+    }
+
+    // Talkback is latency sensitive - drop the oldest audio when the engine falls behind
+    if (queue_.size() >= options_.max_queue_packets) {
+      queue_.pop_front();
+      dropped_packets_++;
+    }
+    queue_.push_back(std::move(rtp));
+    received_packets_++;
+  }
+  cv_.notify_one();
+
+  return Napi::Boolean::New(env, true);
+}
+
+Napi::Value RtspTalkback::StopAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object thisObj = info.This().As<Napi::Object>();
+  auto* worker = new RTBStopWorker(env, thisObj, this);
+  worker->Queue();
+  return worker->GetPromise();
+}
+
+Napi::Value RtspTalkback::StopSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Stop();
+  format_ref_.Reset();
+
+  return env.Undefined();
+}
+
+Napi::Value RtspTalkback::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  size_t queued;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued = queue_.size();
+  }
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("receivedPackets", Napi::Number::New(env, static_cast<double>(received_packets_.load())));
+  stats.Set("queuedPackets", Napi::Number::New(env, static_cast<double>(queued)));
+  stats.Set("droppedPackets", Napi::Number::New(env, static_cast<double>(dropped_packets_.load())));
+  stats.Set("ignoredPackets", Napi::Number::New(env, static_cast<double>(ignored_packets_.load())));
+  stats.Set("latePackets", Napi::Number::New(env, static_cast<double>(late_packets_.load())));
+  stats.Set("lostPackets", Napi::Number::New(env, static_cast<double>(lost_packets_.load())));
+  stats.Set("decodedFrames", Napi::Number::New(env, static_cast<double>(decoded_frames_.load())));
+  stats.Set("encodedPackets", Napi::Number::New(env, static_cast<double>(encoded_packets_.load())));
+  stats.Set("sentPackets", Napi::Number::New(env, static_cast<double>(sent_packets_.load())));
+  stats.Set("sentBytes", Napi::Number::New(env, static_cast<double>(sent_bytes_.load())));
+  stats.Set("sendErrors", Napi::Number::New(env, static_cast<double>(send_errors_.load())));
+  stats.Set("errors", Napi::Number::New(env, static_cast<double>(errors_.load())));
+  stats.Set("lastError", Napi::Number::New(env, last_error_.load()));
+  return stats;
+}
+
+Napi::Value RtspTalkback::GetCodecId(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  return Napi::Number::New(env, encoder_ ? encoder_->codec_id : AV_CODEC_ID_NONE);
+}
+
+Napi::Value RtspTalkback::GetIsRunning(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  return Napi::Boolean::New(env, running_.load());
+}
+
+} // namespace ffmpeg
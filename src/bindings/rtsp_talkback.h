@@ -0,0 +1,133 @@
+#ifndef FFMPEG_RTSP_TALKBACK_H
+#define FFMPEG_RTSP_TALKBACK_H
+
+#include <napi.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common.h"
+
+extern "C" {
+#include <libavutil/audio_fifo.h>
+}
+
+namespace ffmpeg {
+
+class FormatContext;
+
+struct RtspTalkbackOptions {
+  int input_payload_type = -1;    // Only accept this inbound payload type, -1 = any
+  int input_channels = 2;         // Opus decoder output channels
+  int payload_type = -1;          // Outbound payload type, -1 = from SDP
+  bool has_ssrc = false;
+  uint32_t ssrc = 0;
+  int packet_duration_ms = 20;    // Packet duration for codecs without a fixed frame size
+  int64_t bit_rate = 0;           // Encoder bitrate (AAC), 0 = encoder default
+  size_t max_queue_packets = 64;  // Inbound queue depth, oldest packets are dropped
+};
+
+// Native WebRTC -> RTSP backchannel talkback engine.
+//
+// Inbound Opus RTP packets are queued by push() and processed on one native
+// thread per session: depacketize -> decode -> resample -> re-encode to the
+// backchannel codec (G.711 u-law/A-law, L16 or AAC) -> packetize -> send via
+// FormatContext::SendRTSPPacket(), the same path used by sendRTSPPacket().
+class RtspTalkback : public Napi::ObjectWrap<RtspTalkback> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  RtspTalkback(const Napi::CallbackInfo& info);
+  ~RtspTalkback();
+
+private:
+  friend class RTBStopWorker;
+
+  static Napi::FunctionReference constructor;
+
+  // Static methods
+  static Napi::Value Create(const Napi::CallbackInfo& info);
+
+  // Instance methods
+  Napi::Value Push(const Napi::CallbackInfo& info);
+  Napi::Value StopAsync(const Napi::CallbackInfo& info);
+  Napi::Value StopSync(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value GetCodecId(const Napi::CallbackInfo& info);
+  Napi::Value GetIsRunning(const Napi::CallbackInfo& info);
+
+  static bool ParseOptions(const Napi::Object& obj, RtspTalkbackOptions& options);
+
+  int Setup(AVCodecID codec_id, int sample_rate, int channels, int sdp_payload_type, std::string& error);
+  void Start();
+  void Stop();
+  void Run();
+  void Cleanup();
+
+  // Processing stages (worker thread only)
+  void HandleRtp(const std::vector<uint8_t>& rtp);
+  int Decode(const uint8_t* payload, int size);
+  int Resample(const AVFrame* frame);
+  int Encode();
+  int Packetize(const AVPacket* pkt);
+
+  RtspTalkbackOptions options_;
+
+  // Backchannel target (kept alive by format_ref_)
+  Napi::ObjectReference format_ref_;
+  FormatContext* format_ = nullptr;
+  int stream_index_ = -1;
+
+  // Codec chain
+  AVCodecContext* decoder_ = nullptr;
+  AVCodecContext* encoder_ = nullptr;
+  SwrContext* swr_ = nullptr;
+  AVAudioFifo* fifo_ = nullptr;
+  AVPacket* in_packet_ = nullptr;
+  AVPacket* out_packet_ = nullptr;
+  AVFrame* decoded_ = nullptr;
+  AVFrame* resampled_ = nullptr;
+  AVFrame* encode_frame_ = nullptr;
+  int frame_samples_ = 0;
+  int64_t next_pts_ = 0;
+
+  // Outbound RTP state
+  uint8_t payload_type_ = 0;
+  uint32_t ssrc_ = 0;
+  uint16_t next_seq_ = 0;
+  uint32_t base_ts_ = 0;
+  bool marker_pending_ = true;
+  std::vector<uint8_t> rtp_buffer_;
+
+  // Inbound sequence tracking
+  bool have_seq_ = false;
+  uint16_t last_seq_ = 0;
+
+  // Worker thread
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::vector<uint8_t>> queue_;
+  bool stopping_ = false;
+  std::atomic<bool> running_{false};
+
+  // Statistics
+  std::atomic<uint64_t> received_packets_{0};
+  std::atomic<uint64_t> dropped_packets_{0};
+  std::atomic<uint64_t> ignored_packets_{0};
+  std::atomic<uint64_t> late_packets_{0};
+  std::atomic<uint64_t> lost_packets_{0};
+  std::atomic<uint64_t> decoded_frames_{0};
+  std::atomic<uint64_t> errors_{0};
+  std::atomic<uint64_t> encoded_packets_{0};
+  std::atomic<uint64_t> sent_packets_{0};
+  std::atomic<uint64_t> sent_bytes_{0};
+  std::atomic<uint64_t> send_errors_{0};
+  std::atomic<int> last_error_{0};
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_RTSP_TALKBACK_H
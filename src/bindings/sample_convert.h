@@ -0,0 +1,70 @@
+#ifndef FFMPEG_SAMPLE_CONVERT_H
+#define FFMPEG_SAMPLE_CONVERT_H
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+#include <libavutil/samplefmt.h>
+}
+
+namespace ffmpeg {
+
+// Whether SamplesToDouble can read a (packed) sample format
+inline bool IsConvertibleSampleFormat(AVSampleFormat packed) {
+  switch (packed) {
+    case AV_SAMPLE_FMT_U8:
+    case AV_SAMPLE_FMT_S16:
+    case AV_SAMPLE_FMT_S32:
+    case AV_SAMPLE_FMT_S64:
+    case AV_SAMPLE_FMT_FLT:
+    case AV_SAMPLE_FMT_DBL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Convert count samples of one channel to double in [-1, 1).
+// index is the first sample and stride the distance between samples of the
+// channel, in samples (1 for planar data, the channel count for packed data).
+inline void SamplesToDouble(double* dst, const uint8_t* data, AVSampleFormat packed, size_t index, size_t stride, size_t count) {
+  switch (packed) {
+    case AV_SAMPLE_FMT_U8: {
+      const uint8_t* src = data + index;
+      for (size_t i = 0; i < count; i++) dst[i] = (src[i * stride] - 128) * (1.0 / 128);
+      break;
+    }
+    case AV_SAMPLE_FMT_S16: {
+      const int16_t* src = reinterpret_cast<const int16_t*>(data) + index;
+      for (size_t i = 0; i < count; i++) dst[i] = src[i * stride] * (1.0 / 32768);
+      break;
+    }
+    case AV_SAMPLE_FMT_S32: {
+      const int32_t* src = reinterpret_cast<const int32_t*>(data) + index;
+      for (size_t i = 0; i < count; i++) dst[i] = src[i * stride] * (1.0 / 2147483648.0);
+      break;
+    }
+    case AV_SAMPLE_FMT_S64: {
+      const int64_t* src = reinterpret_cast<const int64_t*>(data) + index;
+      for (size_t i = 0; i < count; i++) dst[i] = static_cast<double>(src[i * stride]) * (1.0 / 9223372036854775808.0);
+      break;
+    }
+    case AV_SAMPLE_FMT_FLT: {
+      const float* src = reinterpret_cast<const float*>(data) + index;
+      for (size_t i = 0; i < count; i++) dst[i] = src[i * stride];
+      break;
+    }
+    case AV_SAMPLE_FMT_DBL: {
+      const double* src = reinterpret_cast<const double*>(data) + index;
+      for (size_t i = 0; i < count; i++) dst[i] = src[i * stride];
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_SAMPLE_CONVERT_H
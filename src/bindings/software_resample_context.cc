@@ -16,7 +16,9 @@ Napi::Object SoftwareResampleContext::Init(Napi::Env env, Napi::Object exports)
     InstanceMethod<&SoftwareResampleContext::Close>("close"),
     InstanceMethod<&SoftwareResampleContext::ConvertAsync>("convert"),
     InstanceMethod<&SoftwareResampleContext::ConvertSync>("convertSync"),
-    InstanceMethod<&SoftwareResampleContext::ConvertFrame>("convertFrame"),
+    InstanceMethod<&SoftwareResampleContext::ConvertFrameAsync>("convertFrame"),
+    InstanceMethod<&SoftwareResampleContext::ConvertFrameSync>("convertFrameSync"),
+    InstanceMethod<&SoftwareResampleContext::ConvertFramesAsync>("convertFrames"),
     InstanceMethod<&SoftwareResampleContext::ConfigFrame>("configFrame"),
     InstanceMethod<&SoftwareResampleContext::IsInitialized>("isInitialized"),
     InstanceMethod<&SoftwareResampleContext::GetDelay>("getDelay"),
@@ -167,7 +169,7 @@ Napi::Value SoftwareResampleContext::Close(const Napi::CallbackInfo& info) {
   return env.Undefined();
 }
 
-Napi::Value SoftwareResampleContext::ConvertFrame(const Napi::CallbackInfo& info) {
+Napi::Value SoftwareResampleContext::ConvertFrameSync(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   
   SwrContext* ctx = Get();
@@ -203,6 +205,9 @@ Napi::Value SoftwareResampleContext::ConvertFrame(const Napi::CallbackInfo& info
   int ret = swr_convert_frame(ctx, 
     out ? out->Get() : nullptr,
     in ? in->Get() : nullptr);
+  if (out) {
+    out->TrackMemory();
+  }
   
   return Napi::Number::New(env, ret);
 }
@@ -23,6 +23,7 @@ public:
 private:
   friend class AVOptionWrapper;
   friend class SwrConvertWorker;
+  friend class SwrConvertFramesWorker;
 
   static Napi::FunctionReference constructor;
 
@@ -35,7 +36,9 @@ private:
   Napi::Value Close(const Napi::CallbackInfo& info);
   Napi::Value ConvertAsync(const Napi::CallbackInfo& info);
   Napi::Value ConvertSync(const Napi::CallbackInfo& info);
-  Napi::Value ConvertFrame(const Napi::CallbackInfo& info);
+  Napi::Value ConvertFrameAsync(const Napi::CallbackInfo& info);
+  Napi::Value ConvertFrameSync(const Napi::CallbackInfo& info);
+  Napi::Value ConvertFramesAsync(const Napi::CallbackInfo& info);
   Napi::Value ConfigFrame(const Napi::CallbackInfo& info);
   Napi::Value IsInitialized(const Napi::CallbackInfo& info);
   Napi::Value GetDelay(const Napi::CallbackInfo& info);
@@ -1,8 +1,12 @@
 #include "software_resample_context.h"
+#include "frame.h"
+#include "tracing.h"
 #include <napi.h>
+#include <vector>
 
 extern "C" {
 #include <libswresample/swresample.h>
+#include <libavutil/opt.h>
 }
 
 namespace ffmpeg {
@@ -40,6 +44,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("SwrConvertWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_ || !ctx_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -123,4 +129,209 @@ Napi::Value SoftwareResampleContext::ConvertAsync(const Napi::CallbackInfo& info
   return worker->GetPromise();
 }
 
+class SwrConvertFramesWorker : public Napi::AsyncWorker {
+public:
+  // prepare_outputs: give output frames the output parameters of the context
+  // and reuse their buffers (batch mode); otherwise frames are passed as is
+  SwrConvertFramesWorker(Napi::Env env, Napi::Object ctxObj, SoftwareResampleContext* ctx, bool prepare_outputs)
+    : Napi::AsyncWorker(env),
+      ctx_(ctx),
+      prepare_outputs_(prepare_outputs),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    ctx_ref_.Reset(ctxObj, 1);
+  }
+
+  ~SwrConvertFramesWorker() {
+    ctx_ref_.Reset();
+    for (auto& ref : frame_refs_) {
+      ref.Reset();
+    }
+  }
+
+  void AddPair(Napi::Value outVal, Frame* out, Napi::Value inVal, Frame* in) {
+    // Hold references to frames to prevent GC during async operation
+    if (out) frame_refs_.push_back(Napi::Persistent(outVal.As<Napi::Object>()));
+    if (in) frame_refs_.push_back(Napi::Persistent(inVal.As<Napi::Object>()));
+    pairs_.push_back({out, in});
+  }
+
+  void Execute() override {
+    Tracing::Scope trace("SwrConvertFramesWorker", "worker", ctx_);
+
+    if (!ctx_ || !ctx_->Get()) {
+      ret_ = AVERROR(EINVAL);
+      return;
+    }
+
+    SwrContext* ctx = ctx_->Get();
+    for (const auto& pair : pairs_) {
+      AVFrame* out = pair.out ? pair.out->Get() : nullptr;
+      AVFrame* in = pair.in ? pair.in->Get() : nullptr;
+
+      if (out && prepare_outputs_) {
+        ret_ = PrepareOutput(ctx, out);
+        if (ret_ < 0) return;
+      }
+
+      ret_ = swr_convert_frame(ctx, out, in);
+      if (ret_ < 0) return;
+    }
+  }
+
+  void OnOK() override {
+    for (const auto& pair : pairs_) {
+      if (pair.out) pair.out->TrackMemory();
+    }
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  struct Pair {
+    Frame* out;
+    Frame* in;
+  };
+
+  // A writable output buffer is reused with its full capacity, a shared one
+  // is released so swr_convert_frame() allocates a new one. Unset output
+  // parameters are taken from the context.
+  static int PrepareOutput(SwrContext* ctx, AVFrame* out) {
+    if (out->buf[0] && !av_frame_is_writable(out)) {
+      av_frame_unref(out);
+    }
+    if (out->buf[0]) {
+      // swr_convert_frame() fills up to the capacity of the buffer
+      out->nb_samples = 0;
+    }
+
+    int ret;
+    if (out->ch_layout.nb_channels == 0) {
+      ret = av_opt_get_chlayout(ctx, "out_chlayout", 0, &out->ch_layout);
+      if (ret < 0) return ret;
+    }
+    if (out->format < 0) {
+      AVSampleFormat format;
+      ret = av_opt_get_sample_fmt(ctx, "out_sample_fmt", 0, &format);
+      if (ret < 0) return ret;
+      out->format = format;
+    }
+    if (out->sample_rate <= 0) {
+      int64_t rate;
+      ret = av_opt_get_int(ctx, "out_sample_rate", 0, &rate);
+      if (ret < 0) return ret;
+      out->sample_rate = static_cast<int>(rate);
+    }
+    return 0;
+  }
+
+  Napi::ObjectReference ctx_ref_;
+  SoftwareResampleContext* ctx_;
+  std::vector<Napi::ObjectReference> frame_refs_;
+  std::vector<Pair> pairs_;
+  bool prepare_outputs_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+Napi::Value SoftwareResampleContext::ConvertFrameAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!ctx_) {
+    Napi::TypeError::New(env, "SoftwareResampleContext is not initialized").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected 2 arguments (out, in)").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Frame* out = nullptr;
+  Frame* in = nullptr;
+
+  if (!info[0].IsNull()) {
+    out = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+    if (!out || !out->Get()) {
+      Napi::TypeError::New(env, "Invalid output frame").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  if (!info[1].IsNull()) {
+    in = UnwrapNativeObject<Frame>(env, info[1], "Frame");
+    if (!in || !in->Get()) {
+      Napi::TypeError::New(env, "Invalid input frame").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+
+  Napi::Object thisObj = info.This().As<Napi::Object>();
+  auto* worker = new SwrConvertFramesWorker(env, thisObj, this, false);
+  worker->AddPair(info[0], out, info[1], in);
+  worker->Queue();
+  return worker->GetPromise();
+}
+
+Napi::Value SoftwareResampleContext::ConvertFramesAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!ctx_) {
+    Napi::TypeError::New(env, "SoftwareResampleContext is not initialized").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsArray()) {
+    Napi::TypeError::New(env, "Expected 2 arrays (out, in)").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Array outArray = info[0].As<Napi::Array>();
+  Napi::Array inArray = info[1].As<Napi::Array>();
+  if (outArray.Length() < inArray.Length()) {
+    Napi::RangeError::New(env, "Expected one output frame per input frame").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::vector<Frame*> outs;
+  std::vector<Frame*> ins;
+  for (uint32_t i = 0; i < inArray.Length(); i++) {
+    Frame* out = UnwrapNativeObject<Frame>(env, outArray.Get(i), "Frame");
+    if (!out || !out->Get()) {
+      Napi::TypeError::New(env, "Invalid output frame").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    // A null input flushes the resampler
+    Frame* in = nullptr;
+    Napi::Value inVal = inArray.Get(i);
+    if (!inVal.IsNull() && !inVal.IsUndefined()) {
+      in = UnwrapNativeObject<Frame>(env, inVal, "Frame");
+      if (!in || !in->Get()) {
+        Napi::TypeError::New(env, "Invalid input frame").ThrowAsJavaScriptException();
+        return env.Null();
+      }
+    }
+
+    outs.push_back(out);
+    ins.push_back(in);
+  }
+
+  Napi::Object thisObj = info.This().As<Napi::Object>();
+  auto* worker = new SwrConvertFramesWorker(env, thisObj, this, true);
+  for (uint32_t i = 0; i < inArray.Length(); i++) {
+    worker->AddPair(outArray.Get(i), outs[i], inArray.Get(i), ins[i]);
+  }
+
+  worker->Queue();
+  return worker->GetPromise();
+}
+
 } // namespace ffmpeg
\ No newline at end of file
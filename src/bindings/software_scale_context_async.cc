@@ -1,5 +1,6 @@
 #include "software_scale_context.h"
 #include "frame.h"
+#include "tracing.h"
 #include <napi.h>
 
 extern "C" {
@@ -31,6 +32,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("SwsScaleFrameWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_ || !ctx_->Get()) {
       ret_ = AVERROR(EINVAL);
@@ -42,6 +45,7 @@ public:
       return;
     }
 
+    Tracing::Scope call("sws_scale_frame", "ffmpeg", ctx_);
     ret_ = sws_scale_frame(ctx_->Get(), dst_->Get(), src_->Get());
   }
 
@@ -107,6 +111,8 @@ public:
   }
 
   void Execute() override {
+    Tracing::Scope trace("SwsScaleWorker", "worker", ctx_);
+
     // Null checks to prevent use-after-free crashes
     if (!ctx_ || !ctx_->Get()) {
       ret_ = AVERROR(EINVAL);
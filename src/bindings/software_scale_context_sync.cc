@@ -1,5 +1,6 @@
 #include "software_scale_context.h"
 #include "frame.h"
+#include "tracing.h"
 #include <napi.h>
 
 extern "C" {
@@ -25,6 +26,7 @@ Napi::Value SoftwareScaleContext::ScaleFrameSync(const Napi::CallbackInfo& info)
   Frame* src = Napi::ObjectWrap<Frame>::Unwrap(info[1].As<Napi::Object>());
 
   // Direct synchronous call
+  Tracing::Scope trace("sws_scale_frame", "ffmpeg", this);
   int ret = sws_scale_frame(ctx_, dst->Get(), src->Get());
 
   return Napi::Number::New(env, ret);
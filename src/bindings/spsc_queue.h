@@ -0,0 +1,73 @@
+#ifndef FFMPEG_SPSC_QUEUE_H
+#define FFMPEG_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace ffmpeg {
+
+// Bounded lock-free single-producer/single-consumer ring.
+//
+// TryPush() must only be called from one thread and TryPop() from one (other)
+// thread. Capacity is rounded up to a power of two. Head and tail live on
+// separate cache lines so producer and consumer do not false-share.
+template <typename T>
+class SpscQueue {
+public:
+  explicit SpscQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    buffer_.resize(size);
+    mask_ = size - 1;
+    capacity_ = capacity < 1 ? 1 : capacity;
+  }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // Producer side
+  bool TryPush(const T& item) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= capacity_) {
+      return false;
+    }
+    buffer_[tail & mask_] = item;
+    tail_.store(tail + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  // Consumer side
+  bool TryPop(T& item) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = buffer_[head & mask_];
+    head_.store(head + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  // Approximate when called concurrently with push/pop
+  size_t Size() const {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+  bool Empty() const { return Size() == 0; }
+  bool Full() const { return Size() >= capacity_; }
+  size_t Capacity() const { return capacity_; }
+
+private:
+  std::vector<T> buffer_;
+  size_t mask_ = 0;
+  size_t capacity_ = 0;
+
+  alignas(64) std::atomic<size_t> head_{0};  // Written by consumer
+  alignas(64) std::atomic<size_t> tail_{0};  // Written by producer
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_SPSC_QUEUE_H
@@ -0,0 +1,101 @@
+#include "timestamp_rescaler.h"
+
+extern "C" {
+#include <libavutil/avutil.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference TimestampRescaler::constructor;
+
+Napi::Object TimestampRescaler::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "TimestampRescaler", {
+    StaticMethod<&TimestampRescaler::Create>("create"),
+    InstanceMethod<&TimestampRescaler::Rescale>("rescale"),
+    InstanceMethod<&TimestampRescaler::RescaleArray>("rescaleArray"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("TimestampRescaler", func);
+  return exports;
+}
+
+TimestampRescaler::TimestampRescaler(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<TimestampRescaler>(info) {
+  // Created via TimestampRescaler.create()
+}
+
+void TimestampRescaler::RescaleValues(const int64_t* values, int64_t* out, size_t count,
+                                      int64_t b, int64_t c, AVRounding rnd) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = av_rescale_rnd(values[i], b, c, rnd);
+  }
+}
+
+Napi::Value TimestampRescaler::Create(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Expected source and destination time base").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  AVRational bq = JSToRational(info[0].As<Napi::Object>());
+  AVRational cq = JSToRational(info[1].As<Napi::Object>());
+
+  Napi::Object obj = constructor.New({});
+  TimestampRescaler* rescaler = Napi::ObjectWrap<TimestampRescaler>::Unwrap(obj);
+
+  // Same factors as av_rescale_q_rnd(); invalid time bases give INT64_MIN like it
+  rescaler->b_ = bq.num * static_cast<int64_t>(cq.den);
+  rescaler->c_ = cq.num * static_cast<int64_t>(bq.den);
+  if (info.Length() > 2 && info[2].IsNumber()) {
+    rescaler->rnd_ = static_cast<AVRounding>(info[2].As<Napi::Number>().Int32Value());
+  }
+
+  return obj;
+}
+
+Napi::Value TimestampRescaler::Rescale(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int64_t a;
+  if (info.Length() > 0 && info[0].IsBigInt()) {
+    bool lossless;
+    a = info[0].As<Napi::BigInt>().Int64Value(&lossless);
+  } else if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    a = AV_NOPTS_VALUE;
+  } else {
+    a = info[0].As<Napi::Number>().Int64Value();
+  }
+
+  return Napi::BigInt::New(env, av_rescale_rnd(a, b_, c_, rnd_));
+}
+
+Napi::Value TimestampRescaler::RescaleArray(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_bigint64_array) {
+    Napi::TypeError::New(env, "Expected BigInt64Array").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::TypedArrayOf<int64_t> values = info[0].As<Napi::TypedArrayOf<int64_t>>();
+  Napi::TypedArrayOf<int64_t> out = values;
+  if (info.Length() > 1 && !info[1].IsNull() && !info[1].IsUndefined()) {
+    if (!info[1].IsTypedArray() || info[1].As<Napi::TypedArray>().TypedArrayType() != napi_bigint64_array ||
+        info[1].As<Napi::TypedArray>().ElementLength() < values.ElementLength()) {
+      Napi::TypeError::New(env, "Output must be a BigInt64Array at least as long as the input").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    out = info[1].As<Napi::TypedArrayOf<int64_t>>();
+  }
+
+  RescaleValues(values.Data(), out.Data(), values.ElementLength(), b_, c_, rnd_);
+  return out;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,45 @@
+#ifndef FFMPEG_TIMESTAMP_RESCALER_H
+#define FFMPEG_TIMESTAMP_RESCALER_H
+
+#include <napi.h>
+#include "common.h"
+
+extern "C" {
+#include <libavutil/mathematics.h>
+}
+
+namespace ffmpeg {
+
+// Timestamp rescaler bound to one source/destination time base pair.
+//
+// av_rescale_q_rnd(a, bq, cq) is av_rescale_rnd(a, bq.num * cq.den,
+// cq.num * bq.den). Both factors are computed once at creation, so a call
+// only converts the timestamp argument: no time base objects are read and
+// results are identical to avRescaleQRnd().
+class TimestampRescaler : public Napi::ObjectWrap<TimestampRescaler> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  TimestampRescaler(const Napi::CallbackInfo& info);
+
+  // Rescale values into out (may be values itself)
+  static void RescaleValues(const int64_t* values, int64_t* out, size_t count,
+                            int64_t b, int64_t c, AVRounding rnd);
+
+private:
+  static Napi::FunctionReference constructor;
+
+  // Static methods
+  static Napi::Value Create(const Napi::CallbackInfo& info);
+
+  // Instance methods
+  Napi::Value Rescale(const Napi::CallbackInfo& info);
+  Napi::Value RescaleArray(const Napi::CallbackInfo& info);
+
+  int64_t b_ = 1;
+  int64_t c_ = 1;
+  AVRounding rnd_ = AV_ROUND_NEAR_INF;
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_TIMESTAMP_RESCALER_H
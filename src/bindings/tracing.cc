@@ -0,0 +1,219 @@
+#include "tracing.h"
+#include "spsc_queue.h"
+#include <uv.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ffmpeg {
+
+std::atomic<bool> Tracing::enabled_{false};
+
+namespace {
+
+struct TraceEvent {
+  const char* name;
+  const char* category;
+  const void* object;
+  uint64_t start;
+  uint64_t end;
+};
+
+struct ThreadRing {
+  ThreadRing(int id, size_t capacity) : id(id), events(capacity) {}
+
+  int id;
+  std::string name;
+  SpscQueue<TraceEvent> events;
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<bool> owned{true};  // Cleared when the recording thread exits
+};
+
+constexpr size_t kDefaultRingEvents = 1 << 15;
+
+// Rings alive at once. Threads come and go with sessions (UDP senders,
+// pacers, pipeline stages), so rings of exited threads are reused once
+// drained and freed by export; past the cap, events are dropped.
+constexpr size_t kMaxRings = 256;
+
+std::mutex rings_mutex;
+std::vector<std::unique_ptr<ThreadRing>> rings;
+std::atomic<size_t> ring_events{kDefaultRingEvents};
+std::atomic<uint64_t> ringless_dropped{0};
+int next_ring_id = 0;
+
+// Serializes the consumer side of all rings
+std::mutex export_mutex;
+
+// Hands the ring back when the thread exits
+struct RingOwner {
+  ThreadRing* ring = nullptr;
+
+  ~RingOwner() {
+    if (ring) {
+      ring->owned.store(false, std::memory_order_release);
+      ring = nullptr;
+    }
+  }
+};
+
+thread_local RingOwner thread_ring;
+
+ThreadRing* CurrentRing() {
+  if (!thread_ring.ring) {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    size_t capacity = ring_events.load(std::memory_order_relaxed);
+
+    // Drained ring of an exited thread, under a new thread id
+    for (auto& ring : rings) {
+      if (!ring->owned.load(std::memory_order_acquire) && ring->events.Empty() &&
+          ring->events.Capacity() == capacity) {
+        ring->owned.store(true, std::memory_order_relaxed);
+        thread_ring.ring = ring.get();
+        break;
+      }
+    }
+
+    if (!thread_ring.ring) {
+      if (rings.size() >= kMaxRings) {
+        return nullptr;
+      }
+      rings.push_back(std::make_unique<ThreadRing>(0, capacity));
+      thread_ring.ring = rings.back().get();
+    }
+
+    thread_ring.ring->id = ++next_ring_id;
+    thread_ring.ring->name = "native " + std::to_string(thread_ring.ring->id);
+  }
+  return thread_ring.ring;
+}
+
+void NameCurrentThread(const char* name) {
+  ThreadRing* ring = CurrentRing();
+  if (!ring) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(rings_mutex);
+  ring->name = name;
+}
+
+} // namespace
+
+uint64_t Tracing::Now() {
+  return uv_hrtime();
+}
+
+void Tracing::Record(const char* name, const char* category, const void* object, uint64_t start, uint64_t end) {
+  ThreadRing* ring = CurrentRing();
+  if (!ring) {
+    ringless_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (!ring->events.TryPush({name, category, object, start, end})) {
+    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+Napi::Object Tracing::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setNativeTracing", Napi::Function::New(env, SetEnabled));
+  exports.Set("exportNativeTrace", Napi::Function::New(env, Export));
+  return exports;
+}
+
+Napi::Value Tracing::SetEnabled(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsBoolean()) {
+    Napi::TypeError::New(env, "Enabled (boolean) required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Applies to rings of threads that record their first event afterwards
+  if (info.Length() > 1 && info[1].IsNumber()) {
+    int64_t events = info[1].As<Napi::Number>().Int64Value();
+    if (events < 1) {
+      Napi::RangeError::New(env, "Buffer size must be positive").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    ring_events.store(static_cast<size_t>(events), std::memory_order_relaxed);
+  }
+
+  bool enabled = info[0].As<Napi::Boolean>().Value();
+  if (enabled) {
+    NameCurrentThread("JavaScript");
+  }
+  enabled_.store(enabled, std::memory_order_relaxed);
+  return env.Undefined();
+}
+
+Napi::Value Tracing::Export(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // Also keeps the snapshot valid, rings are only freed under this lock
+  std::lock_guard<std::mutex> lock(export_mutex);
+  std::vector<ThreadRing*> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    for (auto& ring : rings) {
+      snapshot.push_back(ring.get());
+    }
+  }
+
+  int pid = static_cast<int>(uv_os_getpid());
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  char line[512];
+  uint64_t dropped = 0;
+
+  auto append = [&](int length) {
+    if (!first) {
+      json += ',';
+    }
+    first = false;
+    json.append(line, static_cast<size_t>(length) < sizeof(line) ? length : sizeof(line) - 1);
+  };
+
+  for (ThreadRing* ring : snapshot) {
+    // A drained ring may be taken over by a new thread with a new id
+    int tid;
+    {
+      std::lock_guard<std::mutex> name_lock(rings_mutex);
+      tid = ring->id;
+      append(snprintf(line, sizeof(line),
+                      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                      pid, tid, ring->name.c_str()));
+    }
+
+    // Complete events: begin timestamp plus duration, in microseconds
+    TraceEvent event;
+    while (ring->events.TryPop(event)) {
+      append(snprintf(line, sizeof(line),
+                      "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d,"
+                      "\"args\":{\"object\":\"%p\"}}",
+                      event.name, event.category, event.start / 1000.0, (event.end - event.start) / 1000.0,
+                      pid, tid, event.object));
+    }
+    dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+  }
+  dropped += ringless_dropped.exchange(0, std::memory_order_relaxed);
+
+  // Free the drained rings of exited threads
+  {
+    std::lock_guard<std::mutex> rings_lock(rings_mutex);
+    rings.erase(std::remove_if(rings.begin(), rings.end(),
+                               [](const std::unique_ptr<ThreadRing>& ring) {
+                                 return !ring->owned.load(std::memory_order_acquire) && ring->events.Empty();
+                               }),
+                rings.end());
+  }
+
+  snprintf(line, sizeof(line), "],\"otherData\":{\"droppedEvents\":%" PRIu64 "}}", dropped);
+  json += line;
+  return Napi::String::New(env, json);
+}
+
+} // namespace ffmpeg
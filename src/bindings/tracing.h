@@ -0,0 +1,63 @@
+#ifndef FFMPEG_TRACING_H
+#define FFMPEG_TRACING_H
+
+#include <napi.h>
+#include <atomic>
+#include <cstdint>
+
+namespace ffmpeg {
+
+// Opt-in timing of native work, exported as Chrome trace JSON.
+//
+// While enabled, Scope records one complete event (name, category, object,
+// start, duration) per AsyncWorker::Execute and per key FFmpeg call. Every
+// thread writes into its own lock-free single-producer ring, so recording
+// never takes a lock; export drains the rings from the JS thread. When a
+// ring is full new events are dropped and counted. Rings of exited threads
+// are reused by new threads once drained, or freed by the next export, so
+// short-lived session threads do not accumulate rings. Timestamps come from
+// uv_hrtime(), the monotonic clock V8 uses for --cpu-prof, so both can be
+// lined up in the DevTools performance panel.
+class Tracing {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  // Times the enclosing block. Category is "worker" for AsyncWorker::Execute
+  // and "ffmpeg" for library calls. Names and categories must be string
+  // literals, only the pointers are stored.
+  class Scope {
+  public:
+    Scope(const char* name, const char* category, const void* object)
+      : name_(name), category_(category), object_(object), start_(Enabled() ? Now() : 0) {}
+
+    ~Scope() {
+      if (start_ != 0) {
+        Record(name_, category_, object_, start_, Now());
+      }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    const char* name_;
+    const char* category_;
+    const void* object_;
+    uint64_t start_;
+  };
+
+private:
+  static std::atomic<bool> enabled_;
+
+  static uint64_t Now();
+  static void Record(const char* name, const char* category, const void* object, uint64_t start, uint64_t end);
+
+  static Napi::Value SetEnabled(const Napi::CallbackInfo& info);
+  static Napi::Value Export(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_TRACING_H
@@ -0,0 +1,321 @@
+#include "udp_sender.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+extern "C" {
+#include <libavutil/mem.h>
+}
+
+namespace ffmpeg {
+
+// Datagrams per sendmmsg() call, the size of the message arrays
+static constexpr int MAX_BATCH_DATAGRAMS = 64;
+
+#ifdef _WIN32
+static const udp_socket_t INVALID_UDP_SOCKET = INVALID_SOCKET;
+static void CloseUdpSocket(udp_socket_t s) { closesocket(s); }
+static std::once_flag wsa_once;
+#else
+static const udp_socket_t INVALID_UDP_SOCKET = -1;
+static void CloseUdpSocket(udp_socket_t s) { close(s); }
+#endif
+
+UdpSender::UdpSender(const UdpSenderOptions& options)
+  : options_(options),
+    socket_(INVALID_UDP_SOCKET) {
+  options_.max_batch_datagrams = std::clamp(options_.max_batch_datagrams, 1, MAX_BATCH_DATAGRAMS);
+
+  bytes_per_sec_ = options_.pacing_bitrate / 8.0;
+  if (bytes_per_sec_ > 0) {
+    // Default bucket: 20ms worth of data, at least a few MTU-sized datagrams
+    bucket_size_ = options_.burst_bytes > 0
+      ? static_cast<double>(options_.burst_bytes)
+      : std::max(bytes_per_sec_ * 0.02, 4.0 * 1500.0);
+    tokens_ = bucket_size_;
+  }
+  last_refill_ = std::chrono::steady_clock::now();
+}
+
+UdpSender::~UdpSender() {
+  Stop();
+  if (socket_ != INVALID_UDP_SOCKET) {
+    CloseUdpSocket(socket_);
+    socket_ = INVALID_UDP_SOCKET;
+  }
+}
+
+std::unique_ptr<UdpSender> UdpSender::Create(const UdpSenderOptions& options, std::string& error) {
+#ifdef _WIN32
+  std::call_once(wsa_once, []() {
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+  });
+#endif
+
+  if (options.port <= 0 || options.port > 65535) {
+    error = "Invalid UDP port";
+    return nullptr;
+  }
+
+  // Numeric hosts only - name resolution would block the event loop
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_DGRAM;
+  hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV;
+
+  struct addrinfo* res = nullptr;
+  std::string port = std::to_string(options.port);
+  if (getaddrinfo(options.address.c_str(), port.c_str(), &hints, &res) != 0 || !res) {
+    error = "Invalid UDP address (numeric IPv4/IPv6 expected): " + options.address;
+    return nullptr;
+  }
+
+  std::unique_ptr<UdpSender> sender(new UdpSender(options));
+  sender->socket_ = socket(res->ai_family, SOCK_DGRAM, IPPROTO_UDP);
+  if (sender->socket_ == INVALID_UDP_SOCKET) {
+    freeaddrinfo(res);
+    error = "Failed to create UDP socket";
+    return nullptr;
+  }
+
+  if (options.send_buffer_size > 0) {
+    int size = options.send_buffer_size;
+    setsockopt(sender->socket_, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&size), sizeof(size));
+  }
+
+  // Connected socket: the kernel caches the route and msg_name can stay empty
+  if (connect(sender->socket_, res->ai_addr, static_cast<int>(res->ai_addrlen)) != 0) {
+    freeaddrinfo(res);
+    error = "Failed to connect UDP socket";
+    return nullptr;
+  }
+  freeaddrinfo(res);
+
+  sender->thread_ = std::thread(&UdpSender::Run, sender.get());
+  return sender;
+}
+
+bool UdpSender::ParseOptions(const Napi::Object& obj, UdpSenderOptions& options) {
+  Napi::Value address = obj.Get("address");
+  Napi::Value port = obj.Get("port");
+  if (!address.IsString() || !port.IsNumber()) {
+    return false;
+  }
+
+  options.address = address.As<Napi::String>().Utf8Value();
+  options.port = port.As<Napi::Number>().Int32Value();
+
+  Napi::Value v = obj.Get("pacingBitrate");
+  if (v.IsNumber()) {
+    options.pacing_bitrate = std::max(0.0, v.As<Napi::Number>().DoubleValue());
+  }
+  v = obj.Get("burstBytes");
+  if (v.IsNumber()) {
+    options.burst_bytes = static_cast<size_t>(std::max(0.0, v.As<Napi::Number>().DoubleValue()));
+  }
+  v = obj.Get("maxQueuePackets");
+  if (v.IsNumber()) {
+    options.max_queue_packets = static_cast<size_t>(std::max(1.0, v.As<Napi::Number>().DoubleValue()));
+  }
+  v = obj.Get("maxBatchDatagrams");
+  if (v.IsNumber()) {
+    options.max_batch_datagrams = v.As<Napi::Number>().Int32Value();
+  }
+  v = obj.Get("sendBufferSize");
+  if (v.IsNumber()) {
+    options.send_buffer_size = v.As<Napi::Number>().Int32Value();
+  }
+
+  return true;
+}
+
+void UdpSender::Enqueue(uint8_t* data, std::vector<uint32_t>&& offsets) {
+  size_t count = offsets.empty() ? 0 : offsets.size() - 1;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!stopping_ && count > 0 && queued_packets_ + count <= options_.max_queue_packets) {
+      Chunk chunk;
+      chunk.data = data;
+      chunk.offsets = std::move(offsets);
+      queue_.push_back(std::move(chunk));
+      queued_packets_ += count;
+      data = nullptr;
+    }
+  }
+
+  if (data) {
+    // Queue full (receiver or pacer can't keep up) - tail drop the batch
+    dropped_packets_ += count;
+    av_free(data);
+    return;
+  }
+
+  cv_.notify_one();
+}
+
+void UdpSender::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+    stopping_ = true;
+  }
+  cv_.notify_one();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void UdpSender::Refill(std::chrono::steady_clock::time_point now) {
+  double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+  last_refill_ = now;
+  tokens_ = std::min(bucket_size_, tokens_ + elapsed * bytes_per_sec_);
+}
+
+int UdpSender::SendDatagrams(uint8_t* base, const uint32_t* offsets, int count) {
+#if defined(__linux__)
+  struct mmsghdr msgs[MAX_BATCH_DATAGRAMS];
+  struct iovec iovs[MAX_BATCH_DATAGRAMS];
+  count = std::min(count, MAX_BATCH_DATAGRAMS);
+
+  for (int i = 0; i < count; i++) {
+    iovs[i].iov_base = base + offsets[i];
+    iovs[i].iov_len = offsets[i + 1] - offsets[i];
+    memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int sent = 0;
+  while (sent < count) {
+    int ret = sendmmsg(socket_, msgs + sent, count - sent, 0);
+    syscalls_++;
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // Skip the failing datagram (e.g. ECONNREFUSED from ICMP) and keep going
+      send_errors_++;
+      dropped_packets_++;
+      sent++;
+      continue;
+    }
+    for (int i = sent; i < sent + ret; i++) {
+      sent_bytes_ += iovs[i].iov_len;
+    }
+    sent_packets_ += ret;
+    sent += ret;
+  }
+  return count;
+#else
+  for (int i = 0; i < count; i++) {
+    int len = static_cast<int>(offsets[i + 1] - offsets[i]);
+    int ret = static_cast<int>(send(socket_, reinterpret_cast<const char*>(base + offsets[i]), len, 0));
+    syscalls_++;
+    if (ret < 0) {
+      send_errors_++;
+      dropped_packets_++;
+      continue;
+    }
+    sent_packets_++;
+    sent_bytes_ += len;
+  }
+  return count;
+#endif
+}
+
+void UdpSender::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+
+    if (queue_.empty()) {
+      // stopping_ and nothing left to send
+      break;
+    }
+
+    Chunk& chunk = queue_.front();
+    int remaining = static_cast<int>(chunk.offsets.size() - 1 - chunk.next);
+    int count = std::min(remaining, options_.max_batch_datagrams);
+
+    // Pacing: only take as many datagrams as the bucket allows.
+    // On shutdown the queue is drained without pacing.
+    if (bytes_per_sec_ > 0 && !stopping_) {
+      Refill(std::chrono::steady_clock::now());
+
+      int allowed = 0;
+      double budget = tokens_;
+      for (int i = 0; i < count; i++) {
+        double size = chunk.offsets[chunk.next + i + 1] - chunk.offsets[chunk.next + i];
+        // A datagram larger than the bucket is sent once the bucket is full
+        if (size > budget && !(allowed == 0 && budget >= bucket_size_)) {
+          break;
+        }
+        budget -= size;
+        allowed++;
+      }
+
+      if (allowed == 0) {
+        double needed = std::min<double>(chunk.offsets[chunk.next + 1] - chunk.offsets[chunk.next], bucket_size_) - tokens_;
+        auto wait = std::chrono::duration<double>(needed / bytes_per_sec_);
+        paced_waits_++;
+        cv_.wait_for(lock, std::chrono::duration_cast<std::chrono::microseconds>(wait) + std::chrono::microseconds(1));
+        continue;
+      }
+
+      tokens_ = budget;
+      count = allowed;
+    }
+
+    // Chunk data is only released by this thread, safe to use unlocked
+    uint8_t* base = chunk.data;
+    const uint32_t* offsets = chunk.offsets.data() + chunk.next;
+    lock.unlock();
+    count = SendDatagrams(base, offsets, count);
+    lock.lock();
+
+    Chunk& front = queue_.front();
+    front.next += count;
+    queued_packets_ -= count;
+    if (front.next + 1 >= front.offsets.size()) {
+      av_free(front.data);
+      queue_.pop_front();
+    }
+  }
+}
+
+Napi::Object UdpSender::GetStats(Napi::Env env) {
+  size_t queued;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued = queued_packets_;
+  }
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("sentPackets", Napi::Number::New(env, static_cast<double>(sent_packets_.load())));
+  stats.Set("sentBytes", Napi::Number::New(env, static_cast<double>(sent_bytes_.load())));
+  stats.Set("droppedPackets", Napi::Number::New(env, static_cast<double>(dropped_packets_.load())));
+  stats.Set("sendErrors", Napi::Number::New(env, static_cast<double>(send_errors_.load())));
+  stats.Set("syscalls", Napi::Number::New(env, static_cast<double>(syscalls_.load())));
+  stats.Set("pacedWaits", Napi::Number::New(env, static_cast<double>(paced_waits_.load())));
+  stats.Set("queuedPackets", Napi::Number::New(env, static_cast<double>(queued)));
+  return stats;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,96 @@
+#ifndef FFMPEG_UDP_SENDER_H
+#define FFMPEG_UDP_SENDER_H
+
+#include <napi.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET udp_socket_t;
+#else
+typedef int udp_socket_t;
+#endif
+
+namespace ffmpeg {
+
+struct UdpSenderOptions {
+  std::string address;
+  int port = 0;
+  double pacing_bitrate = 0;      // bits per second, 0 = unpaced
+  size_t burst_bytes = 0;         // token bucket depth, 0 = derived from bitrate
+  size_t max_queue_packets = 1024;
+  int max_batch_datagrams = 32;   // datagrams per sendmmsg() call
+  int send_buffer_size = 0;       // SO_SNDBUF, 0 = system default
+};
+
+// Sends datagram batches produced by the RTP sink over a connected UDP socket.
+//
+// Batches are queued and sent from a dedicated thread so the muxer never
+// blocks on the network or on pacing. On Linux datagrams are sent with
+// sendmmsg(), elsewhere with one send() per datagram. An optional token
+// bucket smooths keyframe bursts to the configured bitrate.
+class UdpSender {
+public:
+  static std::unique_ptr<UdpSender> Create(const UdpSenderOptions& options, std::string& error);
+  ~UdpSender();
+
+  // Takes ownership of data (av_malloc'ed). Datagram i spans offsets[i]..offsets[i+1].
+  void Enqueue(uint8_t* data, std::vector<uint32_t>&& offsets);
+
+  // Stop the thread, sending what is still queued without pacing
+  void Stop();
+
+  Napi::Object GetStats(Napi::Env env);
+
+  static bool ParseOptions(const Napi::Object& obj, UdpSenderOptions& options);
+
+private:
+  struct Chunk {
+    uint8_t* data = nullptr;
+    std::vector<uint32_t> offsets;
+    size_t next = 0;  // Next datagram to send
+  };
+
+  explicit UdpSender(const UdpSenderOptions& options);
+
+  void Run();
+  int SendDatagrams(uint8_t* base, const uint32_t* offsets, int count);
+  void Refill(std::chrono::steady_clock::time_point now);
+
+  UdpSenderOptions options_;
+  udp_socket_t socket_;
+
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Chunk> queue_;
+  size_t queued_packets_ = 0;
+  bool stopping_ = false;
+
+  // Token bucket (bytes)
+  double tokens_ = 0;
+  double bytes_per_sec_ = 0;
+  double bucket_size_ = 0;
+  std::chrono::steady_clock::time_point last_refill_;
+
+  // Statistics
+  std::atomic<uint64_t> sent_packets_{0};
+  std::atomic<uint64_t> sent_bytes_{0};
+  std::atomic<uint64_t> dropped_packets_{0};
+  std::atomic<uint64_t> send_errors_{0};
+  std::atomic<uint64_t> syscalls_{0};
+  std::atomic<uint64_t> paced_waits_{0};
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_UDP_SENDER_H
@@ -5,6 +5,7 @@
 #include "packet.h"
 #include "stream.h"
 #include "codec_parser.h"
+#include "timestamp_rescaler.h"
 #include <cstring>
 #include <vector>
 extern "C" {
@@ -72,6 +73,7 @@ Napi::Object Utilities::Init(Napi::Env env, Napi::Object exports) {
   exports.Set("avAddQ", Napi::Function::New(env, AddQ));
   exports.Set("avGcd", Napi::Function::New(env, Gcd));
   exports.Set("avRescaleQRnd", Napi::Function::New(env, RescaleQRnd));
+  exports.Set("avRescaleQBatch", Napi::Function::New(env, RescaleQBatch));
 
   // Audio sample utilities
   exports.Set("avSamplesAlloc", Napi::Function::New(env, SamplesAlloc));
@@ -1690,6 +1692,45 @@ Napi::Value Utilities::RescaleQRnd(const Napi::CallbackInfo& info) {
   return Napi::BigInt::New(env, result);
 }
 
+Napi::Value Utilities::RescaleQBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3 || !info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_bigint64_array) {
+    Napi::TypeError::New(env, "Expected arguments (values: BigInt64Array, bq, cq, rnd?, out?)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[1].IsObject() || !info[2].IsObject()) {
+    Napi::TypeError::New(env, "bq and cq must be objects with num and den").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  AVRational bq = JSToRational(info[1].As<Napi::Object>());
+  AVRational cq = JSToRational(info[2].As<Napi::Object>());
+  AVRounding rnd = AV_ROUND_NEAR_INF;
+  if (info.Length() > 3 && info[3].IsNumber()) {
+    rnd = static_cast<AVRounding>(info[3].As<Napi::Number>().Int32Value());
+  }
+
+  Napi::TypedArrayOf<int64_t> values = info[0].As<Napi::TypedArrayOf<int64_t>>();
+  Napi::TypedArrayOf<int64_t> out = values;
+  if (info.Length() > 4 && !info[4].IsNull() && !info[4].IsUndefined()) {
+    if (!info[4].IsTypedArray() || info[4].As<Napi::TypedArray>().TypedArrayType() != napi_bigint64_array ||
+        info[4].As<Napi::TypedArray>().ElementLength() < values.ElementLength()) {
+      Napi::TypeError::New(env, "out must be a BigInt64Array at least as long as values").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    out = info[4].As<Napi::TypedArrayOf<int64_t>>();
+  }
+
+  // One argument parse for the whole array, same math as av_rescale_q_rnd()
+  TimestampRescaler::RescaleValues(values.Data(), out.Data(), values.ElementLength(),
+                                   bq.num * static_cast<int64_t>(cq.den),
+                                   cq.num * static_cast<int64_t>(bq.den), rnd);
+  return out;
+}
+
 Napi::Value Utilities::DtsPredict(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
@@ -72,6 +72,7 @@ public:
   static Napi::Value AddQ(const Napi::CallbackInfo& info);
   static Napi::Value Gcd(const Napi::CallbackInfo& info);
   static Napi::Value RescaleQRnd(const Napi::CallbackInfo& info);
+  static Napi::Value RescaleQBatch(const Napi::CallbackInfo& info);
   
   // Audio sample utilities
   static Napi::Value SamplesAlloc(const Napi::CallbackInfo& info);
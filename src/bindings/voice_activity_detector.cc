@@ -0,0 +1,327 @@
+#include "voice_activity_detector.h"
+#include "frame.h"
+#include "sample_convert.h"
+#include <algorithm>
+#include <cmath>
+
+extern "C" {
+#include <libavutil/dict.h>
+#include <libavutil/error.h>
+#include <libavutil/samplefmt.h>
+}
+
+namespace ffmpeg {
+
+// Analysis window length
+static constexpr double WINDOW_MS = 20.0;
+
+// How far below the threshold unvoiced speech may be
+static constexpr double UNVOICED_RANGE_DB = 10.0;
+
+// Noise floor rise per window towards louder windows (2 s time constant);
+// quieter windows lower it at once
+static constexpr double NOISE_FLOOR_RISE = 0.01;
+
+// Lowest noise floor
+static constexpr double NOISE_FLOOR_MIN = -100.0;
+
+// Metadata key set on frames with flagFrames
+static constexpr const char* SPEECH_METADATA_KEY = "vad.speech";
+
+Napi::FunctionReference VoiceActivityDetector::constructor;
+
+Napi::Object VoiceActivityDetector::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "VoiceActivityDetector", {
+    StaticMethod<&VoiceActivityDetector::Create>("create"),
+
+    InstanceMethod<&VoiceActivityDetector::Process>("process"),
+    InstanceMethod<&VoiceActivityDetector::TakeSegments>("takeSegments"),
+    InstanceMethod<&VoiceActivityDetector::Flush>("flush"),
+    InstanceMethod<&VoiceActivityDetector::Reset>("reset"),
+    InstanceMethod<&VoiceActivityDetector::GetStats>("getStats"),
+
+    InstanceAccessor<&VoiceActivityDetector::GetSpeaking>("speaking"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("VoiceActivityDetector", func);
+  return exports;
+}
+
+VoiceActivityDetector::VoiceActivityDetector(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<VoiceActivityDetector>(info) {
+  // Created via VoiceActivityDetector.create()
+}
+
+Napi::Value VoiceActivityDetector::Create(const Napi::CallbackInfo& info) {
+  Napi::Object obj = constructor.New({});
+  VoiceActivityDetector* vad = Napi::ObjectWrap<VoiceActivityDetector>::Unwrap(obj);
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+    Napi::Value v = options.Get("threshold");
+    if (v.IsNumber()) {
+      vad->threshold_ = v.As<Napi::Number>().DoubleValue();
+    }
+    v = options.Get("noiseMargin");
+    if (v.IsNumber()) {
+      vad->noise_margin_ = v.As<Napi::Number>().DoubleValue();
+    }
+    v = options.Get("adaptive");
+    if (v.IsBoolean()) {
+      vad->adaptive_ = v.As<Napi::Boolean>().Value();
+    }
+    v = options.Get("zeroCrossingRate");
+    if (v.IsNumber()) {
+      vad->zero_crossing_rate_ = std::max(0.0, v.As<Napi::Number>().DoubleValue());
+    }
+    v = options.Get("hangover");
+    if (v.IsNumber()) {
+      vad->hangover_ = std::max(0.0, v.As<Napi::Number>().DoubleValue());
+    }
+    v = options.Get("minSpeech");
+    if (v.IsNumber()) {
+      vad->min_speech_ = std::max(0.0, v.As<Napi::Number>().DoubleValue());
+    }
+    v = options.Get("flagFrames");
+    if (v.IsBoolean()) {
+      vad->flag_frames_ = v.As<Napi::Boolean>().Value();
+    }
+  }
+
+  return obj;
+}
+
+void VoiceActivityDetector::FinishWindow() {
+  const double duration = window_fill_ * 1000.0 / sample_rate_;
+  const double end = window_start_ + duration;
+  const double mean_square = window_energy_ / window_fill_;
+  const double level = mean_square > 1e-20 ? 10.0 * std::log10(mean_square) : -200.0;
+  const double crossing_rate = window_crossings_ * static_cast<double>(sample_rate_) / window_fill_;
+
+  // The first window sets the noise floor, so a stream starting with
+  // background noise does not start with a segment
+  if (!has_noise_floor_) {
+    noise_floor_ = std::max(level, NOISE_FLOOR_MIN);
+    has_noise_floor_ = true;
+  }
+
+  const double threshold = adaptive_ ? std::max(threshold_, noise_floor_ + noise_margin_) : threshold_;
+  const bool voiced = level >= threshold;
+  const bool unvoiced = !voiced && level >= threshold - UNVOICED_RANGE_DB && crossing_rate >= zero_crossing_rate_;
+
+  if (level < noise_floor_) {
+    noise_floor_ = std::max(level, NOISE_FLOOR_MIN);
+  } else {
+    noise_floor_ += (level - noise_floor_) * NOISE_FLOOR_RISE;
+  }
+
+  total_duration_ += duration;
+
+  if (speaking_) {
+    if (voiced) {
+      segment_end_ = end;
+      silence_duration_ = 0;
+    } else {
+      // Unvoiced speech extends the segment only within the hangover
+      if (unvoiced && silence_duration_ < hangover_) {
+        segment_end_ = end;
+      }
+      silence_duration_ += duration;
+      if (silence_duration_ >= hangover_) {
+        CloseSegment();
+      }
+    }
+  } else if (voiced) {
+    if (onset_start_ < 0) {
+      onset_start_ = unvoiced_start_ >= 0 ? unvoiced_start_ : window_start_;
+      onset_duration_ = 0;
+    }
+    onset_duration_ += duration;
+    if (onset_duration_ >= min_speech_) {
+      speaking_ = true;
+      segment_start_ = onset_start_;
+      segment_end_ = end;
+      silence_duration_ = 0;
+      onset_start_ = -1;
+      unvoiced_start_ = -1;
+    }
+  } else {
+    onset_start_ = -1;
+    if (unvoiced) {
+      if (unvoiced_start_ < 0) {
+        unvoiced_start_ = window_start_;
+      }
+    } else {
+      unvoiced_start_ = -1;
+    }
+  }
+
+  window_start_ = end;
+  window_fill_ = 0;
+  window_energy_ = 0;
+  window_crossings_ = 0;
+}
+
+void VoiceActivityDetector::CloseSegment() {
+  segments_.push_back({segment_start_, segment_end_});
+  speech_duration_ += segment_end_ - segment_start_;
+  segment_count_++;
+  speaking_ = false;
+  silence_duration_ = 0;
+}
+
+Napi::Value VoiceActivityDetector::Process(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  AVFrame* f = frame ? frame->Get() : nullptr;
+  if (!f) {
+    Napi::TypeError::New(env, "Expected a Frame").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  const AVSampleFormat format = static_cast<AVSampleFormat>(f->format);
+  const AVSampleFormat packed = av_get_packed_sample_fmt(format);
+  const int channels = f->ch_layout.nb_channels;
+  if (f->nb_samples <= 0 || f->sample_rate <= 0 || channels <= 0 ||
+      !f->extended_data || !f->extended_data[0] || !IsConvertibleSampleFormat(packed)) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  // A new sample rate starts a new window
+  if (f->sample_rate != sample_rate_) {
+    sample_rate_ = f->sample_rate;
+    window_size_ = std::max(static_cast<int>(sample_rate_ * WINDOW_MS / 1000.0), 1);
+    window_fill_ = 0;
+    window_energy_ = 0;
+    window_crossings_ = 0;
+  }
+
+  // Frame time from the timestamp, or continuing the previous frame
+  double frame_start = next_time_;
+  if (f->pts != AV_NOPTS_VALUE && f->time_base.num > 0 && f->time_base.den > 0) {
+    frame_start = static_cast<double>(f->pts) * f->time_base.num * 1000.0 / f->time_base.den;
+  }
+  next_time_ = frame_start + f->nb_samples * 1000.0 / sample_rate_;
+
+  // Mix down to mono
+  const size_t n = static_cast<size_t>(f->nb_samples);
+  const bool planar = av_sample_fmt_is_planar(format);
+  scratch_.resize(n);
+  mono_.assign(n, 0.0);
+  for (int c = 0; c < channels; c++) {
+    const uint8_t* data = planar ? f->extended_data[c] : f->extended_data[0];
+    SamplesToDouble(scratch_.data(), data, packed, planar ? 0 : c, planar ? 1 : channels, n);
+    for (size_t i = 0; i < n; i++) {
+      mono_[i] += scratch_[i];
+    }
+  }
+  const double scale = 1.0 / channels;
+  for (size_t i = 0; i < n; i++) {
+    mono_[i] *= scale;
+  }
+
+  bool speech = speaking_;
+  size_t offset = 0;
+  while (offset < n) {
+    if (window_fill_ == 0) {
+      window_start_ = frame_start + offset * 1000.0 / sample_rate_;
+    }
+    size_t count = std::min(n - offset, static_cast<size_t>(window_size_ - window_fill_));
+    const double* x = mono_.data() + offset;
+
+    double energy = 0;
+    int crossings = 0;
+    double previous = last_sample_;
+    for (size_t i = 0; i < count; i++) {
+      energy += x[i] * x[i];
+      crossings += (x[i] >= 0) != (previous >= 0);
+      previous = x[i];
+    }
+    last_sample_ = previous;
+    window_energy_ += energy;
+    window_crossings_ += crossings;
+    window_fill_ += static_cast<int>(count);
+    offset += count;
+
+    if (window_fill_ == window_size_) {
+      FinishWindow();
+      speech = speech || speaking_;
+    }
+  }
+
+  if (flag_frames_) {
+    av_dict_set(&f->metadata, SPEECH_METADATA_KEY, speech ? "1" : "0", 0);
+  }
+
+  return Napi::Number::New(env, speech ? 1 : 0);
+}
+
+Napi::Value VoiceActivityDetector::TakeSegments(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Array result = Napi::Array::New(env, segments_.size());
+  for (size_t i = 0; i < segments_.size(); i++) {
+    Napi::Object segment = Napi::Object::New(env);
+    segment.Set("start", Napi::Number::New(env, segments_[i].start));
+    segment.Set("end", Napi::Number::New(env, segments_[i].end));
+    result.Set(static_cast<uint32_t>(i), segment);
+  }
+  segments_.clear();
+  return result;
+}
+
+Napi::Value VoiceActivityDetector::Flush(const Napi::CallbackInfo& info) {
+  // End of stream: close the open segment without waiting for the hangover
+  if (speaking_) {
+    CloseSegment();
+  }
+  onset_start_ = -1;
+  unvoiced_start_ = -1;
+  window_fill_ = 0;
+  window_energy_ = 0;
+  window_crossings_ = 0;
+  return info.Env().Undefined();
+}
+
+Napi::Value VoiceActivityDetector::Reset(const Napi::CallbackInfo& info) {
+  sample_rate_ = 0;
+  window_fill_ = 0;
+  window_energy_ = 0;
+  window_crossings_ = 0;
+  last_sample_ = 0;
+  next_time_ = 0;
+  noise_floor_ = NOISE_FLOOR_MIN;
+  has_noise_floor_ = false;
+  speaking_ = false;
+  onset_start_ = -1;
+  unvoiced_start_ = -1;
+  silence_duration_ = 0;
+  segments_.clear();
+  total_duration_ = 0;
+  speech_duration_ = 0;
+  segment_count_ = 0;
+  return info.Env().Undefined();
+}
+
+Napi::Value VoiceActivityDetector::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  double speech = speech_duration_ + (speaking_ ? segment_end_ - segment_start_ : 0);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("duration", Napi::Number::New(env, total_duration_));
+  result.Set("speechDuration", Napi::Number::New(env, speech));
+  result.Set("segments", Napi::Number::New(env, static_cast<double>(segment_count_ + (speaking_ ? 1 : 0))));
+  result.Set("noiseFloor", Napi::Number::New(env, noise_floor_));
+  return result;
+}
+
+Napi::Value VoiceActivityDetector::GetSpeaking(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), speaking_);
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,96 @@
+#ifndef FFMPEG_VOICE_ACTIVITY_DETECTOR_H
+#define FFMPEG_VOICE_ACTIVITY_DETECTOR_H
+
+#include <napi.h>
+#include <cstdint>
+#include <vector>
+#include "common.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+namespace ffmpeg {
+
+// Energy and zero-crossing voice activity detector.
+//
+// Frames of any sample format and layout are mixed down to mono and analyzed
+// in 20 ms windows. A window is voiced when its energy is above the threshold
+// (the fixed threshold or the tracked noise floor plus a margin, whichever is
+// higher). Windows up to 10 dB quieter with a high zero-crossing rate
+// (fricatives such as "s" or "f") are unvoiced speech: they extend segment
+// boundaries but never open or hold a segment on their own.
+//
+// A segment opens after minSpeech ms of consecutive voiced windows and
+// closes after hangover ms without voiced windows. Closed segments are kept
+// with start and end times in milliseconds, from the frame timestamps when
+// set and from the sample count otherwise.
+class VoiceActivityDetector : public Napi::ObjectWrap<VoiceActivityDetector> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  VoiceActivityDetector(const Napi::CallbackInfo& info);
+
+private:
+  struct Segment {
+    double start;
+    double end;
+  };
+
+  static Napi::FunctionReference constructor;
+
+  // Static methods
+  static Napi::Value Create(const Napi::CallbackInfo& info);
+
+  // Instance methods
+  Napi::Value Process(const Napi::CallbackInfo& info);
+  Napi::Value TakeSegments(const Napi::CallbackInfo& info);
+  Napi::Value Flush(const Napi::CallbackInfo& info);
+  Napi::Value Reset(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value GetSpeaking(const Napi::CallbackInfo& info);
+
+  void FinishWindow();
+  void CloseSegment();
+
+  // Options
+  double threshold_ = -50.0;        // dBFS
+  double noise_margin_ = 10.0;      // dB above the noise floor
+  bool adaptive_ = true;
+  double zero_crossing_rate_ = 5000.0;  // Crossings per second for unvoiced speech
+  double hangover_ = 300.0;         // ms
+  double min_speech_ = 100.0;       // ms
+  bool flag_frames_ = false;
+
+  // Analysis window
+  int sample_rate_ = 0;
+  int window_size_ = 0;
+  int window_fill_ = 0;
+  double window_start_ = 0;         // ms
+  double window_energy_ = 0;        // Sum of squares
+  int window_crossings_ = 0;
+  double last_sample_ = 0;
+  double next_time_ = 0;            // ms, expected start of the next frame
+  std::vector<double> scratch_;     // One channel of one frame as double
+  std::vector<double> mono_;
+
+  // Detection state
+  double noise_floor_ = -100.0;     // dBFS
+  bool has_noise_floor_ = false;
+  bool speaking_ = false;
+  double onset_start_ = -1;         // Start of the pending voiced run, -1 if none
+  double onset_duration_ = 0;
+  double unvoiced_start_ = -1;      // Start of the unvoiced run before an onset, -1 if none
+  double segment_start_ = 0;
+  double segment_end_ = 0;          // End of the last speech window
+  double silence_duration_ = 0;     // Since the last voiced window
+  std::vector<Segment> segments_;
+
+  // Statistics
+  double total_duration_ = 0;
+  double speech_duration_ = 0;
+  uint64_t segment_count_ = 0;
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_VOICE_ACTIVITY_DETECTOR_H
@@ -0,0 +1,293 @@
+import { bindings } from './binding.js';
+
+import type { Frame } from './frame.js';
+import type { NativeAudioMixer, NativeWrapper } from './native-types.js';
+import type { AudioMixerInputOptions, AudioMixerOptions, AudioMixerStats } from './types.js';
+
+/**
+ * Clock driven mixer for live audio inputs.
+ *
+ * Mixes any number of inputs (e.g. conference participants or microphones)
+ * into frames of a fixed size without a filter graph. Every input has its own
+ * ring buffer; frames must have the sample rate and channel count of the
+ * mixer (FLT, FLTP, S16 and S16P are accepted, resample other audio first).
+ *
+ * An output frame is mixed as soon as every running input has a full frame
+ * buffered, and at the latest when it is due on the mixer clock, which starts
+ * at the first write. A late input does not stall the mix: with the `'zero'`
+ * policy its missing samples are filled with silence when the frame is due,
+ * with `'wait'` the mixer first waits up to `maxWait` milliseconds for it.
+ * The samples of a late input that arrive afterwards are dropped, so the
+ * input stays aligned with the others. For frames with pts, a gap to the
+ * previous frame of the input counts as already skipped, so samples that
+ * were never sent are not dropped a second time. Inputs that have not
+ * written yet are silent and never hold back the mix.
+ *
+ * Inputs are summed with their gain and soft clipped, and output frames carry
+ * pts in 1/sampleRate, ready for an audio encoder.
+ *
+ * @example
+ * ```typescript
+ * import { AudioMixer, FFmpegError, Frame } from 'node-av';
+ * import { AV_SAMPLE_FMT_FLTP, AVERROR_EOF } from 'node-av/constants';
+ *
+ * using mixer = AudioMixer.create({ sampleRate: 48000, frameSize: 1024, sampleFormat: AV_SAMPLE_FMT_FLTP });
+ * const alice = mixer.addInput();
+ * const bob = mixer.addInput({ gain: 0.8 });
+ *
+ * // From the decoders of each participant
+ * mixer.write(alice, aliceFrame);
+ * mixer.write(bob, bobFrame);
+ *
+ * // Output loop
+ * const frame = new Frame();
+ * frame.alloc();
+ * while (true) {
+ *   const ret = await mixer.receiveAsync(frame);
+ *   if (ret === AVERROR_EOF) break;
+ *   FFmpegError.throwIfError(ret, 'receive');
+ *   await encoder.encode(frame);
+ * }
+ * ```
+ *
+ * @see {@link SoftwareResampleContext} To bring inputs to the mixer format
+ */
+export class AudioMixer implements Disposable, NativeWrapper<NativeAudioMixer> {
+  private native: NativeAudioMixer;
+
+  private constructor(native: NativeAudioMixer) {
+    this.native = native;
+  }
+
+  /**
+   * Create an audio mixer.
+   *
+   * @param options - Output format, frame size and late input policy
+   *
+   * @returns Mixer without inputs
+   *
+   * @throws {TypeError} If the channel layout, sample format or late policy is invalid
+   *
+   * @throws {RangeError} If sampleRate or frameSize is not positive
+   *
+   * @example
+   * ```typescript
+   * const mixer = AudioMixer.create({ latePolicy: 'wait', maxWait: 40 });
+   * ```
+   */
+  static create(options?: AudioMixerOptions): AudioMixer {
+    return new AudioMixer(bindings.AudioMixer.create(options));
+  }
+
+  /**
+   * Add an input.
+   *
+   * Indices of removed inputs are reused.
+   *
+   * @param options - Gain and mute state
+   *
+   * @returns Input index
+   *
+   * @throws {Error} If the mixer is closed
+   *
+   * @example
+   * ```typescript
+   * const input = mixer.addInput({ gain: 0.5 });
+   * ```
+   */
+  addInput(options?: AudioMixerInputOptions): number {
+    return this.native.addInput(options);
+  }
+
+  /**
+   * Remove an input and discard its buffered samples.
+   *
+   * @param input - Input index
+   *
+   * @throws {RangeError} If the input does not exist
+   *
+   * @example
+   * ```typescript
+   * // Participant left
+   * mixer.removeInput(bob);
+   * ```
+   */
+  removeInput(input: number): void {
+    this.native.removeInput(input);
+  }
+
+  /**
+   * Write audio to an input.
+   *
+   * Samples are copied into the ring buffer of the input. Passing null ends
+   * the input: its buffered samples are still mixed, and when all inputs have
+   * ended and drained, receive returns AVERROR_EOF.
+   *
+   * @param input - Input index
+   *
+   * @param frame - Audio frame in the mixer format, or null to end the input
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Sample rate, channel count or sample format does not match
+   *   - AVERROR_EOF: Input has ended or mixer is closed
+   *
+   * @throws {RangeError} If the input does not exist
+   *
+   * @example
+   * ```typescript
+   * const ret = mixer.write(alice, frame);
+   * FFmpegError.throwIfError(ret, 'write');
+   * ```
+   */
+  write(input: number, frame: Frame | null): number {
+    return this.native.write(input, frame?.getNative() ?? null);
+  }
+
+  /**
+   * Set the gain of an input.
+   *
+   * Applies from the next output frame.
+   *
+   * @param input - Input index
+   *
+   * @param gain - Linear gain
+   *
+   * @throws {RangeError} If the input does not exist
+   *
+   * @example
+   * ```typescript
+   * mixer.setGain(bob, 0.5);
+   * ```
+   */
+  setGain(input: number, gain: number): void {
+    this.native.setGain(input, gain);
+  }
+
+  /**
+   * Mute or unmute an input.
+   *
+   * A muted input keeps being consumed, so it is in sync when unmuted.
+   *
+   * @param input - Input index
+   *
+   * @param muted - Whether the input is muted
+   *
+   * @throws {RangeError} If the input does not exist
+   *
+   * @example
+   * ```typescript
+   * mixer.setMuted(alice, true);
+   * ```
+   */
+  setMuted(input: number, muted: boolean): void {
+    this.native.setMuted(input, muted);
+  }
+
+  /**
+   * Receive the next mixed frame without waiting.
+   *
+   * @param frame - Allocated frame receiving the mix
+   *
+   * @returns 0 when a frame was mixed, AVERROR_EAGAIN if the next frame is not due yet,
+   *   or AVERROR_EOF when all inputs have ended
+   *
+   * @throws {Error} If a receiveAsync() call is pending
+   *
+   * @example
+   * ```typescript
+   * const ret = mixer.receive(frame);
+   * if (ret === 0) {
+   *   await encoder.encode(frame);
+   * }
+   * ```
+   *
+   * @see {@link receiveAsync} To wait for the next frame
+   */
+  receive(frame: Frame): number {
+    return this.native.receive(frame.getNative());
+  }
+
+  /**
+   * Receive the next mixed frame.
+   *
+   * Resolves as soon as the frame is ready or due; waits on the libuv
+   * threadpool otherwise. Only one call may be pending.
+   *
+   * @param frame - Allocated frame receiving the mix
+   *
+   * @returns 0 when a frame was mixed, or AVERROR_EOF when all inputs have ended
+   *   or the mixer was closed
+   *
+   * @throws {Error} If another receiveAsync() call is pending
+   *
+   * @example
+   * ```typescript
+   * const ret = await mixer.receiveAsync(frame);
+   * FFmpegError.throwIfError(ret, 'receiveAsync');
+   * ```
+   *
+   * @see {@link receive} For non-blocking receive
+   */
+  async receiveAsync(frame: Frame): Promise<number> {
+    return await this.native.receiveAsync(frame.getNative());
+  }
+
+  /**
+   * Get mixer statistics.
+   *
+   * @returns Output frames and per-input buffer levels, late and dropped samples
+   *
+   * @example
+   * ```typescript
+   * for (const input of mixer.getStats().inputs) {
+   *   console.log(`input ${input.index}: ${input.lateFrames} late frames`);
+   * }
+   * ```
+   */
+  getStats(): AudioMixerStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Close the mixer.
+   *
+   * Discards all inputs; a pending receiveAsync() resolves with AVERROR_EOF.
+   *
+   * @example
+   * ```typescript
+   * mixer.close();
+   * ```
+   */
+  close(): void {
+    this.native.close();
+  }
+
+  /**
+   * Get the underlying native AudioMixer object.
+   *
+   * @returns The native AudioMixer binding object
+   *
+   * @internal
+   */
+  getNative(): NativeAudioMixer {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the mixer.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling close().
+   *
+   * @example
+   * ```typescript
+   * {
+   *   using mixer = AudioMixer.create();
+   *   // Use mixer...
+   * } // Automatically closed
+   * ```
+   */
+  [Symbol.dispose](): void {
+    this.close();
+  }
+}
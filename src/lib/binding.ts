@@ -26,6 +26,7 @@ import type {
 import type { PosixError } from './error.js';
 import type {
   NativeAudioFifo,
+  NativeAudioMixer,
   NativeBitStreamFilter,
   NativeBitStreamFilterContext,
   NativeCodec,
@@ -44,18 +45,47 @@ import type {
   NativeFrameUtils,
   NativeHardwareDeviceContext,
   NativeHardwareFramesContext,
+  NativeImageEncoder,
   NativeInputFormat,
+  NativeInputSynchronizer,
   NativeIOContext,
   NativeLog,
+  NativeLoudnessMeter,
   NativeOption,
   NativeOutputFormat,
   NativePacket,
+  NativePacketPacer,
+  NativePipelineStage,
+  NativeRTSPTalkback,
   NativeSoftwareResampleContext,
   NativeSoftwareScaleContext,
   NativeStream,
   NativeSyncQueue,
+  NativeTimestampRescaler,
+  NativeVoiceActivityDetector,
 } from './native-types.js';
-import type { ChannelLayout, DtsPredictState, IDimension, IRational } from './types.js';
+import type {
+  AudioMixerOptions,
+  ChannelLayout,
+  DtsPredictState,
+  HardwareDeviceCapability,
+  IDimension,
+  ImageEncoderOptions,
+  InlineDispatchOptions,
+  InlineDispatchStats,
+  InputSynchronizerOptions,
+  IRational,
+  LeakSite,
+  LoudnessMeterOptions,
+  MemoryAccountingSnapshot,
+  Mp4DefragmentResult,
+  PacketPacerOptions,
+  PipelineStageKind,
+  PipelineStageOptions,
+  RegistrySnapshot,
+  RTSPTalkbackOptions,
+  VoiceActivityDetectorOptions,
+} from './types.js';
 
 const __filename = fileURLToPath(import.meta.url);
 const __dirname = dirname(__filename);
@@ -143,6 +173,8 @@ interface NativeHardwareDeviceContextConstructor {
   getTypeName(type: AVHWDeviceType): string | null;
   iterateTypes(): AVHWDeviceType[];
   findTypeByName(name: string): AVHWDeviceType;
+  probeCapabilities(device: string | null, options: NativeDictionary | null, open: boolean): Promise<HardwareDeviceCapability[]>;
+  probeCapabilitiesSync(device: string | null, options: NativeDictionary | null, open: boolean): HardwareDeviceCapability[];
 }
 
 type NativeHardwareFramesContextConstructor = new () => NativeHardwareFramesContext;
@@ -201,6 +233,56 @@ interface NativeSyncQueueConstructor {
   create(type: number, bufferSizeUs: number): NativeSyncQueue;
 }
 
+// RTSP Talkback - native Opus RTP to backchannel transcoder
+interface NativeRTSPTalkbackConstructor {
+  create(formatContext: NativeFormatContext, streamIndex: number, options?: RTSPTalkbackOptions): NativeRTSPTalkback;
+}
+
+// Pipeline Stage - BSF/codec/filter stage on its own thread, linked by SPSC queues
+interface NativePipelineStageConstructor {
+  create(
+    kind: PipelineStageKind,
+    context: NativeBitStreamFilterContext | NativeCodecContext | NativeFilterContext,
+    sinkContext: NativeFilterContext | null,
+    options?: PipelineStageOptions,
+  ): NativePipelineStage;
+}
+
+// Packet Pacer - real-time release of packets on a native timer thread
+interface NativePacketPacerConstructor {
+  create(options?: PacketPacerOptions): NativePacketPacer;
+}
+
+// Input Synchronizer - multi-input capture on a shared wall clock timeline
+interface NativeInputSynchronizerConstructor {
+  create(inputs: NativeFormatContext[], options?: InputSynchronizerOptions): NativeInputSynchronizer;
+}
+
+// Timestamp Rescaler - av_rescale_q_rnd() bound to a time base pair
+interface NativeTimestampRescalerConstructor {
+  create(src: IRational, dst: IRational, rnd?: number): NativeTimestampRescaler;
+}
+
+// Image Encoder - still image encoding with pooled encoder contexts
+interface NativeImageEncoderConstructor {
+  create(options?: ImageEncoderOptions): NativeImageEncoder;
+}
+
+// Audio Mixer - clock driven mixing of live audio inputs
+interface NativeAudioMixerConstructor {
+  create(options?: AudioMixerOptions): NativeAudioMixer;
+}
+
+// Loudness Meter - EBU R128 loudness, true peak and channel levels
+interface NativeLoudnessMeterConstructor {
+  create(options?: LoudnessMeterOptions): NativeLoudnessMeter;
+}
+
+// Voice Activity Detector - speech segments from energy and zero crossings
+interface NativeVoiceActivityDetectorConstructor {
+  create(options?: VoiceActivityDetectorOptions): NativeVoiceActivityDetector;
+}
+
 /**
  * The complete native binding interface
  */
@@ -256,6 +338,33 @@ export interface NativeBinding {
   // Sync Queue
   SyncQueue: NativeSyncQueueConstructor;
 
+  // RTSP Talkback
+  RTSPTalkback: NativeRTSPTalkbackConstructor;
+
+  // Native pipeline stages
+  PipelineStage: NativePipelineStageConstructor;
+
+  // Real-time packet pacing
+  PacketPacer: NativePacketPacerConstructor;
+
+  // Multi-input synchronization
+  InputSynchronizer: NativeInputSynchronizerConstructor;
+
+  // Timestamp rescaling for a fixed time base pair
+  TimestampRescaler: NativeTimestampRescalerConstructor;
+
+  // Still image encoding with pooled encoder contexts
+  ImageEncoder: NativeImageEncoderConstructor;
+
+  // Clock driven mixing of live audio inputs
+  AudioMixer: NativeAudioMixerConstructor;
+
+  // Loudness and level metering
+  LoudnessMeter: NativeLoudnessMeterConstructor;
+
+  // Voice activity detection
+  VoiceActivityDetector: NativeVoiceActivityDetectorConstructor;
+
   // Functions
   getFFmpegInfo: () => {
     version: string;
@@ -322,6 +431,7 @@ export interface NativeBinding {
   avAddQ: (a: IRational, b: IRational) => IRational;
   avGcd: (a: bigint | number, b: bigint | number) => bigint;
   avRescaleQRnd: (a: bigint | number | null, bq: IRational, cq: IRational, rnd: number) => bigint;
+  avRescaleQBatch: (values: BigInt64Array, bq: IRational, cq: IRational, rnd?: number, out?: BigInt64Array | null) => BigInt64Array;
   avGetAudioFrameDuration2: (codecpar: NativeCodecParameters, frameBytes: number) => number;
   avUsleep: (usec: number) => void;
   avSamplesAlloc: (nbChannels: number, nbSamples: number, sampleFmt: AVSampleFormat, align: number) => { data: Buffer[]; linesize: number; size: number } | number;
@@ -329,6 +439,21 @@ export interface NativeBinding {
   avChannelLayoutDescribe: (channelLayout: Partial<ChannelLayout>) => string | null;
   avSdpCreate: (contexts: NativeFormatContext[]) => string | null;
   dtsPredict: (packet: NativePacket, stream: NativeStream, state: DtsPredictState) => DtsPredictState;
+  mp4Defragment: (input: string, output: string, onProgress?: (progress: number) => void) => Promise<Mp4DefragmentResult>;
+  mp4DefragmentSync: (input: string, output: string) => Mp4DefragmentResult;
+  registryFind: (table: number, key: string | number) => number;
+  registryEntry: (table: number, index: number) => NativeCodec | NativeFilter | NativeInputFormat | NativeOutputFormat | null;
+  registrySnapshot: () => RegistrySnapshot;
+  setMemoryAccounting: (enabled: boolean) => void;
+  getMemoryAccounting: () => MemoryAccountingSnapshot;
+  resetMemoryAccountingPeak: () => void;
+  setLeakDetection: (enabled: boolean) => void;
+  getLeakDetectionSites: () => (Omit<LeakSite, 'kind' | 'stack'> & { site: number })[];
+  resetLeakDetection: () => void;
+  setNativeTracing: (enabled: boolean, bufferEvents?: number) => void;
+  exportNativeTrace: () => string;
+  setInlineDispatch: (options: InlineDispatchOptions) => void;
+  getInlineDispatchStats: () => InlineDispatchStats;
 }
 
 /**
@@ -362,6 +362,34 @@ export class FormatContext extends OptionMember<NativeFormatContext> implements
     return this.native.probeScore;
   }
 
+  /**
+   * Read stall timeout in milliseconds.
+   *
+   * A readFrame() that blocks longer than this without returning a packet is
+   * interrupted through the interrupt callback and returns AVERROR_EXIT with
+   * {@link readStalled} set. Detects dead network inputs (RTSP, TCP) that
+   * neither deliver data nor close the connection. 0 disables (default).
+   *
+   * Also bounds openInput() and findStreamInfo() (each call as a whole, when
+   * set before them) and readPlay()/readPause()/suspendInput().
+   */
+  get readTimeout(): number {
+    return this.native.readTimeout;
+  }
+
+  set readTimeout(value: number) {
+    this.native.readTimeout = value;
+  }
+
+  /**
+   * Whether the last read was interrupted by the read timeout.
+   *
+   * Reset at the start of every read.
+   */
+  get readStalled(): boolean {
+    return this.native.readStalled;
+  }
+
   /**
    * Allocate a format context.
    *
@@ -1159,6 +1187,134 @@ export class FormatContext extends OptionMember<NativeFormatContext> implements
     this.native.flushSync();
   }
 
+  /**
+   * Start or resume playing a network stream.
+   *
+   * Sends RTSP PLAY after {@link readPause}.
+   *
+   * Direct mapping to av_read_play().
+   *
+   * @returns 0 on success, AVERROR(ENOSYS) if the format has no play/pause, negative AVERROR on error
+   *
+   * @example
+   * ```typescript
+   * const ret = await ctx.readPlay();
+   * FFmpegError.throwIfError(ret, 'Failed to resume');
+   * ```
+   *
+   * @see {@link readPlaySync} For synchronous version
+   */
+  async readPlay(): Promise<number> {
+    return await this.native.readPlay();
+  }
+
+  /**
+   * Start or resume playing a network stream synchronously.
+   * Synchronous version of readPlay.
+   *
+   * Direct mapping to av_read_play().
+   *
+   * @returns 0 on success, AVERROR(ENOSYS) if the format has no play/pause, negative AVERROR on error
+   *
+   * @example
+   * ```typescript
+   * ctx.readPlaySync();
+   * ```
+   *
+   * @see {@link readPlay} For async version
+   */
+  readPlaySync(): number {
+    return this.native.readPlaySync();
+  }
+
+  /**
+   * Pause a network stream.
+   *
+   * Sends RTSP PAUSE, so the server stops sending while the session stays set up.
+   *
+   * Direct mapping to av_read_pause().
+   *
+   * @returns 0 on success, AVERROR(ENOSYS) if the format has no play/pause, negative AVERROR on error
+   *
+   * @example
+   * ```typescript
+   * await ctx.readPause();
+   * // Later
+   * await ctx.readPlay();
+   * ```
+   *
+   * @see {@link readPauseSync} For synchronous version
+   */
+  async readPause(): Promise<number> {
+    return await this.native.readPause();
+  }
+
+  /**
+   * Pause a network stream synchronously.
+   * Synchronous version of readPause.
+   *
+   * Direct mapping to av_read_pause().
+   *
+   * @returns 0 on success, AVERROR(ENOSYS) if the format has no play/pause, negative AVERROR on error
+   *
+   * @example
+   * ```typescript
+   * ctx.readPauseSync();
+   * ```
+   *
+   * @see {@link readPause} For async version
+   */
+  readPauseSync(): number {
+    return this.native.readPauseSync();
+  }
+
+  /**
+   * Stop network input while keeping the streams.
+   *
+   * Pauses the stream (RTSP PAUSE) and closes the input's own I/O, so no more
+   * data is received. Streams and their parameters stay valid until
+   * {@link closeInput}. Reading afterwards fails. Custom I/O is left open.
+   *
+   * RTSP has no I/O of its own (`pb` is null): its control and RTP sockets
+   * belong to the demuxer and stay open until {@link closeInput}; PAUSE only
+   * stops the server sending. The PAUSE request is bounded by {@link readTimeout}.
+   *
+   * @param pause - Send PAUSE first (skip it for a connection known to be dead)
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @example
+   * ```typescript
+   * // Keep the Stream objects of a lost connection, but stop its traffic
+   * await ctx.suspendInput();
+   * ```
+   *
+   * @see {@link suspendInputSync} For synchronous version
+   * @see {@link readPause} To pause and resume later
+   */
+  async suspendInput(pause = true): Promise<number> {
+    return await this.native.suspendInput(pause);
+  }
+
+  /**
+   * Stop network input while keeping the streams synchronously.
+   * Synchronous version of suspendInput.
+   *
+   * @param pause - Send PAUSE first (skip it for a connection known to be dead)
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @example
+   * ```typescript
+   * ctx.suspendInputSync();
+   * ```
+   *
+   * @see {@link suspendInput} For async version
+   */
+  suspendInputSync(pause = true): number {
+    return this.native.suspendInputSync(pause);
+  }
+
   /**
    * Print format information.
    *
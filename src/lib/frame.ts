@@ -2,6 +2,7 @@ import { AV_NOPTS_VALUE, AV_TIME_BASE_Q, AVMEDIA_TYPE_AUDIO, AVMEDIA_TYPE_UNKNOW
 import { bindings } from './binding.js';
 import { FFmpegError } from './error.js';
 import { HardwareFramesContext } from './hardware-frames-context.js';
+import { captureAllocationSite, leakDetection } from './leak-detector.js';
 import { Rational } from './rational.js';
 
 import type {
@@ -798,6 +799,9 @@ export class Frame implements Disposable, NativeWrapper<NativeFrame> {
    */
   alloc(): void {
     this.native.alloc();
+    if (leakDetection.enabled) {
+      this.native.setAllocationSite(captureAllocationSite('Frame', Frame.prototype.alloc));
+    }
   }
 
   /**
@@ -900,6 +904,10 @@ export class Frame implements Disposable, NativeWrapper<NativeFrame> {
       return null;
     }
 
+    if (leakDetection.enabled) {
+      cloned.setAllocationSite(captureAllocationSite('Frame', Frame.prototype.clone));
+    }
+
     // Wrap the native cloned frame
     const frame = Object.create(Frame.prototype) as Frame;
     (frame as unknown as { native: NativeFrame }).native = cloned;
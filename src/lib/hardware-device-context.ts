@@ -4,6 +4,7 @@ import type { AVHWDeviceType } from '../constants/constants.js';
 import type { FFHWDeviceType } from '../constants/hardware.js';
 import type { Dictionary } from './dictionary.js';
 import type { NativeHardwareDeviceContext, NativeWrapper } from './native-types.js';
+import type { HardwareDeviceCapability } from './types.js';
 
 /**
  * Hardware device context for GPU-accelerated processing.
@@ -130,6 +131,60 @@ export class HardwareDeviceContext implements Disposable, NativeWrapper<NativeHa
     return bindings.HardwareDeviceContext.findTypeByName(name);
   }
 
+  /**
+   * Probe the capabilities of all hardware device types in this build.
+   *
+   * For every device type, lists the hardware decoders and encoders with
+   * their pixel formats and, if `open` is true, tries to create the device
+   * and reads its frame constraints. Runs in the thread pool; devices are
+   * freed again before returning. Device types that cannot be created are
+   * reported with `available: false` and the FFmpeg error code.
+   *
+   * @param device - Device specifier for every type (VAAPI defaults to /dev/dri/renderD128)
+   *
+   * @param options - Device creation options
+   *
+   * @param open - Create the devices (default: true). Without it only the codec tables are read.
+   *
+   * @returns Capabilities per device type
+   *
+   * @example
+   * ```typescript
+   * const devices = await HardwareDeviceContext.probeCapabilities();
+   * for (const device of devices.filter((d) => d.available)) {
+   *   console.log(device.type, device.encoders.map((c) => c.name));
+   * }
+   * ```
+   *
+   * @see {@link probeCapabilitiesSync} For synchronous version
+   */
+  static async probeCapabilities(device?: string | null, options?: Dictionary | null, open = true): Promise<HardwareDeviceCapability[]> {
+    return await bindings.HardwareDeviceContext.probeCapabilities(device ?? null, options?.getNative() ?? null, open);
+  }
+
+  /**
+   * Probe the capabilities of all hardware device types in this build.
+   * Synchronous version of probeCapabilities.
+   *
+   * @param device - Device specifier for every type (VAAPI defaults to /dev/dri/renderD128)
+   *
+   * @param options - Device creation options
+   *
+   * @param open - Create the devices (default: true)
+   *
+   * @returns Capabilities per device type
+   *
+   * @example
+   * ```typescript
+   * const devices = HardwareDeviceContext.probeCapabilitiesSync(null, null, false);
+   * ```
+   *
+   * @see {@link probeCapabilities} For async version
+   */
+  static probeCapabilitiesSync(device?: string | null, options?: Dictionary | null, open = true): HardwareDeviceCapability[] {
+    return bindings.HardwareDeviceContext.probeCapabilitiesSync(device ?? null, options?.getNative() ?? null, open);
+  }
+
   /**
    * Hardware device type.
    *
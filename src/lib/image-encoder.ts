@@ -0,0 +1,211 @@
+import { AV_CODEC_ID_MJPEG, AV_CODEC_ID_PNG, AV_CODEC_ID_WEBP } from '../constants/constants.js';
+import { bindings } from './binding.js';
+import { FFmpegError } from './error.js';
+
+import type { Frame } from './frame.js';
+import type { NativeImageEncoder, NativeWrapper } from './native-types.js';
+import type { ImageEncodeOptions, ImageEncoderOptions, ImageEncoderStats } from './types.js';
+
+const IMAGE_CODEC_IDS = {
+  jpeg: AV_CODEC_ID_MJPEG,
+  png: AV_CODEC_ID_PNG,
+  webp: AV_CODEC_ID_WEBP,
+} as const;
+
+/**
+ * Still image encoder with warm encoder contexts.
+ *
+ * Encodes video frames of any pixel format (hardware frames are downloaded)
+ * to JPEG, PNG or WebP. Opening an encoder and a scaler costs far more than
+ * encoding one snapshot, so contexts are kept in a bounded LRU pool keyed by
+ * format, output size and quality, each with its own cached scaler. Encodes
+ * run on the libuv threadpool; concurrent encodes never share a context.
+ *
+ * WebP requires FFmpeg built with libwebp.
+ *
+ * @example
+ * ```typescript
+ * import { ImageEncoder } from 'node-av';
+ *
+ * using snapshots = ImageEncoder.create({ maxContexts: 32 });
+ *
+ * // Per camera request
+ * const jpeg = await snapshots.encode(frame, { quality: 80, width: 640 });
+ * response.end(jpeg);
+ * ```
+ *
+ * @see {@link Encoder} For encoding streams
+ */
+export class ImageEncoder implements Disposable, NativeWrapper<NativeImageEncoder> {
+  private native: NativeImageEncoder;
+
+  private constructor(native: NativeImageEncoder) {
+    this.native = native;
+  }
+
+  /**
+   * Create an image encoder.
+   *
+   * @param options - Pool size and threads per encoder context
+   *
+   * @returns Image encoder with an empty pool
+   *
+   * @throws {RangeError} If maxContexts or threads is negative
+   *
+   * @example
+   * ```typescript
+   * const snapshots = ImageEncoder.create({ maxContexts: 64 });
+   * ```
+   */
+  static create(options?: ImageEncoderOptions): ImageEncoder {
+    return new ImageEncoder(bindings.ImageEncoder.create(options));
+  }
+
+  /**
+   * Encode a frame to an image.
+   *
+   * Converts pixel format and size as needed with a cached scaler and
+   * encodes on the libuv threadpool. The frame must stay unchanged until
+   * the promise settles.
+   *
+   * @param frame - Video frame (any pixel format, software or hardware)
+   *
+   * @param options - Image format, output size and quality
+   *
+   * @returns Encoded image
+   *
+   * @throws {FFmpegError} If the encoder is missing, the frame is invalid or encoding fails
+   *
+   * @example
+   * ```typescript
+   * const png = await snapshots.encode(frame, { format: 'png', height: 360 });
+   * ```
+   *
+   * @see {@link encodeSync} For synchronous encoding
+   */
+  async encode(frame: Frame, options: ImageEncodeOptions = {}): Promise<Buffer> {
+    const result = await this.native.encode(frame.getNative(), this.toNativeOptions(options));
+    if (typeof result === 'number') {
+      FFmpegError.throwIfError(result, 'Failed to encode image');
+    }
+    return result as Buffer;
+  }
+
+  /**
+   * Encode a frame to an image synchronously.
+   * Synchronous version of encode.
+   *
+   * @param frame - Video frame (any pixel format, software or hardware)
+   *
+   * @param options - Image format, output size and quality
+   *
+   * @returns Encoded image
+   *
+   * @throws {FFmpegError} If the encoder is missing, the frame is invalid or encoding fails
+   *
+   * @example
+   * ```typescript
+   * const jpeg = snapshots.encodeSync(frame, { quality: 90 });
+   * ```
+   *
+   * @see {@link encode} For async version
+   */
+  encodeSync(frame: Frame, options: ImageEncodeOptions = {}): Buffer {
+    const result = this.native.encodeSync(frame.getNative(), this.toNativeOptions(options));
+    if (typeof result === 'number') {
+      FFmpegError.throwIfError(result, 'Failed to encode image');
+    }
+    return result as Buffer;
+  }
+
+  /**
+   * Close all idle encoder contexts.
+   *
+   * The pool stays usable; the next encodes open new contexts.
+   *
+   * @example
+   * ```typescript
+   * // Camera layout changed
+   * snapshots.clear();
+   * ```
+   */
+  clear(): void {
+    this.native.clear();
+  }
+
+  /**
+   * Close the encoder.
+   *
+   * Idle contexts are closed immediately, contexts of running encodes when
+   * they finish. Later encodes fail.
+   *
+   * @example
+   * ```typescript
+   * snapshots.close();
+   * ```
+   */
+  close(): void {
+    this.native.close();
+  }
+
+  /**
+   * Get pool statistics.
+   *
+   * @returns Idle and in-use contexts, encoded images, pool hits, misses and evictions
+   *
+   * @example
+   * ```typescript
+   * const { hits, misses } = snapshots.getStats();
+   * ```
+   */
+  getStats(): ImageEncoderStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native ImageEncoder object.
+   *
+   * @returns The native ImageEncoder binding object
+   *
+   * @internal
+   */
+  getNative(): NativeImageEncoder {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the encoder.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling close().
+   *
+   * @example
+   * ```typescript
+   * {
+   *   using snapshots = ImageEncoder.create();
+   *   // Use encoder...
+   * } // Automatically closed
+   * ```
+   */
+  [Symbol.dispose](): void {
+    this.close();
+  }
+
+  /**
+   * Map public options to the native encode options.
+   *
+   * @param options - Image encode options
+   *
+   * @returns Native options with the codec ID
+   *
+   * @internal
+   */
+  private toNativeOptions(options: ImageEncodeOptions): { codecId: number; width?: number; height?: number; quality?: number } {
+    const format = options.format ?? 'jpeg';
+    const codecId = IMAGE_CODEC_IDS[format];
+    if (codecId === undefined) {
+      throw new TypeError(`Unsupported image format '${format}'`);
+    }
+    return { codecId, width: options.width, height: options.height, quality: options.quality };
+  }
+}
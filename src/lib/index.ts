@@ -12,6 +12,12 @@ export { CodecParameters } from './codec-parameters.js';
 // Codec
 export { Codec } from './codec.js';
 
+// Leak detection
+export { getLeakReport, resetLeakDetection, setLeakDetection } from './leak-detector.js';
+
+// Codec/filter/format registry
+export { Registry, RegistryTable } from './registry.js';
+
 // Codec Parser
 export { CodecParser } from './codec-parser.js';
 
@@ -59,6 +65,33 @@ export { Option, OptionInfo, type OptionMember } from './option.js';
 // Sync Queue
 export { SyncQueue, SyncQueueType } from './sync-queue.js';
 
+// RTSP Talkback
+export { RTSPTalkback } from './rtsp-talkback.js';
+
+// Pipeline Stage
+export { PipelineStage } from './pipeline-stage.js';
+
+// Packet Pacer
+export { PacketPacer } from './packet-pacer.js';
+
+// Input Synchronizer
+export { InputSynchronizer } from './input-synchronizer.js';
+
+// Timestamp Rescaler
+export { TimestampRescaler } from './timestamp-rescaler.js';
+
+// Image Encoder
+export { ImageEncoder } from './image-encoder.js';
+
+// Audio Mixer
+export { AudioMixer } from './audio-mixer.js';
+
+// Loudness Meter
+export { LoudnessMeter } from './loudness-meter.js';
+
+// Voice Activity Detector
+export { VoiceActivityDetector } from './voice-activity-detector.js';
+
 // Filter related classes
 export { FilterContext } from './filter-context.js';
 export { FilterGraph } from './filter-graph.js';
@@ -0,0 +1,243 @@
+import { bindings } from './binding.js';
+
+import type { FormatContext } from './format-context.js';
+import type { NativeInputSynchronizer, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { Stream } from './stream.js';
+import type { InputSynchronizerOptions, InputSynchronizerStats } from './types.js';
+
+/**
+ * Synchronized multi-input reader.
+ *
+ * Reads several opened input format contexts (e.g. one RTSP camera each) on
+ * native threads and places their packets on one shared wall clock timeline
+ * for multi-camera recording. Inputs that report an absolute start time
+ * (`start_time_realtime`, set by the RTSP demuxer from RTCP sender reports)
+ * are mapped with it, so cameras with synchronized clocks line up regardless
+ * of connection delay. Other inputs are anchored at the arrival time of their
+ * first packet. When the first sender report arrives after the first packet,
+ * the input starts on arrival time and is re-anchored to the source clock
+ * once, so its timestamps may jump forward at that point. They never jump
+ * backwards: after a re-anchor to an earlier clock, packets follow the last
+ * mapped timestamp of their stream until the new timeline catches up.
+ * Timeline zero is the wall clock at {@link start}.
+ *
+ * Mapped packets are interleaved by FFmpeg's sync queue, which keeps every
+ * stream within `bufferDuration` of the others, and are received in timeline
+ * order. Output stream indices are flattened: all streams of input 0 first,
+ * then input 1 and so on (see {@link getSource}). Received packets carry the
+ * time base of their source stream.
+ *
+ * Interarrival jitter is measured per input (RFC 3550 estimator on arrival
+ * time versus timeline position). When an input ends or fails, the others
+ * keep going; the timeline ends when all inputs have ended.
+ *
+ * The format contexts are read by the synchronizer and must not be read from
+ * JavaScript while it is running. {@link stop} interrupts blocking reads, so
+ * the inputs can only be closed afterwards.
+ *
+ * @example
+ * ```typescript
+ * import { FFmpegError, InputSynchronizer, Packet } from 'node-av';
+ * import { AVERROR_EOF } from 'node-av/constants';
+ *
+ * await using sync = InputSynchronizer.create([camA.getFormatContext(), camB.getFormatContext()]);
+ * sync.start();
+ *
+ * const packet = new Packet();
+ * packet.alloc();
+ * while (true) {
+ *   const ret = await sync.receiveAsync(packet);
+ *   if (ret === AVERROR_EOF) break;
+ *   FFmpegError.throwIfError(ret, 'receive');
+ *   await output.writePacket(packet, outputIndex[packet.streamIndex]);
+ * }
+ * ```
+ */
+export class InputSynchronizer implements AsyncDisposable, NativeWrapper<NativeInputSynchronizer> {
+  /** @internal */
+  public native: NativeInputSynchronizer;
+
+  private sources: { input: number; stream: Stream }[];
+
+  private constructor(native: NativeInputSynchronizer, inputs: FormatContext[]) {
+    this.native = native;
+    this.sources = inputs.flatMap((ctx, input) => ctx.streams.map((stream) => ({ input, stream })));
+  }
+
+  /**
+   * Create a synchronizer for opened inputs.
+   *
+   * Streams must be known (find stream info done); streams added to an input
+   * later are skipped.
+   *
+   * @param inputs - Opened input format contexts
+   *
+   * @param options - Sync buffer and queue limits
+   *
+   * @returns Synchronizer (not started)
+   *
+   * @throws {TypeError} If an input is not an opened input context
+   *
+   * @example
+   * ```typescript
+   * const sync = InputSynchronizer.create([ctxA, ctxB], { bufferDuration: 2 });
+   * ```
+   */
+  static create(inputs: FormatContext[], options?: InputSynchronizerOptions): InputSynchronizer {
+    const native = bindings.InputSynchronizer.create(
+      inputs.map((ctx) => ctx.getNative()),
+      options,
+    );
+    return new InputSynchronizer(native, inputs);
+  }
+
+  /**
+   * Total number of output streams over all inputs.
+   */
+  get streamCount(): number {
+    return this.native.streamCount;
+  }
+
+  /**
+   * Get the input and source stream of an output stream index.
+   *
+   * @param streamIndex - Output stream index (as set on received packets)
+   *
+   * @returns Input index and source stream, or null if out of range
+   *
+   * @example
+   * ```typescript
+   * const source = sync.getSource(packet.streamIndex);
+   * console.log(`camera ${source?.input}, ${source?.stream.codecpar.codecType}`);
+   * ```
+   */
+  getSource(streamIndex: number): { input: number; stream: Stream } | null {
+    return this.sources[streamIndex] ?? null;
+  }
+
+  /**
+   * Start the reader threads.
+   *
+   * The wall clock at this call is timeline zero.
+   *
+   * @throws {Error} If already started
+   *
+   * @example
+   * ```typescript
+   * sync.start();
+   * ```
+   */
+  start(): void {
+    this.native.start();
+  }
+
+  /**
+   * Receive the next packet in timeline order without waiting.
+   *
+   * @param packet - Allocated packet receiving the data
+   *
+   * @returns Output stream index (>= 0), AVERROR_EAGAIN if no packet is ready yet,
+   *   or AVERROR_EOF when all inputs have ended
+   *
+   * @example
+   * ```typescript
+   * const ret = sync.receive(packet);
+   * if (ret >= 0) {
+   *   // Use packet...
+   * }
+   * ```
+   *
+   * @see {@link receiveAsync} For waiting version
+   */
+  receive(packet: Packet): number {
+    return this.native.receive(packet.getNative());
+  }
+
+  /**
+   * Receive the next packet in timeline order.
+   *
+   * Waits on a native wakeup, not on a libuv threadpool thread.
+   *
+   * @param packet - Allocated packet receiving the data
+   *
+   * @returns Output stream index (>= 0), or AVERROR_EOF when all inputs have
+   *   ended or the synchronizer was stopped
+   *
+   * @throws {Error} If another receiveAsync() is pending
+   *
+   * @example
+   * ```typescript
+   * while ((await sync.receiveAsync(packet)) >= 0) {
+   *   // Use packet...
+   * }
+   * ```
+   *
+   * @see {@link receive} For non-waiting version
+   */
+  async receiveAsync(packet: Packet): Promise<number> {
+    return await this.native.receiveAsync(packet.getNative());
+  }
+
+  /**
+   * Stop reading.
+   *
+   * Interrupts blocking reads and joins the reader threads. A pending
+   * receiveAsync() resolves with AVERROR_EOF. The inputs are not readable
+   * afterwards and should be closed.
+   *
+   * @example
+   * ```typescript
+   * await sync.stop();
+   * await camA.close();
+   * ```
+   */
+  async stop(): Promise<void> {
+    await this.native.stop();
+  }
+
+  /**
+   * Get per-input clock and jitter statistics.
+   *
+   * @returns Statistics per input and the number of queued packets
+   *
+   * @example
+   * ```typescript
+   * for (const [i, input] of sync.getStats().inputs.entries()) {
+   *   console.log(`input ${i}: ${input.clock} clock, jitter ${input.jitterMs.toFixed(1)}ms`);
+   * }
+   * ```
+   */
+  getStats(): InputSynchronizerStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native InputSynchronizer object.
+   *
+   * @returns The native InputSynchronizer binding object
+   *
+   * @internal
+   */
+  getNative(): NativeInputSynchronizer {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the synchronizer.
+   *
+   * Implements the AsyncDisposable interface for automatic cleanup.
+   * Equivalent to calling stop().
+   *
+   * @example
+   * ```typescript
+   * {
+   *   await using sync = InputSynchronizer.create(inputs);
+   *   // Use sync...
+   * } // Automatically stopped
+   * ```
+   */
+  async [Symbol.asyncDispose](): Promise<void> {
+    await this.stop();
+  }
+}
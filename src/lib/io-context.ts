@@ -4,6 +4,7 @@ import { OptionMember } from './option.js';
 
 import type { AVIOFlag, AVSeekWhence } from '../constants/constants.js';
 import type { NativeIOContext, NativeWrapper } from './native-types.js';
+import type { RTPSinkOptions, RTPSinkStats } from './types.js';
 
 /**
  * I/O context for custom input/output operations.
@@ -281,6 +282,118 @@ export class IOContext extends OptionMember<NativeIOContext> implements AsyncDis
     this.native.allocContextWithCallbacks(bufferSize, writeFlag, readCallback ?? undefined, writeCallback ?? undefined, seekCallback ?? undefined);
   }
 
+  /**
+   * Allocate write-only I/O context backed by the native RTP sink.
+   *
+   * Intended as `pb` of an RTP muxer. Every datagram flushed by the muxer
+   * has its header rewritten in place (SSRC, payload type, continuous
+   * sequence numbers, rebased or synthesized timestamps), RTCP packets are
+   * dropped, and the remaining datagrams are delivered in batches:
+   * one Buffer slab plus an offsets array where datagram `i` spans
+   * `slab.subarray(offsets[i], offsets[i + 1])`.
+   *
+   * Batches are delivered when the marker bit is seen (unless disabled),
+   * when `maxBatchPackets` is reached, on {@link flushRtpSink} and on {@link freeContext}.
+   *
+   * With `options.udp` the batches are sent natively over a connected UDP socket
+   * (sendmmsg on Linux, optional token-bucket pacing) and never reach JS.
+   *
+   * @param bufferSize - Size of internal buffer (should be >= the muxer packet size)
+   *
+   * @param options - Header rewrite, batching and UDP options
+   *
+   * @param callback - Receives batches of ready-to-send datagrams (optional with `options.udp`)
+   *
+   * @throws {Error} If the UDP destination is invalid or the socket cannot be created
+   *
+   * @example
+   * ```typescript
+   * const io = new IOContext();
+   * io.allocContextRtpSink(1500, { ssrc: 0x1234, payloadType: 96 }, (slab, offsets) => {
+   *   for (let i = 0; i < offsets.length - 1; i++) {
+   *     socket.send(slab.subarray(offsets[i], offsets[i + 1]));
+   *   }
+   * });
+   * io.maxPacketSize = 1200;
+   * formatContext.pb = io;
+   * ```
+   *
+   * @example
+   * ```typescript
+   * // Send straight to a local SFU, paced to 4 Mbit/s
+   * io.allocContextRtpSink(1500, {
+   *   ssrc: 0x1234,
+   *   udp: { address: '127.0.0.1', port: 5004, pacingBitrate: 4_000_000 },
+   * });
+   * ```
+   *
+   * @see {@link allocContextWithCallbacks} For generic custom output
+   */
+  allocContextRtpSink(bufferSize: number, options: RTPSinkOptions, callback?: (slab: Buffer, offsets: Uint32Array) => void): void {
+    this.native.allocContextRtpSink(bufferSize, options, callback);
+  }
+
+  /**
+   * Deliver pending RTP sink datagrams.
+   *
+   * Flushes the I/O buffer and hands any batched datagrams to the sink callback.
+   * No-op if this context is not an RTP sink.
+   *
+   * @example
+   * ```typescript
+   * await muxer.writePacket(packet, streamIndex);
+   * io.flushRtpSink();
+   * ```
+   */
+  flushRtpSink(): void {
+    this.native.flushRtpSink();
+  }
+
+  /**
+   * Get RTP sink statistics.
+   *
+   * @returns Packet, byte, batch and drop counters (plus UDP sender counters), or null if this context is not an RTP sink
+   *
+   * @example
+   * ```typescript
+   * const stats = io.getRtpSinkStats();
+   * console.log(`Sent ${stats?.packets} packets in ${stats?.batches} batches`);
+   * ```
+   */
+  getRtpSinkStats(): RTPSinkStats | null {
+    return this.native.getRtpSinkStats();
+  }
+
+  /**
+   * Allocate read-only I/O context backed by a memory-mapped local file.
+   *
+   * Replaces the file protocol for demuxing local files. The context runs in
+   * direct mode, so packet payloads are copied once from the mapping into the
+   * packet buffer instead of being read into the I/O buffer first. Seeking only
+   * moves the read position. The file is unmapped by {@link freeContext}.
+   *
+   * Set as `pb` of a format context before opening the input. The high-level
+   * Demuxer uses it with the `mmap` option.
+   *
+   * @param path - Local file path
+   *
+   * @param bufferSize - Size of internal buffer used for small reads (default: 32768)
+   *
+   * @throws {Error} If the file cannot be opened or mapped
+   *
+   * @example
+   * ```typescript
+   * const io = new IOContext();
+   * io.allocContextMmap('input.mp4');
+   * formatContext.allocContext();
+   * formatContext.pb = io;
+   * await formatContext.openInput('', null, null);
+   * ```
+   */
+  allocContextMmap(path: string, bufferSize?: number): void {
+    this.native.allocContextMmap(path, bufferSize);
+  }
+
   /**
    * Free I/O context.
    *
@@ -0,0 +1,199 @@
+import { bindings } from './binding.js';
+
+import type { Frame } from './frame.js';
+import type { NativeLoudnessMeter, NativeWrapper } from './native-types.js';
+import type { ChannelLevel, LoudnessMeterOptions, LoudnessResult } from './types.js';
+
+/**
+ * Loudness and level meter (ITU-R BS.1770-4, EBU R128).
+ *
+ * Measures audio frames of any sample format and channel layout without
+ * modifying them, so it can sit inline in a decode or filter loop. Keeps
+ * momentary (400 ms), short-term (3 s) and gated integrated loudness in LUFS,
+ * loudness range in LU, true peak (4x oversampled) and sample peak, and RMS
+ * per channel. Integrated loudness and loudness range use fixed size
+ * histograms, so a meter costs the same memory after an hour as after a
+ * second.
+ *
+ * The sample rate and channel layout are taken from the first frame.
+ *
+ * For many meters (e.g. one per radio channel), {@link getValues} fills a
+ * reusable Float64Array instead of building result objects:
+ *
+ * | Index           | Value                                   |
+ * |-----------------|-----------------------------------------|
+ * | 0               | Momentary loudness (LUFS)               |
+ * | 1               | Short-term loudness (LUFS)              |
+ * | 2               | Integrated loudness (LUFS)              |
+ * | 3               | Loudness range (LU)                     |
+ * | 4               | Sample peak over all channels (dBFS)    |
+ * | 5               | True peak over all channels (dBTP)      |
+ * | 6 + 3c          | RMS of channel c over 400 ms (dBFS)     |
+ * | 7 + 3c          | Sample peak of channel c (dBFS)         |
+ * | 8 + 3c          | True peak of channel c (dBTP)           |
+ *
+ * Values without enough audio yet (and silence) are -Infinity; true peak
+ * values are NaN when disabled.
+ *
+ * @example
+ * ```typescript
+ * import { LoudnessMeter } from 'node-av';
+ *
+ * const meter = LoudnessMeter.create();
+ *
+ * for await (const frame of decoder.frames(input.packets(stream.index))) {
+ *   meter.measure(frame);
+ *   await encoder.encode(frame);
+ * }
+ *
+ * const { integrated, range, truePeak } = meter.getResult();
+ * console.log(`${integrated.toFixed(1)} LUFS, LRA ${range.toFixed(1)} LU, ${truePeak.toFixed(1)} dBTP`);
+ * ```
+ */
+export class LoudnessMeter implements NativeWrapper<NativeLoudnessMeter> {
+  private native: NativeLoudnessMeter;
+
+  private constructor(native: NativeLoudnessMeter) {
+    this.native = native;
+  }
+
+  /**
+   * Create a loudness meter.
+   *
+   * @param options - Whether to measure true peak
+   *
+   * @returns Meter, configured by the first measured frame
+   *
+   * @example
+   * ```typescript
+   * // VU meter without the cost of oversampling
+   * const meter = LoudnessMeter.create({ truePeak: false });
+   * ```
+   */
+  static create(options?: LoudnessMeterOptions): LoudnessMeter {
+    return new LoudnessMeter(bindings.LoudnessMeter.create(options));
+  }
+
+  /**
+   * Number of channels measured (0 before the first frame).
+   */
+  get channels(): number {
+    return this.native.channels;
+  }
+
+  /**
+   * Measure an audio frame.
+   *
+   * The frame is only read.
+   *
+   * @param frame - Audio frame (U8, S16, S32, S64, FLT or DBL, packed or planar)
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Frame has no samples or an unsupported sample format
+   *   - AVERROR_INPUT_CHANGED: Sample rate or channel count differs from the first frame
+   *
+   * @example
+   * ```typescript
+   * const ret = meter.measure(frame);
+   * FFmpegError.throwIfError(ret, 'measure');
+   * ```
+   */
+  measure(frame: Frame): number {
+    return this.native.measure(frame.getNative());
+  }
+
+  /**
+   * Get all measurements as numbers.
+   *
+   * See the class description for the layout.
+   *
+   * @param out - Array to fill (at least 6 + 3 * channels values), allocated if omitted
+   *
+   * @returns The filled array
+   *
+   * @throws {TypeError} If out is not a Float64Array or too short
+   *
+   * @example
+   * ```typescript
+   * const values = new Float64Array(6 + 3 * meter.channels);
+   * setInterval(() => {
+   *   meter.getValues(values);
+   *   vu.update(values[0], values[5]);
+   * }, 100);
+   * ```
+   */
+  getValues(out?: Float64Array): Float64Array {
+    return this.native.getValues(out);
+  }
+
+  /**
+   * Get all measurements as an object.
+   *
+   * @returns Loudness, peaks and channel levels
+   *
+   * @example
+   * ```typescript
+   * const { momentary, channels } = meter.getResult();
+   * ```
+   *
+   * @see {@link getValues} For the allocation-free variant
+   */
+  getResult(): LoudnessResult {
+    const values = this.native.getValues();
+    const channels: ChannelLevel[] = [];
+    for (let i = 6; i + 2 < values.length; i += 3) {
+      channels.push({ rms: values[i], samplePeak: values[i + 1], truePeak: values[i + 2] });
+    }
+    return {
+      momentary: values[0],
+      shortTerm: values[1],
+      integrated: values[2],
+      range: values[3],
+      samplePeak: values[4],
+      truePeak: values[5],
+      channels,
+    };
+  }
+
+  /**
+   * Reset all measurements.
+   *
+   * The next frame configures the meter again, so it may have another
+   * sample rate or layout.
+   *
+   * @example
+   * ```typescript
+   * // Next programme
+   * meter.reset();
+   * ```
+   */
+  reset(): void {
+    this.native.reset();
+  }
+
+  /**
+   * Reset sample and true peaks.
+   *
+   * Loudness measurements are kept.
+   *
+   * @example
+   * ```typescript
+   * // Peak hold of 2 seconds
+   * setInterval(() => meter.resetPeaks(), 2000);
+   * ```
+   */
+  resetPeaks(): void {
+    this.native.resetPeaks();
+  }
+
+  /**
+   * Get the underlying native LoudnessMeter object.
+   *
+   * @returns The native LoudnessMeter binding object
+   *
+   * @internal
+   */
+  getNative(): NativeLoudnessMeter {
+    return this.native;
+  }
+}
@@ -46,7 +46,26 @@ import type {
   AVStreamEventFlag,
   SwsFlags,
 } from '../constants/index.js';
-import type { ChannelLayout, CodecProfile, FilterPad, ImageOptions, IRational, RTSPStreamInfo } from './types.js';
+import type {
+  AudioMixerInputOptions,
+  AudioMixerStats,
+  ChannelLayout,
+  CodecProfile,
+  FilterPad,
+  ImageEncoderStats,
+  ImageOptions,
+  InputSynchronizerStats,
+  IRational,
+  PacketPacerStats,
+  PipelineStageKind,
+  PipelineStageStats,
+  RTPSinkOptions,
+  RTPSinkStats,
+  RTSPStreamInfo,
+  RTSPTalkbackStats,
+  SpeechSegment,
+  VoiceActivityStats,
+} from './types.js';
 
 /**
  * Native AVPacket binding interface
@@ -82,6 +101,7 @@ export interface NativePacket extends Disposable {
   addSideData(type: AVPacketSideDataType, data: Buffer): number;
   newSideData(type: AVPacketSideDataType, size: number): Buffer;
   freeSideData(): void;
+  setAllocationSite(site: number, handover?: boolean): void;
 
   [Symbol.dispose](): void;
 }
@@ -148,6 +168,7 @@ export interface NativeFrame extends Disposable {
   removeSideData(type: AVFrameSideDataType): void;
   getMetadata(): NativeDictionary;
   applyCropping(flags?: number): number;
+  setAllocationSite(site: number): void;
 
   [Symbol.dispose](): void;
 }
@@ -380,6 +401,10 @@ export interface NativeIOContext extends AsyncDisposable {
     writeCallback?: (buffer: Buffer) => number | void,
     seekCallback?: (offset: bigint, whence: AVSeekWhence) => bigint | number,
   ): void;
+  allocContextRtpSink(bufferSize: number, options: RTPSinkOptions, callback?: (slab: Buffer, offsets: Uint32Array) => void): void;
+  flushRtpSink(): void;
+  getRtpSinkStats(): RTPSinkStats | null;
+  allocContextMmap(path: string, bufferSize?: number): void;
   freeContext(): void;
   open2(url: string, flags: AVIOFlag): Promise<number>;
   open2Sync(url: string, flags: AVIOFlag): number;
@@ -502,6 +527,8 @@ export interface NativeFormatContext extends AsyncDisposable {
   readonly nbPrograms: number;
   readonly pbBytes: bigint;
   readonly probeScore: number;
+  readonly readStalled: boolean;
+  readTimeout: number;
   url: string | null;
   flags: AVFormatFlag;
   probesize: bigint;
@@ -541,6 +568,12 @@ export interface NativeFormatContext extends AsyncDisposable {
   writeTrailerSync(): number;
   flush(): Promise<void>;
   flushSync(): void;
+  readPlay(): Promise<number>;
+  readPlaySync(): number;
+  readPause(): Promise<number>;
+  readPauseSync(): number;
+  suspendInput(pause?: boolean): Promise<number>;
+  suspendInputSync(pause?: boolean): number;
   newStream(c: NativeCodec | null): NativeStream;
   dumpFormat(index: number, url: string, isOutput: boolean): void;
   findBestStream(
@@ -690,7 +723,9 @@ export interface NativeSoftwareResampleContext extends Disposable {
   close(): void;
   convert(outBuffer: Buffer[] | null, outCount: number, inBuffer: Buffer[] | null, inCount: number): Promise<number>;
   convertSync(outBuffer: Buffer[] | null, outCount: number, inBuffer: Buffer[] | null, inCount: number): number;
-  convertFrame(outFrame: NativeFrame | null, inFrame: NativeFrame | null): number;
+  convertFrame(outFrame: NativeFrame | null, inFrame: NativeFrame | null): Promise<number>;
+  convertFrameSync(outFrame: NativeFrame | null, inFrame: NativeFrame | null): number;
+  convertFrames(outFrames: NativeFrame[], inFrames: (NativeFrame | null)[]): Promise<number>;
   configFrame(outFrame: NativeFrame | null, inFrame: NativeFrame | null): number;
   isInitialized(): boolean;
   getDelay(base: bigint): bigint;
@@ -1015,6 +1050,176 @@ export interface NativeSyncQueue extends Disposable {
   free(): void;
 }
 
+/**
+ * Native RTSP talkback engine interface
+ *
+ * Opus RTP to RTSP backchannel transcoder running on its own native thread.
+ *
+ * @internal
+ */
+export interface NativeRTSPTalkback {
+  readonly __brand: 'NativeRTSPTalkback';
+
+  readonly codecId: AVCodecID;
+  readonly isRunning: boolean;
+
+  push(rtpPacket: Buffer): boolean;
+  stop(): Promise<void>;
+  stopSync(): void;
+  getStats(): RTSPTalkbackStats;
+}
+
+/**
+ * Native pipeline stage interface
+ *
+ * BSF/codec/filter stage running on its own native thread, connected to the
+ * next stage through a lock-free SPSC queue.
+ *
+ * @internal
+ */
+export interface NativePipelineStage {
+  readonly __brand: 'NativePipelineStage';
+
+  readonly kind: PipelineStageKind;
+  readonly isRunning: boolean;
+
+  connect(next: NativePipelineStage): void;
+  start(): void;
+  push(item: NativePacket | NativeFrame | null): boolean;
+  pushAsync(item: NativePacket | NativeFrame | null): Promise<boolean>;
+  pull(target: NativePacket | NativeFrame): number;
+  pullAsync(target: NativePacket | NativeFrame): Promise<number>;
+  stop(): Promise<void>;
+  stopSync(): void;
+  getStats(): PipelineStageStats;
+}
+
+/**
+ * Native PacketPacer binding interface
+ *
+ * Releases packets at their timestamp relative to a wall clock anchor,
+ * waiting on a native timer thread.
+ *
+ * @internal
+ */
+export interface NativePacketPacer extends Disposable {
+  readonly __brand: 'NativePacketPacer';
+
+  wait(timestamp: bigint, timeBase: IRational): Promise<void> | null;
+  reset(): void;
+  close(): void;
+  getStats(): PacketPacerStats;
+}
+
+/**
+ * Native InputSynchronizer binding interface
+ *
+ * Reads several input format contexts on native threads and interleaves
+ * their packets on a shared wall clock timeline.
+ *
+ * @internal
+ */
+export interface NativeInputSynchronizer {
+  readonly __brand: 'NativeInputSynchronizer';
+
+  readonly streamCount: number;
+
+  start(): void;
+  receive(packet: NativePacket): number;
+  receiveAsync(packet: NativePacket): Promise<number>;
+  stop(): Promise<void>;
+  getStats(): InputSynchronizerStats;
+}
+
+/**
+ * Native TimestampRescaler binding interface
+ *
+ * av_rescale_q_rnd() with the time base factors computed at creation.
+ *
+ * @internal
+ */
+export interface NativeTimestampRescaler {
+  readonly __brand: 'NativeTimestampRescaler';
+
+  rescale(ts: bigint | number | null): bigint;
+  rescaleArray(values: BigInt64Array, out?: BigInt64Array | null): BigInt64Array;
+}
+
+/**
+ * Native ImageEncoder binding interface
+ *
+ * Encodes frames to still images with pooled encoder and scaler contexts.
+ *
+ * @internal
+ */
+export interface NativeImageEncoder extends Disposable {
+  readonly __brand: 'NativeImageEncoder';
+
+  encode(frame: NativeFrame, options: { codecId: number; width?: number; height?: number; quality?: number }): Promise<Buffer | number>;
+  encodeSync(frame: NativeFrame, options: { codecId: number; width?: number; height?: number; quality?: number }): Buffer | number;
+  clear(): void;
+  close(): void;
+  getStats(): ImageEncoderStats;
+}
+
+/**
+ * Native AudioMixer binding interface
+ *
+ * Mixes live audio inputs into fixed size frames on a clock.
+ *
+ * @internal
+ */
+export interface NativeAudioMixer extends Disposable {
+  readonly __brand: 'NativeAudioMixer';
+
+  addInput(options?: AudioMixerInputOptions): number;
+  removeInput(input: number): void;
+  write(input: number, frame: NativeFrame | null): number;
+  setGain(input: number, gain: number): void;
+  setMuted(input: number, muted: boolean): void;
+  receive(frame: NativeFrame): number;
+  receiveAsync(frame: NativeFrame): Promise<number>;
+  close(): void;
+  getStats(): AudioMixerStats;
+}
+
+/**
+ * Native LoudnessMeter binding interface
+ *
+ * Measures EBU R128 loudness, true peak and channel levels of audio frames.
+ *
+ * @internal
+ */
+export interface NativeLoudnessMeter {
+  readonly __brand: 'NativeLoudnessMeter';
+
+  readonly channels: number;
+
+  measure(frame: NativeFrame): number;
+  getValues(out?: Float64Array | null): Float64Array;
+  reset(): void;
+  resetPeaks(): void;
+}
+
+/**
+ * Native VoiceActivityDetector binding interface
+ *
+ * Detects speech segments in audio frames from energy and zero-crossing rate.
+ *
+ * @internal
+ */
+export interface NativeVoiceActivityDetector {
+  readonly __brand: 'NativeVoiceActivityDetector';
+
+  readonly speaking: boolean;
+
+  process(frame: NativeFrame): number;
+  takeSegments(): SpeechSegment[];
+  flush(): void;
+  reset(): void;
+  getStats(): VoiceActivityStats;
+}
+
 /**
  * Interface for classes that wrap native objects
  *
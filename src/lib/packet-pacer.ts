@@ -0,0 +1,188 @@
+import { AV_NOPTS_VALUE } from '../constants/constants.js';
+import { bindings } from './binding.js';
+
+import type { NativePacketPacer, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { IRational, PacketPacerOptions, PacketPacerStats } from './types.js';
+
+/**
+ * Real-time packet pacer.
+ *
+ * Native equivalent of FFmpeg's `-re`/`-readrate`: releases packets when the
+ * wall clock reaches their timestamp relative to the first packet. All release
+ * times are computed from one clock anchor, so timer overshoot does not add up
+ * to drift over long runs (24/7 playout), and the anchor is moved on timestamp
+ * discontinuities and after stalls longer than `maxLag`.
+ *
+ * Packets that are already due are released without a promise. Waiting is done
+ * on a dedicated native timer thread and does not block the event loop or a
+ * libuv threadpool thread.
+ *
+ * One pending {@link wait} at a time; use one pacer per packet source
+ * (typically all streams of one input, paced by DTS).
+ *
+ * @example
+ * ```typescript
+ * import { PacketPacer } from 'node-av';
+ *
+ * using pacer = PacketPacer.create({ initialBurst: 0.5 });
+ * for await (const packet of input.packets()) {
+ *   if (!packet) break;
+ *   await pacer.waitFor(packet);
+ *   await output.writePacket(packet, streamIndex);
+ *   packet.free();
+ * }
+ * ```
+ *
+ * @see {@link Demuxer} The `pacing` option paces the demux loop with a PacketPacer
+ */
+export class PacketPacer implements Disposable, NativeWrapper<NativePacketPacer> {
+  /** @internal */
+  public native: NativePacketPacer;
+
+  private constructor(native: NativePacketPacer) {
+    this.native = native;
+  }
+
+  /**
+   * Create a pacer.
+   *
+   * @param options - Speed, initial burst and drift correction thresholds
+   *
+   * @returns Pacer (anchored on the first packet)
+   *
+   * @throws {RangeError} If speed is not positive
+   *
+   * @example
+   * ```typescript
+   * const pacer = PacketPacer.create({ speed: 1, maxLag: 2 });
+   * ```
+   */
+  static create(options?: PacketPacerOptions): PacketPacer {
+    return new PacketPacer(bindings.PacketPacer.create(options));
+  }
+
+  /**
+   * Wait until a timestamp is due.
+   *
+   * Returns null when the timestamp is already due (or has no value), so
+   * callers can skip the await: `const wait = pacer.wait(ts, tb); if (wait) await wait;`.
+   *
+   * @param timestamp - Timestamp (usually DTS)
+   *
+   * @param timeBase - Time base of the timestamp
+   *
+   * @returns Promise resolving at the release time, or null if due now
+   *
+   * @throws {Error} If another wait is pending
+   *
+   * @example
+   * ```typescript
+   * const pending = pacer.wait(packet.dts, stream.timeBase);
+   * if (pending) {
+   *   await pending;
+   * }
+   * ```
+   *
+   * @see {@link waitFor} For packets
+   */
+  wait(timestamp: bigint, timeBase: IRational): Promise<void> | null {
+    return this.native.wait(timestamp, timeBase);
+  }
+
+  /**
+   * Wait until a packet is due.
+   *
+   * Uses the DTS (PTS if DTS is unset) and the time base of the packet.
+   *
+   * @param packet - Packet with time base set
+   *
+   * @throws {Error} If another wait is pending
+   *
+   * @example
+   * ```typescript
+   * await pacer.waitFor(packet);
+   * ```
+   *
+   * @see {@link wait} For raw timestamps
+   */
+  async waitFor(packet: Packet): Promise<void> {
+    const ts = packet.dts !== AV_NOPTS_VALUE ? packet.dts : packet.pts;
+    const pending = this.native.wait(ts, packet.timeBase);
+    if (pending) {
+      await pending;
+    }
+  }
+
+  /**
+   * Re-anchor the clock on the next packet.
+   *
+   * Call after seeking or looping the source. The initial burst applies again.
+   *
+   * @example
+   * ```typescript
+   * await input.seek(0);
+   * pacer.reset();
+   * ```
+   */
+  reset(): void {
+    this.native.reset();
+  }
+
+  /**
+   * Stop the timer thread.
+   *
+   * A pending wait resolves immediately; later waits return null.
+   *
+   * @example
+   * ```typescript
+   * pacer.close();
+   * ```
+   */
+  close(): void {
+    this.native.close();
+  }
+
+  /**
+   * Get pacing statistics.
+   *
+   * @returns Released, waited and late packet counts and re-anchors
+   *
+   * @example
+   * ```typescript
+   * const { late, maxLateMs } = pacer.getStats();
+   * ```
+   */
+  getStats(): PacketPacerStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native PacketPacer object.
+   *
+   * @returns The native PacketPacer binding object
+   *
+   * @internal
+   */
+  getNative(): NativePacketPacer {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the pacer.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling close().
+   *
+   * @example
+   * ```typescript
+   * {
+   *   using pacer = PacketPacer.create();
+   *   // Use pacer...
+   * } // Automatically closed
+   * ```
+   */
+  [Symbol.dispose](): void {
+    this.close();
+  }
+}
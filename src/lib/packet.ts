@@ -1,4 +1,5 @@
 import { bindings } from './binding.js';
+import { captureAllocationSite, leakDetection } from './leak-detector.js';
 
 import type { AVPacketFlag, AVPacketSideDataType } from '../constants/constants.js';
 import type { NativePacket, NativeWrapper } from './native-types.js';
@@ -224,6 +225,9 @@ export class Packet implements Disposable, NativeWrapper<NativePacket> {
    */
   alloc(): void {
     this.native.alloc();
+    if (leakDetection.enabled) {
+      this.native.setAllocationSite(captureAllocationSite('Packet', Packet.prototype.alloc));
+    }
   }
 
   /**
@@ -325,6 +329,10 @@ export class Packet implements Disposable, NativeWrapper<NativePacket> {
       return null;
     }
 
+    if (leakDetection.enabled) {
+      cloned.setAllocationSite(captureAllocationSite('Packet', Packet.prototype.clone));
+    }
+
     // Wrap the native cloned packet
     const packet = Object.create(Packet.prototype) as Packet;
     (packet as any).native = cloned;
@@ -0,0 +1,393 @@
+import { bindings } from './binding.js';
+
+import type { BitStreamFilterContext } from './bitstream-filter-context.js';
+import type { CodecContext } from './codec-context.js';
+import type { FilterContext } from './filter-context.js';
+import type { Frame } from './frame.js';
+import type { NativePipelineStage, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { PipelineStageKind, PipelineStageOptions, PipelineStageStats } from './types.js';
+
+/**
+ * Native pipeline stage.
+ *
+ * Runs a bitstream filter, decoder, encoder or filter graph on its own native
+ * thread. Stages are linked with {@link connect} through bounded lock-free
+ * single-producer/single-consumer queues, so packets and frames travel from
+ * one stage to the next without touching the event loop. JavaScript is only
+ * involved at the ends of a chain: {@link push} into the head and {@link pull}
+ * from the tail. Waiting in {@link pushAsync}/{@link pullAsync} does not occupy
+ * a libuv threadpool thread.
+ *
+ * Items are reference-counted, not copied: push() takes a new reference to the
+ * packet/frame and pull() moves the result into the target object.
+ *
+ * The contexts must be fully configured (codec opened, filter graph configured,
+ * bitstream filter initialized) before the stage is created and must not be
+ * used from JavaScript while the stage is running.
+ *
+ * Compared to the Decoder/Encoder/FilterAPI classes, stages apply only the
+ * native per-item timestamp handling (best-effort PTS for decoders, buffer
+ * source/sink time bases for filters, encoder time base rescaling for
+ * encoders). Hardware frame transfer, corrupt frame checks and frame-rate
+ * handling stay in the high-level API.
+ *
+ * The high-level pipeTo() methods link components with stages on their own:
+ * - Bitstream filter to bitstream filter
+ * - Video decoder to filter or encoder
+ * - Filter to filter or encoder, when the filter itself runs on a stage
+ *
+ * The decoder must not use hardware decoding or the hwaccelOutputFormat,
+ * forcedFramerate, sarOverride or applyCropping options. Filter graphs and
+ * encoders in such a chain are configured from the decoder parameters at
+ * pipeTo() time instead of from the first frame. Filters with the hardware
+ * option hand their frames back to JavaScript. Everything else keeps the
+ * JavaScript workers.
+ *
+ * @example
+ * ```typescript
+ * import { FFmpegError, Packet, PipelineStage } from 'node-av';
+ * import { AVERROR_EOF } from 'node-av/constants';
+ *
+ * const toAnnexB = PipelineStage.create('bsf', annexbCtx);
+ * const dumpExtra = PipelineStage.create('bsf', dumpExtraCtx);
+ * toAnnexB.connect(dumpExtra);
+ * toAnnexB.start();
+ * dumpExtra.start();
+ *
+ * // Producer
+ * for await (const packet of input.packets(streamIndex)) {
+ *   await toAnnexB.pushAsync(packet);
+ * }
+ * await toAnnexB.pushAsync(null);
+ *
+ * // Consumer
+ * const out = new Packet();
+ * out.alloc();
+ * while (true) {
+ *   const ret = await dumpExtra.pullAsync(out);
+ *   if (ret === AVERROR_EOF) break;
+ *   FFmpegError.throwIfError(ret, 'pull');
+ *   // Use out...
+ * }
+ * ```
+ *
+ * @see {@link BitStreamFilterAPI.pipeTo} Links bitstream filter chains
+ * @see {@link Decoder.pipeTo} Links decoder, filter and encoder chains
+ */
+export class PipelineStage implements AsyncDisposable, NativeWrapper<NativePipelineStage> {
+  /** @internal */
+  public native: NativePipelineStage;
+
+  private constructor(native: NativePipelineStage) {
+    this.native = native;
+  }
+
+  /**
+   * Create a bitstream filter stage (packet to packet).
+   *
+   * @param kind - 'bsf'
+   *
+   * @param context - Initialized bitstream filter context
+   *
+   * @param options - Stage options
+   *
+   * @returns Stage (not started)
+   *
+   * @throws {TypeError} If the context is not initialized
+   *
+   * @example
+   * ```typescript
+   * const stage = PipelineStage.create('bsf', bsfCtx, { queueSize: 32 });
+   * ```
+   */
+  static create(kind: 'bsf', context: BitStreamFilterContext, options?: PipelineStageOptions): PipelineStage;
+
+  /**
+   * Create a decoder (packet to frame) or encoder (frame to packet) stage.
+   *
+   * @param kind - 'decoder' or 'encoder'
+   *
+   * @param context - Opened codec context
+   *
+   * @param options - Stage options
+   *
+   * @returns Stage (not started)
+   *
+   * @throws {TypeError} If the codec context is not open or has the wrong direction
+   *
+   * @example
+   * ```typescript
+   * const decode = PipelineStage.create('decoder', decoderCtx);
+   * const encode = PipelineStage.create('encoder', encoderCtx);
+   * ```
+   */
+  static create(kind: 'decoder' | 'encoder', context: CodecContext, options?: PipelineStageOptions): PipelineStage;
+
+  /**
+   * Create a filter graph stage (frame to frame).
+   *
+   * @param kind - 'filter'
+   *
+   * @param buffersrc - Buffer source filter context of a configured graph
+   *
+   * @param buffersink - Buffer sink filter context of the same graph
+   *
+   * @param options - Stage options
+   *
+   * @returns Stage (not started)
+   *
+   * @throws {TypeError} If the contexts are not a buffer source and sink
+   *
+   * @example
+   * ```typescript
+   * const scale = PipelineStage.create('filter', srcCtx, sinkCtx);
+   * ```
+   */
+  static create(kind: 'filter', buffersrc: FilterContext, buffersink: FilterContext, options?: PipelineStageOptions): PipelineStage;
+
+  static create(
+    kind: PipelineStageKind,
+    context: BitStreamFilterContext | CodecContext | FilterContext,
+    sinkOrOptions?: FilterContext | PipelineStageOptions,
+    options?: PipelineStageOptions,
+  ): PipelineStage {
+    const native =
+      kind === 'filter'
+        ? bindings.PipelineStage.create(kind, context.getNative(), (sinkOrOptions as FilterContext).getNative(), options)
+        : bindings.PipelineStage.create(kind, context.getNative(), null, sinkOrOptions as PipelineStageOptions | undefined);
+    return new PipelineStage(native);
+  }
+
+  /**
+   * Stage kind.
+   */
+  get kind(): PipelineStageKind {
+    return this.native.kind;
+  }
+
+  /**
+   * Whether the stage thread is running.
+   */
+  get isRunning(): boolean {
+    return this.native.isRunning;
+  }
+
+  /**
+   * Link the output of this stage to the input of another stage.
+   *
+   * Output items (and end of stream) are handed to the next stage on the
+   * native side. Both stages must not be started yet. After connecting,
+   * this stage can no longer be pulled and the next stage can no longer be pushed.
+   *
+   * @param next - Downstream stage
+   *
+   * @returns The downstream stage, for chaining
+   *
+   * @throws {TypeError} If the output type does not match the next stage input
+   *
+   * @throws {Error} If either stage is started or already connected
+   *
+   * @example
+   * ```typescript
+   * decode.connect(scale).connect(encode);
+   * ```
+   */
+  connect(next: PipelineStage): PipelineStage {
+    this.native.connect(next.getNative());
+    return next;
+  }
+
+  /**
+   * Start the stage thread.
+   *
+   * @throws {Error} If already started
+   *
+   * @example
+   * ```typescript
+   * stage.start();
+   * ```
+   */
+  start(): void {
+    this.native.start();
+  }
+
+  /**
+   * Queue an input item without waiting.
+   *
+   * Takes a new reference; the caller keeps ownership of the packet/frame.
+   * Pass null to signal end of stream.
+   *
+   * @param item - Packet (bsf/decoder) or frame (encoder/filter), or null
+   *
+   * @returns True if queued, false if the queue is full or the stage has finished
+   *
+   * @throws {Error} If the stage is fed by an upstream stage
+   *
+   * @example
+   * ```typescript
+   * if (!stage.push(packet)) {
+   *   await stage.pushAsync(packet);
+   * }
+   * ```
+   *
+   * @see {@link pushAsync} For waiting on queue space
+   */
+  push(item: Packet | Frame | null): boolean {
+    return this.native.push(item ? item.getNative() : null);
+  }
+
+  /**
+   * Queue an input item, waiting for queue space.
+   *
+   * Takes a new reference; the caller keeps ownership of the packet/frame.
+   * Pass null to signal end of stream.
+   *
+   * @param item - Packet (bsf/decoder) or frame (encoder/filter), or null
+   *
+   * @returns True if queued, false if the stage has finished or was stopped
+   *
+   * @throws {Error} If the stage is fed by an upstream stage or another pushAsync() is pending
+   *
+   * @example
+   * ```typescript
+   * await stage.pushAsync(packet);
+   * await stage.pushAsync(null); // End of stream
+   * ```
+   *
+   * @see {@link push} For non-waiting version
+   */
+  async pushAsync(item: Packet | Frame | null): Promise<boolean> {
+    return await this.native.pushAsync(item ? item.getNative() : null);
+  }
+
+  /**
+   * Take the next output item without waiting.
+   *
+   * Moves the item into the target, replacing its previous content.
+   *
+   * @param target - Allocated packet (bsf/encoder) or frame (decoder/filter)
+   *
+   * @returns 0 on success, AVERROR_EAGAIN if nothing is ready,
+   *          AVERROR_EOF at end of stream, or the error the stage finished with
+   *
+   * @throws {Error} If the stage output feeds a downstream stage
+   *
+   * @example
+   * ```typescript
+   * while (stage.pull(packet) === 0) {
+   *   await output.writePacket(packet, 0);
+   * }
+   * ```
+   *
+   * @see {@link pullAsync} For waiting on output
+   */
+  pull(target: Packet | Frame): number {
+    return this.native.pull(target.getNative());
+  }
+
+  /**
+   * Take the next output item, waiting until one is available.
+   *
+   * Moves the item into the target, replacing its previous content.
+   *
+   * @param target - Allocated packet (bsf/encoder) or frame (decoder/filter)
+   *
+   * @returns 0 on success, AVERROR_EOF at end of stream,
+   *          or the error the stage finished with
+   *
+   * @throws {Error} If the stage output feeds a downstream stage or another pullAsync() is pending
+   *
+   * @example
+   * ```typescript
+   * while ((await stage.pullAsync(packet)) === 0) {
+   *   await output.writePacket(packet, 0);
+   * }
+   * ```
+   *
+   * @see {@link pull} For non-waiting version
+   */
+  async pullAsync(target: Packet | Frame): Promise<number> {
+    return await this.native.pullAsync(target.getNative());
+  }
+
+  /**
+   * Stop the stage thread.
+   *
+   * Queued items are discarded. Pending pushAsync() resolves with false and
+   * pending pullAsync() with AVERROR_EOF. Does not stop connected stages.
+   *
+   * @returns Promise resolving when the thread has finished
+   *
+   * @example
+   * ```typescript
+   * await stage.stop();
+   * ```
+   *
+   * @see {@link stopSync} For synchronous version
+   */
+  async stop(): Promise<void> {
+    await this.native.stop();
+  }
+
+  /**
+   * Stop the stage thread synchronously.
+   * Synchronous version of stop.
+   *
+   * Blocks until the thread has finished its current item.
+   *
+   * @example
+   * ```typescript
+   * stage.stopSync();
+   * ```
+   *
+   * @see {@link stop} For async version
+   */
+  stopSync(): void {
+    this.native.stopSync();
+  }
+
+  /**
+   * Get stage statistics.
+   *
+   * @returns Item counters, queue depths and completion state
+   *
+   * @example
+   * ```typescript
+   * const stats = stage.getStats();
+   * console.log(`${stats.outputItems} out, ${stats.inputStalls} input stalls`);
+   * ```
+   */
+  getStats(): PipelineStageStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native PipelineStage object.
+   *
+   * @returns The native PipelineStage binding object
+   *
+   * @internal
+   */
+  getNative(): NativePipelineStage {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the stage.
+   *
+   * Implements the AsyncDisposable interface for automatic cleanup.
+   * Equivalent to calling stop().
+   *
+   * @example
+   * ```typescript
+   * {
+   *   await using stage = PipelineStage.create('bsf', bsfCtx);
+   *   // Use stage...
+   * } // Automatically stopped
+   * ```
+   */
+  async [Symbol.asyncDispose](): Promise<void> {
+    await this.stop();
+  }
+}
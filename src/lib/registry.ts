@@ -0,0 +1,245 @@
+import { bindings } from './binding.js';
+import { Codec } from './codec.js';
+import { Filter } from './filter.js';
+import { InputFormat } from './input-format.js';
+import { OutputFormat } from './output-format.js';
+
+import type { AVCodecID, AVHWDeviceType, AVMediaType, FFDecoderCodec, FFEncoderCodec } from '../constants/index.js';
+import type { NativeCodec, NativeFilter, NativeInputFormat, NativeOutputFormat } from './native-types.js';
+import type { RegistryCodecInfo, RegistrySnapshot } from './types.js';
+
+/**
+ * Registry table
+ *
+ * Selects the index used by a lookup. Encoders and decoders share
+ * the codec entries.
+ */
+export enum RegistryTable {
+  ENCODER = 0,
+  DECODER = 1,
+  FILTER = 2,
+  DEMUXER = 3,
+  MUXER = 4,
+}
+
+/**
+ * Indexed snapshot of the codec, filter and format registries.
+ *
+ * The native side walks FFmpeg's codec, filter, demuxer and muxer iterators
+ * once per process and keeps the results in compact arrays with hash indexes
+ * by name and codec id. Lookups resolve to an index, and every index maps to
+ * one cached wrapper: repeated lookups return the same object without
+ * allocating, which replaces the `Codec.getCodecList()` scans in hot paths.
+ *
+ * Lookups match FFmpeg's own: `findEncoder()`/`findDecoder()` by id prefer
+ * non-experimental codecs like `avcodec_find_encoder()`, demuxer and muxer
+ * names match any of a format's comma separated names.
+ *
+ * @example
+ * ```typescript
+ * import { Registry } from 'node-av';
+ * import { AV_CODEC_ID_H264 } from 'node-av/constants';
+ *
+ * const decoder = Registry.findDecoder(AV_CODEC_ID_H264);
+ * const encoder = Registry.findEncoder('libx264');
+ * const muxer = Registry.findMuxer('mp4');
+ *
+ * // Plain data for capability endpoints
+ * const { codecs, filters, demuxers, muxers } = Registry.snapshot();
+ * ```
+ *
+ * @see {@link Codec} For codec descriptors
+ * @see {@link Filter} For filter descriptors
+ */
+export class Registry {
+  private static codecs: (Codec | undefined)[] = [];
+  private static filters: (Filter | undefined)[] = [];
+  private static demuxers: (InputFormat | undefined)[] = [];
+  private static muxers: (OutputFormat | undefined)[] = [];
+  private static cachedSnapshot?: Readonly<RegistrySnapshot>;
+  private static byType = new Map<string, readonly RegistryCodecInfo[]>();
+  private static byDevice = new Map<string, readonly Codec[]>();
+
+  /**
+   * Find an encoder by codec id or name.
+   *
+   * @param codec - Codec id (non-experimental encoders preferred) or encoder name
+   *
+   * @returns Cached encoder or null if not found
+   *
+   * @example
+   * ```typescript
+   * const encoder = Registry.findEncoder('h264_nvenc') ?? Registry.findEncoder(AV_CODEC_ID_H264);
+   * ```
+   */
+  static findEncoder(codec: AVCodecID | FFEncoderCodec | string): Codec | null {
+    return Registry.codecAt(bindings.registryFind(RegistryTable.ENCODER, codec));
+  }
+
+  /**
+   * Find a decoder by codec id or name.
+   *
+   * @param codec - Codec id (non-experimental decoders preferred) or decoder name
+   *
+   * @returns Cached decoder or null if not found
+   *
+   * @example
+   * ```typescript
+   * const decoder = Registry.findDecoder(stream.codecpar.codecId);
+   * ```
+   */
+  static findDecoder(codec: AVCodecID | FFDecoderCodec | string): Codec | null {
+    return Registry.codecAt(bindings.registryFind(RegistryTable.DECODER, codec));
+  }
+
+  /**
+   * Find a filter by name.
+   *
+   * @param name - Filter name (e.g. 'scale')
+   *
+   * @returns Cached filter or null if not found
+   */
+  static findFilter(name: string): Filter | null {
+    const index = bindings.registryFind(RegistryTable.FILTER, name);
+    if (index < 0) {
+      return null;
+    }
+    return (Registry.filters[index] ??= new Filter(bindings.registryEntry(RegistryTable.FILTER, index) as NativeFilter));
+  }
+
+  /**
+   * Find a demuxer by name.
+   *
+   * Matches any of the demuxer's names ('mp4' finds 'mov,mp4,m4a,3gp,3g2,mj2'),
+   * ignoring case like av_find_input_format().
+   *
+   * @param name - Demuxer name
+   *
+   * @returns Cached input format or null if not found
+   */
+  static findDemuxer(name: string): InputFormat | null {
+    const index = bindings.registryFind(RegistryTable.DEMUXER, name);
+    if (index < 0) {
+      return null;
+    }
+    return (Registry.demuxers[index] ??= new InputFormat(bindings.registryEntry(RegistryTable.DEMUXER, index) as NativeInputFormat));
+  }
+
+  /**
+   * Find a muxer by name.
+   *
+   * Matches any of the muxer's names, ignoring case like av_guess_format().
+   *
+   * @param name - Muxer name
+   *
+   * @returns Cached output format or null if not found
+   */
+  static findMuxer(name: string): OutputFormat | null {
+    const index = bindings.registryFind(RegistryTable.MUXER, name);
+    if (index < 0) {
+      return null;
+    }
+    return (Registry.muxers[index] ??= new OutputFormat(bindings.registryEntry(RegistryTable.MUXER, index) as NativeOutputFormat));
+  }
+
+  /**
+   * Get the registry snapshot as plain, serializable data.
+   *
+   * Created on first call and frozen; later calls return the same object.
+   * Array positions are registry indexes (see {@link codecAt}).
+   *
+   * @returns Codecs, filters, demuxers and muxers with their capabilities
+   *
+   * @example
+   * ```typescript
+   * res.json(Registry.snapshot());
+   * ```
+   */
+  static snapshot(): Readonly<RegistrySnapshot> {
+    if (!Registry.cachedSnapshot) {
+      const snapshot = bindings.registrySnapshot();
+      for (const list of Object.values(snapshot)) {
+        for (const entry of list) {
+          Object.freeze(entry);
+          if ('hwDeviceTypes' in entry) {
+            Object.freeze(entry.hwDeviceTypes);
+          }
+        }
+        Object.freeze(list);
+      }
+      Registry.cachedSnapshot = Object.freeze(snapshot);
+    }
+    return Registry.cachedSnapshot;
+  }
+
+  /**
+   * Get the codec at a registry index.
+   *
+   * @param index - Position in `snapshot().codecs`
+   *
+   * @returns Cached codec or null if out of range
+   */
+  static codecAt(index: number): Codec | null {
+    if (index < 0) {
+      return null;
+    }
+    const cached = Registry.codecs[index];
+    if (cached) {
+      return cached;
+    }
+    const native = bindings.registryEntry(RegistryTable.ENCODER, index) as NativeCodec | null;
+    return native ? (Registry.codecs[index] = new Codec(native)) : null;
+  }
+
+  /**
+   * Get the codecs of a media type.
+   *
+   * @param type - Media type
+   *
+   * @param isEncoder - Encoders (true) or decoders (false)
+   *
+   * @returns Snapshot entries in registration order
+   *
+   * @example
+   * ```typescript
+   * const audioEncoders = Registry.codecsByType(AVMEDIA_TYPE_AUDIO, true).map((c) => c.name);
+   * ```
+   */
+  static codecsByType(type: AVMediaType, isEncoder: boolean): readonly RegistryCodecInfo[] {
+    const key = `${type}:${isEncoder}`;
+    let codecs = Registry.byType.get(key);
+    if (!codecs) {
+      codecs = Object.freeze(Registry.snapshot().codecs.filter((c) => c.type === type && c.isEncoder === isEncoder));
+      Registry.byType.set(key, codecs);
+    }
+    return codecs;
+  }
+
+  /**
+   * Get the codecs usable with a hardware device type.
+   *
+   * Codecs with a hardware config for the device type using a device or
+   * frames context, in registration order.
+   *
+   * @param deviceType - Hardware device type
+   *
+   * @param isEncoder - Encoders (true) or decoders (false)
+   *
+   * @returns Cached codecs
+   */
+  static codecsForDevice(deviceType: AVHWDeviceType, isEncoder: boolean): readonly Codec[] {
+    const key = `${deviceType}:${isEncoder}`;
+    let codecs = Registry.byDevice.get(key);
+    if (!codecs) {
+      const result: Codec[] = [];
+      Registry.snapshot().codecs.forEach((info, index) => {
+        if (info.isEncoder === isEncoder && info.hwDeviceTypes.includes(deviceType)) {
+          result.push(Registry.codecAt(index)!);
+        }
+      });
+      codecs = Object.freeze(result);
+      Registry.byDevice.set(key, codecs);
+    }
+    return codecs;
+  }
+}
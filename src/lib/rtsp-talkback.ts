@@ -0,0 +1,197 @@
+import { bindings } from './binding.js';
+
+import type { AVCodecID } from '../constants/constants.js';
+import type { FormatContext } from './format-context.js';
+import type { NativeRTSPTalkback, NativeWrapper } from './native-types.js';
+import type { RTSPTalkbackOptions, RTSPTalkbackStats } from './types.js';
+
+/**
+ * Native RTSP talkback engine.
+ *
+ * Transcodes inbound WebRTC audio (Opus RTP) to the codec announced for an RTSP
+ * backchannel stream and sends it to the camera. Depacketizing, Opus decoding,
+ * resampling, encoding (G.711 u-law/A-law, L16 or AAC) and RTP packetization
+ * run on one native thread per session, so the event loop only copies packets
+ * into the engine queue. Packets are sent through the same path as
+ * {@link FormatContext.sendRTSPPacket} (interleaved over TCP or raw over UDP).
+ *
+ * Sequence numbers, timestamps and SSRC are generated by the engine; the marker
+ * bit is set on the first packet of the talkspurt.
+ *
+ * @example
+ * ```typescript
+ * import { FormatContext, RTSPTalkback } from 'node-av';
+ *
+ * const ctx = new FormatContext();
+ * await ctx.openInput('rtsp://camera/stream?backchannel=1');
+ *
+ * const backchannel = ctx.getRTSPStreamInfo()?.find((s) => s.direction === 'sendonly' && s.mediaType === 'audio');
+ * if (backchannel) {
+ *   const talkback = RTSPTalkback.create(ctx, backchannel.streamIndex, { inputPayloadType: 111 });
+ *
+ *   // Forward inbound WebRTC RTP packets
+ *   track.onReceiveRtp.subscribe((rtp) => talkback.push(rtp.serialize()));
+ *
+ *   // Later
+ *   await talkback.stop();
+ *   console.log(talkback.getStats());
+ * }
+ * ```
+ *
+ * @see {@link FormatContext.getRTSPStreamInfo} For finding the backchannel stream
+ * @see {@link FormatContext.sendRTSPPacket} For forwarding packets without transcoding
+ */
+export class RTSPTalkback implements AsyncDisposable, NativeWrapper<NativeRTSPTalkback> {
+  /** @internal */
+  public native: NativeRTSPTalkback;
+
+  private constructor(native: NativeRTSPTalkback) {
+    this.native = native;
+  }
+
+  /**
+   * Create a talkback engine for an RTSP backchannel stream.
+   *
+   * The outbound codec, sample rate, channel count and payload type are taken
+   * from the backchannel stream of the opened RTSP input. The engine thread is
+   * started immediately.
+   *
+   * @param formatContext - Opened RTSP input context
+   *
+   * @param streamIndex - Backchannel stream index (see {@link FormatContext.getRTSPStreamInfo})
+   *
+   * @param options - Talkback options
+   *
+   * @returns Running talkback engine
+   *
+   * @throws {Error} If the context is not an RTSP input, the stream is not audio,
+   *                 or the backchannel codec is not supported
+   *
+   * @example
+   * ```typescript
+   * const talkback = RTSPTalkback.create(ctx, backchannel.streamIndex, {
+   *   inputPayloadType: 111,
+   *   packetDuration: 40,
+   * });
+   * ```
+   */
+  static create(formatContext: FormatContext, streamIndex: number, options: RTSPTalkbackOptions = {}): RTSPTalkback {
+    const native = bindings.RTSPTalkback.create(formatContext.getNative(), streamIndex, options);
+    return new RTSPTalkback(native);
+  }
+
+  /**
+   * Codec ID of the backchannel encoder.
+   */
+  get codecId(): AVCodecID {
+    return this.native.codecId;
+  }
+
+  /**
+   * Whether the engine thread is running.
+   */
+  get isRunning(): boolean {
+    return this.native.isRunning;
+  }
+
+  /**
+   * Queue an inbound Opus RTP packet.
+   *
+   * The packet is copied; the buffer can be reused immediately.
+   * When the queue is full the oldest packet is dropped.
+   *
+   * @param rtpPacket - Serialized RTP packet (header + Opus payload)
+   *
+   * @returns True if queued, false if the engine is stopped
+   *
+   * @example
+   * ```typescript
+   * track.onReceiveRtp.subscribe((rtp) => {
+   *   talkback.push(rtp.serialize());
+   * });
+   * ```
+   */
+  push(rtpPacket: Buffer): boolean {
+    return this.native.push(rtpPacket);
+  }
+
+  /**
+   * Stop the engine.
+   *
+   * Packets queued before the call are still processed and sent.
+   * Waits for the engine thread on the libuv threadpool.
+   *
+   * @returns Promise resolving when the engine thread has finished
+   *
+   * @example
+   * ```typescript
+   * await talkback.stop();
+   * ```
+   *
+   * @see {@link stopSync} For synchronous version
+   */
+  async stop(): Promise<void> {
+    await this.native.stop();
+  }
+
+  /**
+   * Stop the engine synchronously.
+   * Synchronous version of stop.
+   *
+   * Blocks until the engine thread has finished.
+   *
+   * @example
+   * ```typescript
+   * talkback.stopSync();
+   * ```
+   *
+   * @see {@link stop} For async version
+   */
+  stopSync(): void {
+    this.native.stopSync();
+  }
+
+  /**
+   * Get engine statistics.
+   *
+   * @returns Packet, frame and error counters
+   *
+   * @example
+   * ```typescript
+   * const stats = talkback.getStats();
+   * console.log(`Sent ${stats.sentPackets} packets, ${stats.lostPackets} lost`);
+   * ```
+   */
+  getStats(): RTSPTalkbackStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native RTSPTalkback object.
+   *
+   * @returns The native RTSPTalkback binding object
+   *
+   * @internal
+   */
+  getNative(): NativeRTSPTalkback {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the talkback engine.
+   *
+   * Implements the AsyncDisposable interface for automatic cleanup.
+   * Equivalent to calling stop().
+   *
+   * @example
+   * ```typescript
+   * {
+   *   await using talkback = RTSPTalkback.create(ctx, backchannel.streamIndex);
+   *   // Use talkback...
+   * } // Automatically stopped
+   * ```
+   */
+  async [Symbol.asyncDispose](): Promise<void> {
+    await this.stop();
+  }
+}
@@ -1,8 +1,9 @@
 import { bindings } from './binding.js';
+import { FFmpegError } from './error.js';
+import { Frame } from './frame.js';
 import { OptionMember } from './option.js';
 
 import type { AVSampleFormat } from '../constants/constants.js';
-import type { Frame } from './frame.js';
 import type { NativeSoftwareResampleContext, NativeWrapper } from './native-types.js';
 import type { ChannelLayout } from './types.js';
 
@@ -45,7 +46,7 @@ import type { ChannelLayout } from './types.js';
  * outFrame.sampleRate = 48000;
  * outFrame.allocBuffer();
  *
- * const ret3 = resampler.convertFrame(outFrame, inFrame);
+ * const ret3 = await resampler.convertFrame(outFrame, inFrame);
  * FFmpegError.throwIfError(ret3, 'convertFrame');
  *
  * // Get conversion delay
@@ -301,6 +302,8 @@ export class SoftwareResampleContext extends OptionMember<NativeSoftwareResample
    *
    * Converts an entire audio frame to the output format.
    * Simpler interface than convert() for frame-based processing.
+   * Runs on the libuv threadpool, so slow resamplers (soxr, long filters)
+   * do not block the event loop.
    *
    * Direct mapping to swr_convert_frame().
    *
@@ -319,22 +322,119 @@ export class SoftwareResampleContext extends OptionMember<NativeSoftwareResample
    *
    * // Convert frame
    * const outFrame = new Frame();
-   * const ret = resampler.convertFrame(outFrame, inFrame);
+   * const ret = await resampler.convertFrame(outFrame, inFrame);
    * FFmpegError.throwIfError(ret, 'convertFrame');
    *
    * // Drain remaining samples
    * const drainFrame = new Frame();
-   * const ret2 = resampler.convertFrame(drainFrame, null);
+   * const ret2 = await resampler.convertFrame(drainFrame, null);
    * if (ret2 === 0) {
    *   // Got drained samples
    * }
    * ```
    *
-   * @see {@link convert} For buffer-based conversion
+   * @see {@link convertFrameSync} For synchronous version
+   * @see {@link convertFrames} For batched conversion
    * @see {@link configFrame} To configure from frame
    */
-  convertFrame(outFrame: Frame | null, inFrame: Frame | null): number {
-    return this.native.convertFrame(outFrame?.getNative() ?? null, inFrame?.getNative() ?? null);
+  async convertFrame(outFrame: Frame | null, inFrame: Frame | null): Promise<number> {
+    return await this.native.convertFrame(outFrame?.getNative() ?? null, inFrame?.getNative() ?? null);
+  }
+
+  /**
+   * Convert audio frame synchronously.
+   * Synchronous version of convertFrame.
+   *
+   * Converts an entire audio frame to the output format.
+   *
+   * Direct mapping to swr_convert_frame().
+   *
+   * @param outFrame - Output frame (null to drain)
+   *
+   * @param inFrame - Input frame (null to flush)
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Invalid parameters
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *   - AVERROR_INPUT_CHANGED: Input format changed
+   *
+   * @example
+   * ```typescript
+   * import { Frame, FFmpegError } from 'node-av';
+   *
+   * const outFrame = new Frame();
+   * const ret = resampler.convertFrameSync(outFrame, inFrame);
+   * FFmpegError.throwIfError(ret, 'convertFrameSync');
+   * ```
+   *
+   * @see {@link convertFrame} For async version
+   */
+  convertFrameSync(outFrame: Frame | null, inFrame: Frame | null): number {
+    return this.native.convertFrameSync(outFrame?.getNative() ?? null, inFrame?.getNative() ?? null);
+  }
+
+  /**
+   * Convert multiple audio frames in one call.
+   *
+   * Converts all input frames in order on a single threadpool job, saving a
+   * threadpool hop and event loop wakeup per frame. A null input flushes the
+   * resampler, so a batch can end with the drained tail.
+   *
+   * Output frames get the output format, sample rate and channel layout of
+   * the context. Pass `outFrames` to reuse frames across batches: a writable
+   * buffer is filled up to its capacity instead of allocating a new one, and
+   * samples that do not fit stay buffered for the next call. Frames whose
+   * buffer is shared get a new buffer.
+   *
+   * Direct mapping to swr_convert_frame() for each input frame.
+   *
+   * @param inFrames - Input frames (null to flush)
+   *
+   * @param outFrames - Output frames to fill, one per input frame (allocated if omitted)
+   *
+   * @returns Output frames, one per input frame (empty frames when nothing was output)
+   *
+   * @throws {RangeError} If fewer output frames than input frames are given
+   *
+   * @throws {FFmpegError} If a conversion fails
+   *
+   * @example
+   * ```typescript
+   * // Resample a batch of decoded frames
+   * const outputs = await resampler.convertFrames(frames);
+   * for (const frame of outputs) {
+   *   await encoder.encode(frame);
+   * }
+   *
+   * // Reuse output frames across batches
+   * const pool = frames.map(() => {
+   *   const frame = new Frame();
+   *   frame.alloc();
+   *   return frame;
+   * });
+   * await resampler.convertFrames(frames, pool);
+   * ```
+   *
+   * @see {@link convertFrame} For single frame conversion
+   */
+  async convertFrames(inFrames: (Frame | null)[], outFrames?: Frame[]): Promise<Frame[]> {
+    let outputs = outFrames;
+    if (!outputs) {
+      outputs = inFrames.map(() => {
+        const frame = new Frame();
+        frame.alloc();
+        return frame;
+      });
+    } else if (outputs.length < inFrames.length) {
+      throw new RangeError(`Expected ${inFrames.length} output frames, got ${outputs.length}`);
+    }
+
+    const ret = await this.native.convertFrames(
+      outputs.map((frame) => frame.getNative()),
+      inFrames.map((frame) => frame?.getNative() ?? null),
+    );
+    FFmpegError.throwIfError(ret, 'Failed to convert frames');
+    return outputs.slice(0, inFrames.length);
   }
 
   /**
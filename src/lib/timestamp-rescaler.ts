@@ -0,0 +1,123 @@
+import { AV_ROUND_NEAR_INF } from '../constants/constants.js';
+import { bindings } from './binding.js';
+
+import type { NativeTimestampRescaler, NativeWrapper } from './native-types.js';
+import type { IRational } from './types.js';
+
+/**
+ * Timestamp rescaler bound to a source and destination time base.
+ *
+ * {@link avRescaleQ} reads `num` and `den` of both time base objects on every
+ * call. A rescaler computes the conversion factors once, so per-packet calls
+ * only pass the timestamp. Results are identical to `avRescaleQRnd()` with
+ * the same rounding.
+ *
+ * {@link rescaleArray} converts a whole BigInt64Array in one native call.
+ *
+ * @example
+ * ```typescript
+ * import { TimestampRescaler } from 'node-av/lib';
+ *
+ * const toMs = TimestampRescaler.create(stream.timeBase, { num: 1, den: 1000 });
+ * for await (const packet of input.packets(stream.index)) {
+ *   console.log(`${toMs.rescale(packet.pts)} ms`);
+ * }
+ *
+ * // Batch
+ * const pts = BigInt64Array.from(packets, (p) => p.pts);
+ * toMs.rescaleArray(pts); // in place
+ * ```
+ *
+ * @see {@link avRescaleQBatch} For one-off batch conversion
+ */
+export class TimestampRescaler implements NativeWrapper<NativeTimestampRescaler> {
+  private native: NativeTimestampRescaler;
+
+  /** Source time base */
+  readonly src: IRational;
+
+  /** Destination time base */
+  readonly dst: IRational;
+
+  /** Rounding mode (AVRounding, optionally with AV_ROUND_PASS_MINMAX) */
+  readonly rnd: number;
+
+  private constructor(native: NativeTimestampRescaler, src: IRational, dst: IRational, rnd: number) {
+    this.native = native;
+    this.src = { num: src.num, den: src.den };
+    this.dst = { num: dst.num, den: dst.den };
+    this.rnd = rnd;
+  }
+
+  /**
+   * Create a rescaler.
+   *
+   * @param src - Source time base
+   *
+   * @param dst - Destination time base
+   *
+   * @param rnd - Rounding mode (default: AV_ROUND_NEAR_INF, like av_rescale_q())
+   *
+   * @returns Rescaler
+   *
+   * @example
+   * ```typescript
+   * const toUs = TimestampRescaler.create(packet.timeBase, AV_TIME_BASE_Q, AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX);
+   * ```
+   */
+  static create(src: IRational, dst: IRational, rnd: number = AV_ROUND_NEAR_INF): TimestampRescaler {
+    return new TimestampRescaler(bindings.TimestampRescaler.create(src, dst, rnd), src, dst, rnd);
+  }
+
+  /**
+   * Check whether the rescaler converts between the given time bases.
+   *
+   * Lets callers keep one rescaler and only recreate it when a time base changes.
+   *
+   * @param src - Source time base
+   *
+   * @param dst - Destination time base
+   *
+   * @returns True if both time bases match
+   */
+  matches(src: IRational, dst: IRational): boolean {
+    return src.num === this.src.num && src.den === this.src.den && dst.num === this.dst.num && dst.den === this.dst.den;
+  }
+
+  /**
+   * Rescale a timestamp.
+   *
+   * @param ts - Timestamp in the source time base (null is AV_NOPTS_VALUE)
+   *
+   * @returns Timestamp in the destination time base
+   */
+  rescale(ts: bigint | number | null): bigint {
+    return this.native.rescale(ts);
+  }
+
+  /**
+   * Rescale an array of timestamps.
+   *
+   * @param values - Timestamps in the source time base
+   *
+   * @param out - Output array (default: values, converted in place)
+   *
+   * @returns The output array
+   *
+   * @throws {TypeError} If out is shorter than values
+   */
+  rescaleArray(values: BigInt64Array, out?: BigInt64Array): BigInt64Array {
+    return this.native.rescaleArray(values, out);
+  }
+
+  /**
+   * Get the underlying native TimestampRescaler object.
+   *
+   * @returns Native TimestampRescaler binding object
+   *
+   * @internal
+   */
+  getNative(): NativeTimestampRescaler {
+    return this.native;
+  }
+}
@@ -5,7 +5,7 @@
  * directly from FFmpeg constants.
  */
 
-import type { AVCodecID, AVLogLevel, AVMediaType, AVPixelFormat, AVSampleFormat } from '../constants/constants.ts';
+import type { AVCodecID, AVHWDeviceType, AVLogLevel, AVMediaType, AVPixelFormat, AVSampleFormat } from '../constants/constants.ts';
 
 /**
  * Rational number (fraction) interface
@@ -170,3 +170,495 @@ export interface RTSPStreamInfo {
   direction: 'sendonly' | 'recvonly' | 'sendrecv' | 'inactive';
   fmtp?: string; // FMTP parameters from SDP (e.g., "packetization-mode=1; sprop-parameter-sets=...")
 }
+
+/**
+ * RTSP talkback options
+ * Used by RTSPTalkback.create(); outbound codec parameters come from the backchannel SDP
+ */
+export interface RTSPTalkbackOptions {
+  inputPayloadType?: number; // Only accept this inbound Opus payload type (default: any)
+  inputChannels?: 1 | 2; // Opus decoder output channels (default: 2)
+  payloadType?: number; // Outbound payload type (default: from SDP)
+  ssrc?: number; // Outbound SSRC (default: random)
+  packetDuration?: number; // Packet duration in ms for PCM codecs (default: 20)
+  bitrate?: number; // Encoder bitrate for AAC (default: encoder default)
+  maxQueuePackets?: number; // Inbound queue depth, oldest packets are dropped (default: 64)
+}
+
+/**
+ * RTSP talkback statistics
+ * Returned by RTSPTalkback.getStats()
+ */
+export interface RTSPTalkbackStats {
+  receivedPackets: number; // Packets accepted by push()
+  queuedPackets: number; // Packets waiting for the engine thread
+  droppedPackets: number; // Packets dropped because the queue was full
+  ignoredPackets: number; // Non-RTP, RTCP, foreign payload type or empty packets
+  latePackets: number; // Out-of-order packets (dropped)
+  lostPackets: number; // Sequence number gaps
+  decodedFrames: number; // Opus frames decoded
+  encodedPackets: number; // Backchannel codec packets produced
+  sentPackets: number; // RTP packets sent on the backchannel
+  sentBytes: number; // RTP bytes sent on the backchannel
+  sendErrors: number; // Failed backchannel sends
+  errors: number; // Decode/resample/encode failures
+  lastError: number; // Last negative AVERROR code (0 if none)
+}
+
+/**
+ * Native pipeline stage kind
+ * Input/output: bsf packet -> packet, decoder packet -> frame, encoder frame -> packet, filter frame -> frame
+ */
+export type PipelineStageKind = 'bsf' | 'decoder' | 'encoder' | 'filter';
+
+/**
+ * Native pipeline stage options
+ * Used by PipelineStage.create()
+ */
+export interface PipelineStageOptions {
+  queueSize?: number; // Input and output queue capacity in items (default: 16, max: 4096)
+}
+
+/**
+ * Native pipeline stage statistics
+ * Returned by PipelineStage.getStats()
+ */
+export interface PipelineStageStats {
+  inputItems: number; // Packets/frames consumed by the stage thread
+  outputItems: number; // Packets/frames produced
+  inputQueued: number; // Items waiting in the input queue
+  outputQueued: number; // Items waiting to be pulled (tail stage only)
+  inputStalls: number; // Pushes that found the input queue full (backpressure)
+  outputStalls: number; // Times the stage waited for output queue space
+  finished: boolean; // Stage thread has finished (end of stream, error or stop)
+  error: number; // Negative AVERROR code the stage finished with (0 if none)
+}
+
+/**
+ * Real-time packet pacing options
+ * Used by PacketPacer.create() and the Demuxer `pacing` option
+ */
+export interface PacketPacerOptions {
+  speed?: number; // Playback speed relative to real time (default: 1)
+  initialBurst?: number; // Seconds of media released immediately at start and after reset() (default: 0)
+  maxLag?: number; // Seconds behind schedule after which the clock is re-anchored instead of catching up (default: 1)
+  maxJump?: number; // Timestamp jump in seconds treated as a discontinuity (default: 10)
+}
+
+/**
+ * Real-time packet pacing statistics
+ * Returned by PacketPacer.getStats()
+ */
+export interface PacketPacerStats {
+  released: number; // Packets released
+  waited: number; // Packets that had to wait for their release time
+  late: number; // Packets released more than 1ms after their release time
+  maxLateMs: number; // Largest lateness in milliseconds (below maxLag)
+  reanchors: number; // Clock re-anchors (discontinuities and stalls)
+}
+
+/**
+ * Multi-input synchronizer options
+ * Used by InputSynchronizer.create()
+ */
+export interface InputSynchronizerOptions {
+  bufferDuration?: number; // Seconds one stream may run ahead of the others; also how long an ended input holds back the rest (default: 1)
+  maxQueuedPackets?: number; // Packets queued across all inputs before readers wait (default: 8192)
+}
+
+/**
+ * Per-input clock and jitter statistics
+ * Part of InputSynchronizerStats
+ */
+export interface InputClockStats {
+  packets: number; // Packets read
+  clock: 'realtime' | 'arrival' | 'none'; // Timeline anchor: source wall clock (RTCP NTP), first packet arrival, or not anchored yet
+  offsetMs: number; // Offset added to input timestamps to place them on the timeline
+  jitterMs: number; // Interarrival jitter (RFC 3550), largest over the input's streams
+  maxJitterMs: number; // Largest jitter seen
+  eof: boolean; // Input has ended
+  error: number; // Negative AVERROR code the input ended with (0 if none)
+}
+
+/**
+ * Multi-input synchronizer statistics
+ * Returned by InputSynchronizer.getStats()
+ */
+export interface InputSynchronizerStats {
+  inputs: InputClockStats[]; // In input order
+  queued: number; // Packets waiting in the sync queue
+}
+
+/**
+ * Native RTP sink options
+ * Header rewrites and batching applied by IOContext.allocContextRtpSink()
+ */
+export interface RTPSinkOptions {
+  ssrc?: number; // Rewrite SSRC
+  payloadType?: number; // Rewrite payload type (marker bit is preserved)
+  sequenceNumber?: number; // Initial sequence number (always rewritten to be continuous)
+  timestamp?: number; // Initial RTP timestamp (muxer timestamps are rebased onto it)
+  timestampIncrement?: number; // Synthesize timestamps, advanced on every marker bit (e.g. 90000 / fps)
+  maxBatchPackets?: number; // Maximum datagrams per batch (default: 32)
+  flushOnMarker?: boolean; // Deliver the batch when a packet carries the marker bit (default: true)
+  udp?: RTPSinkUdpOptions; // Send datagrams natively instead of delivering them to JS
+}
+
+/**
+ * Native UDP destination for the RTP sink
+ * Datagrams are sent from a native thread (sendmmsg on Linux) with optional token-bucket pacing
+ */
+export interface RTPSinkUdpOptions {
+  address: string; // Numeric IPv4/IPv6 address
+  port: number;
+  pacingBitrate?: number; // Token-bucket rate in bits per second (default: unpaced)
+  burstBytes?: number; // Token-bucket depth in bytes (default: 20ms at pacingBitrate)
+  maxQueuePackets?: number; // Queued datagrams before batches are dropped (default: 1024)
+  maxBatchDatagrams?: number; // Datagrams per sendmmsg() call, 1 to 64 (default: 32)
+  sendBufferSize?: number; // SO_SNDBUF in bytes (default: system default)
+}
+
+/**
+ * Native RTP sink statistics
+ * Maps to the counters returned by IOContext.getRtpSinkStats()
+ */
+export interface RTPSinkStats {
+  packets: number;
+  bytes: number;
+  batches: number;
+  rtcpDropped: number;
+  invalidDropped: number;
+  udp?: RTPSinkUdpStats; // Only present with a native UDP destination
+}
+
+/**
+ * Native UDP sender statistics
+ */
+export interface RTPSinkUdpStats {
+  sentPackets: number;
+  sentBytes: number;
+  droppedPackets: number; // Queue overflow and send errors
+  sendErrors: number;
+  syscalls: number;
+  pacedWaits: number;
+  queuedPackets: number;
+}
+
+/**
+ * Result of a fragmented MP4 to faststart MP4 conversion
+ */
+export interface Mp4DefragmentResult {
+  tracks: number;
+  fragments: number; // moof boxes read
+  samples: number;
+  bytes: number; // Output file size
+}
+
+/**
+ * Hardware codec bound to a device type
+ */
+export interface HardwareCodecCapability {
+  name: string; // Codec name (e.g. 'h264_nvenc', or 'h264' for hwaccel decoders)
+  codecId: AVCodecID;
+  pixelFormats: AVPixelFormat[]; // Decoders: hardware output formats; encoders: accepted input formats
+}
+
+/**
+ * Capabilities of one hardware device type
+ * Returned by HardwareDeviceContext.probeCapabilities()
+ */
+export interface HardwareDeviceCapability {
+  type: string; // Device type name (e.g. 'cuda')
+  deviceType: AVHWDeviceType;
+  available: boolean; // Device could be created
+  error: number; // av_hwdevice_ctx_create() result (0 if not opened)
+  hwFormats: AVPixelFormat[]; // Frame constraints, empty if unavailable
+  swFormats: AVPixelFormat[];
+  maxWidth: number;
+  maxHeight: number;
+  decoders: HardwareCodecCapability[];
+  encoders: HardwareCodecCapability[];
+}
+
+/**
+ * Codec entry of the registry snapshot
+ */
+export interface RegistryCodecInfo {
+  name: string;
+  longName: string | null;
+  id: AVCodecID;
+  type: AVMediaType;
+  isEncoder: boolean;
+  capabilities: number; // AV_CODEC_CAP_* flags
+  wrapper: string | null; // External library (e.g. 'libx264'), null for native codecs
+  hwDeviceTypes: AVHWDeviceType[]; // Device types usable via device or frames context
+}
+
+/**
+ * Filter entry of the registry snapshot
+ */
+export interface RegistryFilterInfo {
+  name: string;
+  description: string | null;
+  flags: number; // AVFILTER_FLAG_* flags
+  inputs: number; // Static pads (dynamic pads are flagged)
+  outputs: number;
+}
+
+/**
+ * Demuxer entry of the registry snapshot
+ */
+export interface RegistryDemuxerInfo {
+  name: string; // Comma separated names (e.g. 'mov,mp4,m4a,3gp,3g2,mj2')
+  longName: string | null;
+  extensions: string | null;
+  mimeType: string | null;
+  flags: number; // AVFMT_* flags
+}
+
+/**
+ * Muxer entry of the registry snapshot
+ */
+export interface RegistryMuxerInfo extends RegistryDemuxerInfo {
+  audioCodec: AVCodecID; // Default codecs
+  videoCodec: AVCodecID;
+  subtitleCodec: AVCodecID;
+}
+
+/**
+ * Snapshot of the codec, filter and format registries
+ * Array positions are the registry indexes used by Registry lookups
+ */
+export interface RegistrySnapshot {
+  codecs: RegistryCodecInfo[];
+  filters: RegistryFilterInfo[];
+  demuxers: RegistryDemuxerInfo[];
+  muxers: RegistryMuxerInfo[];
+}
+
+/**
+ * Native memory held by one owner class
+ */
+export interface MemoryAccountingCounter {
+  objects: number; // Live tracked objects (allocated packets/frames, open I/O contexts, graphs)
+  bytes: number; // Referenced buffer bytes (shared buffers count once per wrapper)
+  peakBytes: number; // High-water mark since start or the last reset
+}
+
+/**
+ * Native memory accounting snapshot
+ * Returned by getMemoryAccounting()
+ */
+export interface MemoryAccountingSnapshot extends MemoryAccountingCounter {
+  enabled: boolean;
+  owners: {
+    packet: MemoryAccountingCounter;
+    frame: MemoryAccountingCounter;
+    frameUtils: MemoryAccountingCounter; // Input frame and frame pool
+    ioContext: MemoryAccountingCounter; // I/O buffers
+    filterGraph: MemoryAccountingCounter; // Object counts only
+  };
+}
+
+/**
+ * Allocation site of leaked Packet/Frame wrappers
+ */
+export interface LeakSite {
+  kind: 'Packet' | 'Frame';
+  stack: string; // Stack trace of the alloc()/clone() call
+  allocated: number;
+  freed: number; // Explicit free()/dispose
+  leaked: number; // Finalized by the GC without free()
+  leakedBytes: number; // Buffer bytes held by the leaked objects until GC
+}
+
+/**
+ * Leak detection report
+ * Returned by getLeakReport()
+ */
+export interface LeakReport {
+  enabled: boolean;
+  allocated: number;
+  freed: number;
+  leaked: number;
+  leakedBytes: number;
+  sites: LeakSite[]; // Sorted by leaked count
+}
+
+/**
+ * Image encoder pool options
+ * Used by ImageEncoder.create()
+ */
+export interface ImageEncoderOptions {
+  maxContexts?: number; // Idle encoder contexts kept warm, least recently used are closed first (default: 16)
+  threads?: number; // Threads per encoder context, 0 = auto (default: 1, parallelism comes from concurrent encodes)
+}
+
+/**
+ * Still image encoding options
+ * Used by ImageEncoder.encode()
+ */
+export interface ImageEncodeOptions {
+  format?: 'jpeg' | 'png' | 'webp'; // Output image format (default: 'jpeg')
+  width?: number; // Output width (default: source width, or keeps aspect ratio with height)
+  height?: number; // Output height (default: source height, or keeps aspect ratio with width)
+  quality?: number; // 1-100, higher is better (default: encoder default, ignored for PNG)
+}
+
+/**
+ * Image encoder pool statistics
+ * Returned by ImageEncoder.getStats()
+ */
+export interface ImageEncoderStats {
+  idle: number; // Warm encoder contexts in the pool
+  inUse: number; // Encoder contexts checked out by running encodes
+  encoded: number; // Images encoded
+  hits: number; // Encodes that reused a warm context
+  misses: number; // Encodes that opened a new context
+  evictions: number; // Idle contexts closed because the pool was full
+}
+
+/**
+ * Inline dispatch options
+ * Used by setInlineDispatch()
+ */
+export interface InlineDispatchOptions {
+  enabled?: boolean; // Run cheap async operations inline (default: true)
+  maxBytes?: number; // Largest estimated copy in bytes that runs inline (default: 65536)
+  resetStats?: boolean; // Reset the inline/offloaded counters
+}
+
+/**
+ * Inline vs threadpool dispatch counters of one operation class
+ */
+export interface InlineDispatchCounters {
+  inline: number; // Ran on the calling thread, promise already settled
+  offloaded: number; // Queued on the libuv threadpool
+}
+
+/**
+ * Inline dispatch statistics
+ * Returned by getInlineDispatchStats()
+ */
+export interface InlineDispatchStats {
+  enabled: boolean;
+  maxBytes: number;
+  audioFifo: InlineDispatchCounters; // AudioFifo write/read/peek
+  fifo: InlineDispatchCounters; // Fifo write/read/peek
+  bitstreamFilter: InlineDispatchCounters; // BitStreamFilterContext sendPacket/receivePacket
+}
+
+/**
+ * Audio mixer options
+ * Used by AudioMixer.create()
+ */
+export interface AudioMixerOptions {
+  sampleRate?: number; // Sample rate of inputs and output (default: 48000)
+  channelLayout?: ChannelLayout; // Channel layout of the output; inputs must have as many channels (default: stereo)
+  sampleFormat?: AVSampleFormat; // Output sample format: FLT, FLTP, S16 or S16P (default: FLTP)
+  frameSize?: number; // Samples per output frame (default: 1024)
+  latePolicy?: 'zero' | 'wait'; // Late inputs are zero-filled when the frame is due, or waited for up to maxWait (default: 'zero')
+  maxWait?: number; // Milliseconds to wait for late inputs with latePolicy 'wait' (default: 100)
+  maxBuffered?: number; // Milliseconds buffered per input before the oldest samples are dropped (default: 500)
+  softClip?: boolean; // Soft clip the mix above 0.8 full scale instead of letting it overshoot (default: true)
+}
+
+/**
+ * Audio mixer input options
+ * Used by AudioMixer.addInput()
+ */
+export interface AudioMixerInputOptions {
+  gain?: number; // Linear gain (default: 1)
+  muted?: boolean; // Input is consumed but not mixed (default: false)
+}
+
+/**
+ * Per-input audio mixer statistics
+ * Part of AudioMixerStats
+ */
+export interface AudioMixerInputStats {
+  index: number; // Input index
+  buffered: number; // Samples per channel waiting to be mixed
+  gain: number;
+  muted: boolean;
+  ended: boolean; // write(input, null) was called
+  lateFrames: number; // Output frames this input was zero-filled in
+  lateDropped: number; // Samples dropped after being late, to stay aligned with the other inputs
+  overrunDropped: number; // Oldest samples dropped because more than maxBuffered was buffered
+}
+
+/**
+ * Audio mixer statistics
+ * Returned by AudioMixer.getStats()
+ */
+export interface AudioMixerStats {
+  frames: number; // Output frames mixed
+  lateFrames: number; // Output frames with at least one zero-filled input
+  inputs: AudioMixerInputStats[]; // In input order
+}
+
+/**
+ * Loudness meter options
+ * Used by LoudnessMeter.create()
+ */
+export interface LoudnessMeterOptions {
+  truePeak?: boolean; // Measure true peak by 4x oversampling (default: true)
+}
+
+/**
+ * Level of one channel
+ * Part of LoudnessResult
+ */
+export interface ChannelLevel {
+  rms: number; // RMS over the last 400 ms in dBFS
+  samplePeak: number; // Largest sample since creation or resetPeaks() in dBFS
+  truePeak: number; // Largest interpolated sample in dBTP (NaN if disabled)
+}
+
+/**
+ * Loudness measurement
+ * Returned by LoudnessMeter.getResult()
+ */
+export interface LoudnessResult {
+  momentary: number; // Loudness over the last 400 ms in LUFS
+  shortTerm: number; // Loudness over the last 3 s in LUFS
+  integrated: number; // Gated loudness since creation or reset() in LUFS
+  range: number; // Loudness range (LRA) in LU
+  samplePeak: number; // Largest sample peak over all channels in dBFS
+  truePeak: number; // Largest true peak over all channels in dBTP (NaN if disabled)
+  channels: ChannelLevel[]; // In channel order
+}
+
+/**
+ * Voice activity detector options
+ * Used by VoiceActivityDetector.create()
+ */
+export interface VoiceActivityDetectorOptions {
+  threshold?: number; // Lowest window level counted as speech in dBFS (default: -50)
+  noiseMargin?: number; // Level above the noise floor counted as speech in dB (default: 10)
+  adaptive?: boolean; // Raise the threshold to noiseMargin above the tracked noise floor (default: true)
+  zeroCrossingRate?: number; // Zero crossings per second of unvoiced speech (default: 5000)
+  hangover?: number; // Silence in ms before a segment ends (default: 300)
+  minSpeech?: number; // Speech in ms before a segment starts (default: 100)
+  flagFrames?: boolean; // Set 'vad.speech' frame metadata to '1' or '0' (default: false)
+}
+
+/**
+ * Detected speech segment
+ * Returned by VoiceActivityDetector.takeSegments()
+ */
+export interface SpeechSegment {
+  start: number; // Start in ms
+  end: number; // End of the last speech window in ms (excluding the hangover)
+}
+
+/**
+ * Voice activity detector statistics
+ * Returned by VoiceActivityDetector.getStats()
+ */
+export interface VoiceActivityStats {
+  duration: number; // Audio analyzed in ms
+  speechDuration: number; // Audio in speech segments in ms
+  segments: number; // Segments detected, including an open one
+  noiseFloor: number; // Tracked noise floor in dBFS
+}
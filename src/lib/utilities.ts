@@ -6,7 +6,15 @@ import type { AVCodecID, AVHWDeviceType, AVMediaType, AVPixelFormat, AVSampleFor
 import type { FFHWDeviceType } from '../constants/hardware.js';
 import type { FormatContext } from './format-context.js';
 import type { NativeCodecParameters, NativePacket, NativeStream, NativeWrapper } from './native-types.js';
-import type { ChannelLayout, DtsPredictState, IRational } from './types.js';
+import type {
+  ChannelLayout,
+  DtsPredictState,
+  InlineDispatchOptions,
+  InlineDispatchStats,
+  IRational,
+  MemoryAccountingSnapshot,
+  Mp4DefragmentResult,
+} from './types.js';
 
 /**
  * Get FFmpeg library information.
@@ -1056,6 +1064,37 @@ export function avRescaleQRnd(a: bigint | number | null, bq: IRational, cq: IRat
   return bindings.avRescaleQRnd(a, bq, cq, rnd);
 }
 
+/**
+ * Rescale an array of timestamps.
+ *
+ * Applies av_rescale_q_rnd() to every element in one native call, with the
+ * time bases read once instead of per timestamp.
+ *
+ * @param values - Timestamps in the source time base
+ *
+ * @param bq - Source time base
+ *
+ * @param cq - Destination time base
+ *
+ * @param rnd - Rounding mode (default: AV_ROUND_NEAR_INF, like av_rescale_q())
+ *
+ * @param out - Output array (default: values, converted in place)
+ *
+ * @returns The output array
+ *
+ * @example
+ * ```typescript
+ * const pts = BigInt64Array.of(0n, 3000n, 6000n);
+ * avRescaleQBatch(pts, { num: 1, den: 90000 }, { num: 1, den: 1000 });
+ * // pts is now [0n, 33n, 67n]
+ * ```
+ *
+ * @see {@link TimestampRescaler} For repeated conversions between the same time bases
+ */
+export function avRescaleQBatch(values: BigInt64Array, bq: IRational, cq: IRational, rnd?: number, out?: BigInt64Array): BigInt64Array {
+  return bindings.avRescaleQBatch(values, bq, cq, rnd, out);
+}
+
 /**
  * Get the duration of a single audio frame in samples.
  *
@@ -1332,6 +1371,219 @@ export function dtsPredict(packet: NativeWrapper<NativePacket>, stream: NativeWr
   return bindings.dtsPredict(packet.getNative(), stream.getNative(), state);
 }
 
+/**
+ * Convert a fragmented MP4 into a regular MP4 with the moov in front.
+ *
+ * Single pass over the input: only the moov and moof boxes are parsed, the
+ * sample tables are rebuilt from the fragment runs and the media data is
+ * copied behind the new moov (with copy_file_range() on Linux). Use it to
+ * finalize recordings written with `frag_keyframe+empty_moov`, which stay
+ * playable if the process dies while recording.
+ *
+ * The input must be a complete or truncated fragmented MP4 written with one
+ * moov (e.g. by FFmpeg's mp4/mov muxer); a truncated last fragment is dropped.
+ *
+ * @param input - Fragmented MP4 path
+ *
+ * @param output - Output path (overwritten)
+ *
+ * @param onProgress - Called with the copied fraction of the media data (0..1)
+ *
+ * @returns Number of tracks, fragments, samples and output size
+ *
+ * @throws {Error} If the input is not a fragmented MP4 or on I/O errors
+ *
+ * @example
+ * ```typescript
+ * await mp4Defragment('recording.mp4.part', 'recording.mp4', (p) => {
+ *   console.log(`finalize ${(p * 100).toFixed(0)}%`);
+ * });
+ * ```
+ *
+ * @see {@link mp4DefragmentSync} For synchronous version
+ */
+export async function mp4Defragment(input: string, output: string, onProgress?: (progress: number) => void): Promise<Mp4DefragmentResult> {
+  return await bindings.mp4Defragment(input, output, onProgress);
+}
+
+/**
+ * Convert a fragmented MP4 into a regular MP4 with the moov in front.
+ * Synchronous version of mp4Defragment.
+ *
+ * @param input - Fragmented MP4 path
+ *
+ * @param output - Output path (overwritten)
+ *
+ * @returns Number of tracks, fragments, samples and output size
+ *
+ * @throws {Error} If the input is not a fragmented MP4 or on I/O errors
+ *
+ * @example
+ * ```typescript
+ * mp4DefragmentSync('recording.mp4.part', 'recording.mp4');
+ * ```
+ *
+ * @see {@link mp4Defragment} For async version
+ */
+export function mp4DefragmentSync(input: string, output: string): Mp4DefragmentResult {
+  return bindings.mp4DefragmentSync(input, output);
+}
+
+/**
+ * Enable or disable native memory accounting.
+ *
+ * While enabled, Packet, Frame, FrameUtils, IOContext and FilterGraph
+ * wrappers measure the FFmpeg buffers they hold whenever they are allocated,
+ * filled (read, decode, filter), referenced or freed. The bytes are summed
+ * per owner class and reported to V8 as external memory, so garbage
+ * collection sees the native memory kept alive by unreleased wrappers.
+ *
+ * Disabled by default. Objects join the accounting at their next update
+ * after it was enabled; disabling stops new objects from joining while
+ * already tracked ones stay counted until they are freed.
+ *
+ * @param enabled - Enable accounting
+ *
+ * @example
+ * ```typescript
+ * import { getMemoryAccounting, setMemoryAccounting } from 'node-av/lib';
+ *
+ * setMemoryAccounting(true);
+ * // ... run the pipeline
+ * const { owners } = getMemoryAccounting();
+ * console.log(`${owners.packet.objects} packets hold ${owners.packet.bytes} bytes`);
+ * ```
+ *
+ * @see {@link getMemoryAccounting} For the counters
+ */
+export function setMemoryAccounting(enabled: boolean): void {
+  bindings.setMemoryAccounting(enabled);
+}
+
+/**
+ * Get the native memory accounting counters.
+ *
+ * Live objects, bytes and high-water mark in total and per owner class.
+ * Counters are process-wide and include all worker threads. A steadily
+ * growing `owners.packet.objects` usually means packets (or clones) that
+ * are never freed.
+ *
+ * @returns Accounting snapshot
+ *
+ * @see {@link setMemoryAccounting} To enable accounting
+ * @see {@link resetMemoryAccountingPeak} To restart the high-water marks
+ */
+export function getMemoryAccounting(): MemoryAccountingSnapshot {
+  return bindings.getMemoryAccounting();
+}
+
+/**
+ * Reset the memory accounting high-water marks to the current bytes.
+ *
+ * @example
+ * ```typescript
+ * resetMemoryAccountingPeak();
+ * await transcodeSegment();
+ * console.log('segment peak:', getMemoryAccounting().peakBytes);
+ * ```
+ */
+export function resetMemoryAccountingPeak(): void {
+  bindings.resetMemoryAccountingPeak();
+}
+
+/**
+ * Enable or disable native tracing.
+ *
+ * While enabled, every async operation records how long its native part ran
+ * on the thread pool (event per AsyncWorker, e.g. `CCSendPacketWorker`), and
+ * the key FFmpeg calls `av_read_frame`, `avcodec_send_packet`,
+ * `av_interleaved_write_frame` and `sws_scale_frame` are timed in sync,
+ * async and native-thread code paths. Each event carries the native object
+ * address and the recording thread.
+ *
+ * Events go to a lock-free ring buffer per thread; when a ring is full,
+ * further events of that thread are dropped until the next export.
+ *
+ * @param enabled - Enable tracing
+ *
+ * @param bufferEvents - Ring capacity in events for threads that record their first event afterwards (default: 32768)
+ *
+ * @example
+ * ```typescript
+ * import { writeFileSync } from 'node:fs';
+ * import { exportNativeTrace, setNativeTracing } from 'node-av/lib';
+ *
+ * setNativeTracing(true);
+ * // ... run the pipeline
+ * setNativeTracing(false);
+ * writeFileSync('native-trace.json', exportNativeTrace());
+ * ```
+ *
+ * @see {@link exportNativeTrace} To collect the events
+ */
+export function setNativeTracing(enabled: boolean, bufferEvents?: number): void {
+  bindings.setNativeTracing(enabled, bufferEvents);
+}
+
+/**
+ * Export the recorded native trace events as Chrome trace JSON.
+ *
+ * Drains the per-thread buffers, so every event is exported once.
+ * The result loads in chrome://tracing, Perfetto and the DevTools
+ * performance panel. Timestamps use the same monotonic clock as
+ * `node --cpu-prof`, so native activity can be lined up with JS samples.
+ * `otherData.droppedEvents` counts events lost to full buffers.
+ *
+ * @returns Trace JSON (`{ traceEvents: [...] }`)
+ *
+ * @see {@link setNativeTracing} To enable tracing
+ */
+export function exportNativeTrace(): string {
+  return bindings.exportNativeTrace();
+}
+
+/**
+ * Configure inline dispatch of cheap async operations.
+ *
+ * `AudioFifo.write/read/peek`, `Fifo.write/read/peek` and
+ * `BitStreamFilterContext.sendPacket/receivePacket` run on the calling
+ * thread and return an already resolved promise when their estimated cost
+ * (bytes copied) is at most `maxBytes`; larger operations go to the libuv
+ * threadpool as before. A threadpool round trip costs tens of microseconds,
+ * far more than copying a few kilobytes. `receivePacket` only runs inline
+ * for filters that at most copy the packet (e.g. `null`, `h264_mp4toannexb`,
+ * `aac_adtstoasc`). Enabled by default.
+ *
+ * @param options - Enable flag, byte threshold and counter reset
+ *
+ * @throws {RangeError} If maxBytes is negative
+ *
+ * @example
+ * ```typescript
+ * import { getInlineDispatchStats, setInlineDispatch } from 'node-av/lib';
+ *
+ * setInlineDispatch({ maxBytes: 16384, resetStats: true });
+ * // ... run the pipeline
+ * console.log(getInlineDispatchStats().audioFifo);
+ * ```
+ *
+ * @see {@link getInlineDispatchStats} For the counters
+ */
+export function setInlineDispatch(options: InlineDispatchOptions): void {
+  bindings.setInlineDispatch(options);
+}
+
+/**
+ * Get inline vs threadpool dispatch counters.
+ *
+ * @returns Settings and per operation class counters
+ *
+ * @see {@link setInlineDispatch} To configure the threshold
+ */
+export function getInlineDispatchStats(): InlineDispatchStats {
+  return bindings.getInlineDispatchStats();
+}
+
 /**
  * Convert string to FourCC.
  *
@@ -0,0 +1,176 @@
+import { bindings } from './binding.js';
+
+import type { Frame } from './frame.js';
+import type { NativeVoiceActivityDetector, NativeWrapper } from './native-types.js';
+import type { SpeechSegment, VoiceActivityDetectorOptions, VoiceActivityStats } from './types.js';
+
+/**
+ * Voice activity detector based on energy and zero-crossing rate.
+ *
+ * A cheap speech/silence classifier for audio frames of any sample format and
+ * layout, meant to run before expensive stages such as speech recognition.
+ * Frames are mixed down to mono and analyzed in 20 ms windows:
+ *
+ * - A window is voiced when its level is above `threshold`, or above the
+ *   tracked noise floor plus `noiseMargin` if that is higher (`adaptive`).
+ * - Quieter windows (up to 10 dB below) with a high zero-crossing rate are
+ *   unvoiced speech such as fricatives. They extend the start and end of a
+ *   segment but never start one.
+ * - A segment starts after `minSpeech` ms of voiced windows and ends after
+ *   `hangover` ms without them.
+ *
+ * Segment times are in milliseconds, taken from the frame timestamps when set
+ * and counted from the samples otherwise.
+ *
+ * No model is needed and the cost is a few operations per sample. For a
+ * neural VAD inside the whisper filter, see the `vadModel` option of
+ * WhisperTranscriber.
+ *
+ * @example
+ * ```typescript
+ * import { VoiceActivityDetector } from 'node-av';
+ *
+ * const vad = VoiceActivityDetector.create({ hangover: 500 });
+ *
+ * for await (using frame of decoder.frames(input.packets(stream.index))) {
+ *   if (frame && vad.process(frame) === 1) {
+ *     await transcribe(frame);
+ *   }
+ * }
+ *
+ * vad.flush();
+ * for (const { start, end } of vad.takeSegments()) {
+ *   console.log(`Speech ${start}ms - ${end}ms`);
+ * }
+ * ```
+ */
+export class VoiceActivityDetector implements NativeWrapper<NativeVoiceActivityDetector> {
+  private native: NativeVoiceActivityDetector;
+
+  private constructor(native: NativeVoiceActivityDetector) {
+    this.native = native;
+  }
+
+  /**
+   * Create a voice activity detector.
+   *
+   * @param options - Thresholds and timing
+   *
+   * @returns Detector
+   *
+   * @example
+   * ```typescript
+   * // Fixed threshold for a clean studio feed
+   * const vad = VoiceActivityDetector.create({ threshold: -40, adaptive: false });
+   * ```
+   */
+  static create(options?: VoiceActivityDetectorOptions): VoiceActivityDetector {
+    return new VoiceActivityDetector(bindings.VoiceActivityDetector.create(options));
+  }
+
+  /**
+   * Whether a speech segment is open.
+   */
+  get speaking(): boolean {
+    return this.native.speaking;
+  }
+
+  /**
+   * Analyze an audio frame.
+   *
+   * The frame is only read, unless `flagFrames` is set. In that case its
+   * 'vad.speech' metadata is set to '1' or '0'.
+   *
+   * A frame is speech if a segment is open at any point during it. The
+   * `minSpeech` ms before a segment starts are reported as silence, because
+   * they are only known to be speech afterwards.
+   *
+   * @param frame - Audio frame (U8, S16, S32, S64, FLT or DBL, packed or planar)
+   *
+   * @returns 1 for speech, 0 for silence, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Frame has no samples or an unsupported sample format
+   *
+   * @example
+   * ```typescript
+   * const ret = vad.process(frame);
+   * FFmpegError.throwIfError(ret, 'process');
+   * if (ret === 0) {
+   *   frame.free();
+   * }
+   * ```
+   */
+  process(frame: Frame): number {
+    return this.native.process(frame.getNative());
+  }
+
+  /**
+   * Take the segments that ended since the last call.
+   *
+   * @returns Ended segments in order
+   *
+   * @example
+   * ```typescript
+   * for (const segment of vad.takeSegments()) {
+   *   console.log(`${segment.start}ms - ${segment.end}ms`);
+   * }
+   * ```
+   */
+  takeSegments(): SpeechSegment[] {
+    return this.native.takeSegments();
+  }
+
+  /**
+   * End the open segment at end of stream.
+   *
+   * Without this, the last segment ends only after the hangover, which never
+   * comes at end of stream.
+   *
+   * @example
+   * ```typescript
+   * vad.flush();
+   * const segments = vad.takeSegments();
+   * ```
+   */
+  flush(): void {
+    this.native.flush();
+  }
+
+  /**
+   * Reset detection state, noise floor, segments and statistics.
+   *
+   * @example
+   * ```typescript
+   * // Next recording
+   * vad.reset();
+   * ```
+   */
+  reset(): void {
+    this.native.reset();
+  }
+
+  /**
+   * Get detection statistics.
+   *
+   * @returns Analyzed and speech duration, segment count and noise floor
+   *
+   * @example
+   * ```typescript
+   * const { duration, speechDuration } = vad.getStats();
+   * console.log(`${((100 * speechDuration) / duration).toFixed(0)}% speech`);
+   * ```
+   */
+  getStats(): VoiceActivityStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native VoiceActivityDetector object.
+   *
+   * @returns The native VoiceActivityDetector binding object
+   *
+   * @internal
+   */
+  getNative(): NativeVoiceActivityDetector {
+    return this.native;
+  }
+}
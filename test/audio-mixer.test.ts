@@ -0,0 +1,186 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { AudioMixer, AV_CHANNEL_LAYOUT_STEREO, AV_SAMPLE_FMT_FLT, AVERROR_EAGAIN, AVERROR_EINVAL, AVERROR_EOF, Frame, Rational } from '../src/index.js';
+
+// Interleaved stereo float frame with a constant value
+function createFrame(value: number, nbSamples: number, sampleRate = 48000): Frame {
+  const samples = Buffer.alloc(nbSamples * 2 * 4);
+  for (let i = 0; i < nbSamples * 2; i++) {
+    samples.writeFloatLE(value, i * 4);
+  }
+  return Frame.fromAudioBuffer(samples, {
+    nbSamples,
+    format: AV_SAMPLE_FMT_FLT,
+    sampleRate,
+    channelLayout: AV_CHANNEL_LAYOUT_STEREO,
+  });
+}
+
+function sampleAt(frame: Frame, index: number): number {
+  return frame.toBuffer().readFloatLE(index * 2 * 4);
+}
+
+function createOutput(): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  return frame;
+}
+
+describe('AudioMixer', () => {
+  it('should mix inputs with gain', () => {
+    // Empty inputs are waited for, so the next frame is not due for seconds
+    using mixer = AudioMixer.create({ sampleFormat: AV_SAMPLE_FMT_FLT, latePolicy: 'wait', maxWait: 10000 });
+    const a = mixer.addInput();
+    const b = mixer.addInput({ gain: 0.5 });
+
+    using frameA = createFrame(0.25, 1024);
+    using frameB = createFrame(0.5, 1024);
+    assert.equal(mixer.write(a, frameA), 0);
+    assert.equal(mixer.write(b, frameB), 0);
+
+    using out = createOutput();
+    assert.equal(mixer.receive(out), 0, 'All inputs have a full frame');
+    assert.equal(out.nbSamples, 1024);
+    assert.equal(out.sampleRate, 48000);
+    assert.equal(out.pts, 0n);
+    assert.ok(Math.abs(sampleAt(out, 100) - 0.5) < 1e-6);
+
+    assert.equal(mixer.receive(out), AVERROR_EAGAIN, 'Next frame is not due yet');
+  });
+
+  it('should mute inputs and soft clip the mix', () => {
+    using mixer = AudioMixer.create({ sampleFormat: AV_SAMPLE_FMT_FLT });
+    const inputs = Array.from({ length: 4 }, () => mixer.addInput());
+
+    using loud = createFrame(0.9, 1024);
+    for (const input of inputs) {
+      mixer.write(input, loud);
+    }
+
+    using out = createOutput();
+    assert.equal(mixer.receive(out), 0);
+    const clipped = sampleAt(out, 0);
+    assert.ok(clipped > 0.9 && clipped <= 1, `Soft clipped sample ${clipped}`);
+
+    // Only the unmuted input at half gain, below the knee: unchanged
+    for (const input of inputs.slice(1)) {
+      mixer.setMuted(input, true);
+      mixer.write(input, loud);
+    }
+    mixer.write(inputs[0], loud);
+    mixer.setGain(inputs[0], 0.5);
+    assert.equal(mixer.receive(out), 0);
+    assert.ok(Math.abs(sampleAt(out, 0) - 0.45) < 1e-6);
+  });
+
+  it('should zero-fill late inputs when the frame is due', async () => {
+    using mixer = AudioMixer.create({ sampleFormat: AV_SAMPLE_FMT_FLT });
+    const a = mixer.addInput();
+    const b = mixer.addInput();
+
+    using frameA = createFrame(0.25, 1024);
+    using partial = createFrame(0.5, 512);
+    mixer.write(a, frameA);
+    mixer.write(b, partial);
+
+    // Mixed when the frame is due; a slow runner may already be past it
+    using out = createOutput();
+    const ret = mixer.receive(out);
+    assert.equal(ret === AVERROR_EAGAIN ? await mixer.receiveAsync(out) : ret, 0);
+    assert.ok(Math.abs(sampleAt(out, 0) - 0.75) < 1e-6);
+    assert.ok(Math.abs(sampleAt(out, 1000) - 0.25) < 1e-6, 'Missing samples are silent');
+
+    let stats = mixer.getStats();
+    assert.equal(stats.lateFrames, 1);
+    assert.equal(stats.inputs[b].lateFrames, 1);
+
+    // The samples standing in for the zero-filled part are dropped
+    using frameB = createFrame(0.5, 1024);
+    mixer.write(b, frameB);
+    stats = mixer.getStats();
+    assert.equal(stats.inputs[b].lateDropped, 512);
+    assert.equal(stats.inputs[b].buffered, 512);
+  });
+
+  it('should not drop samples after a pts gap', async () => {
+    using mixer = AudioMixer.create({ sampleFormat: AV_SAMPLE_FMT_FLT });
+    const a = mixer.addInput();
+    const b = mixer.addInput();
+
+    using frameA = createFrame(0.25, 1024);
+    using partial = createFrame(0.5, 512);
+    partial.pts = 0n;
+    partial.timeBase = new Rational(1, 48000);
+    mixer.write(a, frameA);
+    mixer.write(b, partial);
+
+    using out = createOutput();
+    const ret = mixer.receive(out);
+    assert.equal(ret === AVERROR_EAGAIN ? await mixer.receiveAsync(out) : ret, 0);
+    assert.equal(mixer.getStats().inputs[b].lateFrames, 1);
+
+    // Samples 512-1023 were never sent: the next frame is not shortened
+    using frameB = createFrame(0.5, 1024);
+    frameB.pts = 1024n;
+    frameB.timeBase = new Rational(1, 48000);
+    mixer.write(b, frameB);
+    const stats = mixer.getStats();
+    assert.equal(stats.inputs[b].lateDropped, 0);
+    assert.equal(stats.inputs[b].buffered, 1024);
+  });
+
+  it('should wait for late inputs with the wait policy', async () => {
+    using mixer = AudioMixer.create({ sampleFormat: AV_SAMPLE_FMT_FLT, latePolicy: 'wait', maxWait: 2000 });
+    const a = mixer.addInput();
+    const b = mixer.addInput();
+
+    using frameA = createFrame(0.25, 1024);
+    using partial = createFrame(0.5, 512);
+    mixer.write(a, frameA);
+    mixer.write(b, partial);
+    setTimeout(() => mixer.write(b, partial), 50);
+
+    using out = createOutput();
+    assert.equal(await mixer.receiveAsync(out), 0);
+    assert.ok(Math.abs(sampleAt(out, 1000) - 0.75) < 1e-6, 'Late samples are mixed');
+    assert.equal(mixer.getStats().lateFrames, 0);
+  });
+
+  it('should drain ended inputs', () => {
+    using mixer = AudioMixer.create({ sampleFormat: AV_SAMPLE_FMT_FLT });
+    const a = mixer.addInput();
+
+    using frame = createFrame(0.25, 1500);
+    mixer.write(a, frame);
+    assert.equal(mixer.write(a, null), 0);
+    assert.equal(mixer.write(a, frame), AVERROR_EOF, 'Input has ended');
+
+    using out = createOutput();
+    assert.equal(mixer.receive(out), 0);
+    assert.equal(out.nbSamples, 1024);
+    assert.equal(mixer.receive(out), 0);
+    assert.equal(out.nbSamples, 476);
+    assert.equal(out.pts, 1024n);
+    assert.equal(mixer.receive(out), AVERROR_EOF);
+  });
+
+  it('should reject frames in another format', () => {
+    using mixer = AudioMixer.create({ sampleFormat: AV_SAMPLE_FMT_FLT });
+    const a = mixer.addInput();
+
+    using frame = createFrame(0.25, 1024, 44100);
+    assert.equal(mixer.write(a, frame), AVERROR_EINVAL);
+    assert.throws(() => mixer.write(5, frame), RangeError);
+  });
+
+  it('should end a pending receive on close', async () => {
+    const mixer = AudioMixer.create();
+    mixer.addInput();
+
+    using out = createOutput();
+    const pending = mixer.receiveAsync(out);
+    mixer.close();
+    assert.equal(await pending, AVERROR_EOF);
+  });
+});
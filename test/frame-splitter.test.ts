@@ -0,0 +1,92 @@
+import assert from 'node:assert';
+import { setTimeout as sleep } from 'node:timers/promises';
+import { describe, it } from 'node:test';
+
+import { Decoder, Demuxer, FrameSplitter, pipeline } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+import type { Frame } from '../src/index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+async function collect(branch: AsyncIterable<Frame | null>, delayMs = 0): Promise<bigint[]> {
+  const pts: bigint[] = [];
+  for await (const frame of branch) {
+    if (!frame) continue;
+    pts.push(frame.pts);
+    frame.free();
+    if (delayMs > 0) {
+      await sleep(delayMs);
+    }
+  }
+  return pts;
+}
+
+describe('FrameSplitter', () => {
+  it('should decode once and deliver every frame to lossless branches', async () => {
+    await using media = await Demuxer.open(inputFile);
+    const video = media.video();
+    assert.ok(video);
+    using decoder = await Decoder.create(video);
+
+    await using split = FrameSplitter.create(decoder.frames(media.packets(video.index)));
+    const first = split.branch();
+    const second = split.branch({ queueSize: 4 });
+    assert.equal(split.branchCount, 2);
+
+    const [a, b] = await Promise.all([collect(first), collect(second)]);
+
+    assert.ok(a.length > 0);
+    assert.deepEqual(a, b);
+
+    const stats = split.getStats();
+    assert.equal(stats[0].delivered, a.length);
+    assert.equal(stats[1].delivered, b.length);
+    assert.equal(stats[0].dropped, 0);
+    assert.equal(stats[1].dropped, 0);
+
+    assert.throws(() => split.branch(), /before the splitter is consumed/);
+  });
+
+  it('should not stall fast branches behind a dropping slow branch', async () => {
+    await using media = await Demuxer.open(inputFile);
+    const video = media.video();
+    assert.ok(video);
+    using decoder = await Decoder.create(video);
+
+    await using split = FrameSplitter.create(decoder.frames(media.packets(video.index)));
+    const fast = split.branch();
+    const slow = split.branch({ queueSize: 1, dropPolicy: 'drop-oldest' });
+
+    const [all, sampled] = await Promise.all([collect(fast), collect(slow, 20)]);
+
+    const [fastStats, slowStats] = split.getStats();
+    assert.equal(fastStats.dropped, 0);
+    assert.ok(slowStats.dropped > 0, 'slow branch should drop frames');
+    assert.equal(sampled.length + slowStats.dropped, all.length);
+
+    // Dropping keeps the newest frames, so the slow branch still ends on the last frame
+    assert.equal(sampled[sampled.length - 1], all[all.length - 1]);
+  });
+
+  it('should run as a stage in a named pipeline', async () => {
+    await using media = await Demuxer.open(inputFile);
+    const video = media.video();
+    assert.ok(video);
+    using decoder = await Decoder.create(video);
+
+    // The pipeline attaches the source and continues on its own branch
+    await using split = FrameSplitter.create();
+    const side = split.branch();
+    const { video: main } = pipeline<'video', Frame | null>({ video: media }, { video: [decoder, split] });
+    assert.equal(split.branchCount, 2);
+
+    const [a, b] = await Promise.all([collect(main), collect(side)]);
+
+    assert.ok(a.length > 0);
+    assert.deepEqual(a, b);
+    assert.throws(() => split.frames(side), /already has a source/);
+  });
+});
@@ -1,4 +1,5 @@
 import assert from 'node:assert';
+import { readFile, rm, writeFile } from 'node:fs/promises';
 import { describe, it } from 'node:test';
 
 import {
@@ -18,7 +19,7 @@ import {
   HardwareContext,
   type AVHWDeviceType,
 } from '../src/index.js';
-import { getInputFile, prepareTestEnvironment, skipInCI } from './index.js';
+import { getInputFile, getOutputFile, prepareTestEnvironment, skipInCI } from './index.js';
 
 import type { Frame } from '../src/lib/index.js';
 
@@ -51,6 +52,63 @@ describe('HardwareContext', () => {
     });
   });
 
+  describe('capability probe', () => {
+    it('should probe once and reuse the cached matrix', async () => {
+      const cacheFile = getOutputFile(`hwcaps-${process.pid}.json`);
+      await rm(cacheFile, { force: true });
+
+      const caps = HardwareContext.probeCapabilitiesSync({ cacheFile, refresh: true });
+      assert.equal(caps.fromCache, false);
+      assert.equal(caps.devices.length, HardwareContext.listAvailable().length);
+      for (const device of caps.devices) {
+        assert.ok(Array.isArray(device.decoders) && Array.isArray(device.encoders));
+        if (!device.available) {
+          assert.equal(device.verified, false);
+        }
+      }
+
+      const file = JSON.parse(await readFile(cacheFile, 'utf8'));
+      assert.ok(file.entries[caps.key]);
+
+      const again = HardwareContext.probeCapabilitiesSync({ cacheFile });
+      assert.equal(again.fromCache, true);
+      assert.equal(again.key, caps.key);
+      assert.deepEqual(again.devices, caps.devices);
+
+      await rm(cacheFile, { force: true });
+    });
+
+    it('should fall back on a corrupt cache and a missing device node', async () => {
+      const cacheFile = getOutputFile(`hwcaps-corrupt-${process.pid}.json`);
+      await writeFile(cacheFile, '{not json');
+
+      const caps = await HardwareContext.probeCapabilities({ cacheFile, device: '/nonexistent/node-av-device', verify: false });
+      assert.equal(caps.fromCache, false);
+      assert.equal(caps.device, '/nonexistent/node-av-device');
+      for (const device of caps.devices) {
+        assert.equal(device.verified, device.available ? null : false);
+      }
+
+      // Different device node, different key; the file was rewritten
+      assert.notEqual(caps.key, HardwareContext.probeCapabilitiesSync().key);
+      const file = JSON.parse(await readFile(cacheFile, 'utf8'));
+      assert.ok(file.entries[caps.key]);
+
+      await rm(cacheFile, { force: true });
+    });
+
+    it('should auto-select from the capability cache', skipInCI, async () => {
+      const cacheFile = getOutputFile(`hwcaps-auto-${process.pid}.json`);
+      await rm(cacheFile, { force: true });
+
+      using probed = HardwareContext.auto();
+      using cached = HardwareContext.auto({ capabilityCache: cacheFile });
+      assert.equal(cached?.deviceType ?? null, probed?.deviceType ?? null);
+
+      await rm(cacheFile, { force: true });
+    });
+  });
+
   describe('instance methods', () => {
     it('should provide device information', skipInCI, () => {
       const hw = HardwareContext.auto();
@@ -0,0 +1,142 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import {
+  AV_CODEC_ID_WEBP,
+  AV_PIX_FMT_NV12,
+  AV_PIX_FMT_RGBA,
+  AV_PIX_FMT_YUV420P,
+  Codec,
+  CodecContext,
+  FF_ENCODER_LIBWEBP,
+  FFmpegError,
+  Frame,
+  ImageEncoder,
+  Packet,
+} from '../src/index.js';
+
+import type { AVPixelFormat } from '../src/index.js';
+
+function createFrame(width: number, height: number, format: AVPixelFormat): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.width = width;
+  frame.height = height;
+  frame.format = format;
+  assert.equal(frame.getBuffer(), 0);
+  return frame;
+}
+
+describe('ImageEncoder', () => {
+  it('should encode JPEG from any pixel format', async () => {
+    using encoder = ImageEncoder.create();
+
+    for (const format of [AV_PIX_FMT_YUV420P, AV_PIX_FMT_NV12, AV_PIX_FMT_RGBA]) {
+      using frame = createFrame(320, 240, format);
+      const jpeg = await encoder.encode(frame, { quality: 80 });
+      assert.ok(jpeg.length > 0);
+      assert.equal(jpeg.readUInt16BE(0), 0xffd8, 'JPEG SOI marker');
+    }
+  });
+
+  it('should resize and keep the aspect ratio', () => {
+    using encoder = ImageEncoder.create();
+    using frame = createFrame(320, 240, AV_PIX_FMT_YUV420P);
+
+    const png = encoder.encodeSync(frame, { format: 'png', width: 160 });
+    assert.equal(png.toString('latin1', 1, 4), 'PNG');
+    // IHDR width and height
+    assert.equal(png.readUInt32BE(16), 160);
+    assert.equal(png.readUInt32BE(20), 120);
+  });
+
+  it('should encode single WebP images', { skip: !Codec.findEncoderByName(FF_ENCODER_LIBWEBP) }, async () => {
+    using encoder = ImageEncoder.create();
+    using frame = createFrame(320, 240, AV_PIX_FMT_YUV420P);
+
+    const webp = await encoder.encode(frame, { format: 'webp', quality: 75, width: 160 });
+    assert.equal(webp.toString('latin1', 0, 4), 'RIFF');
+    assert.equal(webp.toString('latin1', 8, 12), 'WEBP');
+
+    // Decode it back
+    using ctx = new CodecContext();
+    ctx.allocContext3(Codec.findDecoder(AV_CODEC_ID_WEBP));
+    assert.equal(ctx.open2Sync(), 0);
+
+    using packet = new Packet();
+    packet.alloc();
+    packet.data = webp;
+    assert.equal(ctx.sendPacketSync(packet), 0);
+
+    using decoded = new Frame();
+    decoded.alloc();
+    assert.equal(ctx.receiveFrameSync(decoded), 0);
+    assert.equal(decoded.width, 160);
+    assert.equal(decoded.height, 120);
+  });
+
+  it('should reuse pooled contexts', async () => {
+    using encoder = ImageEncoder.create({ maxContexts: 1 });
+    using frame = createFrame(64, 64, AV_PIX_FMT_YUV420P);
+
+    await encoder.encode(frame);
+    await encoder.encode(frame);
+    let stats = encoder.getStats();
+    assert.equal(stats.misses, 1);
+    assert.equal(stats.hits, 1);
+    assert.equal(stats.idle, 1);
+    assert.equal(stats.encoded, 2);
+
+    // Different size needs another context, the pool keeps only one
+    await encoder.encode(frame, { width: 32 });
+    stats = encoder.getStats();
+    assert.equal(stats.misses, 2);
+    assert.equal(stats.evictions, 1);
+    assert.equal(stats.inUse, 0);
+
+    encoder.clear();
+    assert.equal(encoder.getStats().idle, 0);
+  });
+
+  it('should alternate sources of different sizes on one context', () => {
+    using encoder = ImageEncoder.create({ maxContexts: 1 });
+    using small = createFrame(320, 240, AV_PIX_FMT_YUV420P);
+    using large = createFrame(640, 480, AV_PIX_FMT_NV12);
+
+    for (let i = 0; i < 4; i++) {
+      const png = encoder.encodeSync(i % 2 === 0 ? small : large, { format: 'png', width: 160, height: 120 });
+      assert.equal(png.readUInt32BE(16), 160);
+      assert.equal(png.readUInt32BE(20), 120);
+    }
+
+    const stats = encoder.getStats();
+    assert.equal(stats.misses, 1, 'Same output, one encoder context');
+    assert.equal(stats.hits, 3);
+  });
+
+  it('should encode concurrently', async () => {
+    using encoder = ImageEncoder.create();
+    using frame = createFrame(320, 240, AV_PIX_FMT_YUV420P);
+
+    const images = await Promise.all(Array.from({ length: 8 }, () => encoder.encode(frame, { quality: 60 })));
+    assert.equal(images.length, 8);
+    assert.ok(images.every((image) => image.equals(images[0])), 'Same frame, same image');
+    assert.equal(encoder.getStats().inUse, 0);
+  });
+
+  it('should fail after close', async () => {
+    const encoder = ImageEncoder.create();
+    using frame = createFrame(64, 64, AV_PIX_FMT_YUV420P);
+
+    encoder.close();
+    await assert.rejects(encoder.encode(frame), FFmpegError);
+  });
+
+  it('should reject frames without data', async () => {
+    using encoder = ImageEncoder.create();
+    using frame = new Frame();
+    frame.alloc();
+
+    await assert.rejects(encoder.encode(frame), FFmpegError);
+  });
+});
@@ -0,0 +1,118 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { AVERROR_EOF, Demuxer, FFmpegError, InputSynchronizer, Packet } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+async function countPackets(): Promise<number> {
+  await using media = await Demuxer.open(inputFile);
+  let count = 0;
+  for await (const packet of media.packets()) {
+    if (!packet) break;
+    count++;
+    packet.free();
+  }
+  return count;
+}
+
+describe('InputSynchronizer', () => {
+  it('should interleave all packets of all inputs', async () => {
+    const perInput = await countPackets();
+
+    await using camA = await Demuxer.open(inputFile);
+    await using camB = await Demuxer.open(inputFile);
+    const streamsA = camA.getFormatContext().nbStreams;
+
+    const sync = InputSynchronizer.create([camA.getFormatContext(), camB.getFormatContext()]);
+    assert.equal(sync.streamCount, streamsA * 2);
+    assert.equal(sync.getSource(streamsA)?.input, 1);
+    assert.equal(sync.getSource(sync.streamCount), null);
+
+    sync.start();
+    assert.throws(() => sync.start(), /already started/);
+
+    const packet = new Packet();
+    packet.alloc();
+    const counts = [0, 0];
+    while (true) {
+      const ret = await sync.receiveAsync(packet);
+      if (ret === AVERROR_EOF) break;
+      FFmpegError.throwIfError(ret, 'receive');
+      assert.equal(packet.streamIndex, ret);
+      counts[sync.getSource(ret)!.input]++;
+    }
+    packet.free();
+
+    assert.deepEqual(counts, [perInput, perInput]);
+
+    const stats = sync.getStats();
+    assert.equal(stats.inputs.length, 2);
+    assert.equal(stats.queued, 0);
+    for (const input of stats.inputs) {
+      // Files have no absolute start time
+      assert.equal(input.clock, 'arrival');
+      assert.equal(input.packets, perInput);
+      assert.ok(input.eof);
+      assert.equal(input.error, 0);
+      assert.ok(input.maxJitterMs >= input.jitterMs);
+    }
+
+    await sync.stop();
+  });
+
+  it('should not map timestamps backwards when re-anchored', async () => {
+    await using cam = await Demuxer.open(inputFile);
+    const ctx = cam.getFormatContext();
+
+    // The reader blocks on the small queue, so the clock appears mid-stream
+    const sync = InputSynchronizer.create([ctx], { maxQueuedPackets: 2 });
+    sync.start();
+
+    const packet = new Packet();
+    packet.alloc();
+    const lastDts = new Map<number, bigint>();
+    let received = 0;
+    while (true) {
+      if (received === 8) {
+        // Source clock far before timeline zero: a large backwards re-anchor
+        assert.equal(ctx.setOption('start_time_realtime', '1'), 0);
+      }
+      const ret = await sync.receiveAsync(packet);
+      if (ret === AVERROR_EOF) break;
+      FFmpegError.throwIfError(ret, 'receive');
+      received++;
+
+      const last = lastDts.get(ret);
+      if (last !== undefined) {
+        assert.ok(packet.dts > last, `dts of stream ${ret} went from ${last} to ${packet.dts}`);
+      }
+      lastDts.set(ret, packet.dts);
+    }
+    packet.free();
+
+    assert.equal(sync.getStats().inputs[0].clock, 'realtime');
+    await sync.stop();
+  });
+
+  it('should end a pending receive on stop', async () => {
+    await using cam = await Demuxer.open(inputFile);
+
+    const sync = InputSynchronizer.create([cam.getFormatContext()], { maxQueuedPackets: 1 });
+    sync.start();
+    await sync.stop();
+
+    const packet = new Packet();
+    packet.alloc();
+    // Drain what was queued before the stop, then the timeline is over
+    let ret = 0;
+    while (ret >= 0) {
+      ret = await sync.receiveAsync(packet);
+    }
+    assert.equal(ret, AVERROR_EOF);
+    packet.free();
+  });
+});
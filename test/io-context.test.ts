@@ -828,6 +828,34 @@ describe('IOContext', () => {
     });
   });
 
+  describe('Memory Mapping', () => {
+    it('should read and seek a mapped file', () => {
+      const expected = readFileSync(testVideoFile);
+      const io = new IOContext();
+      io.allocContextMmap(testVideoFile, 4096);
+
+      assert.equal(io.sizeSync(), BigInt(expected.length));
+      assert.equal(io.direct, 1);
+
+      // Larger than the buffer, served straight from the mapping
+      const head = io.readSync(65536);
+      assert.ok(Buffer.isBuffer(head));
+      assert.ok(head.equals(expected.subarray(0, head.length)));
+
+      io.seekSync(BigInt(expected.length - 10), AVSEEK_SET);
+      const tail = io.readSync(100);
+      assert.ok(Buffer.isBuffer(tail));
+      assert.ok(tail.equals(expected.subarray(expected.length - 10)));
+
+      io.freeContext();
+    });
+
+    it('should throw for missing files', () => {
+      const io = new IOContext();
+      assert.throws(() => io.allocContextMmap(getInputFile('does-not-exist.mp4')));
+    });
+  });
+
   describe('Edge Cases', () => {
     it('should handle empty file (async)', async () => {
       // Create empty file
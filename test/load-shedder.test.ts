@@ -0,0 +1,118 @@
+import assert from 'node:assert';
+import { setTimeout as sleep } from 'node:timers/promises';
+import { describe, it } from 'node:test';
+
+import { AV_PKT_FLAG_DISPOSABLE, Frame, LoadShedder, Packet, Rational } from '../src/index.js';
+import { prepareTestEnvironment } from './index.js';
+
+import type { LoadSheddingEvent } from '../src/index.js';
+
+prepareTestEnvironment();
+
+// 25 fps media clock: one frame every 40ms
+const timeBase = new Rational(1, 25);
+
+async function* slowFrames(count: number, delayMs: number, start = 0): AsyncGenerator<Frame | null> {
+  for (let i = 0; i < count; i++) {
+    const frame = new Frame();
+    frame.alloc();
+    frame.pts = BigInt(start + i);
+    frame.timeBase = timeBase;
+    yield frame;
+    if (delayMs > 0) {
+      await sleep(delayMs);
+    }
+  }
+}
+
+describe('LoadShedder', () => {
+  it('should drop frames while behind real time and recover', async () => {
+    const started: LoadSheddingEvent[] = [];
+    const stopped: LoadSheddingEvent[] = [];
+    const shedder = LoadShedder.create({
+      dropDisposableAfter: 0,
+      dropFramesAfter: 50,
+      lowerBitrateAfter: 0,
+      frameDecimation: 2,
+      onSheddingStart: (event) => started.push(event),
+      onSheddingStop: (event) => stopped.push(event),
+    });
+
+    // 60ms per 40ms frame falls 20ms further behind on every frame, then catch up
+    async function* source(): AsyncGenerator<Frame | null> {
+      yield* slowFrames(10, 60);
+      yield* slowFrames(20, 0, 10);
+      yield null;
+    }
+
+    let received = 0;
+    let sawNull = false;
+    for await (const frame of shedder.frames(source())) {
+      if (!frame) {
+        sawNull = true;
+        continue;
+      }
+      received++;
+      frame.free();
+    }
+
+    const stats = shedder.getStats();
+    assert.equal(sawNull, true, 'flush marker must not be dropped');
+    assert.ok(stats.droppedFrames > 0, 'frames should be dropped while behind');
+    assert.equal(received + stats.droppedFrames, 30);
+    assert.ok(stats.maxLatency > 50);
+
+    assert.deepEqual(
+      started.map((e) => e.action),
+      ['drop-frames'],
+    );
+    assert.deepEqual(
+      stopped.map((e) => e.action),
+      ['drop-frames'],
+    );
+    assert.ok(started[0].latency > 50);
+    assert.ok(stopped[0].latency < 25);
+    assert.deepEqual(stats.activeActions, []);
+    assert.equal(shedder.isShedding, false);
+  });
+
+  it('should drop only disposable packets', async () => {
+    const shedder = LoadShedder.create({
+      dropDisposableAfter: 30,
+      dropFramesAfter: 0,
+      lowerBitrateAfter: 0,
+    });
+
+    async function* source(): AsyncGenerator<Packet | null> {
+      for (let i = 0; i < 12; i++) {
+        const packet = new Packet();
+        packet.alloc();
+        packet.pts = BigInt(i);
+        packet.dts = BigInt(i);
+        packet.timeBase = timeBase;
+        if (i % 2 === 1) {
+          packet.flags = AV_PKT_FLAG_DISPOSABLE;
+        }
+        yield packet;
+        await sleep(60);
+      }
+      yield null;
+    }
+
+    const delivered: bigint[] = [];
+    for await (const packet of shedder.packets(source())) {
+      if (!packet) continue;
+      delivered.push(packet.pts);
+      packet.free();
+    }
+
+    const stats = shedder.getStats();
+    assert.ok(stats.droppedPackets > 0, 'disposable packets should be dropped');
+    assert.equal(delivered.length + stats.droppedPackets, 12);
+    for (let i = 0n; i < 12n; i += 2n) {
+      assert.ok(delivered.includes(i), `reference packet ${i} must be kept`);
+    }
+    assert.equal(stats.droppedFrames, 0);
+    assert.deepEqual(stats.activeActions, ['drop-disposable']);
+  });
+});
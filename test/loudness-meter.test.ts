@@ -0,0 +1,111 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import {
+  AV_CHANNEL_LAYOUT_5POINT1,
+  AV_CHANNEL_LAYOUT_MONO,
+  AV_CHANNEL_LAYOUT_STEREO,
+  AV_SAMPLE_FMT_FLT,
+  AV_SAMPLE_FMT_S16,
+  AVERROR_INPUT_CHANGED,
+  Frame,
+  LoudnessMeter,
+} from '../src/index.js';
+
+import type { AVSampleFormat, ChannelLayout } from '../src/index.js';
+
+const SAMPLE_RATE = 48000;
+
+// Interleaved 1 kHz sine in the given channels, silence in the others
+function createSine(amplitude: number, nbSamples: number, format: AVSampleFormat, layout: ChannelLayout, active: number[], start = 0): Frame {
+  const channels = layout.nbChannels;
+  const bytes = format === AV_SAMPLE_FMT_S16 ? 2 : 4;
+  const samples = Buffer.alloc(nbSamples * channels * bytes);
+  for (let i = 0; i < nbSamples; i++) {
+    const value = amplitude * Math.sin((2 * Math.PI * 1000 * (start + i)) / SAMPLE_RATE);
+    for (const c of active) {
+      const offset = (i * channels + c) * bytes;
+      if (format === AV_SAMPLE_FMT_S16) {
+        samples.writeInt16LE(Math.round(value * 32767), offset);
+      } else {
+        samples.writeFloatLE(value, offset);
+      }
+    }
+  }
+  return Frame.fromAudioBuffer(samples, { nbSamples, format, sampleRate: SAMPLE_RATE, channelLayout: layout });
+}
+
+// Feed seconds of sine in frames of 1024 samples
+function feed(meter: LoudnessMeter, seconds: number, amplitude: number, format: AVSampleFormat, layout: ChannelLayout, active: number[]): void {
+  const total = seconds * SAMPLE_RATE;
+  for (let start = 0; start < total; start += 1024) {
+    using frame = createSine(amplitude, Math.min(1024, total - start), format, layout, active, start);
+    assert.equal(meter.measure(frame), 0);
+  }
+}
+
+describe('LoudnessMeter', () => {
+  it('should measure a stereo sine', () => {
+    const meter = LoudnessMeter.create();
+    feed(meter, 5, 0.1, AV_SAMPLE_FMT_FLT, AV_CHANNEL_LAYOUT_STEREO, [0, 1]);
+
+    // BS.1770: a 1 kHz sine in both stereo channels reads its peak level in LUFS
+    const result = meter.getResult();
+    assert.ok(Math.abs(result.integrated + 20) < 0.2, `integrated ${result.integrated}`);
+    assert.ok(Math.abs(result.momentary + 20) < 0.2, `momentary ${result.momentary}`);
+    assert.ok(Math.abs(result.shortTerm + 20) < 0.2, `short-term ${result.shortTerm}`);
+    assert.ok(result.range < 0.5, `range ${result.range}`);
+    assert.ok(Math.abs(result.samplePeak + 20) < 0.1);
+    assert.ok(result.truePeak >= result.samplePeak && result.truePeak < -19.8);
+
+    assert.equal(result.channels.length, 2);
+    for (const channel of result.channels) {
+      assert.ok(Math.abs(channel.rms + 23.01) < 0.05, `rms ${channel.rms}`);
+    }
+  });
+
+  it('should give the same result for any sample format', () => {
+    const float = LoudnessMeter.create();
+    const s16 = LoudnessMeter.create();
+    feed(float, 3, 0.5, AV_SAMPLE_FMT_FLT, AV_CHANNEL_LAYOUT_STEREO, [0, 1]);
+    feed(s16, 3, 0.5, AV_SAMPLE_FMT_S16, AV_CHANNEL_LAYOUT_STEREO, [0, 1]);
+
+    assert.ok(Math.abs(float.getResult().integrated - s16.getResult().integrated) < 0.01);
+  });
+
+  it('should exclude the LFE channel', () => {
+    const meter = LoudnessMeter.create({ truePeak: false });
+    feed(meter, 1, 0.5, AV_SAMPLE_FMT_FLT, AV_CHANNEL_LAYOUT_5POINT1, [3]);
+
+    const result = meter.getResult();
+    assert.equal(result.integrated, -Infinity);
+    assert.ok(Number.isNaN(result.truePeak), 'True peak disabled');
+    assert.ok(result.channels[3].rms > -10, 'LFE level is still reported');
+  });
+
+  it('should fill a reusable values array', () => {
+    const meter = LoudnessMeter.create();
+    assert.equal(meter.getValues().length, 6, 'No channels before the first frame');
+
+    feed(meter, 1, 0.1, AV_SAMPLE_FMT_FLT, AV_CHANNEL_LAYOUT_STEREO, [0]);
+    assert.equal(meter.channels, 2);
+
+    const values = new Float64Array(6 + 3 * meter.channels);
+    assert.strictEqual(meter.getValues(values), values);
+    assert.equal(values[6 + 3 + 1], -Infinity, 'Silent channel has no peak');
+    assert.throws(() => meter.getValues(new Float64Array(6)), TypeError);
+  });
+
+  it('should reject layout changes until reset', () => {
+    const meter = LoudnessMeter.create();
+    feed(meter, 1, 0.1, AV_SAMPLE_FMT_FLT, AV_CHANNEL_LAYOUT_STEREO, [0, 1]);
+
+    using mono = createSine(0.1, 1024, AV_SAMPLE_FMT_FLT, AV_CHANNEL_LAYOUT_MONO, [0]);
+    assert.equal(meter.measure(mono), AVERROR_INPUT_CHANGED);
+
+    meter.reset();
+    assert.equal(meter.measure(mono), 0);
+    assert.equal(meter.channels, 1);
+    assert.equal(meter.getResult().momentary, -Infinity, 'Less than 400 ms measured');
+  });
+});
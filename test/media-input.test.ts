@@ -1,14 +1,16 @@
 import assert from 'node:assert';
 import { readFileSync } from 'node:fs';
 import { readFile } from 'node:fs/promises';
+import { createServer } from 'node:net';
 import { after, describe, it } from 'node:test';
 
-import { Demuxer } from '../src/api/index.js';
+import { Demuxer, Muxer } from '../src/api/index.js';
 import { StreamingUtils } from '../src/api/utilities/streaming.js';
-import { AV_CODEC_ID_H264, AV_CODEC_ID_OPUS } from '../src/constants/constants.js';
+import { AV_CODEC_ID_H264, AV_CODEC_ID_OPUS, AV_NOPTS_VALUE } from '../src/constants/constants.js';
 import { AVMEDIA_TYPE_AUDIO, AVMEDIA_TYPE_VIDEO, AVSEEK_CUR, AVSEEK_END, AVSEEK_SET, AVSEEK_SIZE } from '../src/index.js';
-import { getInputFile, prepareTestEnvironment } from './index.js';
+import { getInputFile, getOutputFile, prepareTestEnvironment } from './index.js';
 
+import type { AddressInfo, Socket } from 'node:net';
 import type { IOInputCallbacks } from '../src/api/types.js';
 import type { AVSeekWhence } from '../src/index.js';
 
@@ -351,6 +353,39 @@ describe('Demuxer', () => {
 
       media.closeSync();
     });
+
+    it('should read identical packets with mmap option', async () => {
+      const collect = async (mmap: boolean) => {
+        await using media = await Demuxer.open(inputFile, { mmap });
+        const packets: { streamIndex: number; pts: bigint; data: Buffer }[] = [];
+        for await (using packet of media.packets()) {
+          if (!packet) break;
+          packets.push({ streamIndex: packet.streamIndex, pts: packet.pts, data: Buffer.from(packet.data!) });
+        }
+        return packets;
+      };
+
+      const expected = await collect(false);
+      const mapped = await collect(true);
+
+      assert.ok(expected.length > 0, 'Should have read packets');
+      assert.deepEqual(mapped, expected);
+    });
+
+    it('should open with mmap option (sync)', () => {
+      const media = Demuxer.openSync(inputFile, { mmap: true });
+      assert.ok(media.streams.length > 0, 'Should have streams');
+
+      let packetCount = 0;
+      for (using packet of media.packetsSync()) {
+        if (!packet) break;
+        assert.ok(packet.size > 0);
+        packetCount++;
+      }
+      assert.ok(packetCount > 0, 'Should have read packets');
+
+      media.closeSync();
+    });
   });
 
   describe('stream info', () => {
@@ -1189,4 +1224,230 @@ describe('Demuxer', () => {
       rtpInput2.closeSync();
     });
   });
+
+  describe('reconnect', () => {
+    // MPEG-TS copy of the test file, served over the network as a live camera stand-in
+    const writeTsSource = async (name: string): Promise<{ data: Buffer; packetsPerPass: number }> => {
+      const tsFile = getOutputFile(name);
+      let packetsPerPass = 0;
+      {
+        await using source = await Demuxer.open(inputFile);
+        await using output = await Muxer.open(tsFile, { format: 'mpegts' });
+        const video = source.video();
+        assert.ok(video);
+        const outIndex = output.addStream(video);
+        for await (using packet of source.packets(video.index)) {
+          if (!packet) break;
+          await output.writePacket(packet, outIndex);
+          packetsPerPass++;
+        }
+      }
+      return { data: readFileSync(tsFile), packetsPerPass };
+    };
+
+    it('should replace a stalled connection and continue timestamps', async () => {
+      const { data, packetsPerPass } = await writeTsSource('reconnect-source.ts');
+      const half = Math.floor(data.length / 2 / 188) * 188;
+
+      // 1st connection: half the stream, then silence; 2nd: whole stream and close; later: refused
+      let connections = 0;
+      const sockets: Socket[] = [];
+      const server = createServer((socket) => {
+        sockets.push(socket);
+        connections++;
+        if (connections === 1) {
+          socket.write(data.subarray(0, half));
+        } else if (connections === 2) {
+          socket.end(data);
+        } else {
+          socket.destroy();
+        }
+      });
+      await new Promise<void>((resolve) => server.listen(0, '127.0.0.1', resolve));
+      const { port } = server.address() as AddressInfo;
+
+      try {
+        const events: string[] = [];
+        const input = await Demuxer.open(`tcp://127.0.0.1:${port}`, {
+          format: 'mpegts',
+          options: { probesize: '8192', analyzeduration: '100000' },
+          reconnect: {
+            stallTimeout: 500,
+            delay: 10,
+            maxAttempts: 2,
+            onDisconnect: (_error, stalled) => events.push(stalled ? 'stall' : 'disconnect'),
+            onReconnect: () => events.push('reconnect'),
+          },
+        });
+        openInstances.push(input);
+        const video = input.video();
+        assert.ok(video);
+
+        let count = 0;
+        let lastDts = AV_NOPTS_VALUE;
+        for await (const packet of input.packets(video.index)) {
+          if (!packet) break;
+          if (lastDts !== AV_NOPTS_VALUE && packet.dts !== AV_NOPTS_VALUE) {
+            assert.ok(packet.dts > lastDts, 'timestamps must continue across reconnects');
+          }
+          lastDts = packet.dts;
+          count++;
+          packet.free();
+        }
+
+        // Part of the first connection plus the complete second one
+        assert.ok(count > packetsPerPass, `read ${count} packets, ${packetsPerPass} per connection`);
+        assert.deepEqual(events.slice(0, 3), ['stall', 'reconnect', 'disconnect']);
+
+        const stats = input.getReconnectStats();
+        assert.ok(stats);
+        assert.equal(stats.stalls, 1);
+        assert.equal(stats.reconnects, 1);
+        assert.equal(stats.failedAttempts, 2);
+        assert.equal(stats.gaveUp, 'attempts');
+
+        // The stream objects handed out before the reconnect are still valid
+        assert.equal(video.codecpar.codecId, AV_CODEC_ID_H264);
+        await input.close();
+      } finally {
+        for (const socket of sockets) {
+          socket.destroy();
+        }
+        server.close();
+      }
+    });
+
+    it('should not hang on an RTSP server that stops responding', async () => {
+      const { data } = await writeTsSource('reconnect-rtsp-source.ts');
+      const half = Math.floor(data.length / 2 / 188) * 188;
+      const sdp = 'v=0\r\no=- 0 0 IN IP4 127.0.0.1\r\ns=test\r\nc=IN IP4 127.0.0.1\r\nt=0 0\r\nm=video 0 RTP/AVP 33\r\na=rtpmap:33 MP2T/90000\r\na=control:track1\r\n';
+
+      // MPEG-TS over RTP (7 TS packets each), interleaved on the RTSP connection
+      const sendRtp = (socket: Socket, payload: Buffer): void => {
+        for (let offset = 0, seq = 0; offset < payload.length; offset += 7 * 188, seq++) {
+          const chunk = payload.subarray(offset, offset + 7 * 188);
+          const header = Buffer.alloc(16);
+          header.writeUInt8(0x24, 0);
+          header.writeUInt16BE(12 + chunk.length, 2);
+          header.writeUInt8(0x80, 4);
+          header.writeUInt8(33, 5);
+          header.writeUInt16BE(seq & 0xffff, 6);
+          header.writeUInt32BE(seq * 3000, 8);
+          header.writeUInt32BE(0x12345678, 12);
+          socket.write(Buffer.concat([header, chunk]));
+        }
+      };
+
+      // 1st connection: half the stream, then no data and no replies (PAUSE, TEARDOWN);
+      // 2nd: accepts but never answers; 3rd: whole stream and close; later: refused
+      let connections = 0;
+      const sockets: Socket[] = [];
+      const server = createServer((socket) => {
+        sockets.push(socket);
+        const connection = ++connections;
+        if (connection > 3) {
+          socket.destroy();
+          return;
+        }
+
+        let buffered = '';
+        let playing = false;
+        socket.on('data', (chunk) => {
+          buffered += chunk.toString('latin1');
+          let end: number;
+          while ((end = buffered.indexOf('\r\n\r\n')) >= 0) {
+            const request = buffered.slice(0, end);
+            buffered = buffered.slice(end + 4);
+            if (connection === 2 || playing) {
+              continue;
+            }
+
+            const [method, url] = request.split(' ');
+            const cseq = /CSeq:\s*(\d+)/i.exec(request)?.[1] ?? '0';
+            let headers = `CSeq: ${cseq}\r\nSession: 12345678\r\n`;
+            let body = '';
+            if (method === 'OPTIONS') {
+              headers += 'Public: OPTIONS, DESCRIBE, SETUP, PLAY, PAUSE, TEARDOWN\r\n';
+            } else if (method === 'DESCRIBE') {
+              body = sdp;
+              headers += `Content-Base: ${url}/\r\nContent-Type: application/sdp\r\nContent-Length: ${body.length}\r\n`;
+            } else if (method === 'SETUP') {
+              headers += 'Transport: RTP/AVP/TCP;unicast;interleaved=0-1\r\n';
+            }
+            socket.write(`RTSP/1.0 200 OK\r\n${headers}\r\n${body}`);
+
+            if (method === 'PLAY') {
+              playing = true;
+              if (connection === 1) {
+                sendRtp(socket, data.subarray(0, half));
+              } else {
+                sendRtp(socket, data);
+                socket.end();
+              }
+            }
+          }
+        });
+      });
+      await new Promise<void>((resolve) => server.listen(0, '127.0.0.1', resolve));
+      const { port } = server.address() as AddressInfo;
+
+      try {
+        const events: string[] = [];
+        const input = await Demuxer.open(`rtsp://127.0.0.1:${port}/live`, {
+          options: { rtsp_transport: 'tcp', probesize: '8192', analyzeduration: '100000' },
+          reconnect: {
+            stallTimeout: 500,
+            delay: 10,
+            maxAttempts: 2,
+            onDisconnect: (_error, stalled) => events.push(stalled ? 'stall' : 'disconnect'),
+            onReconnect: () => events.push('reconnect'),
+          },
+        });
+        openInstances.push(input);
+        const video = input.video();
+        assert.ok(video);
+
+        let count = 0;
+        for await (const packet of input.packets(video.index)) {
+          if (!packet) break;
+          count++;
+          packet.free();
+        }
+
+        assert.ok(count > 0);
+        assert.deepEqual(events.slice(0, 3), ['stall', 'reconnect', 'disconnect']);
+
+        // The silent 2nd server only costs one failed attempt
+        const stats = input.getReconnectStats();
+        assert.ok(stats);
+        assert.equal(stats.stalls, 1);
+        assert.equal(stats.reconnects, 1);
+        assert.ok(stats.failedAttempts >= 1);
+        assert.ok(connections >= 3);
+        await input.close();
+      } finally {
+        for (const socket of sockets) {
+          socket.destroy();
+        }
+        server.close();
+      }
+    });
+
+    it('should not reconnect file inputs', async () => {
+      const input = await Demuxer.open(inputFile, { reconnect: true });
+      openInstances.push(input);
+
+      let count = 0;
+      for await (const packet of input.packets()) {
+        if (!packet) break;
+        count++;
+        packet.free();
+      }
+
+      assert.ok(count > 0);
+      assert.equal(input.getReconnectStats()?.reconnects, 0);
+      assert.equal(input.getFormatContext().readTimeout, 5000);
+      await input.close();
+    });
+  });
 });
@@ -1,8 +1,9 @@
 import assert from 'node:assert';
-import { readFile, stat, unlink } from 'node:fs/promises';
+import { createSocket } from 'node:dgram';
+import { readFile, stat, unlink, writeFile } from 'node:fs/promises';
 import { describe, it } from 'node:test';
 
-import { AVSEEK_CUR, AVSEEK_END, AVSEEK_SET, AVSEEK_SIZE, Decoder, Demuxer, Encoder, FF_ENCODER_AAC, FF_ENCODER_LIBX264, Muxer, Packet } from '../src/index.js';
+import { AVSEEK_CUR, AVSEEK_END, AVSEEK_SET, AVSEEK_SIZE, Decoder, Demuxer, Encoder, FF_ENCODER_AAC, FF_ENCODER_LIBX264, mp4DefragmentSync, Muxer, Packet } from '../src/index.js';
 import { getInputFile, getOutputFile, prepareTestEnvironment } from './index.js';
 
 import type { IOOutputCallbacks } from '../src/api/types.js';
@@ -1272,6 +1273,283 @@ describe('Muxer', () => {
     });
   });
 
+  describe('fast start', () => {
+    const topLevelBoxes = (data: Buffer): string[] => {
+      const boxes: string[] = [];
+      for (let pos = 0; pos + 8 <= data.length; ) {
+        let size = data.readUInt32BE(pos);
+        if (size === 1) size = Number(data.readBigUInt64BE(pos + 8));
+        boxes.push(data.toString('latin1', pos + 4, pos + 8));
+        if (size < 8) break;
+        pos += size;
+      }
+      return boxes;
+    };
+
+    const remux = async (outputFile: string, sync: boolean, onFinalizeProgress?: (progress: number) => void): Promise<number> => {
+      await using input = await Demuxer.open(inputFile);
+      const output = sync ? Muxer.openSync(outputFile, { fastStart: true }) : await Muxer.open(outputFile, { fastStart: true, onFinalizeProgress });
+      const indices = input.streams.map((stream) => output.addStream(stream));
+
+      let count = 0;
+      for await (using packet of input.packets()) {
+        if (!packet) break;
+        await output.writePacket(packet, indices[packet.streamIndex]);
+        count++;
+      }
+
+      if (sync) {
+        output.closeSync();
+      } else {
+        await output.close();
+      }
+      return count;
+    };
+
+    for (const sync of [false, true]) {
+      it(`should finalize a fragmented recording with the moov in front (${sync ? 'sync' : 'async'})`, async () => {
+        const outputFile = getTempFile('mp4');
+        const progress: number[] = [];
+        const written = await remux(outputFile, sync, (p) => progress.push(p));
+
+        const boxes = topLevelBoxes(await readFile(outputFile));
+        assert.deepEqual(boxes, ['ftyp', 'moov', 'mdat']);
+        await assert.rejects(stat(`${outputFile}.part`), { code: 'ENOENT' });
+        if (!sync) {
+          assert.equal(progress.at(-1), 1);
+        }
+
+        await using result = await Demuxer.open(outputFile);
+        let read = 0;
+        for await (using packet of result.packets()) {
+          if (!packet) break;
+          read++;
+        }
+        assert.equal(read, written);
+        assert.ok(result.duration > 0);
+      });
+    }
+
+    it('should drop a truncated last fragment', async () => {
+      const fragmented = getTempFile('mp4');
+      const outputFile = getTempFile('mp4');
+      {
+        await using input = await Demuxer.open(inputFile);
+        await using output = await Muxer.open(fragmented, { options: { movflags: 'frag_every_frame+empty_moov+default_base_moof' } });
+        const indices = input.streams.map((stream) => output.addStream(stream));
+        for await (using packet of input.packets()) {
+          if (!packet) break;
+          await output.writePacket(packet, indices[packet.streamIndex]);
+        }
+      }
+
+      // Cut the recording one byte into the last mdat payload
+      const data = await readFile(fragmented);
+      let lastMdat = -1;
+      for (let pos = 0; pos + 8 <= data.length && data.readUInt32BE(pos) >= 8; pos += data.readUInt32BE(pos)) {
+        if (data.toString('latin1', pos + 4, pos + 8) === 'mdat') lastMdat = pos;
+      }
+      assert.ok(lastMdat > 0);
+      const moofs = topLevelBoxes(data.subarray(0, lastMdat)).filter((box) => box === 'moof').length;
+      await writeFile(fragmented, data.subarray(0, lastMdat + 9));
+
+      const result = mp4DefragmentSync(fragmented, outputFile);
+      assert.equal(result.fragments, moofs - 1);
+      assert.deepEqual(topLevelBoxes(await readFile(outputFile)), ['ftyp', 'moov', 'mdat']);
+
+      await using remuxed = await Demuxer.open(outputFile);
+      let read = 0;
+      for await (using packet of remuxed.packets()) {
+        if (!packet) break;
+        read++;
+      }
+      assert.equal(read, result.samples);
+    });
+
+    it('should report a failed finalize', async () => {
+      const outputFile = getTempFile('mp4');
+      const errors: Error[] = [];
+      {
+        await using input = await Demuxer.open(inputFile);
+        const output = await Muxer.open(outputFile, { fastStart: true, onFastStartError: (error) => errors.push(error) });
+        const indices = input.streams.map((stream) => output.addStream(stream));
+        for await (using packet of input.packets()) {
+          if (!packet) break;
+          await output.writePacket(packet, indices[packet.streamIndex]);
+        }
+
+        // The recording disappears before it is finalized
+        await unlink(`${outputFile}.part`);
+        await output.close();
+      }
+
+      assert.ok(errors.length > 0, 'The failure is reported');
+      assert.ok(errors.every((error) => error instanceof Error));
+      await assert.rejects(stat(outputFile), { code: 'ENOENT' });
+    });
+
+    it('should reject non-MP4 outputs', async () => {
+      const outputFile = getTempFile('ts');
+      await assert.rejects(Muxer.open(outputFile, { fastStart: true }), TypeError);
+    });
+  });
+
+  describe('RTP sink', () => {
+    it('should rewrite RTP headers natively and deliver batches (sync)', () => {
+      const datagrams: Buffer[] = [];
+      let batches = 0;
+
+      const input = Demuxer.openSync(inputFile);
+      const videoStream = input.video();
+      assert(videoStream);
+
+      const output = Muxer.openSync(
+        {
+          ssrc: 0x12345678,
+          payloadType: 100,
+          sequenceNumber: 0xfffe,
+          timestamp: 1000,
+          timestampIncrement: 3000,
+          onPackets: (slab: Buffer, offsets: Uint32Array) => {
+            batches++;
+            for (let i = 0; i < offsets.length - 1; i++) {
+              datagrams.push(Buffer.from(slab.subarray(offsets[i], offsets[i + 1])));
+            }
+          },
+        },
+        {
+          format: 'rtp',
+          maxPacketSize: 1200,
+          options: {
+            pkt_size: 1200,
+          },
+        },
+      );
+
+      const streamIdx = output.addStream(videoStream);
+
+      let packetCount = 0;
+      for (using packet of input.packetsSync()) {
+        if (!packet) {
+          break;
+        }
+
+        if (packet.streamIndex === videoStream.index) {
+          output.writePacketSync(packet, streamIdx);
+          packetCount++;
+        }
+        if (packetCount >= 10) break;
+      }
+
+      const stats = output.getRtpSinkStats();
+      output.closeSync();
+      input.closeSync();
+
+      assert.ok(datagrams.length > 0, 'Should have received datagrams');
+      assert.ok(batches > 0 && batches <= datagrams.length, 'Datagrams should be batched');
+      assert.ok(stats, 'Should expose sink stats');
+      assert.ok(stats.packets > 0 && datagrams.length >= stats.packets, 'Stats should count written datagrams');
+
+      let expectedTimestamp = 1000;
+      datagrams.forEach((datagram, i) => {
+        assert.equal(datagram[0] >> 6, 2, 'Should be RTP version 2');
+        assert.equal(datagram[1] & 0x7f, 100, 'Should rewrite payload type');
+        assert.equal(datagram.readUInt16BE(2), (0xfffe + i) & 0xffff, 'Should have continuous sequence numbers');
+        assert.equal(datagram.readUInt32BE(4), expectedTimestamp, 'Should synthesize timestamps');
+        assert.equal(datagram.readUInt32BE(8), 0x12345678, 'Should rewrite SSRC');
+        if (datagram[1] & 0x80) {
+          expectedTimestamp += 3000;
+        }
+      });
+    });
+
+    it('should send datagrams natively over UDP to a loopback receiver (async)', async () => {
+      const receiver = createSocket('udp4');
+      const received: Buffer[] = [];
+      receiver.on('message', (msg) => received.push(msg));
+      await new Promise<void>((resolve) => receiver.bind(0, '127.0.0.1', resolve));
+      const { port } = receiver.address();
+
+      const input = await Demuxer.open(inputFile);
+      const videoStream = input.video();
+      assert(videoStream);
+
+      const output = await Muxer.open(
+        {
+          ssrc: 0xcafe,
+          udp: {
+            address: '127.0.0.1',
+            port,
+            pacingBitrate: 50_000_000,
+          },
+        },
+        {
+          format: 'rtp',
+          maxPacketSize: 1200,
+          options: {
+            pkt_size: 1200,
+          },
+        },
+      );
+
+      const streamIdx = output.addStream(videoStream);
+
+      let packetCount = 0;
+      for await (using packet of input.packets()) {
+        if (!packet) {
+          break;
+        }
+
+        if (packet.streamIndex === videoStream.index) {
+          await output.writePacket(packet, streamIdx);
+          packetCount++;
+        }
+        if (packetCount >= 10) break;
+      }
+
+      // close() drains the native send queue
+      await output.close();
+      await input.close();
+
+      const stats = output.getRtpSinkStats();
+      assert.ok(stats?.udp, 'Should expose UDP sender stats');
+      assert.ok(stats.udp.sentPackets > 0, 'Should have sent packets');
+      assert.equal(stats.udp.droppedPackets, 0, 'Should not drop packets on loopback');
+      assert.ok(stats.udp.syscalls <= stats.udp.sentPackets, 'Should batch datagrams per syscall');
+
+      // Wait for the loopback receiver to catch up
+      const deadline = Date.now() + 2000;
+      while (received.length < stats.udp.sentPackets && Date.now() < deadline) {
+        await new Promise((resolve) => setTimeout(resolve, 10));
+      }
+      receiver.close();
+
+      assert.equal(received.length, stats.udp.sentPackets, 'Receiver should get every datagram');
+      for (const datagram of received) {
+        assert.equal(datagram.readUInt32BE(8), 0xcafe, 'Should rewrite SSRC');
+      }
+    });
+
+    it('should reject non-numeric UDP destinations', async () => {
+      await assert.rejects(
+        async () =>
+          await Muxer.open(
+            {
+              udp: { address: 'not-an-address', port: 5004 },
+            },
+            { format: 'rtp' },
+          ),
+        /Invalid UDP address/,
+      );
+    });
+
+    it('should not expose sink stats for callback IO', async () => {
+      const output = await Muxer.open({ write: (buffer: Buffer) => buffer.length }, { format: 'mpegts' });
+      assert.equal(output.getRtpSinkStats(), null);
+      await output.close();
+    });
+  });
+
   describe('Integration', () => {
     it('should transcode video with Demuxer/Output (async)', async () => {
       const input = await Demuxer.open(inputFile);
@@ -0,0 +1,87 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { AV_NOPTS_VALUE, Demuxer, PacketPacer } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+const msTimeBase = { num: 1, den: 1000 };
+
+describe('PacketPacer', () => {
+  it('should release timestamps in real time', async () => {
+    using pacer = PacketPacer.create();
+
+    // The first timestamp anchors the clock and is due immediately
+    assert.equal(pacer.wait(0n, msTimeBase), null);
+
+    const start = performance.now();
+    for (let ts = 20n; ts <= 200n; ts += 20n) {
+      const pending = pacer.wait(ts, msTimeBase);
+      assert.ok(pending, `timestamp ${ts} should not be due yet`);
+      await pending;
+    }
+    const elapsed = performance.now() - start;
+
+    assert.ok(elapsed >= 190, `paced 200ms of media in ${elapsed.toFixed(1)}ms`);
+    assert.ok(elapsed < 1000, `pacing took ${elapsed.toFixed(1)}ms`);
+
+    const stats = pacer.getStats();
+    assert.equal(stats.released, 11);
+    assert.equal(stats.waited, 10);
+    assert.equal(stats.reanchors, 0);
+
+    // Unset timestamps are never held back
+    assert.equal(pacer.wait(AV_NOPTS_VALUE, msTimeBase), null);
+  });
+
+  it('should release the initial burst and re-anchor on discontinuities', () => {
+    using pacer = PacketPacer.create({ initialBurst: 0.5, maxJump: 1 });
+
+    for (let ts = 0n; ts < 500n; ts += 40n) {
+      assert.equal(pacer.wait(ts, msTimeBase), null, `timestamp ${ts} is inside the burst`);
+    }
+
+    // A jump beyond maxJump becomes the new anchor instead of a 60s wait
+    assert.equal(pacer.wait(60_000n, msTimeBase), null);
+    assert.equal(pacer.getStats().reanchors, 1);
+
+    assert.throws(() => PacketPacer.create({ speed: 0 }), /speed/);
+  });
+
+  it('should pace and loop the demuxer', async () => {
+    let plainCount = 0;
+    {
+      await using media = await Demuxer.open(inputFile);
+      const video = media.video();
+      assert.ok(video);
+      for await (const packet of media.packets(video.index)) {
+        if (!packet) break;
+        plainCount++;
+        packet.free();
+      }
+    }
+
+    await using media = await Demuxer.open(inputFile, { loop: 1, pacing: { speed: 1000 } });
+    const video = media.video();
+    assert.ok(video);
+
+    let count = 0;
+    let lastDts = AV_NOPTS_VALUE;
+    for await (const packet of media.packets(video.index)) {
+      if (!packet) break;
+      if (lastDts !== AV_NOPTS_VALUE && packet.dts !== AV_NOPTS_VALUE) {
+        assert.ok(packet.dts > lastDts, 'timestamps must continue across the loop');
+      }
+      lastDts = packet.dts;
+      count++;
+      packet.free();
+    }
+
+    assert.equal(count, plainCount * 2);
+    const stats = media.getPacingStats();
+    assert.ok(stats);
+    assert.ok(stats.released >= count);
+  });
+});
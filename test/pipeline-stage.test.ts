@@ -0,0 +1,275 @@
+import assert from 'node:assert';
+import { existsSync, statSync } from 'node:fs';
+import { describe, it } from 'node:test';
+
+import {
+  AV_CODEC_ID_H264,
+  AV_CODEC_ID_RAWVIDEO,
+  AV_PIX_FMT_YUV420P,
+  AVERROR_EOF,
+  BitStreamFilter,
+  BitStreamFilterAPI,
+  BitStreamFilterContext,
+  Codec,
+  CodecContext,
+  Decoder,
+  Demuxer,
+  Encoder,
+  FF_ENCODER_RAWVIDEO,
+  FFmpegError,
+  Filter,
+  FilterAPI,
+  FilterGraph,
+  Muxer,
+  Packet,
+  PipelineStage,
+} from '../src/index.js';
+import { getInputFile, getOutputFile, prepareTestEnvironment } from './index.js';
+
+import type { Stream } from '../src/index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+function createBsf(name: string, stream: Stream): BitStreamFilterContext {
+  const filter = BitStreamFilter.getByName(name);
+  assert.ok(filter, `${name} should exist`);
+
+  const ctx = new BitStreamFilterContext();
+  assert.equal(ctx.alloc(filter), 0);
+  stream.codecpar.copy(ctx.inputCodecParameters!);
+  ctx.inputTimeBase = stream.timeBase;
+  assert.equal(ctx.init(), 0);
+  return ctx;
+}
+
+describe('PipelineStage', () => {
+  it('should run a linked bitstream filter chain natively', async (t) => {
+    await using media = await Demuxer.open(inputFile);
+    const stream = media.video();
+    assert.ok(stream);
+    if (stream.codecpar.codecId !== AV_CODEC_ID_H264) {
+      t.skip('Test file is not H.264');
+      return;
+    }
+
+    using annexbCtx = createBsf('h264_mp4toannexb', stream);
+    using nullCtx = createBsf('null', stream);
+
+    await using head = PipelineStage.create('bsf', annexbCtx, { queueSize: 4 });
+    await using tail = PipelineStage.create('bsf', nullCtx, { queueSize: 4 });
+    assert.equal(head.connect(tail), tail);
+    head.start();
+    tail.start();
+    assert.equal(head.kind, 'bsf');
+    assert.equal(tail.isRunning, true);
+
+    assert.throws(() => tail.push(null), /upstream stage/);
+    assert.throws(() => head.pull(new Packet()), /downstream stage/);
+
+    // Consume while producing so the small queues apply backpressure
+    const output: Buffer[] = [];
+    const consumer = (async () => {
+      using packet = new Packet();
+      packet.alloc();
+      while (true) {
+        const ret = await tail.pullAsync(packet);
+        if (ret === AVERROR_EOF) break;
+        FFmpegError.throwIfError(ret, 'pullAsync');
+        output.push(Buffer.from(packet.data!));
+      }
+    })();
+
+    let input = 0;
+    for await (using packet of media.packets(stream.index)) {
+      if (!packet) break;
+      assert.equal(await head.pushAsync(packet), true);
+      input++;
+    }
+    assert.equal(await head.pushAsync(null), true);
+    assert.equal(await head.pushAsync(null), false);
+
+    await consumer;
+
+    assert.ok(input > 0);
+    assert.equal(output.length, input);
+    const startCode = output[0].subarray(0, 4).equals(Buffer.from([0, 0, 0, 1])) || output[0].subarray(0, 3).equals(Buffer.from([0, 0, 1]));
+    assert.ok(startCode, 'output should be Annex B');
+
+    const stats = tail.getStats();
+    assert.equal(stats.inputItems, input);
+    assert.equal(stats.outputItems, input);
+    assert.equal(stats.finished, true);
+    assert.equal(stats.error, 0);
+    assert.equal(head.getStats().outputItems, input);
+  });
+
+  it('should run a linked decoder, filter and encoder chain natively', async () => {
+    await using media = await Demuxer.open(inputFile);
+    const stream = media.video();
+    assert.ok(stream);
+    const { width, height, format } = stream.codecpar;
+
+    const decoderCodec = Codec.findDecoder(stream.codecpar.codecId);
+    assert.ok(decoderCodec);
+    using decoderCtx = new CodecContext();
+    decoderCtx.allocContext3(decoderCodec);
+    assert.ok(decoderCtx.parametersToContext(stream.codecpar) >= 0);
+    decoderCtx.pktTimebase = stream.timeBase;
+    assert.equal(await decoderCtx.open2(decoderCodec), 0);
+
+    // buffer -> scale -> format -> buffersink
+    using graph = new FilterGraph();
+    graph.alloc();
+    const tb = stream.timeBase;
+    const buffersrc = graph.createFilter(Filter.getByName('buffer')!, 'src', `video_size=${width}x${height}:pix_fmt=${format}:time_base=${tb.num}/${tb.den}:pixel_aspect=1/1`);
+    const scale = graph.createFilter(Filter.getByName('scale')!, 'scale', '160:120');
+    const pixfmt = graph.createFilter(Filter.getByName('format')!, 'format', 'pix_fmts=yuv420p');
+    const buffersink = graph.createFilter(Filter.getByName('buffersink')!, 'sink');
+    assert.ok(buffersrc && scale && pixfmt && buffersink);
+    buffersrc.link(0, scale, 0);
+    scale.link(0, pixfmt, 0);
+    pixfmt.link(0, buffersink, 0);
+    assert.equal(await graph.config(), 0);
+
+    // Raw video output has a known packet size
+    const encoderCodec = Codec.findEncoder(AV_CODEC_ID_RAWVIDEO);
+    assert.ok(encoderCodec);
+    using encoderCtx = new CodecContext();
+    encoderCtx.allocContext3(encoderCodec);
+    encoderCtx.width = 160;
+    encoderCtx.height = 120;
+    encoderCtx.pixelFormat = AV_PIX_FMT_YUV420P;
+    encoderCtx.timeBase = tb;
+    assert.equal(await encoderCtx.open2(encoderCodec), 0);
+
+    await using decode = PipelineStage.create('decoder', decoderCtx, { queueSize: 4 });
+    await using filter = PipelineStage.create('filter', buffersrc, buffersink, { queueSize: 4 });
+    await using encode = PipelineStage.create('encoder', encoderCtx, { queueSize: 4 });
+    decode.connect(filter).connect(encode);
+    decode.start();
+    filter.start();
+    encode.start();
+
+    const sizes: number[] = [];
+    const consumer = (async () => {
+      using packet = new Packet();
+      packet.alloc();
+      while (true) {
+        const ret = await encode.pullAsync(packet);
+        if (ret === AVERROR_EOF) break;
+        FFmpegError.throwIfError(ret, 'pullAsync');
+        sizes.push(packet.size);
+      }
+    })();
+
+    let input = 0;
+    for await (using packet of media.packets(stream.index)) {
+      if (!packet || input === 30) break;
+      assert.equal(await decode.pushAsync(packet), true);
+      input++;
+    }
+    assert.equal(await decode.pushAsync(null), true);
+
+    await consumer;
+
+    const decoded = decode.getStats().outputItems;
+    assert.ok(decoded > 0);
+    assert.equal(filter.getStats().outputItems, decoded);
+    assert.equal(sizes.length, decoded);
+    assert.ok(sizes.every((size) => size === (160 * 120 * 3) / 2));
+    assert.equal(encode.getStats().finished, true);
+    assert.equal(encode.getStats().error, 0);
+  });
+
+  it('should reject mismatched connections', async () => {
+    await using media = await Demuxer.open(inputFile);
+    const stream = media.video();
+    assert.ok(stream);
+
+    const codec = Codec.findDecoder(stream.codecpar.codecId);
+    assert.ok(codec);
+    using codecCtx = new CodecContext();
+    codecCtx.allocContext3(codec);
+    assert.ok(codecCtx.parametersToContext(stream.codecpar) >= 0);
+    assert.equal(await codecCtx.open2(codec), 0);
+
+    await using first = PipelineStage.create('decoder', codecCtx);
+    await using second = PipelineStage.create('decoder', codecCtx);
+    assert.throws(() => first.connect(second), /Cannot connect decoder output to decoder input/);
+    assert.throws(() => PipelineStage.create('encoder', codecCtx), /opened encoder/);
+  });
+
+  it('should link chained BitStreamFilterAPI stages in pipeTo', async () => {
+    const outputFile = getOutputFile('pipeline-stage-bsf.mkv');
+
+    await using media = await Demuxer.open(inputFile);
+    const stream = media.video();
+    assert.ok(stream);
+
+    await using output = await Muxer.open(outputFile);
+    const streamIndex = output.addStream(stream);
+
+    using first = BitStreamFilterAPI.create('null', stream);
+    using second = BitStreamFilterAPI.create('null', stream);
+    const control = first.pipeTo(second).pipeTo(output, streamIndex);
+
+    for await (using packet of media.packets(stream.index)) {
+      if (!packet) break;
+      await control.send(packet);
+    }
+    await control.send(null);
+    await output.close();
+
+    assert.ok(existsSync(outputFile));
+    assert.ok(statSync(outputFile).size > 0);
+  });
+
+  it('should link Decoder, FilterAPI and Encoder stages in pipeTo', async () => {
+    const outputFile = getOutputFile('pipeline-stage-transcode.mkv');
+
+    await using media = await Demuxer.open(inputFile);
+    const stream = media.video();
+    assert.ok(stream);
+
+    using decoder = await Decoder.create(stream);
+    using filter = FilterAPI.create('scale=160:120,format=yuv420p');
+    using encoder = await Encoder.create(FF_ENCODER_RAWVIDEO, { decoder, filter });
+
+    await using output = await Muxer.open(outputFile);
+    const streamIndex = output.addStream(encoder);
+
+    const control = decoder.pipeTo(filter).pipeTo(encoder).pipeTo(output, streamIndex);
+
+    // Filter and encoder are configured from the decoder parameters when piped
+    assert.equal(filter.isReady(), true);
+    assert.equal(encoder.isReady(), true);
+
+    let input = 0;
+    for await (using packet of media.packets(stream.index)) {
+      if (!packet || input === 30) break;
+      await control.send(packet);
+      input++;
+    }
+    await control.send(null);
+    await output.close();
+
+    assert.ok(existsSync(outputFile));
+    assert.ok(statSync(outputFile).size > 0);
+
+    await using check = await Demuxer.open(outputFile);
+    const written = check.video();
+    assert.ok(written);
+    assert.equal(written.codecpar.width, 160);
+    assert.equal(written.codecpar.height, 120);
+
+    let frames = 0;
+    for await (using packet of check.packets(written.index)) {
+      if (!packet) break;
+      assert.equal(packet.size, (160 * 120 * 3) / 2);
+      frames++;
+    }
+    assert.ok(frames > 0);
+  });
+});
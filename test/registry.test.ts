@@ -0,0 +1,78 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { AV_CODEC_ID_AAC, AV_CODEC_ID_H264, AVMEDIA_TYPE_AUDIO, Codec, Filter, InputFormat, OutputFormat, Registry } from '../src/index.js';
+import { prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+describe('Registry', () => {
+  it('should find codecs like Codec.find*', () => {
+    const decoder = Registry.findDecoder(AV_CODEC_ID_H264);
+    assert.ok(decoder);
+    assert.equal(decoder.name, Codec.findDecoder(AV_CODEC_ID_H264)?.name);
+    assert.ok(decoder.isDecoder());
+
+    const encoder = Registry.findEncoder(AV_CODEC_ID_AAC);
+    assert.ok(encoder);
+    assert.equal(encoder.name, Codec.findEncoder(AV_CODEC_ID_AAC)?.name);
+    assert.ok(encoder.isEncoder());
+
+    assert.equal(Registry.findDecoder('h264')?.id, AV_CODEC_ID_H264);
+    assert.equal(Registry.findEncoder('h264'), null, 'decoder names are not encoders');
+    assert.equal(Registry.findDecoder('does-not-exist'), null);
+    assert.equal(Registry.findDecoder('x'.repeat(1000)), null);
+  });
+
+  it('should return the same wrapper for repeated lookups', () => {
+    const first = Registry.findDecoder(AV_CODEC_ID_H264);
+    assert.ok(first);
+    assert.strictEqual(Registry.findDecoder('h264'), first);
+    assert.strictEqual(Registry.findDecoder(AV_CODEC_ID_H264), first);
+
+    assert.ok(Registry.findFilter('scale') instanceof Filter);
+    assert.strictEqual(Registry.findFilter('scale'), Registry.findFilter('scale'));
+  });
+
+  it('should match any of a format name', () => {
+    const demuxer = Registry.findDemuxer('mp4');
+    assert.ok(demuxer instanceof InputFormat);
+    assert.equal(demuxer.name, InputFormat.findInputFormat('mp4')?.name);
+    assert.strictEqual(Registry.findDemuxer('mov'), demuxer);
+
+    const muxer = Registry.findMuxer('mp4');
+    assert.ok(muxer instanceof OutputFormat);
+    assert.equal(muxer.name, 'mp4');
+    assert.equal(Registry.findMuxer('does-not-exist'), null);
+
+    // Format names ignore case like av_match_name(); codec names do not
+    assert.strictEqual(Registry.findDemuxer('MP4'), demuxer);
+    assert.strictEqual(Registry.findMuxer('Mp4'), muxer);
+    assert.equal(Registry.findDecoder('H264'), null);
+  });
+
+  it('should provide a frozen snapshot', () => {
+    const snapshot = Registry.snapshot();
+    assert.strictEqual(Registry.snapshot(), snapshot);
+    assert.ok(Object.isFrozen(snapshot));
+    assert.ok(Object.isFrozen(snapshot.codecs));
+
+    assert.equal(snapshot.codecs.length, Codec.getCodecList().length);
+    assert.equal(snapshot.filters.length, Filter.getList().length);
+    assert.ok(snapshot.demuxers.length > 0);
+    assert.ok(snapshot.muxers.some((m) => m.name === 'mp4'));
+
+    // Plain data
+    assert.doesNotThrow(() => JSON.parse(JSON.stringify(snapshot)));
+
+    // Array positions are registry indexes
+    const index = snapshot.codecs.findIndex((c) => c.name === 'aac' && c.isEncoder);
+    assert.ok(index >= 0);
+    assert.strictEqual(Registry.codecAt(index), Registry.findEncoder('aac'));
+    assert.equal(Registry.codecAt(snapshot.codecs.length), null);
+
+    const audioEncoders = Registry.codecsByType(AVMEDIA_TYPE_AUDIO, true);
+    assert.ok(audioEncoders.some((c) => c.name === 'aac'));
+    assert.ok(audioEncoders.every((c) => c.type === AVMEDIA_TYPE_AUDIO && c.isEncoder));
+  });
+});
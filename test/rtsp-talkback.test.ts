@@ -0,0 +1,198 @@
+import assert from 'node:assert';
+import { createServer } from 'node:net';
+import { after, describe, it } from 'node:test';
+
+import { AV_CODEC_ID_PCM_MULAW, Dictionary, FormatContext, RTSPTalkback } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+import type { AddressInfo, Server, Socket } from 'node:net';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+// 20ms CELT silence frame (TOC 0xf8: fullband, 20ms, mono, one frame)
+const OPUS_SILENCE = Buffer.from([0xf8, 0xff, 0xfe]);
+
+const SDP = [
+  'v=0',
+  'o=- 0 0 IN IP4 127.0.0.1',
+  's=Talkback',
+  'c=IN IP4 127.0.0.1',
+  't=0 0',
+  'm=audio 0 RTP/AVP 0',
+  'a=control:trackID=0',
+  'a=rtpmap:0 PCMU/8000',
+  'a=recvonly',
+  'm=audio 0 RTP/AVP 0',
+  'a=control:trackID=1',
+  'a=rtpmap:0 PCMU/8000',
+  'a=sendonly',
+  '',
+].join('\r\n');
+
+interface InterleavedFrame {
+  channel: number;
+  data: Buffer;
+}
+
+/**
+ * Minimal RTSP server stand-in: answers OPTIONS/DESCRIBE/SETUP/PLAY over TCP
+ * and collects interleaved frames sent by the client (the backchannel).
+ */
+function createRtspStandIn(): Promise<{ server: Server; url: string; frames: InterleavedFrame[] }> {
+  const frames: InterleavedFrame[] = [];
+
+  const server = createServer((socket: Socket) => {
+    let buffer = Buffer.alloc(0);
+
+    socket.on('data', (chunk) => {
+      buffer = Buffer.concat([buffer, chunk]);
+
+      while (buffer.length > 0) {
+        if (buffer[0] === 0x24) {
+          if (buffer.length < 4) break;
+          const len = buffer.readUInt16BE(2);
+          if (buffer.length < 4 + len) break;
+          frames.push({ channel: buffer[1], data: Buffer.from(buffer.subarray(4, 4 + len)) });
+          buffer = buffer.subarray(4 + len);
+          continue;
+        }
+
+        const end = buffer.indexOf('\r\n\r\n');
+        if (end < 0) break;
+        const request = buffer.subarray(0, end).toString();
+        buffer = buffer.subarray(end + 4);
+
+        const [requestLine, ...headerLines] = request.split('\r\n');
+        const method = requestLine.split(' ')[0];
+        const headers = new Map(headerLines.map((line) => [line.slice(0, line.indexOf(':')).toLowerCase(), line.slice(line.indexOf(':') + 1).trim()]));
+
+        const response = ['RTSP/1.0 200 OK', `CSeq: ${headers.get('cseq') ?? '0'}`];
+        let body = '';
+
+        switch (method) {
+          case 'OPTIONS':
+            response.push('Public: OPTIONS, DESCRIBE, SETUP, PLAY, TEARDOWN, GET_PARAMETER');
+            break;
+          case 'DESCRIBE':
+            body = SDP;
+            response.push('Content-Type: application/sdp', `Content-Base: rtsp://127.0.0.1:${(server.address() as AddressInfo).port}/stream/`);
+            break;
+          case 'SETUP':
+            response.push(`Transport: ${headers.get('transport') ?? ''}`, 'Session: 12345678;timeout=60');
+            break;
+          default:
+            response.push('Session: 12345678');
+            break;
+        }
+
+        response.push(`Content-Length: ${Buffer.byteLength(body)}`, '', body);
+        socket.write(response.join('\r\n'));
+      }
+    });
+
+    socket.on('error', () => {
+      // Ignore
+    });
+  });
+
+  return new Promise((resolve) => {
+    server.listen(0, '127.0.0.1', () => {
+      const { port } = server.address() as AddressInfo;
+      resolve({ server, url: `rtsp://127.0.0.1:${port}/stream`, frames });
+    });
+  });
+}
+
+function opusRtp(seq: number, timestamp: number): Buffer {
+  const header = Buffer.alloc(12);
+  header[0] = 0x80;
+  header[1] = 111;
+  header.writeUInt16BE(seq & 0xffff, 2);
+  header.writeUInt32BE(timestamp >>> 0, 4);
+  header.writeUInt32BE(0x1234, 8);
+  return Buffer.concat([header, OPUS_SILENCE]);
+}
+
+describe('RTSPTalkback', () => {
+  const contexts: FormatContext[] = [];
+  const servers: Server[] = [];
+
+  after(async () => {
+    for (const ctx of contexts) {
+      try {
+        await ctx.closeInput();
+      } catch {
+        // Ignore
+      }
+    }
+    for (const server of servers) {
+      server.close();
+    }
+  });
+
+  it('should reject non-RTSP input contexts', async () => {
+    const ctx = new FormatContext();
+    contexts.push(ctx);
+    const ret = await ctx.openInput(inputFile);
+    assert.equal(ret, 0);
+
+    assert.throws(() => RTSPTalkback.create(ctx, 0), /RTSP input/);
+  });
+
+  it('should transcode Opus RTP to the RTSP backchannel codec', async (t) => {
+    const { server, url, frames } = await createRtspStandIn();
+    servers.push(server);
+
+    const ctx = new FormatContext();
+    contexts.push(ctx);
+    const ret = await ctx.openInput(url, null, Dictionary.fromObject({ rtsp_transport: 'tcp' }));
+    assert.equal(ret, 0);
+
+    const backchannel = ctx.getRTSPStreamInfo()?.find((s) => s.direction === 'sendonly');
+    if (!backchannel) {
+      t.skip('FFmpeg build does not expose RTSP backchannel streams');
+      return;
+    }
+
+    const talkback = RTSPTalkback.create(ctx, backchannel.streamIndex, { inputPayloadType: 111 });
+    assert.equal(talkback.codecId, AV_CODEC_ID_PCM_MULAW);
+    assert.equal(talkback.isRunning, true);
+
+    // 1 second of audio, plus one duplicate that must be dropped as late
+    for (let i = 0; i < 50; i++) {
+      assert.equal(talkback.push(opusRtp(1000 + i, i * 960)), true);
+    }
+    talkback.push(opusRtp(1010, 10 * 960));
+
+    await talkback.stop();
+    assert.equal(talkback.isRunning, false);
+    assert.equal(talkback.push(opusRtp(2000, 0)), false);
+
+    const stats = talkback.getStats();
+    assert.equal(stats.receivedPackets, 51);
+    assert.equal(stats.latePackets, 1);
+    assert.equal(stats.decodedFrames, 50);
+    assert.equal(stats.sendErrors, 0);
+    // Resampler delay may hold back the tail of the last frame
+    assert.ok(stats.sentPackets >= 45, `sent ${stats.sentPackets}`);
+
+    // Wait for the stand-in to read everything
+    for (let i = 0; i < 50 && frames.length < stats.sentPackets; i++) {
+      await new Promise((resolve) => setTimeout(resolve, 20));
+    }
+    assert.equal(frames.length, stats.sentPackets);
+
+    const first = frames[0].data;
+    assert.equal(first[0] >> 6, 2);
+    assert.equal(first[1], 0x80 | backchannel.payloadType, 'marker bit on the first packet');
+    assert.equal(first.length, 12 + 160, '20ms of G.711 at 8kHz');
+
+    const second = frames[1].data;
+    assert.equal(second[1], backchannel.payloadType);
+    assert.equal(second.readUInt16BE(2), (first.readUInt16BE(2) + 1) & 0xffff);
+    assert.equal((second.readUInt32BE(4) - first.readUInt32BE(4)) >>> 0, 160);
+    assert.equal(second.readUInt32BE(8), first.readUInt32BE(8));
+  });
+});
@@ -0,0 +1,75 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { AV_CHANNEL_LAYOUT_MONO, AV_SAMPLE_FMT_FLT, Frame, SilenceGate } from '../src/index.js';
+
+import type { SpeechSegment } from '../src/index.js';
+
+const SAMPLE_RATE = 16000;
+const FRAME_SIZE = 320; // 20 ms
+
+// 1s silence, 1s 300 Hz tone, 1s silence in 20 ms frames, then null
+async function* source(): AsyncGenerator<Frame | null> {
+  for (let i = 0; i < 150; i++) {
+    const speech = i >= 50 && i < 100;
+    const buffer = Buffer.alloc(FRAME_SIZE * 4);
+    for (let j = 0; j < FRAME_SIZE; j++) {
+      buffer.writeFloatLE(speech ? 0.3 * Math.sin((2 * Math.PI * 300 * (i * FRAME_SIZE + j)) / SAMPLE_RATE) : 0, j * 4);
+    }
+    yield Frame.fromAudioBuffer(buffer, {
+      nbSamples: FRAME_SIZE,
+      format: AV_SAMPLE_FMT_FLT,
+      sampleRate: SAMPLE_RATE,
+      channelLayout: AV_CHANNEL_LAYOUT_MONO,
+    });
+  }
+  yield null;
+}
+
+describe('SilenceGate', () => {
+  it('should drop silence and keep the pre-roll', async () => {
+    const segments: SpeechSegment[] = [];
+    const gate = SilenceGate.create({ preRoll: 300, minSpeech: 100, hangover: 300, onSegment: (segment) => segments.push(segment) });
+
+    let frames = 0;
+    let flushed = false;
+    for await (using frame of gate.frames(source())) {
+      if (frame === null) {
+        flushed = true;
+      } else {
+        frames++;
+      }
+    }
+
+    // 300ms pre-roll before the onset is confirmed at 1080ms, then speech and hangover up to 2300ms
+    assert.ok(flushed);
+    assert.equal(frames, 15 + 1 + 60);
+    assert.deepEqual(segments, [{ start: 1000, end: 2000 }]);
+
+    const stats = gate.getStats();
+    assert.equal(stats.passedFrames, 76);
+    assert.equal(stats.droppedFrames, 150 - 76);
+    assert.equal(stats.speechDuration, 1000);
+
+    // Passed audio starts with the pre-roll at 780ms
+    assert.equal(gate.sourceTime(0), 780);
+    assert.equal(gate.sourceTime(500), 1280);
+  });
+
+  it('should flag frames without dropping them', async () => {
+    const gate = SilenceGate.create({ mode: 'flag' });
+
+    const flags: string[] = [];
+    for await (using frame of gate.frames(source())) {
+      if (frame) {
+        flags.push(frame.getMetadata().get('vad.speech') ?? '');
+      }
+    }
+
+    assert.equal(flags.length, 150);
+    assert.equal(flags[0], '0');
+    assert.equal(flags[60], '1');
+    assert.equal(gate.getStats().droppedFrames, 0);
+    assert.equal(gate.sourceTime(1500), 1500);
+  });
+});
@@ -18,12 +18,25 @@ import {
   SoftwareResampleContext,
 } from '../src/index.js';
 
+import type { AVSampleFormat } from '../src/index.js';
+
 describe('SoftwareResampleContext', () => {
   // Use imported channel layouts
   const MONO = AV_CHANNEL_LAYOUT_MONO;
   const STEREO = AV_CHANNEL_LAYOUT_STEREO;
   const SURROUND_5_1 = AV_CHANNEL_LAYOUT_5POINT1_BACK;
 
+  const createAudioFrame = (format: AVSampleFormat, sampleRate: number, nbSamples: number): Frame => {
+    const frame = new Frame();
+    frame.alloc();
+    frame.format = format;
+    frame.sampleRate = sampleRate;
+    frame.nbSamples = nbSamples;
+    frame.channelLayout = STEREO;
+    assert.equal(frame.getBuffer(), 0, 'Should allocate audio buffer');
+    return frame;
+  };
+
   describe('Creation and Lifecycle', () => {
     it('should create a new SoftwareResampleContext', () => {
       const swr = new SoftwareResampleContext();
@@ -324,7 +337,7 @@ describe('SoftwareResampleContext', () => {
       const outRet = outFrame.getBuffer();
       assert.equal(outRet, 0, 'Should allocate output buffer');
 
-      const ret = swr.convertFrame(outFrame, inFrame);
+      const ret = swr.convertFrameSync(outFrame, inFrame);
       assert.equal(typeof ret, 'number', 'Should return status code');
       assert.equal(ret, 0, 'Should convert frame successfully');
 
@@ -333,6 +346,79 @@ describe('SoftwareResampleContext', () => {
       swr.free();
     });
 
+    it('should convert frame objects (async)', async () => {
+      const swr = new SoftwareResampleContext();
+
+      swr.allocSetOpts2(STEREO, AV_SAMPLE_FMT_S16P, 44100, STEREO, AV_SAMPLE_FMT_S16, 48000);
+      swr.init();
+
+      using inFrame = createAudioFrame(AV_SAMPLE_FMT_S16, 48000, 1024);
+      using outFrame = new Frame();
+      outFrame.alloc();
+      outFrame.format = AV_SAMPLE_FMT_S16P;
+      outFrame.sampleRate = 44100;
+      outFrame.channelLayout = STEREO;
+
+      const promise = swr.convertFrame(outFrame, inFrame);
+      assert.ok(promise instanceof Promise, 'Should return a promise');
+      assert.equal(await promise, 0, 'Should convert frame successfully');
+      assert.ok(outFrame.nbSamples > 0, 'Should output samples');
+
+      swr.free();
+    });
+
+    it('should convert frame batches', async () => {
+      const swr = new SoftwareResampleContext();
+
+      swr.allocSetOpts2(STEREO, AV_SAMPLE_FMT_FLTP, 44100, STEREO, AV_SAMPLE_FMT_FLTP, 48000);
+      swr.init();
+
+      const inputs = Array.from({ length: 4 }, () => createAudioFrame(AV_SAMPLE_FMT_FLTP, 48000, 1024));
+      const outputs = await swr.convertFrames([...inputs, null]);
+      assert.equal(outputs.length, 5, 'Should return one frame per input');
+
+      for (const frame of outputs) {
+        assert.equal(frame.format, AV_SAMPLE_FMT_FLTP);
+        assert.equal(frame.sampleRate, 44100);
+        assert.equal(frame.channels, 2);
+      }
+
+      // Flushed batch covers all input samples
+      const total = outputs.reduce((sum, frame) => sum + frame.nbSamples, 0);
+      assert.ok(Math.abs(total - (4 * 1024 * 44100) / 48000) <= 8, `Unexpected output length ${total}`);
+
+      for (const frame of [...inputs, ...outputs]) {
+        frame.free();
+      }
+      swr.free();
+    });
+
+    it('should convert frame batches into preallocated frames', async () => {
+      const swr = new SoftwareResampleContext();
+
+      swr.allocSetOpts2(STEREO, AV_SAMPLE_FMT_S16, 44100, STEREO, AV_SAMPLE_FMT_S16, 44100);
+      swr.init();
+
+      const inputs = Array.from({ length: 3 }, () => createAudioFrame(AV_SAMPLE_FMT_S16, 44100, 1024));
+      const pool = Array.from({ length: 3 }, () => createAudioFrame(AV_SAMPLE_FMT_S16, 44100, 2048));
+
+      for (let batch = 0; batch < 2; batch++) {
+        const outputs = await swr.convertFrames(inputs, pool);
+        assert.equal(outputs.length, 3);
+        outputs.forEach((frame, i) => {
+          assert.strictEqual(frame, pool[i], 'Should return the given frames');
+          assert.equal(frame.nbSamples, 1024, 'Should fill the preallocated buffer');
+        });
+      }
+
+      await assert.rejects(swr.convertFrames(inputs, pool.slice(0, 1)), RangeError);
+
+      for (const frame of [...inputs, ...pool]) {
+        frame.free();
+      }
+      swr.free();
+    });
+
     it('should handle planar format conversion (async)', async () => {
       const swr = new SoftwareResampleContext();
 
@@ -624,7 +710,7 @@ describe('SoftwareResampleContext', () => {
       dstFrame.channelLayout = STEREO;
       // Don't set nbSamples or call getBuffer() - let convertFrame handle it
 
-      const ret = swr.convertFrame(dstFrame, srcFrame);
+      const ret = swr.convertFrameSync(dstFrame, srcFrame);
       assert.equal(ret, 0, 'Should auto-allocate destination');
 
       srcFrame.free();
@@ -0,0 +1,80 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import {
+  AV_NOPTS_VALUE,
+  AV_ROUND_NEAR_INF,
+  AV_ROUND_PASS_MINMAX,
+  AV_ROUND_UP,
+  AV_TIME_BASE_Q,
+  avRescaleQ,
+  avRescaleQBatch,
+  avRescaleQRnd,
+  TimestampRescaler,
+} from '../src/index.js';
+
+const tb90k = { num: 1, den: 90000 };
+const tbMs = { num: 1, den: 1000 };
+const tbNtsc = { num: 1001, den: 30000 };
+
+describe('TimestampRescaler', () => {
+  it('should match avRescaleQ', () => {
+    const rescaler = TimestampRescaler.create(tb90k, tbMs);
+    for (const ts of [0n, 1n, 44n, 45n, 3003n, -3003n, 90000n * 3600n * 24n]) {
+      assert.equal(rescaler.rescale(ts), avRescaleQ(ts, tb90k, tbMs), `ts ${ts}`);
+    }
+    assert.equal(rescaler.rescale(1000), 11n);
+
+    const ntsc = TimestampRescaler.create(tbNtsc, AV_TIME_BASE_Q);
+    assert.equal(ntsc.rescale(123456789n), avRescaleQ(123456789n, tbNtsc, AV_TIME_BASE_Q));
+  });
+
+  it('should apply the rounding mode', () => {
+    const up = TimestampRescaler.create(tb90k, tbMs, AV_ROUND_UP);
+    assert.equal(up.rescale(1n), avRescaleQRnd(1n, tb90k, tbMs, AV_ROUND_UP));
+    assert.equal(up.rescale(1n), 1n);
+
+    const passMinMax = TimestampRescaler.create(tb90k, tbMs, AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX);
+    assert.equal(passMinMax.rescale(AV_NOPTS_VALUE), AV_NOPTS_VALUE);
+    assert.equal(passMinMax.rescale(null), AV_NOPTS_VALUE);
+  });
+
+  it('should rescale arrays in place or into an output array', () => {
+    const rescaler = TimestampRescaler.create(tb90k, tbMs);
+    const values = BigInt64Array.of(0n, 3000n, 6000n, -1500n);
+    const expected = Array.from(values, (v) => avRescaleQ(v, tb90k, tbMs));
+
+    const out = new BigInt64Array(values.length);
+    assert.strictEqual(rescaler.rescaleArray(values, out), out);
+    assert.deepEqual(Array.from(out), expected);
+    assert.equal(values[1], 3000n, 'input untouched');
+
+    assert.strictEqual(rescaler.rescaleArray(values), values);
+    assert.deepEqual(Array.from(values), expected);
+
+    assert.throws(() => rescaler.rescaleArray(values, new BigInt64Array(1)), TypeError);
+  });
+
+  it('should report its time bases', () => {
+    const rescaler = TimestampRescaler.create(tb90k, tbMs);
+    assert.ok(rescaler.matches({ num: 1, den: 90000 }, { num: 1, den: 1000 }));
+    assert.ok(!rescaler.matches(tbMs, tb90k));
+    assert.equal(rescaler.rnd, AV_ROUND_NEAR_INF);
+  });
+});
+
+describe('avRescaleQBatch', () => {
+  it('should match avRescaleQ per element', () => {
+    const values = BigInt64Array.of(0n, 1n, 1001n, 30000n, -7n);
+    const expected = Array.from(values, (v) => avRescaleQ(v, tbNtsc, tb90k));
+    assert.strictEqual(avRescaleQBatch(values, tbNtsc, tb90k), values);
+    assert.deepEqual(Array.from(values), expected);
+  });
+
+  it('should support rounding and an output array', () => {
+    const values = BigInt64Array.of(1n, 2n, AV_NOPTS_VALUE);
+    const out = new BigInt64Array(3);
+    avRescaleQBatch(values, tb90k, tbMs, AV_ROUND_UP | AV_ROUND_PASS_MINMAX, out);
+    assert.deepEqual(Array.from(out), [1n, 1n, AV_NOPTS_VALUE]);
+  });
+});
@@ -71,10 +71,23 @@ import {
   avTs2Str,
   avTs2TimeStr,
   avUsleep,
+  exportNativeTrace,
+  Fifo,
   getFFmpegInfo,
+  getInlineDispatchStats,
+  getLeakReport,
+  getMemoryAccounting,
+  Packet,
+  resetLeakDetection,
+  resetMemoryAccountingPeak,
+  setInlineDispatch,
+  setLeakDetection,
+  setMemoryAccounting,
+  setNativeTracing,
 } from '../src/index.js';
 
 import { Demuxer } from '../src/api/index.js';
+import { bindings } from '../src/lib/binding.js';
 import { getInputFile, prepareTestEnvironment } from './index.js';
 
 prepareTestEnvironment();
@@ -127,6 +140,253 @@ describe('Utilities', () => {
     });
   });
 
+  describe('Lazy Registration', () => {
+    it('should register rarely used classes on first access', () => {
+      assert.ok(Object.keys(bindings).includes('PacketPacer'), 'Lazy exports should be enumerable');
+
+      const ctor = bindings.PacketPacer;
+      assert.equal(typeof ctor, 'function');
+
+      // The getter is replaced by the registered class
+      const descriptor = Object.getOwnPropertyDescriptor(bindings, 'PacketPacer');
+      assert.equal(descriptor?.value, ctor);
+      assert.equal(bindings.PacketPacer, ctor);
+    });
+
+    it('should register all exports of a subsystem together', () => {
+      assert.equal(typeof bindings.mp4DefragmentSync, 'function');
+      assert.equal(typeof Object.getOwnPropertyDescriptor(bindings, 'mp4Defragment')?.value, 'function');
+    });
+  });
+
+  describe('Memory Accounting', () => {
+    it('should attribute packet buffers and release them on free', () => {
+      setMemoryAccounting(true);
+      try {
+        const before = getMemoryAccounting();
+        assert.equal(before.enabled, true);
+
+        const packet = new Packet();
+        packet.alloc();
+        packet.data = Buffer.alloc(4096);
+
+        const clone = packet.clone();
+        assert.ok(clone);
+
+        const during = getMemoryAccounting();
+        assert.equal(during.owners.packet.objects, before.owners.packet.objects + 2);
+        // The clone shares the buffer but is counted as a holder too
+        assert.ok(during.owners.packet.bytes >= before.owners.packet.bytes + 2 * 4096);
+        assert.ok(during.peakBytes >= during.bytes);
+
+        clone.free();
+        packet.free();
+
+        const after = getMemoryAccounting();
+        assert.equal(after.owners.packet.objects, before.owners.packet.objects);
+        assert.equal(after.owners.packet.bytes, before.owners.packet.bytes);
+        assert.ok(after.owners.packet.peakBytes >= during.owners.packet.bytes, 'High-water mark is kept');
+
+        resetMemoryAccountingPeak();
+        assert.equal(getMemoryAccounting().owners.packet.peakBytes, after.owners.packet.bytes);
+      } finally {
+        setMemoryAccounting(false);
+      }
+    });
+
+    it('should not track objects while disabled', () => {
+      const before = getMemoryAccounting();
+      const packet = new Packet();
+      packet.alloc();
+      packet.data = Buffer.alloc(1024);
+
+      assert.ok(getMemoryAccounting().owners.packet.objects <= before.owners.packet.objects);
+      packet.free();
+    });
+  });
+
+  describe('Leak Detection', () => {
+    it('should count explicitly freed packets', () => {
+      setLeakDetection(true);
+      resetLeakDetection();
+      try {
+        const packet = new Packet();
+        packet.alloc();
+        const clone = packet.clone();
+        clone?.free();
+        packet.free();
+
+        const report = getLeakReport();
+        assert.equal(report.enabled, true);
+        assert.equal(report.allocated, 2);
+        assert.equal(report.freed, 2);
+        assert.equal(report.leaked, 0);
+        assert.deepEqual(report.sites, []);
+      } finally {
+        setLeakDetection(false);
+      }
+    });
+
+    it('should report the allocation site of packets finalized without free()', async (t) => {
+      if (!global.gc) {
+        t.skip('requires --expose-gc');
+        return;
+      }
+
+      setLeakDetection(true);
+      resetLeakDetection();
+      try {
+        const leakPackets = () => {
+          for (let i = 0; i < 4; i++) {
+            const packet = new Packet();
+            packet.alloc();
+            packet.data = Buffer.alloc(1024);
+          }
+        };
+        leakPackets();
+
+        // Wrapper finalizers run after the collection
+        for (let i = 0; i < 3; i++) {
+          global.gc();
+          await new Promise((resolve) => setImmediate(resolve));
+        }
+
+        const report = getLeakReport(1);
+        assert.ok(report.leaked > 0, 'Unfreed packets should be reported');
+        assert.ok(report.leakedBytes >= 1024 * report.leaked);
+        assert.equal(report.sites[0].kind, 'Packet');
+        assert.match(report.sites[0].stack, /leakPackets/);
+      } finally {
+        setLeakDetection(false);
+      }
+    });
+
+    it('should report packets leaked from Demuxer.packets() at the consuming code', async (t) => {
+      if (!global.gc) {
+        t.skip('requires --expose-gc');
+        return;
+      }
+
+      setLeakDetection(true);
+      resetLeakDetection();
+      try {
+        await using media = await Demuxer.open(getInputFile('demux.mp4'));
+        let kept: Packet[] = [];
+        for await (const packet of media.packets()) {
+          if (!packet || kept.length === 4) break;
+          kept.push(packet);
+        }
+        assert.equal(kept.length, 4);
+        kept = [];
+
+        // Wrapper finalizers run after the collection
+        for (let i = 0; i < 3; i++) {
+          global.gc();
+          await new Promise((resolve) => setImmediate(resolve));
+        }
+
+        const report = getLeakReport(1);
+        assert.ok(report.leaked >= 4, 'Unfreed packets should be reported');
+        assert.equal(report.sites[0].kind, 'Packet');
+        // First frame is this test, not the demuxer read loop
+        assert.match(report.sites[0].stack.split('\n')[0], /utilities\.test\.ts/);
+      } finally {
+        setLeakDetection(false);
+      }
+    });
+  });
+
+  describe('Native Tracing', () => {
+    interface TraceEvent {
+      name: string;
+      cat?: string;
+      ph: string;
+      ts?: number;
+      dur?: number;
+      tid: number;
+      args: Record<string, string>;
+    }
+
+    it('should export worker and FFmpeg call events as Chrome trace JSON', async () => {
+      setNativeTracing(true);
+      exportNativeTrace(); // Drop events of earlier tests
+      const ctx = new FormatContext();
+      const packet = new Packet();
+      packet.alloc();
+      try {
+        assert.equal(await ctx.openInput(getInputFile('demux.mp4')), 0);
+        assert.equal(await ctx.readFrame(packet), 0);
+        packet.unref();
+        assert.equal(ctx.readFrameSync(packet), 0);
+      } finally {
+        setNativeTracing(false);
+        packet.free();
+        await ctx.closeInput();
+      }
+
+      const trace = JSON.parse(exportNativeTrace()) as { traceEvents: TraceEvent[]; otherData: { droppedEvents: number } };
+      assert.equal(trace.otherData.droppedEvents, 0);
+
+      const worker = trace.traceEvents.find((e) => e.name === 'FCReadFrameWorker');
+      assert.ok(worker, 'Async readFrame should record its worker');
+      assert.equal(worker.cat, 'worker');
+      assert.equal(worker.ph, 'X');
+      assert.ok(worker.dur! >= 0);
+
+      const calls = trace.traceEvents.filter((e) => e.name === 'av_read_frame');
+      assert.equal(calls.length, 2, 'Sync and async av_read_frame should be recorded');
+      assert.ok(calls.every((e) => e.cat === 'ffmpeg' && e.args.object === calls[0].args.object));
+
+      // The sync call ran on the JS thread
+      const jsThread = trace.traceEvents.find((e) => e.ph === 'M' && e.args.name === 'JavaScript');
+      assert.ok(jsThread);
+      assert.ok(calls.some((e) => e.tid === jsThread.tid));
+      assert.ok(calls.some((e) => e.tid !== jsThread.tid));
+
+      // Drained
+      const again = JSON.parse(exportNativeTrace()) as { traceEvents: TraceEvent[] };
+      assert.ok(again.traceEvents.every((e) => e.ph === 'M'));
+    });
+  });
+
+  describe('Inline Dispatch', () => {
+    it('should run small copies inline and offload large ones', async () => {
+      const fifo = new Fifo();
+      fifo.alloc(1024, 4);
+      const input = Buffer.from(Array.from({ length: 64 }, (_, i) => i));
+      const output = Buffer.alloc(64);
+
+      try {
+        setInlineDispatch({ enabled: true, maxBytes: 1024, resetStats: true });
+        assert.equal(await fifo.write(input, 16), 16);
+        assert.equal(await fifo.read(output, 16), 16);
+        assert.deepEqual(output, input);
+
+        let stats = getInlineDispatchStats();
+        assert.equal(stats.maxBytes, 1024);
+        assert.deepEqual(stats.fifo, { inline: 2, offloaded: 0 });
+
+        // Above the threshold
+        setInlineDispatch({ maxBytes: 32 });
+        assert.equal(await fifo.write(input, 16), 16);
+        stats = getInlineDispatchStats();
+        assert.deepEqual(stats.fifo, { inline: 2, offloaded: 1 });
+
+        // Disabled
+        setInlineDispatch({ enabled: false, maxBytes: 1024 });
+        assert.equal(await fifo.read(output, 16), 16);
+        assert.equal(getInlineDispatchStats().fifo.offloaded, 2);
+      } finally {
+        setInlineDispatch({ enabled: true, maxBytes: 65536, resetStats: true });
+        fifo.free();
+      }
+    });
+
+    it('should reject negative thresholds', () => {
+      assert.throws(() => setInlineDispatch({ maxBytes: -1 }), RangeError);
+    });
+  });
+
   describe('Channel Layout Functions', () => {
     it('should describe channel layouts', () => {
       // Test mono layout
@@ -0,0 +1,166 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { AV_CHANNEL_LAYOUT_MONO, AV_CHANNEL_LAYOUT_STEREO, AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_S16, AVERROR_EINVAL, Frame, Rational, VoiceActivityDetector } from '../src/index.js';
+
+const SAMPLE_RATE = 16000;
+const FRAME_SIZE = 320; // 20 ms
+
+// Deterministic white noise in [-1, 1)
+let seed = 1;
+function noise(): number {
+  seed = (Math.imul(seed, 1103515245) + 12345) & 0x7fffffff;
+  return seed / 0x40000000 - 1;
+}
+
+function tone(frequency: number, amplitude: number): (t: number) => number {
+  return (t) => amplitude * Math.sin(2 * Math.PI * frequency * t);
+}
+
+// Mono float frames from (seconds, signal) parts
+function createFrames(parts: [number, (t: number) => number][]): Frame[] {
+  const samples: number[] = [];
+  for (const [seconds, signal] of parts) {
+    for (let i = 0; i < seconds * SAMPLE_RATE; i++) {
+      samples.push(signal(samples.length / SAMPLE_RATE));
+    }
+  }
+
+  const frames: Frame[] = [];
+  for (let start = 0; start < samples.length; start += FRAME_SIZE) {
+    const buffer = Buffer.alloc(FRAME_SIZE * 4);
+    for (let i = 0; i < FRAME_SIZE; i++) {
+      buffer.writeFloatLE(samples[start + i] ?? 0, i * 4);
+    }
+    frames.push(
+      Frame.fromAudioBuffer(buffer, {
+        nbSamples: FRAME_SIZE,
+        format: AV_SAMPLE_FMT_FLT,
+        sampleRate: SAMPLE_RATE,
+        channelLayout: AV_CHANNEL_LAYOUT_MONO,
+      }),
+    );
+  }
+  return frames;
+}
+
+function run(vad: VoiceActivityDetector, frames: Frame[]): number[] {
+  const results = frames.map((frame) => vad.process(frame));
+  for (const frame of frames) {
+    frame.free();
+  }
+  return results;
+}
+
+const silence = (): number => 0;
+
+describe('VoiceActivityDetector', () => {
+  it('should detect a speech segment with hangover', () => {
+    const vad = VoiceActivityDetector.create({ minSpeech: 100, hangover: 300 });
+    const results = run(vad, createFrames([[1, silence], [1, tone(300, 0.3)], [1, silence]]));
+
+    // Speech from 1000ms, reported after minSpeech; silence after the hangover
+    assert.equal(results[49], 0);
+    assert.equal(results[53], 0, 'Onset not confirmed yet');
+    assert.equal(results[54], 1);
+    assert.equal(results[100 + 14], 1, 'Within the hangover');
+    assert.equal(results[100 + 15], 0);
+    assert.equal(vad.speaking, false);
+
+    assert.deepEqual(vad.takeSegments(), [{ start: 1000, end: 2000 }]);
+    assert.deepEqual(vad.takeSegments(), [], 'Segments are taken once');
+
+    const stats = vad.getStats();
+    assert.equal(stats.segments, 1);
+    assert.equal(stats.speechDuration, 1000);
+    assert.ok(Math.abs(stats.duration - 3000) < 1e-6);
+  });
+
+  it('should ignore bursts shorter than minSpeech', () => {
+    const vad = VoiceActivityDetector.create({ minSpeech: 200 });
+    run(vad, createFrames([[0.5, silence], [0.1, tone(300, 0.3)], [0.5, silence]]));
+    vad.flush();
+    assert.deepEqual(vad.takeSegments(), []);
+  });
+
+  it('should extend segments with unvoiced speech by zero crossings', () => {
+    // White noise 5 dB below the threshold crosses zero about 8000 times per second,
+    // a 50 Hz hum at the same level 100 times
+    const quiet = 0.0031;
+    const fricative = (): number => quiet * noise();
+    const hum = tone(50, quiet * Math.sqrt(2 / 3));
+
+    const withFricative = VoiceActivityDetector.create({ adaptive: false });
+    run(withFricative, createFrames([[0.5, silence], [0.5, tone(300, 0.3)], [0.1, fricative], [0.5, silence]]));
+    assert.deepEqual(withFricative.takeSegments(), [{ start: 500, end: 1100 }]);
+
+    const withHum = VoiceActivityDetector.create({ adaptive: false });
+    run(withHum, createFrames([[0.5, silence], [0.5, tone(300, 0.3)], [0.1, hum], [0.5, silence]]));
+    assert.deepEqual(withHum.takeSegments(), [{ start: 500, end: 1000 }]);
+  });
+
+  it('should adapt to background noise', () => {
+    const background = (t: number): number => 0.03 * Math.sin(2 * Math.PI * 120 * t); // About -33 dBFS
+    const speech = (t: number): number => background(t) + 0.3 * Math.sin(2 * Math.PI * 300 * t);
+
+    const adaptive = VoiceActivityDetector.create();
+    run(adaptive, createFrames([[1, background], [1, speech], [1, background]]));
+    adaptive.flush();
+    assert.deepEqual(adaptive.takeSegments(), [{ start: 1000, end: 2000 }]);
+    assert.ok(Math.abs(adaptive.getStats().noiseFloor + 33) < 3);
+
+    // With a fixed threshold below the background, it is all speech
+    const fixed = VoiceActivityDetector.create({ adaptive: false });
+    run(fixed, createFrames([[1, background], [1, speech], [1, background]]));
+    fixed.flush();
+    assert.deepEqual(fixed.takeSegments(), [{ start: 0, end: 3000 }]);
+  });
+
+  it('should close the open segment on flush', () => {
+    const vad = VoiceActivityDetector.create();
+    run(vad, createFrames([[0.5, silence], [0.5, tone(300, 0.3)]]));
+    assert.equal(vad.speaking, true);
+    assert.deepEqual(vad.takeSegments(), []);
+
+    vad.flush();
+    assert.equal(vad.speaking, false);
+    assert.deepEqual(vad.takeSegments(), [{ start: 500, end: 1000 }]);
+  });
+
+  it('should use frame timestamps and flag frames', () => {
+    const vad = VoiceActivityDetector.create({ flagFrames: true });
+    const frames = createFrames([[0.5, silence], [0.5, tone(300, 0.3)]]);
+    frames.forEach((frame, i) => {
+      frame.pts = BigInt(10 * SAMPLE_RATE + i * FRAME_SIZE);
+      frame.timeBase = new Rational(1, SAMPLE_RATE);
+    });
+
+    for (const frame of frames) {
+      const ret = vad.process(frame);
+      assert.equal(frame.getMetadata().get('vad.speech'), String(ret));
+      frame.free();
+    }
+    vad.flush();
+    assert.deepEqual(vad.takeSegments(), [{ start: 10500, end: 11000 }]);
+  });
+
+  it('should mix down any layout and sample format', () => {
+    const samples = Buffer.alloc(FRAME_SIZE * 2 * 2);
+    for (let i = 0; i < FRAME_SIZE; i++) {
+      samples.writeInt16LE(Math.round(10000 * Math.sin((2 * Math.PI * 300 * i) / SAMPLE_RATE)), i * 4);
+    }
+
+    const vad = VoiceActivityDetector.create({ minSpeech: 0, adaptive: false });
+    using frame = Frame.fromAudioBuffer(samples, {
+      nbSamples: FRAME_SIZE,
+      format: AV_SAMPLE_FMT_S16,
+      sampleRate: SAMPLE_RATE,
+      channelLayout: AV_CHANNEL_LAYOUT_STEREO,
+    });
+    assert.equal(vad.process(frame), 1, 'Speech in the left channel only');
+
+    using empty = new Frame();
+    empty.alloc();
+    assert.equal(vad.process(empty), AVERROR_EINVAL);
+  });
+});